@@ -6,5 +6,30 @@
 -keep class com.sherpaonnx.SherpaOnnxArchiveHelper { *; }
 -keep class com.sherpaonnx.SherpaOnnxArchiveHelper$* { *; }
 
+# JNI: class/method IDs are cached by name in JNI_OnLoad (sherpa-onnx-jni-cache.cpp); Zipvoice
+# streaming calls back into onNativeChunk / onNativeRingData, PcmRingBuffer, TtsAudioCache,
+# TtsFirstChunkPlanner, WavFileWriter, EngineScheduler, TtsStatsRecorder, TtsPlaybackBuffer,
+# TtsTimeStretcher, ZipvoiceStepPlanner, TtsTextSegmenter, TtsExportWriter, SttBatchPlanner,
+# WavFileReader, SpeechRangeBuilder, ModelPrefetcher, SttAutoTuner and HotwordsCompiler have native
+# methods.
+-keep class com.sherpaonnx.ZipvoiceTtsWrapper { *; }
+-keep class com.sherpaonnx.PcmRingBuffer { *; }
+-keep class com.sherpaonnx.TtsAudioCache { *; }
+-keep class com.sherpaonnx.TtsFirstChunkPlanner { *; }
+-keep class com.sherpaonnx.WavFileWriter { *; }
+-keep class com.sherpaonnx.EngineScheduler { *; }
+-keep class com.sherpaonnx.TtsStatsRecorder { *; }
+-keep class com.sherpaonnx.TtsPlaybackBuffer { *; }
+-keep class com.sherpaonnx.TtsTimeStretcher { *; }
+-keep class com.sherpaonnx.ZipvoiceStepPlanner { *; }
+-keep class com.sherpaonnx.TtsTextSegmenter { *; }
+-keep class com.sherpaonnx.TtsExportWriter { *; }
+-keep class com.sherpaonnx.SttBatchPlanner { *; }
+-keep class com.sherpaonnx.WavFileReader { *; }
+-keep class com.sherpaonnx.SpeechRangeBuilder { *; }
+-keep class com.sherpaonnx.ModelPrefetcher { *; }
+-keep class com.sherpaonnx.SttAutoTuner { *; }
+-keep class com.sherpaonnx.HotwordsCompiler { *; }
+
 # ORT Java bridge: loaded via JNI from libonnxruntime4j_jni.so.
 -keep class ai.onnxruntime.** { *; }
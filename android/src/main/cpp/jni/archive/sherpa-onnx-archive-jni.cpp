@@ -8,19 +8,9 @@
 #include <string>
 #include <memory>
 #include "sherpa-onnx-archive-helper.h"
+#include "sherpa-onnx-jni-cache.h"
 #include <android/log.h>
 
-static JavaVM* g_vm = nullptr;
-
-extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* /* reserved */) {
-  g_vm = vm;
-  JNIEnv* env = nullptr;
-  if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
-    return -1;
-  }
-  return JNI_VERSION_1_6;
-}
-
 extern "C" JNIEXPORT void JNICALL
 Java_com_sherpaonnx_SherpaOnnxArchiveHelper_nativeExtractTarBz2(
     JNIEnv* env,
@@ -49,35 +39,26 @@ Java_com_sherpaonnx_SherpaOnnxArchiveHelper_nativeExtractTarBz2(
     j_progress_callback_global = env->NewGlobalRef(j_progress_callback);
   }
 
-  // Get Promise.resolve and reject methods
-  jclass promise_class = env->GetObjectClass(j_promise);
-  jmethodID resolve_method = env->GetMethodID(promise_class, "resolve", "(Ljava/lang/Object;)V");
-  jmethodID reject_method = env->GetMethodID(promise_class, "reject", 
-                                              "(Ljava/lang/String;Ljava/lang/String;)V");
-
-  // Get WritableMap from Arguments
-  jclass arguments_class = env->FindClass("com/facebook/react/bridge/Arguments");
-  jmethodID create_map_method = env->GetStaticMethodID(
-      arguments_class, "createMap", "()Lcom/facebook/react/bridge/WritableMap;");
-  jobject result_map = env->CallStaticObjectMethod(arguments_class, create_map_method);
-
-  jclass writeable_map_class = env->FindClass("com/facebook/react/bridge/WritableMap");
-  jmethodID put_boolean_method = env->GetMethodID(
-      writeable_map_class, "putBoolean", "(Ljava/lang/String;Z)V");
-  jmethodID put_string_method = env->GetMethodID(
-      writeable_map_class, "putString", "(Ljava/lang/String;Ljava/lang/String;)V");
+  // Promise / WritableMap methods are resolved once in JNI_OnLoad
+  const sherpaonnx::JniCache& cache = sherpaonnx::GetJniCache();
+  jmethodID resolve_method = cache.promiseResolve;
+  jmethodID reject_method = cache.promiseReject;
+  jmethodID put_boolean_method = cache.writableMapPutBoolean;
+  jmethodID put_string_method = cache.writableMapPutString;
+  JavaVM* vm = cache.vm;
+  jobject result_map = env->CallStaticObjectMethod(cache.argumentsClass, cache.argumentsCreateMap);
 
   // Progress callback wrapper - JNI-safe version
-  auto on_progress = [j_progress_callback_global, on_progress_method](
+  auto on_progress = [vm, j_progress_callback_global, on_progress_method](
       long long bytes_extracted, long long total_bytes, double percent) {
     if (j_progress_callback_global != nullptr && on_progress_method != nullptr) {
       // Get JNIEnv for current thread
       JNIEnv* callback_env = nullptr;
       bool should_detach = false;
       
-      if (g_vm->GetEnv(reinterpret_cast<void**>(&callback_env), JNI_VERSION_1_6) == JNI_EDETACHED) {
+      if (vm->GetEnv(reinterpret_cast<void**>(&callback_env), JNI_VERSION_1_6) == JNI_EDETACHED) {
         // Thread not attached, attach it
-        if (g_vm->AttachCurrentThread(&callback_env, nullptr) == JNI_OK) {
+        if (vm->AttachCurrentThread(&callback_env, nullptr) == JNI_OK) {
           should_detach = true;
         } else {
           return; // Failed to attach, skip callback
@@ -95,7 +76,7 @@ Java_com_sherpaonnx_SherpaOnnxArchiveHelper_nativeExtractTarBz2(
         
         // Detach if we attached in this call
         if (should_detach) {
-          g_vm->DetachCurrentThread();
+          vm->DetachCurrentThread();
         }
       }
     }
@@ -139,9 +120,6 @@ Java_com_sherpaonnx_SherpaOnnxArchiveHelper_nativeExtractTarBz2(
   }
 
   env->DeleteLocalRef(result_map);
-  env->DeleteLocalRef(promise_class);
-  env->DeleteLocalRef(arguments_class);
-  env->DeleteLocalRef(writeable_map_class);
 }
 
 extern "C" JNIEXPORT void JNICALL
@@ -159,10 +137,9 @@ Java_com_sherpaonnx_SherpaOnnxArchiveHelper_nativeComputeFileSha256(
   std::string file_str(file_path);
   env->ReleaseStringUTFChars(j_file_path, file_path);
 
-  jclass promise_class = env->GetObjectClass(j_promise);
-  jmethodID resolve_method = env->GetMethodID(promise_class, "resolve", "(Ljava/lang/Object;)V");
-  jmethodID reject_method = env->GetMethodID(
-      promise_class, "reject", "(Ljava/lang/String;Ljava/lang/String;)V");
+  const sherpaonnx::JniCache& cache = sherpaonnx::GetJniCache();
+  jmethodID resolve_method = cache.promiseResolve;
+  jmethodID reject_method = cache.promiseReject;
 
   std::string error_msg;
   std::string sha256;
@@ -176,6 +153,4 @@ Java_com_sherpaonnx_SherpaOnnxArchiveHelper_nativeComputeFileSha256(
                         env->NewStringUTF("CHECKSUM_ERROR"),
                         env->NewStringUTF(error_msg.c_str()));
   }
-
-  env->DeleteLocalRef(promise_class);
 }
@@ -701,6 +701,16 @@ static std::string convertToFormat(const char* inputPath, const char* outputPath
 #endif
 }
 
+namespace sherpaonnx {
+
+// Entry point for native callers in the same library (TTS batch export encodes through it).
+std::string ConvertAudioFileToFormat(const std::string& inputPath, const std::string& outputPath,
+                                     const std::string& format, int outputSampleRateHz) {
+    return convertToFormat(inputPath.c_str(), outputPath.c_str(), format.c_str(), outputSampleRateHz);
+}
+
+}  // namespace sherpaonnx
+
 extern "C" {
 
 // Called from Kotlin: SherpaOnnxModule.nativeConvertAudioToWav16k(inputPath, outputPath) -> Boolean
@@ -0,0 +1,98 @@
+/**
+ * sherpa-onnx-engine-scheduler-jni.cpp
+ *
+ * Purpose: JNI for EngineScheduler (Kotlin). Owns one native sherpaonnx::EngineScheduler per
+ * handle; Kotlin keeps the handle alive until every blocked Acquire has returned.
+ */
+#include <jni.h>
+
+#include "sherpa-onnx-engine-scheduler.h"
+
+namespace {
+
+sherpaonnx::EngineScheduler* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::EngineScheduler*>(ptr);
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativeCreate(JNIEnv* /* env */, jclass /* clazz */) {
+  return reinterpret_cast<jlong>(new sherpaonnx::EngineScheduler());
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativeParsePriority(JNIEnv* env, jclass /* clazz */, jstring name) {
+  if (!name) return sherpaonnx::kRequestPriorityNormal;
+  const char* c = env->GetStringUTFChars(name, nullptr);
+  const int32_t priority = sherpaonnx::ParseRequestPriority(c);
+  if (c) env->ReleaseStringUTFChars(name, c);
+  return static_cast<jint>(priority);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativeSubmit(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                 jint priority, jlong deadlineMs) {
+  auto* scheduler = FromHandle(ptr);
+  return scheduler ? static_cast<jlong>(scheduler->Submit(priority, deadlineMs)) : 0;
+}
+
+// Returns EngineScheduler::Status as an int (0 = ok).
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativeAcquire(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                  jlong id) {
+  auto* scheduler = FromHandle(ptr);
+  if (!scheduler) return static_cast<jint>(sherpaonnx::EngineScheduler::Status::kUnknown);
+  return static_cast<jint>(scheduler->Acquire(static_cast<uint64_t>(id)));
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativeRelease(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                  jlong id) {
+  auto* scheduler = FromHandle(ptr);
+  if (scheduler) scheduler->Release(static_cast<uint64_t>(id));
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativeFinish(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                 jlong id) {
+  auto* scheduler = FromHandle(ptr);
+  return scheduler ? static_cast<jlong>(scheduler->Finish(static_cast<uint64_t>(id))) : 0;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativeCancel(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                 jlong id) {
+  auto* scheduler = FromHandle(ptr);
+  return (scheduler && scheduler->Cancel(static_cast<uint64_t>(id))) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativeCancelAll(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  auto* scheduler = FromHandle(ptr);
+  if (scheduler) scheduler->CancelAll();
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativeShouldStop(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                     jlong id) {
+  auto* scheduler = FromHandle(ptr);
+  return (scheduler && scheduler->ShouldStop(static_cast<uint64_t>(id))) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_EngineScheduler_nativePriorityOf(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                     jlong id) {
+  auto* scheduler = FromHandle(ptr);
+  return scheduler ? static_cast<jint>(scheduler->PriorityOf(static_cast<uint64_t>(id)))
+                   : static_cast<jint>(sherpaonnx::kRequestPriorityNormal);
+}
+
+}  // extern "C"
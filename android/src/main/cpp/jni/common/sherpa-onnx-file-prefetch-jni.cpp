@@ -0,0 +1,38 @@
+/**
+ * sherpa-onnx-file-prefetch-jni.cpp
+ *
+ * Purpose: JNI for ModelPrefetcher (Kotlin). Stateless: lists the model files of a directory and
+ * issues read-ahead hints for them, returning the stats to Kotlin.
+ */
+#include <jni.h>
+#include <string>
+
+#include "sherpa-onnx-file-prefetch.h"
+
+namespace {
+
+std::string ToStdString(JNIEnv* env, jstring s) {
+  if (!s) return std::string();
+  const char* c = env->GetStringUTFChars(s, nullptr);
+  std::string out = c ? c : "";
+  if (c) env->ReleaseStringUTFChars(s, c);
+  return out;
+}
+
+}  // namespace
+
+extern "C" {
+
+// long[] { files, bytes, elapsedMs }.
+JNIEXPORT jlongArray JNICALL
+Java_com_sherpaonnx_ModelPrefetcher_nativePrefetchDir(JNIEnv* env, jclass /* clazz */, jstring dir) {
+  const sherpaonnx::PrefetchStats stats =
+      sherpaonnx::PrefetchFiles(sherpaonnx::ListModelFiles(ToStdString(env, dir)));
+  jlongArray out = env->NewLongArray(3);
+  if (!out) return nullptr;
+  const jlong values[3] = {stats.files, static_cast<jlong>(stats.bytes), static_cast<jlong>(stats.elapsedMs)};
+  env->SetLongArrayRegion(out, 0, 3, values);
+  return out;
+}
+
+}  // extern "C"
@@ -0,0 +1,104 @@
+/**
+ * sherpa-onnx-file-prefetch.cpp
+ *
+ * Purpose: Read-ahead hints for model files, issued while model detection runs so the page cache
+ * is warm by the time the recognizer sessions are created. Hints only: nothing is mapped or read
+ * here, and platforms without an advice call just report the file sizes.
+ */
+#include "sherpa-onnx-file-prefetch.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace sherpaonnx {
+
+namespace {
+
+bool IsModelFile(const fs::path& path) {
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+  return ext == ".onnx" || ext == ".ort" || ext == ".txt" || ext == ".bin" || ext == ".fst" || ext == ".far" ||
+         ext == ".model";
+}
+
+// Returns false if the file could not be opened.
+bool AdviseWillNeed(const std::string& path, int64_t size) {
+#if defined(__unix__) || defined(__APPLE__)
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+#if defined(__APPLE__)
+  radvisory advice{};
+  advice.ra_offset = 0;
+  // ra_count is an int: files over 2 GB get read-ahead for their first 2 GB only.
+  advice.ra_count = static_cast<int>(std::min<int64_t>(size, 0x7FFFFFFF));
+  fcntl(fd, F_RDADVISE, &advice);
+#elif defined(POSIX_FADV_WILLNEED)
+  (void)size;
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#else
+  (void)size;
+#endif
+  close(fd);
+  return true;
+#else
+  (void)path;
+  (void)size;
+  return true;
+#endif
+}
+
+}  // namespace
+
+std::vector<std::string> ListModelFiles(const std::string& dir) {
+  std::vector<std::pair<int64_t, std::string>> found;
+  std::error_code ec;
+  if (dir.empty() || !fs::is_directory(dir, ec)) return {};
+  auto scan = [&found](const fs::path& d, bool recurse, auto& self) -> void {
+    std::error_code iterEc;
+    for (fs::directory_iterator it(d, iterEc), end; !iterEc && it != end; it.increment(iterEc)) {
+      std::error_code entryEc;
+      if (it->is_directory(entryEc)) {
+        if (recurse) self(it->path(), false, self);
+      } else if (it->is_regular_file(entryEc) && IsModelFile(it->path())) {
+        const auto size = it->file_size(entryEc);
+        if (!entryEc) found.emplace_back(static_cast<int64_t>(size), it->path().string());
+      }
+    }
+  };
+  scan(fs::path(dir), true, scan);
+  std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+    return a.first != b.first ? a.first > b.first : a.second < b.second;
+  });
+  std::vector<std::string> paths;
+  paths.reserve(found.size());
+  for (auto& entry : found) paths.push_back(std::move(entry.second));
+  return paths;
+}
+
+PrefetchStats PrefetchFiles(const std::vector<std::string>& paths) {
+  const auto started = std::chrono::steady_clock::now();
+  PrefetchStats stats;
+  for (const std::string& path : paths) {
+    std::error_code ec;
+    const auto size = fs::file_size(path, ec);
+    if (ec) continue;
+    if (!AdviseWillNeed(path, static_cast<int64_t>(size))) continue;
+    ++stats.files;
+    stats.bytes += static_cast<int64_t>(size);
+  }
+  stats.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started)
+                        .count();
+  return stats;
+}
+
+}  // namespace sherpaonnx
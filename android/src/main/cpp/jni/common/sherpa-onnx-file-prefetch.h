@@ -0,0 +1,42 @@
+/**
+ * sherpa-onnx-file-prefetch.h
+ *
+ * Declares model-file prefetching: ask the kernel to start reading model files into the page cache
+ * (posix_fadvise WILLNEED on Linux/Android, F_RDADVISE on Apple) so that session creation, which
+ * runs later on another thread, finds them resident instead of faulting them in page by page.
+ * Shared by the Android JNI and the iOS wrappers (mirrored in ios/common).
+ */
+#ifndef SHERPA_ONNX_FILE_PREFETCH_H
+#define SHERPA_ONNX_FILE_PREFETCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sherpaonnx {
+
+struct PrefetchStats {
+  /** Files for which read-ahead was requested. */
+  int32_t files = 0;
+  /** Total size of those files. */
+  int64_t bytes = 0;
+  /** Wall time spent issuing the hints (the reads themselves continue in the background). */
+  int64_t elapsedMs = 0;
+};
+
+/**
+ * Model-like files directly in dir or one level below it (.onnx, .ort, .txt, .bin, .fst, .far,
+ * .model), largest first, so the big weight files are queued before small side files. Empty if
+ * dir is missing.
+ */
+std::vector<std::string> ListModelFiles(const std::string& dir);
+
+/**
+ * Issue a read-ahead hint for each path; missing or unreadable files are skipped. Does not wait
+ * for the data, and never maps or reads the files itself.
+ */
+PrefetchStats PrefetchFiles(const std::vector<std::string>& paths);
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_FILE_PREFETCH_H
@@ -1,6 +1,7 @@
 #ifndef SHERPA_ONNX_COMMON_H
 #define SHERPA_ONNX_COMMON_H
 
+#include <cstdint>
 #include <string>
 
 namespace sherpaonnx {
@@ -13,6 +14,27 @@ struct DetectedModel {
     std::string modelDir;  // Directory path where the model is located
 };
 
+/**
+ * Bits of the result-field mask of transcribe* / getSttStreamResult / processSttAudioChunk.
+ * text is always returned; every other field is only copied and marshalled when its bit is set.
+ * Same values as RESULT_* in SherpaOnnxSttHelper.kt and SttResultField in src/stt/types.ts.
+ */
+enum SttResultField : uint32_t {
+    kSttResultTokens = 1u << 0,
+    kSttResultTimestamps = 1u << 1,
+    kSttResultDurations = 1u << 2,
+    kSttResultLang = 1u << 3,
+    kSttResultEmotion = 1u << 4,
+    kSttResultEvent = 1u << 5,
+    kSttResultAllFields = (1u << 6) - 1,
+};
+
+/** Mask from a bridge argument: absent or negative means every field (the pre-mask behaviour). */
+inline uint32_t SttResultFieldsFromArg(double value, bool present) {
+    if (!present || value < 0) return kSttResultAllFields;
+    return static_cast<uint32_t>(value) & kSttResultAllFields;
+}
+
 } // namespace sherpaonnx
 
 #endif // SHERPA_ONNX_COMMON_H
@@ -6,6 +6,7 @@
  * sherpa-onnx-tts-wrapper.
  */
 #include "sherpa-onnx-detect-jni-common.h"
+#include "sherpa-onnx-jni-cache.h"
 
 namespace sherpaonnx {
 
@@ -24,15 +25,10 @@ bool PutString(JNIEnv* env, jobject map, jmethodID putId, const char* key, const
 }
 
 bool PutBoolean(JNIEnv* env, jobject map, jmethodID putId, const char* key, bool value) {
-  jclass boolClass = env->FindClass("java/lang/Boolean");
-  if (!boolClass) return false;
-  jmethodID valueOf = env->GetStaticMethodID(boolClass, "valueOf", "(Z)Ljava/lang/Boolean;");
-  if (!valueOf) {
-    env->DeleteLocalRef(boolClass);
-    return false;
-  }
-  jobject boxed = env->CallStaticObjectMethod(boolClass, valueOf, value ? JNI_TRUE : JNI_FALSE);
-  env->DeleteLocalRef(boolClass);
+  const JniCache& cache = GetJniCache();
+  if (!cache.booleanClass || !cache.booleanValueOf) return false;
+  jobject boxed = env->CallStaticObjectMethod(cache.booleanClass, cache.booleanValueOf,
+                                              value ? JNI_TRUE : JNI_FALSE);
   if (!boxed) return false;
   jstring jkey = env->NewStringUTF(key);
   if (!jkey) {
@@ -46,59 +42,32 @@ bool PutBoolean(JNIEnv* env, jobject map, jmethodID putId, const char* key, bool
 }
 
 jobject BuildDetectedModelsList(JNIEnv* env, const std::vector<DetectedModel>& models) {
-  jclass listClass = env->FindClass("java/util/ArrayList");
-  if (!listClass) return nullptr;
-  jmethodID listInit = env->GetMethodID(listClass, "<init>", "()V");
-  jmethodID listAdd = env->GetMethodID(listClass, "add", "(Ljava/lang/Object;)Z");
-  if (!listInit || !listAdd) {
-    env->DeleteLocalRef(listClass);
-    return nullptr;
-  }
-  jobject list = env->NewObject(listClass, listInit);
-  env->DeleteLocalRef(listClass);
+  const JniCache& cache = GetJniCache();
+  if (!cache.arrayListClass || !cache.arrayListInit || !cache.arrayListAdd) return nullptr;
+  if (!cache.hashMapClass || !cache.hashMapInit || !cache.hashMapPut) return nullptr;
+  jobject list = env->NewObject(cache.arrayListClass, cache.arrayListInit);
   if (!list) return nullptr;
 
-  jclass mapClass = env->FindClass("java/util/HashMap");
-  if (!mapClass) {
-    env->DeleteLocalRef(list);
-    return nullptr;
-  }
-  jmethodID mapInit = env->GetMethodID(mapClass, "<init>", "()V");
-  jmethodID mapPut = env->GetMethodID(mapClass, "put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
-  if (!mapInit || !mapPut) {
-    env->DeleteLocalRef(mapClass);
-    env->DeleteLocalRef(list);
-    return nullptr;
-  }
-
   for (const auto& m : models) {
-    jobject modelMap = env->NewObject(mapClass, mapInit);
+    jobject modelMap = env->NewObject(cache.hashMapClass, cache.hashMapInit);
     if (!modelMap) continue;
-    PutString(env, modelMap, mapPut, "type", m.type);
-    PutString(env, modelMap, mapPut, "modelDir", m.modelDir);
-    env->CallBooleanMethod(list, listAdd, modelMap);
+    PutString(env, modelMap, cache.hashMapPut, "type", m.type);
+    PutString(env, modelMap, cache.hashMapPut, "modelDir", m.modelDir);
+    env->CallBooleanMethod(list, cache.arrayListAdd, modelMap);
     env->DeleteLocalRef(modelMap);
   }
-  env->DeleteLocalRef(mapClass);
   return list;
 }
 
 jobject BuildStringList(JNIEnv* env, const std::vector<std::string>& strings) {
-  jclass listClass = env->FindClass("java/util/ArrayList");
-  if (!listClass) return nullptr;
-  jmethodID listInit = env->GetMethodID(listClass, "<init>", "()V");
-  jmethodID listAdd = env->GetMethodID(listClass, "add", "(Ljava/lang/Object;)Z");
-  if (!listInit || !listAdd) {
-    env->DeleteLocalRef(listClass);
-    return nullptr;
-  }
-  jobject list = env->NewObject(listClass, listInit);
-  env->DeleteLocalRef(listClass);
+  const JniCache& cache = GetJniCache();
+  if (!cache.arrayListClass || !cache.arrayListInit || !cache.arrayListAdd) return nullptr;
+  jobject list = env->NewObject(cache.arrayListClass, cache.arrayListInit);
   if (!list) return nullptr;
   for (const auto& s : strings) {
     jstring jval = env->NewStringUTF(s.c_str());
     if (jval) {
-      env->CallBooleanMethod(list, listAdd, jval);
+      env->CallBooleanMethod(list, cache.arrayListAdd, jval);
       env->DeleteLocalRef(jval);
     }
   }
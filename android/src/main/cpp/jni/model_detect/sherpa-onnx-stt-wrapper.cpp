@@ -6,6 +6,7 @@
  */
 #include "sherpa-onnx-stt-wrapper.h"
 #include "sherpa-onnx-detect-jni-common.h"
+#include "sherpa-onnx-jni-cache.h"
 #include "sherpa-onnx-model-detect.h"
 
 namespace sherpaonnx {
@@ -39,16 +40,12 @@ const char* SttModelKindToString(SttModelKind k) {
 }  // namespace
 
 jobject SttDetectResultToJava(JNIEnv* env, const SttDetectResult& result) {
-  jclass mapClass = env->FindClass("java/util/HashMap");
-  if (!mapClass) return nullptr;
-  jmethodID mapInit = env->GetMethodID(mapClass, "<init>", "()V");
-  jmethodID mapPut = env->GetMethodID(mapClass, "put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
-  if (!mapInit || !mapPut) {
-    env->DeleteLocalRef(mapClass);
-    return nullptr;
-  }
+  const JniCache& cache = GetJniCache();
+  jclass mapClass = cache.hashMapClass;
+  jmethodID mapInit = cache.hashMapInit;
+  jmethodID mapPut = cache.hashMapPut;
+  if (!mapClass || !mapInit || !mapPut) return nullptr;
   jobject map = env->NewObject(mapClass, mapInit);
-  env->DeleteLocalRef(mapClass);
   if (!map) return nullptr;
 
   PutBoolean(env, map, mapPut, "success", result.ok);
@@ -62,40 +59,36 @@ jobject SttDetectResultToJava(JNIEnv* env, const SttDetectResult& result) {
     env->DeleteLocalRef(detectedList);
   }
 
-  jclass hashMapClass = env->FindClass("java/util/HashMap");
-  if (hashMapClass) {
-    jobject pathsMap = env->NewObject(hashMapClass, mapInit);
-    env->DeleteLocalRef(hashMapClass);
-    if (pathsMap) {
-      PutString(env, pathsMap, mapPut, "encoder", result.paths.encoder);
-      PutString(env, pathsMap, mapPut, "decoder", result.paths.decoder);
-      PutString(env, pathsMap, mapPut, "joiner", result.paths.joiner);
-      PutString(env, pathsMap, mapPut, "tokens", result.paths.tokens);
-      PutString(env, pathsMap, mapPut, "paraformerModel", result.paths.paraformerModel);
-      PutString(env, pathsMap, mapPut, "ctcModel", result.paths.ctcModel);
-      PutString(env, pathsMap, mapPut, "whisperEncoder", result.paths.whisperEncoder);
-      PutString(env, pathsMap, mapPut, "whisperDecoder", result.paths.whisperDecoder);
-      PutString(env, pathsMap, mapPut, "funasrEncoderAdaptor", result.paths.funasrEncoderAdaptor);
-      PutString(env, pathsMap, mapPut, "funasrLLM", result.paths.funasrLLM);
-      PutString(env, pathsMap, mapPut, "funasrEmbedding", result.paths.funasrEmbedding);
-      PutString(env, pathsMap, mapPut, "funasrTokenizer", result.paths.funasrTokenizer);
-      PutString(env, pathsMap, mapPut, "moonshinePreprocessor", result.paths.moonshinePreprocessor);
-      PutString(env, pathsMap, mapPut, "moonshineEncoder", result.paths.moonshineEncoder);
-      PutString(env, pathsMap, mapPut, "moonshineUncachedDecoder", result.paths.moonshineUncachedDecoder);
-      PutString(env, pathsMap, mapPut, "moonshineCachedDecoder", result.paths.moonshineCachedDecoder);
-      PutString(env, pathsMap, mapPut, "moonshineMergedDecoder", result.paths.moonshineMergedDecoder);
-      PutString(env, pathsMap, mapPut, "dolphinModel", result.paths.dolphinModel);
-      PutString(env, pathsMap, mapPut, "omnilingualModel", result.paths.omnilingualModel);
-      PutString(env, pathsMap, mapPut, "medasrModel", result.paths.medasrModel);
-      PutString(env, pathsMap, mapPut, "telespeechCtcModel", result.paths.telespeechCtcModel);
-      PutString(env, pathsMap, mapPut, "fireRedEncoder", result.paths.fireRedEncoder);
-      PutString(env, pathsMap, mapPut, "fireRedDecoder", result.paths.fireRedDecoder);
-      PutString(env, pathsMap, mapPut, "canaryEncoder", result.paths.canaryEncoder);
-      PutString(env, pathsMap, mapPut, "canaryDecoder", result.paths.canaryDecoder);
-      PutString(env, pathsMap, mapPut, "bpeVocab", result.paths.bpeVocab);
-      env->CallObjectMethod(map, mapPut, env->NewStringUTF("paths"), pathsMap);
-      env->DeleteLocalRef(pathsMap);
-    }
+  jobject pathsMap = env->NewObject(mapClass, mapInit);
+  if (pathsMap) {
+    PutString(env, pathsMap, mapPut, "encoder", result.paths.encoder);
+    PutString(env, pathsMap, mapPut, "decoder", result.paths.decoder);
+    PutString(env, pathsMap, mapPut, "joiner", result.paths.joiner);
+    PutString(env, pathsMap, mapPut, "tokens", result.paths.tokens);
+    PutString(env, pathsMap, mapPut, "paraformerModel", result.paths.paraformerModel);
+    PutString(env, pathsMap, mapPut, "ctcModel", result.paths.ctcModel);
+    PutString(env, pathsMap, mapPut, "whisperEncoder", result.paths.whisperEncoder);
+    PutString(env, pathsMap, mapPut, "whisperDecoder", result.paths.whisperDecoder);
+    PutString(env, pathsMap, mapPut, "funasrEncoderAdaptor", result.paths.funasrEncoderAdaptor);
+    PutString(env, pathsMap, mapPut, "funasrLLM", result.paths.funasrLLM);
+    PutString(env, pathsMap, mapPut, "funasrEmbedding", result.paths.funasrEmbedding);
+    PutString(env, pathsMap, mapPut, "funasrTokenizer", result.paths.funasrTokenizer);
+    PutString(env, pathsMap, mapPut, "moonshinePreprocessor", result.paths.moonshinePreprocessor);
+    PutString(env, pathsMap, mapPut, "moonshineEncoder", result.paths.moonshineEncoder);
+    PutString(env, pathsMap, mapPut, "moonshineUncachedDecoder", result.paths.moonshineUncachedDecoder);
+    PutString(env, pathsMap, mapPut, "moonshineCachedDecoder", result.paths.moonshineCachedDecoder);
+    PutString(env, pathsMap, mapPut, "moonshineMergedDecoder", result.paths.moonshineMergedDecoder);
+    PutString(env, pathsMap, mapPut, "dolphinModel", result.paths.dolphinModel);
+    PutString(env, pathsMap, mapPut, "omnilingualModel", result.paths.omnilingualModel);
+    PutString(env, pathsMap, mapPut, "medasrModel", result.paths.medasrModel);
+    PutString(env, pathsMap, mapPut, "telespeechCtcModel", result.paths.telespeechCtcModel);
+    PutString(env, pathsMap, mapPut, "fireRedEncoder", result.paths.fireRedEncoder);
+    PutString(env, pathsMap, mapPut, "fireRedDecoder", result.paths.fireRedDecoder);
+    PutString(env, pathsMap, mapPut, "canaryEncoder", result.paths.canaryEncoder);
+    PutString(env, pathsMap, mapPut, "canaryDecoder", result.paths.canaryDecoder);
+    PutString(env, pathsMap, mapPut, "bpeVocab", result.paths.bpeVocab);
+    env->CallObjectMethod(map, mapPut, env->NewStringUTF("paths"), pathsMap);
+    env->DeleteLocalRef(pathsMap);
   }
   return map;
 }
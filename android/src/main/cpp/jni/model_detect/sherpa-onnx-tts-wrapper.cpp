@@ -6,6 +6,7 @@
  */
 #include "sherpa-onnx-tts-wrapper.h"
 #include "sherpa-onnx-detect-jni-common.h"
+#include "sherpa-onnx-jni-cache.h"
 #include "sherpa-onnx-model-detect.h"
 
 namespace sherpaonnx {
@@ -27,16 +28,12 @@ const char* TtsModelKindToString(TtsModelKind k) {
 }  // namespace
 
 jobject TtsDetectResultToJava(JNIEnv* env, const TtsDetectResult& result) {
-  jclass mapClass = env->FindClass("java/util/HashMap");
-  if (!mapClass) return nullptr;
-  jmethodID mapInit = env->GetMethodID(mapClass, "<init>", "()V");
-  jmethodID mapPut = env->GetMethodID(mapClass, "put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
-  if (!mapInit || !mapPut) {
-    env->DeleteLocalRef(mapClass);
-    return nullptr;
-  }
+  const JniCache& cache = GetJniCache();
+  jclass mapClass = cache.hashMapClass;
+  jmethodID mapInit = cache.hashMapInit;
+  jmethodID mapPut = cache.hashMapPut;
+  if (!mapClass || !mapInit || !mapPut) return nullptr;
   jobject map = env->NewObject(mapClass, mapInit);
-  env->DeleteLocalRef(mapClass);
   if (!map) return nullptr;
 
   PutBoolean(env, map, mapPut, "success", result.ok);
@@ -59,30 +56,26 @@ jobject TtsDetectResultToJava(JNIEnv* env, const TtsDetectResult& result) {
     env->DeleteLocalRef(langCandidatesList);
   }
 
-  jclass hashMapClass = env->FindClass("java/util/HashMap");
-  if (hashMapClass) {
-    jobject pathsMap = env->NewObject(hashMapClass, mapInit);
-    env->DeleteLocalRef(hashMapClass);
-    if (pathsMap) {
-      PutString(env, pathsMap, mapPut, "ttsModel", result.paths.ttsModel);
-      PutString(env, pathsMap, mapPut, "tokens", result.paths.tokens);
-      PutString(env, pathsMap, mapPut, "lexicon", result.paths.lexicon);
-      PutString(env, pathsMap, mapPut, "dataDir", result.paths.dataDir);
-      PutString(env, pathsMap, mapPut, "voices", result.paths.voices);
-      PutString(env, pathsMap, mapPut, "acousticModel", result.paths.acousticModel);
-      PutString(env, pathsMap, mapPut, "vocoder", result.paths.vocoder);
-      PutString(env, pathsMap, mapPut, "encoder", result.paths.encoder);
-      PutString(env, pathsMap, mapPut, "decoder", result.paths.decoder);
-      PutString(env, pathsMap, mapPut, "lmFlow", result.paths.lmFlow);
-      PutString(env, pathsMap, mapPut, "lmMain", result.paths.lmMain);
-      PutString(env, pathsMap, mapPut, "textConditioner", result.paths.textConditioner);
-      PutString(env, pathsMap, mapPut, "vocabJson", result.paths.vocabJson);
-      PutString(env, pathsMap, mapPut, "tokenScoresJson", result.paths.tokenScoresJson);
-      jstring keyPaths = env->NewStringUTF("paths");
-      env->CallObjectMethod(map, mapPut, keyPaths, pathsMap);
-      env->DeleteLocalRef(keyPaths);
-      env->DeleteLocalRef(pathsMap);
-    }
+  jobject pathsMap = env->NewObject(mapClass, mapInit);
+  if (pathsMap) {
+    PutString(env, pathsMap, mapPut, "ttsModel", result.paths.ttsModel);
+    PutString(env, pathsMap, mapPut, "tokens", result.paths.tokens);
+    PutString(env, pathsMap, mapPut, "lexicon", result.paths.lexicon);
+    PutString(env, pathsMap, mapPut, "dataDir", result.paths.dataDir);
+    PutString(env, pathsMap, mapPut, "voices", result.paths.voices);
+    PutString(env, pathsMap, mapPut, "acousticModel", result.paths.acousticModel);
+    PutString(env, pathsMap, mapPut, "vocoder", result.paths.vocoder);
+    PutString(env, pathsMap, mapPut, "encoder", result.paths.encoder);
+    PutString(env, pathsMap, mapPut, "decoder", result.paths.decoder);
+    PutString(env, pathsMap, mapPut, "lmFlow", result.paths.lmFlow);
+    PutString(env, pathsMap, mapPut, "lmMain", result.paths.lmMain);
+    PutString(env, pathsMap, mapPut, "textConditioner", result.paths.textConditioner);
+    PutString(env, pathsMap, mapPut, "vocabJson", result.paths.vocabJson);
+    PutString(env, pathsMap, mapPut, "tokenScoresJson", result.paths.tokenScoresJson);
+    jstring keyPaths = env->NewStringUTF("paths");
+    env->CallObjectMethod(map, mapPut, keyPaths, pathsMap);
+    env->DeleteLocalRef(keyPaths);
+    env->DeleteLocalRef(pathsMap);
   }
   return map;
 }
@@ -0,0 +1,108 @@
+/**
+ * sherpa-onnx-jni-cache.cpp
+ *
+ * Purpose: JNI_OnLoad for libsherpaonnx. Stores the JavaVM and resolves the classes and method IDs
+ * used on hot paths (audio results, detect result maps, streaming callbacks, promises) exactly once.
+ * FindClass runs here because JNI_OnLoad executes with the app class loader, so com.sherpaonnx and
+ * React Native classes are visible.
+ */
+#include "sherpa-onnx-jni-cache.h"
+
+#include <android/log.h>
+
+#define LOG_TAG "SherpaOnnxJniCache"
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+namespace sherpaonnx {
+
+namespace {
+
+JniCache g_cache;
+
+// Resolve a class and promote it to a global ref. Returns null (and clears the exception) if missing.
+jclass FindGlobalClass(JNIEnv* env, const char* name) {
+  jclass local = env->FindClass(name);
+  if (!local) {
+    env->ExceptionClear();
+    LOGE("FindClass failed: %s", name);
+    return nullptr;
+  }
+  auto global = static_cast<jclass>(env->NewGlobalRef(local));
+  env->DeleteLocalRef(local);
+  return global;
+}
+
+jmethodID FindMethod(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+  if (!cls) return nullptr;
+  jmethodID id = env->GetMethodID(cls, name, sig);
+  if (!id) {
+    env->ExceptionClear();
+    LOGE("GetMethodID failed: %s%s", name, sig);
+  }
+  return id;
+}
+
+jmethodID FindStaticMethod(JNIEnv* env, jclass cls, const char* name, const char* sig) {
+  if (!cls) return nullptr;
+  jmethodID id = env->GetStaticMethodID(cls, name, sig);
+  if (!id) {
+    env->ExceptionClear();
+    LOGE("GetStaticMethodID failed: %s%s", name, sig);
+  }
+  return id;
+}
+
+void Populate(JNIEnv* env) {
+  JniCache& c = g_cache;
+
+  c.objectClass = FindGlobalClass(env, "java/lang/Object");
+  c.stringClass = FindGlobalClass(env, "java/lang/String");
+  c.integerClass = FindGlobalClass(env, "java/lang/Integer");
+  c.integerValueOf = FindStaticMethod(env, c.integerClass, "valueOf", "(I)Ljava/lang/Integer;");
+  c.booleanClass = FindGlobalClass(env, "java/lang/Boolean");
+  c.booleanValueOf = FindStaticMethod(env, c.booleanClass, "valueOf", "(Z)Ljava/lang/Boolean;");
+  c.hashMapClass = FindGlobalClass(env, "java/util/HashMap");
+  c.hashMapInit = FindMethod(env, c.hashMapClass, "<init>", "()V");
+  c.hashMapPut = FindMethod(env, c.hashMapClass, "put",
+                            "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
+  c.arrayListClass = FindGlobalClass(env, "java/util/ArrayList");
+  c.arrayListInit = FindMethod(env, c.arrayListClass, "<init>", "()V");
+  c.arrayListAdd = FindMethod(env, c.arrayListClass, "add", "(Ljava/lang/Object;)Z");
+
+  c.argumentsClass = FindGlobalClass(env, "com/facebook/react/bridge/Arguments");
+  c.argumentsCreateMap = FindStaticMethod(env, c.argumentsClass, "createMap",
+                                          "()Lcom/facebook/react/bridge/WritableMap;");
+  // Method IDs are only valid while their class stays loaded, so every class they come from is
+  // held as a global ref, even when native code never uses the class itself.
+  c.writableMapClass = FindGlobalClass(env, "com/facebook/react/bridge/WritableMap");
+  c.writableMapPutBoolean =
+      FindMethod(env, c.writableMapClass, "putBoolean", "(Ljava/lang/String;Z)V");
+  c.writableMapPutString =
+      FindMethod(env, c.writableMapClass, "putString", "(Ljava/lang/String;Ljava/lang/String;)V");
+  c.promiseClass = FindGlobalClass(env, "com/facebook/react/bridge/Promise");
+  c.promiseResolve = FindMethod(env, c.promiseClass, "resolve", "(Ljava/lang/Object;)V");
+  c.promiseReject =
+      FindMethod(env, c.promiseClass, "reject", "(Ljava/lang/String;Ljava/lang/String;)V");
+
+  c.zipvoiceClass = FindGlobalClass(env, "com/sherpaonnx/ZipvoiceTtsWrapper");
+  c.zipvoiceOnNativeChunk = FindMethod(env, c.zipvoiceClass, "onNativeChunk", "([FI)Z");
+  c.zipvoiceOnNativeRingData = FindMethod(env, c.zipvoiceClass, "onNativeRingData", "(I)Z");
+}
+
+}  // namespace
+
+const JniCache& GetJniCache() {
+  return g_cache;
+}
+
+}  // namespace sherpaonnx
+
+extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* /* reserved */) {
+  JNIEnv* env = nullptr;
+  if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
+    return -1;
+  }
+  sherpaonnx::g_cache.vm = vm;
+  sherpaonnx::Populate(env);
+  return JNI_VERSION_1_6;
+}
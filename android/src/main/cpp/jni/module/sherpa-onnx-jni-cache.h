@@ -0,0 +1,54 @@
+/**
+ * sherpa-onnx-jni-cache.h
+ *
+ * Declares the process-wide JNI reflection cache: the JavaVM plus global class refs and method IDs
+ * resolved once in JNI_OnLoad (sherpa-onnx-jni-cache.cpp). All JNI translation units use it instead
+ * of calling FindClass / GetMethodID per call. Entries are null if a class could not be resolved at
+ * load time; callers must check before use.
+ */
+#ifndef SHERPA_ONNX_JNI_CACHE_H
+#define SHERPA_ONNX_JNI_CACHE_H
+
+#include <jni.h>
+
+namespace sherpaonnx {
+
+struct JniCache {
+  JavaVM* vm = nullptr;
+
+  // java.lang / java.util
+  jclass objectClass = nullptr;
+  jclass stringClass = nullptr;
+  jclass integerClass = nullptr;
+  jmethodID integerValueOf = nullptr;
+  jclass booleanClass = nullptr;
+  jmethodID booleanValueOf = nullptr;
+  jclass hashMapClass = nullptr;
+  jmethodID hashMapInit = nullptr;
+  jmethodID hashMapPut = nullptr;
+  jclass arrayListClass = nullptr;
+  jmethodID arrayListInit = nullptr;
+  jmethodID arrayListAdd = nullptr;
+
+  // com.facebook.react.bridge
+  jclass argumentsClass = nullptr;
+  jmethodID argumentsCreateMap = nullptr;
+  jclass writableMapClass = nullptr;
+  jmethodID writableMapPutBoolean = nullptr;
+  jmethodID writableMapPutString = nullptr;
+  jclass promiseClass = nullptr;
+  jmethodID promiseResolve = nullptr;
+  jmethodID promiseReject = nullptr;
+
+  // com.sherpaonnx (callbacks invoked from native)
+  jclass zipvoiceClass = nullptr;
+  jmethodID zipvoiceOnNativeChunk = nullptr;
+  jmethodID zipvoiceOnNativeRingData = nullptr;
+};
+
+/** Cache populated in JNI_OnLoad. Read-only afterwards, so safe to use from any thread. */
+const JniCache& GetJniCache();
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_JNI_CACHE_H
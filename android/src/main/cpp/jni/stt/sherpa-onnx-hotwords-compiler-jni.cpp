@@ -0,0 +1,64 @@
+/**
+ * sherpa-onnx-hotwords-compiler-jni.cpp
+ *
+ * Purpose: JNI for HotwordsCompiler (Kotlin). Stateless: compiles a hotwords file or per-stream
+ * hotwords string with sherpa-onnx-hotwords-compiler.cpp and returns the result to Kotlin.
+ */
+#include <jni.h>
+#include <string>
+
+#include "sherpa-onnx-hotwords-compiler.h"
+#include "sherpa-onnx-jni-cache.h"
+
+namespace {
+
+std::string ToStdString(JNIEnv* env, jstring s) {
+  if (!s) return std::string();
+  const char* c = env->GetStringUTFChars(s, nullptr);
+  std::string out = c ? c : "";
+  if (c) env->ReleaseStringUTFChars(s, c);
+  return out;
+}
+
+}  // namespace
+
+extern "C" {
+
+// String[] { error, compiled path or string, oov samples... };
+// out = { ok, entries, duplicates, oovLines, vocabChecked, cached, compileMs }.
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_HotwordsCompiler_nativeCompile(JNIEnv* env, jclass /* clazz */, jstring input, jboolean isFile,
+                                                   jstring tokensPath, jstring bpeVocabPath, jstring modelingUnit,
+                                                   jstring cacheDir, jdoubleArray out) {
+  if (!out || env->GetArrayLength(out) < 7) return nullptr;
+  sherpaonnx::HotwordsCompileOptions options;
+  options.tokensPath = ToStdString(env, tokensPath);
+  options.bpeVocabPath = ToStdString(env, bpeVocabPath);
+  options.modelingUnit = ToStdString(env, modelingUnit);
+  options.cacheDir = ToStdString(env, cacheDir);
+  const std::string text = ToStdString(env, input);
+  const sherpaonnx::HotwordsCompileResult r = isFile == JNI_TRUE ? sherpaonnx::CompileHotwordsFile(text, options)
+                                                                  : sherpaonnx::CompileHotwordsText(text, options);
+
+  const jdouble values[7] = {r.ok ? 1.0 : 0.0, static_cast<jdouble>(r.entries), static_cast<jdouble>(r.duplicates),
+                             static_cast<jdouble>(r.oovLines), r.vocabChecked ? 1.0 : 0.0, r.cached ? 1.0 : 0.0,
+                             r.compileMs};
+  env->SetDoubleArrayRegion(out, 0, 7, values);
+  jclass stringClass = sherpaonnx::GetJniCache().stringClass;
+  if (!stringClass) return nullptr;
+  const jsize n = static_cast<jsize>(2 + r.oovSamples.size());
+  jobjectArray strings = env->NewObjectArray(n, stringClass, nullptr);
+  if (!strings) return nullptr;
+  auto put = [&](jsize i, const std::string& s) {
+    jstring js = env->NewStringUTF(s.c_str());
+    if (!js) return;
+    env->SetObjectArrayElement(strings, i, js);
+    env->DeleteLocalRef(js);
+  };
+  put(0, r.error);
+  put(1, isFile == JNI_TRUE ? r.compiledPath : r.text);
+  for (size_t i = 0; i < r.oovSamples.size(); ++i) put(static_cast<jsize>(2 + i), r.oovSamples[i]);
+  return strings;
+}
+
+}  // extern "C"
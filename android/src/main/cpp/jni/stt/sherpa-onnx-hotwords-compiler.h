@@ -0,0 +1,75 @@
+/**
+ * sherpa-onnx-hotwords-compiler.h
+ *
+ * Declares the hotwords compiler: validates a hotwords file (or a per-stream hotwords string)
+ * once, checks every phrase against the model's tokens.txt / bpe.vocab the way sherpa-onnx will
+ * tokenize it, drops lines it would reject, merges duplicates and caches the compact result keyed
+ * by the file content and the model vocabulary. Later inits (and setConfig / createStream with the
+ * same hotwords) reuse the compiled form instead of re-reading and re-checking the file.
+ *
+ * sherpa-onnx only takes hotwords as text (hotwords_file, CreateStream(hotwords)), so the
+ * compiled form is a text file / string with one "phrase[ :score]" entry per line.
+ */
+#ifndef SHERPA_ONNX_HOTWORDS_COMPILER_H
+#define SHERPA_ONNX_HOTWORDS_COMPILER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sherpaonnx {
+
+struct HotwordsCompileOptions {
+  /** Model tokens.txt; empty or unreadable = no vocabulary check (validation and dedup only). */
+  std::string tokensPath;
+  /** sentencepiece bpe.vocab for "bpe" / "cjkchar+bpe"; only part of the cache key. */
+  std::string bpeVocabPath;
+  /** "cjkchar" (also used when empty), "bpe" or "cjkchar+bpe". */
+  std::string modelingUnit;
+  /** Directory for compiled files (created when missing); required by CompileHotwordsFile. */
+  std::string cacheDir;
+};
+
+struct HotwordsCompileResult {
+  bool ok = false;
+  /** Same messages as the former platform validators (INVALID_HOTWORDS_FILE). */
+  std::string error;
+  /** CompileHotwordsFile: compiled file to pass as hotwords_file. */
+  std::string compiledPath;
+  /** CompileHotwordsText: compiled '/'-separated string to pass to CreateStream(hotwords). */
+  std::string text;
+  /** Phrases kept. */
+  int32_t entries = 0;
+  /** Lines merged into an earlier identical phrase (the higher explicit score is kept). */
+  int32_t duplicates = 0;
+  /** Lines dropped because a token is not in the model vocabulary. */
+  int32_t oovLines = 0;
+  /** Up to five of the dropped phrases, for logging. */
+  std::vector<std::string> oovSamples;
+  /** False when tokens.txt could not be read and no vocabulary check was done. */
+  bool vocabChecked = false;
+  /** Served from the cache (disk for files, memory for strings). */
+  bool cached = false;
+  /** Time spent in this call. */
+  double compileMs = 0.0;
+};
+
+/**
+ * Compile a hotwords file into options.cacheDir as hw-<key>.txt (+ .meta with the counts), where
+ * key hashes the file content, tokens.txt, bpe.vocab and the modeling unit. A cache hit costs one
+ * read of the hotwords file; tokens.txt is only hashed again when its size or mtime changed. A path
+ * that already is a compiled file in cacheDir is returned as is. Fails (ok = false) on the same
+ * format errors as before, and when no phrase survives the vocabulary check. Files returned in
+ * this process are kept when the cache is pruned, as a recognizer config may still name them.
+ */
+HotwordsCompileResult CompileHotwordsFile(const std::string& path, const HotwordsCompileOptions& options);
+
+/**
+ * Same for a per-stream hotwords string (lines separated by '/' or newlines, as sherpa-onnx
+ * CreateStream expects); compiled strings are cached in memory.
+ */
+HotwordsCompileResult CompileHotwordsText(const std::string& hotwords, const HotwordsCompileOptions& options);
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_HOTWORDS_COMPILER_H
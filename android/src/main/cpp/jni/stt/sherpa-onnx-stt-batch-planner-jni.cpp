@@ -0,0 +1,73 @@
+/**
+ * sherpa-onnx-stt-batch-planner-jni.cpp
+ *
+ * Purpose: JNI for SttBatchPlanner (Kotlin). Estimates each input's duration from its header and
+ * groups the inputs into length-sorted batches for transcribeFiles.
+ */
+#include <jni.h>
+#include <string>
+#include <vector>
+
+#include "sherpa-onnx-jni-cache.h"
+#include "sherpa-onnx-stt-batch-planner.h"
+
+namespace {
+
+std::string ToStdString(JNIEnv* env, jstring s) {
+  if (!s) return std::string();
+  const char* c = env->GetStringUTFChars(s, nullptr);
+  std::string out = c ? c : "";
+  if (c) env->ReleaseStringUTFChars(s, c);
+  return out;
+}
+
+}  // namespace
+
+extern "C" {
+
+// Object[] { double[n] estimated seconds (-1 = unknown), int[n] indices in batch order,
+// int[numBatches] batch sizes }.
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_SttBatchPlanner_nativePlan(JNIEnv* env, jclass /* clazz */, jobjectArray paths,
+                                               jint maxBatchSize, jdouble maxPaddedSeconds) {
+  const sherpaonnx::JniCache& cache = sherpaonnx::GetJniCache();
+  if (!paths || !cache.objectClass) return nullptr;
+  const jsize n = env->GetArrayLength(paths);
+  std::vector<double> seconds(static_cast<size_t>(n));
+  for (jsize i = 0; i < n; ++i) {
+    auto path = static_cast<jstring>(env->GetObjectArrayElement(paths, i));
+    seconds[static_cast<size_t>(i)] = sherpaonnx::EstimateAudioFileSeconds(ToStdString(env, path));
+    env->DeleteLocalRef(path);
+  }
+  sherpaonnx::SttBatchOptions options;
+  options.maxBatchSize = maxBatchSize;
+  options.maxPaddedSeconds = maxPaddedSeconds;
+  const sherpaonnx::SttBatchPlan plan = sherpaonnx::PlanSttBatches(seconds, options);
+
+  std::vector<jint> order;
+  std::vector<jint> sizes;
+  order.reserve(seconds.size());
+  sizes.reserve(plan.size());
+  for (const auto& batch : plan) {
+    sizes.push_back(static_cast<jint>(batch.size()));
+    for (size_t index : batch) order.push_back(static_cast<jint>(index));
+  }
+
+  jdoubleArray jseconds = env->NewDoubleArray(n);
+  jintArray jorder = env->NewIntArray(static_cast<jsize>(order.size()));
+  jintArray jsizes = env->NewIntArray(static_cast<jsize>(sizes.size()));
+  jobjectArray out = env->NewObjectArray(3, cache.objectClass, nullptr);
+  if (!jseconds || !jorder || !jsizes || !out) return nullptr;
+  if (n > 0) env->SetDoubleArrayRegion(jseconds, 0, n, seconds.data());
+  if (!order.empty()) env->SetIntArrayRegion(jorder, 0, static_cast<jsize>(order.size()), order.data());
+  if (!sizes.empty()) env->SetIntArrayRegion(jsizes, 0, static_cast<jsize>(sizes.size()), sizes.data());
+  env->SetObjectArrayElement(out, 0, jseconds);
+  env->SetObjectArrayElement(out, 1, jorder);
+  env->SetObjectArrayElement(out, 2, jsizes);
+  env->DeleteLocalRef(jseconds);
+  env->DeleteLocalRef(jorder);
+  env->DeleteLocalRef(jsizes);
+  return out;
+}
+
+}  // extern "C"
@@ -0,0 +1,85 @@
+/**
+ * sherpa-onnx-stt-long-form-jni.cpp
+ *
+ * Purpose: JNI for SpeechRangeBuilder (Kotlin). Turns VAD speech segments into padded, merged decode
+ * ranges for transcribeLongFile and joins the per-range transcripts.
+ */
+#include <jni.h>
+#include <string>
+#include <vector>
+
+#include "sherpa-onnx-stt-long-form.h"
+
+namespace {
+
+sherpaonnx::SpeechRangeBuilder* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::SpeechRangeBuilder*>(ptr);
+}
+
+// Flattened { start0, end0, start1, end1, ... }.
+jlongArray ToJava(JNIEnv* env, const std::vector<sherpaonnx::SpeechRange>& ranges) {
+  jlongArray out = env->NewLongArray(static_cast<jsize>(ranges.size() * 2));
+  if (!out || ranges.empty()) return out;
+  std::vector<jlong> flat;
+  flat.reserve(ranges.size() * 2);
+  for (const auto& r : ranges) {
+    flat.push_back(static_cast<jlong>(r.start));
+    flat.push_back(static_cast<jlong>(r.end));
+  }
+  env->SetLongArrayRegion(out, 0, static_cast<jsize>(flat.size()), flat.data());
+  return out;
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_SpeechRangeBuilder_nativeCreate(JNIEnv* /* env */, jclass /* clazz */,
+                                                    jlong paddingSamples, jlong maxRangeSamples) {
+  sherpaonnx::SpeechRangeOptions options;
+  options.paddingSamples = paddingSamples;
+  options.maxRangeSamples = maxRangeSamples;
+  return reinterpret_cast<jlong>(new sherpaonnx::SpeechRangeBuilder(options));
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_SpeechRangeBuilder_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_com_sherpaonnx_SpeechRangeBuilder_nativePush(JNIEnv* env, jclass /* clazz */, jlong ptr, jlong start,
+                                                  jlong length) {
+  auto* builder = FromHandle(ptr);
+  if (!builder) return nullptr;
+  return ToJava(env, builder->Push(start, length));
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_com_sherpaonnx_SpeechRangeBuilder_nativeFinish(JNIEnv* env, jclass /* clazz */, jlong ptr,
+                                                    jlong totalSamples) {
+  auto* builder = FromHandle(ptr);
+  if (!builder) return nullptr;
+  return ToJava(env, builder->Finish(totalSamples));
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_sherpaonnx_SpeechRangeBuilder_nativeJoinTexts(JNIEnv* env, jclass /* clazz */, jobjectArray texts) {
+  std::vector<std::string> parts;
+  const jsize n = texts ? env->GetArrayLength(texts) : 0;
+  parts.reserve(static_cast<size_t>(n));
+  for (jsize i = 0; i < n; ++i) {
+    auto text = static_cast<jstring>(env->GetObjectArrayElement(texts, i));
+    if (!text) continue;
+    const char* c = env->GetStringUTFChars(text, nullptr);
+    if (c) {
+      parts.emplace_back(c);
+      env->ReleaseStringUTFChars(text, c);
+    }
+    env->DeleteLocalRef(text);
+  }
+  return env->NewStringUTF(sherpaonnx::JoinSegmentTexts(parts).c_str());
+}
+
+}  // extern "C"
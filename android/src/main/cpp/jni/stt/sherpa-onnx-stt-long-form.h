@@ -0,0 +1,61 @@
+/**
+ * sherpa-onnx-stt-long-form.h
+ *
+ * Declares the platform-independent parts of VAD-segmented long-form transcription: turning raw
+ * VAD speech segments into padded, merged and length-capped decode ranges, and joining per-segment
+ * text. The VAD itself and decoding stay in the platform bridges.
+ */
+#ifndef SHERPA_ONNX_STT_LONG_FORM_H
+#define SHERPA_ONNX_STT_LONG_FORM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sherpaonnx {
+
+/** Half-open sample range [start, end) of the source audio. */
+struct SpeechRange {
+  int64_t start = 0;
+  int64_t end = 0;
+};
+
+struct SpeechRangeOptions {
+  /** Context added before and after each VAD segment (clamped to the audio and to earlier ranges). */
+  int64_t paddingSamples = 0;
+  /** Upper bound of one range; neighbours are only merged below it, longer speech is split. 0 = no cap. */
+  int64_t maxRangeSamples = 0;
+};
+
+/**
+ * Incremental: VAD segments arrive in time order while the file is still being scanned, and each
+ * Push returns the ranges that later segments can no longer change, so decoding can start before
+ * the scan ends. Overlapping padded segments are merged while the result stays within the cap.
+ */
+class SpeechRangeBuilder {
+ public:
+  explicit SpeechRangeBuilder(const SpeechRangeOptions& options) : options_(options) {}
+
+  /** Add the VAD segment [start, start + length). Returns finalized ranges (possibly none). */
+  std::vector<SpeechRange> Push(int64_t start, int64_t length);
+
+  /** End of audio: clamp to totalSamples and return the remaining ranges. */
+  std::vector<SpeechRange> Finish(int64_t totalSamples);
+
+ private:
+  void Emit(const SpeechRange& range, std::vector<SpeechRange>* out) const;
+
+  SpeechRangeOptions options_;
+  bool hasPending_ = false;
+  SpeechRange pending_;
+};
+
+/**
+ * Join per-segment transcripts: trims each, drops empty ones, and separates with a space unless
+ * both sides of the boundary are CJK (those scripts are written without spaces).
+ */
+std::string JoinSegmentTexts(const std::vector<std::string>& texts);
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_STT_LONG_FORM_H
@@ -0,0 +1,137 @@
+/**
+ * sherpa-onnx-stt-tuner-jni.cpp
+ *
+ * Purpose: JNI for SttAutoTuner (Kotlin). Exposes the candidate search, winner selection, stored
+ * choice format, model key and process memory probe of sherpa-onnx-stt-tuner.cpp to tuneStt.
+ */
+#include <jni.h>
+#include <string>
+#include <vector>
+
+#include "sherpa-onnx-stt-tuner.h"
+
+namespace {
+
+struct TunerHandle {
+  explicit TunerHandle(const sherpaonnx::SttTuneOptions& options) : tuner(options) {}
+  sherpaonnx::SttAutoTuner tuner;
+  sherpaonnx::ProcessMemoryProbe probe;
+};
+
+TunerHandle* FromHandle(jlong ptr) { return reinterpret_cast<TunerHandle*>(ptr); }
+
+std::string ToString(JNIEnv* env, jstring value) {
+  if (!value) return {};
+  const char* c = env->GetStringUTFChars(value, nullptr);
+  if (!c) return {};
+  std::string out(c);
+  env->ReleaseStringUTFChars(value, c);
+  return out;
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_SttAutoTuner_nativeCreate(JNIEnv* env, jclass /* clazz */, jint maxThreads,
+                                              jobjectArray providers, jboolean hasInt8, jboolean hasFp32,
+                                              jlong maxMemoryBytes, jdouble tolerance) {
+  sherpaonnx::SttTuneOptions options;
+  options.maxThreads = maxThreads;
+  const jsize n = providers ? env->GetArrayLength(providers) : 0;
+  for (jsize i = 0; i < n; ++i) {
+    auto provider = static_cast<jstring>(env->GetObjectArrayElement(providers, i));
+    options.providers.push_back(ToString(env, provider));
+    if (provider) env->DeleteLocalRef(provider);
+  }
+  options.hasInt8 = hasInt8 == JNI_TRUE;
+  options.hasFp32 = hasFp32 == JNI_TRUE;
+  options.maxMemoryBytes = maxMemoryBytes;
+  options.tolerance = tolerance;
+  return reinterpret_cast<jlong>(new TunerHandle(options));
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_SttAutoTuner_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+// Provider of the next candidate (null when done); out[0] = threads, out[1] = int8 (0/1).
+JNIEXPORT jstring JNICALL
+Java_com_sherpaonnx_SttAutoTuner_nativeNext(JNIEnv* env, jclass /* clazz */, jlong ptr, jintArray out) {
+  auto* handle = FromHandle(ptr);
+  sherpaonnx::SttTuneCandidate candidate;
+  if (!handle || !out || env->GetArrayLength(out) < 2 || !handle->tuner.Next(&candidate)) return nullptr;
+  const jint values[2] = {candidate.numThreads, candidate.int8 ? 1 : 0};
+  env->SetIntArrayRegion(out, 0, 2, values);
+  return env->NewStringUTF(candidate.provider.c_str());
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_SttAutoTuner_nativeReport(JNIEnv* env, jclass /* clazz */, jlong ptr, jint numThreads,
+                                              jstring provider, jboolean int8, jboolean ok, jstring error,
+                                              jdouble loadMs, jdouble decodeMs, jdouble audioMs,
+                                              jlong peakMemoryBytes) {
+  auto* handle = FromHandle(ptr);
+  if (!handle) return;
+  sherpaonnx::SttTuneMeasurement m;
+  m.candidate.numThreads = numThreads;
+  m.candidate.provider = ToString(env, provider);
+  m.candidate.int8 = int8 == JNI_TRUE;
+  m.ok = ok == JNI_TRUE && audioMs > 0.0;
+  m.error = ToString(env, error);
+  m.loadMs = loadMs;
+  m.decodeMs = decodeMs;
+  m.audioMs = audioMs;
+  m.rtf = audioMs > 0.0 ? decodeMs / audioMs : 0.0;
+  m.peakMemoryBytes = peakMemoryBytes;
+  handle->tuner.Report(m);
+}
+
+// Serialized winner (see nativeParse), or null when no candidate worked.
+JNIEXPORT jstring JNICALL
+Java_com_sherpaonnx_SttAutoTuner_nativeBest(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  auto* handle = FromHandle(ptr);
+  sherpaonnx::SttTuneMeasurement best;
+  if (!handle || !handle->tuner.Best(&best)) return nullptr;
+  return env->NewStringUTF(sherpaonnx::SerializeSttTuneChoice(best).c_str());
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_SttAutoTuner_nativeProbeBegin(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  if (auto* handle = FromHandle(ptr)) handle->probe.Begin();
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_SttAutoTuner_nativeProbeSample(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  if (auto* handle = FromHandle(ptr)) handle->probe.Sample();
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_SttAutoTuner_nativeProbePeak(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  auto* handle = FromHandle(ptr);
+  return handle ? static_cast<jlong>(handle->probe.PeakDeltaBytes()) : 0;
+}
+
+// Provider of a stored choice (null if it does not parse); out = { threads, int8, rtf, memory }.
+JNIEXPORT jstring JNICALL
+Java_com_sherpaonnx_SttAutoTuner_nativeParse(JNIEnv* env, jclass /* clazz */, jstring text, jdoubleArray out) {
+  sherpaonnx::SttTuneMeasurement m;
+  if (!out || env->GetArrayLength(out) < 4 || !sherpaonnx::ParseSttTuneChoice(ToString(env, text), &m)) {
+    return nullptr;
+  }
+  const jdouble values[4] = {static_cast<jdouble>(m.candidate.numThreads), m.candidate.int8 ? 1.0 : 0.0, m.rtf,
+                             static_cast<jdouble>(m.peakMemoryBytes)};
+  env->SetDoubleArrayRegion(out, 0, 4, values);
+  return env->NewStringUTF(m.candidate.provider.c_str());
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_sherpaonnx_SttAutoTuner_nativeModelKey(JNIEnv* env, jclass /* clazz */, jstring modelDir,
+                                                jstring modelType) {
+  const std::string key = sherpaonnx::SttTuneModelKey(ToString(env, modelDir), ToString(env, modelType));
+  return env->NewStringUTF(key.c_str());
+}
+
+}  // extern "C"
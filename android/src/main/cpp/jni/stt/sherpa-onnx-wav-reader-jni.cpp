@@ -0,0 +1,119 @@
+/**
+ * sherpa-onnx-wav-reader-jni.cpp
+ *
+ * Purpose: JNI for WavFileReader (Kotlin). Owns one native sherpaonnx::WavFileReader per handle so
+ * long recordings can be scanned and read back range by range, and WAV inputs are converted from
+ * a memory mapping instead of being loaded whole.
+ */
+#include <jni.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "sherpa-onnx-wav-reader.h"
+
+namespace {
+
+std::string ToStdString(JNIEnv* env, jstring s) {
+  if (!s) return std::string();
+  const char* c = env->GetStringUTFChars(s, nullptr);
+  std::string out = c ? c : "";
+  if (c) env->ReleaseStringUTFChars(s, c);
+  return out;
+}
+
+sherpaonnx::WavFileReader* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::WavFileReader*>(ptr);
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_WavFileReader_nativeCreate(JNIEnv* /* env */, jclass /* clazz */) {
+  return reinterpret_cast<jlong>(new sherpaonnx::WavFileReader());
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_WavFileReader_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+// Error message, or null when the file was opened.
+JNIEXPORT jstring JNICALL
+Java_com_sherpaonnx_WavFileReader_nativeOpen(JNIEnv* env, jclass /* clazz */, jlong ptr, jstring path) {
+  auto* reader = FromHandle(ptr);
+  if (!reader) return env->NewStringUTF("Reader released");
+  if (reader->Open(ToStdString(env, path))) return nullptr;
+  return env->NewStringUTF(reader->Error().c_str());
+}
+
+// long[] { sampleRate, numChannels, numFrames }.
+JNIEXPORT jlongArray JNICALL
+Java_com_sherpaonnx_WavFileReader_nativeInfo(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  auto* reader = FromHandle(ptr);
+  jlongArray out = env->NewLongArray(3);
+  if (!out) return nullptr;
+  const jlong info[3] = {reader ? reader->SampleRate() : 0, reader ? reader->NumChannels() : 0,
+                         reader ? static_cast<jlong>(reader->NumFrames()) : 0};
+  env->SetLongArrayRegion(out, 0, 3, info);
+  return out;
+}
+
+// Frames read into out[0, count) (mono), 0 past the end, -1 on error. Converted one window at a
+// time into a small native buffer and copied into the Java array, so the call never holds a second
+// full-size copy (GetFloatArrayElements may copy the whole array).
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_WavFileReader_nativeRead(JNIEnv* env, jclass /* clazz */, jlong ptr, jlong start,
+                                             jfloatArray out, jint count) {
+  auto* reader = FromHandle(ptr);
+  if (!reader || !out || count < 0 || count > env->GetArrayLength(out)) return -1;
+  constexpr jint kWindowFrames = 64 * 1024;
+  std::vector<float> window(static_cast<size_t>(std::min(count, kWindowFrames)));
+  jint done = 0;
+  while (done < count) {
+    const jint want = std::min(count - done, kWindowFrames);
+    const int64_t got = reader->ReadMono(start + done, want, window.data());
+    if (got < 0) return -1;
+    if (got == 0) break;
+    env->SetFloatArrayRegion(out, done, static_cast<jsize>(got), window.data());
+    done += static_cast<jint>(got);
+    if (got < want) break;
+  }
+  return done;
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_WavFileReader_nativeClose(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  auto* reader = FromHandle(ptr);
+  if (reader) reader->Close();
+}
+
+// Raw mono PCM bytes (encoding: sherpaonnx::PcmEncoding) to a new float array, converted in place
+// from the pinned Java arrays (SIMD for int16). Null on allocation failure.
+JNIEXPORT jfloatArray JNICALL
+Java_com_sherpaonnx_WavFileReader_nativePcmToFloat(JNIEnv* env, jclass /* clazz */, jbyteArray bytes,
+                                                   jint encoding) {
+  if (!bytes) return env->NewFloatArray(0);
+  const auto pcmEncoding = encoding == static_cast<jint>(sherpaonnx::PcmEncoding::kFloat32)
+                               ? sherpaonnx::PcmEncoding::kFloat32
+                               : sherpaonnx::PcmEncoding::kInt16;
+  const jsize numBytes = env->GetArrayLength(bytes);
+  const jsize n = static_cast<jsize>(static_cast<size_t>(numBytes) / sherpaonnx::PcmBytesPerSample(pcmEncoding));
+  jfloatArray out = env->NewFloatArray(n);
+  if (!out || n == 0) return out;
+  void* in = env->GetPrimitiveArrayCritical(bytes, nullptr);
+  if (!in) return nullptr;
+  void* dst = env->GetPrimitiveArrayCritical(out, nullptr);
+  if (!dst) {
+    env->ReleasePrimitiveArrayCritical(bytes, in, JNI_ABORT);
+    return nullptr;
+  }
+  sherpaonnx::PcmBytesToFloat(in, static_cast<size_t>(numBytes), pcmEncoding, static_cast<float*>(dst));
+  env->ReleasePrimitiveArrayCritical(out, dst, 0);
+  env->ReleasePrimitiveArrayCritical(bytes, in, JNI_ABORT);
+  return out;
+}
+
+}  // extern "C"
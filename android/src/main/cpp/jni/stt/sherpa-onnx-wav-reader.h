@@ -0,0 +1,100 @@
+/**
+ * sherpa-onnx-wav-reader.h
+ *
+ * Declares WavFileReader: random-access reads of a WAV file's samples, downmixed to mono float,
+ * without loading the whole file. The file is memory-mapped where the platform allows it and
+ * converted window by window (SIMD for 16-bit PCM), so a read never holds the file bytes and the
+ * float copy at the same time. Long-form transcription scans a recording with VAD and then reads
+ * back only the speech ranges, so memory stays bounded by a few segments. The same converters
+ * turn raw PCM buffers (transcribePcm) into float samples.
+ */
+#ifndef SHERPA_ONNX_WAV_READER_H
+#define SHERPA_ONNX_WAV_READER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace sherpaonnx {
+
+/**
+ * Convert 16-bit PCM to float in [-1, 1) (divide by 32768). Uses NEON on ARM and SSE2 on x86,
+ * with a scalar tail; results are identical on every path.
+ */
+void Int16ToFloat(const int16_t* in, float* out, size_t n);
+
+/** Raw mono little-endian PCM accepted by PcmBytesToFloat. */
+enum class PcmEncoding : int32_t { kInt16 = 0, kFloat32 = 1 };
+
+/** "int16" / "s16le" or "float32" / "f32le"; false (encoding untouched) for anything else. */
+bool ParsePcmEncoding(const std::string& name, PcmEncoding* encoding);
+
+size_t PcmBytesPerSample(PcmEncoding encoding);
+
+/**
+ * Convert raw PCM bytes to float in [-1, 1]: int16 through Int16ToFloat, float32 copied as is. data
+ * needs no alignment; out must hold bytes / PcmBytesPerSample(encoding) floats. Returns the number
+ * of samples written (a trailing partial sample is ignored).
+ */
+size_t PcmBytesToFloat(const void* data, size_t bytes, PcmEncoding encoding, float* out);
+
+/**
+ * Supports PCM 8/16/24/32-bit and IEEE float 32-bit (also in WAVE_FORMAT_EXTENSIBLE). Not
+ * thread-safe: use one reader per thread (opening is cheap: the header is parsed and the file
+ * mapped, nothing is read ahead).
+ */
+class WavFileReader {
+ public:
+  WavFileReader() = default;
+  ~WavFileReader();
+
+  WavFileReader(const WavFileReader&) = delete;
+  WavFileReader& operator=(const WavFileReader&) = delete;
+
+  /** Parse the header and keep the file open. Returns false (see Error()) for unsupported files. */
+  bool Open(const std::string& path);
+  void Close();
+
+  bool IsOpen() const { return file_ != nullptr || mapped_ != nullptr; }
+  /** True when reads come from a memory mapping rather than stdio. */
+  bool IsMapped() const { return mapped_ != nullptr; }
+  int32_t SampleRate() const { return sampleRate_; }
+  int32_t NumChannels() const { return numChannels_; }
+  /** Frames (samples per channel) in the data chunk. */
+  int64_t NumFrames() const { return numFrames_; }
+  const std::string& Error() const { return error_; }
+
+  /**
+   * Read up to n frames starting at frame `start`, averaged over channels, into out. Returns the
+   * number of frames read (0 past the end, -1 on an I/O error).
+   */
+  int64_t ReadMono(int64_t start, int64_t n, float* out);
+
+ private:
+  void ConvertFrames(const unsigned char* p, int64_t frames, float* out) const;
+
+  std::FILE* file_ = nullptr;
+  // Whole-file read-only mapping; mapped pages are released after each window is converted.
+  unsigned char* mapped_ = nullptr;
+  size_t mappedSize_ = 0;
+  std::string error_;
+  int32_t sampleRate_ = 0;
+  int32_t numChannels_ = 0;
+  int32_t bitsPerSample_ = 0;
+  bool isFloat_ = false;
+  int64_t dataOffset_ = 0;
+  int64_t numFrames_ = 0;
+  std::vector<unsigned char> buffer_;
+};
+
+/**
+ * Read a whole WAV file as mono float into samples (sized once, filled window by window). Returns
+ * false with error set when the file cannot be opened or is not a supported WAV.
+ */
+bool ReadWavFileMono(const std::string& path, std::vector<float>* samples, int32_t* sampleRate,
+                     std::string* error);
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_WAV_READER_H
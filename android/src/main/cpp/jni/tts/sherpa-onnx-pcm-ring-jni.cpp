@@ -0,0 +1,66 @@
+/**
+ * sherpa-onnx-pcm-ring-jni.cpp
+ *
+ * Purpose: JNI for PcmRingBuffer (Kotlin). The ring lives in a direct ByteBuffer shared with the
+ * native producer (see sherpa-onnx-pcm-ring.h); these entry points give Kotlin acquire/release
+ * access to the shared indices. Sample data is read in place through a FloatBuffer view.
+ */
+#include <jni.h>
+
+#include "sherpa-onnx-pcm-ring.h"
+
+namespace {
+
+sherpaonnx::PcmRing AttachRing(JNIEnv* env, jobject buffer) {
+  if (!buffer) return sherpaonnx::PcmRing();
+  void* base = env->GetDirectBufferAddress(buffer);
+  jlong bytes = env->GetDirectBufferCapacity(buffer);
+  if (!base || bytes <= 0) return sherpaonnx::PcmRing();
+  return sherpaonnx::PcmRing::Attach(base, static_cast<size_t>(bytes));
+}
+
+}  // namespace
+
+extern "C" {
+
+// Initialize the ring header inside a direct ByteBuffer. Returns capacity in samples (0 on failure).
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_PcmRingBuffer_nativeInit(JNIEnv* env, jclass /* clazz */, jobject buffer) {
+  if (!buffer) return 0;
+  void* base = env->GetDirectBufferAddress(buffer);
+  jlong bytes = env->GetDirectBufferCapacity(buffer);
+  if (!base || bytes <= 0) return 0;
+  return sherpaonnx::PcmRing::Init(base, static_cast<size_t>(bytes)).capacity();
+}
+
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_PcmRingBuffer_nativeReadable(JNIEnv* env, jclass /* clazz */, jobject buffer) {
+  return AttachRing(env, buffer).Readable();
+}
+
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_PcmRingBuffer_nativeReadOffset(JNIEnv* env, jclass /* clazz */, jobject buffer) {
+  return AttachRing(env, buffer).ReadOffset();
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_PcmRingBuffer_nativeCommitRead(JNIEnv* env, jclass /* clazz */, jobject buffer, jint n) {
+  AttachRing(env, buffer).CommitRead(n);
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_PcmRingBuffer_nativeSetFlag(JNIEnv* env, jclass /* clazz */, jobject buffer, jint flag) {
+  AttachRing(env, buffer).SetFlag(flag);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_PcmRingBuffer_nativeHasFlag(JNIEnv* env, jclass /* clazz */, jobject buffer, jint flag) {
+  return AttachRing(env, buffer).HasFlag(flag) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_PcmRingBuffer_nativeReset(JNIEnv* env, jclass /* clazz */, jobject buffer) {
+  AttachRing(env, buffer).Reset();
+}
+
+}  // extern "C"
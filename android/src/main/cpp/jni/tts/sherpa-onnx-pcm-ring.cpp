@@ -0,0 +1,121 @@
+/**
+ * sherpa-onnx-pcm-ring.cpp
+ *
+ * Purpose: Lock-free SPSC float ring over caller-owned memory. Used by the Zipvoice JNI to hand
+ * streaming chunks to Kotlin through a preallocated direct ByteBuffer without per-chunk allocation.
+ */
+#include "sherpa-onnx-pcm-ring.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace sherpaonnx {
+
+static_assert(std::atomic<int64_t>::is_always_lock_free, "PcmRing requires lock-free 64-bit atomics");
+
+size_t PcmRing::RequiredBytes(int32_t capacitySamples) {
+  if (capacitySamples <= 0) return kHeaderBytes;
+  return kHeaderBytes + static_cast<size_t>(capacitySamples) * sizeof(float);
+}
+
+PcmRing PcmRing::Init(void* base, size_t bytes) {
+  if (!base || bytes <= kHeaderBytes) return PcmRing();
+  if (reinterpret_cast<uintptr_t>(base) % alignof(Header) != 0) return PcmRing();
+  auto* header = new (base) Header();
+  header->writeIndex.store(0, std::memory_order_relaxed);
+  header->readIndex.store(0, std::memory_order_relaxed);
+  header->flags.store(0, std::memory_order_relaxed);
+  header->capacity = static_cast<int32_t>((bytes - kHeaderBytes) / sizeof(float));
+  std::atomic_thread_fence(std::memory_order_release);
+  return PcmRing(header, reinterpret_cast<float*>(static_cast<char*>(base) + kHeaderBytes));
+}
+
+PcmRing PcmRing::Attach(void* base, size_t bytes) {
+  if (!base || bytes <= kHeaderBytes) return PcmRing();
+  if (reinterpret_cast<uintptr_t>(base) % alignof(Header) != 0) return PcmRing();
+  auto* header = static_cast<Header*>(base);
+  const size_t maxCapacity = (bytes - kHeaderBytes) / sizeof(float);
+  if (header->capacity <= 0 || static_cast<size_t>(header->capacity) > maxCapacity) return PcmRing();
+  return PcmRing(header, reinterpret_cast<float*>(static_cast<char*>(base) + kHeaderBytes));
+}
+
+int32_t PcmRing::capacity() const {
+  return header_ ? header_->capacity : 0;
+}
+
+int32_t PcmRing::Writable() const {
+  if (!header_) return 0;
+  const int64_t w = header_->writeIndex.load(std::memory_order_relaxed);
+  const int64_t r = header_->readIndex.load(std::memory_order_acquire);
+  return header_->capacity - static_cast<int32_t>(w - r);
+}
+
+int32_t PcmRing::Write(const float* samples, int32_t n) {
+  if (!header_ || !samples || n <= 0) return 0;
+  const int32_t cap = header_->capacity;
+  const int64_t w = header_->writeIndex.load(std::memory_order_relaxed);
+  const int64_t r = header_->readIndex.load(std::memory_order_acquire);
+  const int32_t count = std::min(n, cap - static_cast<int32_t>(w - r));
+  if (count <= 0) return 0;
+
+  const int32_t start = static_cast<int32_t>(w % cap);
+  const int32_t first = std::min(count, cap - start);
+  std::memcpy(data_ + start, samples, static_cast<size_t>(first) * sizeof(float));
+  if (count > first) {
+    std::memcpy(data_, samples + first, static_cast<size_t>(count - first) * sizeof(float));
+  }
+  header_->writeIndex.store(w + count, std::memory_order_release);
+  return count;
+}
+
+int32_t PcmRing::Readable() const {
+  if (!header_) return 0;
+  const int64_t w = header_->writeIndex.load(std::memory_order_acquire);
+  const int64_t r = header_->readIndex.load(std::memory_order_relaxed);
+  return static_cast<int32_t>(w - r);
+}
+
+int32_t PcmRing::ReadOffset() const {
+  if (!header_) return 0;
+  return static_cast<int32_t>(header_->readIndex.load(std::memory_order_relaxed) % header_->capacity);
+}
+
+int32_t PcmRing::Read(float* out, int32_t n) {
+  if (!header_ || !out || n <= 0) return 0;
+  const int32_t cap = header_->capacity;
+  const int32_t count = std::min(n, Readable());
+  if (count <= 0) return 0;
+  const int32_t start = ReadOffset();
+  const int32_t first = std::min(count, cap - start);
+  std::memcpy(out, data_ + start, static_cast<size_t>(first) * sizeof(float));
+  if (count > first) {
+    std::memcpy(out + first, data_, static_cast<size_t>(count - first) * sizeof(float));
+  }
+  CommitRead(count);
+  return count;
+}
+
+void PcmRing::CommitRead(int32_t n) {
+  if (!header_ || n <= 0) return;
+  const int32_t count = std::min(n, Readable());
+  const int64_t r = header_->readIndex.load(std::memory_order_relaxed);
+  header_->readIndex.store(r + count, std::memory_order_release);
+}
+
+void PcmRing::SetFlag(int32_t flag) {
+  if (header_) header_->flags.fetch_or(flag, std::memory_order_acq_rel);
+}
+
+bool PcmRing::HasFlag(int32_t flag) const {
+  return header_ && (header_->flags.load(std::memory_order_acquire) & flag) != 0;
+}
+
+void PcmRing::Reset() {
+  if (!header_) return;
+  header_->writeIndex.store(0, std::memory_order_relaxed);
+  header_->readIndex.store(0, std::memory_order_relaxed);
+  header_->flags.store(0, std::memory_order_release);
+}
+
+}  // namespace sherpaonnx
@@ -0,0 +1,83 @@
+/**
+ * sherpa-onnx-pcm-ring.h
+ *
+ * Declares PcmRing: a lock-free SPSC float ring over caller-owned memory, shared between the
+ * Zipvoice JNI producer and the Kotlin consumer through a direct ByteBuffer.
+ */
+#ifndef SHERPA_ONNX_PCM_RING_H
+#define SHERPA_ONNX_PCM_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace sherpaonnx {
+
+/**
+ * Single-producer / single-consumer float PCM ring living in caller-owned memory (e.g. a Java
+ * direct ByteBuffer). The first kHeaderBytes hold the shared state; samples follow. Indices are
+ * monotonically increasing sample counts, so readable = write - read and no slot is wasted.
+ *
+ * Producer: Write() then (optionally) notify the consumer. Consumer: Readable()/ReadOffset() to
+ * locate contiguous data, then CommitRead(). Either side can mark the ring done/closed.
+ */
+class PcmRing {
+ public:
+  static constexpr size_t kHeaderBytes = 64;
+
+  /** Flag bits in the header: writer finished (EOF) / reader closed (producer should stop). */
+  static constexpr int32_t kWriterDone = 1;
+  static constexpr int32_t kReaderClosed = 2;
+
+  /** Bytes needed for a ring holding capacitySamples floats. */
+  static size_t RequiredBytes(int32_t capacitySamples);
+
+  /** Initialize a fresh ring over [base, base + bytes). Returns an invalid ring if too small. */
+  static PcmRing Init(void* base, size_t bytes);
+
+  /** Attach to a ring previously set up with Init (does not reset indices). */
+  static PcmRing Attach(void* base, size_t bytes);
+
+  PcmRing() = default;
+
+  bool valid() const { return header_ != nullptr; }
+  int32_t capacity() const;
+
+  /** Copy up to n samples in; returns the number written (less than n when the ring is full). */
+  int32_t Write(const float* samples, int32_t n);
+  /** Free space in samples. */
+  int32_t Writable() const;
+
+  /** Samples available to the consumer. */
+  int32_t Readable() const;
+  /** Physical sample offset of the read position inside the data region. */
+  int32_t ReadOffset() const;
+  /** Copy up to n samples out and commit them; returns the number read. */
+  int32_t Read(float* out, int32_t n);
+  /** Release n samples previously inspected in place. */
+  void CommitRead(int32_t n);
+
+  void SetFlag(int32_t flag);
+  bool HasFlag(int32_t flag) const;
+
+  /** Reset indices and flags (only when neither side is active). */
+  void Reset();
+
+ private:
+  struct Header {
+    std::atomic<int64_t> writeIndex;
+    std::atomic<int64_t> readIndex;
+    std::atomic<int32_t> flags;
+    int32_t capacity;
+  };
+  static_assert(sizeof(Header) <= kHeaderBytes, "PcmRing header must fit in kHeaderBytes");
+
+  PcmRing(Header* header, float* data) : header_(header), data_(data) {}
+
+  Header* header_ = nullptr;
+  float* data_ = nullptr;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_PCM_RING_H
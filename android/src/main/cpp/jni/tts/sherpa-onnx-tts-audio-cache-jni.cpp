@@ -0,0 +1,126 @@
+/**
+ * sherpa-onnx-tts-audio-cache-jni.cpp
+ *
+ * Purpose: JNI for TtsAudioCache (Kotlin). Owns one native sherpaonnx::TtsAudioCache per handle;
+ * the Kotlin side builds keys with nativeMakeKey and passes FloatArrays in and out.
+ */
+#include <jni.h>
+#include <string>
+#include <vector>
+
+#include "sherpa-onnx-tts-audio-cache.h"
+
+namespace {
+
+std::string ToStdString(JNIEnv* env, jstring s) {
+  if (!s) return std::string();
+  const char* c = env->GetStringUTFChars(s, nullptr);
+  std::string out = c ? c : "";
+  if (c) env->ReleaseStringUTFChars(s, c);
+  return out;
+}
+
+sherpaonnx::TtsAudioCache* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::TtsAudioCache*>(ptr);
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_TtsAudioCache_nativeCreate(JNIEnv* /* env */, jclass /* clazz */) {
+  return reinterpret_cast<jlong>(new sherpaonnx::TtsAudioCache());
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsAudioCache_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsAudioCache_nativeConfigure(JNIEnv* env, jclass /* clazz */, jlong ptr,
+                                                  jlong maxMemoryBytes, jstring diskDir,
+                                                  jlong maxDiskBytes) {
+  auto* cache = FromHandle(ptr);
+  if (!cache) return;
+  sherpaonnx::TtsAudioCache::Options opts;
+  opts.maxMemoryBytes = maxMemoryBytes > 0 ? static_cast<size_t>(maxMemoryBytes) : 0;
+  opts.diskDir = ToStdString(env, diskDir);
+  opts.maxDiskBytes = maxDiskBytes > 0 ? static_cast<size_t>(maxDiskBytes) : 0;
+  cache->Configure(opts);
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_sherpaonnx_TtsAudioCache_nativeMakeKey(JNIEnv* env, jclass /* clazz */, jstring fingerprint,
+                                                jstring text, jint sid, jfloat speed, jstring params) {
+  std::string key = sherpaonnx::TtsAudioCache::MakeKey(
+      ToStdString(env, fingerprint), ToStdString(env, text), sid, speed, ToStdString(env, params));
+  // Input came from GetStringUTFChars (modified UTF-8), so the round trip through NewStringUTF is
+  // lossless; the key is opaque to Kotlin and only handed back to nativeGet / nativePut.
+  return env->NewStringUTF(key.c_str());
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_sherpaonnx_TtsAudioCache_nativeModelFingerprint(JNIEnv* env, jclass /* clazz */,
+                                                         jstring modelDir, jstring config) {
+  std::string fp = sherpaonnx::TtsAudioCache::ModelFingerprint(ToStdString(env, modelDir),
+                                                                ToStdString(env, config));
+  return env->NewStringUTF(fp.c_str());
+}
+
+// Returns cached samples or null; sampleRateOut[0] receives the sample rate on a hit.
+JNIEXPORT jfloatArray JNICALL
+Java_com_sherpaonnx_TtsAudioCache_nativeGet(JNIEnv* env, jclass /* clazz */, jlong ptr, jstring key,
+                                            jintArray sampleRateOut) {
+  auto* cache = FromHandle(ptr);
+  if (!cache) return nullptr;
+  sherpaonnx::TtsAudioCache::Samples samples;
+  int32_t sampleRate = 0;
+  if (!cache->Get(ToStdString(env, key), &samples, &sampleRate) || !samples) return nullptr;
+  const jsize n = static_cast<jsize>(samples->size());
+  jfloatArray out = env->NewFloatArray(n);
+  if (!out) return nullptr;
+  env->SetFloatArrayRegion(out, 0, n, samples->data());
+  if (sampleRateOut && env->GetArrayLength(sampleRateOut) > 0) {
+    jint rate = sampleRate;
+    env->SetIntArrayRegion(sampleRateOut, 0, 1, &rate);
+  }
+  return out;
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsAudioCache_nativePut(JNIEnv* env, jclass /* clazz */, jlong ptr, jstring key,
+                                            jfloatArray samples, jint sampleRate) {
+  auto* cache = FromHandle(ptr);
+  if (!cache || !samples) return;
+  const jsize n = env->GetArrayLength(samples);
+  std::vector<float> data(static_cast<size_t>(n));
+  if (n > 0) env->GetFloatArrayRegion(samples, 0, n, data.data());
+  cache->Put(ToStdString(env, key), std::move(data), sampleRate);
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsAudioCache_nativeClear(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                              jboolean includeDisk) {
+  auto* cache = FromHandle(ptr);
+  if (cache) cache->Clear(includeDisk == JNI_TRUE);
+}
+
+// Stats as [memoryHits, diskHits, misses, insertions, evictions, memoryBytes, memoryEntries, diskBytes].
+JNIEXPORT jlongArray JNICALL
+Java_com_sherpaonnx_TtsAudioCache_nativeStats(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  auto* cache = FromHandle(ptr);
+  sherpaonnx::TtsAudioCache::Stats s = cache ? cache->GetStats() : sherpaonnx::TtsAudioCache::Stats();
+  jlong values[8] = {
+      static_cast<jlong>(s.memoryHits), static_cast<jlong>(s.diskHits),
+      static_cast<jlong>(s.misses),     static_cast<jlong>(s.insertions),
+      static_cast<jlong>(s.evictions),  static_cast<jlong>(s.memoryBytes),
+      static_cast<jlong>(s.memoryEntries), static_cast<jlong>(s.diskBytes),
+  };
+  jlongArray out = env->NewLongArray(8);
+  if (out) env->SetLongArrayRegion(out, 0, 8, values);
+  return out;
+}
+
+}  // extern "C"
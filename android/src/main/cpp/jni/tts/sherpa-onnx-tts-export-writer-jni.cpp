@@ -0,0 +1,129 @@
+/**
+ * sherpa-onnx-tts-export-writer-jni.cpp
+ *
+ * Purpose: JNI for TtsExportWriter (Kotlin). Owns one native sherpaonnx::TtsExportWriter per
+ * handle; batch export submits each synthesized item and the writer's thread encodes it while the
+ * next one is synthesized. Non-WAV formats go through convertToFormat (audio-convert JNI).
+ */
+#include <jni.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sherpa-onnx-jni-cache.h"
+#include "sherpa-onnx-tts-export-writer.h"
+
+namespace sherpaonnx {
+// Defined in sherpa-onnx-audio-convert-jni.cpp; returns "" on success.
+std::string ConvertAudioFileToFormat(const std::string& inputPath, const std::string& outputPath,
+                                     const std::string& format, int outputSampleRateHz);
+}  // namespace sherpaonnx
+
+namespace {
+
+std::string ToStdString(JNIEnv* env, jstring s) {
+  if (!s) return std::string();
+  const char* c = env->GetStringUTFChars(s, nullptr);
+  std::string out = c ? c : "";
+  if (c) env->ReleaseStringUTFChars(s, c);
+  return out;
+}
+
+sherpaonnx::TtsExportWriter* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::TtsExportWriter*>(ptr);
+}
+
+// Object[] { double[4 * n] of (index, numSamples, sampleRate, encodeMs), String[n] errors ("" = ok) },
+// or null when there are no results.
+jobjectArray ToJava(JNIEnv* env, const std::vector<sherpaonnx::TtsExportResult>& results) {
+  if (results.empty()) return nullptr;
+  const sherpaonnx::JniCache& cache = sherpaonnx::GetJniCache();
+  if (!cache.objectClass || !cache.stringClass) return nullptr;
+  const jsize n = static_cast<jsize>(results.size());
+
+  std::vector<jdouble> values;
+  values.reserve(results.size() * 4);
+  for (const auto& r : results) {
+    values.push_back(static_cast<jdouble>(r.index));
+    values.push_back(static_cast<jdouble>(r.numSamples));
+    values.push_back(static_cast<jdouble>(r.sampleRate));
+    values.push_back(r.encodeMs);
+  }
+  jdoubleArray jvalues = env->NewDoubleArray(n * 4);
+  if (!jvalues) return nullptr;
+  env->SetDoubleArrayRegion(jvalues, 0, n * 4, values.data());
+
+  jobjectArray jerrors = env->NewObjectArray(n, cache.stringClass, nullptr);
+  if (!jerrors) return nullptr;
+  for (jsize i = 0; i < n; ++i) {
+    jstring error = env->NewStringUTF(results[i].error.c_str());
+    env->SetObjectArrayElement(jerrors, i, error);
+    env->DeleteLocalRef(error);
+  }
+
+  jobjectArray out = env->NewObjectArray(2, cache.objectClass, nullptr);
+  if (!out) return nullptr;
+  env->SetObjectArrayElement(out, 0, jvalues);
+  env->SetObjectArrayElement(out, 1, jerrors);
+  env->DeleteLocalRef(jvalues);
+  env->DeleteLocalRef(jerrors);
+  return out;
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_TtsExportWriter_nativeCreate(JNIEnv* /* env */, jclass /* clazz */, jfloat tempo,
+                                                 jint outputSampleRateHz) {
+  const int rate = outputSampleRateHz;
+  sherpaonnx::TtsExportEncoder encoder = [rate](const std::string& wavPath, const std::string& outputPath,
+                                                const std::string& format) {
+    return sherpaonnx::ConvertAudioFileToFormat(wavPath, outputPath, format, rate);
+  };
+  return reinterpret_cast<jlong>(new sherpaonnx::TtsExportWriter(std::move(encoder), tempo));
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsExportWriter_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+// Copies samples once into the job; blocks while the previous item is still queued.
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_TtsExportWriter_nativeSubmit(JNIEnv* env, jclass /* clazz */, jlong ptr, jint index,
+                                                 jfloatArray samples, jint sampleRate, jstring path,
+                                                 jstring format) {
+  auto* writer = FromHandle(ptr);
+  if (!writer || !samples) return JNI_FALSE;
+  sherpaonnx::TtsExportJob job;
+  job.index = static_cast<size_t>(index);
+  job.samples.resize(static_cast<size_t>(env->GetArrayLength(samples)));
+  if (!job.samples.empty()) {
+    env->GetFloatArrayRegion(samples, 0, static_cast<jsize>(job.samples.size()), job.samples.data());
+  }
+  job.sampleRate = sampleRate;
+  job.path = ToStdString(env, path);
+  job.format = ToStdString(env, format);
+  return writer->Submit(std::move(job)) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_TtsExportWriter_nativeTakeCompleted(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  auto* writer = FromHandle(ptr);
+  return writer ? ToJava(env, writer->TakeCompleted()) : nullptr;
+}
+
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_TtsExportWriter_nativeFinish(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  auto* writer = FromHandle(ptr);
+  return writer ? ToJava(env, writer->Finish()) : nullptr;
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsExportWriter_nativeCancel(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  if (auto* writer = FromHandle(ptr)) writer->Cancel();
+}
+
+}  // extern "C"
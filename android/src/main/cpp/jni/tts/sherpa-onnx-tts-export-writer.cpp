@@ -0,0 +1,127 @@
+/**
+ * sherpa-onnx-tts-export-writer.cpp
+ *
+ * Purpose: Pipelined encode / write for batch TTS export. Encoding and file I/O of one item overlap
+ * synthesis of the next, and samples stay in native memory from the engine to the file.
+ */
+#include "sherpa-onnx-tts-export-writer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+#include "sherpa-onnx-tts-time-stretch.h"
+#include "sherpa-onnx-wav-writer.h"
+
+namespace sherpaonnx {
+
+TtsExportWriter::TtsExportWriter(TtsExportEncoder encoder, float tempo)
+    : encoder_(std::move(encoder)), tempo_(tempo > 0.0f ? tempo : 1.0f) {
+  thread_ = std::thread([this] { Run(); });
+}
+
+TtsExportWriter::~TtsExportWriter() { Finish(); }
+
+bool TtsExportWriter::Submit(TtsExportJob job) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return closed_ || slot_.empty(); });
+  if (closed_) return false;
+  slot_.push_back(std::move(job));
+  cv_.notify_all();
+  return true;
+}
+
+std::vector<TtsExportResult> TtsExportWriter::TakeCompleted() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<TtsExportResult> out;
+  out.swap(completed_);
+  return out;
+}
+
+std::vector<TtsExportResult> TtsExportWriter::Finish() {
+  {
+    // The thread drains the slot before it sees closed_.
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    cv_.notify_all();
+  }
+  if (thread_.joinable()) thread_.join();
+  return TakeCompleted();
+}
+
+void TtsExportWriter::Cancel() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  slot_.clear();
+  closed_ = true;
+  cv_.notify_all();
+}
+
+std::string TtsExportWriter::ResolveFormat(const std::string& path, const std::string& format) {
+  std::string fmt = format;
+  if (fmt.empty()) {
+    const size_t slash = path.find_last_of("/\\");
+    const size_t dot = path.find_last_of('.');
+    if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) fmt = path.substr(dot + 1);
+  }
+  std::transform(fmt.begin(), fmt.end(), fmt.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return fmt.empty() ? "wav" : fmt;
+}
+
+void TtsExportWriter::Run() {
+  for (;;) {
+    TtsExportJob job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return closed_ || !slot_.empty(); });
+      if (slot_.empty()) return;  // closed and drained
+      job = std::move(slot_.front());
+      slot_.clear();
+      cv_.notify_all();  // the slot is free for the next Submit
+    }
+    TtsExportResult result = Encode(job);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      completed_.push_back(std::move(result));
+    }
+  }
+}
+
+TtsExportResult TtsExportWriter::Encode(TtsExportJob& job) const {
+  const auto start = std::chrono::steady_clock::now();
+  TtsExportResult result;
+  result.index = job.index;
+  result.path = job.path;
+  result.sampleRate = job.sampleRate;
+
+  const std::string format = ResolveFormat(job.path, job.format);
+  const bool isWav = format == "wav";
+  if (job.sampleRate <= 0) {
+    result.error = "Invalid sample rate";
+  } else if (!isWav && !encoder_) {
+    result.error = "No encoder available for format " + format;
+  } else {
+    if (tempo_ != 1.0f) {
+      job.samples = WsolaTimeStretcher::Stretch(job.samples.data(), job.samples.size(), job.sampleRate, tempo_);
+    }
+    const std::string wavPath = isWav ? job.path : job.path + ".part.wav";
+    WavWriter writer;
+    if (!writer.Open(wavPath, job.sampleRate) || !writer.Append(job.samples.data(), job.samples.size()) ||
+        !writer.Finalize()) {
+      result.error = "Failed to write " + wavPath;
+    } else {
+      result.numSamples = writer.NumSamples();
+      if (!isWav) result.error = encoder_(wavPath, job.path, format);
+    }
+    if (!isWav) std::remove(wavPath.c_str());
+  }
+  // The samples are not needed past this point; free them before the result waits to be taken.
+  std::vector<float>().swap(job.samples);
+
+  result.encodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+}  // namespace sherpaonnx
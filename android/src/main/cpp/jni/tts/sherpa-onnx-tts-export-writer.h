@@ -0,0 +1,97 @@
+/**
+ * sherpa-onnx-tts-export-writer.h
+ *
+ * Declares TtsExportWriter: the encode side of batch text-to-file export. Synthesized items are
+ * handed to a dedicated thread that writes WAV (or a temporary WAV passed to an FFmpeg encoder for
+ * MP3 / FLAC / ...) while the engine synthesizes the next item. Shared by the Android JNI and the
+ * iOS TTS bridge (mirrored in ios/tts).
+ */
+#ifndef SHERPA_ONNX_TTS_EXPORT_WRITER_H
+#define SHERPA_ONNX_TTS_EXPORT_WRITER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sherpaonnx {
+
+/** One synthesized item: mono float samples to write to path as format ("wav", "mp3", "flac", ...). */
+struct TtsExportJob {
+  size_t index = 0;
+  std::vector<float> samples;
+  int32_t sampleRate = 0;
+  std::string path;
+  std::string format;
+};
+
+struct TtsExportResult {
+  size_t index = 0;
+  std::string path;
+  uint64_t numSamples = 0;  // written (after tempo)
+  int32_t sampleRate = 0;
+  double encodeMs = 0.0;    // stretch + WAV write + encoder
+  std::string error;        // empty on success
+};
+
+/**
+ * Encode the 16-bit PCM WAV at wavPath into outputPath as format. Returns an empty string on
+ * success, an error message otherwise (same contract as convertToFormat).
+ */
+using TtsExportEncoder = std::function<std::string(
+    const std::string& wavPath, const std::string& outputPath, const std::string& format)>;
+
+/**
+ * Single encoder thread with a one-slot handoff. Submit() returns as soon as the slot is free, so
+ * while item N is encoded item N + 1 waits in the slot and the caller synthesizes N + 2; at most
+ * three items' audio is alive at once however long the batch is. WAV is written directly at the
+ * job's sample rate; other formats go through a "<path>.part.wav" that is removed afterwards.
+ * A tempo other than 1 is applied (WSOLA) on the encoder thread. Results come out in submit order.
+ * Thread-safe.
+ */
+class TtsExportWriter {
+ public:
+  /** encoder may be empty; non-WAV jobs then fail with an error result. */
+  explicit TtsExportWriter(TtsExportEncoder encoder, float tempo = 1.0f);
+  /** Finish()es: waits for submitted jobs. */
+  ~TtsExportWriter();
+
+  TtsExportWriter(const TtsExportWriter&) = delete;
+  TtsExportWriter& operator=(const TtsExportWriter&) = delete;
+
+  /** Hand job to the encoder thread, waiting while the slot is taken. False after Finish / Cancel. */
+  bool Submit(TtsExportJob job);
+
+  /** Results completed since the last call (for progress reporting). */
+  std::vector<TtsExportResult> TakeCompleted();
+
+  /** Wait for every submitted job and stop the thread; returns the results not yet taken. */
+  std::vector<TtsExportResult> Finish();
+
+  /** Drop the queued job and stop after the one being encoded; Finish() still returns its result. */
+  void Cancel();
+
+  /** Lower-cased format, or the path's extension when format is empty; "wav" when neither is set. */
+  static std::string ResolveFormat(const std::string& path, const std::string& format);
+
+ private:
+  void Run();
+  TtsExportResult Encode(TtsExportJob& job) const;
+
+  TtsExportEncoder encoder_;
+  float tempo_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<TtsExportJob> slot_;  // at most one job (guarded by mutex_)
+  bool closed_ = false;             // guarded by mutex_
+  std::vector<TtsExportResult> completed_;  // guarded by mutex_
+  std::thread thread_;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_TTS_EXPORT_WRITER_H
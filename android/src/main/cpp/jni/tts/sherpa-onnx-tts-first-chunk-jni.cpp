@@ -0,0 +1,93 @@
+/**
+ * sherpa-onnx-tts-first-chunk-jni.cpp
+ *
+ * Purpose: JNI for TtsFirstChunkPlanner (Kotlin). Owns one native sherpaonnx::FirstChunkPlanner
+ * per handle and exposes SplitLeadingClause for the streaming first-chunk fast path, and
+ * SplitSentences for batch-priority streams that yield the engine between sentences.
+ */
+#include <jni.h>
+#include <string>
+
+#include "sherpa-onnx-jni-cache.h"
+#include "sherpa-onnx-tts-sentence-pipeline.h"
+
+namespace {
+
+std::string ToStdString(JNIEnv* env, jstring s) {
+  if (!s) return std::string();
+  const char* c = env->GetStringUTFChars(s, nullptr);
+  std::string out = c ? c : "";
+  if (c) env->ReleaseStringUTFChars(s, c);
+  return out;
+}
+
+sherpaonnx::FirstChunkPlanner* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::FirstChunkPlanner*>(ptr);
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_TtsFirstChunkPlanner_nativeCreate(JNIEnv* /* env */, jclass /* clazz */) {
+  return reinterpret_cast<jlong>(new sherpaonnx::FirstChunkPlanner());
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsFirstChunkPlanner_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_TtsFirstChunkPlanner_nativeBudget(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                      jint targetMs) {
+  auto* planner = FromHandle(ptr);
+  return planner ? static_cast<jint>(planner->Budget(targetMs)) : 0;
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsFirstChunkPlanner_nativeObserve(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                       jint chars, jlong elapsedMs) {
+  auto* planner = FromHandle(ptr);
+  if (planner && chars > 0) planner->Observe(static_cast<size_t>(chars), elapsedMs);
+}
+
+// Returns String[] { head, rest }, or null when the text should not be split.
+// Budgets are in (modified) UTF-8 bytes, matching the native planner.
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_TtsFirstChunkPlanner_nativeSplit(JNIEnv* env, jclass /* clazz */, jstring text,
+                                                     jint maxChars) {
+  if (maxChars <= 0) return nullptr;
+  auto parts = sherpaonnx::SplitLeadingClause(ToStdString(env, text), static_cast<size_t>(maxChars));
+  if (parts.first.empty()) return nullptr;
+  jclass stringClass = sherpaonnx::GetJniCache().stringClass;
+  if (!stringClass) return nullptr;
+  jobjectArray out = env->NewObjectArray(2, stringClass, nullptr);
+  if (!out) return nullptr;
+  jstring head = env->NewStringUTF(parts.first.c_str());
+  jstring rest = env->NewStringUTF(parts.second.c_str());
+  env->SetObjectArrayElement(out, 0, head);
+  env->SetObjectArrayElement(out, 1, rest);
+  env->DeleteLocalRef(head);
+  env->DeleteLocalRef(rest);
+  return out;
+}
+
+// Returns String[] of sentence pieces, or null on allocation failure.
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_TtsFirstChunkPlanner_nativeSplitSentences(JNIEnv* env, jclass /* clazz */, jstring text) {
+  auto pieces = sherpaonnx::SplitSentences(ToStdString(env, text));
+  jclass stringClass = sherpaonnx::GetJniCache().stringClass;
+  if (!stringClass) return nullptr;
+  jobjectArray out = env->NewObjectArray(static_cast<jsize>(pieces.size()), stringClass, nullptr);
+  if (!out) return nullptr;
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    jstring piece = env->NewStringUTF(pieces[i].c_str());
+    env->SetObjectArrayElement(out, static_cast<jsize>(i), piece);
+    env->DeleteLocalRef(piece);
+  }
+  return out;
+}
+
+}  // extern "C"
@@ -0,0 +1,131 @@
+/**
+ * sherpa-onnx-tts-playback-buffer-jni.cpp
+ *
+ * Purpose: JNI for TtsPlaybackBuffer (Kotlin). Owns one native sherpaonnx::TtsPlaybackBuffer per
+ * handle; generation / writeTtsPcmChunk push into it and the PCM player thread pulls fixed frames
+ * for AudioTrack, through a StretchedFrameReader when the player tempo is not 1. Times come from
+ * the steady clock.
+ */
+#include <jni.h>
+#include <chrono>
+
+#include "sherpa-onnx-tts-playback-buffer.h"
+#include "sherpa-onnx-tts-time-stretch.h"
+
+namespace {
+
+struct PlaybackHandle {
+  explicit PlaybackHandle(const sherpaonnx::PlaybackBufferConfig& config)
+      : buffer(config), reader(config.sampleRate, config.frameSamples) {}
+
+  sherpaonnx::TtsPlaybackBuffer buffer;
+  sherpaonnx::StretchedFrameReader reader;  // used by the player thread only
+};
+
+PlaybackHandle* HandleFrom(jlong ptr) { return reinterpret_cast<PlaybackHandle*>(ptr); }
+
+sherpaonnx::TtsPlaybackBuffer* FromHandle(jlong ptr) {
+  auto* handle = HandleFrom(ptr);
+  return handle ? &handle->buffer : nullptr;
+}
+
+int64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_TtsPlaybackBuffer_nativeCreate(JNIEnv* /* env */, jclass /* clazz */,
+                                                   jint sampleRate, jint frameSamples) {
+  sherpaonnx::PlaybackBufferConfig config;
+  config.sampleRate = sampleRate;
+  config.frameSamples = frameSamples;
+  return reinterpret_cast<jlong>(new PlaybackHandle(config));
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsPlaybackBuffer_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete HandleFrom(ptr);
+}
+
+// Pushes samples[offset, offset + length); returns how many fit.
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_TtsPlaybackBuffer_nativePush(JNIEnv* env, jclass /* clazz */, jlong ptr,
+                                                 jfloatArray samples, jint offset, jint length) {
+  auto* buffer = FromHandle(ptr);
+  if (!buffer || !samples || length <= 0) return 0;
+  float* data = env->GetFloatArrayElements(samples, nullptr);
+  if (!data) return 0;
+  const int32_t pushed = buffer->Push(data + offset, length, NowMs());
+  env->ReleaseFloatArrayElements(samples, data, JNI_ABORT);
+  return pushed;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_TtsPlaybackBuffer_nativeWaitWritable(JNIEnv* /* env */, jclass /* clazz */,
+                                                         jlong ptr, jint n, jint timeoutMs) {
+  auto* buffer = FromHandle(ptr);
+  return buffer && buffer->WaitWritable(n, timeoutMs) ? JNI_TRUE : JNI_FALSE;
+}
+
+// Fills the whole frame (zero-padded) at the player tempo; returns the number of buffered samples
+// consumed for it.
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_TtsPlaybackBuffer_nativePull(JNIEnv* env, jclass /* clazz */, jlong ptr,
+                                                 jfloatArray frame) {
+  auto* handle = HandleFrom(ptr);
+  if (!handle || !frame) return 0;
+  const jsize n = env->GetArrayLength(frame);
+  float* data = env->GetFloatArrayElements(frame, nullptr);
+  if (!data) return 0;
+  int32_t got = 0;
+  handle->reader.Fill(data, n, [&](float* dst, int32_t count) {
+    got += handle->buffer.Pull(dst, count, NowMs());
+  });
+  env->ReleaseFloatArrayElements(frame, data, 0);
+  return got;
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsPlaybackBuffer_nativeSetTempo(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                     jfloat tempo) {
+  if (auto* handle = HandleFrom(ptr)) handle->reader.SetTempo(tempo);
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsPlaybackBuffer_nativeMarkEnd(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  if (auto* buffer = FromHandle(ptr)) buffer->MarkEnd();
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsPlaybackBuffer_nativeClear(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  if (auto* buffer = FromHandle(ptr)) buffer->Clear();
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsPlaybackBuffer_nativeClose(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  if (auto* buffer = FromHandle(ptr)) buffer->Close();
+}
+
+// Returns [samplesIn, samplesOut, framesOut, silentFrames, underruns, overruns,
+//          fillSamples, targetSamples, maxFillSamples, playing (0/1)].
+JNIEXPORT jlongArray JNICALL
+Java_com_sherpaonnx_TtsPlaybackBuffer_nativeStats(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  sherpaonnx::PlaybackBufferStats s;
+  if (auto* buffer = FromHandle(ptr)) s = buffer->GetStats();
+  const jlong values[] = {static_cast<jlong>(s.samplesIn), static_cast<jlong>(s.samplesOut),
+                          static_cast<jlong>(s.framesOut), static_cast<jlong>(s.silentFrames),
+                          static_cast<jlong>(s.underruns), static_cast<jlong>(s.overruns),
+                          s.fillSamples, s.targetSamples, s.maxFillSamples, s.playing ? 1 : 0};
+  constexpr jsize kCount = sizeof(values) / sizeof(values[0]);
+  jlongArray out = env->NewLongArray(kCount);
+  if (out) env->SetLongArrayRegion(out, 0, kCount, values);
+  return out;
+}
+
+}  // extern "C"
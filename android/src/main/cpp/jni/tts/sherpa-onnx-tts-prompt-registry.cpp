@@ -0,0 +1,88 @@
+/**
+ * sherpa-onnx-tts-prompt-registry.cpp
+ *
+ * Purpose: Registry of voice-cloning prompts. Prompts are resampled to the engine rate once at
+ * registration (instead of inside every generate call) and handed out as shared, immutable data.
+ */
+#include "sherpa-onnx-tts-prompt-registry.h"
+
+#include <utility>
+
+namespace sherpaonnx {
+
+TtsPromptRegistry::TtsPromptRegistry(int32_t targetSampleRate, Resampler resampler)
+    : targetSampleRate_(targetSampleRate), resampler_(std::move(resampler)) {}
+
+int64_t TtsPromptRegistry::Register(const std::string& owner, const std::string& text,
+                                    const float* samples, size_t n, int32_t sampleRate) {
+  if (!samples || n == 0 || sampleRate <= 0) return 0;
+
+  // Resample outside the lock; it is the expensive part.
+  auto prompt = std::make_shared<TtsPrompt>();
+  prompt->owner = owner;
+  prompt->text = text;
+  if (targetSampleRate_ > 0 && sampleRate != targetSampleRate_ && resampler_) {
+    prompt->samples = resampler_(samples, n, sampleRate, targetSampleRate_);
+  }
+  if (prompt->samples.empty()) {
+    prompt->samples.assign(samples, samples + n);
+    prompt->sampleRate = sampleRate;
+  } else {
+    prompt->sampleRate = targetSampleRate_;
+  }
+
+  const size_t bytes = prompt->samples.size() * sizeof(float);
+  std::lock_guard<std::mutex> lock(mutex_);
+  const int64_t id = nextId_++;
+  prompts_.emplace(id, std::move(prompt));
+  bytes_ += bytes;
+  return id;
+}
+
+std::shared_ptr<const TtsPrompt> TtsPromptRegistry::Get(const std::string& owner, int64_t id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = prompts_.find(id);
+  return it == prompts_.end() || it->second->owner != owner ? nullptr : it->second;
+}
+
+bool TtsPromptRegistry::Remove(const std::string& owner, int64_t id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = prompts_.find(id);
+  if (it == prompts_.end() || it->second->owner != owner) return false;
+  bytes_ -= it->second->samples.size() * sizeof(float);
+  prompts_.erase(it);
+  return true;
+}
+
+size_t TtsPromptRegistry::RemoveOwner(const std::string& owner) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t removed = 0;
+  for (auto it = prompts_.begin(); it != prompts_.end();) {
+    if (it->second->owner == owner) {
+      bytes_ -= it->second->samples.size() * sizeof(float);
+      it = prompts_.erase(it);
+      ++removed;
+    } else {
+      ++it;
+    }
+  }
+  return removed;
+}
+
+void TtsPromptRegistry::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  prompts_.clear();
+  bytes_ = 0;
+}
+
+size_t TtsPromptRegistry::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return prompts_.size();
+}
+
+size_t TtsPromptRegistry::Bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_;
+}
+
+}  // namespace sherpaonnx
@@ -0,0 +1,82 @@
+/**
+ * sherpa-onnx-tts-prompt-registry.h
+ *
+ * Declares TtsPromptRegistry: reference prompts (audio + transcript) for zero-shot voice cloning,
+ * registered once and then referenced by id, so repeated generations with the same voice do not
+ * re-send, re-copy or re-resample the prompt. Thread-safe. Used by the Zipvoice JNI.
+ *
+ * One registry serves every instance sharing an engine, so each prompt belongs to an owner (the
+ * instance id): ids are only visible to the owner that registered them.
+ */
+#ifndef SHERPA_ONNX_TTS_PROMPT_REGISTRY_H
+#define SHERPA_ONNX_TTS_PROMPT_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sherpaonnx {
+
+/** A registered prompt, stored at the registry's target sample rate when a resampler is set. */
+struct TtsPrompt {
+  std::string owner;
+  std::string text;
+  std::vector<float> samples;
+  int32_t sampleRate = 0;
+};
+
+class TtsPromptRegistry {
+ public:
+  /** Converts samples from inRate to outRate. Returning an empty vector keeps the original audio. */
+  using Resampler =
+      std::function<std::vector<float>(const float* samples, size_t n, int32_t inRate, int32_t outRate)>;
+
+  /**
+   * targetSampleRate: rate the engine works at (0 = keep prompts at their own rate).
+   * resampler: used at registration when a prompt's rate differs from targetSampleRate.
+   */
+  explicit TtsPromptRegistry(int32_t targetSampleRate = 0, Resampler resampler = nullptr);
+
+  /**
+   * Store a prompt for owner and return its id (> 0), or 0 if samples are empty or
+   * sampleRate <= 0.
+   */
+  int64_t Register(const std::string& owner, const std::string& text, const float* samples, size_t n,
+                   int32_t sampleRate);
+
+  /**
+   * owner's prompt for id, or null if unknown or registered by another owner. Stays valid after
+   * Remove while the caller holds it.
+   */
+  std::shared_ptr<const TtsPrompt> Get(const std::string& owner, int64_t id) const;
+
+  /** Forget one of owner's prompts. Returns false if owner has no prompt with this id. */
+  bool Remove(const std::string& owner, int64_t id);
+
+  /** Forget all of owner's prompts (its instance was unloaded). Returns how many were removed. */
+  size_t RemoveOwner(const std::string& owner);
+
+  void Clear();
+
+  size_t Size() const;
+
+  /** Bytes of prompt audio held (float32). */
+  size_t Bytes() const;
+
+ private:
+  const int32_t targetSampleRate_;
+  const Resampler resampler_;
+  mutable std::mutex mutex_;
+  int64_t nextId_ = 1;
+  size_t bytes_ = 0;
+  std::unordered_map<int64_t, std::shared_ptr<const TtsPrompt>> prompts_;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_TTS_PROMPT_REGISTRY_H
@@ -0,0 +1,389 @@
+/**
+ * sherpa-onnx-tts-sentence-pipeline.cpp
+ *
+ * Purpose: Sentence splitting and the ordered, parallel sentence synthesis pipeline used for long
+ * texts. Workers pull sentence indices from a shared counter and store results by index; the
+ * calling thread emits results in order, waiting only for the next missing sentence.
+ * Also the leading-clause split and FirstChunkPlanner behind the streaming first-chunk fast path,
+ * and IncrementalTextSegmenter for text sessions fed fragment by fragment.
+ */
+#include "sherpa-onnx-tts-sentence-pipeline.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace sherpaonnx {
+
+namespace {
+
+bool IsSpace(unsigned char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+std::string Trim(const std::string& s) {
+  size_t b = 0;
+  size_t e = s.size();
+  while (b < e && IsSpace(static_cast<unsigned char>(s[b]))) ++b;
+  while (e > b && IsSpace(static_cast<unsigned char>(s[e - 1]))) --e;
+  return s.substr(b, e - b);
+}
+
+// Length in bytes of a CJK sentence terminator starting at i (。！？；), or 0.
+size_t CjkTerminatorLength(const std::string& s, size_t i) {
+  if (i + 2 >= s.size()) return 0;
+  const auto b0 = static_cast<unsigned char>(s[i]);
+  const auto b1 = static_cast<unsigned char>(s[i + 1]);
+  const auto b2 = static_cast<unsigned char>(s[i + 2]);
+  if (b0 == 0xE3 && b1 == 0x80 && b2 == 0x82) return 3;  // 。
+  if (b0 == 0xEF && b1 == 0xBC && (b2 == 0x81 || b2 == 0x9F || b2 == 0x9B)) return 3;  // ！？；
+  return 0;
+}
+
+// Length in bytes of a CJK clause mark starting at i (，、：), or 0.
+size_t CjkClauseLength(const std::string& s, size_t i) {
+  if (i + 2 >= s.size()) return 0;
+  const auto b0 = static_cast<unsigned char>(s[i]);
+  const auto b1 = static_cast<unsigned char>(s[i + 1]);
+  const auto b2 = static_cast<unsigned char>(s[i + 2]);
+  if (b0 == 0xE3 && b1 == 0x80 && b2 == 0x81) return 3;  // 、
+  if (b0 == 0xEF && b1 == 0xBC && (b2 == 0x8C || b2 == 0x9A)) return 3;  // ，：
+  return 0;
+}
+
+void AppendPiece(const std::string& raw, size_t maxChars, std::vector<std::string>* out) {
+  std::string piece = Trim(raw);
+  while (maxChars > 0 && piece.size() > maxChars) {
+    size_t cut = piece.find_last_of(", ", maxChars);
+    if (cut == std::string::npos || cut == 0) {
+      // No break point: cut at a UTF-8 character boundary.
+      cut = maxChars;
+      while (cut > 0 && (static_cast<unsigned char>(piece[cut]) & 0xC0) == 0x80) --cut;
+      if (cut == 0) cut = maxChars;
+    } else {
+      ++cut;
+    }
+    std::string head = Trim(piece.substr(0, cut));
+    if (!head.empty()) out->push_back(std::move(head));
+    piece = Trim(piece.substr(cut));
+  }
+  if (!piece.empty()) out->push_back(std::move(piece));
+}
+
+}  // namespace
+
+std::vector<std::string> SplitSentences(const std::string& text, size_t maxChars) {
+  std::vector<std::string> sentences;
+  size_t start = 0;
+  size_t i = 0;
+  while (i < text.size()) {
+    const char c = text[i];
+    size_t end = 0;
+    if (c == '\n') {
+      AppendPiece(text.substr(start, i - start), maxChars, &sentences);
+      start = i + 1;
+      ++i;
+      continue;
+    }
+    if (c == '.' || c == '!' || c == '?' || c == ';') {
+      if (i + 1 == text.size() || IsSpace(static_cast<unsigned char>(text[i + 1]))) end = i + 1;
+    } else if (size_t len = CjkTerminatorLength(text, i)) {
+      end = i + len;
+    }
+    if (end > 0) {
+      AppendPiece(text.substr(start, end - start), maxChars, &sentences);
+      start = end;
+      i = end;
+    } else {
+      ++i;
+    }
+  }
+  if (start < text.size()) AppendPiece(text.substr(start), maxChars, &sentences);
+  return sentences;
+}
+
+std::pair<std::string, std::string> SplitLeadingClause(
+    const std::string& text, size_t maxChars, size_t minChars) {
+  std::string t = Trim(text);
+  if (maxChars == 0 || t.size() <= maxChars) return {std::string(), std::move(t)};
+
+  size_t punctEnd = 0;  // end of the last clause punctuation within the budget
+  size_t spaceAt = 0;   // position of the last space within the budget
+  for (size_t i = 0; i < maxChars; ++i) {
+    const char c = t[i];
+    if (c == ' ') {
+      spaceAt = i;
+    } else if (c == ',' || c == ';' || c == ':' || c == '.' || c == '!' || c == '?') {
+      if (IsSpace(static_cast<unsigned char>(t[i + 1])) && i + 1 >= minChars) punctEnd = i + 1;
+    } else if (i + 3 <= maxChars) {
+      const auto b0 = static_cast<unsigned char>(t[i]);
+      const auto b1 = static_cast<unsigned char>(t[i + 1]);
+      const auto b2 = static_cast<unsigned char>(t[i + 2]);
+      // ，；：！？ (U+FF0C, FF1B, FF1A, FF01, FF1F) and 、。 (U+3001, 3002)
+      const bool fullwidth = b0 == 0xEF && b1 == 0xBC &&
+                             (b2 == 0x8C || b2 == 0x9B || b2 == 0x9A || b2 == 0x81 || b2 == 0x9F);
+      const bool ideographic = b0 == 0xE3 && b1 == 0x80 && (b2 == 0x81 || b2 == 0x82);
+      if ((fullwidth || ideographic) && i + 3 >= minChars) punctEnd = i + 3;
+    }
+  }
+
+  size_t cut = 0;
+  if (punctEnd > 0) {
+    cut = punctEnd;
+  } else if (spaceAt >= minChars) {
+    cut = spaceAt;
+  } else if (static_cast<unsigned char>(t[maxChars]) >= 0x80) {
+    // Unspaced script (e.g. CJK) without punctuation in range: cut at a character boundary.
+    cut = maxChars;
+    while (cut > 0 && (static_cast<unsigned char>(t[cut]) & 0xC0) == 0x80) --cut;
+  }
+  if (cut < minChars) return {std::string(), std::move(t)};
+
+  std::string head = Trim(t.substr(0, cut));
+  std::string rest = Trim(t.substr(cut));
+  if (head.empty() || rest.empty()) return {std::string(), std::move(t)};
+  return {std::move(head), std::move(rest)};
+}
+
+IncrementalTextSegmenter::IncrementalTextSegmenter() = default;
+
+IncrementalTextSegmenter::IncrementalTextSegmenter(const Options& options) : options_(options) {}
+
+void IncrementalTextSegmenter::SetFirstClauseChars(size_t chars) {
+  if (chars > 0) options_.firstClauseChars = chars;
+}
+
+std::vector<std::string> IncrementalTextSegmenter::Push(const std::string& fragment) {
+  std::vector<std::string> out;
+  size_t from = 0;
+  if (buffer_.empty()) {
+    while (from < fragment.size() && IsSpace(static_cast<unsigned char>(fragment[from]))) ++from;
+  }
+  if (from < fragment.size()) {
+    buffer_.append(fragment, from, std::string::npos);
+    Extract(&out);
+  }
+  return out;
+}
+
+std::vector<std::string> IncrementalTextSegmenter::Flush() {
+  std::vector<std::string> out;
+  std::string rest = Trim(buffer_);
+  if (!rest.empty()) out.push_back(std::move(rest));
+  Reset();
+  return out;
+}
+
+void IncrementalTextSegmenter::Reset() {
+  buffer_.clear();
+  scan_ = 0;
+  clauseEnd_ = 0;
+  first_ = true;
+}
+
+void IncrementalTextSegmenter::Emit(size_t end, std::vector<std::string>* out) {
+  std::string segment = Trim(buffer_.substr(0, end));
+  while (end < buffer_.size() && IsSpace(static_cast<unsigned char>(buffer_[end]))) ++end;
+  buffer_.erase(0, end);
+  scan_ = 0;
+  clauseEnd_ = 0;
+  if (!segment.empty()) {
+    out->push_back(std::move(segment));
+    first_ = false;
+  }
+}
+
+size_t IncrementalTextSegmenter::HardCut() const {
+  if (clauseEnd_ > 0) return clauseEnd_;
+  const size_t space = buffer_.find_last_of(' ', options_.maxChars);
+  if (space != std::string::npos && space > 0) return space;
+  // No break point: cut at a UTF-8 character boundary.
+  size_t cut = options_.maxChars;
+  while (cut > 0 && (static_cast<unsigned char>(buffer_[cut]) & 0xC0) == 0x80) --cut;
+  return cut > 0 ? cut : options_.maxChars;
+}
+
+void IncrementalTextSegmenter::Extract(std::vector<std::string>* out) {
+  size_t i = scan_;
+  for (;;) {
+    const size_t limit = first_ ? options_.firstClauseChars : options_.clauseChars;
+    if (clauseEnd_ >= options_.minChars && i >= limit) {
+      Emit(clauseEnd_, out);
+      i = 0;
+      continue;
+    }
+    if (options_.maxChars > 0 && i > options_.maxChars) {
+      Emit(HardCut(), out);
+      i = 0;
+      continue;
+    }
+    if (i >= buffer_.size()) break;
+
+    const auto c = static_cast<unsigned char>(buffer_[i]);
+    const bool last = i + 1 == buffer_.size();
+    size_t end = 0;
+    size_t clause = 0;
+    if (c == '\n') {
+      end = i + 1;
+    } else if (c == '.' || c == '!' || c == '?' || c == ';' || c == ',' || c == ':') {
+      if (last) break;  // "3." may continue as "3.14": wait for the next character
+      if (IsSpace(static_cast<unsigned char>(buffer_[i + 1]))) {
+        if (c == ',' || c == ':') {
+          clause = i + 1;
+        } else {
+          end = i + 1;
+        }
+      }
+    } else if (c == 0xE3 || c == 0xEF) {
+      if (i + 2 >= buffer_.size()) break;  // wait for the rest of the character
+      if (size_t len = CjkTerminatorLength(buffer_, i)) {
+        end = i + len;
+      } else if (size_t len2 = CjkClauseLength(buffer_, i)) {
+        clause = i + len2;
+      }
+    }
+
+    if (end > 0 && end >= options_.minChars) {
+      Emit(end, out);
+      i = 0;
+    } else if (end > 0 || clause > 0) {
+      // A short sentence ("Dr.", "Hi.") only joins the next one, but may still end a clause.
+      clauseEnd_ = std::max(end, clause);
+      i = clauseEnd_;
+    } else {
+      ++i;
+    }
+  }
+  scan_ = i;
+}
+
+FirstChunkPlanner::FirstChunkPlanner() = default;
+
+FirstChunkPlanner::FirstChunkPlanner(const Options& options) : options_(options) {}
+
+size_t FirstChunkPlanner::Budget(int32_t targetMs) const {
+  if (targetMs <= 0) return 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (msPerChar_ <= 0.0) return std::clamp(options_.initialChars, options_.minChars, options_.maxChars);
+  const double chars = static_cast<double>(targetMs) / msPerChar_;
+  if (chars >= static_cast<double>(options_.maxChars)) return options_.maxChars;
+  return std::max(options_.minChars, static_cast<size_t>(chars));
+}
+
+void FirstChunkPlanner::Observe(size_t chars, int64_t elapsedMs) {
+  if (chars == 0 || elapsedMs < 0) return;
+  const double sample = static_cast<double>(elapsedMs) / static_cast<double>(chars);
+  std::lock_guard<std::mutex> lock(mutex_);
+  msPerChar_ = msPerChar_ <= 0.0 ? sample : 0.7 * msPerChar_ + 0.3 * sample;
+}
+
+double FirstChunkPlanner::MsPerChar() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return msPerChar_;
+}
+
+void FirstChunkPlanner::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  msPerChar_ = 0.0;
+}
+
+SentencePipelineStatus RunSentencePipeline(
+    const std::vector<std::string>& sentences,
+    const SentencePipelineOptions& options,
+    const SentenceSynthFn& synth,
+    const SentenceEmitFn& emit) {
+  const auto total = static_cast<int32_t>(sentences.size());
+  if (total == 0) return SentencePipelineStatus::kOk;
+  if (!synth || !emit) return SentencePipelineStatus::kFailed;
+
+  const int32_t numWorkers = std::max<int32_t>(1, std::min(options.numWorkers, total));
+  const int32_t maxAhead = options.maxAhead > 0 ? options.maxAhead : 2 * numWorkers;
+
+  struct Slot {
+    bool ready = false;
+    bool ok = false;
+    std::vector<float> samples;
+  };
+  std::vector<Slot> slots(static_cast<size_t>(total));
+  std::mutex mutex;
+  std::condition_variable cv;
+  int32_t nextToClaim = 0;
+  int32_t nextToEmit = 0;
+  bool stop = false;
+
+  auto worker = [&](int32_t workerIndex) {
+    for (;;) {
+      int32_t index;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        // Bound buffered audio: do not run too far ahead of the emitter.
+        cv.wait(lock, [&] { return stop || nextToClaim >= total || nextToClaim < nextToEmit + maxAhead; });
+        if (stop || nextToClaim >= total) return;
+        index = nextToClaim++;
+      }
+      std::vector<float> samples;
+      bool ok = false;
+      try {
+        ok = synth(workerIndex, sentences[static_cast<size_t>(index)], &samples);
+      } catch (...) {
+        ok = false;
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        Slot& slot = slots[static_cast<size_t>(index)];
+        slot.ready = true;
+        slot.ok = ok;
+        slot.samples = std::move(samples);
+        if (!ok) stop = true;
+      }
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(static_cast<size_t>(numWorkers));
+  for (int32_t w = 0; w < numWorkers; ++w) threads.emplace_back(worker, w);
+
+  const std::vector<float> silence(static_cast<size_t>(std::max<int32_t>(0, options.silenceSamples)), 0.0f);
+  SentencePipelineStatus status = SentencePipelineStatus::kOk;
+  for (int32_t i = 0; i < total; ++i) {
+    std::vector<float> samples;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      Slot& slot = slots[static_cast<size_t>(i)];
+      // Wait for sentence i, unless a failure stopped the workers before anyone claimed it.
+      cv.wait(lock, [&] { return slot.ready || (stop && nextToClaim <= i); });
+      if (!slot.ready || !slot.ok) {
+        status = SentencePipelineStatus::kFailed;
+        stop = true;
+        break;
+      }
+      samples = std::move(slot.samples);
+      nextToEmit = i + 1;
+    }
+    cv.notify_all();
+
+    bool cont = true;
+    if (i > 0 && !silence.empty() && !(i == 1 && options.firstIsClause)) {
+      cont = emit(silence.data(), static_cast<int32_t>(silence.size()), i, total);
+    }
+    if (cont && !samples.empty()) {
+      cont = emit(samples.data(), static_cast<int32_t>(samples.size()), i, total);
+    }
+    if (!cont) {
+      status = SentencePipelineStatus::kCancelled;
+      break;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  cv.notify_all();
+  for (auto& t : threads) t.join();
+  return status;
+}
+
+}  // namespace sherpaonnx
@@ -0,0 +1,167 @@
+/**
+ * sherpa-onnx-tts-sentence-pipeline.h
+ *
+ * Declares the long-text TTS pipeline: split text into sentences, synthesize them on a small pool
+ * of engines in parallel, and hand the audio back strictly in sentence order as soon as each
+ * prefix is complete. Also holds the leading-clause split and budget planner used by the streaming
+ * first-chunk fast path, and the incremental segmenter for text that arrives in fragments.
+ * Engine-agnostic (synthesis is a callback), so it is shared by the Android
+ * Zipvoice JNI and the iOS TtsWrapper (mirrored in ios/tts).
+ */
+#ifndef SHERPA_ONNX_TTS_SENTENCE_PIPELINE_H
+#define SHERPA_ONNX_TTS_SENTENCE_PIPELINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sherpaonnx {
+
+/**
+ * Split UTF-8 text into sentences on . ! ? ; (followed by whitespace or end), CJK 。！？；, and
+ * newlines. Sentences longer than maxChars bytes are further split at the last comma or space.
+ * Whitespace-only pieces are dropped; surrounding whitespace is trimmed.
+ */
+std::vector<std::string> SplitSentences(const std::string& text, size_t maxChars = 400);
+
+/**
+ * Split a short leading clause off text so the first audio can be synthesized quickly. Breaks at
+ * the last clause punctuation (, ; : . ! ? followed by whitespace, or CJK ，、；：。！？) that ends
+ * within maxChars bytes and leaves at least minChars in the head; otherwise at the last space;
+ * otherwise, for non-ASCII text, at a UTF-8 character boundary. Returns {head, rest}, trimmed.
+ * head is empty (and rest is the trimmed text) when the text already fits in maxChars or no
+ * suitable break exists.
+ */
+std::pair<std::string, std::string> SplitLeadingClause(
+    const std::string& text, size_t maxChars, size_t minChars = 8);
+
+/**
+ * Cuts text that arrives in fragments (e.g. tokens from a streaming LLM) into segments that can be
+ * synthesized as soon as their end is known. Segments end at sentence terminators as in
+ * SplitSentences (an ASCII terminator waits for the next character to rule out "3.14") and at
+ * newlines. So that a long sentence does not hold back audio, pending text that reaches
+ * clauseChars bytes (firstClauseChars for the first segment after construction, Flush or Reset) is
+ * cut at its last clause punctuation (, : or CJK ，、：). Pieces shorter than minChars bytes
+ * ("Dr.", "1.") are merged with what follows; pending text over maxChars is cut at the last space.
+ * Segments are trimmed and never empty. Not thread-safe.
+ */
+class IncrementalTextSegmenter {
+ public:
+  struct Options {
+    size_t minChars = 12;
+    size_t firstClauseChars = 48;
+    size_t clauseChars = 120;
+    size_t maxChars = 400;
+  };
+
+  IncrementalTextSegmenter();
+  explicit IncrementalTextSegmenter(const Options& options);
+
+  /** Clause threshold of the next first segment (e.g. a FirstChunkPlanner budget); 0 keeps it. */
+  void SetFirstClauseChars(size_t chars);
+
+  /** Append a fragment; returns the segments it completed, in order (often none). */
+  std::vector<std::string> Push(const std::string& fragment);
+
+  /** End of input for now: returns the pending text as a segment (if not blank). */
+  std::vector<std::string> Flush();
+
+  /** Drop pending text. */
+  void Reset();
+
+  /** Bytes received but not yet returned in a segment. */
+  size_t PendingBytes() const { return buffer_.size(); }
+
+ private:
+  void Extract(std::vector<std::string>* out);
+  void Emit(size_t end, std::vector<std::string>* out);
+  size_t HardCut() const;
+
+  Options options_;
+  std::string buffer_;    // pending text, never starting with whitespace
+  size_t scan_ = 0;       // next byte of buffer_ to examine
+  size_t clauseEnd_ = 0;  // end of the last clause break seen in buffer_ (0 = none)
+  bool first_ = true;
+};
+
+/**
+ * Chooses the leading-clause budget for a time-to-first-audio target. Keeps an exponential moving
+ * average of the measured cost (ms of time-to-first-audio per byte of leading text) per engine;
+ * since the budget is target / cost, repeated requests converge on a head that meets the target.
+ * Thread-safe.
+ */
+class FirstChunkPlanner {
+ public:
+  struct Options {
+    size_t minChars = 12;
+    size_t maxChars = 160;
+    /** Budget used until the first observation. */
+    size_t initialChars = 48;
+  };
+
+  FirstChunkPlanner();
+  explicit FirstChunkPlanner(const Options& options);
+
+  /** Byte budget for the leading clause; 0 when targetMs <= 0 (fast path disabled). */
+  size_t Budget(int32_t targetMs) const;
+
+  /** Record that a leading clause of `chars` bytes produced its first audio after elapsedMs. */
+  void Observe(size_t chars, int64_t elapsedMs);
+
+  /** Current cost estimate in ms per byte; 0 before the first observation. */
+  double MsPerChar() const;
+
+  /** Forget the estimate (e.g. when the engine is replaced). */
+  void Reset();
+
+ private:
+  Options options_;
+  mutable std::mutex mutex_;
+  double msPerChar_ = 0.0;
+};
+
+struct SentencePipelineOptions {
+  /** Number of synthesis workers (one engine each). Values < 1 are treated as 1. */
+  int32_t numWorkers = 2;
+  /** Zero samples emitted between consecutive sentences. */
+  int32_t silenceSamples = 0;
+  /** How many sentences workers may run ahead of the emitter (bounds buffered audio). 0 = 2 * numWorkers. */
+  int32_t maxAhead = 0;
+  /** sentences[0] is a leading clause split off sentences[1]: no silence is inserted between them. */
+  bool firstIsClause = false;
+};
+
+/**
+ * Synthesize one sentence on engine `worker` (0 .. numWorkers-1). Each worker index is used by
+ * exactly one thread at a time. Return false on failure; out may legitimately stay empty.
+ */
+using SentenceSynthFn =
+    std::function<bool(int32_t worker, const std::string& sentence, std::vector<float>* out)>;
+
+/**
+ * Receives audio in sentence order on the thread that called RunSentencePipeline. Silence between
+ * sentences is delivered as its own call with the index of the following sentence.
+ * Return false to cancel the remaining work.
+ */
+using SentenceEmitFn =
+    std::function<bool(const float* samples, int32_t n, int32_t sentenceIndex, int32_t numSentences)>;
+
+enum class SentencePipelineStatus { kOk, kCancelled, kFailed };
+
+/**
+ * Run the pipeline to completion. All worker threads are joined before returning, so the synth
+ * callback's captures only need to outlive this call.
+ */
+SentencePipelineStatus RunSentencePipeline(
+    const std::vector<std::string>& sentences,
+    const SentencePipelineOptions& options,
+    const SentenceSynthFn& synth,
+    const SentenceEmitFn& emit);
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_TTS_SENTENCE_PIPELINE_H
@@ -0,0 +1,100 @@
+/**
+ * sherpa-onnx-tts-stats-jni.cpp
+ *
+ * Purpose: JNI for TtsStatsRecorder (Kotlin). Owns one native sherpaonnx::TtsStatsRecorder per
+ * handle; requests are timed in Kotlin and recorded here, so nothing native is held per request.
+ */
+#include <jni.h>
+#include <vector>
+
+#include "sherpa-onnx-tts-stats.h"
+
+namespace {
+
+sherpaonnx::TtsStatsRecorder* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::TtsStatsRecorder*>(ptr);
+}
+
+jdoubleArray ToJava(JNIEnv* env, const std::vector<double>& values) {
+  jdoubleArray out = env->NewDoubleArray(static_cast<jsize>(values.size()));
+  if (out && !values.empty()) {
+    env->SetDoubleArrayRegion(out, 0, static_cast<jsize>(values.size()), values.data());
+  }
+  return out;
+}
+
+// [count, mean, min, max, p50, p90, p99, numBounds, bounds..., counts... (numBounds + 1)]
+void AppendHistogram(std::vector<double>* out, const sherpaonnx::StatsHistogram& h) {
+  out->insert(out->end(), {static_cast<double>(h.Count()), h.Mean(), h.Min(), h.Max(),
+                           h.Percentile(0.5), h.Percentile(0.9), h.Percentile(0.99),
+                           static_cast<double>(h.UpperBounds().size())});
+  out->insert(out->end(), h.UpperBounds().begin(), h.UpperBounds().end());
+  for (uint64_t c : h.Counts()) out->push_back(static_cast<double>(c));
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_TtsStatsRecorder_nativeCreate(JNIEnv* /* env */, jclass /* clazz */) {
+  return reinterpret_cast<jlong>(new sherpaonnx::TtsStatsRecorder());
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsStatsRecorder_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+// Records one request measured in Kotlin (chunkSamples: size of every chunk handed out).
+// Returns [timeToFirstChunkMs, synthesisMs, audioMs, realTimeFactor, chunkCount,
+//          minChunkSamples, meanChunkSamples, maxChunkSamples, bytesCopied].
+JNIEXPORT jdoubleArray JNICALL
+Java_com_sherpaonnx_TtsStatsRecorder_nativeRecord(JNIEnv* env, jclass /* clazz */, jlong ptr,
+                                                  jlong timeToFirstChunkMs, jlong synthesisMs,
+                                                  jintArray chunkSamples, jlong totalSamples,
+                                                  jint sampleRate, jlong bytesCopied) {
+  sherpaonnx::TtsRequestStats s;
+  s.timeToFirstChunkMs = timeToFirstChunkMs;
+  s.synthesisMs = synthesisMs;
+  s.bytesCopied = bytesCopied > 0 ? static_cast<uint64_t>(bytesCopied) : 0;
+  if (chunkSamples) {
+    const jsize n = env->GetArrayLength(chunkSamples);
+    jint* sizes = env->GetIntArrayElements(chunkSamples, nullptr);
+    if (sizes) {
+      for (jsize i = 0; i < n; ++i) s.chunkSamples.Record(static_cast<double>(sizes[i]));
+      env->ReleaseIntArrayElements(chunkSamples, sizes, JNI_ABORT);
+    }
+    s.chunkCount = static_cast<int32_t>(n);
+  }
+  sherpaonnx::CompleteRequestStats(&s, static_cast<uint64_t>(totalSamples > 0 ? totalSamples : 0),
+                                   sampleRate);
+  if (auto* recorder = FromHandle(ptr)) recorder->Record(s);
+  return ToJava(env, {static_cast<double>(s.timeToFirstChunkMs), static_cast<double>(s.synthesisMs),
+                      static_cast<double>(s.audioMs), s.realTimeFactor,
+                      static_cast<double>(s.chunkCount), s.chunkSamples.Min(), s.chunkSamples.Mean(),
+                      s.chunkSamples.Max(), static_cast<double>(s.bytesCopied)});
+}
+
+// Returns [requests, totalAudioMs, totalSynthesisMs, bytesCopied] followed by the histograms
+// timeToFirstChunkMs, synthesisMs, realTimeFactor, chunkSamples (see AppendHistogram).
+JNIEXPORT jdoubleArray JNICALL
+Java_com_sherpaonnx_TtsStatsRecorder_nativeSnapshot(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  auto* recorder = FromHandle(ptr);
+  sherpaonnx::TtsStatsSnapshot s = recorder ? recorder->Snapshot() : sherpaonnx::TtsStatsSnapshot();
+  std::vector<double> out = {static_cast<double>(s.requests), static_cast<double>(s.totalAudioMs),
+                             static_cast<double>(s.totalSynthesisMs), static_cast<double>(s.bytesCopied)};
+  AppendHistogram(&out, s.timeToFirstChunkMs);
+  AppendHistogram(&out, s.synthesisMs);
+  AppendHistogram(&out, s.realTimeFactor);
+  AppendHistogram(&out, s.chunkSamples);
+  return ToJava(env, out);
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsStatsRecorder_nativeReset(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  auto* recorder = FromHandle(ptr);
+  if (recorder) recorder->Reset();
+}
+
+}  // extern "C"
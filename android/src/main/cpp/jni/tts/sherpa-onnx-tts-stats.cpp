@@ -0,0 +1,137 @@
+/**
+ * sherpa-onnx-tts-stats.cpp
+ *
+ * Purpose: Per-request TTS timing and the per-instance histograms it feeds. Recording is a few
+ * arithmetic operations per chunk, so it is always on.
+ */
+#include "sherpa-onnx-tts-stats.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace sherpaonnx {
+
+namespace {
+
+std::vector<double> Doubling(double first, size_t n) {
+  std::vector<double> bounds;
+  bounds.reserve(n);
+  for (double b = first; bounds.size() < n; b *= 2.0) bounds.push_back(b);
+  return bounds;
+}
+
+}  // namespace
+
+std::vector<double> LatencyBucketsMs() { return Doubling(10.0, 13); }
+
+std::vector<double> RealTimeFactorBuckets() {
+  return {0.05, 0.1, 0.2, 0.3, 0.5, 0.75, 1.0, 1.5, 2.0, 4.0};
+}
+
+std::vector<double> ChunkSizeBuckets() { return Doubling(128.0, 11); }
+
+StatsHistogram::StatsHistogram(std::vector<double> upperBounds)
+    : upperBounds_(std::move(upperBounds)), counts_(upperBounds_.size() + 1, 0) {}
+
+void StatsHistogram::Record(double value) {
+  const size_t bucket = static_cast<size_t>(
+      std::lower_bound(upperBounds_.begin(), upperBounds_.end(), value) - upperBounds_.begin());
+  ++counts_[bucket];
+  if (count_ == 0) {
+    min_ = max_ = value;
+  } else {
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+  ++count_;
+  sum_ += value;
+}
+
+void StatsHistogram::Merge(const StatsHistogram& other) {
+  if (other.count_ == 0 || other.upperBounds_ != upperBounds_) return;
+  for (size_t i = 0; i < counts_.size(); ++i) counts_[i] += other.counts_[i];
+  min_ = count_ ? std::min(min_, other.min_) : other.min_;
+  max_ = count_ ? std::max(max_, other.max_) : other.max_;
+  count_ += other.count_;
+  sum_ += other.sum_;
+}
+
+void StatsHistogram::Clear() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  count_ = 0;
+  sum_ = min_ = max_ = 0.0;
+}
+
+double StatsHistogram::Percentile(double p) const {
+  if (count_ == 0) return 0.0;
+  p = std::min(std::max(p, 0.0), 1.0);
+  const double rank = p * static_cast<double>(count_);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    if (counts_[i] == 0) continue;
+    if (static_cast<double>(seen + counts_[i]) >= rank) {
+      const double lo = std::max(i == 0 ? min_ : upperBounds_[i - 1], min_);
+      const double hi = std::min(i < upperBounds_.size() ? upperBounds_[i] : max_, max_);
+      const double within = (rank - static_cast<double>(seen)) / static_cast<double>(counts_[i]);
+      return lo + (hi - lo) * within;
+    }
+    seen += counts_[i];
+  }
+  return max_;
+}
+
+void TtsRequestTimer::OnChunk(size_t numSamples) {
+  if (numSamples == 0) return;
+  if (stats_.timeToFirstChunkMs < 0) {
+    stats_.timeToFirstChunkMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_).count();
+  }
+  ++stats_.chunkCount;
+  stats_.chunkSamples.Record(static_cast<double>(numSamples));
+}
+
+void CompleteRequestStats(TtsRequestStats* stats, uint64_t totalSamples, int32_t sampleRate,
+                          int32_t numChannels) {
+  stats->audioMs = 0;
+  if (sampleRate > 0 && numChannels > 0) {
+    stats->audioMs = static_cast<int64_t>(totalSamples * 1000 /
+                                          (static_cast<uint64_t>(sampleRate) * numChannels));
+  }
+  stats->realTimeFactor = stats->audioMs > 0
+      ? static_cast<double>(stats->synthesisMs) / static_cast<double>(stats->audioMs)
+      : 0.0;
+}
+
+TtsRequestStats TtsRequestTimer::Finish(uint64_t totalSamples, int32_t sampleRate, int32_t numChannels) {
+  TtsRequestStats out = stats_;
+  out.synthesisMs =
+      std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_).count();
+  CompleteRequestStats(&out, totalSamples, sampleRate, numChannels);
+  return out;
+}
+
+void TtsStatsRecorder::Record(const TtsRequestStats& stats) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++totals_.requests;
+  totals_.totalAudioMs += static_cast<uint64_t>(std::max<int64_t>(stats.audioMs, 0));
+  totals_.totalSynthesisMs += static_cast<uint64_t>(std::max<int64_t>(stats.synthesisMs, 0));
+  totals_.bytesCopied += stats.bytesCopied;
+  if (stats.timeToFirstChunkMs >= 0) {
+    totals_.timeToFirstChunkMs.Record(static_cast<double>(stats.timeToFirstChunkMs));
+  }
+  totals_.synthesisMs.Record(static_cast<double>(stats.synthesisMs));
+  if (stats.audioMs > 0) totals_.realTimeFactor.Record(stats.realTimeFactor);
+  totals_.chunkSamples.Merge(stats.chunkSamples);
+}
+
+TtsStatsSnapshot TtsStatsRecorder::Snapshot() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return totals_;
+}
+
+void TtsStatsRecorder::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  totals_ = TtsStatsSnapshot();
+}
+
+}  // namespace sherpaonnx
@@ -0,0 +1,146 @@
+/**
+ * sherpa-onnx-tts-stats.h
+ *
+ * Declares TTS request instrumentation: TtsRequestTimer measures one request (time to first
+ * chunk, synthesis time, audio duration, chunk sizes, bytes copied out of native code) and
+ * TtsStatsRecorder aggregates finished requests into histograms. Shared by the Android JNI and the
+ * iOS TtsWrapper (mirrored in ios/tts).
+ */
+#ifndef SHERPA_ONNX_TTS_STATS_H
+#define SHERPA_ONNX_TTS_STATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace sherpaonnx {
+
+/**
+ * Fixed-bucket histogram. Bucket i counts values <= UpperBounds()[i] (and above the previous
+ * bound); one extra overflow bucket counts the rest, so Counts().size() == UpperBounds().size() + 1.
+ */
+class StatsHistogram {
+ public:
+  StatsHistogram() = default;
+  /** upperBounds must be ascending. */
+  explicit StatsHistogram(std::vector<double> upperBounds);
+
+  void Record(double value);
+  /** Add other's counts; both must have the same bounds (otherwise this is a no-op). */
+  void Merge(const StatsHistogram& other);
+  void Clear();
+
+  uint64_t Count() const { return count_; }
+  double Sum() const { return sum_; }
+  double Mean() const { return count_ ? sum_ / static_cast<double>(count_) : 0.0; }
+  double Min() const { return count_ ? min_ : 0.0; }
+  double Max() const { return count_ ? max_ : 0.0; }
+
+  /**
+   * Estimated p-quantile (p in [0, 1]): linear interpolation inside the bucket that holds it,
+   * clamped to the observed min and max. 0 when empty.
+   */
+  double Percentile(double p) const;
+
+  const std::vector<double>& UpperBounds() const { return upperBounds_; }
+  const std::vector<uint64_t>& Counts() const { return counts_; }
+
+ private:
+  std::vector<double> upperBounds_;
+  std::vector<uint64_t> counts_ = std::vector<uint64_t>(1, 0);
+  uint64_t count_ = 0;
+  double sum_ = 0.0;
+  double min_ = 0.0;
+  double max_ = 0.0;
+};
+
+/** Default buckets: milliseconds (10 ms .. ~41 s, doubling). */
+std::vector<double> LatencyBucketsMs();
+/** Default buckets: real-time factor (synthesis time / audio duration). */
+std::vector<double> RealTimeFactorBuckets();
+/** Default buckets: samples per emitted chunk (128 .. 128k, doubling). */
+std::vector<double> ChunkSizeBuckets();
+
+/** Measurements of one TTS request. */
+struct TtsRequestStats {
+  /** From the start of the request to the first non-empty chunk; -1 if none was produced. */
+  int64_t timeToFirstChunkMs = -1;
+  /** From the start of the request to Finish(). */
+  int64_t synthesisMs = 0;
+  /** Duration of the produced audio. */
+  int64_t audioMs = 0;
+  /** synthesisMs / audioMs (< 1 is faster than real time); 0 when no audio was produced. */
+  double realTimeFactor = 0.0;
+  int32_t chunkCount = 0;
+  /** Samples per chunk. */
+  StatsHistogram chunkSamples{ChunkSizeBuckets()};
+  /** PCM payload bytes copied out of native code (JNI arrays, bridge arrays). */
+  uint64_t bytesCopied = 0;
+};
+
+/** Fill audioMs and realTimeFactor from the produced sample count and stats->synthesisMs. */
+void CompleteRequestStats(TtsRequestStats* stats, uint64_t totalSamples, int32_t sampleRate,
+                          int32_t numChannels = 1);
+
+/**
+ * Times one request. Starts on construction; call OnChunk() for every chunk handed to the
+ * caller (a non-streaming request is one chunk) and Finish() once. Not thread-safe: use it from
+ * the generating thread.
+ */
+class TtsRequestTimer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  TtsRequestTimer() : start_(Clock::now()) {}
+
+  /**
+   * Restart the clock once the request holds the engine, so the wait in the engine's queue
+   * (reported as queueWaitMs) is not counted as synthesis. Only the first call has an effect.
+   */
+  void OnEngineAcquired() {
+    if (engineAcquired_) return;
+    engineAcquired_ = true;
+    start_ = Clock::now();
+  }
+
+  void OnChunk(size_t numSamples);
+  void AddBytesCopied(uint64_t bytes) { stats_.bytesCopied += bytes; }
+
+  /** Final stats for audio of totalSamples (all channels) at sampleRate. */
+  TtsRequestStats Finish(uint64_t totalSamples, int32_t sampleRate, int32_t numChannels = 1);
+
+ private:
+  Clock::time_point start_;
+  bool engineAcquired_ = false;
+  TtsRequestStats stats_;
+};
+
+/** Aggregated stats over every request recorded since construction or the last Reset(). */
+struct TtsStatsSnapshot {
+  uint64_t requests = 0;
+  uint64_t totalAudioMs = 0;
+  uint64_t totalSynthesisMs = 0;
+  uint64_t bytesCopied = 0;
+  StatsHistogram timeToFirstChunkMs{LatencyBucketsMs()};
+  StatsHistogram synthesisMs{LatencyBucketsMs()};
+  StatsHistogram realTimeFactor{RealTimeFactorBuckets()};
+  StatsHistogram chunkSamples{ChunkSizeBuckets()};
+};
+
+/** Thread-safe aggregation of TtsRequestStats for one TTS instance. */
+class TtsStatsRecorder {
+ public:
+  void Record(const TtsRequestStats& stats);
+  TtsStatsSnapshot Snapshot() const;
+  void Reset();
+
+ private:
+  mutable std::mutex mutex_;
+  TtsStatsSnapshot totals_;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_TTS_STATS_H
@@ -0,0 +1,107 @@
+/**
+ * sherpa-onnx-tts-step-planner-jni.cpp
+ *
+ * Purpose: JNI for ZipvoiceStepPlanner (Kotlin). Owns one native sherpaonnx::ZipvoiceStepPlanner
+ * per handle (one per Zipvoice engine); the helper times each voice-cloning request and asks it for
+ * the step count that fits the request's latency budget.
+ */
+#include <jni.h>
+#include <string>
+
+#include "sherpa-onnx-tts-step-planner.h"
+
+namespace {
+
+sherpaonnx::ZipvoiceStepPlanner* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::ZipvoiceStepPlanner*>(ptr);
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_ZipvoiceStepPlanner_nativeCreate(JNIEnv* /* env */, jclass /* clazz */) {
+  return reinterpret_cast<jlong>(new sherpaonnx::ZipvoiceStepPlanner());
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_ZipvoiceStepPlanner_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+JNIEXPORT jdouble JNICALL
+Java_com_sherpaonnx_ZipvoiceStepPlanner_nativeFlowSeconds(JNIEnv* /* env */, jclass /* clazz */,
+                                                          jint textBytes, jint promptTextBytes,
+                                                          jdouble promptSeconds, jfloat speed) {
+  return sherpaonnx::ZipvoiceStepPlanner::FlowSeconds(static_cast<size_t>(textBytes > 0 ? textBytes : 0),
+                                                      static_cast<size_t>(promptTextBytes > 0 ? promptTextBytes : 0),
+                                                      promptSeconds, speed);
+}
+
+// Returns [numSteps, predictedMs, fits (0/1)].
+JNIEXPORT jdoubleArray JNICALL
+Java_com_sherpaonnx_ZipvoiceStepPlanner_nativeChoose(JNIEnv* env, jclass /* clazz */, jlong ptr,
+                                                     jdouble budgetMs, jdouble flowSeconds, jint maxSteps) {
+  auto* planner = FromHandle(ptr);
+  if (!planner) return nullptr;
+  const auto choice = planner->Choose(budgetMs, flowSeconds, maxSteps);
+  const jdouble values[] = {static_cast<jdouble>(choice.numSteps), choice.predictedMs, choice.fits ? 1.0 : 0.0};
+  jdoubleArray out = env->NewDoubleArray(3);
+  if (out) env->SetDoubleArrayRegion(out, 0, 3, values);
+  return out;
+}
+
+JNIEXPORT jdouble JNICALL
+Java_com_sherpaonnx_ZipvoiceStepPlanner_nativePredictMs(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                        jdouble flowSeconds, jint numSteps) {
+  auto* planner = FromHandle(ptr);
+  return planner ? planner->PredictMs(flowSeconds, numSteps) : -1.0;
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_ZipvoiceStepPlanner_nativeObserve(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                      jdouble flowSeconds, jint numSteps, jdouble elapsedMs) {
+  if (auto* planner = FromHandle(ptr)) planner->Observe(flowSeconds, numSteps, elapsedMs);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_ZipvoiceStepPlanner_nativeCalibrate(JNIEnv* /* env */, jclass /* clazz */, jlong ptr,
+                                                        jdouble flowSeconds, jint stepsLo, jdouble msLo,
+                                                        jint stepsHi, jdouble msHi) {
+  auto* planner = FromHandle(ptr);
+  return planner && planner->Calibrate(flowSeconds, stepsLo, msLo, stepsHi, msHi) ? JNI_TRUE : JNI_FALSE;
+}
+
+// Returns [overheadMsPerSec, stepMsPerSec, scale, calibrated (0/1), observations].
+JNIEXPORT jdoubleArray JNICALL
+Java_com_sherpaonnx_ZipvoiceStepPlanner_nativeModel(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  auto* planner = FromHandle(ptr);
+  if (!planner) return nullptr;
+  const auto m = planner->GetModel();
+  const jdouble values[] = {m.overheadMsPerSec, m.stepMsPerSec, m.scale, m.calibrated ? 1.0 : 0.0,
+                            static_cast<jdouble>(m.observations)};
+  jdoubleArray out = env->NewDoubleArray(5);
+  if (out) env->SetDoubleArrayRegion(out, 0, 5, values);
+  return out;
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_sherpaonnx_ZipvoiceStepPlanner_nativeSerialize(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  auto* planner = FromHandle(ptr);
+  return planner ? env->NewStringUTF(planner->Serialize().c_str()) : nullptr;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_ZipvoiceStepPlanner_nativeRestore(JNIEnv* env, jclass /* clazz */, jlong ptr,
+                                                      jstring text) {
+  auto* planner = FromHandle(ptr);
+  if (!planner || !text) return JNI_FALSE;
+  const char* c = env->GetStringUTFChars(text, nullptr);
+  if (!c) return JNI_FALSE;
+  const bool ok = planner->Restore(c);
+  env->ReleaseStringUTFChars(text, c);
+  return ok ? JNI_TRUE : JNI_FALSE;
+}
+
+}  // extern "C"
@@ -0,0 +1,133 @@
+/**
+ * sherpa-onnx-tts-step-planner.cpp
+ *
+ * Purpose: Deadline-aware num_steps choice for Zipvoice voice cloning. Flow-matching time grows
+ * linearly with the step count, so a two-point calibration per device plus a running correction
+ * predicts the cost of any step count for a given prompt and text.
+ */
+#include "sherpa-onnx-tts-step-planner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace sherpaonnx {
+
+namespace {
+
+constexpr const char* kSerializedTag = "zvsteps1";
+
+}  // namespace
+
+ZipvoiceStepPlanner::ZipvoiceStepPlanner() = default;
+
+ZipvoiceStepPlanner::ZipvoiceStepPlanner(const Options& options) : options_(options) {
+  options_.minSteps = std::max<int32_t>(1, options_.minSteps);
+  options_.maxSteps = std::max(options_.minSteps, options_.maxSteps);
+}
+
+double ZipvoiceStepPlanner::FlowSeconds(size_t textBytes, size_t promptTextBytes, double promptSeconds,
+                                        float speed) {
+  if (promptSeconds <= 0.0) return 0.0;
+  const double ratio = static_cast<double>(textBytes) / static_cast<double>(std::max<size_t>(1, promptTextBytes));
+  return promptSeconds * (1.0 + ratio / (speed > 0.0f ? speed : 1.0f));
+}
+
+bool ZipvoiceStepPlanner::Calibrate(double flowSeconds, int32_t stepsLo, double msLo, int32_t stepsHi,
+                                    double msHi) {
+  if (flowSeconds <= 0.0 || stepsLo <= 0 || stepsHi <= stepsLo || msLo <= 0.0 || msHi <= msLo) {
+    return false;
+  }
+  const double stepMsPerSec = (msHi - msLo) / (static_cast<double>(stepsHi - stepsLo) * flowSeconds);
+  const double overheadMsPerSec = std::max(0.0, msLo / flowSeconds - stepsLo * stepMsPerSec);
+  std::lock_guard<std::mutex> lock(mutex_);
+  model_.stepMsPerSec = stepMsPerSec;
+  model_.overheadMsPerSec = overheadMsPerSec;
+  model_.scale = 1.0;
+  model_.calibrated = true;
+  return true;
+}
+
+void ZipvoiceStepPlanner::Observe(double flowSeconds, int32_t numSteps, double elapsedMs) {
+  if (flowSeconds <= 0.0 || numSteps <= 0 || elapsedMs <= 0.0) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++model_.observations;
+  if (model_.stepMsPerSec <= 0.0) {
+    const double msPerSec = elapsedMs / flowSeconds;
+    model_.stepMsPerSec = msPerSec / (numSteps + options_.priorOverheadSteps);
+    model_.overheadMsPerSec = options_.priorOverheadSteps * model_.stepMsPerSec;
+    model_.scale = 1.0;
+    return;
+  }
+  const double unscaled = flowSeconds * (model_.overheadMsPerSec + numSteps * model_.stepMsPerSec);
+  const double ratio = elapsedMs / unscaled;
+  model_.scale = (1.0 - options_.smoothing) * model_.scale + options_.smoothing * ratio;
+}
+
+double ZipvoiceStepPlanner::PredictLocked(double flowSeconds, int32_t numSteps) const {
+  if (model_.stepMsPerSec <= 0.0 || flowSeconds <= 0.0) return -1.0;
+  return flowSeconds * model_.scale * (model_.overheadMsPerSec + numSteps * model_.stepMsPerSec);
+}
+
+double ZipvoiceStepPlanner::PredictMs(double flowSeconds, int32_t numSteps) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return PredictLocked(flowSeconds, numSteps);
+}
+
+ZipvoiceStepPlanner::Choice ZipvoiceStepPlanner::Choose(double budgetMs, double flowSeconds,
+                                                        int32_t maxSteps) const {
+  const int32_t hi = std::max(options_.minSteps, maxSteps > 0 ? maxSteps : options_.maxSteps);
+  Choice choice;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (model_.stepMsPerSec <= 0.0 || flowSeconds <= 0.0) {
+    choice.numSteps = hi;
+    return choice;
+  }
+  const double perStep = flowSeconds * model_.scale * model_.stepMsPerSec;
+  const double overhead = flowSeconds * model_.scale * model_.overheadMsPerSec;
+  const double fit = std::floor((budgetMs - overhead) / perStep);
+  choice.numSteps = static_cast<int32_t>(std::clamp(fit, static_cast<double>(options_.minSteps),
+                                                    static_cast<double>(hi)));
+  choice.predictedMs = PredictLocked(flowSeconds, choice.numSteps);
+  choice.fits = choice.predictedMs <= budgetMs;
+  return choice;
+}
+
+ZipvoiceStepPlanner::Model ZipvoiceStepPlanner::GetModel() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return model_;
+}
+
+std::string ZipvoiceStepPlanner::Serialize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  char buf[160];
+  std::snprintf(buf, sizeof(buf), "%s %.6g %.6g %.6g %d %lld", kSerializedTag, model_.overheadMsPerSec,
+                model_.stepMsPerSec, model_.scale, model_.calibrated ? 1 : 0,
+                static_cast<long long>(model_.observations));
+  return buf;
+}
+
+bool ZipvoiceStepPlanner::Restore(const std::string& text) {
+  char tag[16] = {0};
+  Model m;
+  int calibrated = 0;
+  long long observations = 0;
+  if (std::sscanf(text.c_str(), "%15s %lf %lf %lf %d %lld", tag, &m.overheadMsPerSec, &m.stepMsPerSec,
+                  &m.scale, &calibrated, &observations) != 6 ||
+      std::string(tag) != kSerializedTag || !(m.stepMsPerSec > 0.0) || m.overheadMsPerSec < 0.0 ||
+      !(m.scale > 0.0)) {
+    return false;
+  }
+  m.calibrated = calibrated != 0;
+  m.observations = observations;
+  std::lock_guard<std::mutex> lock(mutex_);
+  model_ = m;
+  return true;
+}
+
+void ZipvoiceStepPlanner::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  model_ = Model();
+}
+
+}  // namespace sherpaonnx
@@ -0,0 +1,100 @@
+/**
+ * sherpa-onnx-tts-step-planner.h
+ *
+ * Declares ZipvoiceStepPlanner: picks the number of flow-matching steps for a Zipvoice
+ * voice-cloning request so it finishes within a latency budget, from a per-device cost model
+ * (calibrated once, then tracked from every request). Used by the Zipvoice JNI.
+ */
+#ifndef SHERPA_ONNX_TTS_STEP_PLANNER_H
+#define SHERPA_ONNX_TTS_STEP_PLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace sherpaonnx {
+
+/**
+ * Cost model: elapsedMs = flowSeconds * scale * (overheadMsPerSec + numSteps * stepMsPerSec), where
+ * flowSeconds is the length of the feature sequence the flow model runs over (prompt + generated
+ * audio, see FlowSeconds). Calibrate() fits the two per-second costs from runs at two step counts;
+ * Observe() keeps `scale` as a moving average of measured / predicted time, so thermal throttling
+ * or background load shift the choice without a new calibration. Before any calibration the first
+ * observation bootstraps the model with an assumed overhead of priorOverheadSteps steps.
+ * Thread-safe.
+ */
+class ZipvoiceStepPlanner {
+ public:
+  struct Options {
+    int32_t minSteps = 4;
+    int32_t maxSteps = 32;
+    /** Vocoder + front end cost, in steps, assumed until a calibration separates the two. */
+    double priorOverheadSteps = 2.0;
+    /** Weight of a new observation in the scale average. */
+    double smoothing = 0.3;
+  };
+
+  struct Model {
+    double overheadMsPerSec = 0.0;
+    double stepMsPerSec = 0.0;
+    double scale = 1.0;
+    bool calibrated = false;
+    int64_t observations = 0;
+  };
+
+  struct Choice {
+    int32_t numSteps = 0;
+    /** Predicted generation time; < 0 when there is no cost model yet. */
+    double predictedMs = -1.0;
+    /** Whether predictedMs is within the budget (true when unknown). */
+    bool fits = true;
+  };
+
+  ZipvoiceStepPlanner();
+  explicit ZipvoiceStepPlanner(const Options& options);
+
+  /**
+   * Seconds of features Zipvoice generates over: the prompt plus the target, whose duration it
+   * derives from the prompt's seconds per text byte, divided by speed.
+   */
+  static double FlowSeconds(size_t textBytes, size_t promptTextBytes, double promptSeconds, float speed);
+
+  /**
+   * Fit the model from the same request timed at two step counts (stepsLo < stepsHi). Returns
+   * false (model unchanged) when the timings are not usable, e.g. the slower run was not slower.
+   */
+  bool Calibrate(double flowSeconds, int32_t stepsLo, double msLo, int32_t stepsHi, double msHi);
+
+  /** Record a finished request. */
+  void Observe(double flowSeconds, int32_t numSteps, double elapsedMs);
+
+  /**
+   * Largest step count in [minSteps, maxSteps] predicted to finish within budgetMs (minSteps when
+   * none fits). maxSteps <= 0 uses Options::maxSteps. Without a model, returns maxSteps.
+   */
+  Choice Choose(double budgetMs, double flowSeconds, int32_t maxSteps = 0) const;
+
+  /** Predicted time for numSteps; < 0 without a model. */
+  double PredictMs(double flowSeconds, int32_t numSteps) const;
+
+  Model GetModel() const;
+
+  /** One-line text form of the model, for storing the calibration across launches. */
+  std::string Serialize() const;
+  /** Load a Serialize() result; returns false (model unchanged) if it does not parse. */
+  bool Restore(const std::string& text);
+
+  void Reset();
+
+ private:
+  double PredictLocked(double flowSeconds, int32_t numSteps) const;
+
+  Options options_;
+  mutable std::mutex mutex_;
+  Model model_;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_TTS_STEP_PLANNER_H
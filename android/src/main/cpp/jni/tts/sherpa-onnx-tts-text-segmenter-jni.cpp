@@ -0,0 +1,75 @@
+/**
+ * sherpa-onnx-tts-text-segmenter-jni.cpp
+ *
+ * Purpose: JNI for TtsTextSegmenter (Kotlin). Owns one native sherpaonnx::IncrementalTextSegmenter
+ * per handle; text sessions push LLM fragments through it and synthesize each returned segment.
+ */
+#include <jni.h>
+#include <string>
+#include <vector>
+
+#include "sherpa-onnx-jni-cache.h"
+#include "sherpa-onnx-tts-sentence-pipeline.h"
+
+namespace {
+
+std::string ToStdString(JNIEnv* env, jstring s) {
+  if (!s) return std::string();
+  const char* c = env->GetStringUTFChars(s, nullptr);
+  std::string out = c ? c : "";
+  if (c) env->ReleaseStringUTFChars(s, c);
+  return out;
+}
+
+sherpaonnx::IncrementalTextSegmenter* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::IncrementalTextSegmenter*>(ptr);
+}
+
+// String[] of segments, or null when there are none (or on allocation failure).
+jobjectArray ToStringArray(JNIEnv* env, const std::vector<std::string>& segments) {
+  if (segments.empty()) return nullptr;
+  jclass stringClass = sherpaonnx::GetJniCache().stringClass;
+  if (!stringClass) return nullptr;
+  jobjectArray out = env->NewObjectArray(static_cast<jsize>(segments.size()), stringClass, nullptr);
+  if (!out) return nullptr;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    jstring segment = env->NewStringUTF(segments[i].c_str());
+    env->SetObjectArrayElement(out, static_cast<jsize>(i), segment);
+    env->DeleteLocalRef(segment);
+  }
+  return out;
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_TtsTextSegmenter_nativeCreate(JNIEnv* /* env */, jclass /* clazz */,
+                                                  jint firstClauseChars) {
+  auto* segmenter = new sherpaonnx::IncrementalTextSegmenter();
+  if (firstClauseChars > 0) segmenter->SetFirstClauseChars(static_cast<size_t>(firstClauseChars));
+  return reinterpret_cast<jlong>(segmenter);
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsTextSegmenter_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_TtsTextSegmenter_nativePush(JNIEnv* env, jclass /* clazz */, jlong ptr,
+                                                jstring fragment) {
+  auto* segmenter = FromHandle(ptr);
+  if (!segmenter) return nullptr;
+  return ToStringArray(env, segmenter->Push(ToStdString(env, fragment)));
+}
+
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_TtsTextSegmenter_nativeFlush(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  auto* segmenter = FromHandle(ptr);
+  if (!segmenter) return nullptr;
+  return ToStringArray(env, segmenter->Flush());
+}
+
+}  // extern "C"
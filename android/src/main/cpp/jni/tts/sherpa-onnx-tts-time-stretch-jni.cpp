@@ -0,0 +1,86 @@
+/**
+ * sherpa-onnx-tts-time-stretch-jni.cpp
+ *
+ * Purpose: JNI for TtsTimeStretcher (Kotlin). One-shot stretching of generated / cached audio and
+ * one native sherpaonnx::WsolaTimeStretcher per handle for streaming generation.
+ */
+#include <jni.h>
+#include <vector>
+
+#include "sherpa-onnx-tts-time-stretch.h"
+
+namespace {
+
+sherpaonnx::WsolaTimeStretcher* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::WsolaTimeStretcher*>(ptr);
+}
+
+jfloatArray ToJava(JNIEnv* env, const std::vector<float>& samples) {
+  jfloatArray out = env->NewFloatArray(static_cast<jsize>(samples.size()));
+  if (out && !samples.empty()) {
+    env->SetFloatArrayRegion(out, 0, static_cast<jsize>(samples.size()), samples.data());
+  }
+  return out;
+}
+
+// Moves all available output of the stretcher into a new float[].
+jfloatArray TakeOutput(JNIEnv* env, sherpaonnx::WsolaTimeStretcher* stretcher) {
+  std::vector<float> out;
+  out.reserve(static_cast<size_t>(stretcher->Available()));
+  stretcher->ReadAll(&out);
+  return ToJava(env, out);
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jfloatArray JNICALL
+Java_com_sherpaonnx_TtsTimeStretcher_nativeStretch(JNIEnv* env, jclass /* clazz */,
+                                                   jfloatArray samples, jint sampleRate, jfloat tempo) {
+  if (!samples) return env->NewFloatArray(0);
+  const jsize n = env->GetArrayLength(samples);
+  float* data = env->GetFloatArrayElements(samples, nullptr);
+  if (!data) return nullptr;
+  std::vector<float> out =
+      sherpaonnx::WsolaTimeStretcher::Stretch(data, static_cast<size_t>(n), sampleRate, tempo);
+  env->ReleaseFloatArrayElements(samples, data, JNI_ABORT);
+  return ToJava(env, out);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_TtsTimeStretcher_nativeCreate(JNIEnv* /* env */, jclass /* clazz */,
+                                                  jint sampleRate, jfloat tempo) {
+  return reinterpret_cast<jlong>(new sherpaonnx::WsolaTimeStretcher(sampleRate, tempo));
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_TtsTimeStretcher_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+// Pushes samples[0, length) and returns the output that became available (possibly empty).
+JNIEXPORT jfloatArray JNICALL
+Java_com_sherpaonnx_TtsTimeStretcher_nativePush(JNIEnv* env, jclass /* clazz */, jlong ptr,
+                                                jfloatArray samples, jint length) {
+  auto* stretcher = FromHandle(ptr);
+  if (!stretcher) return env->NewFloatArray(0);
+  if (samples && length > 0) {
+    float* data = env->GetFloatArrayElements(samples, nullptr);
+    if (!data) return nullptr;
+    stretcher->Push(data, length);
+    env->ReleaseFloatArrayElements(samples, data, JNI_ABORT);
+  }
+  return TakeOutput(env, stretcher);
+}
+
+// End of stream: returns the remaining output.
+JNIEXPORT jfloatArray JNICALL
+Java_com_sherpaonnx_TtsTimeStretcher_nativeFlush(JNIEnv* env, jclass /* clazz */, jlong ptr) {
+  auto* stretcher = FromHandle(ptr);
+  if (!stretcher) return env->NewFloatArray(0);
+  stretcher->Flush();
+  return TakeOutput(env, stretcher);
+}
+
+}  // extern "C"
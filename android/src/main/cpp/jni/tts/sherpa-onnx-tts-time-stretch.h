@@ -0,0 +1,139 @@
+/**
+ * sherpa-onnx-tts-time-stretch.h
+ *
+ * Declares WsolaTimeStretcher: pitch-preserving time-scale modification (WSOLA) for generated,
+ * cached and streaming TTS audio, so a speed change does not re-run the model. Shared by the
+ * Android JNI and the iOS bridge (mirrored in ios/tts).
+ */
+#ifndef SHERPA_ONNX_TTS_TIME_STRETCH_H
+#define SHERPA_ONNX_TTS_TIME_STRETCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sherpaonnx {
+
+/**
+ * Streaming WSOLA (waveform-similarity overlap-add) for mono float PCM. Input is cut into
+ * Hann-windowed frames of ~30 ms, taken every tempo * 15 ms and overlap-added every 15 ms; each
+ * frame start is shifted by up to ~7.5 ms to the position that best continues the previous frame,
+ * which keeps pitch periods intact. tempo > 1 is faster (shorter output), < 1 slower.
+ *
+ * Push() input in any chunk sizes and Read() output as it becomes available (about one frame of
+ * latency); Flush() at the end of the stream emits the tail so the output length is input / tempo.
+ * SetTempo() may be called from another thread at any time and applies from the next frame.
+ * Otherwise not thread-safe.
+ */
+class WsolaTimeStretcher {
+ public:
+  static constexpr float kMinTempo = 0.25f;
+  static constexpr float kMaxTempo = 4.0f;
+
+  explicit WsolaTimeStretcher(int32_t sampleRate, float tempo = 1.0f);
+
+  /** Clamped to [kMinTempo, kMaxTempo]. */
+  void SetTempo(float tempo);
+  float tempo() const { return tempo_.load(std::memory_order_relaxed); }
+
+  void Push(const float* samples, int32_t n);
+  /**
+   * End of stream: process what is left (zero-padded) and trim the output to input / tempo.
+   * A Push() after Flush() starts a new stream.
+   */
+  void Flush();
+  /** Drop all state for a new stream (keeps the tempo). */
+  void Reset();
+
+  /** Output samples ready to Read(). */
+  int32_t Available() const { return static_cast<int32_t>(out_.size() - outRead_); }
+  /** Copy up to n output samples; returns the number copied. */
+  int32_t Read(float* out, int32_t n);
+  /** Append all available output to *out. */
+  void ReadAll(std::vector<float>* out);
+
+  /** One-shot stretch of a whole clip. tempo == 1 returns a copy. */
+  static std::vector<float> Stretch(const float* samples, size_t n, int32_t sampleRate, float tempo);
+
+ private:
+  void Process(bool flushing);
+  int32_t BestOffset(int64_t nominal) const;
+  void CompactInput();
+
+  int32_t frame_ = 0;     // analysis/synthesis frame length N
+  int32_t hop_ = 0;       // synthesis hop Hs = N / 2
+  int32_t tolerance_ = 0; // search range +/- (samples)
+  std::vector<float> window_;
+  std::atomic<float> tempo_{1.0f};
+
+  std::vector<float> in_;  // input samples, in_[0] is absolute position inStart_
+  int64_t inStart_ = 0;
+  double anaPos_ = 0.0;    // nominal absolute start of the next analysis frame
+  std::vector<float> template_;  // natural continuation of the last frame (hop_ samples)
+  bool haveTemplate_ = false;
+  std::vector<float> ola_;       // overlap-add accumulator, frame_ samples
+  std::vector<float> out_;
+  size_t outRead_ = 0;
+  int32_t skip_ = 0;             // leading output to drop (startup padding)
+  double expectedOut_ = 0.0;     // input consumed / tempo, accumulated per Push
+  int64_t produced_ = 0;
+  bool flushed_ = false;
+};
+
+/**
+ * Fills an audio sink's frames from a pull source through a WsolaTimeStretcher, so the playback
+ * tempo can change while audio is already buffered. At tempo 1 the source passes through
+ * untouched (after the stretcher's remaining output is played). SetTempo() may be called from any
+ * thread; Fill() belongs to the sink's thread.
+ */
+class StretchedFrameReader {
+ public:
+  StretchedFrameReader(int32_t sampleRate, int32_t frameSamples)
+      : stretcher_(sampleRate), input_(static_cast<size_t>(frameSamples > 0 ? frameSamples : 256)) {}
+
+  void SetTempo(float tempo) { stretcher_.SetTempo(tempo); }
+  float tempo() const { return stretcher_.tempo(); }
+
+  /** Fill out[0, n); pull(float* dst, int32_t count) must fill dst[0, count) (zero-padded). */
+  template <typename Pull>
+  void Fill(float* out, int32_t n, Pull&& pull) {
+    if (draining_) {
+      const int32_t got = stretcher_.Read(out, n);
+      if (got < n) pull(out + got, n - got);
+      if (stretcher_.Available() == 0) active_ = draining_ = false;
+      return;
+    }
+    const bool unity = stretcher_.tempo() == 1.0f;
+    if (!active_) {
+      if (unity) {
+        pull(out, n);
+        return;
+      }
+      stretcher_.Reset();
+      active_ = true;
+    } else if (unity) {
+      // Back to tempo 1: play out what the stretcher holds, then pass through.
+      stretcher_.Flush();
+      draining_ = true;
+      Fill(out, n, pull);
+      return;
+    }
+    const int32_t frame = static_cast<int32_t>(input_.size());
+    while (stretcher_.Available() < n) {
+      pull(input_.data(), frame);
+      stretcher_.Push(input_.data(), frame);
+    }
+    stretcher_.Read(out, n);
+  }
+
+ private:
+  WsolaTimeStretcher stretcher_;
+  std::vector<float> input_;
+  bool active_ = false;
+  bool draining_ = false;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_TTS_TIME_STRETCH_H
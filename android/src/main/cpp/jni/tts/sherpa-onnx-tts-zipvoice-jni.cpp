@@ -5,10 +5,19 @@
  * Kotlin TTS API does not expose Zipvoice config, so this native layer is used for Zipvoice-only flows.
  */
 #include <jni.h>
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
 #include <android/log.h>
 
 #include "sherpa-onnx/c-api/c-api.h"
+#include "sherpa-onnx-jni-cache.h"
+#include "sherpa-onnx-pcm-ring.h"
+#include "sherpa-onnx-tts-prompt-registry.h"
+#include "sherpa-onnx-tts-sentence-pipeline.h"
 
 #define LOG_TAG "ZipvoiceTtsJni"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
@@ -16,6 +25,10 @@
 
 namespace {
 
+// nativeGenerateWithRing: how long the producer waits on a full ring before giving up.
+constexpr int32_t kRingFullTimeoutMs = 2000;
+constexpr int32_t kRingFullPollMs = 2;
+
 // Helper: get a non-null C string from a jstring (returns "" for null).
 struct JStringGuard {
   JNIEnv* env;
@@ -33,14 +46,11 @@ struct JStringGuard {
 
 // Build a Java float[] + int pair as Object[] { float[], Integer } for returning generated audio.
 jobjectArray buildAudioResult(JNIEnv* env, const float* samples, int32_t n, int32_t sampleRate) {
-  jclass objClass = env->FindClass("java/lang/Object");
-  if (!objClass) return nullptr;
+  const sherpaonnx::JniCache& cache = sherpaonnx::GetJniCache();
+  if (!cache.objectClass || !cache.integerClass || !cache.integerValueOf) return nullptr;
 
-  jobjectArray result = env->NewObjectArray(2, objClass, nullptr);
-  if (!result) {
-    env->DeleteLocalRef(objClass);
-    return nullptr;
-  }
+  jobjectArray result = env->NewObjectArray(2, cache.objectClass, nullptr);
+  if (!result) return nullptr;
 
   // Element 0: float[] samples
   jfloatArray jsamples = env->NewFloatArray(n);
@@ -51,17 +61,31 @@ jobjectArray buildAudioResult(JNIEnv* env, const float* samples, int32_t n, int3
   if (jsamples) env->DeleteLocalRef(jsamples);
 
   // Element 1: Integer sampleRate
-  jclass intClass = env->FindClass("java/lang/Integer");
-  jmethodID intValueOf = env->GetStaticMethodID(intClass, "valueOf", "(I)Ljava/lang/Integer;");
-  jobject jrate = env->CallStaticObjectMethod(intClass, intValueOf, sampleRate);
+  jobject jrate = env->CallStaticObjectMethod(cache.integerClass, cache.integerValueOf, sampleRate);
   env->SetObjectArrayElement(result, 1, jrate);
-  env->DeleteLocalRef(intClass);
   if (jrate) env->DeleteLocalRef(jrate);
 
-  env->DeleteLocalRef(objClass);
   return result;
 }
 
+// Resample prompt audio with sherpa-onnx's LinearResampler, using the same filter settings the
+// engine applies internally, so a pre-resampled prompt yields the same features.
+std::vector<float> ResamplePrompt(const float* samples, size_t n, int32_t inRate, int32_t outRate) {
+  const float cutoff = 0.99f * 0.5f * static_cast<float>(std::min(inRate, outRate));
+  const SherpaOnnxLinearResampler* resampler =
+      SherpaOnnxCreateLinearResampler(inRate, outRate, cutoff, 6);
+  if (!resampler) return {};
+  std::vector<float> out;
+  const SherpaOnnxResampleOut* r =
+      SherpaOnnxLinearResamplerResample(resampler, samples, static_cast<int32_t>(n), 1);
+  if (r) {
+    out.assign(r->samples, r->samples + r->n);
+    SherpaOnnxLinearResamplerResampleFree(r);
+  }
+  SherpaOnnxDestroyLinearResampler(resampler);
+  return out;
+}
+
 }  // namespace
 
 extern "C" {
@@ -155,6 +179,31 @@ Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeGetNumSpeakers(
   return tts ? SherpaOnnxOfflineTtsNumSpeakers(tts) : 0;
 }
 
+// Synthesize a short fixed phrase and discard the audio so ONNX Runtime finishes
+// its lazy session setup (allocations, kernel selection) before the first real
+// request. Returns the elapsed time in ms, or -1 on failure.
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeWarmUp(
+    JNIEnv* /* env */, jobject /* this */, jlong ptr) {
+  auto* tts = reinterpret_cast<const SherpaOnnxOfflineTts*>(ptr);
+  if (!tts) {
+    LOGE("nativeWarmUp: tts pointer is null");
+    return -1;
+  }
+  auto start = std::chrono::steady_clock::now();
+  const SherpaOnnxGeneratedAudio* audio =
+      SherpaOnnxOfflineTtsGenerate(tts, "Hello.", 0, 1.0f);
+  if (!audio) {
+    LOGE("nativeWarmUp: generate returned null");
+    return -1;
+  }
+  SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  LOGI("nativeWarmUp: %lld ms", static_cast<long long>(elapsed.count()));
+  return static_cast<jlong>(elapsed.count());
+}
+
 // Generate audio (non-zero-shot). Returns Object[] { float[], Integer }.
 JNIEXPORT jobjectArray JNICALL
 Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeGenerate(
@@ -206,9 +255,7 @@ Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeGenerateWithCallback(
     bool cancelled;
   };
 
-  jclass cls = env->GetObjectClass(thiz);
-  jmethodID onChunkId = env->GetMethodID(cls, "onNativeChunk", "([FI)Z");
-  env->DeleteLocalRef(cls);
+  jmethodID onChunkId = sherpaonnx::GetJniCache().zipvoiceOnNativeChunk;
   if (!onChunkId) {
     LOGE("nativeGenerateWithCallback: onNativeChunk method not found");
     return nullptr;
@@ -250,6 +297,183 @@ Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeGenerateWithCallback(
   return result;
 }
 
+// Generate audio streaming chunks into a shared PcmRing (direct ByteBuffer) instead of allocating
+// a float[] per chunk. After each write, Java onNativeRingData(int readable) is called so the
+// consumer can drain in place; when the ring is full the producer waits for space. If
+// returnAudio is false, the final concatenated audio is not copied back (float[] of length 0).
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeGenerateWithRing(
+    JNIEnv* env, jobject thiz,
+    jlong ptr, jstring j_text, jint sid, jfloat speed,
+    jobject j_ring, jboolean return_audio) {
+  auto* tts = reinterpret_cast<const SherpaOnnxOfflineTts*>(ptr);
+  if (!tts) {
+    LOGE("nativeGenerateWithRing: tts pointer is null");
+    return nullptr;
+  }
+
+  void* ringBase = j_ring ? env->GetDirectBufferAddress(j_ring) : nullptr;
+  jlong ringBytes = j_ring ? env->GetDirectBufferCapacity(j_ring) : 0;
+  sherpaonnx::PcmRing ring = (ringBase && ringBytes > 0)
+      ? sherpaonnx::PcmRing::Attach(ringBase, static_cast<size_t>(ringBytes))
+      : sherpaonnx::PcmRing();
+  if (!ring.valid()) {
+    LOGE("nativeGenerateWithRing: ring buffer is not a valid direct PcmRing");
+    return nullptr;
+  }
+
+  jmethodID onRingDataId = sherpaonnx::GetJniCache().zipvoiceOnNativeRingData;
+  if (!onRingDataId) {
+    LOGE("nativeGenerateWithRing: onNativeRingData method not found");
+    return nullptr;
+  }
+
+  JStringGuard text(env, j_text);
+
+  struct RingCtx {
+    JNIEnv* env;
+    jobject thiz;
+    jmethodID onRingDataId;
+    sherpaonnx::PcmRing* ring;
+    bool cancelled;
+  };
+  RingCtx ctx{env, thiz, onRingDataId, &ring, false};
+
+  auto callback = [](const float* samples, int32_t n, float /* progress */, void* arg) -> int32_t {
+    auto* c = static_cast<RingCtx*>(arg);
+    int32_t offset = 0;
+    int32_t fullWaitMs = 0;
+    while (!c->cancelled && offset < n) {
+      if (c->ring->HasFlag(sherpaonnx::PcmRing::kReaderClosed)) {
+        c->cancelled = true;
+        break;
+      }
+      int32_t written = c->ring->Write(samples + offset, n - offset);
+      offset += written;
+      // Call Java: boolean onNativeRingData(int readable). Also once when the ring is full, so a
+      // consumer draining on this thread gets to run.
+      if (written > 0 || fullWaitMs == 0) {
+        jboolean cont = c->env->CallBooleanMethod(c->thiz, c->onRingDataId, c->ring->Readable());
+        if (c->env->ExceptionCheck() || !cont) {
+          c->cancelled = true;
+          break;
+        }
+      }
+      if (written > 0) {
+        fullWaitMs = 0;
+        continue;
+      }
+      // Still full: wait for a consumer on another thread, but not forever.
+      if (fullWaitMs >= kRingFullTimeoutMs) {
+        LOGE("nativeGenerateWithRing: ring stayed full for %d ms, stopping", fullWaitMs);
+        c->cancelled = true;
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(kRingFullPollMs));
+      fullWaitMs += kRingFullPollMs;
+    }
+    return c->cancelled ? 0 : 1;
+  };
+
+  const SherpaOnnxGeneratedAudio* audio =
+      SherpaOnnxOfflineTtsGenerateWithProgressCallbackWithArg(
+          tts, text.get(), sid, speed, callback, &ctx);
+  ring.SetFlag(sherpaonnx::PcmRing::kWriterDone);
+
+  if (env->ExceptionCheck()) {
+    if (audio) SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+    return nullptr;
+  }
+  if (!audio) {
+    LOGE("nativeGenerateWithRing: generate returned null");
+    return nullptr;
+  }
+
+  jobjectArray result = return_audio
+      ? buildAudioResult(env, audio->samples, audio->n, audio->sample_rate)
+      : buildAudioResult(env, nullptr, 0, audio->sample_rate);
+  SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+  return result;
+}
+
+// Long-text mode: split text into sentences and synthesize them in parallel, one sentence at a time
+// per engine in j_ptrs (all created from the same config). Audio is reassembled in sentence order
+// with silence_ms between sentences. If stream_chunks is true, each in-order piece is passed to
+// onNativeChunk on this thread and the returned float[] is empty; otherwise the full audio is returned.
+// A non-empty j_leading_clause (first-chunk fast path) is synthesized first, with no silence after it.
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeGenerateParallel(
+    JNIEnv* env, jobject thiz,
+    jlongArray j_ptrs, jstring j_leading_clause, jstring j_text, jint sid, jfloat speed,
+    jint silence_ms, jboolean stream_chunks) {
+  std::vector<const SherpaOnnxOfflineTts*> engines;
+  if (j_ptrs) {
+    jsize count = env->GetArrayLength(j_ptrs);
+    std::vector<jlong> ptrs(static_cast<size_t>(count));
+    env->GetLongArrayRegion(j_ptrs, 0, count, ptrs.data());
+    for (jlong p : ptrs) {
+      if (p) engines.push_back(reinterpret_cast<const SherpaOnnxOfflineTts*>(p));
+    }
+  }
+  if (engines.empty()) {
+    LOGE("nativeGenerateParallel: no tts engines");
+    return nullptr;
+  }
+
+  jmethodID onChunkId = sherpaonnx::GetJniCache().zipvoiceOnNativeChunk;
+  if (stream_chunks && !onChunkId) {
+    LOGE("nativeGenerateParallel: onNativeChunk method not found");
+    return nullptr;
+  }
+
+  JStringGuard text(env, j_text);
+  std::vector<std::string> sentences = sherpaonnx::SplitSentences(text.get());
+  const int32_t sampleRate = SherpaOnnxOfflineTtsSampleRate(engines[0]);
+
+  sherpaonnx::SentencePipelineOptions options;
+  JStringGuard leading(env, j_leading_clause);
+  if (*leading.get()) {
+    sentences.insert(sentences.begin(), std::string(leading.get()));
+    options.firstIsClause = true;
+  }
+  options.numWorkers = static_cast<int32_t>(engines.size());
+  options.silenceSamples =
+      static_cast<int32_t>(static_cast<int64_t>(sampleRate) * (silence_ms > 0 ? silence_ms : 0) / 1000);
+  LOGI("nativeGenerateParallel: %zu sentences on %zu engines, silenceMs=%d",
+       sentences.size(), engines.size(), silence_ms);
+
+  std::vector<float> collected;
+  auto status = sherpaonnx::RunSentencePipeline(
+      sentences, options,
+      [&engines, sid, speed](int32_t worker, const std::string& sentence, std::vector<float>* out) {
+        const SherpaOnnxGeneratedAudio* audio = SherpaOnnxOfflineTtsGenerate(
+            engines[static_cast<size_t>(worker)], sentence.c_str(), sid, speed);
+        if (!audio) return false;
+        out->assign(audio->samples, audio->samples + audio->n);
+        SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+        return true;
+      },
+      [&](const float* samples, int32_t n, int32_t /* index */, int32_t /* total */) -> bool {
+        if (!stream_chunks) {
+          collected.insert(collected.end(), samples, samples + n);
+          return true;
+        }
+        jfloatArray chunk = env->NewFloatArray(n);
+        if (!chunk) return false;
+        env->SetFloatArrayRegion(chunk, 0, n, samples);
+        jboolean cont = env->CallBooleanMethod(thiz, onChunkId, chunk, n);
+        env->DeleteLocalRef(chunk);
+        return !env->ExceptionCheck() && cont;
+      });
+
+  if (env->ExceptionCheck()) return nullptr;
+  if (status == sherpaonnx::SentencePipelineStatus::kFailed) {
+    LOGE("nativeGenerateParallel: generation failed");
+    return nullptr;
+  }
+  return buildAudioResult(env, collected.data(), static_cast<int32_t>(collected.size()), sampleRate);
+}
+
 // Zero-shot voice cloning with Zipvoice. Returns Object[] { float[], Integer }.
 JNIEXPORT jobjectArray JNICALL
 Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeGenerateWithZipvoice(
@@ -298,4 +522,113 @@ Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeGenerateWithZipvoice(
   return result;
 }
 
+// Prompt registry for repeated voice cloning. Prompts are resampled to target_sr at registration.
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeCreatePromptRegistry(
+    JNIEnv* /* env */, jclass /* clazz */, jint target_sr) {
+  return reinterpret_cast<jlong>(new sherpaonnx::TtsPromptRegistry(target_sr, ResamplePrompt));
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeDestroyPromptRegistry(
+    JNIEnv* /* env */, jclass /* clazz */, jlong registry_ptr) {
+  delete reinterpret_cast<sherpaonnx::TtsPromptRegistry*>(registry_ptr);
+}
+
+// Prompts belong to j_owner (the instance id); the registry is shared by every instance on the engine.
+// Returns the prompt id (> 0), or 0 on invalid input.
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeRegisterPrompt(
+    JNIEnv* env, jclass /* clazz */,
+    jlong registry_ptr, jstring j_owner, jstring j_prompt_text,
+    jfloatArray j_prompt_samples, jint prompt_sr) {
+  auto* registry = reinterpret_cast<sherpaonnx::TtsPromptRegistry*>(registry_ptr);
+  if (!registry || !j_prompt_samples) return 0;
+
+  JStringGuard owner(env, j_owner);
+  JStringGuard promptText(env, j_prompt_text);
+  const jsize n = env->GetArrayLength(j_prompt_samples);
+  jfloat* samples = env->GetFloatArrayElements(j_prompt_samples, nullptr);
+  if (!samples) return 0;
+  const int64_t id =
+      registry->Register(owner.get(), promptText.get(), samples, static_cast<size_t>(n), prompt_sr);
+  env->ReleaseFloatArrayElements(j_prompt_samples, samples, JNI_ABORT);
+
+  LOGI("nativeRegisterPrompt: id=%lld, promptLen=%d, promptSr=%d",
+       static_cast<long long>(id), static_cast<int>(n), prompt_sr);
+  return static_cast<jlong>(id);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeUnregisterPrompt(
+    JNIEnv* env, jclass /* clazz */, jlong registry_ptr, jstring j_owner, jlong prompt_id) {
+  auto* registry = reinterpret_cast<sherpaonnx::TtsPromptRegistry*>(registry_ptr);
+  if (!registry) return JNI_FALSE;
+  JStringGuard owner(env, j_owner);
+  return registry->Remove(owner.get(), prompt_id) ? JNI_TRUE : JNI_FALSE;
+}
+
+// Drops every prompt of j_owner (its instance released the engine). Returns how many were removed.
+JNIEXPORT jint JNICALL
+Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeUnregisterPrompts(
+    JNIEnv* env, jclass /* clazz */, jlong registry_ptr, jstring j_owner) {
+  auto* registry = reinterpret_cast<sherpaonnx::TtsPromptRegistry*>(registry_ptr);
+  if (!registry) return 0;
+  JStringGuard owner(env, j_owner);
+  return static_cast<jint>(registry->RemoveOwner(owner.get()));
+}
+
+// Returns [seconds, transcript UTF-8 bytes] of a registered prompt, or null if the id is unknown.
+JNIEXPORT jdoubleArray JNICALL
+Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativePromptInfo(
+    JNIEnv* env, jclass /* clazz */, jlong registry_ptr, jstring j_owner, jlong prompt_id) {
+  auto* registry = reinterpret_cast<sherpaonnx::TtsPromptRegistry*>(registry_ptr);
+  JStringGuard owner(env, j_owner);
+  auto prompt = registry ? registry->Get(owner.get(), prompt_id) : nullptr;
+  if (!prompt || prompt->sampleRate <= 0) return nullptr;
+  const jdouble values[] = {static_cast<jdouble>(prompt->samples.size()) / prompt->sampleRate,
+                            static_cast<jdouble>(prompt->text.size())};
+  jdoubleArray out = env->NewDoubleArray(2);
+  if (out) env->SetDoubleArrayRegion(out, 0, 2, values);
+  return out;
+}
+
+// Voice cloning with a registered prompt: no prompt data crosses JNI. Returns Object[] { float[], Integer }.
+JNIEXPORT jobjectArray JNICALL
+Java_com_sherpaonnx_ZipvoiceTtsWrapper_nativeGenerateWithPrompt(
+    JNIEnv* env, jclass /* clazz */,
+    jlong ptr, jlong registry_ptr, jstring j_owner, jstring j_text, jlong prompt_id,
+    jfloat speed, jint num_steps) {
+  auto* tts = reinterpret_cast<const SherpaOnnxOfflineTts*>(ptr);
+  auto* registry = reinterpret_cast<sherpaonnx::TtsPromptRegistry*>(registry_ptr);
+  if (!tts || !registry) {
+    LOGE("nativeGenerateWithPrompt: tts or registry pointer is null");
+    return nullptr;
+  }
+  JStringGuard owner(env, j_owner);
+  auto prompt = registry->Get(owner.get(), prompt_id);
+  if (!prompt) {
+    LOGE("nativeGenerateWithPrompt: unknown prompt id %lld", static_cast<long long>(prompt_id));
+    return nullptr;
+  }
+
+  JStringGuard text(env, j_text);
+  LOGI("nativeGenerateWithPrompt: text=%s, promptId=%lld, speed=%.2f, steps=%d",
+       text.get(), static_cast<long long>(prompt_id), speed, num_steps);
+
+  const SherpaOnnxGeneratedAudio* audio =
+      SherpaOnnxOfflineTtsGenerateWithZipvoice(
+          tts, text.get(), prompt->text.c_str(),
+          prompt->samples.data(), static_cast<int32_t>(prompt->samples.size()), prompt->sampleRate,
+          speed, num_steps);
+  if (!audio) {
+    LOGE("nativeGenerateWithPrompt: returned null");
+    return nullptr;
+  }
+
+  jobjectArray result = buildAudioResult(env, audio->samples, audio->n, audio->sample_rate);
+  SherpaOnnxDestroyOfflineTtsGeneratedAudio(audio);
+  return result;
+}
+
 }  // extern "C"
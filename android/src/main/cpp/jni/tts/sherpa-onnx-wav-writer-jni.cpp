@@ -0,0 +1,91 @@
+/**
+ * sherpa-onnx-wav-writer-jni.cpp
+ *
+ * Purpose: JNI for WavFileWriter (Kotlin). Owns one native sherpaonnx::WavWriter per handle and
+ * exposes the vectorized float -> 16-bit PCM conversion for writers that target an OutputStream.
+ */
+#include <jni.h>
+#include <string>
+
+#include "sherpa-onnx-wav-writer.h"
+
+namespace {
+
+std::string ToStdString(JNIEnv* env, jstring s) {
+  if (!s) return std::string();
+  const char* c = env->GetStringUTFChars(s, nullptr);
+  std::string out = c ? c : "";
+  if (c) env->ReleaseStringUTFChars(s, c);
+  return out;
+}
+
+sherpaonnx::WavWriter* FromHandle(jlong ptr) {
+  return reinterpret_cast<sherpaonnx::WavWriter*>(ptr);
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_WavFileWriter_nativeCreate(JNIEnv* /* env */, jclass /* clazz */) {
+  return reinterpret_cast<jlong>(new sherpaonnx::WavWriter());
+}
+
+JNIEXPORT void JNICALL
+Java_com_sherpaonnx_WavFileWriter_nativeDestroy(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  delete FromHandle(ptr);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_WavFileWriter_nativeOpen(JNIEnv* env, jclass /* clazz */, jlong ptr, jstring path,
+                                             jint sampleRate, jint numChannels) {
+  auto* writer = FromHandle(ptr);
+  if (!writer) return JNI_FALSE;
+  return writer->Open(ToStdString(env, path), sampleRate, numChannels) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_WavFileWriter_nativeAppend(JNIEnv* env, jclass /* clazz */, jlong ptr,
+                                               jfloatArray samples, jint offset, jint count) {
+  auto* writer = FromHandle(ptr);
+  if (!writer || !samples || offset < 0 || count < 0) return JNI_FALSE;
+  if (offset + count > env->GetArrayLength(samples)) return JNI_FALSE;
+  if (count == 0) return JNI_TRUE;
+  // Not a critical section: Append may block on file I/O.
+  jfloat* data = env->GetFloatArrayElements(samples, nullptr);
+  if (!data) return JNI_FALSE;
+  bool ok = writer->Append(data + offset, static_cast<size_t>(count));
+  env->ReleaseFloatArrayElements(samples, data, JNI_ABORT);
+  return ok ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_sherpaonnx_WavFileWriter_nativeFinalize(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  auto* writer = FromHandle(ptr);
+  return writer && writer->Finalize() ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_sherpaonnx_WavFileWriter_nativeNumSamples(JNIEnv* /* env */, jclass /* clazz */, jlong ptr) {
+  auto* writer = FromHandle(ptr);
+  return writer ? static_cast<jlong>(writer->NumSamples()) : 0;
+}
+
+// 16-bit little-endian PCM bytes for samples (all Android ABIs are little-endian).
+JNIEXPORT jbyteArray JNICALL
+Java_com_sherpaonnx_WavFileWriter_nativeToPcm16(JNIEnv* env, jclass /* clazz */, jfloatArray samples) {
+  if (!samples) return nullptr;
+  const jsize n = env->GetArrayLength(samples);
+  jbyteArray out = env->NewByteArray(n * 2);
+  if (!out || n == 0) return out;
+  // Pure computation, so a critical section is fine and avoids copying either array.
+  auto* in = static_cast<const float*>(env->GetPrimitiveArrayCritical(samples, nullptr));
+  auto* dst = static_cast<int16_t*>(env->GetPrimitiveArrayCritical(out, nullptr));
+  if (in && dst) sherpaonnx::FloatToInt16(in, dst, static_cast<size_t>(n));
+  if (dst) env->ReleasePrimitiveArrayCritical(out, dst, 0);
+  if (in) env->ReleasePrimitiveArrayCritical(samples, const_cast<float*>(in), JNI_ABORT);
+  return (in && dst) ? out : nullptr;
+}
+
+}  // extern "C"
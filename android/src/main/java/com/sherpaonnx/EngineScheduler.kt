@@ -0,0 +1,126 @@
+package com.sherpaonnx
+
+import java.util.concurrent.locks.ReentrantReadWriteLock
+import kotlin.concurrent.read
+import kotlin.concurrent.write
+
+/**
+ * Request queue in front of one shared engine, backed by sherpaonnx::EngineScheduler
+ * (sherpa-onnx-engine-scheduler.cpp). Requests get the engine by priority, then earliest deadline,
+ * then arrival; streaming requests [acquireSlot] it per sentence so an interactive request can run
+ * between the sentences of a batch one.
+ *
+ * Thread-safe. [acquireSlot] blocks; [release] cancels every waiter before freeing the native queue.
+ */
+internal class EngineScheduler {
+
+  companion object {
+    const val PRIORITY_BATCH = 0
+    const val PRIORITY_NORMAL = 1
+    const val PRIORITY_INTERACTIVE = 2
+
+    /** Must match EngineScheduler::Status. */
+    private const val STATUS_OK = 0
+    private const val STATUS_EXPIRED = 2
+
+    // JNI native methods (implemented in sherpa-onnx-engine-scheduler-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeParsePriority(name: String?): Int
+
+    @JvmStatic
+    private external fun nativeSubmit(ptr: Long, priority: Int, deadlineMs: Long): Long
+
+    @JvmStatic
+    private external fun nativeAcquire(ptr: Long, id: Long): Int
+
+    @JvmStatic
+    private external fun nativeRelease(ptr: Long, id: Long)
+
+    @JvmStatic
+    private external fun nativeFinish(ptr: Long, id: Long): Long
+
+    @JvmStatic
+    private external fun nativeCancel(ptr: Long, id: Long): Boolean
+
+    @JvmStatic
+    private external fun nativeCancelAll(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeShouldStop(ptr: Long, id: Long): Boolean
+
+    @JvmStatic
+    private external fun nativePriorityOf(ptr: Long, id: Long): Int
+
+    /** "interactive" / "normal" / "batch" (anything else is normal). */
+    fun parsePriority(name: String?): Int = nativeParsePriority(name)
+  }
+
+  /** Thrown by [acquireSlot] when the request was cancelled or its deadline passed while queued. */
+  class RequestStoppedException(val expired: Boolean) :
+    IllegalStateException(if (expired) "Request deadline exceeded" else "Request cancelled")
+
+  // Read-held by every call (including a blocked acquireSlot), write-held only to free the queue.
+  private val lifetime = ReentrantReadWriteLock()
+
+  @Volatile
+  private var ptr: Long = nativeCreate()
+
+  /** Register a request; [deadlineMs] > 0 is relative to now. Returns its ticket (0 if released). */
+  fun submit(priority: Int, deadlineMs: Long = 0L): Long =
+    lifetime.read { if (ptr != 0L) nativeSubmit(ptr, priority, deadlineMs) else 0L }
+
+  /**
+   * Block until [ticket] may use the engine. Pair with [releaseSlot] after each chunk of work.
+   * @throws RequestStoppedException when it was cancelled or expired while waiting.
+   */
+  fun acquireSlot(ticket: Long) {
+    val status = lifetime.read { if (ptr != 0L) nativeAcquire(ptr, ticket) else STATUS_OK }
+    if (status != STATUS_OK) throw RequestStoppedException(expired = status == STATUS_EXPIRED)
+  }
+
+  /** Give the engine back between chunks; the request keeps its place in the queue. */
+  fun releaseSlot(ticket: Long) {
+    lifetime.read { if (ptr != 0L) nativeRelease(ptr, ticket) }
+  }
+
+  /** Forget [ticket] (releasing the engine if held). Returns its total queue wait in ms. */
+  fun finish(ticket: Long): Long =
+    lifetime.read { if (ptr != 0L && ticket != 0L) nativeFinish(ptr, ticket) else 0L }
+
+  /** Cancel [ticket]; a queued request fails its [acquireSlot], a running one sees [shouldStop]. */
+  fun cancel(ticket: Long): Boolean =
+    lifetime.read { ptr != 0L && ticket != 0L && nativeCancel(ptr, ticket) }
+
+  /** True when [ticket] was cancelled or its deadline passed: stop generating. */
+  fun shouldStop(ticket: Long): Boolean =
+    lifetime.read { ptr != 0L && ticket != 0L && nativeShouldStop(ptr, ticket) }
+
+  fun priorityOf(ticket: Long): Int =
+    lifetime.read { if (ptr != 0L) nativePriorityOf(ptr, ticket) else PRIORITY_NORMAL }
+
+  /** Run [block] holding the engine for [ticket] (see [acquireSlot]). */
+  inline fun <T> withSlot(ticket: Long, block: () -> T): T {
+    acquireSlot(ticket)
+    try {
+      return block()
+    } finally {
+      releaseSlot(ticket)
+    }
+  }
+
+  fun release() {
+    lifetime.read { if (ptr != 0L) nativeCancelAll(ptr) }
+    lifetime.write {
+      if (ptr != 0L) {
+        nativeDestroy(ptr)
+        ptr = 0L
+      }
+    }
+  }
+}
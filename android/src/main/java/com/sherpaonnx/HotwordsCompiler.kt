@@ -0,0 +1,82 @@
+package com.sherpaonnx
+
+/**
+ * Hotwords compilation, backed by sherpaonnx::CompileHotwordsFile / CompileHotwordsText
+ * (sherpa-onnx-hotwords-compiler.cpp): validates the hotwords once, drops lines whose tokens are
+ * not in the model's tokens.txt, merges duplicates and caches the compact result keyed by content
+ * and vocabulary (files on disk, per-stream strings in memory).
+ */
+internal object HotwordsCompiler {
+
+  /** Directory for compiled hotwords files, under context.cacheDir. */
+  const val CACHE_DIR = "sherpaonnx_hotwords"
+
+  class Result(
+    val ok: Boolean,
+    /** INVALID_HOTWORDS_FILE message when [ok] is false. */
+    val error: String,
+    /** Compiled file ([compileFile]) or '/'-separated string ([compileText]). */
+    val output: String,
+    val entries: Int,
+    val duplicates: Int,
+    val oovLines: Int,
+    val oovSamples: List<String>,
+    val vocabChecked: Boolean,
+    val cached: Boolean,
+    val compileMs: Double
+  )
+
+  // JNI native method (implemented in sherpa-onnx-hotwords-compiler-jni.cpp, loaded via libsherpaonnx)
+  @JvmStatic
+  private external fun nativeCompile(
+    input: String,
+    isFile: Boolean,
+    tokensPath: String,
+    bpeVocabPath: String,
+    modelingUnit: String,
+    cacheDir: String,
+    out: DoubleArray
+  ): Array<String?>?
+
+  /** Compile the hotwords file at [path] into [cacheDir] (reused while content and tokens match). */
+  fun compileFile(
+    path: String,
+    tokensPath: String,
+    bpeVocabPath: String,
+    modelingUnit: String,
+    cacheDir: String
+  ): Result = compile(path, true, tokensPath, bpeVocabPath, modelingUnit, cacheDir)
+
+  /** Compile a per-stream hotwords string (lines separated by '/' or newlines). */
+  fun compileText(
+    hotwords: String,
+    tokensPath: String,
+    bpeVocabPath: String,
+    modelingUnit: String
+  ): Result = compile(hotwords, false, tokensPath, bpeVocabPath, modelingUnit, "")
+
+  private fun compile(
+    input: String,
+    isFile: Boolean,
+    tokensPath: String,
+    bpeVocabPath: String,
+    modelingUnit: String,
+    cacheDir: String
+  ): Result {
+    val out = DoubleArray(7)
+    val strings = nativeCompile(input, isFile, tokensPath, bpeVocabPath, modelingUnit, cacheDir, out)
+      ?: return Result(false, "Failed to compile hotwords", "", 0, 0, 0, emptyList(), false, false, 0.0)
+    return Result(
+      ok = out[0] != 0.0,
+      error = strings.getOrNull(0).orEmpty(),
+      output = strings.getOrNull(1).orEmpty(),
+      entries = out[1].toInt(),
+      duplicates = out[2].toInt(),
+      oovLines = out[3].toInt(),
+      oovSamples = strings.drop(2).filterNotNull(),
+      vocabChecked = out[4] != 0.0,
+      cached = out[5] != 0.0,
+      compileMs = out[6]
+    )
+  }
+}
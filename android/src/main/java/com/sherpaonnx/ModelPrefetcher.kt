@@ -0,0 +1,21 @@
+package com.sherpaonnx
+
+/**
+ * Read-ahead for model directories, backed by sherpaonnx::PrefetchFiles
+ * (sherpa-onnx-file-prefetch.cpp). The kernel starts pulling the model files into the page cache
+ * while detection runs, so recognizer creation finds them resident. Hints only; returns quickly.
+ */
+internal object ModelPrefetcher {
+
+  class Stats(val files: Int, val bytes: Long, val elapsedMs: Long)
+
+  // JNI native method (implemented in sherpa-onnx-file-prefetch-jni.cpp, loaded via libsherpaonnx)
+  @JvmStatic
+  private external fun nativePrefetchDir(dir: String): LongArray?
+
+  /** Request read-ahead for the model files in [dir] (and one level below). */
+  fun prefetchDir(dir: String): Stats {
+    val values = nativePrefetchDir(dir) ?: return Stats(0, 0L, 0L)
+    return Stats(values[0].toInt(), values[1], values[2])
+  }
+}
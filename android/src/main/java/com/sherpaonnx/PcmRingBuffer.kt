@@ -0,0 +1,92 @@
+package com.sherpaonnx
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.nio.FloatBuffer
+
+/**
+ * Float PCM ring shared with native code through a preallocated direct [ByteBuffer].
+ *
+ * The native producer (sherpa-onnx-pcm-ring.cpp) writes samples straight into [buffer]; Kotlin reads
+ * them in place through a [FloatBuffer] view, so streaming generation does not allocate a float[]
+ * per chunk. Single producer, single consumer: indices live in the first [HEADER_BYTES] bytes and
+ * are accessed with acquire/release semantics via the JNI methods below.
+ */
+internal class PcmRingBuffer(capacitySamples: Int) {
+
+  companion object {
+    /** Must match PcmRing::kHeaderBytes. */
+    private const val HEADER_BYTES = 64
+    /** Must match PcmRing::kWriterDone / kReaderClosed. */
+    private const val FLAG_WRITER_DONE = 1
+    private const val FLAG_READER_CLOSED = 2
+
+    // JNI native methods (implemented in sherpa-onnx-pcm-ring-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeInit(buffer: ByteBuffer): Int
+
+    @JvmStatic
+    private external fun nativeReadable(buffer: ByteBuffer): Int
+
+    @JvmStatic
+    private external fun nativeReadOffset(buffer: ByteBuffer): Int
+
+    @JvmStatic
+    private external fun nativeCommitRead(buffer: ByteBuffer, n: Int)
+
+    @JvmStatic
+    private external fun nativeSetFlag(buffer: ByteBuffer, flag: Int)
+
+    @JvmStatic
+    private external fun nativeHasFlag(buffer: ByteBuffer, flag: Int): Boolean
+
+    @JvmStatic
+    private external fun nativeReset(buffer: ByteBuffer)
+  }
+
+  /** Direct buffer passed to native producers (header + sample data). */
+  val buffer: ByteBuffer =
+    ByteBuffer.allocateDirect(HEADER_BYTES + capacitySamples * 4).order(ByteOrder.nativeOrder())
+
+  val capacity: Int = nativeInit(buffer)
+
+  private val samples: FloatBuffer
+
+  init {
+    require(capacity > 0) { "PcmRingBuffer: native init failed (capacity=$capacitySamples)" }
+    buffer.position(HEADER_BYTES)
+    samples = buffer.slice().order(ByteOrder.nativeOrder()).asFloatBuffer()
+    buffer.position(0)
+  }
+
+  /** Number of samples ready to read. */
+  fun available(): Int = nativeReadable(buffer)
+
+  /**
+   * Copy up to [length] samples into [dst] starting at [offset] and release them to the producer.
+   * @return number of samples read (0 if the ring is empty).
+   */
+  fun read(dst: FloatArray, offset: Int = 0, length: Int = dst.size - offset): Int {
+    val n = minOf(length, available())
+    if (n <= 0) return 0
+    val start = nativeReadOffset(buffer)
+    val first = minOf(n, capacity - start)
+    samples.position(start)
+    samples.get(dst, offset, first)
+    if (n > first) {
+      samples.position(0)
+      samples.get(dst, offset + first, n - first)
+    }
+    nativeCommitRead(buffer, n)
+    return n
+  }
+
+  /** True once the producer has finished and all samples have been read. */
+  fun isDrained(): Boolean = nativeHasFlag(buffer, FLAG_WRITER_DONE) && available() == 0
+
+  /** Ask the producer to stop; it checks this before each write. */
+  fun close() = nativeSetFlag(buffer, FLAG_READER_CLOSED)
+
+  /** Reset for reuse; only call while no producer is attached. */
+  fun reset() = nativeReset(buffer)
+}
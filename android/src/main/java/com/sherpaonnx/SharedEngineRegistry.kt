@@ -0,0 +1,94 @@
+package com.sherpaonnx
+
+import android.util.Log
+import java.util.concurrent.CountDownLatch
+
+/**
+ * Process-wide sharing of loaded engines (OfflineTts, Zipvoice, OfflineRecognizer) across
+ * instance ids. Instances that load the same model with the same load-affecting config receive a
+ * [Handle] to one engine instead of each holding a copy of the weights; the engine is released
+ * when the last handle is released. Mirrors ios/common/sherpa-onnx-engine-registry.h.
+ *
+ * Engines are not thread-safe, so every call into [Handle.engine] must hold [Handle.lock]. Callers
+ * queue for it through [Handle.scheduler] first so requests run by priority rather than lock order.
+ */
+internal class SharedEngineRegistry<E : Any>(
+  private val tag: String,
+  private val releaseEngine: (E) -> Unit
+) {
+
+  companion object {
+    /** Registry key: model directory contents plus the serialized load config. */
+    fun engineKey(modelDir: String, config: String): String =
+      TtsAudioCache.modelFingerprint(modelDir, config)
+  }
+
+  /** One holder's reference to a shared engine. Release it exactly once. */
+  class Handle<E : Any> internal constructor(val key: String, val engine: E) {
+    /** Serializes use of [engine] across all holders. */
+    val lock = Any()
+
+    /** Orders requests from all holders; take a slot before [lock]. Released with the engine. */
+    val scheduler = EngineScheduler()
+
+    /**
+     * Per-holder settings last applied to [engine] (e.g. recognizer decoding config); null = the
+     * settings it was created with. Guarded by [lock].
+     */
+    var appliedSettings: Any? = null
+  }
+
+  /** Result of [acquire]: the handle, and whether it is an engine another holder already loaded. */
+  class Acquired<E : Any>(val handle: Handle<E>, val reused: Boolean)
+
+  private class Entry<E : Any>(val handle: Handle<E>, var refs: Int)
+
+  private val entries = HashMap<String, Entry<E>>()
+
+  /** Keys being loaded by some caller; the latch opens when that load finishes. Guarded by this. */
+  private val loading = HashMap<String, CountDownLatch>()
+
+  /**
+   * Return a handle to the engine loaded under [key], or load it with [create] (null = failure;
+   * nothing is registered). [create] runs outside the registry lock, so loads of other keys proceed
+   * in parallel; callers racing on the same key wait for the first load and share its engine (or
+   * load again if it failed).
+   */
+  fun acquire(key: String, create: () -> E?): Acquired<E>? {
+    val pending = CountDownLatch(1)
+    while (true) {
+      val inFlight = synchronized(this) {
+        entries[key]?.let { entry ->
+          entry.refs++
+          Log.i(tag, "Reusing shared engine (holders=${entry.refs})")
+          return Acquired(entry.handle, reused = true)
+        }
+        loading[key].also { if (it == null) loading[key] = pending }
+      } ?: break
+      inFlight.await()
+    }
+    var handle: Handle<E>? = null
+    try {
+      handle = create()?.let { Handle(key, it) }
+    } finally {
+      synchronized(this) {
+        loading.remove(key)
+        handle?.let { entries[key] = Entry(it, 1) }
+      }
+      pending.countDown()
+    }
+    return handle?.let { Acquired(it, reused = false) }
+  }
+
+  /** Drop one reference; the last one releases the engine (after any in-flight call finishes). */
+  fun release(handle: Handle<E>) {
+    synchronized(this) {
+      val entry = entries[handle.key] ?: return
+      if (entry.handle !== handle) return
+      if (--entry.refs > 0) return
+      entries.remove(handle.key)
+    }
+    handle.scheduler.release()
+    synchronized(handle.lock) { releaseEngine(handle.engine) }
+  }
+}
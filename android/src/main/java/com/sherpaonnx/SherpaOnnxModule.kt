@@ -5,6 +5,7 @@ import com.facebook.react.bridge.ReactApplicationContext
 import com.facebook.react.bridge.Promise
 import com.facebook.react.bridge.ReadableArray
 import com.facebook.react.bridge.ReadableMap
+import com.facebook.react.bridge.WritableMap
 import com.facebook.react.bridge.Arguments
 import com.facebook.react.module.annotations.ReactModule
 import com.facebook.react.modules.core.DeviceEventManagerModule
@@ -45,15 +46,18 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     { modelDir, preferInt8, hasPreferInt8, modelType, debug ->
       Companion.nativeDetectSttModel(modelDir, preferInt8, hasPreferInt8, modelType, debug)
     },
-    NAME
+    NAME,
+    { instanceId, requestId, item -> emitSttBatchResult(instanceId, requestId, item) },
+    { instanceId, requestId, item -> emitSttLongFormSegment(instanceId, requestId, item) }
   )
   private val onlineSttHelper = SherpaOnnxOnlineSttHelper(reactApplicationContext, NAME)
   private val ttsHelper = SherpaOnnxTtsHelper(
     reactApplicationContext,
     { modelDir, modelType -> Companion.nativeDetectTtsModel(modelDir, modelType) },
-    { instanceId, requestId, samples, sampleRate, progress, isFinal -> emitTtsStreamChunk(instanceId, requestId, samples, sampleRate, progress, isFinal) },
+    { instanceId, requestId, samples, length, sampleRate, progress, isFinal -> emitTtsStreamChunk(instanceId, requestId, samples, length, sampleRate, progress, isFinal) },
     { instanceId, requestId, message -> emitTtsStreamError(instanceId, requestId, message) },
-    { instanceId, requestId, cancelled -> emitTtsStreamEnd(instanceId, requestId, cancelled) }
+    { instanceId, requestId, cancelled, timeToFirstAudioMs, queueWaitMs, stats -> emitTtsStreamEnd(instanceId, requestId, cancelled, timeToFirstAudioMs, queueWaitMs, stats) },
+    { instanceId, requestId, item -> emitTtsExportProgress(instanceId, requestId, item) }
   )
   private val archiveHelper = SherpaOnnxArchiveHelper()
   private var pcmCapture: SherpaOnnxPcmCapture? = null
@@ -400,9 +404,55 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     modelOptions: ReadableMap?,
     modelingUnit: String?,
     bpeVocab: String?,
+    warmUp: Boolean?,
+    loadOptions: ReadableMap?,
     promise: Promise
   ) {
-    sttHelper.initializeStt(instanceId, modelDir, preferInt8, modelType, debug, hotwordsFile, hotwordsScore, numThreads, provider, ruleFsts, ruleFars, dither, modelOptions, modelingUnit, bpeVocab, promise)
+    sttHelper.initializeStt(instanceId, modelDir, preferInt8, modelType, debug, hotwordsFile, hotwordsScore, numThreads, provider, ruleFsts, ruleFars, dither, modelOptions, modelingUnit, bpeVocab, warmUp, loadOptions, promise)
+  }
+
+  /**
+   * Benchmark thread count, provider and quantization for an STT model and store the winner, which
+   * later initializeStt calls use for the options they leave unset.
+   */
+  override fun tuneStt(modelDir: String, options: ReadableMap?, promise: Promise) {
+    sttHelper.tuneStt(modelDir, options, tuningProviders(), promise)
+  }
+
+  /**
+   * Get the stored tuneStt winner for a model on this device (null if none).
+   */
+  override fun getSttTuning(modelDir: String, modelType: String?, promise: Promise) {
+    sttHelper.getSttTuning(modelDir, modelType, promise)
+  }
+
+  /**
+   * Forget the stored tuneStt winner for a model.
+   */
+  override fun clearSttTuning(modelDir: String, modelType: String?, promise: Promise) {
+    sttHelper.clearSttTuning(modelDir, modelType, promise)
+  }
+
+  /** Providers tuneStt tries besides cpu: XNNPACK when compiled in, NNAPI when an accelerator is present. */
+  private fun tuningProviders(): List<String> {
+    val compiled = try {
+      ai.onnxruntime.OrtEnvironment.getAvailableProviders().map { it.name }
+    } catch (_: Throwable) {
+      emptyList()
+    }
+    val providers = ArrayList<String>()
+    if (compiled.any { it.contains("XNNPACK", ignoreCase = true) }) providers.add("xnnpack")
+    val nnapi = compiled.any { it.contains("NNAPI", ignoreCase = true) } &&
+      (try { nativeHasNnapiAccelerator(android.os.Build.VERSION.SDK_INT) } catch (_: Throwable) { false })
+    if (nnapi) providers.add("nnapi")
+    return providers
+  }
+
+  /**
+   * Wait until the STT recognizer of a background initializeStt is loaded (resolves with load timings).
+   */
+  override fun waitForSttReady(instanceId: String, promise: Promise) {
+    sttHelper.waitForSttReady(instanceId, promise)
   }
 
   /**
@@ -489,8 +539,8 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     onlineSttHelper.isSttStreamReady(streamId, promise)
   }
 
-  override fun getSttStreamResult(streamId: String, promise: Promise) {
-    onlineSttHelper.getSttStreamResult(streamId, promise)
+  override fun getSttStreamResult(streamId: String, resultFields: Double?, promise: Promise) {
+    onlineSttHelper.getSttStreamResult(streamId, SherpaOnnxSttHelper.resultFields(resultFields), promise)
   }
 
   override fun isSttStreamEndpoint(streamId: String, promise: Promise) {
@@ -509,8 +559,8 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     onlineSttHelper.unloadOnlineStt(instanceId, promise)
   }
 
-  override fun processSttAudioChunk(streamId: String, samples: ReadableArray, sampleRate: Double, promise: Promise) {
-    onlineSttHelper.processSttAudioChunk(streamId, samples, sampleRate.toInt(), promise)
+  override fun processSttAudioChunk(streamId: String, samples: ReadableArray, sampleRate: Double, resultFields: Double?, promise: Promise) {
+    onlineSttHelper.processSttAudioChunk(streamId, samples, sampleRate.toInt(), SherpaOnnxSttHelper.resultFields(resultFields), promise)
   }
 
   override fun startPcmLiveStream(options: ReadableMap, promise: Promise) {
@@ -581,17 +631,62 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
   // ==================== STT Methods ====================
 
   /**
-   * Transcribe an audio file. Returns full result (text, tokens, timestamps, lang, emotion, event, durations).
+   * Transcribe an audio file. Returns text plus the fields in resultFields (tokens, timestamps, lang,
+   * emotion, event, durations; all when absent).
    */
-  override fun transcribeFile(instanceId: String, filePath: String, promise: Promise) {
-    sttHelper.transcribeFile(instanceId, filePath, promise)
+  override fun transcribeFile(instanceId: String, filePath: String, resultFields: Double?, promise: Promise) {
+    sttHelper.transcribeFile(instanceId, filePath, SherpaOnnxSttHelper.resultFields(resultFields), promise)
   }
 
   /**
    * Transcribe from float PCM samples.
    */
-  override fun transcribeSamples(instanceId: String, samples: ReadableArray, sampleRate: Double, promise: Promise) {
-    sttHelper.transcribeSamples(instanceId, samples, sampleRate.toInt(), promise)
+  override fun transcribeSamples(instanceId: String, samples: ReadableArray, sampleRate: Double, resultFields: Double?, promise: Promise) {
+    sttHelper.transcribeSamples(instanceId, samples, sampleRate.toInt(), SherpaOnnxSttHelper.resultFields(resultFields), promise)
+  }
+
+  /**
+   * Transcribe raw PCM passed as base64 ("int16" or "float32"), without boxing each sample.
+   */
+  override fun transcribePcm(
+    instanceId: String,
+    base64Pcm: String,
+    sampleRate: Double,
+    encoding: String?,
+    resultFields: Double?,
+    promise: Promise
+  ) {
+    sttHelper.transcribePcm(instanceId, base64Pcm, sampleRate.toInt(), encoding, SherpaOnnxSttHelper.resultFields(resultFields), promise)
+  }
+
+  /**
+   * Transcribe many files in length-sorted batches; per-file results arrive as sttBatchResult events.
+   */
+  override fun transcribeFiles(instanceId: String, requestId: String, paths: ReadableArray, options: ReadableMap?, promise: Promise) {
+    sttHelper.transcribeFiles(instanceId, requestId, paths, options, promise)
+  }
+
+  private fun emitSttBatchResult(instanceId: String, requestId: String, item: WritableMap) {
+    val eventEmitter = reactApplicationContext
+      .getJSModule(DeviceEventManagerModule.RCTDeviceEventEmitter::class.java)
+    item.putString("instanceId", instanceId)
+    item.putString("requestId", requestId)
+    eventEmitter.emit("sttBatchResult", item)
+  }
+
+  /**
+   * Transcribe a long recording: VAD-segmented, decoded in batches, merged with offset timestamps.
+   */
+  override fun transcribeLongFile(instanceId: String, requestId: String, filePath: String, options: ReadableMap?, promise: Promise) {
+    sttHelper.transcribeLongFile(instanceId, requestId, filePath, options, promise)
+  }
+
+  private fun emitSttLongFormSegment(instanceId: String, requestId: String, item: WritableMap) {
+    val eventEmitter = reactApplicationContext
+      .getJSModule(DeviceEventManagerModule.RCTDeviceEventEmitter::class.java)
+    item.putString("instanceId", instanceId)
+    item.putString("requestId", requestId)
+    eventEmitter.emit("sttLongFormSegment", item)
   }
 
   /**
@@ -709,6 +804,7 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     maxNumSentences: Double?,
     silenceScale: Double?,
     provider: String?,
+    warmUp: Boolean?,
     promise: Promise
   ) {
     ttsHelper.initializeTts(
@@ -725,6 +821,7 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
       maxNumSentences,
       silenceScale,
       provider,
+      warmUp,
       promise
     )
   }
@@ -816,6 +913,63 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     ttsHelper.generateTtsStream(instanceId, requestId, text, options, promise)
   }
 
+  /**
+   * Open a streaming TTS text session fed by pushTtsText (emits chunk events).
+   */
+  override fun startTtsTextStream(instanceId: String, requestId: String, options: ReadableMap?, promise: Promise) {
+    ttsHelper.startTtsTextStream(instanceId, requestId, options, promise)
+  }
+
+  /**
+   * Append a text fragment to an open TTS text session.
+   */
+  override fun pushTtsText(instanceId: String, requestId: String, text: String, promise: Promise) {
+    ttsHelper.pushTtsText(instanceId, requestId, text, promise)
+  }
+
+  /**
+   * Synthesize the pending text of a TTS text session without waiting for a sentence end.
+   */
+  override fun flushTtsText(instanceId: String, requestId: String, promise: Promise) {
+    ttsHelper.flushTtsText(instanceId, requestId, promise)
+  }
+
+  /**
+   * Finish a TTS text session after its pending text.
+   */
+  override fun closeTtsText(instanceId: String, requestId: String, promise: Promise) {
+    ttsHelper.closeTtsText(instanceId, requestId, promise)
+  }
+
+  /**
+   * Synthesize text straight into a file (WAV, or MP3/FLAC/... via FFmpeg); resolves with metadata
+   * only (path, sampleRate, numSamples, durationMs).
+   */
+  override fun generateTtsToFile(
+    instanceId: String,
+    text: String,
+    options: ReadableMap?,
+    path: String,
+    format: String,
+    promise: Promise
+  ) {
+    ttsHelper.generateTtsToFile(instanceId, text, options, path, format, promise)
+  }
+
+  /**
+   * Synthesize a list of { text, path, format? } items to files natively, encoding each item while
+   * the next is synthesized. Emits ttsExportProgress; resolves with per-item results.
+   */
+  override fun exportTtsBatch(
+    instanceId: String,
+    requestId: String,
+    items: ReadableArray,
+    options: ReadableMap?,
+    promise: Promise
+  ) {
+    ttsHelper.exportTtsBatch(instanceId, requestId, items, options, promise)
+  }
+
   /**
    * Cancel ongoing streaming TTS.
    */
@@ -837,6 +991,20 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     ttsHelper.writeTtsPcmChunk(instanceId, samples, promise)
   }
 
+  /**
+   * Get jitter buffer counters of the PCM player (null when not running).
+   */
+  override fun getTtsPlaybackStats(instanceId: String, promise: Promise) {
+    ttsHelper.getTtsPlaybackStats(instanceId, promise)
+  }
+
+  /**
+   * Set the PCM player's speed (1 = as generated); time-stretches buffered audio without re-synthesis.
+   */
+  override fun setTtsPcmPlayerTempo(instanceId: String, tempo: Double, promise: Promise) {
+    ttsHelper.setTtsPcmPlayerTempo(instanceId, tempo, promise)
+  }
+
   /**
    * Stop PCM playback for streaming TTS.
    */
@@ -848,15 +1016,17 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     instanceId: String,
     requestId: String,
     samples: FloatArray,
+    length: Int,
     sampleRate: Int,
     progress: Float,
     isFinal: Boolean
   ) {
     val eventEmitter = reactApplicationContext
       .getJSModule(DeviceEventManagerModule.RCTDeviceEventEmitter::class.java)
+    // Only the first length samples: samples may be a reused read buffer.
     val samplesArray = Arguments.createArray()
-    for (sample in samples) {
-      samplesArray.pushDouble(sample.toDouble())
+    for (i in 0 until length) {
+      samplesArray.pushDouble(samples[i].toDouble())
     }
     val payload = Arguments.createMap()
     payload.putString("instanceId", instanceId)
@@ -878,16 +1048,34 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     eventEmitter.emit("ttsStreamError", payload)
   }
 
-  private fun emitTtsStreamEnd(instanceId: String, requestId: String, cancelled: Boolean) {
+  private fun emitTtsStreamEnd(
+    instanceId: String,
+    requestId: String,
+    cancelled: Boolean,
+    timeToFirstAudioMs: Long,
+    queueWaitMs: Long,
+    stats: WritableMap?
+  ) {
     val eventEmitter = reactApplicationContext
       .getJSModule(DeviceEventManagerModule.RCTDeviceEventEmitter::class.java)
     val payload = Arguments.createMap()
     payload.putString("instanceId", instanceId)
     payload.putString("requestId", requestId)
     payload.putBoolean("cancelled", cancelled)
+    if (timeToFirstAudioMs >= 0) payload.putDouble("timeToFirstAudioMs", timeToFirstAudioMs.toDouble())
+    payload.putDouble("queueWaitMs", queueWaitMs.toDouble())
+    stats?.let { payload.putMap("stats", it) }
     eventEmitter.emit("ttsStreamEnd", payload)
   }
 
+  private fun emitTtsExportProgress(instanceId: String, requestId: String, item: WritableMap) {
+    val eventEmitter = reactApplicationContext
+      .getJSModule(DeviceEventManagerModule.RCTDeviceEventEmitter::class.java)
+    item.putString("instanceId", instanceId)
+    item.putString("requestId", requestId)
+    eventEmitter.emit("ttsExportProgress", item)
+  }
+
   /**
    * Get TTS sample rate.
    */
@@ -902,6 +1090,81 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     ttsHelper.getTtsNumSpeakers(instanceId, promise)
   }
 
+  /**
+   * Enable or reconfigure the synthesized-audio cache of a TTS instance.
+   */
+  override fun configureTtsAudioCache(
+    instanceId: String,
+    maxMemoryBytes: Double,
+    diskDir: String,
+    maxDiskBytes: Double,
+    promise: Promise
+  ) {
+    ttsHelper.configureTtsAudioCache(instanceId, maxMemoryBytes, diskDir, maxDiskBytes, promise)
+  }
+
+  /**
+   * Get audio cache hit/miss counters and sizes.
+   */
+  override fun getTtsAudioCacheStats(instanceId: String, promise: Promise) {
+    ttsHelper.getTtsAudioCacheStats(instanceId, promise)
+  }
+
+  /**
+   * Drop cached TTS audio (memory, optionally disk).
+   */
+  override fun clearTtsAudioCache(instanceId: String, includeDisk: Boolean, promise: Promise) {
+    ttsHelper.clearTtsAudioCache(instanceId, includeDisk, promise)
+  }
+
+  /**
+   * Get aggregate latency / real-time-factor stats of this instance's requests.
+   */
+  override fun getTtsStats(instanceId: String, promise: Promise) {
+    ttsHelper.getTtsStats(instanceId, promise)
+  }
+
+  /**
+   * Reset the aggregate TTS stats.
+   */
+  override fun resetTtsStats(instanceId: String, promise: Promise) {
+    ttsHelper.resetTtsStats(instanceId, promise)
+  }
+
+  /**
+   * Register a reference prompt (Zipvoice voice cloning) once; resolves its id.
+   */
+  override fun registerTtsPrompt(
+    instanceId: String,
+    samples: ReadableArray,
+    sampleRate: Double,
+    promptText: String,
+    promise: Promise
+  ) {
+    ttsHelper.registerTtsPrompt(instanceId, samples, sampleRate, promptText, promise)
+  }
+
+  /**
+   * Forget a registered prompt; resolves false if the id is unknown.
+   */
+  override fun unregisterTtsPrompt(instanceId: String, promptId: Double, promise: Promise) {
+    ttsHelper.unregisterTtsPrompt(instanceId, promptId, promise)
+  }
+
+  /**
+   * Calibrate latency-budgeted step selection for Zipvoice voice cloning (times two step counts).
+   */
+  override fun calibrateTtsSteps(instanceId: String, options: ReadableMap?, promise: Promise) {
+    ttsHelper.calibrateTtsSteps(instanceId, options, promise)
+  }
+
+  /**
+   * Get the Zipvoice step cost model (null for other models).
+   */
+  override fun getTtsStepCalibration(instanceId: String, promise: Promise) {
+    ttsHelper.getTtsStepCalibration(instanceId, promise)
+  }
+
   /**
    * Release TTS resources.
    */
@@ -1036,8 +1299,16 @@ class SherpaOnnxModule(reactContext: ReactApplicationContext) :
     @JvmStatic
     private external fun nativeConvertAudioToFormat(inputPath: String, outputPath: String, format: String, outputSampleRateHz: Int): String
 
+    /** [nativeConvertAudioToFormat] for other helpers in this package (TTS file output). */
+    internal fun convertAudioFile(inputPath: String, outputPath: String, format: String, outputSampleRateHz: Int): String =
+      nativeConvertAudioToFormat(inputPath, outputPath, format, outputSampleRateHz)
+
     /** Convert any supported audio file to WAV 16 kHz mono 16-bit PCM. Returns empty string on success, error message otherwise. Requires FFmpeg prebuilts. */
     @JvmStatic
     private external fun nativeConvertAudioToWav16k(inputPath: String, outputPath: String): String
+
+    /** [nativeConvertAudioToWav16k] for other helpers in this package (batch transcription input). */
+    internal fun convertAudioFileToWav16k(inputPath: String, outputPath: String): String =
+      nativeConvertAudioToWav16k(inputPath, outputPath)
   }
 }
@@ -231,6 +231,21 @@ internal class SherpaOnnxOnlineSttHelper(
         resolvedHotwordsFile = ""
       }
     }
+    if (resolvedHotwordsFile.isNotEmpty()) {
+      // Compiled (validated, vocabulary-checked, cached) form; the file as given if that fails.
+      val compiled = HotwordsCompiler.compileFile(
+        resolvedHotwordsFile,
+        paths["tokens"].orEmpty(),
+        "",
+        "",
+        File(context.cacheDir, HotwordsCompiler.CACHE_DIR).absolutePath
+      )
+      if (compiled.ok) {
+        resolvedHotwordsFile = compiled.output
+      } else {
+        Log.w(logTag, "Online hotwords not compiled, using the file as is: ${compiled.error}")
+      }
+    }
 
     return OnlineRecognizerConfig(
       featConfig = FeatureConfig(sampleRate = 16000, featureDim = 80, dither = 0f),
@@ -307,6 +322,20 @@ internal class SherpaOnnxOnlineSttHelper(
     }
   }
 
+  /**
+   * Per-stream hotwords through [HotwordsCompiler] (cached in memory), so lines the model cannot
+   * encode are dropped instead of failing the whole string; the string as given if that fails.
+   */
+  private fun compileStreamHotwords(inst: OnlineSttInstance, hotwords: String): String {
+    if (hotwords.isEmpty()) return hotwords
+    val compiled = HotwordsCompiler.compileText(hotwords, inst.config.modelConfig.tokens, "", "")
+    if (!compiled.ok) {
+      Log.w(logTag, "Stream hotwords not compiled, using them as is: ${compiled.error}")
+      return hotwords
+    }
+    return compiled.output
+  }
+
   fun createSttStream(instanceId: String, streamId: String, hotwords: String?, promise: Promise) {
     try {
       val inst = getInstance(instanceId)
@@ -318,7 +347,7 @@ internal class SherpaOnnxOnlineSttHelper(
         promise.reject("STREAM_ERROR", "Stream already exists: $streamId")
         return
       }
-      val stream = inst.recognizer.createStream(hotwords = hotwords?.trim().orEmpty())
+      val stream = inst.recognizer.createStream(hotwords = compileStreamHotwords(inst, hotwords?.trim().orEmpty()))
       inst.streams[streamId] = stream
       streamToInstance[streamId] = instanceId
       promise.resolve(null)
@@ -392,19 +421,24 @@ internal class SherpaOnnxOnlineSttHelper(
     }
   }
 
-  private fun resultToWritableMap(result: OnlineRecognizerResult): WritableMap {
+  /** Text plus tokens / timestamps when their SherpaOnnxSttHelper.RESULT_* bit is set in [fields]. */
+  private fun resultToWritableMap(result: OnlineRecognizerResult, fields: Int): WritableMap {
     val map = Arguments.createMap()
     map.putString("text", result.text)
-    val tokensArray = Arguments.createArray()
-    for (t in result.tokens) tokensArray.pushString(t)
-    map.putArray("tokens", tokensArray)
-    val timestampsArray = Arguments.createArray()
-    for (t in result.timestamps) timestampsArray.pushDouble(t.toDouble())
-    map.putArray("timestamps", timestampsArray)
+    if (fields and SherpaOnnxSttHelper.RESULT_TOKENS != 0) {
+      val tokensArray = Arguments.createArray()
+      for (t in result.tokens) tokensArray.pushString(t)
+      map.putArray("tokens", tokensArray)
+    }
+    if (fields and SherpaOnnxSttHelper.RESULT_TIMESTAMPS != 0) {
+      val timestampsArray = Arguments.createArray()
+      for (t in result.timestamps) timestampsArray.pushDouble(t.toDouble())
+      map.putArray("timestamps", timestampsArray)
+    }
     return map
   }
 
-  fun getSttStreamResult(streamId: String, promise: Promise) {
+  fun getSttStreamResult(streamId: String, fields: Int, promise: Promise) {
     try {
       val (inst, stream) = getStream(streamId)
         ?: run {
@@ -412,7 +446,7 @@ internal class SherpaOnnxOnlineSttHelper(
           return
         }
       val result = inst.recognizer.getResult(stream)
-      promise.resolve(resultToWritableMap(result))
+      promise.resolve(resultToWritableMap(result, fields))
     } catch (e: Exception) {
       Log.e(logTag, "getSttStreamResult failed: ${e.message}", e)
       promise.reject("STREAM_ERROR", "getSttStreamResult failed: ${e.message}", e)
@@ -492,6 +526,7 @@ internal class SherpaOnnxOnlineSttHelper(
     streamId: String,
     samples: ReadableArray,
     sampleRate: Int,
+    fields: Int,
     promise: Promise
   ) {
     try {
@@ -507,7 +542,7 @@ internal class SherpaOnnxOnlineSttHelper(
       }
       val result = inst.recognizer.getResult(stream)
       val isEndpoint = inst.recognizer.isEndpoint(stream)
-      val map = resultToWritableMap(result)
+      val map = resultToWritableMap(result, fields)
       map.putBoolean("isEndpoint", isEndpoint)
       promise.resolve(map)
     } catch (e: Exception) {
@@ -2,10 +2,12 @@ package com.sherpaonnx
 
 import android.content.Context
 import android.net.Uri
+import android.os.Build
 import android.os.HandlerThread
 import android.util.Log
 import com.facebook.react.bridge.Arguments
 import com.facebook.react.bridge.Promise
+import com.facebook.react.bridge.ReadableArray
 import com.facebook.react.bridge.ReadableMap
 import com.facebook.react.bridge.WritableMap
 import com.k2fsa.sherpa.onnx.FeatureConfig
@@ -28,9 +30,16 @@ import com.k2fsa.sherpa.onnx.OfflineFireRedAsrModelConfig
 import com.k2fsa.sherpa.onnx.OfflineCanaryModelConfig
 import com.k2fsa.sherpa.onnx.OfflineOmnilingualAsrCtcModelConfig
 import com.k2fsa.sherpa.onnx.OfflineMedAsrCtcModelConfig
+import com.k2fsa.sherpa.onnx.SileroVadModelConfig
+import com.k2fsa.sherpa.onnx.TenVadModelConfig
+import com.k2fsa.sherpa.onnx.Vad
+import com.k2fsa.sherpa.onnx.VadModelConfig
 import com.k2fsa.sherpa.onnx.WaveReader
 import java.io.File
+import java.util.concurrent.Callable
 import java.util.concurrent.ConcurrentHashMap
+import java.util.concurrent.Executors
+import java.util.concurrent.Future
 
 internal class SherpaOnnxSttHelper(
   private val context: Context,
@@ -41,22 +50,158 @@ internal class SherpaOnnxSttHelper(
     modelType: String,
     debug: Boolean
   ) -> HashMap<String, Any>?,
-  private val logTag: String
+  private val logTag: String,
+  private val emitBatchResult: (instanceId: String, requestId: String, item: WritableMap) -> Unit,
+  private val emitLongFormSegment: (instanceId: String, requestId: String, item: WritableMap) -> Unit
 ) {
 
+  companion object {
+    /** Loaded recognizers shared across instance ids (and module instances) by model and config. */
+    private val recognizerRegistry = SharedEngineRegistry<OfflineRecognizer>("SherpaOnnxStt") { it.release() }
+
+    /**
+     * Result-field mask bits (SttResultField in sherpa-onnx-common.h and src/stt/types.ts): text is
+     * always returned, every other field only when its bit is set.
+     */
+    const val RESULT_TOKENS = 1
+    const val RESULT_TIMESTAMPS = 1 shl 1
+    const val RESULT_DURATIONS = 1 shl 2
+    const val RESULT_LANG = 1 shl 3
+    const val RESULT_EMOTION = 1 shl 4
+    const val RESULT_EVENT = 1 shl 5
+    const val RESULT_ALL = (1 shl 6) - 1
+
+    /** Mask from a bridge argument: absent or negative means every field (the pre-mask behaviour). */
+    fun resultFields(value: Double?): Int =
+      if (value == null || value < 0) RESULT_ALL else value.toInt() and RESULT_ALL
+
+    fun resultFields(options: ReadableMap?): Int =
+      resultFields(if (options != null && options.hasKey("resultFields")) options.getDouble("resultFields") else null)
+
+    /** tuneStt winners, keyed by device build and model (tuningKey). */
+    private const val TUNING_PREFS = "sherpaonnx_stt_tuning"
+    /** Length of the synthetic calibration clip when tuneStt gets no audioFile. */
+    private const val TUNING_AUDIO_SAMPLES = 16000 * 4
+  }
+
+  /**
+   * Outcome of the recognizer load started by initializeStt. With loadInBackground, initializeStt
+   * resolves before the load is done; waitForSttReady promises queue here until it completes.
+   */
+  private class LoadState {
+    @Volatile
+    private var done = false
+    private var buildResult: (() -> WritableMap)? = null
+    private var errorCode = "INIT_ERROR"
+    private var errorMessage = ""
+    private val waiters = ArrayList<Promise>()
+
+    val isPending: Boolean get() = !done
+
+    /** [build] is called once per waiting promise (a WritableMap can only be resolved once). */
+    fun succeed(build: () -> WritableMap) = complete(build, "", "")
+
+    fun fail(code: String, message: String) = complete(null, code, message)
+
+    private fun complete(build: (() -> WritableMap)?, code: String, message: String) {
+      val pending = synchronized(this) {
+        if (done) return
+        buildResult = build
+        errorCode = code
+        errorMessage = message
+        done = true
+        ArrayList(waiters).also { waiters.clear() }
+      }
+      pending.forEach { settle(it) }
+    }
+
+    /** Settle [promise] with the load outcome, now or when the load completes. */
+    fun await(promise: Promise) {
+      synchronized(this) {
+        if (!done) {
+          waiters.add(promise)
+          return
+        }
+      }
+      settle(promise)
+    }
+
+    private fun settle(promise: Promise) {
+      val build = buildResult
+      if (build != null) promise.resolve(build()) else promise.reject(errorCode, errorMessage)
+    }
+  }
+
   private data class SttEngineInstance(
-    @Volatile var recognizer: OfflineRecognizer? = null,
+    @Volatile var engine: SharedEngineRegistry.Handle<OfflineRecognizer>? = null,
     @Volatile var lastRecognizerConfig: OfflineRecognizerConfig? = null,
     @Volatile var currentSttModelType: String? = null
-  )
+  ) {
+    /** Load started by the latest initializeStt; pending while the recognizer is being created. */
+    @Volatile
+    var load: LoadState? = null
+
+    /** Guards replacing [load] and publishing or detaching [engine] against each other. */
+    val lock = Any()
+
+    val recognizer: OfflineRecognizer? get() = engine?.engine
+
+    /**
+     * Run [block] with the shared recognizer locked and this instance's config applied (another
+     * holder may have set a different one). Returns null when no recognizer is loaded.
+     */
+    inline fun <T> withRecognizer(block: (OfflineRecognizer) -> T): T? {
+      val handle = engine ?: return null
+      // Queue behind other holders' decodes (FIFO at normal priority), then lock the recognizer.
+      val scheduler = handle.scheduler
+      val ticket = scheduler.submit(EngineScheduler.PRIORITY_NORMAL)
+      try {
+        return scheduler.withSlot(ticket) {
+          synchronized(handle.lock) {
+            val config = lastRecognizerConfig
+            if (config != null && handle.appliedSettings != config) {
+              handle.engine.setConfig(config)
+              handle.appliedSettings = config
+            }
+            block(handle.engine)
+          }
+        }
+      } finally {
+        scheduler.finish(ticket)
+      }
+    }
+
+    fun releaseRecognizer() {
+      val released = synchronized(lock) { engine.also { engine = null } }
+      released?.let { recognizerRegistry.release(it) }
+    }
+  }
 
   private val instances = ConcurrentHashMap<String, SttEngineInstance>()
 
   private val initThread = HandlerThread("stt-init").also { it.start() }
   private val initHandler = android.os.Handler(initThread.looper)
 
+  private val batchThread = HandlerThread("stt-batch").also { it.start() }
+  private val batchHandler = android.os.Handler(batchThread.looper)
+
+  /** Issues model-file read-ahead hints in parallel with detection. */
+  private val prefetchExecutor = Executors.newSingleThreadExecutor()
+
   private fun getInstance(instanceId: String): SttEngineInstance? = instances[instanceId]
 
+  /**
+   * Reject a request on an instance without a recognizer: STT_NOT_READY while a background load
+   * is still running (the caller can wait for it), otherwise [code] / not initialized.
+   */
+  private fun rejectNotLoaded(inst: SttEngineInstance, code: String, promise: Promise) {
+    if (inst.load?.isPending == true) {
+      promise.reject("STT_NOT_READY", "STT model is still loading. Wait for waitForSttReady (engine.whenReady()) first.")
+    } else {
+      promise.reject(code, "STT not initialized. Call initializeStt first.")
+    }
+  }
+
   /** Hotwords are supported for transducer and NeMo transducer models (sherpa-onnx; NeMo: https://github.com/k2-fsa/sherpa-onnx/pull/3077). */
   private fun supportsHotwords(modelType: String): Boolean =
     modelType == "transducer" || modelType == "nemo_transducer"
@@ -108,47 +253,28 @@ internal class SherpaOnnxSttHelper(
     resolveContentUriToFile(path, "stt_hotwords")
 
   /**
-   * Validates hotwords file format (one hotword per line; optional " :score" at end).
-   * Call after resolveHotwordsPath so path is always a file path (not content URI).
-   * @return null if valid, or an error message if invalid.
+   * Compiles a hotwords file (call after resolveHotwordsPath) with [HotwordsCompiler]: the former
+   * format checks, then lines with tokens missing from [tokensPath] are dropped and duplicates
+   * merged. The result is cached by file content and vocabulary, so re-inits with the same file
+   * skip the work; [HotwordsCompiler.Result.output] is the file to give the recognizer.
    */
-  private fun validateHotwordsFile(filePath: String): String? {
-    val file = File(filePath)
-    if (!file.exists()) return "Hotwords file does not exist: $filePath"
-    if (!file.isFile) return "Hotwords path is not a file: $filePath"
-    if (!file.canRead()) return "Hotwords file is not readable: $filePath"
-    val content = try {
-      file.readText(Charsets.UTF_8)
-    } catch (e: Exception) {
-      return "Failed to read hotwords file: ${e.message}"
-    }
-    if (content.contains('\u0000')) return "Hotwords file contains null bytes (not a valid text file)."
-    val lines = content.split('\n', '\r')
-    var validLines = 0
-    for (raw in lines) {
-      val line = raw.trim()
-      if (line.isEmpty()) continue
-      val hotwordPart = if (line.contains(" :")) {
-        val lastColon = line.lastIndexOf(" :")
-        val afterScore = line.substring(lastColon + 2).trim()
-        if (afterScore.isEmpty()) return "Invalid hotword line (missing score after ' :'): ${line.take(60)}…"
-        val score = afterScore.toFloatOrNull()
-        if (score == null) return "Invalid hotword line (score must be a number after ' :'): ${line.take(60)}…"
-        line.substring(0, lastColon).trim()
-      } else if (line.contains('\t')) {
-        // Likely sentencepiece .vocab format (token<TAB>score); hotwords use " :score" and one word/phrase per line.
-        val afterTab = line.substringAfter('\t').trim()
-        if (afterTab.toFloatOrNull() != null) {
-          return "This file looks like a sentencepiece .vocab file (token<TAB>score). Use a hotwords file instead: one word or phrase per line, optional ' :score' at end."
-        }
-        line
-      } else line
-      if (hotwordPart.isEmpty()) return "Invalid hotword line (empty hotword): ${line.take(60)}…"
-      if (!hotwordPart.any { it.isLetter() }) return "Invalid hotword line (must contain at least one letter): ${line.take(60)}…"
-      validLines++
+  private fun compileHotwordsFile(
+    filePath: String,
+    tokensPath: String,
+    bpeVocabPath: String,
+    modelingUnit: String
+  ): HotwordsCompiler.Result {
+    val result = HotwordsCompiler.compileFile(
+      filePath,
+      tokensPath,
+      bpeVocabPath,
+      modelingUnit,
+      File(context.cacheDir, HotwordsCompiler.CACHE_DIR).absolutePath
+    )
+    if (result.ok && result.oovLines > 0) {
+      Log.w(logTag, "Hotwords: dropped ${result.oovLines} line(s) not in the model tokens, e.g. ${result.oovSamples.joinToString()}")
     }
-    if (validLines == 0) return "Hotwords file has no valid lines (one hotword or phrase per line, UTF-8 text)."
-    return null
+    return result
   }
 
   fun initializeStt(
@@ -167,8 +293,14 @@ internal class SherpaOnnxSttHelper(
     modelOptions: ReadableMap?,
     modelingUnit: String?,
     bpeVocab: String?,
+    warmUp: Boolean?,
+    loadOptions: ReadableMap?,
     promise: Promise
   ) {
+    val startedNs = System.nanoTime()
+    val background = loadOptions?.takeIf { it.hasKey("background") }?.getBoolean("background") ?: false
+    val prefetch = loadOptions?.takeIf { it.hasKey("prefetch") }?.getBoolean("prefetch") ?: true
+    val useTuning = loadOptions?.takeIf { it.hasKey("useTuning") }?.getBoolean("useTuning") ?: true
     try {
       val modelDirFile = File(modelDir)
       if (!modelDirFile.exists()) {
@@ -185,13 +317,31 @@ internal class SherpaOnnxSttHelper(
         return
       }
 
+      // Page the model files in while detection runs; creation below then reads from the cache.
+      val prefetchFuture = if (prefetch) {
+        prefetchExecutor.submit(Callable { ModelPrefetcher.prefetchDir(modelDir) })
+      } else null
+
+      // A tuneStt winner for this device and model fills in whatever the caller left unset.
+      val tuned = if (useTuning && (numThreads == null || provider == null || preferInt8 == null)) {
+        storedTuning(modelDir, modelType ?: "auto")
+      } else null
+      val effectivePreferInt8 = preferInt8 ?: tuned?.int8
+      val effectiveNumThreads = numThreads?.toInt() ?: tuned?.numThreads
+      val effectiveProvider = provider ?: tuned?.provider
+      if (tuned != null) {
+        Log.i(logTag, "STT init: using tuned threads=$effectiveNumThreads provider=$effectiveProvider preferInt8=$effectivePreferInt8")
+      }
+
+      val detectStartNs = System.nanoTime()
       val result = detectSttModel(
         modelDir,
-        preferInt8 ?: false,
-        preferInt8 != null,
+        effectivePreferInt8 ?: false,
+        effectivePreferInt8 != null,
         modelType ?: "auto",
         debug ?: false
       )
+      val detectMs = (System.nanoTime() - detectStartNs) / 1_000_000
 
       if (result == null) {
         val errorMsg = "Failed to detect STT model. Check native logs for details."
@@ -237,13 +387,20 @@ internal class SherpaOnnxSttHelper(
           return
         }
       } else ""
-      if (resolvedHotwordsPath.isNotEmpty()) {
-        validateHotwordsFile(resolvedHotwordsPath)?.let { errorMsg ->
-          Log.e(logTag, errorMsg)
-          promise.reject("INVALID_HOTWORDS_FILE", errorMsg)
-          return
+      val compiledHotwords = if (resolvedHotwordsPath.isNotEmpty()) {
+        compileHotwordsFile(
+          resolvedHotwordsPath,
+          path(pathStrings, "tokens"),
+          bpeVocab?.trim().orEmpty().ifEmpty { path(pathStrings, "bpeVocab") },
+          modelingUnit?.trim().orEmpty()
+        ).also { compiled ->
+          if (!compiled.ok) {
+            Log.e(logTag, compiled.error)
+            promise.reject("INVALID_HOTWORDS_FILE", compiled.error)
+            return
+          }
         }
-      }
+      } else null
 
       val resolvedRuleFsts = try {
         resolveFilePaths(ruleFsts.orEmpty().trim(), "stt_rule_fst")
@@ -263,15 +420,13 @@ internal class SherpaOnnxSttHelper(
       }
 
       val inst = instances.getOrPut(instanceId) { SttEngineInstance() }
-      inst.recognizer?.release()
-      inst.recognizer = null
       val config = buildRecognizerConfig(
         pathStrings,
         modelTypeStr,
-        hotwordsFile = resolvedHotwordsPath,
+        hotwordsFile = compiledHotwords?.output.orEmpty(),
         hotwordsScore = hotwordsScore?.toFloat() ?: 1.5f,
-        numThreads = numThreads?.toInt(),
-        provider = provider,
+        numThreads = effectiveNumThreads,
+        provider = effectiveProvider,
         ruleFsts = resolvedRuleFsts,
         ruleFars = resolvedRuleFars,
         dither = dither?.toFloat() ?: 0f,
@@ -279,33 +434,124 @@ internal class SherpaOnnxSttHelper(
         modelingUnit = modelingUnit?.trim().orEmpty(),
         bpeVocab = bpeVocab?.trim().orEmpty()
       )
+      val load = LoadState()
+      // A previous load still running either published its recognizer already (released here)
+      // or sees under the lock that it was superseded and releases it itself.
+      synchronized(inst.lock) { inst.load = load }
+      inst.releaseRecognizer()
       inst.lastRecognizerConfig = config
       inst.currentSttModelType = modelTypeStr
+
+      fun detectedModelsArray(): com.facebook.react.bridge.WritableArray {
+        val array = Arguments.createArray()
+        for (model in detectedModels) {
+          val modelMap = model as? HashMap<*, *>
+          if (modelMap != null) {
+            val modelResultMap = Arguments.createMap()
+            modelResultMap.putString("type", modelMap["type"] as? String ?: "")
+            modelResultMap.putString("modelDir", modelMap["modelDir"] as? String ?: "")
+            array.pushMap(modelResultMap)
+          }
+        }
+        return array
+      }
+
+      fun autoTunedMap(): WritableMap? {
+        if (tuned == null) return null
+        val map = Arguments.createMap()
+        map.putInt("numThreads", effectiveNumThreads ?: 1)
+        map.putString("provider", effectiveProvider ?: "cpu")
+        map.putBoolean("preferInt8", effectivePreferInt8 ?: false)
+        return map
+      }
+
+      fun hotwordsMap(): WritableMap? {
+        val compiled = compiledHotwords ?: return null
+        val map = Arguments.createMap()
+        map.putInt("entries", compiled.entries)
+        map.putInt("duplicates", compiled.duplicates)
+        map.putInt("droppedLines", compiled.oovLines)
+        map.putBoolean("vocabChecked", compiled.vocabChecked)
+        map.putBoolean("cached", compiled.cached)
+        map.putDouble("compileMs", compiled.compileMs)
+        return map
+      }
+
+      if (background) {
+        // Hand the instance back now; transcribe* wait (JS) or get STT_NOT_READY until the load is done.
+        val resultMap = Arguments.createMap()
+        resultMap.putBoolean("success", true)
+        resultMap.putBoolean("loading", true)
+        resultMap.putString("modelType", modelTypeStr)
+        resultMap.putString("decodingMethod", config.decodingMethod)
+        resultMap.putArray("detectedModels", detectedModelsArray())
+        autoTunedMap()?.let { resultMap.putMap("autoTuned", it) }
+        hotwordsMap()?.let { resultMap.putMap("hotwords", it) }
+        promise.resolve(resultMap)
+      } else {
+        load.await(promise)
+      }
+
       // Defer recognizer creation to the dedicated background thread so release() of the previous
       // recognizer can complete off the UI thread (avoids "destroyed mutex" / SIGSEGV when switching models).
       initHandler.post {
         try {
-          inst.recognizer = OfflineRecognizer(config = config)
-          val resultMap = Arguments.createMap()
-          resultMap.putBoolean("success", true)
-          resultMap.putString("modelType", modelTypeStr)
-          resultMap.putString("decodingMethod", config.decodingMethod)
-          val detectedModelsArray = Arguments.createArray()
-          for (model in detectedModels) {
-            val modelMap = model as? HashMap<*, *>
-            if (modelMap != null) {
-              val modelResultMap = Arguments.createMap()
-              modelResultMap.putString("type", modelMap["type"] as? String ?: "")
-              modelResultMap.putString("modelDir", modelMap["modelDir"] as? String ?: "")
-              detectedModelsArray.pushMap(modelResultMap)
-            }
+          val prefetchStats = try {
+            prefetchFuture?.get()
+          } catch (e: Exception) {
+            Log.w(logTag, "Model prefetch failed (ignored): ${e.message}")
+            null
+          }
+          // Instances with the same model and config share one recognizer; a shared one is already warm.
+          val createStartNs = System.nanoTime()
+          val acquired = recognizerRegistry.acquire(SharedEngineRegistry.engineKey(modelDir, config.toString())) {
+            OfflineRecognizer(config = config)
+          } ?: throw IllegalStateException("Failed to create recognizer")
+          val handle = acquired.handle
+          val reused = acquired.reused
+          val createMs = (System.nanoTime() - createStartNs) / 1_000_000
+          synchronized(handle.lock) {
+            if (handle.appliedSettings == null) handle.appliedSettings = config
+          }
+          val published = synchronized(inst.lock) {
+            val current = instances[instanceId] === inst && inst.load === load
+            if (current) inst.engine = handle
+            current
+          }
+          if (!published) {
+            // Unloaded or re-initialized while this load was running.
+            recognizerRegistry.release(handle)
+            load.fail("INIT_ERROR", "STT instance was unloaded or re-initialized while loading")
+            return@post
+          }
+          val warmUpMs = if (warmUp == true && !reused) inst.withRecognizer { warmUpRecognizer(it) } ?: -1L else -1L
+          val totalMs = (System.nanoTime() - startedNs) / 1_000_000
+          Log.i(logTag, "STT load: detect ${detectMs} ms, create ${createMs} ms (shared=$reused), total ${totalMs} ms")
+          load.succeed {
+            val resultMap = Arguments.createMap()
+            resultMap.putBoolean("success", true)
+            resultMap.putString("modelType", modelTypeStr)
+            resultMap.putString("decodingMethod", config.decodingMethod)
+            if (warmUpMs >= 0) resultMap.putDouble("warmUpMs", warmUpMs.toDouble())
+            resultMap.putArray("detectedModels", detectedModelsArray())
+            autoTunedMap()?.let { resultMap.putMap("autoTuned", it) }
+            hotwordsMap()?.let { resultMap.putMap("hotwords", it) }
+            val timings = Arguments.createMap()
+            timings.putDouble("prefetchMs", (prefetchStats?.elapsedMs ?: 0L).toDouble())
+            timings.putInt("prefetchedFiles", prefetchStats?.files ?: 0)
+            timings.putDouble("prefetchedBytes", (prefetchStats?.bytes ?: 0L).toDouble())
+            timings.putDouble("detectMs", detectMs.toDouble())
+            timings.putDouble("createMs", createMs.toDouble())
+            if (warmUpMs >= 0) timings.putDouble("warmUpMs", warmUpMs.toDouble())
+            timings.putDouble("totalMs", totalMs.toDouble())
+            timings.putBoolean("shared", reused)
+            resultMap.putMap("loadTimings", timings)
+            resultMap
           }
-          resultMap.putArray("detectedModels", detectedModelsArray)
-          promise.resolve(resultMap)
         } catch (e: Exception) {
           val errorMsg = "Exception creating recognizer: ${e.message ?: e.javaClass.simpleName}"
           Log.e(logTag, errorMsg, e)
-          promise.reject("INIT_ERROR", errorMsg, e)
+          load.fail("INIT_ERROR", errorMsg)
         }
       }
     } catch (e: Exception) {
@@ -315,16 +561,257 @@ internal class SherpaOnnxSttHelper(
     }
   }
 
-  fun transcribeFile(instanceId: String, filePath: String, promise: Promise) {
+  /**
+   * Decode 0.5 s of low-level noise and drop the result so the first real request does not pay
+   * for ONNX Runtime's lazy initialization. Returns elapsed ms, or -1 if it failed (a failed
+   * warm-up is logged but does not fail init).
+   */
+  private fun warmUpRecognizer(recognizer: OfflineRecognizer): Long {
+    val start = System.nanoTime()
+    try {
+      var seed = 12345
+      val samples = FloatArray(8000) {
+        seed = seed * 1664525 + 1013904223
+        ((seed ushr 8).toFloat() / 16777216f - 0.5f) * 1e-3f
+      }
+      val stream = recognizer.createStream()
+      try {
+        stream.acceptWaveform(samples, 16000)
+        recognizer.decode(stream)
+        recognizer.getResult(stream)
+      } finally {
+        stream.release()
+      }
+    } catch (e: Exception) {
+      Log.w(logTag, "Warm-up decode failed (ignored): ${e.message}")
+      return -1L
+    }
+    val ms = (System.nanoTime() - start) / 1_000_000
+    Log.i(logTag, "Warm-up decode took $ms ms")
+    return ms
+  }
+
+  /**
+   * Benchmark recognizer configurations for a model on this device and store the fastest: cpu over
+   * a thread ladder up to options.maxThreads, then options.providers at the best thread count, then
+   * the other quantization when the model ships int8 and fp32 files (SttAutoTuner). Each candidate
+   * is loaded, decoded once to warm up and options.runs times on options.audioFile (or a synthetic
+   * clip) for the median RTF, and its peak memory is measured. Runs on the init thread, so it never
+   * overlaps a model load. Resolves with the winner and every measurement.
+   */
+  fun tuneStt(modelDir: String, options: ReadableMap?, defaultProviders: List<String>, promise: Promise) {
+    if (!File(modelDir).isDirectory) {
+      Log.e(logTag, "STT_TUNE_ERROR: Model directory does not exist: $modelDir")
+      promise.reject("STT_TUNE_ERROR", "Model directory does not exist: $modelDir")
+      return
+    }
+    val modelType = options?.takeIf { it.hasKey("modelType") }?.getString("modelType") ?: "auto"
+    val maxThreads = options?.takeIf { it.hasKey("maxThreads") }?.getDouble("maxThreads")?.toInt()?.coerceIn(1, 16)
+      ?: Runtime.getRuntime().availableProcessors().coerceIn(1, 8)
+    val providers = options?.takeIf { it.hasKey("providers") }?.getArray("providers")?.let { array ->
+      (0 until array.size()).mapNotNull { array.getString(it)?.trim()?.lowercase()?.takeIf { p -> p.isNotEmpty() } }
+    } ?: defaultProviders
+    val runs = options?.takeIf { it.hasKey("runs") }?.getDouble("runs")?.toInt()?.coerceIn(1, 10) ?: 2
+    val maxMemoryBytes = options?.takeIf { it.hasKey("maxMemoryMB") }?.getDouble("maxMemoryMB")
+      ?.let { (it * 1024 * 1024).toLong() } ?: 0L
+    val tolerance = options?.takeIf { it.hasKey("tolerance") }?.getDouble("tolerance") ?: 0.05
+    val persist = options?.takeIf { it.hasKey("persist") }?.getBoolean("persist") ?: true
+    val audioFile = options?.takeIf { it.hasKey("audioFile") }?.getString("audioFile")?.trim().orEmpty()
+    val modelOptions = options?.takeIf { it.hasKey("modelOptions") }?.getMap("modelOptions")
+
+    initHandler.post {
+      var tuner: SttAutoTuner? = null
+      try {
+        // Detect both ways to learn which quantizations the model directory actually has.
+        val int8Paths = detectedPaths(modelDir, true, modelType)
+        val fp32Paths = detectedPaths(modelDir, false, modelType)
+        val detected = int8Paths ?: fp32Paths ?: run {
+          promise.reject("STT_TUNE_ERROR", "Failed to detect STT model in $modelDir")
+          return@post
+        }
+        val both = int8Paths != null && fp32Paths != null && int8Paths.second != fp32Paths.second
+        val int8Only = !both && detected.second.values.any { it.contains("int8", ignoreCase = true) }
+        val (samples, sampleRate) = if (audioFile.isNotEmpty()) {
+          readWaveSamples(audioFile).let { (s, sr) ->
+            if (s == null || s.isEmpty() || sr <= 0) {
+              promise.reject("STT_TUNE_ERROR", "Could not read calibration audio: $audioFile")
+              return@post
+            }
+            s to sr
+          }
+        } else syntheticCalibrationAudio() to 16000
+        val audioMs = samples.size * 1000.0 / sampleRate
+
+        val t = SttAutoTuner(maxThreads, providers, both || int8Only, both || !int8Only, maxMemoryBytes, tolerance)
+        tuner = t
+        val measurements = Arguments.createArray()
+        while (true) {
+          val candidate = t.next() ?: break
+          val paths = if (candidate.int8) (int8Paths ?: detected) else (fp32Paths ?: detected)
+          var loadMs = 0.0
+          var decodeMs = 0.0
+          var error = ""
+          t.beginMemory()
+          try {
+            val config = buildRecognizerConfig(
+              paths.second,
+              paths.first,
+              numThreads = candidate.numThreads,
+              provider = candidate.provider,
+              modelOptions = modelOptions
+            )
+            val loadStartNs = System.nanoTime()
+            val recognizer = OfflineRecognizer(config = config)
+            try {
+              loadMs = (System.nanoTime() - loadStartNs) / 1e6
+              t.sampleMemory()
+              decodeOnce(recognizer, samples, sampleRate)  // warm-up: lazy ORT initialization is not decode cost
+              t.sampleMemory()
+              val times = DoubleArray(runs) {
+                val startNs = System.nanoTime()
+                decodeOnce(recognizer, samples, sampleRate)
+                t.sampleMemory()
+                (System.nanoTime() - startNs) / 1e6
+              }
+              times.sort()
+              decodeMs = times[runs / 2]
+            } finally {
+              recognizer.release()
+            }
+          } catch (e: Exception) {
+            error = e.message ?: e.javaClass.simpleName
+            Log.w(logTag, "STT tune: ${candidate.provider} x${candidate.numThreads} int8=${candidate.int8} failed: $error")
+          }
+          val peak = t.peakMemoryBytes()
+          t.report(candidate, error.isEmpty(), error, loadMs, decodeMs, audioMs, peak)
+          val item = Arguments.createMap()
+          item.putInt("numThreads", candidate.numThreads)
+          item.putString("provider", candidate.provider)
+          item.putBoolean("preferInt8", candidate.int8)
+          item.putBoolean("ok", error.isEmpty())
+          if (error.isNotEmpty()) item.putString("error", error)
+          item.putDouble("loadMs", loadMs)
+          item.putDouble("decodeMs", decodeMs)
+          item.putDouble("rtf", if (audioMs > 0) decodeMs / audioMs else 0.0)
+          item.putDouble("peakMemoryBytes", peak.toDouble())
+          measurements.pushMap(item)
+        }
+        val best = t.best() ?: run {
+          promise.reject("STT_TUNE_ERROR", "No configuration could load and decode the model")
+          return@post
+        }
+        if (persist) tuningPrefs().edit().putString(tuningKey(modelDir, modelType), best.serialized).apply()
+        Log.i(logTag, "STT tune: best ${best.provider} x${best.numThreads} int8=${best.int8} rtf=${best.rtf}")
+        val result = tuningToMap(best)
+        result.putDouble("audioMs", audioMs)
+        result.putBoolean("stored", persist)
+        result.putArray("measurements", measurements)
+        promise.resolve(result)
+      } catch (e: Exception) {
+        Log.e(logTag, "STT_TUNE_ERROR: Tuning failed", e)
+        promise.reject("STT_TUNE_ERROR", e.message ?: "Tuning failed", e)
+      } finally {
+        tuner?.release()
+      }
+    }
+  }
+
+  /** Stored tuneStt winner for a model on this device, or null. */
+  fun getSttTuning(modelDir: String, modelType: String?, promise: Promise) {
+    promise.resolve(storedTuning(modelDir, modelType ?: "auto")?.let { tuningToMap(it) })
+  }
+
+  /** Forget the stored tuneStt winner; resolves true if one was stored. */
+  fun clearSttTuning(modelDir: String, modelType: String?, promise: Promise) {
+    val key = tuningKey(modelDir, modelType ?: "auto")
+    val prefs = tuningPrefs()
+    val existed = prefs.contains(key)
+    if (existed) prefs.edit().remove(key).apply()
+    promise.resolve(existed)
+  }
+
+  private fun tuningPrefs() =
+    context.getSharedPreferences(TUNING_PREFS, Context.MODE_PRIVATE)
+
+  /** Device build plus model files: an OS or ORT update, or new model files, invalidate a choice. */
+  private fun tuningKey(modelDir: String, modelType: String): String =
+    "${Build.FINGERPRINT}|${SttAutoTuner.modelKey(modelDir, modelType)}"
+
+  private fun storedTuning(modelDir: String, modelType: String): SttAutoTuner.Choice? {
+    val stored = try {
+      tuningPrefs().getString(tuningKey(modelDir, modelType), null)
+    } catch (e: Exception) {
+      null
+    } ?: return null
+    return SttAutoTuner.parseChoice(stored) ?: run {
+      Log.w(logTag, "Ignoring unreadable STT tuning for $modelDir")
+      null
+    }
+  }
+
+  private fun tuningToMap(choice: SttAutoTuner.Choice): WritableMap {
+    val map = Arguments.createMap()
+    map.putInt("numThreads", choice.numThreads)
+    map.putString("provider", choice.provider)
+    map.putBoolean("preferInt8", choice.int8)
+    map.putDouble("rtf", choice.rtf)
+    map.putDouble("peakMemoryBytes", choice.peakMemoryBytes.toDouble())
+    return map
+  }
+
+  /** (model type, paths) detected with the given int8 preference; null when detection fails. */
+  private fun detectedPaths(modelDir: String, preferInt8: Boolean, modelType: String): Pair<String, Map<String, String>>? {
+    val result = detectSttModel(modelDir, preferInt8, true, modelType, false) ?: return null
+    if (result["success"] as? Boolean != true) return null
+    val paths = result["paths"] as? Map<*, *> ?: return null
+    val type = result["modelType"] as? String ?: return null
+    return type to paths.mapValues { (_, v) -> (v as? String).orEmpty() }.mapKeys { it.key.toString() }
+  }
+
+  private fun decodeOnce(recognizer: OfflineRecognizer, samples: FloatArray, sampleRate: Int) {
+    val stream = recognizer.createStream()
+    try {
+      stream.acceptWaveform(samples, sampleRate)
+      recognizer.decode(stream)
+      recognizer.getResult(stream)
+    } finally {
+      stream.release()
+    }
+  }
+
+  /**
+   * Speech-like stand-in for tuneStt without audioFile: syllable-rate bursts of a few harmonics
+   * over low noise, so the encoder and decoder see non-silent frames.
+   */
+  private fun syntheticCalibrationAudio(): FloatArray {
+    var seed = 12345
+    return FloatArray(TUNING_AUDIO_SAMPLES) { i ->
+      seed = seed * 1664525 + 1013904223
+      val t = i / 16000.0
+      val envelope = maxOf(0.0, Math.sin(2 * Math.PI * 4.0 * t))
+      val f0 = 140.0 + 30.0 * Math.sin(2 * Math.PI * 0.5 * t)
+      var v = 0.0
+      for (h in 1..4) v += Math.sin(2 * Math.PI * f0 * h * t) / h
+      (0.1 * envelope * v).toFloat() + ((seed ushr 8).toFloat() / 16777216f - 0.5f) * 2e-3f
+    }
+  }
+
+  /**
+   * WAV samples through the memory-mapped WavFileReader (no whole-file byte copy next to the
+   * floats); encodings it does not parse fall back to WaveReader.
+   */
+  private fun readWaveSamples(path: String): Pair<FloatArray?, Int> =
+    WavFileReader.readMono(path) ?: WaveReader.readWave(path).let { it.samples to it.sampleRate }
+
+  fun transcribeFile(instanceId: String, filePath: String, fields: Int, promise: Promise) {
     var tempPath: String? = null
     try {
       val inst = getInstance(instanceId) ?: run {
         promise.reject("TRANSCRIBE_ERROR", "STT instance not found: $instanceId")
         return
       }
-      val rec = inst.recognizer
-      if (rec == null) {
-        promise.reject("TRANSCRIBE_ERROR", "STT not initialized. Call initializeStt first.")
+      if (inst.recognizer == null) {
+        rejectNotLoaded(inst, "TRANSCRIBE_ERROR", promise)
         return
       }
       val pathToRead = if (filePath.startsWith("content://")) {
@@ -342,21 +829,25 @@ internal class SherpaOnnxSttHelper(
         promise.reject("TRANSCRIBE_ERROR", "Audio file does not exist or is empty: $pathToRead (size=${f.length()})")
         return
       }
-      val wave = WaveReader.readWave(pathToRead)
-      val samples = wave.samples
+      val (samples, sampleRate) = readWaveSamples(pathToRead)
       if (samples == null || samples.isEmpty()) {
         promise.reject("TRANSCRIBE_ERROR", "Could not read audio samples (file=${f.length()} bytes). The file must be WAV format (use convertAudioToWav16k for MP3/FLAC).")
         return
       }
-      val stream: OfflineStream = rec.createStream()
-      try {
-        stream.acceptWaveform(samples, wave.sampleRate)
-        rec.decode(stream)
-        val result = rec.getResult(stream)
-        promise.resolve(resultToWritableMap(result))
-      } finally {
-        stream.release()
+      val result = inst.withRecognizer { rec ->
+        val stream: OfflineStream = rec.createStream()
+        try {
+          stream.acceptWaveform(samples, sampleRate)
+          rec.decode(stream)
+          rec.getResult(stream)
+        } finally {
+          stream.release()
+        }
+      } ?: run {
+        promise.reject("TRANSCRIBE_ERROR", "STT not initialized. Call initializeStt first.")
+        return
       }
+      promise.resolve(resultToWritableMap(result, fields))
     } catch (e: Exception) {
       val message = e.message?.takeIf { it.isNotBlank() } ?: "Failed to transcribe file"
       Log.e(logTag, "transcribeFile error: $message", e)
@@ -370,27 +861,67 @@ internal class SherpaOnnxSttHelper(
     }
   }
 
-  fun transcribeSamples(instanceId: String, samples: com.facebook.react.bridge.ReadableArray, sampleRate: Int, promise: Promise) {
+  fun transcribeSamples(instanceId: String, samples: com.facebook.react.bridge.ReadableArray, sampleRate: Int, fields: Int, promise: Promise) {
+    val floatSamples = try {
+      FloatArray(samples.size()) { i -> samples.getDouble(i).toFloat() }
+    } catch (e: Exception) {
+      promise.reject("TRANSCRIBE_ERROR", e.message ?: "Invalid samples", e)
+      return
+    }
+    transcribeSamples(instanceId, floatSamples, sampleRate, fields, promise)
+  }
+
+  /**
+   * Raw PCM (base64, e.g. a pcmLiveStreamData chunk passed through untouched) decoded from its
+   * bytes in one native pass: no per-sample boxing through a ReadableArray.
+   * @param encoding "int16" (default) or "float32", little-endian mono
+   */
+  fun transcribePcm(instanceId: String, base64Pcm: String, sampleRate: Int, encoding: String?, fields: Int, promise: Promise) {
+    val pcmEncoding = when (encoding?.takeIf { it.isNotEmpty() } ?: "int16") {
+      "int16", "s16le" -> WavFileReader.PCM_INT16
+      "float32", "f32le" -> WavFileReader.PCM_FLOAT32
+      else -> {
+        promise.reject("TRANSCRIBE_ERROR", "Unsupported PCM encoding: $encoding (use int16 or float32)")
+        return
+      }
+    }
+    val samples = try {
+      WavFileReader.pcmToFloat(android.util.Base64.decode(base64Pcm, android.util.Base64.DEFAULT), pcmEncoding)
+    } catch (e: IllegalArgumentException) {
+      promise.reject("TRANSCRIBE_ERROR", "base64Pcm is not valid base64", e)
+      return
+    }
+    transcribeSamples(instanceId, samples, sampleRate, fields, promise)
+  }
+
+  /**
+   * Transcribe samples that already live in a FloatArray (natively captured or converted audio);
+   * the array is handed to the stream as is.
+   */
+  fun transcribeSamples(instanceId: String, samples: FloatArray, sampleRate: Int, fields: Int, promise: Promise) {
     try {
       val inst = getInstance(instanceId) ?: run {
         promise.reject("TRANSCRIBE_ERROR", "STT instance not found: $instanceId")
         return
       }
-      val rec = inst.recognizer
-      if (rec == null) {
-        promise.reject("TRANSCRIBE_ERROR", "STT not initialized. Call initializeStt first.")
+      if (inst.recognizer == null) {
+        rejectNotLoaded(inst, "TRANSCRIBE_ERROR", promise)
         return
       }
-      val floatSamples = FloatArray(samples.size()) { i -> samples.getDouble(i).toFloat() }
-      val stream: OfflineStream = rec.createStream()
-      try {
-        stream.acceptWaveform(floatSamples, sampleRate)
-        rec.decode(stream)
-        val result = rec.getResult(stream)
-        promise.resolve(resultToWritableMap(result))
-      } finally {
-        stream.release()
+      val result = inst.withRecognizer { rec ->
+        val stream: OfflineStream = rec.createStream()
+        try {
+          stream.acceptWaveform(samples, sampleRate)
+          rec.decode(stream)
+          rec.getResult(stream)
+        } finally {
+          stream.release()
+        }
+      } ?: run {
+        promise.reject("TRANSCRIBE_ERROR", "STT not initialized. Call initializeStt first.")
+        return
       }
+      promise.resolve(resultToWritableMap(result, fields))
     } catch (e: Exception) {
       val message = e.message?.takeIf { it.isNotBlank() } ?: "Failed to transcribe samples"
       Log.e(logTag, "transcribeSamples error: $message", e)
@@ -398,16 +929,450 @@ internal class SherpaOnnxSttHelper(
     }
   }
 
+  /** One transcribeFiles input after reading (and converting) on an I/O thread. */
+  private class BatchInput(val samples: FloatArray?, val sampleRate: Int, val error: String?)
+
+  /** RIFF/WAVE magic; anything else goes through the FFmpeg converter first. */
+  private fun isWavFile(path: String): Boolean = try {
+    File(path).inputStream().use { input ->
+      val header = ByteArray(12)
+      input.read(header) == 12 &&
+        String(header, 0, 4, Charsets.US_ASCII) == "RIFF" && String(header, 8, 4, Charsets.US_ASCII) == "WAVE"
+    }
+  } catch (_: Exception) {
+    false
+  }
+
+  private fun loadBatchInput(path: String): BatchInput {
+    val temps = ArrayList<String>(2)
+    try {
+      var pathToRead = path
+      if (pathToRead.startsWith("content://")) {
+        pathToRead = resolveContentUriToFile(pathToRead, "stt_batch")
+        temps.add(pathToRead)
+      }
+      val f = File(pathToRead)
+      if (!f.exists() || f.length() == 0L) return BatchInput(null, 0, "Audio file does not exist or is empty: $path")
+      if (!isWavFile(pathToRead)) {
+        val wavPath = File(context.cacheDir, "stt_batch_${System.nanoTime()}.wav").absolutePath
+        temps.add(wavPath)
+        val err = SherpaOnnxModule.convertAudioFileToWav16k(pathToRead, wavPath)
+        if (err.isNotEmpty()) return BatchInput(null, 0, "Could not convert $path to WAV: $err")
+        pathToRead = wavPath
+      }
+      val (samples, sampleRate) = readWaveSamples(pathToRead)
+      if (samples == null || samples.isEmpty()) return BatchInput(null, 0, "Could not read audio samples: $path")
+      return BatchInput(samples, sampleRate, null)
+    } catch (e: Exception) {
+      return BatchInput(null, 0, e.message?.takeIf { it.isNotBlank() } ?: "Could not read $path")
+    } finally {
+      for (temp in temps) {
+        try {
+          File(temp).delete()
+        } catch (_: Exception) { }
+      }
+    }
+  }
+
+  private fun batchItemMap(index: Int, path: String, result: OfflineRecognizerResult?, error: String?, fields: Int): WritableMap {
+    val map = if (result != null) resultToWritableMap(result, fields) else Arguments.createMap()
+    map.putInt("index", index)
+    map.putString("path", path)
+    map.putBoolean("success", result != null)
+    error?.let { map.putString("error", it) }
+    return map
+  }
+
+  /**
+   * Transcribe many files: durations are estimated from file headers, files are grouped into
+   * length-sorted batches (options.maxBatchSize, options.maxPaddedSeconds) and the next batch is
+   * read and, for non-WAV inputs, converted on options.ioThreads I/O threads while the current one
+   * decodes. Each batch takes the recognizer once; every file is reported with the sttBatchResult
+   * event as soon as its batch is done, and failures do not stop the rest.
+   */
+  fun transcribeFiles(instanceId: String, requestId: String, paths: ReadableArray, options: ReadableMap?, promise: Promise) {
+    val inst = getInstance(instanceId) ?: run {
+      promise.reject("TRANSCRIBE_ERROR", "STT instance not found: $instanceId")
+      return
+    }
+    if (inst.recognizer == null) {
+      rejectNotLoaded(inst, "TRANSCRIBE_ERROR", promise)
+      return
+    }
+    val pathList = Array(paths.size()) { i -> paths.getString(i) ?: "" }
+    val maxBatchSize =
+      if (options != null && options.hasKey("maxBatchSize")) options.getDouble("maxBatchSize").toInt().coerceAtLeast(1) else 8
+    val maxPaddedSeconds =
+      if (options != null && options.hasKey("maxPaddedSeconds")) options.getDouble("maxPaddedSeconds") else 240.0
+    val ioThreads =
+      if (options != null && options.hasKey("ioThreads")) options.getDouble("ioThreads").toInt().coerceIn(1, 8) else 2
+    val fields = resultFields(options)
+    batchHandler.post {
+      val io = Executors.newFixedThreadPool(ioThreads)
+      try {
+        val startNs = System.nanoTime()
+        val plan = SttBatchPlanner.plan(pathList, maxBatchSize, maxPaddedSeconds)
+        val results = arrayOfNulls<OfflineRecognizerResult>(pathList.size)
+        val errors = arrayOfNulls<String>(pathList.size)
+        var completed = 0
+        var audioSeconds = 0.0
+        var decodeNs = 0L
+        fun load(batch: IntArray): List<Future<BatchInput>> =
+          batch.map { i -> io.submit(Callable { loadBatchInput(pathList[i]) }) }
+        fun report(index: Int) {
+          completed++
+          val item = batchItemMap(index, pathList[index], results[index], errors[index], fields)
+          item.putInt("completed", completed)
+          item.putInt("total", pathList.size)
+          emitBatchResult(instanceId, requestId, item)
+        }
+
+        var pending = if (plan.batches.isNotEmpty()) load(plan.batches[0]) else emptyList()
+        for ((b, batch) in plan.batches.withIndex()) {
+          val inputs = pending.map { it.get() }
+          // Read the next batch while this one decodes.
+          pending = if (b + 1 < plan.batches.size) load(plan.batches[b + 1]) else emptyList()
+          val ready = batch.indices.filter { inputs[it].samples != null }
+          for (k in batch.indices) {
+            if (inputs[k].samples == null) errors[batch[k]] = inputs[k].error ?: "Could not read ${pathList[batch[k]]}"
+          }
+          if (ready.isNotEmpty()) {
+            val decodeStart = System.nanoTime()
+            try {
+              // The Kotlin API decodes one stream per call; the batch still shares one recognizer turn.
+              val decoded = inst.withRecognizer { rec ->
+                val streams = ArrayList<OfflineStream>(ready.size)
+                try {
+                  for (k in ready) {
+                    val stream = rec.createStream()
+                    streams.add(stream)
+                    stream.acceptWaveform(inputs[k].samples!!, inputs[k].sampleRate)
+                  }
+                  streams.map { stream ->
+                    rec.decode(stream)
+                    rec.getResult(stream)
+                  }
+                } finally {
+                  for (stream in streams) stream.release()
+                }
+              } ?: throw IllegalStateException("STT not initialized. Call initializeStt first.")
+              for ((j, k) in ready.withIndex()) {
+                results[batch[k]] = decoded[j]
+                audioSeconds += inputs[k].samples!!.size.toDouble() / inputs[k].sampleRate
+              }
+            } catch (e: Exception) {
+              val message = e.message?.takeIf { it.isNotBlank() } ?: "Recognition failed"
+              Log.e(logTag, "transcribeFiles batch $b failed: $message", e)
+              for (k in ready) errors[batch[k]] = message
+            }
+            decodeNs += System.nanoTime() - decodeStart
+          }
+          for (index in batch) report(index)
+        }
+
+        val items = Arguments.createArray()
+        var succeeded = 0
+        for (i in pathList.indices) {
+          if (results[i] != null) succeeded++
+          items.pushMap(batchItemMap(i, pathList[i], results[i], errors[i], fields))
+        }
+        val decodeMs = decodeNs / 1e6
+        val audioMs = audioSeconds * 1000.0
+        val map = Arguments.createMap()
+        map.putArray("results", items)
+        map.putInt("succeeded", succeeded)
+        map.putInt("failed", pathList.size - succeeded)
+        map.putInt("total", pathList.size)
+        map.putInt("batches", plan.batches.size)
+        map.putDouble("audioMs", audioMs)
+        map.putDouble("decodeMs", decodeMs)
+        map.putDouble("elapsedMs", (System.nanoTime() - startNs) / 1e6)
+        map.putDouble("realTimeFactor", if (audioMs > 0.0) decodeMs / audioMs else 0.0)
+        promise.resolve(map)
+      } catch (e: Exception) {
+        val message = e.message?.takeIf { it.isNotBlank() } ?: "Failed to transcribe files"
+        Log.e(logTag, "transcribeFiles error: $message", e)
+        promise.reject("TRANSCRIBE_ERROR", message, e)
+      } finally {
+        io.shutdownNow()
+      }
+    }
+  }
+
+  /** One decoded transcribeLongFile range: source samples [range], result or error. */
+  private class LongFormSegment(val range: SpeechRangeBuilder.Range, val result: OfflineRecognizerResult?, val error: String?)
+
+  private fun buildVadConfig(options: ReadableMap, maxSegmentSeconds: Float): VadModelConfig {
+    val model = options.getString("vadModel")?.trim().orEmpty()
+    if (model.isEmpty()) throw IllegalArgumentException("options.vadModel (silero_vad.onnx or ten-vad.onnx) is required")
+    if (!File(model).isFile) throw IllegalArgumentException("VAD model not found: $model")
+    val type = (if (options.hasKey("vadType")) options.getString("vadType") else null)?.lowercase()
+      ?: if (File(model).name.lowercase().contains("ten")) "ten" else "silero"
+    val threshold = if (options.hasKey("threshold")) options.getDouble("threshold").toFloat() else 0.5f
+    val minSilence = if (options.hasKey("minSilenceDuration")) options.getDouble("minSilenceDuration").toFloat() else 0.5f
+    val minSpeech = if (options.hasKey("minSpeechDuration")) options.getDouble("minSpeechDuration").toFloat() else 0.25f
+    val numThreads = if (options.hasKey("vadThreads")) options.getDouble("vadThreads").toInt().coerceAtLeast(1) else 1
+    return when (type) {
+      "ten" -> VadModelConfig(
+        tenVadModelConfig = TenVadModelConfig(
+          model = model,
+          threshold = threshold,
+          minSilenceDuration = minSilence,
+          minSpeechDuration = minSpeech,
+          windowSize = 256,
+          maxSpeechDuration = maxSegmentSeconds
+        ),
+        sampleRate = 16000,
+        numThreads = numThreads
+      )
+      "silero" -> VadModelConfig(
+        sileroVadModelConfig = SileroVadModelConfig(
+          model = model,
+          threshold = threshold,
+          minSilenceDuration = minSilence,
+          minSpeechDuration = minSpeech,
+          windowSize = 512,
+          maxSpeechDuration = maxSegmentSeconds
+        ),
+        sampleRate = 16000,
+        numThreads = numThreads
+      )
+      else -> throw IllegalArgumentException("Unsupported vadType: $type (expected \"silero\" or \"ten\")")
+    }
+  }
+
+  /**
+   * Long-form transcription for recordings offline models cannot take in one piece. The file
+   * (converted to 16 kHz WAV if needed) is scanned with a Silero or TEN VAD one second at a time;
+   * speech becomes padded decode ranges of at most options.maxSegmentSeconds (SpeechRangeBuilder),
+   * which a decode thread reads back and decodes options.maxBatchSize at a time, one recognizer
+   * turn per batch, while the scan continues. Memory holds the VAD window plus one batch being
+   * collected and one being decoded. Each segment is reported with the sttLongFormSegment event;
+   * the result merges them in order with timestamps shifted by each segment's offset.
+   */
+  fun transcribeLongFile(instanceId: String, requestId: String, filePath: String, options: ReadableMap?, promise: Promise) {
+    val inst = getInstance(instanceId) ?: run {
+      promise.reject("TRANSCRIBE_ERROR", "STT instance not found: $instanceId")
+      return
+    }
+    if (inst.recognizer == null) {
+      rejectNotLoaded(inst, "TRANSCRIBE_ERROR", promise)
+      return
+    }
+    val opts = options ?: Arguments.createMap()
+    val fields = resultFields(options)
+    val maxSegmentSeconds =
+      if (opts.hasKey("maxSegmentSeconds")) opts.getDouble("maxSegmentSeconds").toFloat().coerceAtLeast(1f) else 20f
+    val paddingMs = if (opts.hasKey("paddingMs")) opts.getDouble("paddingMs").coerceAtLeast(0.0) else 200.0
+    val maxBatchSize = if (opts.hasKey("maxBatchSize")) opts.getDouble("maxBatchSize").toInt().coerceAtLeast(1) else 8
+    val vadConfig = try {
+      buildVadConfig(opts, maxSegmentSeconds)
+    } catch (e: Exception) {
+      promise.reject("TRANSCRIBE_ERROR", e.message ?: "Invalid VAD options", e)
+      return
+    }
+    batchHandler.post {
+      val sampleRate = 16000
+      val temps = ArrayList<String>(2)
+      val scanReader = WavFileReader()
+      val rangeReader = WavFileReader()
+      val builder = SpeechRangeBuilder((paddingMs * sampleRate / 1000.0).toLong(), (maxSegmentSeconds * sampleRate).toLong())
+      val decoder = Executors.newSingleThreadExecutor()
+      var vad: Vad? = null
+      try {
+        val startNs = System.nanoTime()
+        var pathToRead = filePath
+        if (pathToRead.startsWith("content://")) {
+          pathToRead = resolveContentUriToFile(pathToRead, "stt_long")
+          temps.add(pathToRead)
+        }
+        if (!File(pathToRead).isFile) throw IllegalArgumentException("Audio file does not exist: $filePath")
+        // The VAD runs at 16 kHz; anything else (other rates, compressed formats) is converted once.
+        if (scanReader.open(pathToRead) != null || scanReader.sampleRate != sampleRate) {
+          val wavPath = File(context.cacheDir, "stt_long_${System.nanoTime()}.wav").absolutePath
+          temps.add(wavPath)
+          val err = SherpaOnnxModule.convertAudioFileToWav16k(pathToRead, wavPath)
+          if (err.isNotEmpty()) throw IllegalStateException("Could not convert $filePath to WAV: $err")
+          pathToRead = wavPath
+          scanReader.open(pathToRead)?.let { throw IllegalStateException(it) }
+        }
+        rangeReader.open(pathToRead)?.let { throw IllegalStateException(it) }
+        val totalFrames = scanReader.numFrames
+        val detector = Vad(config = vadConfig)
+        vad = detector
+
+        val segments = ArrayList<LongFormSegment>()
+        val window = ArrayList<SpeechRangeBuilder.Range>(maxBatchSize)
+        var inFlight: Future<List<LongFormSegment>>? = null
+        var decodeNs = 0L
+        var vadNs = 0L
+
+        // Runs on the decode thread; only that thread touches rangeReader.
+        fun decodeBatch(ranges: List<SpeechRangeBuilder.Range>): List<LongFormSegment> {
+          val decodeStart = System.nanoTime()
+          try {
+            val audio = ranges.map { rangeReader.read(it.start, (it.end - it.start).toInt()) }
+            val decoded = inst.withRecognizer { rec ->
+              val streams = ArrayList<OfflineStream>(ranges.size)
+              try {
+                for (samples in audio) {
+                  val stream = rec.createStream()
+                  streams.add(stream)
+                  stream.acceptWaveform(samples, sampleRate)
+                }
+                streams.map { stream ->
+                  rec.decode(stream)
+                  rec.getResult(stream)
+                }
+              } finally {
+                for (stream in streams) stream.release()
+              }
+            } ?: throw IllegalStateException("STT not initialized. Call initializeStt first.")
+            return ranges.indices.map { LongFormSegment(ranges[it], decoded[it], null) }
+          } catch (e: Exception) {
+            val message = e.message?.takeIf { it.isNotBlank() } ?: "Recognition failed"
+            Log.e(logTag, "transcribeLongFile batch failed: $message", e)
+            return ranges.map { LongFormSegment(it, null, message) }
+          } finally {
+            decodeNs += System.nanoTime() - decodeStart
+          }
+        }
+
+        fun collect() {
+          val done = inFlight?.get() ?: return
+          inFlight = null
+          for (segment in done) {
+            val item = Arguments.createMap()
+            item.putInt("index", segments.size)
+            item.putDouble("start", segment.range.start.toDouble() / sampleRate)
+            item.putDouble("end", segment.range.end.toDouble() / sampleRate)
+            item.putString("text", segment.result?.text?.trim().orEmpty())
+            item.putBoolean("success", segment.result != null)
+            segment.error?.let { item.putString("error", it) }
+            item.putDouble("progress", if (totalFrames > 0) segment.range.end.toDouble() / totalFrames else 1.0)
+            emitLongFormSegment(instanceId, requestId, item)
+            segments.add(segment)
+          }
+        }
+
+        fun submit(count: Int) {
+          val batch = ArrayList(window.subList(0, count))
+          window.subList(0, count).clear()
+          // At most one batch decoding while the next is collected: bounded memory.
+          collect()
+          inFlight = decoder.submit(Callable { decodeBatch(batch) })
+        }
+
+        fun enqueue(ranges: List<SpeechRangeBuilder.Range>) {
+          window.addAll(ranges)
+          while (window.size >= maxBatchSize) submit(maxBatchSize)
+        }
+
+        fun drainVad(v: Vad) {
+          while (!v.empty()) {
+            val segment = v.front()
+            v.pop()
+            enqueue(builder.push(segment.start.toLong(), segment.samples.size.toLong()))
+          }
+        }
+
+        var position = 0L
+        while (position < totalFrames) {
+          val block = scanReader.read(position, sampleRate)
+          if (block.isEmpty()) break
+          val vadStart = System.nanoTime()
+          detector.acceptWaveform(block)
+          vadNs += System.nanoTime() - vadStart
+          position += block.size
+          drainVad(detector)
+        }
+        detector.flush()
+        drainVad(detector)
+        enqueue(builder.finish(totalFrames))
+        if (window.isNotEmpty()) submit(window.size)
+        collect()
+
+        val texts = ArrayList<String>(segments.size)
+        val tokens = Arguments.createArray()
+        val timestamps = Arguments.createArray()
+        val durations = Arguments.createArray()
+        val segmentArray = Arguments.createArray()
+        var lang = ""
+        var emotion = ""
+        var event = ""
+        var speechFrames = 0L
+        var failed = 0
+        for (segment in segments) {
+          val offset = segment.range.start.toDouble() / sampleRate
+          speechFrames += segment.range.end - segment.range.start
+          val result = segment.result
+          if (result == null) {
+            failed++
+            continue
+          }
+          texts.add(result.text)
+          if (fields and RESULT_TOKENS != 0) for (t in result.tokens) tokens.pushString(t)
+          if (fields and RESULT_TIMESTAMPS != 0) for (t in result.timestamps) timestamps.pushDouble(t + offset)
+          if (fields and RESULT_DURATIONS != 0) for (d in result.durations) durations.pushDouble(d.toDouble())
+          if (lang.isEmpty()) lang = result.lang
+          if (emotion.isEmpty()) emotion = result.emotion
+          if (event.isEmpty()) event = result.event
+          val entry = Arguments.createMap()
+          entry.putDouble("start", offset)
+          entry.putDouble("end", segment.range.end.toDouble() / sampleRate)
+          entry.putString("text", result.text.trim())
+          segmentArray.pushMap(entry)
+        }
+        val audioMs = totalFrames * 1000.0 / sampleRate
+        val decodeMs = decodeNs / 1e6
+        val map = Arguments.createMap()
+        map.putString("text", SpeechRangeBuilder.joinTexts(texts))
+        if (fields and RESULT_TOKENS != 0) map.putArray("tokens", tokens)
+        if (fields and RESULT_TIMESTAMPS != 0) map.putArray("timestamps", timestamps)
+        if (fields and RESULT_LANG != 0) map.putString("lang", lang)
+        if (fields and RESULT_EMOTION != 0) map.putString("emotion", emotion)
+        if (fields and RESULT_EVENT != 0) map.putString("event", event)
+        if (fields and RESULT_DURATIONS != 0) map.putArray("durations", durations)
+        map.putArray("segments", segmentArray)
+        map.putInt("failedSegments", failed)
+        map.putDouble("audioMs", audioMs)
+        map.putDouble("speechMs", speechFrames * 1000.0 / sampleRate)
+        map.putDouble("vadMs", vadNs / 1e6)
+        map.putDouble("decodeMs", decodeMs)
+        map.putDouble("elapsedMs", (System.nanoTime() - startNs) / 1e6)
+        map.putDouble("realTimeFactor", if (audioMs > 0.0) decodeMs / audioMs else 0.0)
+        promise.resolve(map)
+      } catch (e: Exception) {
+        val message = e.message?.takeIf { it.isNotBlank() } ?: "Failed to transcribe file"
+        Log.e(logTag, "transcribeLongFile error: $message", e)
+        promise.reject("TRANSCRIBE_ERROR", message, e)
+      } finally {
+        decoder.shutdown()
+        try {
+          decoder.awaitTermination(1, java.util.concurrent.TimeUnit.MINUTES)
+        } catch (_: InterruptedException) { }
+        vad?.release()
+        builder.release()
+        scanReader.release()
+        rangeReader.release()
+        for (temp in temps) {
+          try {
+            File(temp).delete()
+          } catch (_: Exception) { }
+        }
+      }
+    }
+  }
+
   fun setSttConfig(instanceId: String, options: ReadableMap, promise: Promise) {
     try {
       val inst = getInstance(instanceId) ?: run {
         promise.reject("CONFIG_ERROR", "STT instance not found: $instanceId")
         return
       }
-      val rec = inst.recognizer
       val current = inst.lastRecognizerConfig
-      if (rec == null || current == null) {
-        promise.reject("CONFIG_ERROR", "STT not initialized. Call initializeStt first.")
+      if (inst.recognizer == null || current == null) {
+        rejectNotLoaded(inst, "CONFIG_ERROR", promise)
         return
       }
       val merged = current.copy(
@@ -452,12 +1417,19 @@ internal class SherpaOnnxSttHelper(
           Log.e(logTag, errorMsg, e)
           promise.reject("INVALID_HOTWORDS_FILE", errorMsg, e)
           return
-        }.also { path ->
-          validateHotwordsFile(path)?.let { errorMsg ->
-            Log.e(logTag, errorMsg)
-            promise.reject("INVALID_HOTWORDS_FILE", errorMsg)
+        }.let { path ->
+          val compiled = compileHotwordsFile(
+            path,
+            current.modelConfig.tokens,
+            current.modelConfig.bpeVocab,
+            current.modelConfig.modelingUnit
+          )
+          if (!compiled.ok) {
+            Log.e(logTag, compiled.error)
+            promise.reject("INVALID_HOTWORDS_FILE", compiled.error)
             return
           }
+          compiled.output
         }
       } else ""
       val configWithPaths = merged.copy(
@@ -471,8 +1443,9 @@ internal class SherpaOnnxSttHelper(
           maxActivePaths = maxOf(4, configWithPaths.maxActivePaths)
         )
       } else configWithPaths
+      // Applied now so errors surface here; other holders of a shared recognizer re-apply their own before decoding.
       inst.lastRecognizerConfig = configToApply
-      rec.setConfig(configToApply)
+      inst.withRecognizer { }
       promise.resolve(null)
     } catch (e: Exception) {
       val message = e.message?.takeIf { it.isNotBlank() } ?: "Failed to set STT config"
@@ -481,30 +1454,54 @@ internal class SherpaOnnxSttHelper(
     }
   }
 
-  private fun resultToWritableMap(result: OfflineRecognizerResult): WritableMap {
+  /** Only the fields in [fields] (RESULT_* mask) are marshalled; text always is. */
+  private fun resultToWritableMap(result: OfflineRecognizerResult, fields: Int = RESULT_ALL): WritableMap {
     val map = Arguments.createMap()
     map.putString("text", result.text)
-    val tokensArray = Arguments.createArray()
-    for (t in result.tokens) tokensArray.pushString(t)
-    map.putArray("tokens", tokensArray)
-    val timestampsArray = Arguments.createArray()
-    for (t in result.timestamps) timestampsArray.pushDouble(t.toDouble())
-    map.putArray("timestamps", timestampsArray)
-    map.putString("lang", result.lang)
-    map.putString("emotion", result.emotion)
-    map.putString("event", result.event)
-    val durationsArray = Arguments.createArray()
-    for (d in result.durations) durationsArray.pushDouble(d.toDouble())
-    map.putArray("durations", durationsArray)
+    if (fields and RESULT_TOKENS != 0) {
+      val tokensArray = Arguments.createArray()
+      for (t in result.tokens) tokensArray.pushString(t)
+      map.putArray("tokens", tokensArray)
+    }
+    if (fields and RESULT_TIMESTAMPS != 0) {
+      val timestampsArray = Arguments.createArray()
+      for (t in result.timestamps) timestampsArray.pushDouble(t.toDouble())
+      map.putArray("timestamps", timestampsArray)
+    }
+    if (fields and RESULT_LANG != 0) map.putString("lang", result.lang)
+    if (fields and RESULT_EMOTION != 0) map.putString("emotion", result.emotion)
+    if (fields and RESULT_EVENT != 0) map.putString("event", result.event)
+    if (fields and RESULT_DURATIONS != 0) {
+      val durationsArray = Arguments.createArray()
+      for (d in result.durations) durationsArray.pushDouble(d.toDouble())
+      map.putArray("durations", durationsArray)
+    }
     return map
   }
 
+  /**
+   * Resolve with the initializeStt result (including loadTimings) once the recognizer of
+   * [instanceId] is loaded, or reject with the load error. Settles immediately when already done.
+   */
+  fun waitForSttReady(instanceId: String, promise: Promise) {
+    val inst = getInstance(instanceId) ?: run {
+      promise.reject("INIT_ERROR", "STT instance not found: $instanceId")
+      return
+    }
+    val load = inst.load ?: run {
+      promise.reject("INIT_ERROR", "STT not initialized. Call initializeStt first.")
+      return
+    }
+    load.await(promise)
+  }
+
   fun unloadStt(instanceId: String, promise: Promise) {
     try {
       val inst = instances.remove(instanceId)
       if (inst != null) {
-        inst.recognizer?.release()
-        inst.recognizer = null
+        // A load still running releases its recognizer when it sees the instance is gone.
+        inst.load?.fail("INIT_ERROR", "STT instance was unloaded while loading")
+        inst.releaseRecognizer()
         inst.lastRecognizerConfig = null
         inst.currentSttModelType = null
       }
@@ -35,18 +35,53 @@ import java.io.FileInputStream
 import java.io.FileOutputStream
 import java.io.InputStream
 import java.io.OutputStream
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
 import java.util.concurrent.ConcurrentHashMap
 import java.util.concurrent.Executors
+import java.util.concurrent.LinkedBlockingQueue
+import java.util.concurrent.TimeUnit
 import java.util.concurrent.atomic.AtomicBoolean
 
 internal class SherpaOnnxTtsHelper(
   private val context: ReactApplicationContext,
   private val detectTtsModel: (modelDir: String, modelType: String) -> HashMap<String, Any>?,
-  private val emitChunk: (String, String, FloatArray, Int, Float, Boolean) -> Unit,
+  private val emitChunk: (String, String, FloatArray, Int, Int, Float, Boolean) -> Unit,
   private val emitError: (String, String, String) -> Unit,
-  private val emitEnd: (String, String, Boolean) -> Unit
+  private val emitEnd: (String, String, Boolean, Long, Long, WritableMap?) -> Unit,
+  private val emitExportProgress: (String, String, WritableMap) -> Unit
 ) {
 
+  companion object {
+    /** Loaded engines shared across instance ids (and module instances) by model and load config. */
+    private val engineRegistry = SharedEngineRegistry<TtsEngines>("SherpaOnnxTts") { engines ->
+      engines.tts?.release()
+      engines.zipvoice?.release()
+    }
+
+    /** Zipvoice step calibration: SharedPreferences file, default sentence and the two step counts timed. */
+    private const val STEP_CALIBRATION_PREFS = "sherpaonnx_zipvoice_steps"
+    private const val STEP_CALIBRATION_TEXT =
+      "The quick brown fox jumps over the lazy dog, then rests for a while in the shade."
+    private const val CALIBRATION_STEPS_LO = 4
+    private const val CALIBRATION_STEPS_HI = 16
+  }
+
+  /** The engine behind a shared handle: exactly one of [tts] / [zipvoice] is set. */
+  private class TtsEngines(val tts: OfflineTts?, val zipvoice: ZipvoiceTtsWrapper?)
+
+  /**
+   * Text input of a running text stream (startTtsTextStream): fragments are cut into segments by
+   * [segmenter] on the caller's thread and queued for the stream thread in order; an empty string
+   * (segments are never empty) ends the stream.
+   */
+  private class TtsTextSession(val requestId: String, val segmenter: TtsTextSegmenter) {
+    val segments = LinkedBlockingQueue<String>()
+    @Volatile var closed = false
+    /** First pushText call, for time to first audio. */
+    @Volatile var firstTextNs = 0L
+  }
+
   private data class TtsInitState(
     val modelDir: String,
     val modelType: String,
@@ -63,30 +98,134 @@ internal class SherpaOnnxTtsHelper(
   )
 
   private data class TtsEngineInstance(
-    @Volatile var tts: OfflineTts? = null,
-    @Volatile var zipvoiceTts: ZipvoiceTtsWrapper? = null,
+    /** Also scopes the voice prompts this instance registers on the shared Zipvoice engine. */
+    val instanceId: String,
+    @Volatile var engine: SharedEngineRegistry.Handle<TtsEngines>? = null,
     var ttsInitState: TtsInitState? = null,
     val ttsStreamRunning: AtomicBoolean = AtomicBoolean(false),
     val ttsStreamCancelled: AtomicBoolean = AtomicBoolean(false),
     var ttsStreamThread: Thread? = null,
-    var ttsPcmTrack: AudioTrack? = null
+    @Volatile var ttsStreamTicket: Long = 0L,
+    /** Set while the running stream is a text session fed by pushTtsText. */
+    @Volatile var ttsTextSession: TtsTextSession? = null,
+    var ttsPcmTrack: AudioTrack? = null,
+    /** Jitter buffer feeding ttsPcmTrack from ttsPlaybackThread (startTtsPcmPlayer). */
+    var ttsPlayback: TtsPlaybackBuffer? = null,
+    var ttsPlaybackThread: Thread? = null,
+    /** Player speed (setTtsPcmPlayerTempo); kept across player restarts. */
+    @Volatile var ttsPlayerTempo: Float = 1f,
+    @Volatile var audioCache: TtsAudioCache? = null,
+    @Volatile var modelFingerprint: String? = null,
+    private var chunkPlanner: TtsFirstChunkPlanner? = null,
+    /** Per-request measurements of every generation on this instance (getTtsStats). */
+    val stats: TtsStatsRecorder = TtsStatsRecorder()
   ) {
     private val lock = Any()
 
-    fun hasEngine(): Boolean = synchronized(lock) { tts != null || zipvoiceTts != null }
-    val isZipvoice: Boolean get() = synchronized(lock) { zipvoiceTts != null }
+    val tts: OfflineTts? get() = engine?.engine?.tts
+    val zipvoiceTts: ZipvoiceTtsWrapper? get() = engine?.engine?.zipvoice
+
+    /**
+     * Run [block] holding the shared engine's lock; other instances may be using the same engine.
+     * Waits for [ticket]'s turn in the engine's scheduler first (0 = a one-off normal-priority
+     * request). Throws [EngineScheduler.RequestStoppedException] if it is cancelled or expires
+     * while queued. [request]'s clock starts once the engine is held.
+     */
+    inline fun <T> withEngineLock(
+      ticket: Long = 0L,
+      request: TtsStatsRecorder.Request? = null,
+      block: () -> T
+    ): T {
+      val handle = engine ?: return block()
+      val scheduler = handle.scheduler
+      val id = if (ticket != 0L) ticket else scheduler.submit(EngineScheduler.PRIORITY_NORMAL)
+      try {
+        return scheduler.withSlot(id) {
+          synchronized(handle.lock) {
+            request?.engineAcquired()
+            block()
+          }
+        }
+      } finally {
+        if (ticket == 0L) scheduler.finish(id)
+      }
+    }
+
+    /** Queue a request on the shared engine's scheduler; returns 0 when no engine is loaded. */
+    fun submitRequest(priority: Int, deadlineMs: Long): Long =
+      engine?.scheduler?.submit(priority, deadlineMs) ?: 0L
+
+    /** True when [ticket] was cancelled or passed its deadline. */
+    fun requestStopped(ticket: Long): Boolean = engine?.scheduler?.shouldStop(ticket) ?: false
+
+    fun cancelRequest(ticket: Long) {
+      engine?.scheduler?.cancel(ticket)
+    }
+
+    /** Forget [ticket]; returns how long it waited for the engine in ms. */
+    fun finishRequest(ticket: Long): Long = engine?.scheduler?.finish(ticket) ?: 0L
+
+    // Read the volatile [engine] without [lock]: generation calls these while holding the engine's
+    // lock, and [releaseEngines] must never wait for that lock while holding [lock].
+    fun hasEngine(): Boolean = tts != null || zipvoiceTts != null
+    val isZipvoice: Boolean get() = zipvoiceTts != null
     val isPocket: Boolean get() = ttsInitState?.modelType == "pocket"
     fun releaseEngines() {
-      synchronized(lock) {
-        tts?.release()
-        tts = null
-        zipvoiceTts?.release()
-        zipvoiceTts = null
+      val released = synchronized(lock) {
+        val handle = engine
+        engine = null
         ttsInitState = null
+        modelFingerprint = null
+        // Its cost estimate belongs to the released engine.
+        chunkPlanner?.release()
+        chunkPlanner = null
+        handle
+      } ?: return
+      // Outside [lock]: the last release waits for the engine's lock to finish an in-flight call.
+      // The engine may stay loaded for other instances; this instance's prompts go now.
+      released.engine.zipvoice?.unregisterPrompts(instanceId)
+      engineRegistry.release(released)
+    }
+    /** Planner for the first-chunk fast path, created on first use; null when no engine is loaded. */
+    fun firstChunkPlanner(): TtsFirstChunkPlanner? {
+      synchronized(lock) {
+        if (tts == null && zipvoiceTts == null) return null
+        return chunkPlanner ?: TtsFirstChunkPlanner().also { chunkPlanner = it }
+      }
+    }
+    private var chunkRingRate = 0
+    private var chunkRing: PcmRingBuffer? = null
+    /** Array [chunkRing] chunks are read into; same lifetime and locking as the ring. */
+    var chunkScratch = FloatArray(0)
+      private set
+
+    /**
+     * Zipvoice chunk ring (one second at [sampleRate]) shared by every streamPiece on this
+     * instance, reset for the next producer. Only use it inside [withEngineLock].
+     */
+    fun chunkRing(sampleRate: Int): PcmRingBuffer {
+      val ring = chunkRing?.takeIf { chunkRingRate == sampleRate }
+        ?: PcmRingBuffer(sampleRate).also {
+          chunkRing = it
+          chunkRingRate = sampleRate
+          chunkScratch = FloatArray(it.capacity)
+        }
+      ring.reset()
+      return ring
+    }
+    fun releaseAudioCache() {
+      synchronized(lock) {
+        audioCache?.release()
+        audioCache = null
       }
     }
     fun stopPcmPlayer() {
       synchronized(lock) {
+        // Closing the buffer ends the player thread after its current frame.
+        ttsPlayback?.release()
+        ttsPlayback = null
+        ttsPlaybackThread?.join(500)
+        ttsPlaybackThread = null
         ttsPcmTrack?.apply {
           try { stop() } catch (_: IllegalStateException) {}
           flush()
@@ -131,6 +270,7 @@ internal class SherpaOnnxTtsHelper(
     }
     instances.values.forEach { inst ->
       inst.releaseEngines()
+      inst.releaseAudioCache()
       inst.stopPcmPlayer()
     }
     instances.clear()
@@ -150,6 +290,7 @@ internal class SherpaOnnxTtsHelper(
     maxNumSentences: Double?,
     silenceScale: Double?,
     provider: String?,
+    warmUp: Boolean?,
     promise: Promise
   ) {
     ttsInitExecutor.execute init@{
@@ -171,12 +312,28 @@ internal class SherpaOnnxTtsHelper(
       val modelTypeStr = result["modelType"] as? String ?: "vits"
       val detectedModels = result["detectedModels"] as? ArrayList<*>
 
-      val inst = instances.getOrPut(instanceId) { TtsEngineInstance() }
+      val inst = instances.getOrPut(instanceId) { TtsEngineInstance(instanceId) }
       inst.stopPcmPlayer()
       inst.releaseEngines()
 
-      val sampleRate: Int
-      val numSpeakers: Int
+      val initState = TtsInitState(
+        modelDir,
+        modelTypeStr,  // detected model type (e.g. "pocket"), not the requested "auto"
+        numThreads.toInt(),
+        debug,
+        noiseScale?.takeUnless { it.isNaN() },
+        noiseScaleW?.takeUnless { it.isNaN() },
+        lengthScale?.takeUnless { it.isNaN() },
+        ruleFsts?.takeIf { it.isNotBlank() },
+        ruleFars?.takeIf { it.isNotBlank() },
+        maxNumSentences?.toInt()?.takeIf { it > 0 },
+        silenceScale?.takeUnless { it.isNaN() },
+        provider?.takeIf { it.isNotBlank() }
+      )
+      val fingerprint = fingerprintFor(initState)
+      val key = engineKeyFor(initState, fingerprint)
+      // True when another instance already holds this model with the same config and its engine is shared.
+      val reused: Boolean
 
       if (modelTypeStr == "zipvoice") {
         val vocoderPath = path(paths, "vocoder")
@@ -187,66 +344,79 @@ internal class SherpaOnnxTtsHelper(
           return@init
         }
         val am = context.applicationContext.getSystemService(Context.ACTIVITY_SERVICE) as? ActivityManager
-        if (am != null) {
-          val memInfo = ActivityManager.MemoryInfo()
-          am.getMemoryInfo(memInfo)
-          val availMb = memInfo.availMem / (1024 * 1024)
-          if (memInfo.availMem < 800L * 1024 * 1024) {
-            val msg = "Not enough free memory to load the Zipvoice model (available: ${availMb} MB). Close other apps to free memory or use a smaller Zipvoice model that includes all required components (encoder, decoder, and vocoder)."
-            Log.e("SherpaOnnxTts", "TTS_INIT_ERROR: $msg")
-            rejectOnUiThread(promise, "TTS_INIT_ERROR", msg)
-            return@init
+        // Set when the load is skipped for lack of memory (a shared engine needs none).
+        var lowMemoryMsg: String? = null
+        val acquired = engineRegistry.acquire(key) {
+          if (am != null) {
+            val memInfo = ActivityManager.MemoryInfo()
+            am.getMemoryInfo(memInfo)
+            val availMb = memInfo.availMem / (1024 * 1024)
+            if (memInfo.availMem < 800L * 1024 * 1024) {
+              lowMemoryMsg = "Not enough free memory to load the Zipvoice model (available: ${availMb} MB). Close other apps to free memory or use a smaller Zipvoice model that includes all required components (encoder, decoder, and vocoder)."
+              return@acquire null
+            }
           }
+          // Hint GC before heavy allocation to reduce memory pressure; zipvoice always uses 1 thread to limit peak RAM.
+          System.gc()
+          if (am != null) {
+            val memInfoBefore = ActivityManager.MemoryInfo()
+            am.getMemoryInfo(memInfoBefore)
+            Log.i("SherpaOnnxTts", "Zipvoice init: availMem=${memInfoBefore.availMem / (1024 * 1024)} MB (before load)")
+          }
+          val zipvoiceNumThreads = 1
+          val wrapper = ZipvoiceTtsWrapper.create(
+            tokens = path(paths, "tokens"),
+            encoder = path(paths, "encoder"),
+            decoder = path(paths, "decoder"),
+            vocoder = vocoderPath,
+            dataDir = path(paths, "dataDir"),
+            lexicon = path(paths, "lexicon"),
+            numThreads = zipvoiceNumThreads,
+            debug = debug,
+            ruleFsts = ruleFsts?.takeIf { it.isNotBlank() } ?: "",
+            ruleFars = ruleFars?.takeIf { it.isNotBlank() } ?: "",
+            maxNumSentences = maxNumSentences?.toInt()?.coerceAtLeast(1) ?: 1,
+            silenceScale = silenceScale?.toFloat()?.coerceIn(0f, 10f) ?: 0.2f,
+            provider = provider?.takeIf { it.isNotBlank() } ?: "cpu"
+          )
+          if (am != null) {
+            val memInfo = ActivityManager.MemoryInfo()
+            am.getMemoryInfo(memInfo)
+            Log.i("SherpaOnnxTts", "Zipvoice init: availMem=${memInfo.availMem / (1024 * 1024)} MB (after load)")
+          }
+          // A calibration recorded for this model and config on an earlier launch applies again.
+          wrapper?.let { restoreStepCalibration(key, it) }
+          wrapper?.let { TtsEngines(null, it) }
         }
-        // Hint GC before heavy allocation to reduce memory pressure; zipvoice always uses 1 thread to limit peak RAM.
-        System.gc()
-        if (am != null) {
-          val memInfoBefore = ActivityManager.MemoryInfo()
-          am.getMemoryInfo(memInfoBefore)
-          Log.i("SherpaOnnxTts", "Zipvoice init: availMem=${memInfoBefore.availMem / (1024 * 1024)} MB (before load)")
-        }
-        val zipvoiceNumThreads = 1
-        val wrapper = ZipvoiceTtsWrapper.create(
-          tokens = path(paths, "tokens"),
-          encoder = path(paths, "encoder"),
-          decoder = path(paths, "decoder"),
-          vocoder = vocoderPath,
-          dataDir = path(paths, "dataDir"),
-          lexicon = path(paths, "lexicon"),
-          numThreads = zipvoiceNumThreads,
-          debug = debug,
-          ruleFsts = ruleFsts?.takeIf { it.isNotBlank() } ?: "",
-          ruleFars = ruleFars?.takeIf { it.isNotBlank() } ?: "",
-          maxNumSentences = maxNumSentences?.toInt()?.coerceAtLeast(1) ?: 1,
-          silenceScale = silenceScale?.toFloat()?.coerceIn(0f, 10f) ?: 0.2f,
-          provider = provider?.takeIf { it.isNotBlank() } ?: "cpu"
-        )
-        if (am != null) {
-          val memInfo = ActivityManager.MemoryInfo()
-          am.getMemoryInfo(memInfo)
-          Log.i("SherpaOnnxTts", "Zipvoice init: availMem=${memInfo.availMem / (1024 * 1024)} MB (after load)")
+        inst.engine = acquired?.handle
+        reused = acquired?.reused ?: false
+        lowMemoryMsg?.let { msg ->
+          Log.e("SherpaOnnxTts", "TTS_INIT_ERROR: $msg")
+          rejectOnUiThread(promise, "TTS_INIT_ERROR", msg)
+          return@init
         }
-        if (wrapper == null) {
+        if (inst.engine == null) {
           Log.e("SherpaOnnxTts", "TTS_INIT_ERROR: Failed to create Zipvoice TTS engine via C-API. Check logcat for details.")
           rejectOnUiThread(promise, "TTS_INIT_ERROR", "Failed to create Zipvoice TTS engine via C-API. Check logcat for details.")
           return@init
         }
-        inst.zipvoiceTts = wrapper
-        sampleRate = wrapper.sampleRate()
-        numSpeakers = wrapper.numSpeakers()
       } else {
-        val config = buildTtsConfig(
-          paths, modelTypeStr, numThreads.toInt(), debug,
-          noiseScale, noiseScaleW, lengthScale,
-          ruleFsts, ruleFars, maxNumSentences?.toInt(), silenceScale,
-          provider
-        )
-        inst.tts = OfflineTts(config = config)
-        sampleRate = inst.tts!!.sampleRate()
-        numSpeakers = inst.tts!!.numSpeakers()
+        val acquired = engineRegistry.acquire(key) {
+          val config = buildTtsConfig(
+            paths, modelTypeStr, numThreads.toInt(), debug,
+            noiseScale, noiseScaleW, lengthScale,
+            ruleFsts, ruleFars, maxNumSentences?.toInt(), silenceScale,
+            provider
+          )
+          TtsEngines(OfflineTts(config = config), null)
+        }
+        inst.engine = acquired?.handle
+        reused = acquired?.reused ?: false
       }
+      val sampleRate = dispatchSampleRate(inst)
+      val numSpeakers = dispatchNumSpeakers(inst)
 
-      Log.i("SherpaOnnxTts", "initializeTts: instanceId=$instanceId, engine=${if (inst.isZipvoice) "zipvoice-c-api" else "kotlin-api"}, sampleRate=$sampleRate, numSpeakers=$numSpeakers")
+      Log.i("SherpaOnnxTts", "initializeTts: instanceId=$instanceId, engine=${if (inst.isZipvoice) "zipvoice-c-api" else "kotlin-api"}, shared=$reused, sampleRate=$sampleRate, numSpeakers=$numSpeakers")
 
       val modelsArray = Arguments.createArray()
       detectedModels?.forEach { modelObj ->
@@ -258,26 +428,19 @@ internal class SherpaOnnxTtsHelper(
         }
       }
 
-      inst.ttsInitState = TtsInitState(
-        modelDir,
-        modelTypeStr,  // detected model type (e.g. "pocket"), not the requested "auto"
-        numThreads.toInt(),
-        debug,
-        noiseScale?.takeUnless { it.isNaN() },
-        noiseScaleW?.takeUnless { it.isNaN() },
-        lengthScale?.takeUnless { it.isNaN() },
-        ruleFsts?.takeIf { it.isNotBlank() },
-        ruleFars?.takeIf { it.isNotBlank() },
-        maxNumSentences?.toInt()?.takeIf { it > 0 },
-        silenceScale?.takeUnless { it.isNaN() },
-        provider?.takeIf { it.isNotBlank() }
-      )
+      inst.ttsInitState = initState
+      inst.modelFingerprint = fingerprint
+
+      // Pocket needs reference audio for every generation, so there is nothing to warm up with.
+      // A shared engine is already warm.
+      val warmUpMs = if (warmUp == true && !reused && modelTypeStr != "pocket") warmUpEngine(inst) else -1L
 
       val resultMap = Arguments.createMap()
       resultMap.putBoolean("success", true)
       resultMap.putArray("detectedModels", modelsArray)
       resultMap.putInt("sampleRate", sampleRate)
       resultMap.putInt("numSpeakers", numSpeakers)
+      if (warmUpMs >= 0) resultMap.putDouble("warmUpMs", warmUpMs.toDouble())
       resolveOnUiThread(promise, resultMap)
     } catch (e: Exception) {
       Log.e("SherpaOnnxTts", "TTS_INIT_ERROR: Failed to initialize TTS: ${e.message}", e)
@@ -286,6 +449,30 @@ internal class SherpaOnnxTtsHelper(
     }
   }
 
+  /**
+   * Run one short synthesis on the init thread and drop the result. Returns elapsed ms, or -1
+   * if it failed (a failed warm-up is logged but does not fail init).
+   */
+  private fun warmUpEngine(inst: TtsEngineInstance): Long {
+    return try {
+      inst.withEngineLock {
+        val zipvoice = inst.zipvoiceTts
+        if (zipvoice != null) {
+          zipvoice.warmUp()
+        } else {
+          val start = System.nanoTime()
+          inst.tts?.generate("Hello.", 0, 1.0f)
+          val ms = (System.nanoTime() - start) / 1_000_000
+          Log.i("SherpaOnnxTts", "TTS warm-up: $ms ms")
+          ms
+        }
+      }
+    } catch (e: Exception) {
+      Log.w("SherpaOnnxTts", "TTS warm-up failed: ${e.message}")
+      -1L
+    }
+  }
+
   fun updateTtsParams(
     instanceId: String,
     noiseScale: Double?,
@@ -316,6 +503,7 @@ internal class SherpaOnnxTtsHelper(
         noiseScale, noiseScaleW, lengthScale,
         state.ruleFsts, state.ruleFars, state.maxNumSentences?.toDouble(), state.silenceScale,
         state.provider,
+        false,
         promise
       )
       return
@@ -347,15 +535,24 @@ internal class SherpaOnnxTtsHelper(
       val modelTypeStr = result["modelType"] as? String ?: state.modelType
       val detectedModels = result["detectedModels"] as? ArrayList<*>
 
-      inst.tts?.release()
-      inst.tts = null
-      val config = buildTtsConfig(
-        paths, modelTypeStr, state.numThreads, state.debug,
-        nextNoiseScale, nextNoiseScaleW, nextLengthScale,
-        state.ruleFsts, state.ruleFars, state.maxNumSentences, state.silenceScale,
-        state.provider
+      val nextState = state.copy(
+        noiseScale = nextNoiseScale,
+        noiseScaleW = nextNoiseScaleW,
+        lengthScale = nextLengthScale
       )
-      inst.tts = OfflineTts(config = config)
+      val fingerprint = fingerprintFor(nextState)
+      // Drop this instance's reference first so an unshared engine is freed before the reload.
+      inst.engine?.let { engineRegistry.release(it) }
+      inst.engine = null
+      inst.engine = engineRegistry.acquire(engineKeyFor(nextState, fingerprint)) {
+        val config = buildTtsConfig(
+          paths, modelTypeStr, state.numThreads, state.debug,
+          nextNoiseScale, nextNoiseScaleW, nextLengthScale,
+          state.ruleFsts, state.ruleFars, state.maxNumSentences, state.silenceScale,
+          state.provider
+        )
+        TtsEngines(OfflineTts(config = config), null)
+      }?.handle
       val ttsInstance = inst.tts!!
 
       val modelsArray = Arguments.createArray()
@@ -368,11 +565,8 @@ internal class SherpaOnnxTtsHelper(
         }
       }
 
-      inst.ttsInitState = state.copy(
-        noiseScale = nextNoiseScale,
-        noiseScaleW = nextNoiseScaleW,
-        lengthScale = nextLengthScale
-      )
+      inst.ttsInitState = nextState
+      inst.modelFingerprint = fingerprint
 
       val resultMap = Arguments.createMap()
       resultMap.putBoolean("success", true)
@@ -400,43 +594,106 @@ internal class SherpaOnnxTtsHelper(
       }
       val sid = getSid(options)
       val speed = getSpeed(options)
-      val audio = when {
-        hasReferenceOptions(options) && inst.isZipvoice -> {
-          val refAudio = options?.getArray("referenceAudio")
-            ?: run {
-              Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: referenceAudio required for Zipvoice voice cloning")
-              promise.reject("TTS_GENERATE_ERROR", "referenceAudio required for Zipvoice voice cloning")
-              return
-            }
-          val promptSr = if (options.hasKey("referenceSampleRate")) options.getDouble("referenceSampleRate").toInt() else 0
-          val promptText = options.getString("referenceText").orEmpty()
-          val numSteps = if (options.hasKey("numSteps")) options.getDouble("numSteps").toInt() else 20
-          val samples = FloatArray(refAudio.size()) { i -> refAudio.getDouble(i).toFloat() }
-          inst.zipvoiceTts!!.generateWithZipvoice(text, promptText, samples, promptSr, speed, numSteps)
-        }
-        hasReferenceOptions(options) && inst.tts != null -> {
-          val config = parseGenerationConfig(options) ?: GenerationConfig(speed = speed, sid = sid)
-          inst.tts!!.generateWithConfig(text, config)
-        }
-        inst.isPocket && !hasReferenceOptions(options) -> {
-          Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: Pocket TTS requires reference audio for voice cloning")
-          promise.reject("TTS_GENERATE_ERROR", "Pocket TTS requires reference audio for voice cloning. Pass referenceAudio and referenceSampleRate in options.")
-          return
-        }
-        else -> dispatchGenerate(inst, text, sid, speed)
-          ?: run {
+      val cacheKey = audioCacheKey(inst, text, sid, speed, options)
+      val cached = cacheKey?.let { inst.audioCache?.get(it) }
+      val request = inst.stats.begin()
+      val ticket = if (cached == null) submitTtsRequest(inst, options) else 0L
+      var stopped = false
+      var queueWaitMs = 0L
+      var stepPlan: ZipvoiceStepPlan? = null
+      // Batch requests take the engine one sentence at a time, as in generateTtsStream, so an
+      // interactive request on the same engine waits for one sentence rather than the whole text.
+      val sentences = if (cached == null && canGenerateBySentence(inst, options) &&
+        inst.engine?.scheduler?.priorityOf(ticket) == EngineScheduler.PRIORITY_BATCH
+      ) TtsFirstChunkPlanner.splitSentences(text) else listOf(text)
+      val audio = try {
+        if (cached != null) {
+          cached
+        } else if (sentences.size > 1) {
+          val config = if (hasReferenceOptions(options) && inst.tts != null) {
+            parseGenerationConfig(options) ?: GenerationConfig(speed = speed, sid = sid)
+          } else null
+          generateBySentence(inst, sentences, sid, speed, config, ticket, request) ?: run {
             Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: TTS not initialized")
             promise.reject("TTS_GENERATE_ERROR", "TTS not initialized")
             return
           }
+        } else inst.withEngineLock(ticket, request) { when {
+          getPromptId(options) != null && inst.isZipvoice -> {
+            val zipvoice = inst.zipvoiceTts!!
+            val promptId = getPromptId(options)!!
+            val prompt = zipvoice.promptInfo(inst.instanceId, promptId)
+            val plan = planZipvoiceSteps(zipvoice, text, prompt?.second ?: 0, prompt?.first ?: 0.0, speed, options)
+            stepPlan = plan
+            runPlannedZipvoice(zipvoice, plan) { steps -> zipvoice.generateWithPrompt(inst.instanceId, text, promptId, speed, steps) }
+          }
+          hasReferenceOptions(options) && inst.isZipvoice -> {
+            val refAudio = options?.getArray("referenceAudio")
+              ?: run {
+                Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: referenceAudio required for Zipvoice voice cloning")
+                promise.reject("TTS_GENERATE_ERROR", "referenceAudio required for Zipvoice voice cloning")
+                return
+              }
+            val promptSr = if (options.hasKey("referenceSampleRate")) options.getDouble("referenceSampleRate").toInt() else 0
+            val promptText = options.getString("referenceText").orEmpty()
+            val samples = FloatArray(refAudio.size()) { i -> refAudio.getDouble(i).toFloat() }
+            val zipvoice = inst.zipvoiceTts!!
+            val promptSeconds = if (promptSr > 0) samples.size.toDouble() / promptSr else 0.0
+            val plan = planZipvoiceSteps(zipvoice, text, utf8Length(promptText), promptSeconds, speed, options)
+            stepPlan = plan
+            runPlannedZipvoice(zipvoice, plan) { steps ->
+              zipvoice.generateWithZipvoice(text, promptText, samples, promptSr, speed, steps)
+            }
+          }
+          hasReferenceOptions(options) && inst.tts != null -> {
+            val config = parseGenerationConfig(options) ?: GenerationConfig(speed = speed, sid = sid)
+            inst.tts!!.generateWithConfig(text, config)
+          }
+          inst.isPocket && !hasReferenceOptions(options) -> {
+            Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: Pocket TTS requires reference audio for voice cloning")
+            promise.reject("TTS_GENERATE_ERROR", "Pocket TTS requires reference audio for voice cloning. Pass referenceAudio and referenceSampleRate in options.")
+            return
+          }
+          inst.isZipvoice && getParallelSentences(options) > 1 ->
+            inst.zipvoiceTts!!.generateParallel(text, sid, speed, getParallelSentences(options), getSentenceSilenceMs(options))
+          else -> dispatchGenerate(inst, text, sid, speed)
+            ?: run {
+              Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: TTS not initialized")
+              promise.reject("TTS_GENERATE_ERROR", "TTS not initialized")
+              return
+            }
+        } }
+      } catch (e: EngineScheduler.RequestStoppedException) {
+        rejectStoppedRequest(promise, e)
+        return
+      } finally {
+        stopped = inst.requestStopped(ticket)
+        queueWaitMs = inst.finishRequest(ticket)
+      }
+      if (stopped) {
+        rejectStoppedRequest(promise, EngineScheduler.RequestStoppedException(expired = true))
+        return
       }
+      // Audio generated by sentence pauses differently from the one-shot result the key stands for.
+      if (cached == null && cacheKey != null && sentences.size == 1) {
+        inst.audioCache?.put(cacheKey, audio.samples, audio.sampleRate)
+      }
+      // The cache holds tempo-1 audio; tempo is applied afterwards so every tempo shares an entry.
+      val tempo = getTempo(options)
+      val samples = TtsTimeStretcher.stretch(audio.samples, audio.sampleRate, tempo)
+      // Generated audio crosses JNI once, then the bridge; a cache hit only the bridge.
+      val stretchCopies = if (samples !== audio.samples) 1 else 0
+      request.chunk(samples.size, copies = (if (cached != null) 1 else 2) + stretchCopies)
       val map = Arguments.createMap()
       val samplesArray = Arguments.createArray()
-      for (sample in audio.samples) {
+      for (sample in samples) {
         samplesArray.pushDouble(sample.toDouble())
       }
       map.putArray("samples", samplesArray)
       map.putInt("sampleRate", audio.sampleRate)
+      map.putDouble("queueWaitMs", queueWaitMs.toDouble())
+      stepPlan?.let { putStepPlan(map, it) }
+      request.finish(samples.size.toLong(), audio.sampleRate)?.let { map.putMap("stats", it) }
       promise.resolve(map)
     } catch (e: Exception) {
       Log.e("SherpaOnnxTts", "generateTts error: ${e.message}", e)
@@ -458,46 +715,79 @@ internal class SherpaOnnxTtsHelper(
       }
       val sid = getSid(options)
       val speed = getSpeed(options)
-      val audio = when {
-        hasReferenceOptions(options) && inst.isZipvoice -> {
-          val refAudio = options?.getArray("referenceAudio")
-            ?: run {
-              Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: referenceAudio required for Zipvoice voice cloning")
-              promise.reject("TTS_GENERATE_ERROR", "referenceAudio required for Zipvoice voice cloning")
-              return
+      val request = inst.stats.begin()
+      val ticket = submitTtsRequest(inst, options)
+      var stopped = false
+      var queueWaitMs = 0L
+      var stepPlan: ZipvoiceStepPlan? = null
+      val audio = try {
+        inst.withEngineLock(ticket, request) { when {
+          getPromptId(options) != null && inst.isZipvoice -> {
+            val zipvoice = inst.zipvoiceTts!!
+            val promptId = getPromptId(options)!!
+            val prompt = zipvoice.promptInfo(inst.instanceId, promptId)
+            val plan = planZipvoiceSteps(zipvoice, text, prompt?.second ?: 0, prompt?.first ?: 0.0, speed, options)
+            stepPlan = plan
+            runPlannedZipvoice(zipvoice, plan) { steps -> zipvoice.generateWithPrompt(inst.instanceId, text, promptId, speed, steps) }
+          }
+          hasReferenceOptions(options) && inst.isZipvoice -> {
+            val refAudio = options?.getArray("referenceAudio")
+              ?: run {
+                Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: referenceAudio required for Zipvoice voice cloning")
+                promise.reject("TTS_GENERATE_ERROR", "referenceAudio required for Zipvoice voice cloning")
+                return
+              }
+            val promptSr = if (options.hasKey("referenceSampleRate")) options.getDouble("referenceSampleRate").toInt() else 0
+            val promptText = options.getString("referenceText").orEmpty()
+            val samples = FloatArray(refAudio.size()) { i -> refAudio.getDouble(i).toFloat() }
+            val zipvoice = inst.zipvoiceTts!!
+            val promptSeconds = if (promptSr > 0) samples.size.toDouble() / promptSr else 0.0
+            val plan = planZipvoiceSteps(zipvoice, text, utf8Length(promptText), promptSeconds, speed, options)
+            stepPlan = plan
+            runPlannedZipvoice(zipvoice, plan) { steps ->
+              zipvoice.generateWithZipvoice(text, promptText, samples, promptSr, speed, steps)
             }
-          val promptSr = if (options.hasKey("referenceSampleRate")) options.getDouble("referenceSampleRate").toInt() else 0
-          val promptText = options.getString("referenceText").orEmpty()
-          val numSteps = if (options.hasKey("numSteps")) options.getDouble("numSteps").toInt() else 20
-          val samples = FloatArray(refAudio.size()) { i -> refAudio.getDouble(i).toFloat() }
-          inst.zipvoiceTts!!.generateWithZipvoice(text, promptText, samples, promptSr, speed, numSteps)
-        }
-        hasReferenceOptions(options) && inst.tts != null -> {
-          val config = parseGenerationConfig(options) ?: GenerationConfig(speed = speed, sid = sid)
-          inst.tts!!.generateWithConfig(text, config)
-        }
-        inst.isPocket && !hasReferenceOptions(options) -> {
-          Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: Pocket TTS requires reference audio for voice cloning")
-          promise.reject("TTS_GENERATE_ERROR", "Pocket TTS requires reference audio for voice cloning. Pass referenceAudio and referenceSampleRate in options.")
-          return
-        }
-        else -> dispatchGenerate(inst, text, sid, speed)
-          ?: run {
-            Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: TTS not initialized")
-            promise.reject("TTS_GENERATE_ERROR", "TTS not initialized")
+          }
+          hasReferenceOptions(options) && inst.tts != null -> {
+            val config = parseGenerationConfig(options) ?: GenerationConfig(speed = speed, sid = sid)
+            inst.tts!!.generateWithConfig(text, config)
+          }
+          inst.isPocket && !hasReferenceOptions(options) -> {
+            Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: Pocket TTS requires reference audio for voice cloning")
+            promise.reject("TTS_GENERATE_ERROR", "Pocket TTS requires reference audio for voice cloning. Pass referenceAudio and referenceSampleRate in options.")
             return
           }
+          else -> dispatchGenerate(inst, text, sid, speed)
+            ?: run {
+              Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: TTS not initialized")
+              promise.reject("TTS_GENERATE_ERROR", "TTS not initialized")
+              return
+            }
+        } }
+      } catch (e: EngineScheduler.RequestStoppedException) {
+        rejectStoppedRequest(promise, e)
+        return
+      } finally {
+        stopped = inst.requestStopped(ticket)
+        queueWaitMs = inst.finishRequest(ticket)
       }
+      if (stopped) {
+        rejectStoppedRequest(promise, EngineScheduler.RequestStoppedException(expired = true))
+        return
+      }
+      val samples = TtsTimeStretcher.stretch(audio.samples, audio.sampleRate, getTempo(options))
+      request.chunk(samples.size, copies = if (samples !== audio.samples) 3 else 2)
       val map = Arguments.createMap()
       val samplesArray = Arguments.createArray()
-      for (sample in audio.samples) {
+      for (sample in samples) {
         samplesArray.pushDouble(sample.toDouble())
       }
       map.putArray("samples", samplesArray)
       map.putInt("sampleRate", audio.sampleRate)
       val subtitlesArray = Arguments.createArray()
-      if (audio.samples.isNotEmpty() && audio.sampleRate > 0) {
-        val durationSec = audio.samples.size.toDouble() / audio.sampleRate
+      // Timestamps are taken from the stretched audio, so they already follow the tempo.
+      if (samples.isNotEmpty() && audio.sampleRate > 0) {
+        val durationSec = samples.size.toDouble() / audio.sampleRate
         val subtitleMap = Arguments.createMap()
         subtitleMap.putString("text", text)
         subtitleMap.putDouble("start", 0.0)
@@ -506,6 +796,9 @@ internal class SherpaOnnxTtsHelper(
       }
       map.putArray("subtitles", subtitlesArray)
       map.putBoolean("estimated", true)
+      map.putDouble("queueWaitMs", queueWaitMs.toDouble())
+      stepPlan?.let { putStepPlan(map, it) }
+      request.finish(samples.size.toLong(), audio.sampleRate)?.let { map.putMap("stats", it) }
       promise.resolve(map)
     } catch (e: Exception) {
       Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: ${e.message ?: "Failed to generate speech"}", e)
@@ -513,6 +806,153 @@ internal class SherpaOnnxTtsHelper(
     }
   }
 
+  /**
+   * Synthesize [text] straight into [path] as [format] ("wav", "mp3", "flac", ...; "" = the path's
+   * extension) and resolve with metadata only. Chunks from the engine callback are appended to a
+   * native WAV writer as they arrive, so memory and bridge traffic stay constant with the output
+   * length; other formats are encoded from a temporary WAV by the FFmpeg converter. A cache hit is
+   * written as is; a miss is not inserted (that would buffer the whole utterance).
+   */
+  fun generateTtsToFile(
+    instanceId: String,
+    text: String,
+    options: ReadableMap?,
+    path: String,
+    format: String,
+    promise: Promise
+  ) {
+    val inst = getInstance(instanceId) ?: run {
+      Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: TTS instance not found: $instanceId")
+      promise.reject("TTS_GENERATE_ERROR", "TTS instance not found: $instanceId")
+      return
+    }
+    if (!inst.hasEngine()) {
+      Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: TTS not initialized")
+      promise.reject("TTS_GENERATE_ERROR", "TTS not initialized")
+      return
+    }
+    if (inst.isPocket && !hasReferenceOptions(options)) {
+      Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: Pocket TTS requires reference audio for voice cloning")
+      promise.reject("TTS_GENERATE_ERROR", "Pocket TTS requires reference audio for voice cloning. Pass referenceAudio and referenceSampleRate in options.")
+      return
+    }
+    if (inst.isZipvoice && hasReferenceOptions(options) && getPromptId(options) == null) {
+      Log.e("SherpaOnnxTts", "TTS_GENERATE_ERROR: Zipvoice file output clones from a registered prompt")
+      promise.reject("TTS_GENERATE_ERROR", "Zipvoice file output clones from a registered prompt. Call registerTtsPrompt and pass promptId.")
+      return
+    }
+    val outputFormat = resolveOutputFormat(path, format)
+    val wavPath = if (outputFormat == "wav") path else "$path.part.wav"
+    val sid = getSid(options)
+    val speed = getSpeed(options)
+    val cacheKey = audioCacheKey(inst, text, sid, speed, options)
+    val cached = cacheKey?.let { inst.audioCache?.get(it) }
+    val request = inst.stats.begin()
+    val ticket = if (cached == null) submitTtsRequest(inst, options) else 0L
+    val writer = WavFileWriter()
+    var stretcher: TtsTimeStretcher? = null
+    var writeFailed = false
+    var stopped = false
+    var queueWaitMs = 0L
+    var sampleRate = 0
+    // copies: as for streams, with the writer's JNI append in place of the bridge array.
+    val write = { chunk: FloatArray, length: Int, copies: Int ->
+      val stretched = stretcher?.push(chunk, length)
+      val count = stretched?.size ?: length
+      request.chunk(count, if (stretched != null) copies + 1 else copies)
+      if (count > 0 && !writer.append(stretched ?: chunk, 0, count)) writeFailed = true
+    }
+    try {
+      // Everything after submitTtsRequest runs inside the inner try so the ticket is always finished.
+      try {
+        sampleRate = cached?.sampleRate ?: dispatchSampleRate(inst)
+        if (!writer.open(wavPath, sampleRate)) {
+          Log.e("SherpaOnnxTts", "TTS_SAVE_ERROR: Failed to open $wavPath")
+          promise.reject("TTS_SAVE_ERROR", "Failed to open $wavPath")
+          return
+        }
+        val tempo = getTempo(options)
+        if (TtsTimeStretcher.isActive(tempo)) stretcher = TtsTimeStretcher(sampleRate, tempo)
+        when {
+          cached != null -> write(cached.samples, cached.samples.size, 1)
+          getPromptId(options) != null && inst.isZipvoice -> {
+            val audio = inst.withEngineLock(ticket, request) { synthesizeExportItem(inst, text, sid, speed, options, null) }
+              ?: throw IllegalStateException("TTS not initialized")
+            write(audio.samples, audio.samples.size, 2)
+          }
+          inst.zipvoiceTts != null && getParallelSentences(options) > 1 -> inst.withEngineLock(ticket, request) {
+            inst.zipvoiceTts!!.generateParallel(text, sid, speed, getParallelSentences(options), getSentenceSilenceMs(options)) { chunk ->
+              if (writeFailed) return@generateParallel 0
+              write(chunk, chunk.size, 2)
+              chunk.size
+            }
+          }
+          else -> {
+            val config = if (hasReferenceOptions(options) && inst.tts != null) {
+              parseGenerationConfig(options) ?: GenerationConfig(speed = speed, sid = sid)
+            } else null
+            // Batch requests take the engine one sentence at a time, as in generateTtsStream.
+            val pieces = if (inst.engine?.scheduler?.priorityOf(ticket) == EngineScheduler.PRIORITY_BATCH) {
+              TtsFirstChunkPlanner.splitSentences(text)
+            } else listOf(text)
+            val stopRequested = { writeFailed || inst.requestStopped(ticket) }
+            for (piece in pieces) {
+              if (stopRequested()) break
+              streamPiece(inst, piece, sid, speed, config, ticket, request, stopRequested, write)
+            }
+          }
+        }
+      } catch (e: EngineScheduler.RequestStoppedException) {
+        rejectStoppedRequest(promise, e)
+        File(wavPath).delete()
+        return
+      } finally {
+        stopped = inst.requestStopped(ticket)
+        queueWaitMs = inst.finishRequest(ticket)
+      }
+      if (stopped) {
+        File(wavPath).delete()
+        rejectStoppedRequest(promise, EngineScheduler.RequestStoppedException(expired = true))
+        return
+      }
+      stretcher?.flush()?.let { tail -> if (tail.isNotEmpty() && !writer.append(tail)) writeFailed = true }
+      val numSamples = writer.numSamples()
+      if (!writer.finish() || writeFailed) {
+        File(wavPath).delete()
+        Log.e("SherpaOnnxTts", "TTS_SAVE_ERROR: Failed to write $wavPath")
+        promise.reject("TTS_SAVE_ERROR", "Failed to write $wavPath")
+        return
+      }
+      if (wavPath != path) {
+        val outputSampleRateHz =
+          if (options != null && options.hasKey("outputSampleRateHz")) options.getDouble("outputSampleRateHz").toInt() else 0
+        val err = SherpaOnnxModule.convertAudioFile(wavPath, path, outputFormat, outputSampleRateHz)
+        File(wavPath).delete()
+        if (err.isNotEmpty()) {
+          Log.e("SherpaOnnxTts", "TTS_SAVE_ERROR: $err")
+          promise.reject("TTS_SAVE_ERROR", err)
+          return
+        }
+      }
+      val map = Arguments.createMap()
+      map.putString("path", path)
+      map.putString("format", outputFormat)
+      map.putInt("sampleRate", sampleRate)
+      map.putDouble("numSamples", numSamples.toDouble())
+      map.putDouble("durationMs", if (sampleRate > 0) numSamples * 1000.0 / sampleRate else 0.0)
+      map.putDouble("queueWaitMs", queueWaitMs.toDouble())
+      request.finish(numSamples, sampleRate)?.let { map.putMap("stats", it) }
+      promise.resolve(map)
+    } catch (e: Exception) {
+      File(wavPath).delete()
+      Log.e("SherpaOnnxTts", "generateTtsToFile error: ${e.message}", e)
+      promise.reject("TTS_GENERATE_ERROR", e.message ?: "Failed to generate speech", e)
+    } finally {
+      stretcher?.release()
+      writer.release()
+    }
+  }
+
   fun generateTtsStream(instanceId: String, requestId: String, text: String, options: ReadableMap?, promise: Promise) {
     val inst = getInstance(instanceId) ?: run {
       Log.e("SherpaOnnxTts", "TTS_STREAM_ERROR: TTS instance not found: $instanceId")
@@ -534,51 +974,130 @@ internal class SherpaOnnxTtsHelper(
       promise.reject("TTS_STREAM_ERROR", "Pocket TTS requires reference audio for voice cloning. Pass referenceAudio and referenceSampleRate in options.")
       return
     }
-    if (hasReferenceOptions(options) && inst.isZipvoice) {
+    if ((hasReferenceOptions(options) || getPromptId(options) != null) && inst.isZipvoice) {
       Log.e("SherpaOnnxTts", "TTS_STREAM_ERROR: Streaming with reference audio not supported for Zipvoice")
       promise.reject("TTS_STREAM_ERROR", "Streaming with reference audio not supported for Zipvoice")
       return
     }
     val sid = getSid(options)
     val speed = getSpeed(options)
+    val cacheKey = audioCacheKey(inst, text, sid, speed, options)
+    val firstChunkTargetMs = getFirstChunkTargetMs(options)
     inst.ttsStreamCancelled.set(false)
     inst.ttsStreamRunning.set(true)
+    val ticket = submitTtsRequest(inst, options)
+    inst.ttsStreamTicket = ticket
     inst.ttsStreamThread = Thread {
+      val startNs = System.nanoTime()
+      val request = inst.stats.begin()
+      var totalSamples = 0L
+      var streamSampleRate = 0
+      var playback: TtsPlaybackBuffer? = null
+      var stretcher: TtsTimeStretcher? = null
+      var firstAudioNs = 0L
+      // Stop on cancelTtsStream or once the request's deadline passes.
+      val stopRequested = { inst.ttsStreamCancelled.get() || inst.requestStopped(ticket) }
       try {
         val sampleRate = dispatchSampleRate(inst)
+        streamSampleRate = sampleRate
+        if (getPlayback(options)) {
+          val player = inst.ttsPlayback
+          when {
+            player == null -> Log.w("SherpaOnnxTts", "TTS stream: playback requested but the PCM player is not running")
+            player.sampleRate != sampleRate -> Log.w("SherpaOnnxTts", "TTS stream: PCM player runs at ${player.sampleRate} Hz, stream at $sampleRate Hz; not playing")
+            else -> playback = player
+          }
+        }
+        val cached = cacheKey?.let { inst.audioCache?.get(it) }
+        // First-chunk fast path: synthesize a short leading clause first so audio starts sooner.
+        val leading = if (cached == null && firstChunkTargetMs > 0 && !hasReferenceOptions(options)) {
+          inst.firstChunkPlanner()?.let { planner ->
+            TtsFirstChunkPlanner.splitLeadingClause(text, planner.budget(firstChunkTargetMs))
+          }
+        } else null
+        var pieces = if (leading != null) listOf(leading.first, leading.second) else listOf(text)
+        // Batch streams take the engine one sentence at a time so interactive requests on the same
+        // engine can run in between.
+        if (inst.engine?.scheduler?.priorityOf(ticket) == EngineScheduler.PRIORITY_BATCH) {
+          pieces = pieces.dropLast(1) + TtsFirstChunkPlanner.splitSentences(pieces.last())
+        }
+        // On a miss, keep the emitted chunks so the full utterance can be cached when it completes.
+        // Split text is not cached: its pauses and prosody differ from a one-shot generateTts.
+        val collected = if (cacheKey != null && cached == null && pieces.size == 1) ArrayList<FloatArray>() else null
+        // copies: boundary crossings of the chunk's PCM (a JNI float[] and the bridge array).
+        val emitPcm = { chunk: FloatArray, length: Int, copies: Int ->
+          if (firstAudioNs == 0L && length > 0) firstAudioNs = System.nanoTime()
+          request.chunk(length, copies)
+          totalSamples += length
+          playback?.write(chunk, length, stop = stopRequested)
+          emitChunk(instanceId, requestId, chunk, length, sampleRate, 0f, false)
+        }
+        val tempo = getTempo(options)
+        if (TtsTimeStretcher.isActive(tempo)) stretcher = TtsTimeStretcher(sampleRate, tempo)
+        // Chunks are cached as generated (tempo 1) and stretched on the way out.
+        // chunk may be the instance's reused ring array, so the cache keeps a copy.
+        val emitAudio = { chunk: FloatArray, length: Int, copies: Int ->
+          collected?.add(chunk.copyOf(length))
+          val out = stretcher?.push(chunk, length)
+          if (out == null) emitPcm(chunk, length, copies) else if (out.isNotEmpty()) emitPcm(out, out.size, copies + 1)
+        }
         when {
-          hasReferenceOptions(options) && inst.tts != null -> {
+          cached != null -> emitAudio(cached.samples, cached.samples.size, 1)
+          hasReferenceOptions(options) && inst.tts != null -> inst.withEngineLock(ticket, request) {
             val config = parseGenerationConfig(options) ?: GenerationConfig(speed = speed, sid = sid)
             inst.tts!!.generateWithConfigAndCallback(text, config) { chunk ->
-              if (inst.ttsStreamCancelled.get()) return@generateWithConfigAndCallback 0
-              emitChunk(instanceId, requestId, chunk, sampleRate, 0f, false)
+              if (stopRequested()) return@generateWithConfigAndCallback 0
+              emitAudio(chunk, chunk.size, 2)
               chunk.size
             }
           }
-          inst.zipvoiceTts != null -> {
-            inst.zipvoiceTts!!.generateWithCallback(text, sid, speed) { chunk ->
-              if (inst.ttsStreamCancelled.get()) return@generateWithCallback 0
-              emitChunk(instanceId, requestId, chunk, sampleRate, 0f, false)
+          inst.zipvoiceTts != null && getParallelSentences(options) > 1 -> inst.withEngineLock(ticket, request) {
+            // Long-text mode: sentences synthesized on an engine pool, chunks emitted in order. It
+            // holds the engine slot throughout, so batch priority does not yield here.
+            // The leading clause runs on the first engine while the others start on the rest.
+            inst.zipvoiceTts!!.generateParallel(
+              leading?.second ?: text, sid, speed, getParallelSentences(options), getSentenceSilenceMs(options),
+              leadingClause = leading?.first ?: ""
+            ) { chunk ->
+              if (stopRequested()) return@generateParallel 0
+              emitAudio(chunk, chunk.size, 2)
               chunk.size
             }
           }
           else -> {
-            inst.tts!!.generateWithCallback(text, sid, speed) { chunk ->
-              if (inst.ttsStreamCancelled.get()) return@generateWithCallback 0
-              emitChunk(instanceId, requestId, chunk, sampleRate, 0f, false)
-              chunk.size
+            for (piece in pieces) {
+              if (stopRequested()) break
+              streamPiece(inst, piece, sid, speed, null, ticket, request, stopRequested, emitAudio)
             }
           }
         }
-        if (!inst.ttsStreamCancelled.get()) {
-          emitChunk(instanceId, requestId, FloatArray(0), sampleRate, 1f, true)
+        if (leading != null && firstAudioNs != 0L) {
+          inst.firstChunkPlanner()?.observe(leading.first, (firstAudioNs - startNs) / 1_000_000)
         }
+        val expired = !inst.ttsStreamCancelled.get() && inst.requestStopped(ticket)
+        if (expired) {
+          emitError(instanceId, requestId, "TTS request deadline passed before synthesis completed")
+        } else if (!inst.ttsStreamCancelled.get()) {
+          stretcher?.flush()?.let { tail -> if (tail.isNotEmpty()) emitPcm(tail, tail.size, 2) }
+          if (collected != null && cacheKey != null) {
+            inst.audioCache?.put(cacheKey, concatChunks(collected), sampleRate)
+          }
+          emitChunk(instanceId, requestId, FloatArray(0), 0, sampleRate, 1f, true)
+        }
+      } catch (e: EngineScheduler.RequestStoppedException) {
+        if (e.expired) emitError(instanceId, requestId, "TTS request deadline passed before synthesis completed")
       } catch (e: Exception) {
         if (!inst.ttsStreamCancelled.get()) {
           emitError(instanceId, requestId, "TTS streaming failed: ${e.message}")
         }
       } finally {
-        emitEnd(instanceId, requestId, inst.ttsStreamCancelled.get())
+        val timeToFirstAudioMs = if (firstAudioNs != 0L) (firstAudioNs - startNs) / 1_000_000 else -1L
+        val queueWaitMs = inst.finishRequest(ticket)
+        inst.ttsStreamTicket = 0L
+        stretcher?.release()
+        val stats = request.finish(totalSamples, streamSampleRate)
+        if (inst.ttsStreamCancelled.get()) playback?.clear() else playback?.markEnd()
+        emitEnd(instanceId, requestId, inst.ttsStreamCancelled.get(), timeToFirstAudioMs, queueWaitMs, stats)
         inst.ttsStreamRunning.set(false)
       }
     }
@@ -586,10 +1105,384 @@ internal class SherpaOnnxTtsHelper(
     promise.resolve(null)
   }
 
+  /**
+   * Open a text session: a stream whose text arrives in fragments through [pushTtsText] (e.g. from
+   * a streaming LLM). Fragments are cut natively at sentence and clause ends and each segment is
+   * synthesized as soon as it is complete, so audio starts while text is still arriving. Chunks and
+   * the end are emitted as for [generateTtsStream] under [requestId]; [closeTtsText] ends the
+   * stream after the remaining text, [cancelTtsStream] stops it. Occupies the instance's stream.
+   */
+  fun startTtsTextStream(instanceId: String, requestId: String, options: ReadableMap?, promise: Promise) {
+    val inst = getInstance(instanceId) ?: run {
+      Log.e("SherpaOnnxTts", "TTS_STREAM_ERROR: TTS instance not found: $instanceId")
+      promise.reject("TTS_STREAM_ERROR", "TTS instance not found: $instanceId")
+      return
+    }
+    if (inst.ttsStreamRunning.get()) {
+      Log.e("SherpaOnnxTts", "TTS_STREAM_ERROR: TTS streaming already in progress")
+      promise.reject("TTS_STREAM_ERROR", "TTS streaming already in progress")
+      return
+    }
+    if (!inst.hasEngine()) {
+      Log.e("SherpaOnnxTts", "TTS_STREAM_ERROR: TTS not initialized")
+      promise.reject("TTS_STREAM_ERROR", "TTS not initialized")
+      return
+    }
+    if (inst.isPocket && !hasReferenceOptions(options)) {
+      Log.e("SherpaOnnxTts", "TTS_STREAM_ERROR: Pocket TTS requires reference audio for voice cloning")
+      promise.reject("TTS_STREAM_ERROR", "Pocket TTS requires reference audio for voice cloning. Pass referenceAudio and referenceSampleRate in options.")
+      return
+    }
+    if ((hasReferenceOptions(options) || getPromptId(options) != null) && inst.isZipvoice) {
+      Log.e("SherpaOnnxTts", "TTS_STREAM_ERROR: Streaming with reference audio not supported for Zipvoice")
+      promise.reject("TTS_STREAM_ERROR", "Streaming with reference audio not supported for Zipvoice")
+      return
+    }
+    val sid = getSid(options)
+    val speed = getSpeed(options)
+    val firstChunkTargetMs = getFirstChunkTargetMs(options)
+    // The first segment may be cut at a clause within the first-chunk budget, as in generateTtsStream.
+    val firstClauseChars = if (firstChunkTargetMs > 0) inst.firstChunkPlanner()?.budget(firstChunkTargetMs) ?: 0 else 0
+    val session = TtsTextSession(requestId, TtsTextSegmenter(firstClauseChars))
+    inst.ttsStreamCancelled.set(false)
+    inst.ttsStreamRunning.set(true)
+    inst.ttsTextSession = session
+    val ticket = submitTtsRequest(inst, options)
+    inst.ttsStreamTicket = ticket
+    inst.ttsStreamThread = Thread {
+      val request = inst.stats.begin()
+      var totalSamples = 0L
+      var streamSampleRate = 0
+      var playback: TtsPlaybackBuffer? = null
+      var stretcher: TtsTimeStretcher? = null
+      var firstAudioNs = 0L
+      var firstSegment: String? = null
+      var firstSegmentNs = 0L
+      val stopRequested = { inst.ttsStreamCancelled.get() || inst.requestStopped(ticket) }
+      try {
+        val sampleRate = dispatchSampleRate(inst)
+        streamSampleRate = sampleRate
+        if (getPlayback(options)) {
+          val player = inst.ttsPlayback
+          when {
+            player == null -> Log.w("SherpaOnnxTts", "TTS text stream: playback requested but the PCM player is not running")
+            player.sampleRate != sampleRate -> Log.w("SherpaOnnxTts", "TTS text stream: PCM player runs at ${player.sampleRate} Hz, stream at $sampleRate Hz; not playing")
+            else -> playback = player
+          }
+        }
+        val emitPcm = { chunk: FloatArray, length: Int, copies: Int ->
+          if (firstAudioNs == 0L && length > 0) firstAudioNs = System.nanoTime()
+          request.chunk(length, copies)
+          totalSamples += length
+          playback?.write(chunk, length, stop = stopRequested)
+          emitChunk(instanceId, requestId, chunk, length, sampleRate, 0f, false)
+        }
+        val tempo = getTempo(options)
+        if (TtsTimeStretcher.isActive(tempo)) stretcher = TtsTimeStretcher(sampleRate, tempo)
+        val emitAudio = { chunk: FloatArray, length: Int, copies: Int ->
+          val out = stretcher?.push(chunk, length)
+          if (out == null) emitPcm(chunk, length, copies) else if (out.isNotEmpty()) emitPcm(out, out.size, copies + 1)
+        }
+        val config = if (hasReferenceOptions(options) && inst.tts != null) {
+          parseGenerationConfig(options) ?: GenerationConfig(speed = speed, sid = sid)
+        } else null
+        while (!stopRequested()) {
+          // Poll so a deadline passing while no text arrives is noticed.
+          val segment = session.segments.poll(100, TimeUnit.MILLISECONDS) ?: continue
+          if (segment.isEmpty()) break
+          if (firstSegment == null) {
+            firstSegment = segment
+            firstSegmentNs = System.nanoTime()
+          }
+          streamPiece(inst, segment, sid, speed, config, ticket, request, stopRequested, emitAudio)
+        }
+        if (firstChunkTargetMs > 0 && firstAudioNs != 0L) {
+          firstSegment?.let { inst.firstChunkPlanner()?.observe(it, (firstAudioNs - firstSegmentNs) / 1_000_000) }
+        }
+        val expired = !inst.ttsStreamCancelled.get() && inst.requestStopped(ticket)
+        if (expired) {
+          emitError(instanceId, requestId, "TTS request deadline passed before synthesis completed")
+        } else if (!inst.ttsStreamCancelled.get()) {
+          stretcher?.flush()?.let { tail -> if (tail.isNotEmpty()) emitPcm(tail, tail.size, 2) }
+          emitChunk(instanceId, requestId, FloatArray(0), 0, sampleRate, 1f, true)
+        }
+      } catch (e: EngineScheduler.RequestStoppedException) {
+        if (e.expired) emitError(instanceId, requestId, "TTS request deadline passed before synthesis completed")
+      } catch (e: Exception) {
+        if (!inst.ttsStreamCancelled.get()) {
+          emitError(instanceId, requestId, "TTS text stream failed: ${e.message}")
+        }
+      } finally {
+        // Measured from the first text pushed: how long the listener waits after the LLM starts.
+        val timeToFirstAudioMs =
+          if (firstAudioNs != 0L && session.firstTextNs != 0L) (firstAudioNs - session.firstTextNs) / 1_000_000 else -1L
+        val queueWaitMs = inst.finishRequest(ticket)
+        inst.ttsStreamTicket = 0L
+        session.closed = true
+        inst.ttsTextSession = null
+        session.segmenter.release()
+        stretcher?.release()
+        val stats = request.finish(totalSamples, streamSampleRate)
+        if (inst.ttsStreamCancelled.get()) playback?.clear() else playback?.markEnd()
+        emitEnd(instanceId, requestId, inst.ttsStreamCancelled.get(), timeToFirstAudioMs, queueWaitMs, stats)
+        inst.ttsStreamRunning.set(false)
+      }
+    }
+    inst.ttsStreamThread?.start()
+    promise.resolve(null)
+  }
+
+  /** Feed a text fragment to the open text session [requestId]; complete segments start synthesizing. */
+  fun pushTtsText(instanceId: String, requestId: String, text: String, promise: Promise) {
+    val session = openTextSession(instanceId, requestId, promise) ?: return
+    if (session.firstTextNs == 0L) session.firstTextNs = System.nanoTime()
+    session.segments.addAll(session.segmenter.push(text))
+    promise.resolve(null)
+  }
+
+  /** Synthesize the text pushed so far even without a sentence end; the session stays open. */
+  fun flushTtsText(instanceId: String, requestId: String, promise: Promise) {
+    val session = openTextSession(instanceId, requestId, promise) ?: return
+    session.segments.addAll(session.segmenter.flush())
+    promise.resolve(null)
+  }
+
+  /** No more text: synthesize what is pending, then end the stream (final chunk and ttsStreamEnd). */
+  fun closeTtsText(instanceId: String, requestId: String, promise: Promise) {
+    val session = openTextSession(instanceId, requestId, promise) ?: return
+    session.closed = true
+    session.segments.addAll(session.segmenter.flush())
+    session.segments.add("")
+    promise.resolve(null)
+  }
+
+  private fun openTextSession(instanceId: String, requestId: String, promise: Promise): TtsTextSession? {
+    val session = getInstance(instanceId)?.ttsTextSession
+    if (session == null || session.requestId != requestId || session.closed) {
+      Log.e("SherpaOnnxTts", "TTS_SESSION_ERROR: No open text session $requestId")
+      promise.reject("TTS_SESSION_ERROR", "No open text session $requestId")
+      return null
+    }
+    return session
+  }
+
+  /**
+   * Synthesize one piece of a stream, holding the engine for [ticket] only for this piece so other
+   * requests can run in between. Chunks go to [emitAudio] as (samples, length, PCM copies taken).
+   * Zipvoice chunks arrive through the instance's reused ring and are read into its reused array
+   * (valid only during the call; the concatenated audio is not needed). [config] (reference audio, Pocket) is used instead of [sid] / [speed] when given.
+   * [request]'s clock starts with the first piece that gets the engine.
+   */
+  private fun streamPiece(
+    inst: TtsEngineInstance,
+    piece: String,
+    sid: Int,
+    speed: Float,
+    config: GenerationConfig?,
+    ticket: Long,
+    request: TtsStatsRecorder.Request,
+    stopRequested: () -> Boolean,
+    emitAudio: (FloatArray, Int, Int) -> Unit
+  ) {
+    inst.withEngineLock(ticket, request) {
+      val zipvoice = inst.zipvoiceTts
+      when {
+        zipvoice != null -> {
+          val ring = inst.chunkRing(zipvoice.sampleRate())
+          val scratch = inst.chunkScratch
+          zipvoice.generateToRing(piece, sid, speed, ring, returnAudio = false) {
+            if (stopRequested()) return@generateToRing false
+            val n = ring.read(scratch)
+            if (n > 0) emitAudio(scratch, n, 1)
+            true
+          }
+        }
+        config != null -> inst.tts!!.generateWithConfigAndCallback(piece, config) { chunk ->
+          if (stopRequested()) return@generateWithConfigAndCallback 0
+          emitAudio(chunk, chunk.size, 2)
+          chunk.size
+        }
+        else -> inst.tts!!.generateWithCallback(piece, sid, speed) { chunk ->
+          if (stopRequested()) return@generateWithCallback 0
+          emitAudio(chunk, chunk.size, 2)
+          chunk.size
+        }
+      }
+    }
+  }
+
+  /**
+   * Batch text-to-file export: synthesize each of [items] ({ text, path, format? }) in order and
+   * write it as WAV, MP3, FLAC, ... (format defaults to the path's extension). Samples go from the
+   * engine straight to a [TtsExportWriter], whose thread encodes item N while item N + 1 is
+   * synthesized; nothing crosses the bridge. Emits ttsExportProgress per written item and resolves
+   * with the per-item results. Occupies the instance's stream: [cancelTtsStream] stops it after the
+   * item in progress.
+   */
+  fun exportTtsBatch(instanceId: String, requestId: String, items: ReadableArray, options: ReadableMap?, promise: Promise) {
+    val inst = getInstance(instanceId) ?: run {
+      Log.e("SherpaOnnxTts", "TTS_EXPORT_ERROR: TTS instance not found: $instanceId")
+      promise.reject("TTS_EXPORT_ERROR", "TTS instance not found: $instanceId")
+      return
+    }
+    if (inst.ttsStreamRunning.get()) {
+      Log.e("SherpaOnnxTts", "TTS_EXPORT_ERROR: TTS streaming already in progress")
+      promise.reject("TTS_EXPORT_ERROR", "TTS streaming already in progress")
+      return
+    }
+    if (!inst.hasEngine()) {
+      Log.e("SherpaOnnxTts", "TTS_EXPORT_ERROR: TTS not initialized")
+      promise.reject("TTS_EXPORT_ERROR", "TTS not initialized")
+      return
+    }
+    if (inst.isPocket && !hasReferenceOptions(options)) {
+      Log.e("SherpaOnnxTts", "TTS_EXPORT_ERROR: Pocket TTS requires reference audio for voice cloning")
+      promise.reject("TTS_EXPORT_ERROR", "Pocket TTS requires reference audio for voice cloning. Pass referenceAudio and referenceSampleRate in options.")
+      return
+    }
+    if (inst.isZipvoice && hasReferenceOptions(options) && getPromptId(options) == null) {
+      Log.e("SherpaOnnxTts", "TTS_EXPORT_ERROR: Zipvoice batch export clones from a registered prompt")
+      promise.reject("TTS_EXPORT_ERROR", "Zipvoice batch export clones from a registered prompt. Call registerTtsPrompt and pass promptId.")
+      return
+    }
+    val jobs = ArrayList<ExportItem>(items.size())
+    for (i in 0 until items.size()) {
+      val item = items.getMap(i)
+      val text = item?.getString("text")
+      val path = item?.getString("path")
+      if (text == null || path.isNullOrEmpty()) {
+        Log.e("SherpaOnnxTts", "TTS_EXPORT_ERROR: items[$i] needs text and path")
+        promise.reject("TTS_EXPORT_ERROR", "items[$i] needs text and path")
+        return
+      }
+      val format = if (item.hasKey("format")) item.getString("format").orEmpty() else ""
+      jobs.add(ExportItem(text, path, format))
+    }
+    val sid = getSid(options)
+    val speed = getSpeed(options)
+    val tempo = getTempo(options)
+    val outputSampleRateHz =
+      if (options != null && options.hasKey("outputSampleRateHz")) options.getDouble("outputSampleRateHz").toInt() else 0
+    val config = if (hasReferenceOptions(options) && inst.tts != null) {
+      parseGenerationConfig(options) ?: GenerationConfig(speed = speed, sid = sid)
+    } else null
+    inst.ttsStreamCancelled.set(false)
+    inst.ttsStreamRunning.set(true)
+    val ticket = submitTtsRequest(inst, options)
+    inst.ttsStreamTicket = ticket
+    inst.ttsStreamThread = Thread {
+      val startNs = System.nanoTime()
+      val request = inst.stats.begin()
+      val writer = TtsExportWriter(tempo, outputSampleRateHz)
+      val written = ArrayList<WritableMap>(jobs.size)
+      var totalSamples = 0L
+      var sampleRate = 0
+      var succeeded = 0
+      val report = { results: List<TtsExportWriter.Result> ->
+        for (r in results) {
+          if (r.error == null) succeeded++ else Log.w("SherpaOnnxTts", "TTS export: item ${r.index} failed: ${r.error}")
+          written.add(exportResultMap(r, jobs[r.index].path))
+          emitExportProgress(instanceId, requestId, exportResultMap(r, jobs[r.index].path).apply {
+            putInt("completed", written.size)
+            putInt("total", jobs.size)
+          })
+        }
+      }
+      try {
+        for ((index, job) in jobs.withIndex()) {
+          if (inst.ttsStreamCancelled.get() || inst.requestStopped(ticket)) break
+          val audio = try {
+            inst.withEngineLock(ticket, request) { synthesizeExportItem(inst, job.text, sid, speed, options, config) }
+          } catch (e: EngineScheduler.RequestStoppedException) {
+            break
+          } catch (e: Exception) {
+            // One failed paragraph should not end a long export; it is reported like a write error.
+            report(listOf(TtsExportWriter.Result(index, 0L, 0, 0.0, "Synthesis failed: ${e.message}")))
+            continue
+          }
+          if (audio == null) throw IllegalStateException("TTS not initialized")
+          // One JNI copy out of the engine, one into the writer.
+          request.chunk(audio.samples.size, copies = 2)
+          totalSamples += audio.samples.size
+          sampleRate = audio.sampleRate
+          if (!writer.submit(index, audio.samples, audio.sampleRate, job.path, job.format)) break
+          report(writer.takeCompleted())
+        }
+        if (inst.ttsStreamCancelled.get()) writer.cancel()
+        report(writer.finish())
+        val cancelled = inst.ttsStreamCancelled.get()
+        val expired = !cancelled && inst.requestStopped(ticket)
+        val result = Arguments.createMap()
+        val itemsArray = Arguments.createArray()
+        written.sortedBy { it.getInt("index") }.forEach { itemsArray.pushMap(it) }
+        result.putArray("items", itemsArray)
+        result.putInt("succeeded", succeeded)
+        result.putInt("failed", written.size - succeeded)
+        result.putInt("total", jobs.size)
+        result.putBoolean("cancelled", cancelled)
+        result.putBoolean("expired", expired)
+        result.putDouble("elapsedMs", (System.nanoTime() - startNs) / 1e6)
+        result.putDouble("queueWaitMs", inst.finishRequest(ticket).toDouble())
+        request.finish(totalSamples, sampleRate)?.let { result.putMap("stats", it) }
+        promise.resolve(result)
+      } catch (e: Exception) {
+        writer.cancel()
+        writer.finish()
+        inst.finishRequest(ticket)
+        Log.e("SherpaOnnxTts", "TTS_EXPORT_ERROR: Batch export failed: ${e.message}", e)
+        promise.reject("TTS_EXPORT_ERROR", e.message ?: "Batch export failed", e)
+      } finally {
+        writer.release()
+        inst.ttsStreamTicket = 0L
+        inst.ttsStreamRunning.set(false)
+      }
+    }
+    inst.ttsStreamThread?.start()
+  }
+
+  private class ExportItem(val text: String, val path: String, val format: String)
+
+  /** One export item on the engine: prompt or reference cloning as in generateTts, else the plain voice. */
+  private fun synthesizeExportItem(
+    inst: TtsEngineInstance,
+    text: String,
+    sid: Int,
+    speed: Float,
+    options: ReadableMap?,
+    config: GenerationConfig?
+  ): GeneratedAudio? {
+    val zipvoice = inst.zipvoiceTts
+    val promptId = getPromptId(options)
+    return when {
+      zipvoice != null && promptId != null -> {
+        val prompt = zipvoice.promptInfo(inst.instanceId, promptId)
+        val plan = planZipvoiceSteps(zipvoice, text, prompt?.second ?: 0, prompt?.first ?: 0.0, speed, options)
+        runPlannedZipvoice(zipvoice, plan) { steps -> zipvoice.generateWithPrompt(inst.instanceId, text, promptId, speed, steps) }
+      }
+      config != null -> inst.tts!!.generateWithConfig(text, config)
+      else -> dispatchGenerate(inst, text, sid, speed)
+    }
+  }
+
+  private fun exportResultMap(r: TtsExportWriter.Result, path: String): WritableMap {
+    val map = Arguments.createMap()
+    map.putInt("index", r.index)
+    map.putString("path", path)
+    map.putBoolean("success", r.error == null)
+    r.error?.let { map.putString("error", it) }
+    if (r.sampleRate > 0) {
+      map.putInt("sampleRate", r.sampleRate)
+      map.putDouble("durationMs", r.numSamples * 1000.0 / r.sampleRate)
+    }
+    map.putDouble("encodeMs", r.encodeMs)
+    return map
+  }
+
   fun cancelTtsStream(instanceId: String, promise: Promise) {
     val inst = getInstance(instanceId)
     if (inst != null) {
       inst.ttsStreamCancelled.set(true)
+      inst.cancelRequest(inst.ttsStreamTicket)
       inst.ttsStreamThread?.interrupt()
     }
     promise.resolve(null)
@@ -629,8 +1522,23 @@ internal class SherpaOnnxTtsHelper(
         .setUsage(AudioAttributes.USAGE_MEDIA)
         .setContentType(AudioAttributes.CONTENT_TYPE_SPEECH)
         .build()
-      inst.ttsPcmTrack = AudioTrack(attributes, audioFormat, minBufferSize, AudioTrack.MODE_STREAM, AudioManager.AUDIO_SESSION_ID_GENERATE)
-      inst.ttsPcmTrack?.play()
+      val track = AudioTrack(attributes, audioFormat, minBufferSize, AudioTrack.MODE_STREAM, AudioManager.AUDIO_SESSION_ID_GENERATE)
+      // Chunks go through a jitter buffer; the player thread feeds AudioTrack half its buffer at a
+      // time (at least 10 ms), writing silence while the buffer prefills instead of starving it.
+      val frameSamples = maxOf(minBufferSize / 4 / 2, sampleRate.toInt() / 100)
+      val playback = TtsPlaybackBuffer(sampleRate.toInt(), frameSamples)
+      playback.setTempo(inst.ttsPlayerTempo)
+      inst.ttsPcmTrack = track
+      inst.ttsPlayback = playback
+      track.play()
+      inst.ttsPlaybackThread = Thread({
+        android.os.Process.setThreadPriority(android.os.Process.THREAD_PRIORITY_URGENT_AUDIO)
+        val frame = FloatArray(frameSamples)
+        while (!playback.closed) {
+          playback.pull(frame)
+          if (playback.closed || track.write(frame, 0, frame.size, AudioTrack.WRITE_BLOCKING) < 0) break
+        }
+      }, "SherpaOnnxTtsPlayback").apply { start() }
       promise.resolve(null)
     } catch (e: Exception) {
       Log.e("SherpaOnnxTts", "TTS_PCM_ERROR: Failed to start PCM player", e)
@@ -644,7 +1552,7 @@ internal class SherpaOnnxTtsHelper(
       promise.reject("TTS_PCM_ERROR", "TTS instance not found: $instanceId")
       return
     }
-    val track = inst.ttsPcmTrack ?: run {
+    val playback = inst.ttsPlayback ?: run {
       Log.e("SherpaOnnxTts", "TTS_PCM_ERROR: PCM player not initialized")
       promise.reject("TTS_PCM_ERROR", "PCM player not initialized")
       return
@@ -654,12 +1562,8 @@ internal class SherpaOnnxTtsHelper(
       for (i in 0 until samples.size()) {
         buffer[i] = samples.getDouble(i).toFloat()
       }
-      val written = track.write(buffer, 0, buffer.size, AudioTrack.WRITE_BLOCKING)
-      if (written < 0) {
-        Log.e("SherpaOnnxTts", "TTS_PCM_ERROR: PCM write failed: $written")
-        promise.reject("TTS_PCM_ERROR", "PCM write failed: $written")
-        return
-      }
+      // Blocks only while the jitter buffer is full; fewer samples means the player was stopped.
+      playback.write(buffer)
       promise.resolve(null)
     } catch (e: Exception) {
       Log.e("SherpaOnnxTts", "TTS_PCM_ERROR: Failed to write PCM chunk", e)
@@ -667,6 +1571,31 @@ internal class SherpaOnnxTtsHelper(
     }
   }
 
+  /** Jitter buffer counters of the PCM player; null when it is not running. */
+  fun getTtsPlaybackStats(instanceId: String, promise: Promise) {
+    promise.resolve(getInstance(instanceId)?.ttsPlayback?.stats())
+  }
+
+  /**
+   * Speed of the PCM player (1 = as generated). Applies within a frame, also to audio that is
+   * already buffered, by time-stretching (WSOLA) on the player thread; no re-synthesis.
+   */
+  fun setTtsPcmPlayerTempo(instanceId: String, tempo: Double, promise: Promise) {
+    val inst = getInstance(instanceId) ?: run {
+      Log.e("SherpaOnnxTts", "TTS_PCM_ERROR: TTS instance not found: $instanceId")
+      promise.reject("TTS_PCM_ERROR", "TTS instance not found: $instanceId")
+      return
+    }
+    if (!(tempo > 0.0)) {
+      Log.e("SherpaOnnxTts", "TTS_PCM_ERROR: tempo must be > 0")
+      promise.reject("TTS_PCM_ERROR", "tempo must be > 0")
+      return
+    }
+    inst.ttsPlayerTempo = tempo.toFloat()
+    inst.ttsPlayback?.setTempo(inst.ttsPlayerTempo)
+    promise.resolve(null)
+  }
+
   fun stopTtsPcmPlayer(instanceId: String, promise: Promise) {
     try {
       getInstance(instanceId)?.stopPcmPlayer()
@@ -715,12 +1644,211 @@ internal class SherpaOnnxTtsHelper(
     }
   }
 
+  fun configureTtsAudioCache(
+    instanceId: String,
+    maxMemoryBytes: Double,
+    diskDir: String,
+    maxDiskBytes: Double,
+    promise: Promise
+  ) {
+    val inst = getInstance(instanceId) ?: run {
+      Log.e("SherpaOnnxTts", "TTS_CACHE_ERROR: TTS instance not found: $instanceId")
+      promise.reject("TTS_CACHE_ERROR", "TTS instance not found: $instanceId")
+      return
+    }
+    try {
+      if (maxMemoryBytes <= 0 && diskDir.isBlank()) {
+        inst.releaseAudioCache()
+      } else {
+        val cache = synchronized(inst) {
+          inst.audioCache ?: TtsAudioCache().also { inst.audioCache = it }
+        }
+        cache.configure(maxMemoryBytes.coerceAtLeast(0.0).toLong(), diskDir, maxDiskBytes.coerceAtLeast(0.0).toLong())
+      }
+      promise.resolve(null)
+    } catch (e: Exception) {
+      Log.e("SherpaOnnxTts", "TTS_CACHE_ERROR: Failed to configure audio cache", e)
+      promise.reject("TTS_CACHE_ERROR", "Failed to configure audio cache", e)
+    }
+  }
+
+  fun getTtsAudioCacheStats(instanceId: String, promise: Promise) {
+    val stats = getInstance(instanceId)?.audioCache?.stats()
+    val map = Arguments.createMap()
+    map.putDouble("memoryHits", (stats?.memoryHits ?: 0L).toDouble())
+    map.putDouble("diskHits", (stats?.diskHits ?: 0L).toDouble())
+    map.putDouble("misses", (stats?.misses ?: 0L).toDouble())
+    map.putDouble("insertions", (stats?.insertions ?: 0L).toDouble())
+    map.putDouble("evictions", (stats?.evictions ?: 0L).toDouble())
+    map.putDouble("memoryBytes", (stats?.memoryBytes ?: 0L).toDouble())
+    map.putDouble("memoryEntries", (stats?.memoryEntries ?: 0L).toDouble())
+    map.putDouble("diskBytes", (stats?.diskBytes ?: 0L).toDouble())
+    promise.resolve(map)
+  }
+
+  fun getTtsStats(instanceId: String, promise: Promise) {
+    promise.resolve(getInstance(instanceId)?.stats?.snapshot() ?: Arguments.createMap())
+  }
+
+  fun resetTtsStats(instanceId: String, promise: Promise) {
+    getInstance(instanceId)?.stats?.reset()
+    promise.resolve(null)
+  }
+
+  fun clearTtsAudioCache(instanceId: String, includeDisk: Boolean, promise: Promise) {
+    getInstance(instanceId)?.audioCache?.clear(includeDisk)
+    promise.resolve(null)
+  }
+
+  fun registerTtsPrompt(
+    instanceId: String,
+    samples: ReadableArray,
+    sampleRate: Double,
+    promptText: String,
+    promise: Promise
+  ) {
+    val inst = getInstance(instanceId) ?: run {
+      Log.e("SherpaOnnxTts", "TTS_PROMPT_ERROR: TTS instance not found: $instanceId")
+      promise.reject("TTS_PROMPT_ERROR", "TTS instance not found: $instanceId")
+      return
+    }
+    val zipvoice = inst.zipvoiceTts ?: run {
+      Log.e("SherpaOnnxTts", "TTS_PROMPT_ERROR: Voice prompts are only supported for Zipvoice")
+      promise.reject("TTS_PROMPT_ERROR", "Voice prompts are only supported for Zipvoice")
+      return
+    }
+    try {
+      val samplesArray = FloatArray(samples.size()) { i -> samples.getDouble(i).toFloat() }
+      promise.resolve(zipvoice.registerPrompt(instanceId, promptText, samplesArray, sampleRate.toInt()).toDouble())
+    } catch (e: Exception) {
+      Log.e("SherpaOnnxTts", "TTS_PROMPT_ERROR: Failed to register voice prompt", e)
+      promise.reject("TTS_PROMPT_ERROR", e.message ?: "Failed to register voice prompt", e)
+    }
+  }
+
+  fun unregisterTtsPrompt(instanceId: String, promptId: Double, promise: Promise) {
+    val removed = getInstance(instanceId)?.zipvoiceTts?.unregisterPrompt(instanceId, promptId.toLong()) ?: false
+    promise.resolve(removed)
+  }
+
+  /**
+   * Calibrate deadline-aware step selection for Zipvoice voice cloning on this device: the same
+   * request (options.text or a built-in sentence, with options.promptId or referenceAudio /
+   * referenceText) is timed at two step counts after a warm-up run. The fitted cost model is stored
+   * per model and config and reloaded on later launches. Resolves with the model plus the timings.
+   */
+  fun calibrateTtsSteps(instanceId: String, options: ReadableMap?, promise: Promise) {
+    val inst = getInstance(instanceId) ?: run {
+      Log.e("SherpaOnnxTts", "TTS_CALIBRATE_ERROR: TTS instance not found: $instanceId")
+      promise.reject("TTS_CALIBRATE_ERROR", "TTS instance not found: $instanceId")
+      return
+    }
+    val zipvoice = inst.zipvoiceTts ?: run {
+      Log.e("SherpaOnnxTts", "TTS_CALIBRATE_ERROR: Step calibration is only supported for Zipvoice")
+      promise.reject("TTS_CALIBRATE_ERROR", "Step calibration is only supported for Zipvoice")
+      return
+    }
+    val text = options?.takeIf { it.hasKey("text") }?.getString("text") ?: STEP_CALIBRATION_TEXT
+    val speed = getSpeed(options)
+    val promptId = getPromptId(options)
+    val refAudio = if (promptId == null && hasReferenceOptions(options)) options?.getArray("referenceAudio") else null
+    if (promptId == null && refAudio == null) {
+      Log.e("SherpaOnnxTts", "TTS_CALIBRATE_ERROR: promptId or referenceAudio is required")
+      promise.reject("TTS_CALIBRATE_ERROR", "Step calibration needs a voice: pass promptId or referenceAudio and referenceText")
+      return
+    }
+    try {
+      val generate: (Int) -> GeneratedAudio
+      val promptTextBytes: Int
+      val promptSeconds: Double
+      if (promptId != null) {
+        val prompt = zipvoice.promptInfo(inst.instanceId, promptId) ?: run {
+          Log.e("SherpaOnnxTts", "TTS_CALIBRATE_ERROR: Unknown voice prompt id: $promptId")
+          promise.reject("TTS_CALIBRATE_ERROR", "Unknown voice prompt id: $promptId")
+          return
+        }
+        promptSeconds = prompt.first
+        promptTextBytes = prompt.second
+        generate = { steps -> zipvoice.generateWithPrompt(inst.instanceId, text, promptId, speed, steps) }
+      } else {
+        val promptSr = if (options!!.hasKey("referenceSampleRate")) options.getDouble("referenceSampleRate").toInt() else 0
+        val promptText = options.getString("referenceText").orEmpty()
+        val samples = FloatArray(refAudio!!.size()) { i -> refAudio.getDouble(i).toFloat() }
+        promptSeconds = if (promptSr > 0) samples.size.toDouble() / promptSr else 0.0
+        promptTextBytes = utf8Length(promptText)
+        generate = { steps -> zipvoice.generateWithZipvoice(text, promptText, samples, promptSr, speed, steps) }
+      }
+      val ticket = submitTtsRequest(inst, options)
+      var msLo = 0.0
+      var msHi = 0.0
+      try {
+        inst.withEngineLock(ticket) {
+          generate(CALIBRATION_STEPS_LO / 2)  // warm-up: first-run allocations are not part of the cost
+          var startNs = System.nanoTime()
+          generate(CALIBRATION_STEPS_LO)
+          msLo = (System.nanoTime() - startNs) / 1e6
+          startNs = System.nanoTime()
+          generate(CALIBRATION_STEPS_HI)
+          msHi = (System.nanoTime() - startNs) / 1e6
+        }
+      } finally {
+        inst.finishRequest(ticket)
+      }
+      val flowSeconds = ZipvoiceStepPlanner.flowSeconds(utf8Length(text), promptTextBytes, promptSeconds, speed)
+      if (!zipvoice.stepPlanner.calibrate(flowSeconds, CALIBRATION_STEPS_LO, msLo, CALIBRATION_STEPS_HI, msHi)) {
+        Log.e("SherpaOnnxTts", "TTS_CALIBRATE_ERROR: Unusable timings (${msLo} ms at $CALIBRATION_STEPS_LO steps, ${msHi} ms at $CALIBRATION_STEPS_HI)")
+        promise.reject("TTS_CALIBRATE_ERROR", "Calibration timings were not usable; retry when the device is idle")
+        return
+      }
+      stepCalibrationKey(inst)?.let { key ->
+        zipvoice.stepPlanner.serialize()?.let { stepCalibrationPrefs().edit().putString(key, it).apply() }
+      }
+      val result = zipvoice.stepPlanner.model()
+      result.putDouble("flowSeconds", flowSeconds)
+      result.putInt("stepsLo", CALIBRATION_STEPS_LO)
+      result.putDouble("msLo", msLo)
+      result.putInt("stepsHi", CALIBRATION_STEPS_HI)
+      result.putDouble("msHi", msHi)
+      promise.resolve(result)
+    } catch (e: EngineScheduler.RequestStoppedException) {
+      rejectStoppedRequest(promise, e)
+    } catch (e: Exception) {
+      Log.e("SherpaOnnxTts", "TTS_CALIBRATE_ERROR: Step calibration failed", e)
+      promise.reject("TTS_CALIBRATE_ERROR", e.message ?: "Step calibration failed", e)
+    }
+  }
+
+  /** Step cost model of the instance's Zipvoice engine; null for other models. */
+  fun getTtsStepCalibration(instanceId: String, promise: Promise) {
+    promise.resolve(getInstance(instanceId)?.zipvoiceTts?.stepPlanner?.model())
+  }
+
+  private fun stepCalibrationPrefs() =
+    context.getSharedPreferences(STEP_CALIBRATION_PREFS, Context.MODE_PRIVATE)
+
+  /** Storage key of a calibration: the shared-engine key (model files, init options, threads). */
+  private fun stepCalibrationKey(inst: TtsEngineInstance): String? {
+    val state = inst.ttsInitState ?: return null
+    val fingerprint = inst.modelFingerprint ?: return null
+    return engineKeyFor(state, fingerprint)
+  }
+
+  private fun restoreStepCalibration(key: String, zipvoice: ZipvoiceTtsWrapper) {
+    val stored = stepCalibrationPrefs().getString(key, null) ?: return
+    if (!zipvoice.stepPlanner.restore(stored)) Log.w("SherpaOnnxTts", "Ignoring unreadable Zipvoice step calibration")
+  }
+
   fun unloadTts(instanceId: String, promise: Promise) {
     try {
       val inst = instances.remove(instanceId)
       if (inst != null) {
+        // A running stream holds the engine lock; stop it so the release does not wait for the whole utterance.
+        inst.ttsStreamCancelled.set(true)
+        inst.cancelRequest(inst.ttsStreamTicket)
         inst.stopPcmPlayer()
         inst.releaseEngines()
+        inst.releaseAudioCache()
+        inst.stats.release()
       }
       promise.resolve(null)
     } catch (e: Exception) {
@@ -740,7 +1868,7 @@ internal class SherpaOnnxTtsHelper(
       for (i in 0 until samples.size()) {
         samplesArray[i] = samples.getDouble(i).toFloat()
       }
-      val success = GeneratedAudio(samplesArray, sampleRate.toInt()).save(filePath)
+      val success = WavFileWriter.writeFile(filePath, samplesArray, sampleRate.toInt())
       if (success) {
         promise.resolve(filePath)
       } else {
@@ -893,6 +2021,13 @@ internal class SherpaOnnxTtsHelper(
     return (refAudio != null && refAudio.size() > 0) || !refText.isNullOrEmpty()
   }
 
+  /** Registered voice prompt id (see [registerTtsPrompt]), or null when not set. */
+  private fun getPromptId(options: ReadableMap?): Long? =
+    if (options != null && options.hasKey("promptId")) options.getDouble("promptId").toLong() else null
+
+  private fun getNumSteps(options: ReadableMap?): Int =
+    if (options != null && options.hasKey("numSteps")) options.getDouble("numSteps").toInt() else 20
+
   /** Parse sid and speed from options with defaults. */
   private fun getSid(options: ReadableMap?): Int =
     if (options != null && options.hasKey("sid")) options.getDouble("sid").toInt() else 0
@@ -900,6 +2035,100 @@ internal class SherpaOnnxTtsHelper(
   private fun getSpeed(options: ReadableMap?): Float =
     if (options != null && options.hasKey("speed")) options.getDouble("speed").toFloat() else 1.0f
 
+  /** Number of engines for sentence-parallel (long-text) generation; 1 = regular generation. */
+  private fun getParallelSentences(options: ReadableMap?): Int =
+    if (options != null && options.hasKey("parallelSentences")) options.getDouble("parallelSentences").toInt() else 1
+
+  private fun getSentenceSilenceMs(options: ReadableMap?): Int =
+    if (options != null && options.hasKey("sentenceSilenceMs")) options.getDouble("sentenceSilenceMs").toInt() else 0
+
+  /** Time-to-first-audio target for the streaming first-chunk fast path; 0 = disabled. */
+  private fun getFirstChunkTargetMs(options: ReadableMap?): Int =
+    if (options != null && options.hasKey("firstChunkTargetMs")) options.getDouble("firstChunkTargetMs").toInt() else 0
+
+  /** Streaming: also feed chunks natively into the running PCM player. */
+  /** Latency budget for Zipvoice voice cloning; 0 = use numSteps as given. */
+  private fun getLatencyBudgetMs(options: ReadableMap?): Double =
+    if (options != null && options.hasKey("latencyBudgetMs")) options.getDouble("latencyBudgetMs") else 0.0
+
+  private fun utf8Length(s: String): Int = s.toByteArray(Charsets.UTF_8).size
+
+  /** Steps chosen for a Zipvoice voice-cloning request, with what the planner predicted. */
+  private class ZipvoiceStepPlan(
+    val numSteps: Int,
+    val flowSeconds: Double,
+    val budgetMs: Double,
+    val predictedMs: Double
+  )
+
+  /**
+   * options.numSteps as given, or with options.latencyBudgetMs the largest step count the engine's
+   * planner predicts to fit (numSteps, when set, is then the upper bound).
+   */
+  private fun planZipvoiceSteps(
+    zipvoice: ZipvoiceTtsWrapper,
+    text: String,
+    promptTextBytes: Int,
+    promptSeconds: Double,
+    speed: Float,
+    options: ReadableMap?
+  ): ZipvoiceStepPlan {
+    val flowSeconds = ZipvoiceStepPlanner.flowSeconds(utf8Length(text), promptTextBytes, promptSeconds, speed)
+    val budgetMs = getLatencyBudgetMs(options)
+    if (budgetMs <= 0.0) {
+      val numSteps = getNumSteps(options)
+      return ZipvoiceStepPlan(numSteps, flowSeconds, 0.0, zipvoice.stepPlanner.predictMs(flowSeconds, numSteps))
+    }
+    val maxSteps = if (options != null && options.hasKey("numSteps")) getNumSteps(options) else 0
+    val choice = zipvoice.stepPlanner.choose(budgetMs, flowSeconds, maxSteps)
+    return ZipvoiceStepPlan(choice.numSteps, flowSeconds, budgetMs, choice.predictedMs)
+  }
+
+  /** Run [generate] with the plan's step count and feed the measured time back to the planner. */
+  private inline fun runPlannedZipvoice(
+    zipvoice: ZipvoiceTtsWrapper,
+    plan: ZipvoiceStepPlan,
+    generate: (Int) -> GeneratedAudio
+  ): GeneratedAudio {
+    val startNs = System.nanoTime()
+    val audio = generate(plan.numSteps)
+    zipvoice.stepPlanner.observe(plan.flowSeconds, plan.numSteps, (System.nanoTime() - startNs) / 1e6)
+    return audio
+  }
+
+  private fun putStepPlan(map: WritableMap, plan: ZipvoiceStepPlan) {
+    map.putInt("numSteps", plan.numSteps)
+    if (plan.predictedMs >= 0.0) map.putDouble("predictedMs", plan.predictedMs)
+  }
+
+  /** Lower-cased [format], or [path]'s extension when it is empty; "wav" when neither is set. */
+  private fun resolveOutputFormat(path: String, format: String): String =
+    format.ifEmpty { File(path).extension }.lowercase().ifEmpty { "wav" }
+
+  /** Post-synthesis playback speed (WSOLA time-stretch, pitch kept); 1 = as generated. */
+  private fun getTempo(options: ReadableMap?): Float =
+    if (options != null && options.hasKey("tempo")) options.getDouble("tempo").toFloat() else 1.0f
+
+  private fun getPlayback(options: ReadableMap?): Boolean =
+    options != null && options.hasKey("playback") && options.getBoolean("playback")
+
+  /** Scheduling priority ("interactive" / "normal" / "batch"); defaults to normal. */
+  private fun getPriority(options: ReadableMap?): Int =
+    EngineScheduler.parsePriority(if (options != null && options.hasKey("priority")) options.getString("priority") else null)
+
+  /** Relative deadline in ms for the whole request; 0 = none. */
+  private fun getDeadlineMs(options: ReadableMap?): Long =
+    if (options != null && options.hasKey("deadlineMs")) options.getDouble("deadlineMs").toLong() else 0L
+
+  private fun submitTtsRequest(inst: TtsEngineInstance, options: ReadableMap?): Long =
+    inst.submitRequest(getPriority(options), getDeadlineMs(options))
+
+  private fun rejectStoppedRequest(promise: Promise, e: EngineScheduler.RequestStoppedException) {
+    val code = if (e.expired) "TTS_DEADLINE_EXCEEDED" else "TTS_GENERATE_ERROR"
+    Log.e("SherpaOnnxTts", "$code: ${e.message}")
+    promise.reject(code, e.message ?: "TTS request stopped", e)
+  }
+
   /** Build Kotlin GenerationConfig from ReadableMap. Returns null only when options is null; otherwise returns a config with sid, speed, silenceScale, numSteps, and any reference/extra fields from options. */
   private fun parseGenerationConfig(options: ReadableMap?): GenerationConfig? {
     if (options == null) return null
@@ -935,6 +2164,44 @@ internal class SherpaOnnxTtsHelper(
   }
 
   /** Dispatch generate to whichever engine is active on the instance. Returns null if none loaded. */
+  /**
+   * True when generateTts would synthesize [options] with a plain or config generate call, which can
+   * be run one sentence at a time (not Zipvoice cloning or parallel mode, not Pocket without a reference).
+   */
+  private fun canGenerateBySentence(inst: TtsEngineInstance, options: ReadableMap?): Boolean {
+    if (inst.isZipvoice) {
+      return getPromptId(options) == null && !hasReferenceOptions(options) && getParallelSentences(options) <= 1
+    }
+    return !inst.isPocket || hasReferenceOptions(options)
+  }
+
+  /**
+   * Synthesize [sentences] taking the engine for [ticket] once per sentence, and join the audio.
+   * [config] (reference audio, Pocket) is used instead of [sid] / [speed] when given. Stops early
+   * once the request is cancelled or expires (the caller checks); null when no engine is loaded.
+   */
+  private fun generateBySentence(
+    inst: TtsEngineInstance,
+    sentences: List<String>,
+    sid: Int,
+    speed: Float,
+    config: GenerationConfig?,
+    ticket: Long,
+    request: TtsStatsRecorder.Request
+  ): GeneratedAudio? {
+    val chunks = ArrayList<FloatArray>(sentences.size)
+    var sampleRate = 0
+    for (sentence in sentences) {
+      if (inst.requestStopped(ticket)) break
+      val audio = inst.withEngineLock(ticket, request) {
+        if (config != null) inst.tts?.generateWithConfig(sentence, config) else dispatchGenerate(inst, sentence, sid, speed)
+      } ?: return null
+      chunks.add(audio.samples)
+      sampleRate = audio.sampleRate
+    }
+    return GeneratedAudio(concatChunks(chunks), sampleRate)
+  }
+
   private fun dispatchGenerate(inst: TtsEngineInstance, text: String, sid: Int, speed: Float): GeneratedAudio? {
     inst.zipvoiceTts?.let { return it.generate(text, sid, speed) }
     inst.tts?.let { return it.generate(text, sid, speed) }
@@ -951,6 +2218,42 @@ internal class SherpaOnnxTtsHelper(
     return inst.tts?.numSpeakers() ?: 0
   }
 
+  /** Shared-engine key: the model fingerprint plus the options that only affect how it is loaded. */
+  private fun engineKeyFor(state: TtsInitState, fingerprint: String): String =
+    "$fingerprint|tts|${state.numThreads}|${state.debug}|${state.provider.orEmpty()}"
+
+  /** Model fingerprint for audio cache keys: model files plus every init option that changes the audio. */
+  private fun fingerprintFor(state: TtsInitState): String =
+    TtsAudioCache.modelFingerprint(
+      state.modelDir,
+      listOf(
+        state.modelType, state.noiseScale, state.noiseScaleW, state.lengthScale,
+        state.ruleFsts, state.ruleFars, state.maxNumSentences, state.silenceScale
+      ).joinToString("|")
+    )
+
+  /**
+   * Audio cache key for a generate call, or null when the instance has no cache or the request is
+   * not cacheable (reference audio or a registered prompt / voice cloning).
+   */
+  private fun audioCacheKey(inst: TtsEngineInstance, text: String, sid: Int, speed: Float, options: ReadableMap?): String? {
+    if (inst.audioCache == null || hasReferenceOptions(options) || getPromptId(options) != null) return null
+    val fingerprint = inst.modelFingerprint ?: return null
+    val parallel = getParallelSentences(options)
+    val params = if (inst.isZipvoice && parallel > 1) "silenceMs=${getSentenceSilenceMs(options)}" else ""
+    return TtsAudioCache.makeKey(fingerprint, text, sid, speed, params)
+  }
+
+  private fun concatChunks(chunks: List<FloatArray>): FloatArray {
+    val out = FloatArray(chunks.sumOf { it.size })
+    var offset = 0
+    for (c in chunks) {
+      c.copyInto(out, offset)
+      offset += c.size
+    }
+    return out
+  }
+
   private fun path(paths: Map<String, String>, key: String): String = paths[key].orEmpty()
 
   private fun buildTtsConfig(
@@ -1127,41 +2430,26 @@ internal class SherpaOnnxTtsHelper(
     val byteRate = sampleRate * numChannels * bitsPerSample / 8
     val blockAlign = numChannels * bitsPerSample / 8
     val dataSize = samples.size * 2
-    val chunkSize = 36 + dataSize
-    outputStream.write("RIFF".toByteArray(Charsets.US_ASCII))
-    writeIntLE(outputStream, chunkSize)
-    outputStream.write("WAVE".toByteArray(Charsets.US_ASCII))
-    outputStream.write("fmt ".toByteArray(Charsets.US_ASCII))
-    writeIntLE(outputStream, 16)
-    writeShortLE(outputStream, 1)
-    writeShortLE(outputStream, numChannels.toShort())
-    writeIntLE(outputStream, sampleRate)
-    writeIntLE(outputStream, byteRate)
-    writeShortLE(outputStream, blockAlign.toShort())
-    writeShortLE(outputStream, bitsPerSample.toShort())
-    outputStream.write("data".toByteArray(Charsets.US_ASCII))
-    writeIntLE(outputStream, dataSize)
-    for (sample in samples) {
-      val clamped = sample.coerceIn(-1.0f, 1.0f)
-      val intSample = (clamped * 32767.0f).toInt()
-      writeShortLE(outputStream, intSample.toShort())
-    }
+    val header = ByteBuffer.allocate(44).order(ByteOrder.LITTLE_ENDIAN)
+    header.put("RIFF".toByteArray(Charsets.US_ASCII))
+    header.putInt(36 + dataSize)
+    header.put("WAVE".toByteArray(Charsets.US_ASCII))
+    header.put("fmt ".toByteArray(Charsets.US_ASCII))
+    header.putInt(16)
+    header.putShort(1)
+    header.putShort(numChannels.toShort())
+    header.putInt(sampleRate)
+    header.putInt(byteRate)
+    header.putShort(blockAlign.toShort())
+    header.putShort(bitsPerSample.toShort())
+    header.put("data".toByteArray(Charsets.US_ASCII))
+    header.putInt(dataSize)
+    outputStream.write(header.array())
+    // Converted natively in one pass; a single write instead of two calls per sample.
+    outputStream.write(WavFileWriter.toPcm16(samples))
     outputStream.flush()
   }
 
-  private fun writeIntLE(outputStream: OutputStream, value: Int) {
-    outputStream.write(value and 0xFF)
-    outputStream.write((value shr 8) and 0xFF)
-    outputStream.write((value shr 16) and 0xFF)
-    outputStream.write((value shr 24) and 0xFF)
-  }
-
-  private fun writeShortLE(outputStream: OutputStream, value: Short) {
-    val intValue = value.toInt()
-    outputStream.write(intValue and 0xFF)
-    outputStream.write((intValue shr 8) and 0xFF)
-  }
-
   private fun copyStream(inputStream: InputStream, outputStream: OutputStream) {
     val buffer = ByteArray(8192)
     var bytes = inputStream.read(buffer)
@@ -0,0 +1,54 @@
+package com.sherpaonnx
+
+/**
+ * Decode ranges for transcribeLongFile, backed by sherpaonnx::SpeechRangeBuilder
+ * (sherpa-onnx-stt-long-form.cpp): VAD segments are padded, merged while they stay under
+ * [maxRangeSamples] and split above it. [push] returns ranges as soon as later segments can no
+ * longer change them, so decoding overlaps the VAD scan. Not thread-safe; call [release] when done.
+ */
+internal class SpeechRangeBuilder(paddingSamples: Long, maxRangeSamples: Long) {
+
+  /** Half-open sample range [start, end) of the source audio. */
+  class Range(val start: Long, val end: Long)
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-stt-long-form-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(paddingSamples: Long, maxRangeSamples: Long): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativePush(ptr: Long, start: Long, length: Long): LongArray?
+
+    @JvmStatic
+    private external fun nativeFinish(ptr: Long, totalSamples: Long): LongArray?
+
+    @JvmStatic
+    private external fun nativeJoinTexts(texts: Array<String>): String
+
+    /** Trim and join transcripts; no space between CJK characters. */
+    fun joinTexts(texts: List<String>): String = nativeJoinTexts(texts.toTypedArray())
+
+    private fun toRanges(flat: LongArray?): List<Range> =
+      if (flat == null) emptyList() else List(flat.size / 2) { Range(flat[2 * it], flat[2 * it + 1]) }
+  }
+
+  private var ptr: Long = nativeCreate(paddingSamples, maxRangeSamples)
+
+  /** Add the VAD segment [start, start + length); returns the ranges that are final now. */
+  fun push(start: Long, length: Long): List<Range> =
+    if (ptr != 0L) toRanges(nativePush(ptr, start, length)) else emptyList()
+
+  /** End of audio; returns the remaining ranges clamped to [totalSamples]. */
+  fun finish(totalSamples: Long): List<Range> =
+    if (ptr != 0L) toRanges(nativeFinish(ptr, totalSamples)) else emptyList()
+
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
@@ -0,0 +1,147 @@
+package com.sherpaonnx
+
+/**
+ * Candidate search of tuneStt, backed by sherpaonnx::SttAutoTuner (sherpa-onnx-stt-tuner.cpp):
+ * [next] hands out the recognizer configuration to time (cpu over a thread ladder, then the other
+ * providers, then the other quantization) and [report] takes its measurement; [best] is the winner
+ * in the stored [Choice] form. A process memory probe measures each candidate's peak. Not
+ * thread-safe; call [release] when done.
+ */
+internal class SttAutoTuner(
+  maxThreads: Int,
+  providers: List<String>,
+  hasInt8: Boolean,
+  hasFp32: Boolean,
+  maxMemoryBytes: Long,
+  tolerance: Double
+) {
+
+  class Candidate(val numThreads: Int, val provider: String, val int8: Boolean)
+
+  /** A winning configuration as stored across launches ([serialized]). */
+  class Choice(
+    val numThreads: Int,
+    val provider: String,
+    val int8: Boolean,
+    val rtf: Double,
+    val peakMemoryBytes: Long,
+    val serialized: String
+  )
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-stt-tuner-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(
+      maxThreads: Int,
+      providers: Array<String>,
+      hasInt8: Boolean,
+      hasFp32: Boolean,
+      maxMemoryBytes: Long,
+      tolerance: Double
+    ): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeNext(ptr: Long, out: IntArray): String?
+
+    @JvmStatic
+    private external fun nativeReport(
+      ptr: Long,
+      numThreads: Int,
+      provider: String,
+      int8: Boolean,
+      ok: Boolean,
+      error: String,
+      loadMs: Double,
+      decodeMs: Double,
+      audioMs: Double,
+      peakMemoryBytes: Long
+    )
+
+    @JvmStatic
+    private external fun nativeBest(ptr: Long): String?
+
+    @JvmStatic
+    private external fun nativeProbeBegin(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeProbeSample(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeProbePeak(ptr: Long): Long
+
+    @JvmStatic
+    private external fun nativeParse(text: String, out: DoubleArray): String?
+
+    @JvmStatic
+    private external fun nativeModelKey(modelDir: String, modelType: String): String
+
+    /** Stored choice from its serialized form; null if it does not parse. */
+    fun parseChoice(text: String): Choice? {
+      val out = DoubleArray(4)
+      val provider = nativeParse(text, out) ?: return null
+      return Choice(out[0].toInt(), provider, out[1] != 0.0, out[2], out[3].toLong(), text)
+    }
+
+    /** Model part of the storage key: directory, type and the size of its model files. */
+    fun modelKey(modelDir: String, modelType: String): String = nativeModelKey(modelDir, modelType)
+  }
+
+  private var ptr: Long = nativeCreate(
+    maxThreads,
+    providers.toTypedArray(),
+    hasInt8,
+    hasFp32,
+    maxMemoryBytes,
+    tolerance
+  )
+
+  /** Next configuration to measure; null when the search is done. */
+  fun next(): Candidate? {
+    if (ptr == 0L) return null
+    val out = IntArray(2)
+    val provider = nativeNext(ptr, out) ?: return null
+    return Candidate(out[0], provider, out[1] != 0)
+  }
+
+  /** Measurement of the candidate from the last [next]; [ok] false when it failed with [error]. */
+  fun report(
+    candidate: Candidate,
+    ok: Boolean,
+    error: String,
+    loadMs: Double,
+    decodeMs: Double,
+    audioMs: Double,
+    peakMemoryBytes: Long
+  ) {
+    if (ptr == 0L) return
+    nativeReport(
+      ptr, candidate.numThreads, candidate.provider, candidate.int8, ok, error,
+      loadMs, decodeMs, audioMs, peakMemoryBytes
+    )
+  }
+
+  /** Winner of the measurements so far; null when no candidate worked. */
+  fun best(): Choice? = if (ptr != 0L) nativeBest(ptr)?.let { parseChoice(it) } else null
+
+  /** Memory baseline for the next candidate. */
+  fun beginMemory() {
+    if (ptr != 0L) nativeProbeBegin(ptr)
+  }
+
+  fun sampleMemory() {
+    if (ptr != 0L) nativeProbeSample(ptr)
+  }
+
+  /** Peak growth since [beginMemory]; 0 when unknown. */
+  fun peakMemoryBytes(): Long = if (ptr != 0L) nativeProbePeak(ptr) else 0L
+
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
@@ -0,0 +1,28 @@
+package com.sherpaonnx
+
+/**
+ * Batching for transcribeFiles, backed by sherpaonnx::PlanSttBatches and EstimateAudioFileSeconds
+ * (sherpa-onnx-stt-batch-planner.cpp): durations come from file headers, so files are grouped by
+ * length before any of them is read in full.
+ */
+internal object SttBatchPlanner {
+
+  /** [batches] hold indices into the planned paths, longest first; [seconds] < 0 = unknown. */
+  class Plan(val seconds: DoubleArray, val batches: List<IntArray>)
+
+  // JNI native method (implemented in sherpa-onnx-stt-batch-planner-jni.cpp, loaded via libsherpaonnx)
+  @JvmStatic
+  private external fun nativePlan(paths: Array<String>, maxBatchSize: Int, maxPaddedSeconds: Double): Array<Any>?
+
+  /** Group [paths] into batches of at most [maxBatchSize] files and [maxPaddedSeconds] padded audio. */
+  fun plan(paths: Array<String>, maxBatchSize: Int, maxPaddedSeconds: Double): Plan {
+    val raw = nativePlan(paths, maxBatchSize, maxPaddedSeconds)
+      ?: return Plan(DoubleArray(paths.size) { -1.0 }, paths.indices.map { intArrayOf(it) })
+    val seconds = raw[0] as DoubleArray
+    val order = raw[1] as IntArray
+    val sizes = raw[2] as IntArray
+    var start = 0
+    val batches = sizes.map { size -> order.copyOfRange(start, start + size).also { start += size } }
+    return Plan(seconds, batches)
+  }
+}
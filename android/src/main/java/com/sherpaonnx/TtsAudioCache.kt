@@ -0,0 +1,103 @@
+package com.sherpaonnx
+
+import com.k2fsa.sherpa.onnx.GeneratedAudio
+
+/**
+ * Cache of synthesized TTS audio backed by sherpaonnx::TtsAudioCache (sherpa-onnx-tts-audio-cache.cpp).
+ *
+ * Entries are keyed by (model fingerprint, text, sid, speed, params). The memory tier is an LRU
+ * bounded in bytes; the optional disk tier keeps 16-bit PCM files in [configure]'s directory and
+ * survives app restarts. Thread-safe; call [release] when the owning TTS instance is unloaded.
+ */
+internal class TtsAudioCache {
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-tts-audio-cache-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeConfigure(ptr: Long, maxMemoryBytes: Long, diskDir: String, maxDiskBytes: Long)
+
+    @JvmStatic
+    private external fun nativeMakeKey(fingerprint: String, text: String, sid: Int, speed: Float, params: String): String
+
+    @JvmStatic
+    private external fun nativeModelFingerprint(modelDir: String, config: String): String
+
+    @JvmStatic
+    private external fun nativeGet(ptr: Long, key: String, sampleRateOut: IntArray): FloatArray?
+
+    @JvmStatic
+    private external fun nativePut(ptr: Long, key: String, samples: FloatArray, sampleRate: Int)
+
+    @JvmStatic
+    private external fun nativeClear(ptr: Long, includeDisk: Boolean)
+
+    @JvmStatic
+    private external fun nativeStats(ptr: Long): LongArray
+
+    /** Fingerprint of a loaded model (directory contents + serialized init config). */
+    fun modelFingerprint(modelDir: String, config: String): String = nativeModelFingerprint(modelDir, config)
+
+    /** Cache key; [params] carries any other generation option that changes the audio. */
+    fun makeKey(fingerprint: String, text: String, sid: Int, speed: Float, params: String = ""): String =
+      nativeMakeKey(fingerprint, text, sid, speed, params)
+  }
+
+  /** Snapshot of the native counters. */
+  data class Stats(
+    val memoryHits: Long,
+    val diskHits: Long,
+    val misses: Long,
+    val insertions: Long,
+    val evictions: Long,
+    val memoryBytes: Long,
+    val memoryEntries: Long,
+    val diskBytes: Long
+  )
+
+  @Volatile
+  private var ptr: Long = nativeCreate()
+
+  /** Set budgets and disk directory (empty = memory only). Evicts immediately if over budget. */
+  @Synchronized
+  fun configure(maxMemoryBytes: Long, diskDir: String, maxDiskBytes: Long) {
+    if (ptr != 0L) nativeConfigure(ptr, maxMemoryBytes, diskDir, maxDiskBytes)
+  }
+
+  @Synchronized
+  fun get(key: String): GeneratedAudio? {
+    if (ptr == 0L) return null
+    val rate = IntArray(1)
+    val samples = nativeGet(ptr, key, rate) ?: return null
+    return GeneratedAudio(samples, rate[0])
+  }
+
+  @Synchronized
+  fun put(key: String, samples: FloatArray, sampleRate: Int) {
+    if (ptr != 0L) nativePut(ptr, key, samples, sampleRate)
+  }
+
+  @Synchronized
+  fun clear(includeDisk: Boolean) {
+    if (ptr != 0L) nativeClear(ptr, includeDisk)
+  }
+
+  @Synchronized
+  fun stats(): Stats {
+    val s = if (ptr != 0L) nativeStats(ptr) else LongArray(8)
+    return Stats(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7])
+  }
+
+  @Synchronized
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
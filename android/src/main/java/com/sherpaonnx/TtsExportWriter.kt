@@ -0,0 +1,101 @@
+package com.sherpaonnx
+
+/**
+ * Encode side of batch TTS export, backed by sherpaonnx::TtsExportWriter
+ * (sherpa-onnx-tts-export-writer.cpp). [submit] hands a synthesized item to a native thread that
+ * writes it (WAV directly, MP3 / FLAC / ... through the FFmpeg convertToFormat path) while the
+ * caller synthesizes the next one; it only waits when the previous item has not started encoding.
+ *
+ * [tempo] != 1 is applied on the encoder thread; [outputSampleRateHz] is passed to the encoder as
+ * in convertAudioToFormat (0 = default). Call [finish] (or [cancel] then [finish]) and [release].
+ */
+internal class TtsExportWriter(tempo: Float = 1f, outputSampleRateHz: Int = 0) {
+
+  /** One written item: [error] is null on success. */
+  data class Result(
+    val index: Int,
+    val numSamples: Long,
+    val sampleRate: Int,
+    val encodeMs: Double,
+    val error: String?
+  )
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-tts-export-writer-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(tempo: Float, outputSampleRateHz: Int): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeSubmit(
+      ptr: Long,
+      index: Int,
+      samples: FloatArray,
+      sampleRate: Int,
+      path: String,
+      format: String
+    ): Boolean
+
+    @JvmStatic
+    private external fun nativeTakeCompleted(ptr: Long): Array<Any>?
+
+    @JvmStatic
+    private external fun nativeFinish(ptr: Long): Array<Any>?
+
+    @JvmStatic
+    private external fun nativeCancel(ptr: Long)
+
+    /** Object[] { double[4 * n] (index, numSamples, sampleRate, encodeMs), String[n] errors }. */
+    private fun toResults(raw: Array<Any>?): List<Result> {
+      if (raw == null || raw.size < 2) return emptyList()
+      val values = raw[0] as DoubleArray
+      @Suppress("UNCHECKED_CAST")
+      val errors = raw[1] as Array<String>
+      return errors.indices.map { i ->
+        Result(
+          index = values[i * 4].toInt(),
+          numSamples = values[i * 4 + 1].toLong(),
+          sampleRate = values[i * 4 + 2].toInt(),
+          encodeMs = values[i * 4 + 3],
+          error = errors[i].ifEmpty { null }
+        )
+      }
+    }
+  }
+
+  @Volatile
+  private var ptr: Long = nativeCreate(tempo, outputSampleRateHz)
+
+  /**
+   * Queue [samples] for [path]; [format] "" means the path's extension. Samples are copied once,
+   * so the array may be reused. Returns false after [finish] / [cancel].
+   */
+  fun submit(index: Int, samples: FloatArray, sampleRate: Int, path: String, format: String): Boolean {
+    val p = ptr
+    return p != 0L && nativeSubmit(p, index, samples, sampleRate, path, format)
+  }
+
+  /** Items written since the last call, in submit order. */
+  @Synchronized
+  fun takeCompleted(): List<Result> = if (ptr != 0L) toResults(nativeTakeCompleted(ptr)) else emptyList()
+
+  /** Wait for every submitted item; returns those not yet taken. */
+  @Synchronized
+  fun finish(): List<Result> = if (ptr != 0L) toResults(nativeFinish(ptr)) else emptyList()
+
+  /** Drop the queued item; the one being encoded still completes. */
+  fun cancel() {
+    val p = ptr
+    if (p != 0L) nativeCancel(p)
+  }
+
+  @Synchronized
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
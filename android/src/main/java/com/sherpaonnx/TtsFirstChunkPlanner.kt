@@ -0,0 +1,62 @@
+package com.sherpaonnx
+
+/**
+ * First-chunk fast path for streaming TTS, backed by sherpaonnx::FirstChunkPlanner and
+ * SplitLeadingClause (sherpa-onnx-tts-sentence-pipeline.cpp).
+ *
+ * [budget] turns a time-to-first-audio target into a byte budget for the leading clause, using a
+ * moving average of what previous first chunks on this engine actually cost ([observe]).
+ * Thread-safe; call [release] when the owning TTS engine is released.
+ */
+internal class TtsFirstChunkPlanner {
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-tts-first-chunk-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeBudget(ptr: Long, targetMs: Int): Int
+
+    @JvmStatic
+    private external fun nativeObserve(ptr: Long, chars: Int, elapsedMs: Long)
+
+    @JvmStatic
+    private external fun nativeSplit(text: String, maxChars: Int): Array<String>?
+
+    @JvmStatic
+    private external fun nativeSplitSentences(text: String): Array<String>?
+
+    /** Split a leading clause of at most [maxChars] UTF-8 bytes off [text]; null if not worthwhile. */
+    fun splitLeadingClause(text: String, maxChars: Int): Pair<String, String>? =
+      nativeSplit(text, maxChars)?.let { Pair(it[0], it[1]) }
+
+    /** Sentence pieces of [text] (SplitSentences); [text] itself when it has no split points. */
+    fun splitSentences(text: String): List<String> =
+      nativeSplitSentences(text)?.toList()?.takeIf { it.isNotEmpty() } ?: listOf(text)
+  }
+
+  @Volatile
+  private var ptr: Long = nativeCreate()
+
+  /** Leading-clause budget in UTF-8 bytes for [targetMs]; 0 disables the fast path. */
+  @Synchronized
+  fun budget(targetMs: Int): Int = if (ptr != 0L) nativeBudget(ptr, targetMs) else 0
+
+  /** Record the time-to-first-audio measured for a request whose leading clause was [head]. */
+  @Synchronized
+  fun observe(head: String, elapsedMs: Long) {
+    if (ptr != 0L) nativeObserve(ptr, head.toByteArray(Charsets.UTF_8).size, elapsedMs)
+  }
+
+  @Synchronized
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
@@ -0,0 +1,127 @@
+package com.sherpaonnx
+
+import com.facebook.react.bridge.Arguments
+import com.facebook.react.bridge.WritableMap
+import java.util.concurrent.locks.ReentrantReadWriteLock
+import kotlin.concurrent.read
+import kotlin.concurrent.write
+
+/**
+ * Jitter buffer between TTS generation and the PCM player's AudioTrack, backed by
+ * sherpaonnx::TtsPlaybackBuffer (sherpa-onnx-tts-playback-buffer.cpp). Writers push chunks of any
+ * size; the player thread [pull]s fixed [frameSamples] frames, getting silence while the buffer
+ * prefills to its adaptive target instead of starving AudioTrack. [setTempo] time-stretches what the
+ * player pulls (WSOLA, pitch kept), including audio that is already buffered.
+ *
+ * Thread-safe. [write] blocks while the buffer is full; [release] wakes it before freeing.
+ */
+internal class TtsPlaybackBuffer(val sampleRate: Int, val frameSamples: Int) {
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-tts-playback-buffer-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(sampleRate: Int, frameSamples: Int): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativePush(ptr: Long, samples: FloatArray, offset: Int, length: Int): Int
+
+    @JvmStatic
+    private external fun nativeWaitWritable(ptr: Long, n: Int, timeoutMs: Int): Boolean
+
+    @JvmStatic
+    private external fun nativePull(ptr: Long, frame: FloatArray): Int
+
+    @JvmStatic
+    private external fun nativeSetTempo(ptr: Long, tempo: Float)
+
+    @JvmStatic
+    private external fun nativeMarkEnd(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeClear(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeClose(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeStats(ptr: Long): LongArray?
+
+    /** Wait slice while full, so [write]'s stop condition is checked regularly. */
+    private const val WAIT_SLICE_MS = 50
+  }
+
+  // Read-held by every call (including a blocked write), write-held only to free the buffer.
+  private val lifetime = ReentrantReadWriteLock()
+
+  @Volatile
+  private var ptr: Long = nativeCreate(sampleRate, frameSamples)
+
+  @Volatile
+  var closed: Boolean = false
+    private set
+
+  /**
+   * Push [length] samples, waiting while the buffer is full. Returns the number pushed: less than
+   * [length] only if the buffer was closed or [stop] returned true.
+   */
+  fun write(samples: FloatArray, length: Int = samples.size, stop: () -> Boolean = { false }): Int =
+    lifetime.read {
+      var offset = 0
+      while (ptr != 0L && offset < length) {
+        offset += nativePush(ptr, samples, offset, length - offset)
+        if (offset < length && (!nativeWaitWritable(ptr, length - offset, WAIT_SLICE_MS) || stop())) break
+      }
+      offset
+    }
+
+  /** Fill [frame] for the sink (zero-padded); returns the number of audio samples in it. */
+  fun pull(frame: FloatArray): Int = lifetime.read { if (ptr != 0L) nativePull(ptr, frame) else 0 }
+
+  /** Playback speed of pulled frames (1 = as generated, clamped to 0.25..4). */
+  fun setTempo(tempo: Float) {
+    lifetime.read { if (ptr != 0L) nativeSetTempo(ptr, tempo) }
+  }
+
+  /** End of the current utterance: play the remainder without waiting for the target fill. */
+  fun markEnd() {
+    lifetime.read { if (ptr != 0L) nativeMarkEnd(ptr) }
+  }
+
+  /** Drop buffered audio (cancel). */
+  fun clear() {
+    lifetime.read { if (ptr != 0L) nativeClear(ptr) }
+  }
+
+  /** Underrun/overrun counters and fill levels, as returned by getTtsPlaybackStats. */
+  fun stats(): WritableMap {
+    val s = lifetime.read { if (ptr != 0L) nativeStats(ptr) else null } ?: LongArray(10)
+    val msPerSample = 1000.0 / sampleRate
+    return Arguments.createMap().apply {
+      putDouble("samplesIn", s[0].toDouble())
+      putDouble("samplesOut", s[1].toDouble())
+      putDouble("framesOut", s[2].toDouble())
+      putDouble("silentFrames", s[3].toDouble())
+      putDouble("underruns", s[4].toDouble())
+      putDouble("overruns", s[5].toDouble())
+      putDouble("bufferedMs", s[6] * msPerSample)
+      putDouble("targetMs", s[7] * msPerSample)
+      putDouble("maxBufferedMs", s[8] * msPerSample)
+      putBoolean("playing", s[9] != 0L)
+      putInt("frameSamples", frameSamples)
+    }
+  }
+
+  fun release() {
+    closed = true
+    lifetime.read { if (ptr != 0L) nativeClose(ptr) }
+    lifetime.write {
+      if (ptr != 0L) {
+        nativeDestroy(ptr)
+        ptr = 0L
+      }
+    }
+  }
+}
@@ -0,0 +1,170 @@
+package com.sherpaonnx
+
+import com.facebook.react.bridge.Arguments
+import com.facebook.react.bridge.WritableMap
+
+/**
+ * Per-instance TTS instrumentation, backed by sherpaonnx::TtsStatsRecorder
+ * (sherpa-onnx-tts-stats.cpp). A [Request] times one generation in Kotlin (time to first chunk,
+ * chunk sizes, PCM bytes copied across JNI and the bridge); [Request.finish] computes audio
+ * duration and RTF natively and adds the request to the instance's histograms.
+ * Thread-safe; call [release] when the owning instance is unloaded.
+ */
+internal class TtsStatsRecorder {
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-tts-stats-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeRecord(
+      ptr: Long,
+      timeToFirstChunkMs: Long,
+      synthesisMs: Long,
+      chunkSamples: IntArray,
+      totalSamples: Long,
+      sampleRate: Int,
+      bytesCopied: Long
+    ): DoubleArray?
+
+    @JvmStatic
+    private external fun nativeSnapshot(ptr: Long): DoubleArray?
+
+    @JvmStatic
+    private external fun nativeReset(ptr: Long)
+
+    private const val BYTES_PER_SAMPLE = 4L
+
+    /** Per-request stats as returned to JS (layout of nativeRecord). */
+    private fun requestStatsMap(s: DoubleArray): WritableMap = Arguments.createMap().apply {
+      putDouble("timeToFirstChunkMs", s[0])
+      putDouble("synthesisMs", s[1])
+      putDouble("audioMs", s[2])
+      putDouble("realTimeFactor", s[3])
+      putDouble("chunkCount", s[4])
+      putDouble("minChunkSamples", s[5])
+      putDouble("meanChunkSamples", s[6])
+      putDouble("maxChunkSamples", s[7])
+      putDouble("bytesCopied", s[8])
+    }
+
+    /** Reads one histogram (layout of AppendHistogram in the JNI) starting at [offset]. */
+    private fun histogramMap(s: DoubleArray, offset: Int): Pair<WritableMap, Int> {
+      val numBounds = s[offset + 7].toInt()
+      val bounds = Arguments.createArray()
+      val counts = Arguments.createArray()
+      var i = offset + 8
+      repeat(numBounds) { bounds.pushDouble(s[i++]) }
+      repeat(numBounds + 1) { counts.pushDouble(s[i++]) }
+      val map = Arguments.createMap().apply {
+        putDouble("count", s[offset])
+        putDouble("mean", s[offset + 1])
+        putDouble("min", s[offset + 2])
+        putDouble("max", s[offset + 3])
+        putDouble("p50", s[offset + 4])
+        putDouble("p90", s[offset + 5])
+        putDouble("p99", s[offset + 6])
+        putArray("upperBounds", bounds)
+        putArray("counts", counts)
+      }
+      return Pair(map, i)
+    }
+  }
+
+  /** Measurements of one generation. Not thread-safe: use it from the generating thread. */
+  inner class Request internal constructor() {
+    private var startNs = System.nanoTime()
+    private var engineAcquired = false
+    private var firstChunkNs = 0L
+    private var chunkSamples = IntArray(16)
+    private var chunkCount = 0
+    private var bytesCopied = 0L
+
+    /**
+     * Restart the clock once the request holds the engine, so the wait in the engine's queue
+     * (reported as queueWaitMs) is not counted as synthesis. Only the first call has an effect.
+     */
+    fun engineAcquired() {
+      if (engineAcquired) return
+      engineAcquired = true
+      startNs = System.nanoTime()
+    }
+
+    /**
+     * Count a chunk of [numSamples] handed out; [copies] is how many times its PCM crosses a
+     * boundary on the way to JS (a JNI float[] and the bridge array each count once).
+     */
+    fun chunk(numSamples: Int, copies: Int) {
+      if (numSamples <= 0) return
+      if (firstChunkNs == 0L) firstChunkNs = System.nanoTime()
+      if (chunkCount == chunkSamples.size) chunkSamples = chunkSamples.copyOf(chunkCount * 2)
+      chunkSamples[chunkCount++] = numSamples
+      bytesCopied += numSamples * BYTES_PER_SAMPLE * copies
+    }
+
+    /** Record the request and return its stats for the JS result (null once released). */
+    fun finish(totalSamples: Long, sampleRate: Int): WritableMap? {
+      val nowNs = System.nanoTime()
+      val timeToFirstChunkMs = if (firstChunkNs != 0L) (firstChunkNs - startNs) / 1_000_000 else -1L
+      val stats = record(
+        timeToFirstChunkMs, (nowNs - startNs) / 1_000_000, chunkSamples.copyOf(chunkCount),
+        totalSamples, sampleRate, bytesCopied
+      ) ?: return null
+      return requestStatsMap(stats)
+    }
+  }
+
+  @Volatile
+  private var ptr: Long = nativeCreate()
+
+  fun begin(): Request = Request()
+
+  @Synchronized
+  private fun record(
+    timeToFirstChunkMs: Long,
+    synthesisMs: Long,
+    chunkSamples: IntArray,
+    totalSamples: Long,
+    sampleRate: Int,
+    bytesCopied: Long
+  ): DoubleArray? {
+    if (ptr == 0L) return null
+    return nativeRecord(ptr, timeToFirstChunkMs, synthesisMs, chunkSamples, totalSamples, sampleRate, bytesCopied)
+  }
+
+  /** Aggregate stats since creation or [reset], as returned by getTtsStats. */
+  @Synchronized
+  fun snapshot(): WritableMap {
+    // A released recorder (ptr 0) reads as empty.
+    val s = nativeSnapshot(ptr) ?: return Arguments.createMap()
+    val map = Arguments.createMap()
+    map.putDouble("requests", s[0])
+    map.putDouble("totalAudioMs", s[1])
+    map.putDouble("totalSynthesisMs", s[2])
+    map.putDouble("bytesCopied", s[3])
+    var offset = 4
+    for (name in arrayOf("timeToFirstChunkMs", "synthesisMs", "realTimeFactor", "chunkSamples")) {
+      val (histogram, next) = histogramMap(s, offset)
+      map.putMap(name, histogram)
+      offset = next
+    }
+    return map
+  }
+
+  @Synchronized
+  fun reset() {
+    if (ptr != 0L) nativeReset(ptr)
+  }
+
+  @Synchronized
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
@@ -0,0 +1,47 @@
+package com.sherpaonnx
+
+/**
+ * Incremental text input for TTS text sessions, backed by sherpaonnx::IncrementalTextSegmenter
+ * (sherpa-onnx-tts-sentence-pipeline.cpp). Fragments go in as they arrive (e.g. LLM tokens);
+ * [push] returns the sentences and clauses they completed, ready to synthesize in order.
+ *
+ * [firstClauseChars] > 0 sets how soon the first segment may be cut at a clause (UTF-8 bytes).
+ * Thread-safe; call [release] when the session ends.
+ */
+internal class TtsTextSegmenter(firstClauseChars: Int = 0) {
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-tts-text-segmenter-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(firstClauseChars: Int): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativePush(ptr: Long, fragment: String): Array<String>?
+
+    @JvmStatic
+    private external fun nativeFlush(ptr: Long): Array<String>?
+  }
+
+  @Volatile
+  private var ptr: Long = nativeCreate(firstClauseChars)
+
+  /** Append [fragment]; returns the segments it completed (often none). */
+  @Synchronized
+  fun push(fragment: String): List<String> =
+    if (ptr != 0L) nativePush(ptr, fragment)?.toList().orEmpty() else emptyList()
+
+  /** Returns the pending text as a segment, even without a sentence end. */
+  @Synchronized
+  fun flush(): List<String> = if (ptr != 0L) nativeFlush(ptr)?.toList().orEmpty() else emptyList()
+
+  @Synchronized
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
@@ -0,0 +1,58 @@
+package com.sherpaonnx
+
+/**
+ * Pitch-preserving tempo change (WSOLA) for TTS audio, backed by sherpaonnx::WsolaTimeStretcher
+ * (sherpa-onnx-tts-time-stretch.cpp). Used for the `tempo` generation option: generated and cached
+ * audio is stretched after synthesis, so a speed change never re-runs the model and cached entries
+ * serve every tempo.
+ *
+ * An instance stretches one stream: [push] chunks as they are generated, [flush] at the end, then
+ * [release]. Not thread-safe; one stream thread owns it.
+ */
+internal class TtsTimeStretcher(sampleRate: Int, tempo: Float) {
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-tts-time-stretch-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeStretch(samples: FloatArray, sampleRate: Int, tempo: Float): FloatArray?
+
+    @JvmStatic
+    private external fun nativeCreate(sampleRate: Int, tempo: Float): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativePush(ptr: Long, samples: FloatArray, length: Int): FloatArray?
+
+    @JvmStatic
+    private external fun nativeFlush(ptr: Long): FloatArray?
+
+    /** True if [tempo] changes the audio at all. */
+    fun isActive(tempo: Float): Boolean = tempo > 0f && tempo != 1f
+
+    /** Stretch a whole clip; returns [samples] itself when [tempo] is 1 (or not positive). */
+    fun stretch(samples: FloatArray, sampleRate: Int, tempo: Float): FloatArray =
+      if (!isActive(tempo) || samples.isEmpty()) samples
+      else nativeStretch(samples, sampleRate, tempo) ?: samples
+  }
+
+  private var ptr: Long = nativeCreate(sampleRate, tempo)
+
+  /**
+   * Feed the first [length] samples of [chunk]; returns the stretched audio that is ready (about one
+   * 30 ms frame behind).
+   */
+  fun push(chunk: FloatArray, length: Int = chunk.size): FloatArray =
+    if (ptr != 0L) nativePush(ptr, chunk, length) ?: FloatArray(0) else FloatArray(0)
+
+  /** End of stream: the remaining stretched audio. */
+  fun flush(): FloatArray = if (ptr != 0L) nativeFlush(ptr) ?: FloatArray(0) else FloatArray(0)
+
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
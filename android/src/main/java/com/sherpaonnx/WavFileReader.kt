@@ -0,0 +1,104 @@
+package com.sherpaonnx
+
+/**
+ * Seekable WAV reader backed by sherpaonnx::WavFileReader (sherpa-onnx-wav-reader.cpp).
+ *
+ * Only the header is parsed on [open] and the file is memory-mapped; [read] converts any frame
+ * range to mono float window by window (NEON for 16-bit PCM), so neither long recordings nor
+ * whole-file reads hold the file bytes next to the float samples. Methods are synchronized; use one
+ * reader per thread for parallel reads and call [release] when done.
+ */
+internal class WavFileReader {
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-wav-reader-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeOpen(ptr: Long, path: String): String?
+
+    @JvmStatic
+    private external fun nativeInfo(ptr: Long): LongArray?
+
+    @JvmStatic
+    private external fun nativeRead(ptr: Long, start: Long, out: FloatArray, count: Int): Int
+
+    @JvmStatic
+    private external fun nativeClose(ptr: Long)
+
+    @JvmStatic
+    private external fun nativePcmToFloat(bytes: ByteArray, encoding: Int): FloatArray?
+
+    /** Must match sherpaonnx::PcmEncoding. */
+    const val PCM_INT16 = 0
+    const val PCM_FLOAT32 = 1
+
+    /**
+     * Raw mono little-endian PCM ([PCM_INT16] or [PCM_FLOAT32]) as float samples, converted in one
+     * native pass (NEON for int16). A trailing partial sample is ignored.
+     */
+    fun pcmToFloat(bytes: ByteArray, encoding: Int): FloatArray =
+      nativePcmToFloat(bytes, encoding) ?: throw OutOfMemoryError("Could not allocate PCM sample buffer")
+
+    /** Whole file as mono float with its sample rate, or null when [path] is not a supported WAV. */
+    fun readMono(path: String): Pair<FloatArray, Int>? {
+      val reader = WavFileReader()
+      try {
+        if (reader.open(path) != null || reader.numFrames > Int.MAX_VALUE) return null
+        return reader.read(0, reader.numFrames.toInt()) to reader.sampleRate
+      } finally {
+        reader.release()
+      }
+    }
+  }
+
+  @Volatile
+  private var ptr: Long = nativeCreate()
+
+  var sampleRate: Int = 0
+    private set
+  var numChannels: Int = 0
+    private set
+  /** Frames (samples per channel) in the data chunk. */
+  var numFrames: Long = 0L
+    private set
+
+  /** Parse the header of [path]. Returns null on success, otherwise why the file is unsupported. */
+  @Synchronized
+  fun open(path: String): String? {
+    if (ptr == 0L) return "Reader released"
+    val error = nativeOpen(ptr, path)
+    val info = if (error == null) nativeInfo(ptr) else null
+    sampleRate = info?.get(0)?.toInt() ?: 0
+    numChannels = info?.get(1)?.toInt() ?: 0
+    numFrames = info?.get(2) ?: 0L
+    return error
+  }
+
+  /** Read [count] frames from [start] as mono float; shorter at the end of the file. */
+  @Synchronized
+  fun read(start: Long, count: Int): FloatArray {
+    val out = FloatArray(count.coerceAtLeast(0))
+    val got = if (ptr != 0L) nativeRead(ptr, start, out, out.size) else -1
+    if (got < 0) throw java.io.IOException("Failed to read WAV samples at frame $start")
+    return if (got == out.size) out else out.copyOf(got)
+  }
+
+  @Synchronized
+  fun close() {
+    if (ptr != 0L) nativeClose(ptr)
+  }
+
+  /** Closes the file and frees the native reader. */
+  @Synchronized
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
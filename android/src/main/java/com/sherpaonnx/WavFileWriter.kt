@@ -0,0 +1,78 @@
+package com.sherpaonnx
+
+/**
+ * Streaming 16-bit PCM WAV writer backed by sherpaonnx::WavWriter (sherpa-onnx-wav-writer.cpp).
+ *
+ * [open] writes a header with placeholder sizes, [append] converts float chunks with NEON/SSE and
+ * writes them in large blocks, [finish] patches the sizes and closes the file. Methods are
+ * synchronized; call [release] when done.
+ */
+internal class WavFileWriter {
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-wav-writer-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeOpen(ptr: Long, path: String, sampleRate: Int, numChannels: Int): Boolean
+
+    @JvmStatic
+    private external fun nativeAppend(ptr: Long, samples: FloatArray, offset: Int, count: Int): Boolean
+
+    @JvmStatic
+    private external fun nativeFinalize(ptr: Long): Boolean
+
+    @JvmStatic
+    private external fun nativeNumSamples(ptr: Long): Long
+
+    @JvmStatic
+    private external fun nativeToPcm16(samples: FloatArray): ByteArray?
+
+    /** Convert [samples] to 16-bit little-endian PCM (clamped, scaled by 32767, truncated). */
+    fun toPcm16(samples: FloatArray): ByteArray =
+      nativeToPcm16(samples) ?: throw IllegalStateException("Failed to convert samples to PCM16")
+
+    /** Write [samples] as a mono WAV file at [path]. Returns false on any I/O error. */
+    fun writeFile(path: String, samples: FloatArray, sampleRate: Int): Boolean {
+      val writer = WavFileWriter()
+      try {
+        return writer.open(path, sampleRate) && writer.append(samples) && writer.finish()
+      } finally {
+        writer.release()
+      }
+    }
+  }
+
+  @Volatile
+  private var ptr: Long = nativeCreate()
+
+  /** Create or truncate [path] and write the header; finishes any file already open. */
+  @Synchronized
+  fun open(path: String, sampleRate: Int, numChannels: Int = 1): Boolean =
+    ptr != 0L && nativeOpen(ptr, path, sampleRate, numChannels)
+
+  @Synchronized
+  fun append(samples: FloatArray, offset: Int = 0, count: Int = samples.size - offset): Boolean =
+    ptr != 0L && nativeAppend(ptr, samples, offset, count)
+
+  /** Flush, patch the header sizes and close. Safe to call more than once. */
+  @Synchronized
+  fun finish(): Boolean = ptr != 0L && nativeFinalize(ptr)
+
+  /** Samples appended since [open] (all channels). */
+  @Synchronized
+  fun numSamples(): Long = if (ptr != 0L) nativeNumSamples(ptr) else 0L
+
+  /** Finishes an open file and frees the native writer. */
+  @Synchronized
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
@@ -0,0 +1,112 @@
+package com.sherpaonnx
+
+import com.facebook.react.bridge.Arguments
+import com.facebook.react.bridge.WritableMap
+
+/**
+ * Deadline-aware flow-step count for Zipvoice voice cloning, backed by
+ * sherpaonnx::ZipvoiceStepPlanner (sherpa-onnx-tts-step-planner.cpp).
+ *
+ * Holds a per-engine cost model (ms per flow step and fixed cost, per second of features) from
+ * [calibrate] or from the first [observe]d request; [choose] returns the largest step count
+ * predicted to fit a latency budget. [serialize] / [restore] keep a calibration across launches.
+ * Thread-safe; call [release] when the owning engine is released.
+ */
+internal class ZipvoiceStepPlanner {
+
+  /** A step count for a request, with its predicted time (< 0 when there is no model yet). */
+  data class Choice(val numSteps: Int, val predictedMs: Double, val fits: Boolean)
+
+  companion object {
+    // JNI native methods (implemented in sherpa-onnx-tts-step-planner-jni.cpp, loaded via libsherpaonnx)
+    @JvmStatic
+    private external fun nativeCreate(): Long
+
+    @JvmStatic
+    private external fun nativeDestroy(ptr: Long)
+
+    @JvmStatic
+    private external fun nativeFlowSeconds(textBytes: Int, promptTextBytes: Int, promptSeconds: Double, speed: Float): Double
+
+    @JvmStatic
+    private external fun nativeChoose(ptr: Long, budgetMs: Double, flowSeconds: Double, maxSteps: Int): DoubleArray?
+
+    @JvmStatic
+    private external fun nativePredictMs(ptr: Long, flowSeconds: Double, numSteps: Int): Double
+
+    @JvmStatic
+    private external fun nativeObserve(ptr: Long, flowSeconds: Double, numSteps: Int, elapsedMs: Double)
+
+    @JvmStatic
+    private external fun nativeCalibrate(
+      ptr: Long, flowSeconds: Double, stepsLo: Int, msLo: Double, stepsHi: Int, msHi: Double
+    ): Boolean
+
+    @JvmStatic
+    private external fun nativeModel(ptr: Long): DoubleArray?
+
+    @JvmStatic
+    private external fun nativeSerialize(ptr: Long): String?
+
+    @JvmStatic
+    private external fun nativeRestore(ptr: Long, text: String): Boolean
+
+    /**
+     * Seconds of features Zipvoice runs the flow over for [textBytes] of text (UTF-8) with a prompt
+     * of [promptSeconds] whose transcript is [promptTextBytes] long.
+     */
+    fun flowSeconds(textBytes: Int, promptTextBytes: Int, promptSeconds: Double, speed: Float): Double =
+      nativeFlowSeconds(textBytes, promptTextBytes, promptSeconds, speed)
+  }
+
+  @Volatile
+  private var ptr: Long = nativeCreate()
+
+  /** Largest step count (up to [maxSteps]; <= 0 = planner default) predicted to fit [budgetMs]. */
+  @Synchronized
+  fun choose(budgetMs: Double, flowSeconds: Double, maxSteps: Int): Choice {
+    val c = if (ptr != 0L) nativeChoose(ptr, budgetMs, flowSeconds, maxSteps) else null
+    return if (c != null) Choice(c[0].toInt(), c[1], c[2] != 0.0) else Choice(maxSteps, -1.0, true)
+  }
+
+  @Synchronized
+  fun predictMs(flowSeconds: Double, numSteps: Int): Double =
+    if (ptr != 0L) nativePredictMs(ptr, flowSeconds, numSteps) else -1.0
+
+  @Synchronized
+  fun observe(flowSeconds: Double, numSteps: Int, elapsedMs: Double) {
+    if (ptr != 0L) nativeObserve(ptr, flowSeconds, numSteps, elapsedMs)
+  }
+
+  /** Fit the model from one request timed at two step counts; false if the timings are unusable. */
+  @Synchronized
+  fun calibrate(flowSeconds: Double, stepsLo: Int, msLo: Double, stepsHi: Int, msHi: Double): Boolean =
+    ptr != 0L && nativeCalibrate(ptr, flowSeconds, stepsLo, msLo, stepsHi, msHi)
+
+  /** The cost model as returned by getTtsStepCalibration. */
+  @Synchronized
+  fun model(): WritableMap {
+    val m = (if (ptr != 0L) nativeModel(ptr) else null) ?: DoubleArray(5)
+    return Arguments.createMap().apply {
+      putBoolean("calibrated", m[3] != 0.0)
+      putDouble("overheadMsPerSecond", m[0])
+      putDouble("stepMsPerSecond", m[1])
+      putDouble("scale", m[2])
+      putDouble("observations", m[4])
+    }
+  }
+
+  @Synchronized
+  fun serialize(): String? = if (ptr != 0L) nativeSerialize(ptr) else null
+
+  @Synchronized
+  fun restore(text: String): Boolean = ptr != 0L && nativeRestore(ptr, text)
+
+  @Synchronized
+  fun release() {
+    if (ptr != 0L) {
+      nativeDestroy(ptr)
+      ptr = 0L
+    }
+  }
+}
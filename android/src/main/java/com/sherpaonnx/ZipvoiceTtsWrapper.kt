@@ -2,6 +2,7 @@ package com.sherpaonnx
 
 import android.util.Log
 import com.k2fsa.sherpa.onnx.GeneratedAudio
+import java.nio.ByteBuffer
 
 /**
  * Kotlin wrapper for Zipvoice TTS via the sherpa-onnx C-API.
@@ -13,7 +14,42 @@ import com.k2fsa.sherpa.onnx.GeneratedAudio
  * The public API intentionally mirrors [com.k2fsa.sherpa.onnx.OfflineTts] so that
  * [SherpaOnnxTtsHelper] can dispatch to either engine transparently.
  */
-internal class ZipvoiceTtsWrapper private constructor(private var ptr: Long) {
+internal class ZipvoiceTtsWrapper private constructor(
+  private var ptr: Long,
+  private val createArgs: CreateArgs
+) {
+
+  /** Arguments passed to nativeCreate; kept so extra engines for [generateParallel] match the first. */
+  private data class CreateArgs(
+    val tokens: String, val encoder: String, val decoder: String, val vocoder: String,
+    val dataDir: String, val lexicon: String,
+    val featScale: Float, val tShift: Float, val targetRms: Float, val guidanceScale: Float,
+    val numThreads: Int, val debug: Boolean,
+    val ruleFsts: String, val ruleFars: String, val maxNumSentences: Int, val silenceScale: Float,
+    val provider: String
+  ) {
+    fun create(): Long = nativeCreate(
+      tokens, encoder, decoder, vocoder, dataDir, lexicon,
+      featScale, tShift, targetRms, guidanceScale,
+      numThreads, debug,
+      ruleFsts, ruleFars, maxNumSentences, silenceScale,
+      provider
+    )
+  }
+
+  /** Extra engines for sentence-parallel generation, created on first use. */
+  private val extraEngines = mutableListOf<Long>()
+
+  /** Flow-step planner for latency budgets on voice cloning; cost is per engine. */
+  val stepPlanner = ZipvoiceStepPlanner()
+
+  /**
+   * Native prompt registry for [registerPrompt] / [generateWithPrompt], created on first use. The
+   * wrapper is shared by every instance loaded with the same model, so prompts are scoped by owner
+   * (the instance id).
+   */
+  @Volatile
+  private var promptRegistry = 0L
 
   companion object {
     private const val TAG = "ZipvoiceTts"
@@ -42,18 +78,19 @@ internal class ZipvoiceTtsWrapper private constructor(private var ptr: Long) {
       silenceScale: Float = 0.2f,
       provider: String = "cpu"
     ): ZipvoiceTtsWrapper? {
-      val p = nativeCreate(
+      val args = CreateArgs(
         tokens, encoder, decoder, vocoder, dataDir, lexicon,
         featScale, tShift, targetRms, guidanceScale,
         numThreads, debug,
         ruleFsts, ruleFars, maxNumSentences, silenceScale,
         provider
       )
+      val p = args.create()
       if (p == 0L) {
         Log.e(TAG, "nativeCreate returned 0 — failed to create Zipvoice TTS engine")
         return null
       }
-      return ZipvoiceTtsWrapper(p)
+      return ZipvoiceTtsWrapper(p, args)
     }
 
     // JNI native methods (implemented in sherpa-onnx-tts-zipvoice-jni.cpp, loaded via libsherpaonnx)
@@ -79,17 +116,58 @@ internal class ZipvoiceTtsWrapper private constructor(private var ptr: Long) {
     @JvmStatic
     private external fun nativeGenerate(ptr: Long, text: String, sid: Int, speed: Float): Array<Any>?
 
+    @JvmStatic
+    private external fun nativeWarmUp(ptr: Long): Long
+
     @JvmStatic
     private external fun nativeGenerateWithZipvoice(
       ptr: Long, text: String, promptText: String,
       promptSamples: FloatArray, promptSr: Int,
       speed: Float, numSteps: Int
     ): Array<Any>?
+
+    @JvmStatic
+    private external fun nativeCreatePromptRegistry(targetSr: Int): Long
+
+    @JvmStatic
+    private external fun nativeDestroyPromptRegistry(registryPtr: Long)
+
+    @JvmStatic
+    private external fun nativeRegisterPrompt(
+      registryPtr: Long, owner: String, promptText: String, promptSamples: FloatArray, promptSr: Int
+    ): Long
+
+    @JvmStatic
+    private external fun nativeUnregisterPrompt(registryPtr: Long, owner: String, promptId: Long): Boolean
+
+    @JvmStatic
+    private external fun nativeUnregisterPrompts(registryPtr: Long, owner: String): Int
+
+    @JvmStatic
+    private external fun nativePromptInfo(registryPtr: Long, owner: String, promptId: Long): DoubleArray?
+
+    @JvmStatic
+    private external fun nativeGenerateWithPrompt(
+      ptr: Long, registryPtr: Long, owner: String, text: String, promptId: Long,
+      speed: Float, numSteps: Int
+    ): Array<Any>?
   }
 
   // Instance method: JNI calls onNativeChunk on this object during generation
   private external fun nativeGenerateWithCallback(ptr: Long, text: String, sid: Int, speed: Float): Array<Any>?
 
+  // Instance method: JNI calls onNativeChunk on this object (in sentence order) when streaming
+  private external fun nativeGenerateParallel(
+    ptrs: LongArray, leadingClause: String, text: String, sid: Int, speed: Float,
+    silenceMs: Int, streamChunks: Boolean
+  ): Array<Any>?
+
+  // Instance method: JNI calls onNativeRingData on this object after each write into the ring
+  private external fun nativeGenerateWithRing(
+    ptr: Long, text: String, sid: Int, speed: Float,
+    ring: ByteBuffer, returnAudio: Boolean
+  ): Array<Any>?
+
   fun sampleRate(): Int {
     check(ptr != 0L) { "ZipvoiceTtsWrapper already released" }
     return nativeGetSampleRate(ptr)
@@ -100,6 +178,15 @@ internal class ZipvoiceTtsWrapper private constructor(private var ptr: Long) {
     return nativeGetNumSpeakers(ptr)
   }
 
+  /**
+   * Synthesize a short phrase and discard it so the first real request does not pay for
+   * ONNX Runtime's lazy initialization. Returns elapsed ms, or -1 on failure.
+   */
+  fun warmUp(): Long {
+    check(ptr != 0L) { "ZipvoiceTtsWrapper already released" }
+    return nativeWarmUp(ptr)
+  }
+
   /**
    * Generate audio from text (non-zero-shot, standard TTS).
    * Mirrors [com.k2fsa.sherpa.onnx.OfflineTts.generate].
@@ -131,6 +218,76 @@ internal class ZipvoiceTtsWrapper private constructor(private var ptr: Long) {
     return parseAudioResult(result)
   }
 
+  /**
+   * Long-text mode: split [text] into sentences and synthesize them on up to [numEngines] engines in
+   * parallel, reassembling audio in order with [silenceMs] of silence between sentences. Extra
+   * engines are created on first use and kept until [release]; each one holds a full copy of the
+   * model, so only raise [numEngines] when memory allows.
+   *
+   * If [callback] is given, audio is delivered in order as soon as each prefix of sentences is
+   * complete (return 0 to cancel) and the returned audio has no samples. A non-empty
+   * [leadingClause] (see [TtsFirstChunkPlanner]) is synthesized first, without silence after it.
+   */
+  fun generateParallel(
+    text: String,
+    sid: Int = 0,
+    speed: Float = 1.0f,
+    numEngines: Int = 2,
+    silenceMs: Int = 0,
+    leadingClause: String = "",
+    callback: ((FloatArray) -> Int)? = null
+  ): GeneratedAudio {
+    check(ptr != 0L) { "ZipvoiceTtsWrapper already released" }
+    val ptrs = acquireEngines(numEngines)
+    this.streamCallback = callback
+    try {
+      val result = nativeGenerateParallel(ptrs, leadingClause, text, sid, speed, silenceMs, callback != null)
+        ?: throw RuntimeException("Zipvoice TTS generateParallel returned null")
+      return parseAudioResult(result)
+    } finally {
+      this.streamCallback = null
+    }
+  }
+
+  @Synchronized
+  private fun acquireEngines(numEngines: Int): LongArray {
+    while (extraEngines.size + 1 < numEngines) {
+      val p = createArgs.create()
+      if (p == 0L) {
+        Log.w(TAG, "Could not create extra engine ${extraEngines.size + 1}; using ${extraEngines.size + 1} engine(s)")
+        break
+      }
+      extraEngines.add(p)
+    }
+    val count = minOf(maxOf(numEngines, 1), extraEngines.size + 1)
+    return LongArray(count) { i -> if (i == 0) ptr else extraEngines[i - 1] }
+  }
+
+  /**
+   * Generate audio streaming chunks into [ring] without per-chunk allocation.
+   * [onData] runs on the generating thread after each write with the number of readable samples;
+   * drain [ring] there (or on another thread) and return false to cancel. When [returnAudio] is
+   * false the final concatenated audio is not copied back and the result has no samples.
+   */
+  fun generateToRing(
+    text: String,
+    sid: Int = 0,
+    speed: Float = 1.0f,
+    ring: PcmRingBuffer,
+    returnAudio: Boolean = false,
+    onData: (Int) -> Boolean
+  ): GeneratedAudio {
+    check(ptr != 0L) { "ZipvoiceTtsWrapper already released" }
+    this.ringCallback = onData
+    try {
+      val result = nativeGenerateWithRing(ptr, text, sid, speed, ring.buffer, returnAudio)
+        ?: throw RuntimeException("Zipvoice TTS generateToRing returned null")
+      return parseAudioResult(result)
+    } finally {
+      this.ringCallback = null
+    }
+  }
+
   /**
    * Zero-shot voice cloning with a reference prompt.
    *
@@ -155,7 +312,65 @@ internal class ZipvoiceTtsWrapper private constructor(private var ptr: Long) {
     return parseAudioResult(result)
   }
 
+  /**
+   * Register a reference prompt for repeated voice cloning. The prompt is copied and resampled to
+   * the model rate once, natively; later generations by the same [owner] pass only the returned id.
+   *
+   * @param owner  Instance id the prompt belongs to; other owners cannot use or remove it.
+   * @return the prompt id (> 0).
+   */
+  @Synchronized
+  fun registerPrompt(owner: String, promptText: String, promptSamples: FloatArray, promptSr: Int): Long {
+    check(ptr != 0L) { "ZipvoiceTtsWrapper already released" }
+    if (promptRegistry == 0L) promptRegistry = nativeCreatePromptRegistry(nativeGetSampleRate(ptr))
+    val id = nativeRegisterPrompt(promptRegistry, owner, promptText, promptSamples, promptSr)
+    require(id > 0L) { "Invalid prompt: referenceAudio must be non-empty with a positive sample rate" }
+    return id
+  }
+
+  /** Forget one of [owner]'s prompts. Returns false if [owner] has no prompt [promptId]. */
+  @Synchronized
+  fun unregisterPrompt(owner: String, promptId: Long): Boolean =
+    promptRegistry != 0L && nativeUnregisterPrompt(promptRegistry, owner, promptId)
+
+  /** Forget all of [owner]'s prompts; called when that instance releases the shared engine. */
+  @Synchronized
+  fun unregisterPrompts(owner: String): Int =
+    if (promptRegistry != 0L) nativeUnregisterPrompts(promptRegistry, owner) else 0
+
+  /** Duration in seconds and transcript UTF-8 length of one of [owner]'s prompts; null if unknown. */
+  fun promptInfo(owner: String, promptId: Long): Pair<Double, Int>? {
+    if (promptRegistry == 0L) return null
+    return nativePromptInfo(promptRegistry, owner, promptId)?.let { Pair(it[0], it[1].toInt()) }
+  }
+
+  /**
+   * Zero-shot voice cloning with a prompt [owner] got from [registerPrompt].
+   * Same as [generateWithZipvoice] without passing the prompt again.
+   */
+  fun generateWithPrompt(
+    owner: String,
+    text: String,
+    promptId: Long,
+    speed: Float = 1.0f,
+    numSteps: Int = 20
+  ): GeneratedAudio {
+    check(ptr != 0L) { "ZipvoiceTtsWrapper already released" }
+    require(promptRegistry != 0L) { "Unknown voice prompt id: $promptId" }
+    val result = nativeGenerateWithPrompt(ptr, promptRegistry, owner, text, promptId, speed, numSteps)
+      ?: throw RuntimeException("Zipvoice TTS generateWithPrompt failed (unknown prompt id $promptId?)")
+    return parseAudioResult(result)
+  }
+
+  @Synchronized
   fun release() {
+    stepPlanner.release()
+    if (promptRegistry != 0L) {
+      nativeDestroyPromptRegistry(promptRegistry)
+      promptRegistry = 0L
+    }
+    extraEngines.forEach { nativeDestroy(it) }
+    extraEngines.clear()
     if (ptr != 0L) {
       nativeDestroy(ptr)
       ptr = 0L
@@ -177,6 +392,19 @@ internal class ZipvoiceTtsWrapper private constructor(private var ptr: Long) {
     return cb(samples) != 0
   }
 
+  @Volatile
+  private var ringCallback: ((Int) -> Boolean)? = null
+
+  /**
+   * Invoked from C++ after samples were written into the ring (nativeGenerateWithRing).
+   * @return true to continue generating, false to cancel.
+   */
+  @Suppress("unused") // Called from JNI
+  fun onNativeRingData(readable: Int): Boolean {
+    val cb = ringCallback ?: return false
+    return cb(readable)
+  }
+
   // -- Internal helpers --
 
   private fun parseAudioResult(result: Array<Any>): GeneratedAudio {
@@ -37,6 +37,32 @@ static sherpaonnx::OnlineSttWrapper* getOnlineSttInstanceForStream(NSString* str
     return (it != g_online_stt_instances.end() && it->second != nullptr) ? it->second.get() : nullptr;
 }
 
+/** Optional resultFields bridge argument -> SttResultField mask (nil = every field). */
+static uint32_t onlineSttResultFields(NSNumber *resultFields) {
+    return sherpaonnx::SttResultFieldsFromArg(resultFields != nil ? [resultFields doubleValue] : 0, resultFields != nil);
+}
+
+/** text plus tokens / timestamps when requested: partials usually only need text. */
+static NSMutableDictionary* onlineSttResultToDict(const sherpaonnx::OnlineSttStreamResult& r, uint32_t fields) {
+    NSMutableDictionary* dict = [NSMutableDictionary dictionaryWithCapacity:4];
+    dict[@"text"] = [NSString stringWithUTF8String:r.text.c_str()] ?: @"";
+    if (fields & sherpaonnx::kSttResultTokens) {
+        NSMutableArray* tokens = [NSMutableArray arrayWithCapacity:r.tokens.size()];
+        for (const auto& t : r.tokens) {
+            [tokens addObject:[NSString stringWithUTF8String:t.c_str()]];
+        }
+        dict[@"tokens"] = tokens;
+    }
+    if (fields & sherpaonnx::kSttResultTimestamps) {
+        NSMutableArray* timestamps = [NSMutableArray arrayWithCapacity:r.timestamps.size()];
+        for (float ts : r.timestamps) {
+            [timestamps addObject:@(ts)];
+        }
+        dict[@"timestamps"] = timestamps;
+    }
+    return dict;
+}
+
 
 @implementation SherpaOnnx (OnlineSTT)
 
@@ -216,6 +242,7 @@ static sherpaonnx::OnlineSttWrapper* getOnlineSttInstanceForStream(NSString* str
 }
 
 - (void)getSttStreamResult:(NSString *)streamId
+              resultFields:(NSNumber *)resultFields
                    resolve:(RCTPromiseResolveBlock)resolve
                     reject:(RCTPromiseRejectBlock)reject
 {
@@ -225,20 +252,8 @@ static sherpaonnx::OnlineSttWrapper* getOnlineSttInstanceForStream(NSString* str
         return;
     }
     std::string streamIdStr = [streamId UTF8String];
-    sherpaonnx::OnlineSttStreamResult r = wrapper->getResult(streamIdStr);
-    NSMutableArray* tokens = [NSMutableArray arrayWithCapacity:r.tokens.size()];
-    for (const auto& t : r.tokens) {
-        [tokens addObject:[NSString stringWithUTF8String:t.c_str()]];
-    }
-    NSMutableArray* timestamps = [NSMutableArray arrayWithCapacity:r.timestamps.size()];
-    for (float ts : r.timestamps) {
-        [timestamps addObject:@(ts)];
-    }
-    resolve(@{
-        @"text": [NSString stringWithUTF8String:r.text.c_str()] ?: @"",
-        @"tokens": tokens,
-        @"timestamps": timestamps
-    });
+    const uint32_t fields = onlineSttResultFields(resultFields);
+    resolve(onlineSttResultToDict(wrapper->getResult(streamIdStr, fields), fields));
 }
 
 - (void)isSttStreamEndpoint:(NSString *)streamId
@@ -314,6 +329,7 @@ static sherpaonnx::OnlineSttWrapper* getOnlineSttInstanceForStream(NSString* str
 - (void)processSttAudioChunk:(NSString *)streamId
                      samples:(NSArray *)samples
                   sampleRate:(double)sampleRate
+                resultFields:(NSNumber *)resultFields
                      resolve:(RCTPromiseResolveBlock)resolve
                       reject:(RCTPromiseRejectBlock)reject
 {
@@ -344,22 +360,10 @@ static sherpaonnx::OnlineSttWrapper* getOnlineSttInstanceForStream(NSString* str
     while (wrapper->isReady(streamIdStr)) {
         wrapper->decode(streamIdStr);
     }
-    sherpaonnx::OnlineSttStreamResult r = wrapper->getResult(streamIdStr);
-    BOOL isEndpoint = wrapper->isEndpoint(streamIdStr);
-    NSMutableArray* tokens = [NSMutableArray arrayWithCapacity:r.tokens.size()];
-    for (const auto& t : r.tokens) {
-        [tokens addObject:[NSString stringWithUTF8String:t.c_str()]];
-    }
-    NSMutableArray* timestamps = [NSMutableArray arrayWithCapacity:r.timestamps.size()];
-    for (float ts : r.timestamps) {
-        [timestamps addObject:@(ts)];
-    }
-    resolve(@{
-        @"text": [NSString stringWithUTF8String:r.text.c_str()] ?: @"",
-        @"tokens": tokens,
-        @"timestamps": timestamps,
-        @"isEndpoint": @(isEndpoint)
-    });
+    const uint32_t fields = onlineSttResultFields(resultFields);
+    NSMutableDictionary* dict = onlineSttResultToDict(wrapper->getResult(streamIdStr, fields), fields);
+    dict[@"isEndpoint"] = @(wrapper->isEndpoint(streamIdStr));
+    resolve(dict);
 }
 
 @end
@@ -6,10 +6,19 @@
  */
 
 #import "SherpaOnnx.h"
+#import "SherpaOnnxAudioConvert.h"
 #import <React/RCTLog.h>
 
 #include "sherpa-onnx-stt-wrapper.h"
 #include "sherpa-onnx-model-detect.h"
+#include "sherpa-onnx-file-prefetch.h"
+#include "sherpa-onnx-stt-tuner.h"
+#include "sherpa-onnx-wav-reader.h"
+#include <sys/sysctl.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -17,13 +26,121 @@
 #include <unordered_map>
 #include <vector>
 
+/**
+ * Outcome of the recognizer load started by initializeStt. With loadOptions.background,
+ * initializeStt resolves before the load is done and waitForSttReady promises queue in waiters.
+ * Guarded by g_stt_mutex.
+ */
+struct SttLoadState {
+    bool done = false;
+    NSDictionary *result = nil;
+    NSString *errorCode = nil;
+    NSString *errorMessage = nil;
+    std::vector<std::pair<RCTPromiseResolveBlock, RCTPromiseRejectBlock>> waiters;
+};
+
 struct SttInstanceState {
+    /** Null while a background load is creating the recognizer. */
     std::unique_ptr<sherpaonnx::SttWrapper> wrapper;
+    std::shared_ptr<SttLoadState> load;
 };
 
 static std::unordered_map<std::string, std::unique_ptr<SttInstanceState>> g_stt_instances;
 static std::mutex g_stt_mutex;
 
+static void sttSettleLoad(const SttLoadState &load, RCTPromiseResolveBlock resolve, RCTPromiseRejectBlock reject) {
+    if (load.result != nil) {
+        resolve(load.result);
+    } else {
+        reject(load.errorCode ?: @"INIT_ERROR", load.errorMessage ?: @"STT initialization failed", nil);
+    }
+}
+
+/** Record the load outcome (result, or error code and message) and settle every waiter. Caller holds g_stt_mutex. */
+static void sttCompleteLoadLocked(const std::shared_ptr<SttLoadState> &load, NSDictionary *result,
+                                  NSString *errorCode, NSString *errorMessage) {
+    if (load == nullptr || load->done) return;
+    load->done = true;
+    load->result = result;
+    load->errorCode = errorCode;
+    load->errorMessage = errorMessage;
+    for (const auto &waiter : load->waiters) sttSettleLoad(*load, waiter.first, waiter.second);
+    load->waiters.clear();
+}
+
+/**
+ * Rejects a request on an instance without a loaded recognizer: STT_NOT_READY while a background
+ * load is still running, otherwise code / not initialized. inst may be null. Caller holds g_stt_mutex.
+ */
+static void sttRejectNotLoaded(const SttInstanceState *inst, NSString *code, RCTPromiseRejectBlock reject) {
+    if (inst != nullptr && inst->load != nullptr && !inst->load->done) {
+        reject(@"STT_NOT_READY", @"STT model is still loading. Wait for waitForSttReady (engine.whenReady()) first.", nil);
+    } else {
+        reject(code, @"STT not initialized. Call initializeStt first.", nil);
+    }
+}
+
+static NSString *sttInitErrorCode(NSString *errorMsg) {
+    if ([errorMsg hasPrefix:@"HOTWORDS_NOT_SUPPORTED"]) return @"HOTWORDS_NOT_SUPPORTED";
+    if ([errorMsg hasPrefix:@"INVALID_HOTWORDS_FILE"]) return @"INVALID_HOTWORDS_FILE";
+    return @"INIT_ERROR";
+}
+
+static NSArray *sttDetectedModelsToArray(const std::vector<sherpaonnx::DetectedModel> &models) {
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:models.size()];
+    for (const auto &model : models) {
+        [array addObject:@{
+            @"type": [NSString stringWithUTF8String:model.type.c_str()] ?: @"",
+            @"modelDir": [NSString stringWithUTF8String:model.modelDir.c_str()] ?: @""
+        }];
+    }
+    return array;
+}
+
+/** initializeStt result, with loadTimings for the prefetch, detection, creation and warm-up phases. */
+static NSDictionary *sttInitResultToDict(const sherpaonnx::SttInitializeResult &result,
+                                         const std::shared_future<sherpaonnx::PrefetchStats> &prefetch,
+                                         std::chrono::steady_clock::time_point startedAt,
+                                         NSDictionary *autoTuned) {
+    NSMutableDictionary *resultDict = [NSMutableDictionary dictionary];
+    resultDict[@"success"] = @YES;
+    resultDict[@"detectedModels"] = sttDetectedModelsToArray(result.detectedModels);
+    if (!result.modelType.empty()) {
+        resultDict[@"modelType"] = [NSString stringWithUTF8String:result.modelType.c_str()];
+    }
+    if (!result.decodingMethod.empty()) {
+        resultDict[@"decodingMethod"] = [NSString stringWithUTF8String:result.decodingMethod.c_str()];
+    }
+    if (result.warmUpMs >= 0) {
+        resultDict[@"warmUpMs"] = @(result.warmUpMs);
+    }
+    const sherpaonnx::PrefetchStats stats = prefetch.valid() ? prefetch.get() : sherpaonnx::PrefetchStats{};
+    NSMutableDictionary *timings = [NSMutableDictionary dictionary];
+    timings[@"prefetchMs"] = @(stats.elapsedMs);
+    timings[@"prefetchedFiles"] = @(stats.files);
+    timings[@"prefetchedBytes"] = @(stats.bytes);
+    timings[@"detectMs"] = @(result.detectMs);
+    timings[@"createMs"] = @(result.createMs);
+    if (result.warmUpMs >= 0) timings[@"warmUpMs"] = @(result.warmUpMs);
+    timings[@"totalMs"] = @(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startedAt).count());
+    timings[@"shared"] = @(result.sharedEngine);
+    resultDict[@"loadTimings"] = timings;
+    if (autoTuned != nil) resultDict[@"autoTuned"] = autoTuned;
+    if (result.hotwords.has_value()) {
+        const sherpaonnx::HotwordsCompileResult &hw = *result.hotwords;
+        resultDict[@"hotwords"] = @{
+            @"entries" : @(hw.entries),
+            @"duplicates" : @(hw.duplicates),
+            @"droppedLines" : @(hw.oovLines),
+            @"vocabChecked" : @(hw.vocabChecked),
+            @"cached" : @(hw.cached),
+            @"compileMs" : @(hw.compileMs),
+        };
+    }
+    return resultDict;
+}
+
 static NSString *sttModelKindToNSString(sherpaonnx::SttModelKind kind) {
     using K = sherpaonnx::SttModelKind;
     switch (kind) {
@@ -48,30 +165,177 @@ static NSString *sttModelKindToNSString(sherpaonnx::SttModelKind kind) {
     }
 }
 
-static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r) {
-    NSMutableArray *tokens = [NSMutableArray arrayWithCapacity:r.tokens.size()];
-    for (const auto& t : r.tokens) {
-        [tokens addObject:[NSString stringWithUTF8String:t.c_str()]];
-    }
-    NSMutableArray *timestamps = [NSMutableArray arrayWithCapacity:r.timestamps.size()];
-    for (float ts : r.timestamps) {
-        [timestamps addObject:@(ts)];
-    }
-    NSMutableArray *durations = [NSMutableArray arrayWithCapacity:r.durations.size()];
-    for (float d : r.durations) {
-        [durations addObject:@(d)];
-    }
-    return @{
-        @"text": [NSString stringWithUTF8String:r.text.c_str()] ?: @"",
-        @"tokens": tokens,
-        @"timestamps": timestamps,
-        @"lang": [NSString stringWithUTF8String:r.lang.c_str()] ?: @"",
-        @"emotion": [NSString stringWithUTF8String:r.emotion.c_str()] ?: @"",
-        @"event": [NSString stringWithUTF8String:r.event.c_str()] ?: @"",
-        @"durations": durations
+/** Optional resultFields bridge argument -> SttResultField mask (nil = every field). */
+static uint32_t sttResultFields(NSNumber *resultFields) {
+    return sherpaonnx::SttResultFieldsFromArg(resultFields != nil ? [resultFields doubleValue] : 0, resultFields != nil);
+}
+
+/** text plus the fields in the SttResultField mask; no arrays are boxed for the others. */
+static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r, uint32_t fields) {
+    NSMutableDictionary *dict = [NSMutableDictionary dictionaryWithCapacity:7];
+    dict[@"text"] = [NSString stringWithUTF8String:r.text.c_str()] ?: @"";
+    if (fields & sherpaonnx::kSttResultTokens) {
+        NSMutableArray *tokens = [NSMutableArray arrayWithCapacity:r.tokens.size()];
+        for (const auto& t : r.tokens) {
+            [tokens addObject:[NSString stringWithUTF8String:t.c_str()]];
+        }
+        dict[@"tokens"] = tokens;
+    }
+    if (fields & sherpaonnx::kSttResultTimestamps) {
+        NSMutableArray *timestamps = [NSMutableArray arrayWithCapacity:r.timestamps.size()];
+        for (float ts : r.timestamps) {
+            [timestamps addObject:@(ts)];
+        }
+        dict[@"timestamps"] = timestamps;
+    }
+    if (fields & sherpaonnx::kSttResultLang) dict[@"lang"] = [NSString stringWithUTF8String:r.lang.c_str()] ?: @"";
+    if (fields & sherpaonnx::kSttResultEmotion) dict[@"emotion"] = [NSString stringWithUTF8String:r.emotion.c_str()] ?: @"";
+    if (fields & sherpaonnx::kSttResultEvent) dict[@"event"] = [NSString stringWithUTF8String:r.event.c_str()] ?: @"";
+    if (fields & sherpaonnx::kSttResultDurations) {
+        NSMutableArray *durations = [NSMutableArray arrayWithCapacity:r.durations.size()];
+        for (float d : r.durations) {
+            [durations addObject:@(d)];
+        }
+        dict[@"durations"] = durations;
+    }
+    return dict;
+}
+
+/** Model-specific initializeStt / tuneStt options; only the block for the loaded model type is applied in C++. */
+struct SttParsedModelOptions {
+    sherpaonnx::SttWhisperOptions whisper;
+    sherpaonnx::SttSenseVoiceOptions senseVoice;
+    sherpaonnx::SttCanaryOptions canary;
+    sherpaonnx::SttFunAsrNanoOptions funasrNano;
+    bool hasWhisper = false;
+    bool hasSenseVoice = false;
+    bool hasCanary = false;
+    bool hasFunasrNano = false;
+
+    const sherpaonnx::SttWhisperOptions *whisperPtr() const { return hasWhisper ? &whisper : nullptr; }
+    const sherpaonnx::SttSenseVoiceOptions *senseVoicePtr() const { return hasSenseVoice ? &senseVoice : nullptr; }
+    const sherpaonnx::SttCanaryOptions *canaryPtr() const { return hasCanary ? &canary : nullptr; }
+    const sherpaonnx::SttFunAsrNanoOptions *funasrNanoPtr() const { return hasFunasrNano ? &funasrNano : nullptr; }
+};
+
+static SttParsedModelOptions sttParseModelOptions(NSDictionary *options) {
+    SttParsedModelOptions parsed;
+    if (options == nil || ![options isKindOfClass:[NSDictionary class]]) return parsed;
+    NSDictionary *w = options[@"whisper"];
+    if ([w isKindOfClass:[NSDictionary class]]) {
+        if (w[@"language"] != nil) parsed.whisper.language = std::string([(NSString *)w[@"language"] UTF8String]);
+        if (w[@"task"] != nil) parsed.whisper.task = std::string([(NSString *)w[@"task"] UTF8String]);
+        if (w[@"tailPaddings"] != nil) parsed.whisper.tail_paddings = [(NSNumber *)w[@"tailPaddings"] intValue];
+        parsed.hasWhisper = true;
+    }
+    NSDictionary *sv = options[@"senseVoice"];
+    if ([sv isKindOfClass:[NSDictionary class]]) {
+        if (sv[@"language"] != nil) parsed.senseVoice.language = std::string([(NSString *)sv[@"language"] UTF8String]);
+        if (sv[@"useItn"] != nil) parsed.senseVoice.use_itn = [(NSNumber *)sv[@"useItn"] boolValue];
+        parsed.hasSenseVoice = true;
+    }
+    NSDictionary *c = options[@"canary"];
+    if ([c isKindOfClass:[NSDictionary class]]) {
+        if (c[@"srcLang"] != nil) parsed.canary.src_lang = std::string([(NSString *)c[@"srcLang"] UTF8String]);
+        if (c[@"tgtLang"] != nil) parsed.canary.tgt_lang = std::string([(NSString *)c[@"tgtLang"] UTF8String]);
+        if (c[@"usePnc"] != nil) parsed.canary.use_pnc = [(NSNumber *)c[@"usePnc"] boolValue];
+        parsed.hasCanary = true;
+    }
+    NSDictionary *fn = options[@"funasrNano"];
+    if ([fn isKindOfClass:[NSDictionary class]]) {
+        if (fn[@"systemPrompt"] != nil) parsed.funasrNano.system_prompt = std::string([(NSString *)fn[@"systemPrompt"] UTF8String]);
+        if (fn[@"userPrompt"] != nil) parsed.funasrNano.user_prompt = std::string([(NSString *)fn[@"userPrompt"] UTF8String]);
+        if (fn[@"maxNewTokens"] != nil) parsed.funasrNano.max_new_tokens = [(NSNumber *)fn[@"maxNewTokens"] intValue];
+        if (fn[@"temperature"] != nil) parsed.funasrNano.temperature = [(NSNumber *)fn[@"temperature"] floatValue];
+        if (fn[@"topP"] != nil) parsed.funasrNano.top_p = [(NSNumber *)fn[@"topP"] floatValue];
+        if (fn[@"seed"] != nil) parsed.funasrNano.seed = [(NSNumber *)fn[@"seed"] intValue];
+        if (fn[@"language"] != nil) parsed.funasrNano.language = std::string([(NSString *)fn[@"language"] UTF8String]);
+        if (fn[@"itn"] != nil) parsed.funasrNano.itn = [(NSNumber *)fn[@"itn"] boolValue];
+        if (fn[@"hotwords"] != nil) parsed.funasrNano.hotwords = std::string([(NSString *)fn[@"hotwords"] UTF8String]);
+        parsed.hasFunasrNano = true;
+    }
+    return parsed;
+}
+
+/** Non-WAV inputs of transcribeFiles / transcribeLongFile go through the AVFoundation converter. */
+static sherpaonnx::SttWavConverter sttWavConverter() {
+    return [](const std::string &inputPath, const std::string &outputPath) -> std::string {
+        @autoreleasepool {
+            NSError *error = nil;
+            if ([SherpaOnnxAudioConvert convertAudioToWav16k:[NSString stringWithUTF8String:inputPath.c_str()]
+                                                  outputPath:[NSString stringWithUTF8String:outputPath.c_str()]
+                                                       error:&error]) {
+                return std::string();
+            }
+            return error != nil ? std::string([error.localizedDescription UTF8String]) : std::string("Conversion failed");
+        }
     };
 }
 
+/** NSUserDefaults key of a tuneStt winner: device model, OS build and model files (SttTuneModelKey). */
+static NSString *sttTuningKey(const std::string &modelDir, const std::string &modelType) {
+    char machine[64] = {0};
+    size_t size = sizeof(machine) - 1;
+    if (sysctlbyname("hw.machine", machine, &size, nullptr, 0) != 0) machine[0] = '\0';
+    NSString *os = [[NSProcessInfo processInfo] operatingSystemVersionString] ?: @"";
+    const std::string model = sherpaonnx::SttTuneModelKey(modelDir, modelType);
+    return [NSString stringWithFormat:@"sherpaonnx_stt_tuning|%s|%@|%s", machine, os, model.c_str()];
+}
+
+static std::optional<sherpaonnx::SttTuneMeasurement> sttStoredTuning(const std::string &modelDir, const std::string &modelType) {
+    NSString *stored = [[NSUserDefaults standardUserDefaults] stringForKey:sttTuningKey(modelDir, modelType)];
+    if (stored == nil) return std::nullopt;
+    sherpaonnx::SttTuneMeasurement choice;
+    if (!sherpaonnx::ParseSttTuneChoice([stored UTF8String], &choice)) {
+        RCTLogWarn(@"Ignoring unreadable STT tuning for %s", modelDir.c_str());
+        return std::nullopt;
+    }
+    return choice;
+}
+
+static NSMutableDictionary *sttTuningToDict(const sherpaonnx::SttTuneMeasurement &choice) {
+    NSMutableDictionary *dict = [NSMutableDictionary dictionary];
+    dict[@"numThreads"] = @(choice.candidate.numThreads);
+    dict[@"provider"] = [NSString stringWithUTF8String:choice.candidate.provider.c_str()] ?: @"cpu";
+    dict[@"preferInt8"] = @(choice.candidate.int8);
+    dict[@"rtf"] = @(choice.rtf);
+    dict[@"peakMemoryBytes"] = @(choice.peakMemoryBytes);
+    return dict;
+}
+
+/** Every path detection selected, to tell whether preferInt8 true and false pick different files. */
+static std::string sttModelPathsSignature(const sherpaonnx::SttModelPaths &p) {
+    const std::string parts[] = {
+        p.encoder, p.decoder, p.joiner, p.paraformerModel, p.ctcModel, p.whisperEncoder, p.whisperDecoder,
+        p.funasrEncoderAdaptor, p.funasrLLM, p.funasrEmbedding, p.moonshinePreprocessor, p.moonshineEncoder,
+        p.moonshineUncachedDecoder, p.moonshineCachedDecoder, p.moonshineMergedDecoder, p.dolphinModel,
+        p.omnilingualModel, p.medasrModel, p.telespeechCtcModel, p.fireRedEncoder, p.fireRedDecoder,
+        p.canaryEncoder, p.canaryDecoder};
+    std::string signature;
+    for (const auto &part : parts) signature += part + "\n";
+    return signature;
+}
+
+/**
+ * Speech-like stand-in for tuneStt without audioFile: syllable-rate bursts of a few harmonics over
+ * low noise, so the encoder and decoder see non-silent frames. Same clip as on Android.
+ */
+static std::vector<float> sttSyntheticCalibrationAudio() {
+    std::vector<float> samples(16000 * 4);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const double t = static_cast<double>(i) / 16000.0;
+        const double envelope = std::max(0.0, std::sin(2 * M_PI * 4.0 * t));
+        const double f0 = 140.0 + 30.0 * std::sin(2 * M_PI * 0.5 * t);
+        double v = 0.0;
+        for (int h = 1; h <= 4; ++h) v += std::sin(2 * M_PI * f0 * h * t) / h;
+        samples[i] = static_cast<float>(0.1 * envelope * v) +
+                     (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f) * 2e-3f;
+    }
+    return samples;
+}
+
 @implementation SherpaOnnx (STT)
 
 - (void)initializeStt:(NSString *)instanceId
@@ -89,6 +353,8 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
         modelOptions:(NSDictionary *)modelOptions
         modelingUnit:(NSString *)modelingUnit
              bpeVocab:(NSString *)bpeVocab
+               warmUp:(NSNumber *)warmUp
+          loadOptions:(NSDictionary *)loadOptions
               resolve:(RCTPromiseResolveBlock)resolve
                reject:(RCTPromiseRejectBlock)reject
 {
@@ -99,17 +365,12 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
     std::string instanceIdStr = [instanceId UTF8String];
     RCTLogInfo(@"Initializing STT instance %@ with modelDir: %@", instanceId, modelDir);
 
-    @try {
-        std::lock_guard<std::mutex> lock(g_stt_mutex);
-        auto it = g_stt_instances.find(instanceIdStr);
-        if (it == g_stt_instances.end()) {
-            g_stt_instances[instanceIdStr] = std::make_unique<SttInstanceState>();
-        }
-        SttInstanceState *inst = g_stt_instances[instanceIdStr].get();
-        if (inst->wrapper == nullptr) {
-            inst->wrapper = std::make_unique<sherpaonnx::SttWrapper>();
-        }
+    const auto startedAt = std::chrono::steady_clock::now();
+    const bool background = [loadOptions[@"background"] isKindOfClass:[NSNumber class]] && [loadOptions[@"background"] boolValue];
+    const bool prefetch = ![loadOptions[@"prefetch"] isKindOfClass:[NSNumber class]] || [loadOptions[@"prefetch"] boolValue];
+    const bool useTuning = ![loadOptions[@"useTuning"] isKindOfClass:[NSNumber class]] || [loadOptions[@"useTuning"] boolValue];
 
+    @try {
         std::string modelDirStr = [modelDir UTF8String];
 
         std::optional<bool> preferInt8Opt = std::nullopt;
@@ -159,88 +420,132 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
             ditherOpt = [dither floatValue];
         }
 
-        // Parse model-specific options (only the block for the loaded model type is applied in C++).
-        sherpaonnx::SttWhisperOptions whisperOpts;
-        sherpaonnx::SttSenseVoiceOptions senseVoiceOpts;
-        sherpaonnx::SttCanaryOptions canaryOpts;
-        sherpaonnx::SttFunAsrNanoOptions funasrNanoOpts;
-        const sherpaonnx::SttWhisperOptions *whisperOptsPtr = nullptr;
-        const sherpaonnx::SttSenseVoiceOptions *senseVoiceOptsPtr = nullptr;
-        const sherpaonnx::SttCanaryOptions *canaryOptsPtr = nullptr;
-        const sherpaonnx::SttFunAsrNanoOptions *funasrNanoOptsPtr = nullptr;
-        if (modelOptions != nil && [modelOptions isKindOfClass:[NSDictionary class]]) {
-            NSDictionary *w = modelOptions[@"whisper"];
-            if ([w isKindOfClass:[NSDictionary class]]) {
-                if (w[@"language"] != nil) whisperOpts.language = std::string([(NSString *)w[@"language"] UTF8String]);
-                if (w[@"task"] != nil) whisperOpts.task = std::string([(NSString *)w[@"task"] UTF8String]);
-                if (w[@"tailPaddings"] != nil) whisperOpts.tail_paddings = [(NSNumber *)w[@"tailPaddings"] intValue];
-                whisperOptsPtr = &whisperOpts;
-            }
-            NSDictionary *sv = modelOptions[@"senseVoice"];
-            if ([sv isKindOfClass:[NSDictionary class]]) {
-                if (sv[@"language"] != nil) senseVoiceOpts.language = std::string([(NSString *)sv[@"language"] UTF8String]);
-                if (sv[@"useItn"] != nil) senseVoiceOpts.use_itn = [(NSNumber *)sv[@"useItn"] boolValue];
-                senseVoiceOptsPtr = &senseVoiceOpts;
-            }
-            NSDictionary *c = modelOptions[@"canary"];
-            if ([c isKindOfClass:[NSDictionary class]]) {
-                if (c[@"srcLang"] != nil) canaryOpts.src_lang = std::string([(NSString *)c[@"srcLang"] UTF8String]);
-                if (c[@"tgtLang"] != nil) canaryOpts.tgt_lang = std::string([(NSString *)c[@"tgtLang"] UTF8String]);
-                if (c[@"usePnc"] != nil) canaryOpts.use_pnc = [(NSNumber *)c[@"usePnc"] boolValue];
-                canaryOptsPtr = &canaryOpts;
-            }
-            NSDictionary *fn = modelOptions[@"funasrNano"];
-            if ([fn isKindOfClass:[NSDictionary class]]) {
-                if (fn[@"systemPrompt"] != nil) funasrNanoOpts.system_prompt = std::string([(NSString *)fn[@"systemPrompt"] UTF8String]);
-                if (fn[@"userPrompt"] != nil) funasrNanoOpts.user_prompt = std::string([(NSString *)fn[@"userPrompt"] UTF8String]);
-                if (fn[@"maxNewTokens"] != nil) funasrNanoOpts.max_new_tokens = [(NSNumber *)fn[@"maxNewTokens"] intValue];
-                if (fn[@"temperature"] != nil) funasrNanoOpts.temperature = [(NSNumber *)fn[@"temperature"] floatValue];
-                if (fn[@"topP"] != nil) funasrNanoOpts.top_p = [(NSNumber *)fn[@"topP"] floatValue];
-                if (fn[@"seed"] != nil) funasrNanoOpts.seed = [(NSNumber *)fn[@"seed"] intValue];
-                if (fn[@"language"] != nil) funasrNanoOpts.language = std::string([(NSString *)fn[@"language"] UTF8String]);
-                if (fn[@"itn"] != nil) funasrNanoOpts.itn = [(NSNumber *)fn[@"itn"] boolValue];
-                if (fn[@"hotwords"] != nil) funasrNanoOpts.hotwords = std::string([(NSString *)fn[@"hotwords"] UTF8String]);
-                funasrNanoOptsPtr = &funasrNanoOpts;
+        // A tuneStt winner for this device and model fills in whatever the caller left unset.
+        NSDictionary *autoTuned = nil;
+        if (useTuning && (!numThreadsOpt || !providerOpt || !preferInt8Opt)) {
+            if (auto tuned = sttStoredTuning(modelDirStr, modelTypeOpt.value_or("auto"))) {
+                if (!numThreadsOpt) numThreadsOpt = tuned->candidate.numThreads;
+                if (!providerOpt) providerOpt = tuned->candidate.provider;
+                if (!preferInt8Opt) preferInt8Opt = tuned->candidate.int8;
+                autoTuned = @{
+                    @"numThreads": @(*numThreadsOpt),
+                    @"provider": [NSString stringWithUTF8String:providerOpt->c_str()] ?: @"cpu",
+                    @"preferInt8": @(*preferInt8Opt)
+                };
+                RCTLogInfo(@"STT init: using tuned threads=%d provider=%s preferInt8=%d",
+                           *numThreadsOpt, providerOpt->c_str(), *preferInt8Opt ? 1 : 0);
             }
         }
 
-        sherpaonnx::SttInitializeResult result = inst->wrapper->initialize(
-            modelDirStr, preferInt8Opt, modelTypeOpt, debugVal, hotwordsFileOpt, hotwordsScoreOpt,
-            numThreadsOpt, providerOpt, ruleFstsOpt, ruleFarsOpt, ditherOpt,
-            whisperOptsPtr, senseVoiceOptsPtr, canaryOptsPtr, funasrNanoOptsPtr);
+        // Parse model-specific options (only the block for the loaded model type is applied in C++).
+        const SttParsedModelOptions modelOpts = sttParseModelOptions(modelOptions);
 
-        if (result.success) {
-            RCTLogInfo(@"Sherpa-onnx initialized successfully");
+        const bool warmUpVal = warmUp != nil && [warmUp boolValue];
 
-            NSMutableDictionary *resultDict = [NSMutableDictionary dictionary];
-            resultDict[@"success"] = @YES;
+        // Page the model files in while detection runs; session creation then reads from the cache.
+        std::shared_future<sherpaonnx::PrefetchStats> prefetchFuture;
+        if (prefetch) {
+            prefetchFuture = std::async(std::launch::async, [modelDirStr]() {
+                return sherpaonnx::PrefetchFiles(sherpaonnx::ListModelFiles(modelDirStr));
+            }).share();
+        }
 
-            NSMutableArray *detectedModelsArray = [NSMutableArray array];
-            for (const auto& model : result.detectedModels) {
-                NSMutableDictionary *modelDict = [NSMutableDictionary dictionary];
-                modelDict[@"type"] = [NSString stringWithUTF8String:model.type.c_str()];
-                modelDict[@"modelDir"] = [NSString stringWithUTF8String:model.modelDir.c_str()];
-                [detectedModelsArray addObject:modelDict];
+        if (!background) {
+            std::lock_guard<std::mutex> lock(g_stt_mutex);
+            auto it = g_stt_instances.find(instanceIdStr);
+            if (it == g_stt_instances.end()) {
+                g_stt_instances[instanceIdStr] = std::make_unique<SttInstanceState>();
             }
-            resultDict[@"detectedModels"] = detectedModelsArray;
-            if (!result.modelType.empty()) {
-                resultDict[@"modelType"] = [NSString stringWithUTF8String:result.modelType.c_str()];
+            SttInstanceState *inst = g_stt_instances[instanceIdStr].get();
+            if (inst->wrapper == nullptr) {
+                inst->wrapper = std::make_unique<sherpaonnx::SttWrapper>();
             }
-            if (!result.decodingMethod.empty()) {
-                resultDict[@"decodingMethod"] = [NSString stringWithUTF8String:result.decodingMethod.c_str()];
+            auto load = std::make_shared<SttLoadState>();
+            inst->load = load;
+
+            sherpaonnx::SttInitializeResult result = inst->wrapper->initialize(
+                modelDirStr, preferInt8Opt, modelTypeOpt, debugVal, hotwordsFileOpt, hotwordsScoreOpt,
+                numThreadsOpt, providerOpt, ruleFstsOpt, ruleFarsOpt, ditherOpt,
+                modelOpts.whisperPtr(), modelOpts.senseVoicePtr(), modelOpts.canaryPtr(), modelOpts.funasrNanoPtr(), warmUpVal);
+
+            if (result.success) {
+                RCTLogInfo(@"Sherpa-onnx initialized successfully");
+                sttCompleteLoadLocked(load, sttInitResultToDict(result, prefetchFuture, startedAt, autoTuned), nil, nil);
+            } else {
+                NSString *errorMsg = result.error.empty()
+                    ? [NSString stringWithFormat:@"Failed to initialize sherpa-onnx with model directory: %@", modelDir]
+                    : [NSString stringWithUTF8String:result.error.c_str()];
+                RCTLogError(@"%@", errorMsg);
+                sttCompleteLoadLocked(load, nil, sttInitErrorCode(errorMsg), errorMsg);
             }
+            sttSettleLoad(*load, resolve, reject);
+            return;
+        }
 
-            resolve(resultDict);
-        } else {
-            NSString *errorMsg = result.error.empty()
+        // Background load: detect now so the caller gets the model type (and detection errors)
+        // right away, then create the sessions on a fresh wrapper off the mutex and swap it in.
+        sherpaonnx::SttDetectResult detect = sherpaonnx::DetectSttModel(modelDirStr, preferInt8Opt, modelTypeOpt, debugVal);
+        if (!detect.ok) {
+            NSString *errorMsg = detect.error.empty()
                 ? [NSString stringWithFormat:@"Failed to initialize sherpa-onnx with model directory: %@", modelDir]
-                : [NSString stringWithUTF8String:result.error.c_str()];
-            NSString *code = @"INIT_ERROR";
-            if ([errorMsg hasPrefix:@"HOTWORDS_NOT_SUPPORTED"]) code = @"HOTWORDS_NOT_SUPPORTED";
-            else if ([errorMsg hasPrefix:@"INVALID_HOTWORDS_FILE"]) code = @"INVALID_HOTWORDS_FILE";
+                : [NSString stringWithUTF8String:detect.error.c_str()];
             RCTLogError(@"%@", errorMsg);
-            reject(code, errorMsg, nil);
+            reject(@"INIT_ERROR", errorMsg, nil);
+            return;
+        }
+        auto load = std::make_shared<SttLoadState>();
+        std::unique_ptr<sherpaonnx::SttWrapper> previous;
+        {
+            std::lock_guard<std::mutex> lock(g_stt_mutex);
+            auto it = g_stt_instances.find(instanceIdStr);
+            if (it == g_stt_instances.end()) {
+                g_stt_instances[instanceIdStr] = std::make_unique<SttInstanceState>();
+            }
+            SttInstanceState *inst = g_stt_instances[instanceIdStr].get();
+            previous = std::move(inst->wrapper);
+            inst->load = load;
         }
+        previous.reset();
+
+        NSMutableDictionary *loadingDict = [NSMutableDictionary dictionary];
+        loadingDict[@"success"] = @YES;
+        loadingDict[@"loading"] = @YES;
+        loadingDict[@"detectedModels"] = sttDetectedModelsToArray(detect.detectedModels);
+        if (!detect.detectedModels.empty()) {
+            loadingDict[@"modelType"] = [NSString stringWithUTF8String:detect.detectedModels[0].type.c_str()];
+        }
+        if (autoTuned != nil) loadingDict[@"autoTuned"] = autoTuned;
+        resolve(loadingDict);
+
+        NSString *modelDirCopy = [modelDir copy];
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            auto wrapper = std::make_unique<sherpaonnx::SttWrapper>();
+            sherpaonnx::SttInitializeResult result = wrapper->initialize(
+                modelDirStr, preferInt8Opt, modelTypeOpt, debugVal, hotwordsFileOpt, hotwordsScoreOpt,
+                numThreadsOpt, providerOpt, ruleFstsOpt, ruleFarsOpt, ditherOpt,
+                modelOpts.whisperPtr(), modelOpts.senseVoicePtr(), modelOpts.canaryPtr(), modelOpts.funasrNanoPtr(),
+                warmUpVal);
+            NSDictionary *resultDict = result.success ? sttInitResultToDict(result, prefetchFuture, startedAt, autoTuned) : nil;
+            {
+                std::lock_guard<std::mutex> lock(g_stt_mutex);
+                auto it = g_stt_instances.find(instanceIdStr);
+                if (result.success && it != g_stt_instances.end() && it->second->load == load) {
+                    it->second->wrapper = std::move(wrapper);
+                    RCTLogInfo(@"Sherpa-onnx initialized successfully (background)");
+                    sttCompleteLoadLocked(load, resultDict, nil, nil);
+                } else if (result.success) {
+                    sttCompleteLoadLocked(load, nil, @"INIT_ERROR", @"STT instance was unloaded or re-initialized while loading");
+                } else {
+                    NSString *errorMsg = result.error.empty()
+                        ? [NSString stringWithFormat:@"Failed to initialize sherpa-onnx with model directory: %@", modelDirCopy]
+                        : [NSString stringWithUTF8String:result.error.c_str()];
+                    RCTLogError(@"%@", errorMsg);
+                    sttCompleteLoadLocked(load, nil, sttInitErrorCode(errorMsg), errorMsg);
+                }
+            }
+            // A wrapper that was not swapped in (stale load) releases its recognizer here, off the mutex.
+            wrapper.reset();
+        });
     } @catch (NSException *exception) {
         NSString *errorMsg = [NSString stringWithFormat:@"Exception during initialization: %@", exception.reason];
         RCTLogError(@"%@", errorMsg);
@@ -248,6 +553,226 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
     }
 }
 
+/**
+ * Time recognizer configurations for a model on this device (SttAutoTuner: cpu over a thread
+ * ladder, then options.providers, then the other quantization) and store the fastest in
+ * NSUserDefaults. Each candidate gets its own SttWrapper, one warm-up decode and options.runs
+ * timed decodes (median). Runs on a background queue.
+ */
+- (void)tuneStt:(NSString *)modelDir
+        options:(NSDictionary *)options
+        resolve:(RCTPromiseResolveBlock)resolve
+         reject:(RCTPromiseRejectBlock)reject
+{
+    if (modelDir == nil || [modelDir length] == 0) {
+        reject(@"STT_TUNE_ERROR", @"modelDir is required", nil);
+        return;
+    }
+    const std::string modelDirStr = [modelDir UTF8String];
+    NSString *modelTypeArg = [options[@"modelType"] isKindOfClass:[NSString class]] ? options[@"modelType"] : nil;
+    const std::string modelTypeStr = modelTypeArg.length > 0 ? std::string([modelTypeArg UTF8String]) : "auto";
+    const int32_t cores = static_cast<int32_t>([[NSProcessInfo processInfo] activeProcessorCount]);
+    const int32_t maxThreads = [options[@"maxThreads"] isKindOfClass:[NSNumber class]]
+        ? std::clamp([options[@"maxThreads"] intValue], 1, 16) : std::clamp(cores, 1, 8);
+    std::vector<std::string> providers;
+    if ([options[@"providers"] isKindOfClass:[NSArray class]]) {
+        for (id p in (NSArray *)options[@"providers"]) {
+            if ([p isKindOfClass:[NSString class]] && [(NSString *)p length] > 0) {
+                providers.push_back([[(NSString *)p lowercaseString] UTF8String]);
+            }
+        }
+    } else {
+#if __has_include(<onnxruntime/coreml_provider_factory.h>)
+        providers.push_back("coreml");
+#endif
+    }
+    const int runs = [options[@"runs"] isKindOfClass:[NSNumber class]] ? std::clamp([options[@"runs"] intValue], 1, 10) : 2;
+    const int64_t maxMemoryBytes = [options[@"maxMemoryMB"] isKindOfClass:[NSNumber class]]
+        ? static_cast<int64_t>([options[@"maxMemoryMB"] doubleValue] * 1024 * 1024) : 0;
+    const double tolerance = [options[@"tolerance"] isKindOfClass:[NSNumber class]] ? [options[@"tolerance"] doubleValue] : 0.05;
+    const bool persist = ![options[@"persist"] isKindOfClass:[NSNumber class]] || [options[@"persist"] boolValue];
+    NSString *audioFile = [options[@"audioFile"] isKindOfClass:[NSString class]] ? options[@"audioFile"] : nil;
+    const std::string audioFileStr = audioFile.length > 0 ? std::string([audioFile UTF8String]) : std::string();
+    const SttParsedModelOptions modelOpts = sttParseModelOptions(options[@"modelOptions"]);
+
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        @try {
+            const std::optional<std::string> typeOpt =
+                modelTypeStr == "auto" ? std::nullopt : std::optional<std::string>(modelTypeStr);
+            // Detect both ways to learn which quantizations the model directory actually has.
+            const sherpaonnx::SttDetectResult int8Detect = sherpaonnx::DetectSttModel(modelDirStr, true, typeOpt, false);
+            const sherpaonnx::SttDetectResult fp32Detect = sherpaonnx::DetectSttModel(modelDirStr, false, typeOpt, false);
+            if (!int8Detect.ok && !fp32Detect.ok) {
+                reject(@"STT_TUNE_ERROR", [NSString stringWithFormat:@"Failed to detect STT model in %@", modelDir], nil);
+                return;
+            }
+            const std::string int8Signature = int8Detect.ok ? sttModelPathsSignature(int8Detect.paths) : std::string();
+            const std::string fp32Signature = fp32Detect.ok ? sttModelPathsSignature(fp32Detect.paths) : std::string();
+            const bool both = int8Detect.ok && fp32Detect.ok && int8Signature != fp32Signature;
+            const bool int8Only = !both && (int8Detect.ok ? int8Signature : fp32Signature).find("int8") != std::string::npos;
+
+            std::vector<float> samples;
+            int32_t sampleRate = 16000;
+            if (!audioFileStr.empty()) {
+                std::string error;
+                if (!sherpaonnx::ReadWavFileMono(audioFileStr, &samples, &sampleRate, &error) || samples.empty() || sampleRate <= 0) {
+                    reject(@"STT_TUNE_ERROR", [NSString stringWithFormat:@"Could not read calibration audio: %@", audioFile], nil);
+                    return;
+                }
+            } else {
+                samples = sttSyntheticCalibrationAudio();
+            }
+            const double audioMs = samples.size() * 1000.0 / sampleRate;
+
+            sherpaonnx::SttTuneOptions tuneOptions;
+            tuneOptions.maxThreads = maxThreads;
+            tuneOptions.providers = providers;
+            tuneOptions.hasInt8 = both || int8Only;
+            tuneOptions.hasFp32 = both || !int8Only;
+            tuneOptions.maxMemoryBytes = maxMemoryBytes;
+            tuneOptions.tolerance = tolerance;
+            sherpaonnx::SttAutoTuner tuner(tuneOptions);
+            sherpaonnx::ProcessMemoryProbe probe;
+            NSMutableArray *measurements = [NSMutableArray array];
+            sherpaonnx::SttTuneCandidate candidate;
+            while (tuner.Next(&candidate)) {
+                sherpaonnx::SttTuneMeasurement m;
+                m.candidate = candidate;
+                m.audioMs = audioMs;
+                probe.Begin();
+                try {
+                    auto wrapper = std::make_unique<sherpaonnx::SttWrapper>();
+                    const auto loadStart = std::chrono::steady_clock::now();
+                    sherpaonnx::SttInitializeResult init = wrapper->initialize(
+                        modelDirStr, candidate.int8, typeOpt, false, std::nullopt, std::nullopt,
+                        candidate.numThreads, candidate.provider, std::nullopt, std::nullopt, std::nullopt,
+                        modelOpts.whisperPtr(), modelOpts.senseVoicePtr(), modelOpts.canaryPtr(), modelOpts.funasrNanoPtr(),
+                        false);
+                    m.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+                    if (!init.success) {
+                        m.error = init.error.empty() ? "Recognizer could not be created" : init.error;
+                    } else {
+                        probe.Sample();
+                        // Warm-up: lazy ONNX Runtime initialization is not decode cost.
+                        wrapper->transcribeSamples(samples.data(), samples.size(), sampleRate, 0);
+                        probe.Sample();
+                        std::vector<double> times;
+                        for (int i = 0; i < runs; ++i) {
+                            const auto start = std::chrono::steady_clock::now();
+                            wrapper->transcribeSamples(samples.data(), samples.size(), sampleRate, 0);
+                            probe.Sample();
+                            times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                        }
+                        std::sort(times.begin(), times.end());
+                        m.decodeMs = times[times.size() / 2];
+                        m.ok = audioMs > 0;
+                        m.rtf = audioMs > 0 ? m.decodeMs / audioMs : 0.0;
+                    }
+                    wrapper->release();
+                } catch (const std::exception &e) {
+                    m.error = e.what();
+                }
+                if (!m.ok) {
+                    RCTLogWarn(@"STT tune: %s x%d int8=%d failed: %s", candidate.provider.c_str(), candidate.numThreads,
+                               candidate.int8 ? 1 : 0, m.error.c_str());
+                }
+                m.peakMemoryBytes = probe.PeakDeltaBytes();
+                tuner.Report(m);
+                NSMutableDictionary *item = [NSMutableDictionary dictionary];
+                item[@"numThreads"] = @(candidate.numThreads);
+                item[@"provider"] = [NSString stringWithUTF8String:candidate.provider.c_str()] ?: @"";
+                item[@"preferInt8"] = @(candidate.int8);
+                item[@"ok"] = @(m.ok);
+                if (!m.error.empty()) item[@"error"] = [NSString stringWithUTF8String:m.error.c_str()] ?: @"";
+                item[@"loadMs"] = @(m.loadMs);
+                item[@"decodeMs"] = @(m.decodeMs);
+                item[@"rtf"] = @(m.rtf);
+                item[@"peakMemoryBytes"] = @(m.peakMemoryBytes);
+                [measurements addObject:item];
+            }
+            sherpaonnx::SttTuneMeasurement best;
+            if (!tuner.Best(&best)) {
+                reject(@"STT_TUNE_ERROR", @"No configuration could load and decode the model", nil);
+                return;
+            }
+            if (persist) {
+                [[NSUserDefaults standardUserDefaults]
+                    setObject:[NSString stringWithUTF8String:sherpaonnx::SerializeSttTuneChoice(best).c_str()]
+                       forKey:sttTuningKey(modelDirStr, modelTypeStr)];
+            }
+            RCTLogInfo(@"STT tune: best %s x%d int8=%d rtf=%f", best.candidate.provider.c_str(),
+                       best.candidate.numThreads, best.candidate.int8 ? 1 : 0, best.rtf);
+            NSMutableDictionary *result = sttTuningToDict(best);
+            result[@"audioMs"] = @(audioMs);
+            result[@"stored"] = @(persist);
+            result[@"measurements"] = measurements;
+            resolve(result);
+        } @catch (NSException *exception) {
+            reject(@"STT_TUNE_ERROR", [NSString stringWithFormat:@"Tuning failed: %@", exception.reason], nil);
+        }
+    });
+}
+
+/** Stored tuneStt winner for a model on this device, or nil. */
+- (void)getSttTuning:(NSString *)modelDir
+           modelType:(NSString *)modelType
+             resolve:(RCTPromiseResolveBlock)resolve
+              reject:(RCTPromiseRejectBlock)reject
+{
+    const std::string type = modelType.length > 0 ? std::string([modelType UTF8String]) : "auto";
+    auto stored = modelDir.length > 0 ? sttStoredTuning([modelDir UTF8String], type) : std::nullopt;
+    resolve(stored ? sttTuningToDict(*stored) : nil);
+}
+
+/** Forget the stored tuneStt winner; resolves YES if one was stored. */
+- (void)clearSttTuning:(NSString *)modelDir
+             modelType:(NSString *)modelType
+               resolve:(RCTPromiseResolveBlock)resolve
+                reject:(RCTPromiseRejectBlock)reject
+{
+    if (modelDir.length == 0) {
+        resolve(@NO);
+        return;
+    }
+    const std::string type = modelType.length > 0 ? std::string([modelType UTF8String]) : "auto";
+    NSString *key = sttTuningKey([modelDir UTF8String], type);
+    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    const BOOL existed = [defaults objectForKey:key] != nil;
+    if (existed) [defaults removeObjectForKey:key];
+    resolve(@(existed));
+}
+
+/**
+ * Resolves with the initializeStt result (including loadTimings) once the recognizer of a
+ * background load is ready, or rejects with the load error. Settles at once when already done.
+ */
+- (void)waitForSttReady:(NSString *)instanceId
+                resolve:(RCTPromiseResolveBlock)resolve
+                 reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId == nil || [instanceId length] == 0) {
+        reject(@"INIT_ERROR", @"instanceId is required", nil);
+        return;
+    }
+    std::string instanceIdStr = [instanceId UTF8String];
+    std::lock_guard<std::mutex> lock(g_stt_mutex);
+    auto it = g_stt_instances.find(instanceIdStr);
+    if (it == g_stt_instances.end()) {
+        reject(@"INIT_ERROR", [NSString stringWithFormat:@"STT instance not found: %@", instanceId], nil);
+        return;
+    }
+    const std::shared_ptr<SttLoadState> &load = it->second->load;
+    if (load == nullptr) {
+        reject(@"INIT_ERROR", @"STT not initialized. Call initializeStt first.", nil);
+        return;
+    }
+    if (!load->done) {
+        load->waiters.emplace_back(resolve, reject);
+        return;
+    }
+    sttSettleLoad(*load, resolve, reject);
+}
+
 - (void)detectSttModel:(NSString *)modelDir
            preferInt8:(NSNumber *)preferInt8
             modelType:(NSString *)modelType
@@ -292,6 +817,7 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
 
 - (void)transcribeFile:(NSString *)instanceId
              filePath:(NSString *)filePath
+         resultFields:(NSNumber *)resultFields
               resolve:(RCTPromiseResolveBlock)resolve
                reject:(RCTPromiseRejectBlock)reject
 {
@@ -303,14 +829,15 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
     std::lock_guard<std::mutex> lock(g_stt_mutex);
     auto it = g_stt_instances.find(instanceIdStr);
     if (it == g_stt_instances.end() || it->second->wrapper == nullptr || !it->second->wrapper->isInitialized()) {
-        reject(@"TRANSCRIBE_ERROR", @"STT not initialized. Call initializeStt first.", nil);
+        sttRejectNotLoaded(it == g_stt_instances.end() ? nullptr : it->second.get(), @"TRANSCRIBE_ERROR", reject);
         return;
     }
     sherpaonnx::SttWrapper *wrapper = it->second->wrapper.get();
     try {
         std::string filePathStr = [filePath UTF8String];
-        sherpaonnx::SttRecognitionResult result = wrapper->transcribeFile(filePathStr);
-        resolve(sttResultToDict(result));
+        const uint32_t fields = sttResultFields(resultFields);
+        sherpaonnx::SttRecognitionResult result = wrapper->transcribeFile(filePathStr, fields);
+        resolve(sttResultToDict(result, fields));
     } catch (const std::exception& e) {
         NSString *errorMsg = e.what() ? [NSString stringWithUTF8String:e.what()] : @"Recognition failed.";
         if (!errorMsg) errorMsg = @"Recognition failed.";
@@ -326,6 +853,7 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
 - (void)transcribeSamples:(NSString *)instanceId
                   samples:(NSArray<NSNumber *> *)samples
                 sampleRate:(double)sampleRate
+              resultFields:(NSNumber *)resultFields
                    resolve:(RCTPromiseResolveBlock)resolve
                     reject:(RCTPromiseRejectBlock)reject
 {
@@ -337,7 +865,7 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
     std::lock_guard<std::mutex> lock(g_stt_mutex);
     auto it = g_stt_instances.find(instanceIdStr);
     if (it == g_stt_instances.end() || it->second->wrapper == nullptr || !it->second->wrapper->isInitialized()) {
-        reject(@"TRANSCRIBE_ERROR", @"STT not initialized. Call initializeStt first.", nil);
+        sttRejectNotLoaded(it == g_stt_instances.end() ? nullptr : it->second.get(), @"TRANSCRIBE_ERROR", reject);
         return;
     }
     sherpaonnx::SttWrapper *wrapper = it->second->wrapper.get();
@@ -347,8 +875,10 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
         for (NSNumber *n in samples) {
             floatSamples.push_back([n floatValue]);
         }
-        sherpaonnx::SttRecognitionResult result = wrapper->transcribeSamples(floatSamples, static_cast<int32_t>(sampleRate));
-        resolve(sttResultToDict(result));
+        const uint32_t fields = sttResultFields(resultFields);
+        sherpaonnx::SttRecognitionResult result =
+            wrapper->transcribeSamples(floatSamples, static_cast<int32_t>(sampleRate), fields);
+        resolve(sttResultToDict(result, fields));
     } catch (const std::exception& e) {
         NSString *errorMsg = e.what() ? [NSString stringWithUTF8String:e.what()] : @"Recognition failed.";
         if (!errorMsg) errorMsg = @"Recognition failed.";
@@ -361,6 +891,256 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
     }
 }
 
+/**
+ * Raw PCM (base64, e.g. a pcmLiveStreamData chunk passed through untouched) decoded straight from
+ * its bytes: no per-sample NSNumber boxing, one conversion (SIMD for int16) into the stream input.
+ */
+- (void)transcribePcm:(NSString *)instanceId
+            base64Pcm:(NSString *)base64Pcm
+           sampleRate:(double)sampleRate
+             encoding:(NSString *)encoding
+         resultFields:(NSNumber *)resultFields
+              resolve:(RCTPromiseResolveBlock)resolve
+               reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId == nil || [instanceId length] == 0) {
+        reject(@"TRANSCRIBE_ERROR", @"instanceId is required", nil);
+        return;
+    }
+    sherpaonnx::PcmEncoding pcmEncoding = sherpaonnx::PcmEncoding::kInt16;
+    if (encoding != nil && [encoding length] > 0 && !sherpaonnx::ParsePcmEncoding([encoding UTF8String], &pcmEncoding)) {
+        reject(@"TRANSCRIBE_ERROR", [NSString stringWithFormat:@"Unsupported PCM encoding: %@ (use int16 or float32)", encoding], nil);
+        return;
+    }
+    NSData *data = base64Pcm != nil ? [[NSData alloc] initWithBase64EncodedString:base64Pcm options:0] : nil;
+    if (data == nil) {
+        reject(@"TRANSCRIBE_ERROR", @"base64Pcm is not valid base64", nil);
+        return;
+    }
+    std::string instanceIdStr = [instanceId UTF8String];
+    std::lock_guard<std::mutex> lock(g_stt_mutex);
+    auto it = g_stt_instances.find(instanceIdStr);
+    if (it == g_stt_instances.end() || it->second->wrapper == nullptr || !it->second->wrapper->isInitialized()) {
+        sttRejectNotLoaded(it == g_stt_instances.end() ? nullptr : it->second.get(), @"TRANSCRIBE_ERROR", reject);
+        return;
+    }
+    sherpaonnx::SttWrapper *wrapper = it->second->wrapper.get();
+    try {
+        const uint32_t fields = sttResultFields(resultFields);
+        sherpaonnx::SttRecognitionResult result =
+            wrapper->transcribePcm(data.bytes, data.length, pcmEncoding, static_cast<int32_t>(sampleRate), fields);
+        resolve(sttResultToDict(result, fields));
+    } catch (const std::exception& e) {
+        NSString *errorMsg = e.what() ? [NSString stringWithUTF8String:e.what()] : @"Recognition failed.";
+        if (!errorMsg) errorMsg = @"Recognition failed.";
+        RCTLogError(@"TranscribePcm error: %@", errorMsg);
+        reject(@"TRANSCRIBE_ERROR", errorMsg, nil);
+    } catch (...) {
+        NSString *errorMsg = @"Unknown error during transcription";
+        RCTLogError(@"TranscribePcm error: %@", errorMsg);
+        reject(@"TRANSCRIBE_ERROR", errorMsg, nil);
+    }
+}
+
+- (void)transcribeFiles:(NSString *)instanceId
+              requestId:(NSString *)requestId
+                  paths:(NSArray *)paths
+                options:(NSDictionary *)options
+                resolve:(RCTPromiseResolveBlock)resolve
+                 reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId == nil || [instanceId length] == 0) {
+        reject(@"TRANSCRIBE_ERROR", @"instanceId is required", nil);
+        return;
+    }
+    std::vector<std::string> pathList;
+    pathList.reserve([paths count]);
+    for (id path in paths) {
+        pathList.push_back([path isKindOfClass:[NSString class]] ? std::string([path UTF8String]) : std::string());
+    }
+    sherpaonnx::SttBatchOptions batchOptions;
+    int32_t ioThreads = 2;
+    const uint32_t fields = sttResultFields(options != nil ? options[@"resultFields"] : nil);
+    if (options != nil) {
+        if (options[@"maxBatchSize"] != nil) batchOptions.maxBatchSize = std::max(1, [options[@"maxBatchSize"] intValue]);
+        if (options[@"maxPaddedSeconds"] != nil) batchOptions.maxPaddedSeconds = [options[@"maxPaddedSeconds"] doubleValue];
+        if (options[@"ioThreads"] != nil) ioThreads = std::min(8, std::max(1, [options[@"ioThreads"] intValue]));
+    }
+    std::string instanceIdStr = [instanceId UTF8String];
+    NSString *instanceIdCopy = [instanceId copy];
+    NSString *requestIdCopy = [requestId copy] ?: @"";
+
+    __weak SherpaOnnx *weakSelf = self;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        // Held for the whole batch, as for transcribeFile, so unloadStt cannot release the recognizer mid-decode.
+        std::lock_guard<std::mutex> lock(g_stt_mutex);
+        auto it = g_stt_instances.find(instanceIdStr);
+        if (it == g_stt_instances.end() || it->second->wrapper == nullptr || !it->second->wrapper->isInitialized()) {
+            sttRejectNotLoaded(it == g_stt_instances.end() ? nullptr : it->second.get(), @"TRANSCRIBE_ERROR", reject);
+            return;
+        }
+        sherpaonnx::SttWrapper *wrapper = it->second->wrapper.get();
+        const auto startTime = std::chrono::steady_clock::now();
+        const NSUInteger total = pathList.size();
+        NSMutableArray *results = [NSMutableArray arrayWithCapacity:total];
+        for (NSUInteger i = 0; i < total; i++) [results addObject:[NSNull null]];
+        __block NSInteger completed = 0;
+        __block NSInteger succeeded = 0;
+        const sherpaonnx::SttWavConverter converter = sttWavConverter();
+        try {
+            const sherpaonnx::SttBatchStats stats = wrapper->transcribeFiles(
+                pathList, batchOptions, ioThreads, converter,
+                [&](const sherpaonnx::SttBatchItem &item) {
+                    @autoreleasepool {
+                        const bool success = item.error.empty();
+                        NSMutableDictionary *itemDict = success
+                            ? [sttResultToDict(item.result, fields) mutableCopy]
+                            : [NSMutableDictionary dictionary];
+                        itemDict[@"index"] = @(item.index);
+                        itemDict[@"path"] = [NSString stringWithUTF8String:item.path.c_str()] ?: @"";
+                        itemDict[@"success"] = @(success);
+                        if (!success) itemDict[@"error"] = [NSString stringWithUTF8String:item.error.c_str()] ?: @"Recognition failed.";
+                        if (success) succeeded++;
+                        completed++;
+                        results[item.index] = itemDict;
+                        NSMutableDictionary *payload = [itemDict mutableCopy];
+                        payload[@"instanceId"] = instanceIdCopy;
+                        payload[@"requestId"] = requestIdCopy;
+                        payload[@"completed"] = @(completed);
+                        payload[@"total"] = @(total);
+                        dispatch_async(dispatch_get_main_queue(), ^{
+                            if (weakSelf) {
+                                [weakSelf sendEventWithName:@"sttBatchResult" body:payload];
+                            }
+                        });
+                    }
+                },
+                fields);
+            const double elapsedMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - startTime).count();
+            resolve(@{
+                @"results": results,
+                @"succeeded": @(succeeded),
+                @"failed": @((NSInteger)total - succeeded),
+                @"total": @(total),
+                @"batches": @(stats.batches),
+                @"audioMs": @(stats.audioMs),
+                @"decodeMs": @(stats.decodeMs),
+                @"elapsedMs": @(elapsedMs),
+                @"realTimeFactor": @(stats.audioMs > 0.0 ? stats.decodeMs / stats.audioMs : 0.0)
+            });
+        } catch (const std::exception& e) {
+            NSString *errorMsg = e.what() ? [NSString stringWithUTF8String:e.what()] : @"Recognition failed.";
+            RCTLogError(@"TranscribeFiles error: %@", errorMsg);
+            reject(@"TRANSCRIBE_ERROR", errorMsg ?: @"Recognition failed.", nil);
+        } catch (...) {
+            reject(@"TRANSCRIBE_ERROR", @"Unknown error during transcription", nil);
+        }
+    });
+}
+
+- (void)transcribeLongFile:(NSString *)instanceId
+                  requestId:(NSString *)requestId
+                   filePath:(NSString *)filePath
+                    options:(NSDictionary *)options
+                    resolve:(RCTPromiseResolveBlock)resolve
+                     reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId == nil || [instanceId length] == 0) {
+        reject(@"TRANSCRIBE_ERROR", @"instanceId is required", nil);
+        return;
+    }
+    if (filePath == nil || [filePath length] == 0) {
+        reject(@"TRANSCRIBE_ERROR", @"filePath is required", nil);
+        return;
+    }
+    sherpaonnx::SttLongFormOptions longOptions;
+    if (options != nil) {
+        if ([options[@"vadModel"] isKindOfClass:[NSString class]]) longOptions.vadModel = [options[@"vadModel"] UTF8String];
+        if ([options[@"vadType"] isKindOfClass:[NSString class]]) longOptions.vadType = [[options[@"vadType"] lowercaseString] UTF8String];
+        if (options[@"threshold"] != nil) longOptions.threshold = [options[@"threshold"] floatValue];
+        if (options[@"minSilenceDuration"] != nil) longOptions.minSilenceDuration = [options[@"minSilenceDuration"] floatValue];
+        if (options[@"minSpeechDuration"] != nil) longOptions.minSpeechDuration = [options[@"minSpeechDuration"] floatValue];
+        if (options[@"maxSegmentSeconds"] != nil) longOptions.maxSegmentSeconds = std::max(1.0f, [options[@"maxSegmentSeconds"] floatValue]);
+        if (options[@"paddingMs"] != nil) longOptions.paddingMs = std::max(0.0, [options[@"paddingMs"] doubleValue]);
+        if (options[@"maxBatchSize"] != nil) longOptions.maxBatchSize = std::max(1, [options[@"maxBatchSize"] intValue]);
+        if (options[@"vadThreads"] != nil) longOptions.vadThreads = std::max(1, [options[@"vadThreads"] intValue]);
+        longOptions.resultFields = sttResultFields(options[@"resultFields"]);
+    }
+    if (longOptions.vadModel.empty()) {
+        reject(@"TRANSCRIBE_ERROR", @"options.vadModel (silero_vad.onnx or ten-vad.onnx) is required", nil);
+        return;
+    }
+    std::string instanceIdStr = [instanceId UTF8String];
+    std::string filePathStr = [filePath UTF8String];
+    NSString *instanceIdCopy = [instanceId copy];
+    NSString *requestIdCopy = [requestId copy] ?: @"";
+
+    __weak SherpaOnnx *weakSelf = self;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        // Held for the whole file, as for transcribeFile, so unloadStt cannot release the recognizer mid-decode.
+        std::lock_guard<std::mutex> lock(g_stt_mutex);
+        auto it = g_stt_instances.find(instanceIdStr);
+        if (it == g_stt_instances.end() || it->second->wrapper == nullptr || !it->second->wrapper->isInitialized()) {
+            sttRejectNotLoaded(it == g_stt_instances.end() ? nullptr : it->second.get(), @"TRANSCRIBE_ERROR", reject);
+            return;
+        }
+        sherpaonnx::SttWrapper *wrapper = it->second->wrapper.get();
+        const auto startTime = std::chrono::steady_clock::now();
+        try {
+            const sherpaonnx::SttLongFormResult result = wrapper->transcribeLongFile(
+                filePathStr, longOptions, sttWavConverter(),
+                [&](const sherpaonnx::SttLongFormSegment &segment) {
+                    @autoreleasepool {
+                        const bool success = segment.error.empty();
+                        NSMutableDictionary *payload = [NSMutableDictionary dictionary];
+                        payload[@"instanceId"] = instanceIdCopy;
+                        payload[@"requestId"] = requestIdCopy;
+                        payload[@"index"] = @(segment.index);
+                        payload[@"start"] = @(segment.start);
+                        payload[@"end"] = @(segment.end);
+                        payload[@"text"] = success ? ([NSString stringWithUTF8String:segment.result.text.c_str()] ?: @"") : @"";
+                        payload[@"success"] = @(success);
+                        if (!success) payload[@"error"] = [NSString stringWithUTF8String:segment.error.c_str()] ?: @"Recognition failed.";
+                        payload[@"progress"] = @(segment.progress);
+                        dispatch_async(dispatch_get_main_queue(), ^{
+                            if (weakSelf) {
+                                [weakSelf sendEventWithName:@"sttLongFormSegment" body:payload];
+                            }
+                        });
+                    }
+                });
+            NSMutableArray *segments = [NSMutableArray arrayWithCapacity:result.segments.size()];
+            for (const auto &segment : result.segments) {
+                if (!segment.error.empty()) continue;
+                [segments addObject:@{
+                    @"start": @(segment.start),
+                    @"end": @(segment.end),
+                    @"text": [NSString stringWithUTF8String:segment.result.text.c_str()] ?: @""
+                }];
+            }
+            const double elapsedMs = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - startTime).count();
+            NSMutableDictionary *dict = [sttResultToDict(result.merged, longOptions.resultFields) mutableCopy];
+            dict[@"segments"] = segments;
+            dict[@"failedSegments"] = @(result.failedSegments);
+            dict[@"audioMs"] = @(result.audioMs);
+            dict[@"speechMs"] = @(result.speechMs);
+            dict[@"vadMs"] = @(result.vadMs);
+            dict[@"decodeMs"] = @(result.decodeMs);
+            dict[@"elapsedMs"] = @(elapsedMs);
+            dict[@"realTimeFactor"] = @(result.audioMs > 0.0 ? result.decodeMs / result.audioMs : 0.0);
+            resolve(dict);
+        } catch (const std::exception& e) {
+            NSString *errorMsg = e.what() ? [NSString stringWithUTF8String:e.what()] : @"Recognition failed.";
+            RCTLogError(@"TranscribeLongFile error: %@", errorMsg);
+            reject(@"TRANSCRIBE_ERROR", errorMsg ?: @"Recognition failed.", nil);
+        } catch (...) {
+            reject(@"TRANSCRIBE_ERROR", @"Unknown error during transcription", nil);
+        }
+    });
+}
+
 - (void)setSttConfig:(NSString *)instanceId
              options:(NSDictionary *)options
               resolve:(RCTPromiseResolveBlock)resolve
@@ -374,7 +1154,7 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
     std::lock_guard<std::mutex> lock(g_stt_mutex);
     auto it = g_stt_instances.find(instanceIdStr);
     if (it == g_stt_instances.end() || it->second->wrapper == nullptr || !it->second->wrapper->isInitialized()) {
-        reject(@"CONFIG_ERROR", @"STT not initialized. Call initializeStt first.", nil);
+        sttRejectNotLoaded(it == g_stt_instances.end() ? nullptr : it->second.get(), @"CONFIG_ERROR", reject);
         return;
     }
     sherpaonnx::SttWrapper *wrapper = it->second->wrapper.get();
@@ -441,8 +1221,12 @@ static NSDictionary *sttResultToDict(const sherpaonnx::SttRecognitionResult& r)
         std::lock_guard<std::mutex> lock(g_stt_mutex);
         auto it = g_stt_instances.find(instanceIdStr);
         if (it != g_stt_instances.end()) {
-            it->second->wrapper->release();
-            it->second->wrapper.reset();
+            // A background load still running drops its recognizer when it finds the instance gone.
+            sttCompleteLoadLocked(it->second->load, nil, @"INIT_ERROR", @"STT instance was unloaded while loading");
+            if (it->second->wrapper != nullptr) {
+                it->second->wrapper->release();
+                it->second->wrapper.reset();
+            }
             g_stt_instances.erase(it);
         }
         RCTLogInfo(@"STT instance %@ released", instanceId);
@@ -6,15 +6,22 @@
  */
 
 #import "SherpaOnnx.h"
+#import "SherpaOnnxAudioConvert.h"
 #import <React/RCTLog.h>
 #import <React/RCTUtils.h>
 #import <UIKit/UIKit.h>
 #import <AVFoundation/AVFoundation.h>
 
 #include "sherpa-onnx-tts-wrapper.h"
+#include "sherpa-onnx-tts-export-writer.h"
+#include "sherpa-onnx-tts-playback-buffer.h"
+#include "sherpa-onnx-tts-sentence-pipeline.h"
+#include "sherpa-onnx-tts-time-stretch.h"
 #include "sherpa-onnx-model-detect.h"
 #include <atomic>
 #include <condition_variable>
+#include <cstdio>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -23,13 +30,35 @@
 #include <vector>
 #include <chrono>
 
+// Text input of a running text stream (startTtsTextStream): pushTtsText cuts fragments into
+// segments and queues them for the stream worker, which synthesizes them in order.
+struct TtsTextSessionState {
+    std::string requestId;
+    std::mutex mutex;
+    std::condition_variable cv;
+    sherpaonnx::IncrementalTextSegmenter segmenter;  // guarded by mutex
+    std::deque<std::string> segments;                // guarded by mutex
+    bool closed = false;       // closeTtsText: end once segments are done (guarded by mutex)
+    int64_t firstTextMs = -1;  // first pushTtsText, for time to first audio (guarded by mutex)
+};
+
 struct TtsInstanceState {
-    std::unique_ptr<sherpaonnx::TtsWrapper> wrapper;
+    // Shared with one-shot requests, which synthesize without g_tts_mutex (see TtsWrapperRef).
+    std::shared_ptr<sherpaonnx::TtsWrapper> wrapper;
     std::atomic<bool> streamRunning{false};
     std::atomic<bool> streamCancelled{false};
+    // Scheduler ticket of the running stream (0 = none), so cancelTtsStream can stop it while queued.
+    std::atomic<uint64_t> streamTicket{0};
     __strong AVAudioEngine *engine = nil;
-    __strong AVAudioPlayerNode *player = nil;
+    __strong AVAudioSourceNode *sourceNode = nil;
     __strong AVAudioFormat *format = nil;
+    // Jitter buffer the source node's render block pulls from (shared with the block).
+    std::shared_ptr<sherpaonnx::TtsPlaybackBuffer> playback;
+    // Time-stretches what the render block pulls at the player tempo (setTtsPcmPlayerTempo).
+    std::shared_ptr<sherpaonnx::StretchedFrameReader> playerReader;
+    float playerTempo = 1.0f;  // kept across player restarts
+    // Set while the running stream is a text session (guarded by g_tts_mutex).
+    std::shared_ptr<TtsTextSessionState> textSession;
     __strong NSString *modelDir = nil;
     __strong NSString *modelType = nil;
     int32_t numThreads = 2;
@@ -48,6 +77,189 @@ static std::unordered_map<std::string, std::shared_ptr<TtsInstanceState>> g_tts_
 static std::mutex g_tts_mutex;
 static std::condition_variable g_tts_stream_cv;
 
+/**
+ * A one-shot request's reference to an instance's wrapper, taken under g_tts_mutex so synthesis
+ * (and encoding) can run without it. Dropping it wakes initialize / updateParams, which wait on
+ * g_tts_stream_cv until no request holds the wrapper before re-initializing it in place. After an
+ * unload, the last reference releases the wrapper.
+ */
+class TtsWrapperRef {
+public:
+    explicit TtsWrapperRef(const std::string& instanceId) {
+        std::lock_guard<std::mutex> lock(g_tts_mutex);
+        auto it = g_tts_instances.find(instanceId);
+        if (it != g_tts_instances.end() && it->second->wrapper && it->second->wrapper->isInitialized()) {
+            wrapper_ = it->second->wrapper;
+        }
+    }
+    ~TtsWrapperRef() {
+        if (!wrapper_) return;
+        {
+            std::lock_guard<std::mutex> lock(g_tts_mutex);
+            wrapper_.reset();
+        }
+        g_tts_stream_cv.notify_all();
+    }
+    TtsWrapperRef(const TtsWrapperRef&) = delete;
+    TtsWrapperRef& operator=(const TtsWrapperRef&) = delete;
+
+    /** Null when the instance is missing or not initialized. */
+    sherpaonnx::TtsWrapper *get() const { return wrapper_.get(); }
+
+private:
+    std::shared_ptr<sherpaonnx::TtsWrapper> wrapper_;
+};
+
+/** Wait (releasing lock) until no one-shot request holds inst's wrapper. lock holds g_tts_mutex. */
+static void WaitForTtsRequests(std::unique_lock<std::mutex>& lock, const std::shared_ptr<TtsInstanceState>& inst) {
+    g_tts_stream_cv.wait(lock, [&inst] { return !inst->wrapper || inst->wrapper.use_count() == 1; });
+}
+
+static int64_t PlaybackNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Push samples into the jitter buffer, waiting while it is full; stops early once closed or stop() is true. */
+template <typename Stop>
+static void WritePlayback(sherpaonnx::TtsPlaybackBuffer &playback, const float *samples, int32_t n, Stop stop) {
+    int32_t offset = 0;
+    while (offset < n) {
+        offset += playback.Push(samples + offset, n - offset, PlaybackNowMs());
+        if (offset < n && (!playback.WaitWritable(n - offset, 50) || stop())) break;
+    }
+}
+
+/** Stop the PCM player and drop its jitter buffer. Caller holds g_tts_mutex. */
+static void StopPcmPlayer(TtsInstanceState *inst) {
+    if (inst->engine != nil) {
+        [inst->engine stop];
+        [inst->engine reset];
+    }
+    if (inst->playback) inst->playback->Close();
+    inst->sourceNode = nil;
+    inst->engine = nil;
+    inst->format = nil;
+    inst->playback.reset();
+    inst->playerReader.reset();
+}
+
+/** options.tempo: post-synthesis playback speed (WSOLA time-stretch, pitch kept); 1 = as generated. */
+static float TtsTempoFromOptions(NSDictionary *options) {
+    if (options == nil || options[@"tempo"] == nil) return 1.0f;
+    const float tempo = [options[@"tempo"] floatValue];
+    return tempo > 0.0f ? tempo : 1.0f;
+}
+
+/** The open text session requestId of instanceId, or null. */
+static std::shared_ptr<TtsTextSessionState> FindTextSession(NSString *instanceId, NSString *requestId) {
+    if (instanceId == nil || requestId == nil) return nullptr;
+    std::lock_guard<std::mutex> lock(g_tts_mutex);
+    auto it = g_tts_instances.find([instanceId UTF8String]);
+    if (it == g_tts_instances.end() || !it->second->textSession) return nullptr;
+    auto session = it->second->textSession;
+    return session->requestId == [requestId UTF8String] ? session : nullptr;
+}
+
+/**
+ * Run update on an open session under its mutex and wake the worker; rejects when the session is
+ * unknown or already closed.
+ */
+template <typename Update>
+static void UpdateTextSession(NSString *instanceId, NSString *requestId, Update update,
+                              RCTPromiseResolveBlock resolve, RCTPromiseRejectBlock reject) {
+    auto session = FindTextSession(instanceId, requestId);
+    {
+        std::unique_lock<std::mutex> lock;
+        if (session) lock = std::unique_lock<std::mutex>(session->mutex);
+        if (!session || session->closed) {
+            reject(@"TTS_SESSION_ERROR", [NSString stringWithFormat:@"No open text session %@", requestId], nil);
+            return;
+        }
+        update(*session);
+    }
+    session->cv.notify_all();
+    resolve(nil);
+}
+
+/** Scheduler ticket for a generate call from options.priority / options.deadlineMs. */
+static uint64_t SubmitTtsRequest(sherpaonnx::TtsWrapper *wrapper, NSDictionary *options) {
+    int32_t priority = sherpaonnx::kRequestPriorityNormal;
+    int64_t deadlineMs = 0;
+    if (options != nil) {
+        if ([options[@"priority"] isKindOfClass:[NSString class]]) {
+            priority = sherpaonnx::ParseRequestPriority([options[@"priority"] UTF8String]);
+        }
+        if (options[@"deadlineMs"] != nil) deadlineMs = [options[@"deadlineMs"] longLongValue];
+    }
+    return wrapper->submitRequest(priority, deadlineMs);
+}
+
+static NSDictionary *TtsRequestStatsToDict(const sherpaonnx::TtsRequestStats& stats) {
+    return @{
+        @"timeToFirstChunkMs": @(stats.timeToFirstChunkMs),
+        @"synthesisMs": @(stats.synthesisMs),
+        @"audioMs": @(stats.audioMs),
+        @"realTimeFactor": @(stats.realTimeFactor),
+        @"chunkCount": @(stats.chunkCount),
+        @"minChunkSamples": @(stats.chunkSamples.Min()),
+        @"meanChunkSamples": @(stats.chunkSamples.Mean()),
+        @"maxChunkSamples": @(stats.chunkSamples.Max()),
+        @"bytesCopied": @(stats.bytesCopied),
+    };
+}
+
+static NSDictionary *StatsHistogramToDict(const sherpaonnx::StatsHistogram& histogram) {
+    NSMutableArray *upperBounds = [NSMutableArray arrayWithCapacity:histogram.UpperBounds().size()];
+    for (double bound : histogram.UpperBounds()) [upperBounds addObject:@(bound)];
+    NSMutableArray *counts = [NSMutableArray arrayWithCapacity:histogram.Counts().size()];
+    for (uint64_t count : histogram.Counts()) [counts addObject:@(count)];
+    return @{
+        @"count": @(histogram.Count()),
+        @"mean": @(histogram.Mean()),
+        @"min": @(histogram.Min()),
+        @"max": @(histogram.Max()),
+        @"p50": @(histogram.Percentile(0.5)),
+        @"p90": @(histogram.Percentile(0.9)),
+        @"p99": @(histogram.Percentile(0.99)),
+        @"upperBounds": upperBounds,
+        @"counts": counts,
+    };
+}
+
+/** Encoder for batch export: non-WAV items go through the FFmpeg conversion used by convertAudioToFormat. */
+static sherpaonnx::TtsExportEncoder MakeTtsExportEncoder(int32_t outputSampleRateHz) {
+    return [outputSampleRateHz](const std::string &wavPath, const std::string &outputPath, const std::string &format) -> std::string {
+        @autoreleasepool {
+            NSError *error = nil;
+            if ([SherpaOnnxAudioConvert convertAudioToFormat:[NSString stringWithUTF8String:wavPath.c_str()]
+                                                  outputPath:[NSString stringWithUTF8String:outputPath.c_str()]
+                                                      format:[NSString stringWithUTF8String:format.c_str()]
+                                          outputSampleRateHz:outputSampleRateHz
+                                                       error:&error]) {
+                return std::string();
+            }
+            return error != nil ? std::string([error.localizedDescription UTF8String]) : std::string("Conversion failed");
+        }
+    };
+}
+
+/** Per-item export result, as in the ttsExportProgress event and the exportTtsBatch result. */
+static NSMutableDictionary *TtsExportResultToDict(const sherpaonnx::TtsExportResult &r) {
+    NSMutableDictionary *dict = [NSMutableDictionary dictionaryWithDictionary:@{
+        @"index": @(r.index),
+        @"path": [NSString stringWithUTF8String:r.path.c_str()],
+        @"success": @(r.error.empty()),
+        @"encodeMs": @(r.encodeMs),
+    }];
+    if (!r.error.empty()) dict[@"error"] = [NSString stringWithUTF8String:r.error.c_str()];
+    if (r.sampleRate > 0) {
+        dict[@"sampleRate"] = @(r.sampleRate);
+        dict[@"durationMs"] = @(static_cast<double>(r.numSamples) * 1000.0 / r.sampleRate);
+    }
+    return dict;
+}
+
 static NSString *ttsModelKindToNSString(sherpaonnx::TtsModelKind kind) {
     using K = sherpaonnx::TtsModelKind;
     switch (kind) {
@@ -90,6 +302,7 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
        maxNumSentences:(NSNumber *)maxNumSentences
          silenceScale:(NSNumber *)silenceScale
             provider:(NSString *)provider
+              warmUp:(NSNumber *)warmUp
          resolve:(RCTPromiseResolveBlock)resolve
          reject:(RCTPromiseRejectBlock)reject
 {
@@ -101,14 +314,19 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
     RCTLogInfo(@"Initializing TTS instance %@ with modelDir: %@, modelType: %@", instanceId, modelDir, modelType);
 
     @try {
-        std::lock_guard<std::mutex> lock(g_tts_mutex);
+        std::unique_lock<std::mutex> lock(g_tts_mutex);
         auto it = g_tts_instances.find(instanceIdStr);
+        if (it != g_tts_instances.end()) {
+            // The wrapper is re-initialized in place: let one-shot requests on it finish first.
+            WaitForTtsRequests(lock, std::shared_ptr<TtsInstanceState>(it->second));
+            it = g_tts_instances.find(instanceIdStr);
+        }
         if (it == g_tts_instances.end()) {
             g_tts_instances[instanceIdStr] = std::make_shared<TtsInstanceState>();
         }
         TtsInstanceState *inst = g_tts_instances[instanceIdStr].get();
         if (inst->wrapper == nullptr) {
-            inst->wrapper = std::make_unique<sherpaonnx::TtsWrapper>();
+            inst->wrapper = std::make_shared<sherpaonnx::TtsWrapper>();
         }
 
         std::string modelDirStr = [modelDir UTF8String];
@@ -160,7 +378,8 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
             ruleFarsOpt,
             maxNumSentencesOpt,
             silenceScaleOpt,
-            providerOpt
+            providerOpt,
+            warmUp != nil && [warmUp boolValue]
         );
 
         if (result.success) {
@@ -188,10 +407,13 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
                 [detectedModelsArray addObject:modelDict];
             }
 
-            NSDictionary *resultDict = @{
+            NSMutableDictionary *resultDict = [@{
                 @"success": @YES,
                 @"detectedModels": detectedModelsArray
-            };
+            } mutableCopy];
+            if (result.warmUpMs >= 0) {
+                resultDict[@"warmUpMs"] = @(result.warmUpMs);
+            }
 
             resolve(resultDict);
         } else {
@@ -259,8 +481,13 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
         return;
     }
     std::string instanceIdStr = [instanceId UTF8String];
-    std::lock_guard<std::mutex> lock(g_tts_mutex);
+    std::unique_lock<std::mutex> lock(g_tts_mutex);
     auto it = g_tts_instances.find(instanceIdStr);
+    if (it != g_tts_instances.end()) {
+        // The wrapper is re-initialized in place: let one-shot requests on it finish first.
+        WaitForTtsRequests(lock, std::shared_ptr<TtsInstanceState>(it->second));
+        it = g_tts_instances.find(instanceIdStr);
+    }
     if (it == g_tts_instances.end() || it->second->wrapper == nullptr || it->second->modelDir == nil || it->second->modelType == nil) {
         reject(@"TTS_UPDATE_ERROR", @"TTS instance not found or not initialized", nil);
         return;
@@ -393,33 +620,57 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
     }
     double sid = 0;
     double speed = 1.0;
+    int32_t parallelSentences = 1;
+    int32_t sentenceSilenceMs = 0;
     if (options != nil) {
         if (options[@"sid"] != nil) sid = [options[@"sid"] doubleValue];
         if (options[@"speed"] != nil) speed = [options[@"speed"] doubleValue];
+        if (options[@"parallelSentences"] != nil) parallelSentences = [options[@"parallelSentences"] intValue];
+        if (options[@"sentenceSilenceMs"] != nil) sentenceSilenceMs = [options[@"sentenceSilenceMs"] intValue];
     }
     std::string instanceIdStr = [instanceId UTF8String];
-    std::lock_guard<std::mutex> lock(g_tts_mutex);
-    auto it = g_tts_instances.find(instanceIdStr);
-    if (it == g_tts_instances.end() || it->second->wrapper == nullptr || !it->second->wrapper->isInitialized()) {
+    TtsWrapperRef wrapperRef(instanceIdStr);
+    sherpaonnx::TtsWrapper *wrapper = wrapperRef.get();
+    if (wrapper == nullptr) {
         reject(@"TTS_NOT_INITIALIZED", @"TTS not initialized. Call initializeTts() first.", nil);
         return;
     }
-    sherpaonnx::TtsWrapper *wrapper = it->second->wrapper.get();
+    const uint64_t ticket = SubmitTtsRequest(wrapper, options);
     @try {
         std::string textStr = [text UTF8String];
 
-        auto result = wrapper->generate(
-            textStr,
-            static_cast<int32_t>(sid),
-            static_cast<float>(speed)
-        );
-
+        auto result = parallelSentences > 1
+            ? wrapper->generateParallel(
+                  textStr,
+                  static_cast<int32_t>(sid),
+                  static_cast<float>(speed),
+                  parallelSentences,
+                  sentenceSilenceMs,
+                  ticket)
+            : wrapper->generate(
+                  textStr,
+                  static_cast<int32_t>(sid),
+                  static_cast<float>(speed),
+                  ticket);
+        const bool stopped = wrapper->requestStopped(ticket);
+        const int64_t queueWaitMs = wrapper->finishRequest(ticket);
+
+        if (stopped) {
+            reject(@"TTS_DEADLINE_EXCEEDED", @"TTS request deadline passed before synthesis completed", nil);
+            return;
+        }
         if (result.samples.empty() || result.sampleRate == 0) {
             NSString *errorMsg = @"Failed to generate speech or result is empty";
             RCTLogError(@"%@", errorMsg);
             reject(@"TTS_GENERATE_ERROR", errorMsg, nil);
             return;
         }
+        // Cached audio is stored at tempo 1; the tempo is applied here so every tempo shares it.
+        const float tempo = TtsTempoFromOptions(options);
+        if (tempo != 1.0f) {
+            result.samples = sherpaonnx::WsolaTimeStretcher::Stretch(
+                result.samples.data(), result.samples.size(), result.sampleRate, tempo);
+        }
 
         NSMutableArray *samplesArray = [NSMutableArray arrayWithCapacity:result.samples.size()];
         for (float sample : result.samples) {
@@ -428,7 +679,9 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
 
         NSDictionary *resultDict = @{
             @"samples": samplesArray,
-            @"sampleRate": @(result.sampleRate)
+            @"sampleRate": @(result.sampleRate),
+            @"queueWaitMs": @(queueWaitMs),
+            @"stats": TtsRequestStatsToDict(result.stats)
         };
 
         RCTLogInfo(@"TTS: Generated %lu samples at %d Hz",
@@ -436,6 +689,7 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
 
         resolve(resultDict);
     } @catch (NSException *exception) {
+        wrapper->finishRequest(ticket);
         NSString *errorMsg = [NSString stringWithFormat:@"Exception during TTS generation: %@", exception.reason];
         RCTLogError(@"%@", errorMsg);
         reject(@"TTS_GENERATE_ERROR", errorMsg, nil);
@@ -459,28 +713,41 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
         if (options[@"speed"] != nil) speed = [options[@"speed"] doubleValue];
     }
     std::string instanceIdStr = [instanceId UTF8String];
-    std::lock_guard<std::mutex> lock(g_tts_mutex);
-    auto it = g_tts_instances.find(instanceIdStr);
-    if (it == g_tts_instances.end() || it->second->wrapper == nullptr || !it->second->wrapper->isInitialized()) {
+    TtsWrapperRef wrapperRef(instanceIdStr);
+    sherpaonnx::TtsWrapper *wrapper = wrapperRef.get();
+    if (wrapper == nullptr) {
         reject(@"TTS_NOT_INITIALIZED", @"TTS not initialized. Call initializeTts() first.", nil);
         return;
     }
-    sherpaonnx::TtsWrapper *wrapper = it->second->wrapper.get();
+    const uint64_t ticket = SubmitTtsRequest(wrapper, options);
     @try {
         std::string textStr = [text UTF8String];
 
         auto result = wrapper->generate(
             textStr,
             static_cast<int32_t>(sid),
-            static_cast<float>(speed)
+            static_cast<float>(speed),
+            ticket
         );
+        const bool stopped = wrapper->requestStopped(ticket);
+        const int64_t queueWaitMs = wrapper->finishRequest(ticket);
 
+        if (stopped) {
+            reject(@"TTS_DEADLINE_EXCEEDED", @"TTS request deadline passed before synthesis completed", nil);
+            return;
+        }
         if (result.samples.empty() || result.sampleRate == 0) {
             NSString *errorMsg = @"Failed to generate speech or result is empty";
             RCTLogError(@"%@", errorMsg);
             reject(@"TTS_GENERATE_ERROR", errorMsg, nil);
             return;
         }
+        // Subtitle times below are derived from the stretched length, so they follow the tempo.
+        const float tempo = TtsTempoFromOptions(options);
+        if (tempo != 1.0f) {
+            result.samples = sherpaonnx::WsolaTimeStretcher::Stretch(
+                result.samples.data(), result.samples.size(), result.sampleRate, tempo);
+        }
 
         NSMutableArray *samplesArray = [NSMutableArray arrayWithCapacity:result.samples.size()];
         for (float sample : result.samples) {
@@ -510,11 +777,136 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
             @"samples": samplesArray,
             @"sampleRate": @(result.sampleRate),
             @"subtitles": subtitlesArray,
-            @"estimated": @YES
+            @"estimated": @YES,
+            @"queueWaitMs": @(queueWaitMs),
+            @"stats": TtsRequestStatsToDict(result.stats)
         };
 
         resolve(resultDict);
     } @catch (NSException *exception) {
+        wrapper->finishRequest(ticket);
+        NSString *errorMsg = [NSString stringWithFormat:@"Exception during TTS generation: %@", exception.reason];
+        RCTLogError(@"%@", errorMsg);
+        reject(@"TTS_GENERATE_ERROR", errorMsg, nil);
+    }
+}
+
+- (void)generateTtsToFile:(NSString *)instanceId
+                     text:(NSString *)text
+                  options:(NSDictionary *)options
+                     path:(NSString *)path
+                   format:(NSString *)format
+                  resolve:(RCTPromiseResolveBlock)resolve
+                   reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId == nil || [instanceId length] == 0) {
+        reject(@"TTS_GENERATE_ERROR", @"instanceId is required", nil);
+        return;
+    }
+    if (path == nil || [path length] == 0) {
+        reject(@"TTS_SAVE_ERROR", @"path is required", nil);
+        return;
+    }
+    double sid = 0;
+    double speed = 1.0;
+    int32_t outputSampleRateHz = 0;
+    if (options != nil) {
+        if (options[@"sid"] != nil) sid = [options[@"sid"] doubleValue];
+        if (options[@"speed"] != nil) speed = [options[@"speed"] doubleValue];
+        if (options[@"outputSampleRateHz"] != nil) outputSampleRateHz = [options[@"outputSampleRateHz"] intValue];
+    }
+    const float tempo = TtsTempoFromOptions(options);
+    const std::string pathStr = [path UTF8String];
+    const std::string outputFormat = sherpaonnx::TtsExportWriter::ResolveFormat(pathStr, format != nil ? [format UTF8String] : "");
+    // Non-WAV output is encoded from a temporary WAV once synthesis is done.
+    const std::string wavPath = outputFormat == "wav" ? pathStr : pathStr + ".part.wav";
+    std::string instanceIdStr = [instanceId UTF8String];
+    TtsWrapperRef wrapperRef(instanceIdStr);
+    sherpaonnx::TtsWrapper *wrapper = wrapperRef.get();
+    if (wrapper == nullptr) {
+        reject(@"TTS_NOT_INITIALIZED", @"TTS not initialized. Call initializeTts() first.", nil);
+        return;
+    }
+    const int32_t sampleRate = wrapper->getSampleRate();
+    sherpaonnx::WavWriter writer;
+    if (sampleRate <= 0 || !writer.Open(wavPath, sampleRate)) {
+        reject(@"TTS_SAVE_ERROR", [NSString stringWithFormat:@"Failed to open %s for writing", wavPath.c_str()], nil);
+        return;
+    }
+    const uint64_t ticket = SubmitTtsRequest(wrapper, options);
+    @try {
+        std::string textStr = [text UTF8String];
+        sherpaonnx::TtsRequestStats stats;
+        bool ok = false;
+        if (tempo == 1.0f) {
+            ok = wrapper->generateStream(textStr, static_cast<int32_t>(sid), static_cast<float>(speed),
+                                         &writer, nullptr, ticket, &stats);
+        } else {
+            // Chunks are stretched as they arrive; only the stretcher's window is held in memory.
+            sherpaonnx::WsolaTimeStretcher stretcher(sampleRate, tempo);
+            std::vector<float> stretched;
+            bool writeFailed = false;
+            ok = wrapper->generateStream(
+                textStr, static_cast<int32_t>(sid), static_cast<float>(speed),
+                [&](const float *samples, int32_t numSamples, float /* progress */) -> int32_t {
+                    stretcher.Push(samples, numSamples);
+                    stretched.clear();
+                    stretcher.ReadAll(&stretched);
+                    if (!stretched.empty() && !writer.Append(stretched.data(), stretched.size())) {
+                        writeFailed = true;
+                        return 0;
+                    }
+                    return 1;
+                },
+                0, nullptr, ticket, &stats);
+            if (ok && !writeFailed) {
+                stretcher.Flush();
+                stretched.clear();
+                stretcher.ReadAll(&stretched);
+                if (!stretched.empty() && !writer.Append(stretched.data(), stretched.size())) writeFailed = true;
+            }
+            ok = ok && !writeFailed;
+        }
+        const bool stopped = wrapper->requestStopped(ticket);
+        const int64_t queueWaitMs = wrapper->finishRequest(ticket);
+        const bool finalized = writer.Finalize();
+        const uint64_t numSamples = writer.NumSamples();
+
+        if (stopped || !ok || !finalized || numSamples == 0) {
+            std::remove(wavPath.c_str());
+            if (stopped) {
+                reject(@"TTS_DEADLINE_EXCEEDED", @"TTS request deadline passed before synthesis completed", nil);
+            } else if (!finalized) {
+                reject(@"TTS_SAVE_ERROR", [NSString stringWithFormat:@"Failed to write %s", wavPath.c_str()], nil);
+            } else {
+                reject(@"TTS_GENERATE_ERROR", @"Failed to generate speech or result is empty", nil);
+            }
+            return;
+        }
+        if (outputFormat != "wav") {
+            const std::string error = MakeTtsExportEncoder(outputSampleRateHz)(wavPath, pathStr, outputFormat);
+            std::remove(wavPath.c_str());
+            if (!error.empty()) {
+                NSString *errorMsg = [NSString stringWithFormat:@"Failed to encode %s: %s", pathStr.c_str(), error.c_str()];
+                RCTLogError(@"%@", errorMsg);
+                reject(@"TTS_SAVE_ERROR", errorMsg, nil);
+                return;
+            }
+        }
+
+        resolve(@{
+            @"path": path,
+            @"format": [NSString stringWithUTF8String:outputFormat.c_str()],
+            @"sampleRate": @(sampleRate),
+            @"numSamples": @(numSamples),
+            @"durationMs": @(static_cast<double>(numSamples) * 1000.0 / sampleRate),
+            @"queueWaitMs": @(queueWaitMs),
+            @"stats": TtsRequestStatsToDict(stats)
+        });
+    } @catch (NSException *exception) {
+        wrapper->finishRequest(ticket);
+        writer.Finalize();
+        std::remove(wavPath.c_str());
         NSString *errorMsg = [NSString stringWithFormat:@"Exception during TTS generation: %@", exception.reason];
         RCTLogError(@"%@", errorMsg);
         reject(@"TTS_GENERATE_ERROR", errorMsg, nil);
@@ -534,12 +926,22 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
     }
     double sid = 0;
     double speed = 1.0;
+    int32_t parallelSentences = 1;
+    int32_t sentenceSilenceMs = 0;
+    int32_t firstChunkTargetMs = 0;
+    BOOL playbackRequested = NO;
+    const float tempo = TtsTempoFromOptions(options);
     if (options != nil) {
         if (options[@"sid"] != nil) sid = [options[@"sid"] doubleValue];
         if (options[@"speed"] != nil) speed = [options[@"speed"] doubleValue];
+        if (options[@"parallelSentences"] != nil) parallelSentences = [options[@"parallelSentences"] intValue];
+        if (options[@"sentenceSilenceMs"] != nil) sentenceSilenceMs = [options[@"sentenceSilenceMs"] intValue];
+        if (options[@"firstChunkTargetMs"] != nil) firstChunkTargetMs = [options[@"firstChunkTargetMs"] intValue];
+        if (options[@"playback"] != nil) playbackRequested = [options[@"playback"] boolValue];
     }
     std::string instanceIdStr = [instanceId UTF8String];
     std::shared_ptr<TtsInstanceState> instRef;
+    std::shared_ptr<sherpaonnx::TtsPlaybackBuffer> playback;
     {
         std::lock_guard<std::mutex> lock(g_tts_mutex);
         auto it = g_tts_instances.find(instanceIdStr);
@@ -554,49 +956,100 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
         }
         instRef->streamCancelled.store(false);
         instRef->streamRunning.store(true);
+        // Submitted before the worker starts so a cancel right after this call still finds it.
+        instRef->streamTicket.store(SubmitTtsRequest(instRef->wrapper.get(), options));
+        if (playbackRequested) playback = instRef->playback;
     }
+    const uint64_t ticket = instRef->streamTicket.load();
 
     std::string textStr = [text UTF8String];
     int32_t sampleRate = instRef->wrapper->getSampleRate();
+    if (playbackRequested && !playback) {
+        RCTLogWarn(@"TTS stream: playback requested but the PCM player is not running");
+    } else if (playback && playback->config().sampleRate != sampleRate) {
+        RCTLogWarn(@"TTS stream: PCM player runs at %d Hz, stream at %d Hz; not playing",
+                   playback->config().sampleRate, sampleRate);
+        playback.reset();
+    }
     NSString *instanceIdCopy = [instanceId copy];
     NSString *requestIdCopy = (requestId != nil && [requestId length] > 0) ? [requestId copy] : nil;
 
     __weak SherpaOnnx *weakSelf = self;
     dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
         bool success = false;
+        int64_t timeToFirstAudioMs = -1;
+        sherpaonnx::TtsRequestStats requestStats;
+        // Chunks are generated (and cached) at tempo 1 and stretched on the way out.
+        std::shared_ptr<sherpaonnx::WsolaTimeStretcher> stretcher;
+        if (tempo != 1.0f) stretcher = std::make_shared<sherpaonnx::WsolaTimeStretcher>(sampleRate, tempo);
+        auto emitPcm = [weakSelf, sampleRate, instanceIdCopy, requestIdCopy, instRef, playback](const float *samples, int32_t numSamples, float progress) {
+            if (playback) {
+                WritePlayback(*playback, samples, numSamples, [&instRef] { return instRef->streamCancelled.load(); });
+            }
+
+            NSMutableArray *samplesArray = [NSMutableArray arrayWithCapacity:numSamples];
+            for (int32_t i = 0; i < numSamples; i++) {
+                [samplesArray addObject:@(samples[i])];
+            }
+
+            NSMutableDictionary *payload = [NSMutableDictionary dictionaryWithDictionary:@{
+                @"instanceId": instanceIdCopy,
+                @"samples": samplesArray,
+                @"sampleRate": @(sampleRate),
+                @"progress": @(progress),
+                @"isFinal": @NO
+            }];
+            if (requestIdCopy != nil) payload[@"requestId"] = requestIdCopy;
+
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if (weakSelf) {
+                    [weakSelf sendEventWithName:@"ttsStreamChunk" body:payload];
+                }
+            });
+        };
         @try {
-            success = instRef->wrapper->generateStream(
-                textStr,
-                static_cast<int32_t>(sid),
-                static_cast<float>(speed),
-                [weakSelf, sampleRate, instanceIdCopy, requestIdCopy, instRef](const float *samples, int32_t numSamples, float progress) -> int32_t {
+            sherpaonnx::TtsWrapper::TtsStreamCallback onChunk =
+                [emitPcm, stretcher, instRef](const float *samples, int32_t numSamples, float progress) -> int32_t {
                     if (instRef->streamCancelled.load()) {
                         return 0;
                     }
-
-                    NSMutableArray *samplesArray = [NSMutableArray arrayWithCapacity:numSamples];
-                    for (int32_t i = 0; i < numSamples; i++) {
-                        [samplesArray addObject:@(samples[i])];
+                    if (stretcher) {
+                        std::vector<float> out;
+                        stretcher->Push(samples, numSamples);
+                        stretcher->ReadAll(&out);
+                        if (!out.empty()) emitPcm(out.data(), static_cast<int32_t>(out.size()), progress);
+                    } else {
+                        emitPcm(samples, numSamples, progress);
                     }
 
-                    NSMutableDictionary *payload = [NSMutableDictionary dictionaryWithDictionary:@{
-                        @"instanceId": instanceIdCopy,
-                        @"samples": samplesArray,
-                        @"sampleRate": @(sampleRate),
-                        @"progress": @(progress),
-                        @"isFinal": @NO
-                    }];
-                    if (requestIdCopy != nil) payload[@"requestId"] = requestIdCopy;
-
-                    dispatch_async(dispatch_get_main_queue(), ^{
-                        if (weakSelf) {
-                            [weakSelf sendEventWithName:@"ttsStreamChunk" body:payload];
-                        }
-                    });
-
                     return instRef->streamCancelled.load() ? 0 : 1;
-                }
-            );
+                };
+            if (parallelSentences > 1) {
+                // Long-text mode: sentences synthesized on an engine pool, chunks emitted in order.
+                success = instRef->wrapper->generateParallelStream(
+                    textStr,
+                    static_cast<int32_t>(sid),
+                    static_cast<float>(speed),
+                    parallelSentences,
+                    sentenceSilenceMs,
+                    onChunk,
+                    firstChunkTargetMs,
+                    &timeToFirstAudioMs,
+                    ticket,
+                    &requestStats
+                );
+            } else {
+                success = instRef->wrapper->generateStream(
+                    textStr,
+                    static_cast<int32_t>(sid),
+                    static_cast<float>(speed),
+                    onChunk,
+                    firstChunkTargetMs,
+                    &timeToFirstAudioMs,
+                    ticket,
+                    &requestStats
+                );
+            }
         } @catch (NSException *exception) {
             NSString *errorMsg = [NSString stringWithFormat:@"TTS streaming failed: %@", exception.reason];
             NSMutableDictionary *errPayload = [NSMutableDictionary dictionaryWithDictionary:@{ @"instanceId": instanceIdCopy, @"message": errorMsg }];
@@ -609,8 +1062,26 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
         }
 
         bool cancelled = instRef->streamCancelled.load();
-        if (!success && !cancelled) {
-            NSMutableDictionary *errPayload = [NSMutableDictionary dictionaryWithDictionary:@{ @"instanceId": instanceIdCopy, @"message": @"TTS streaming generation failed" }];
+        if (stretcher && success && !cancelled && !instRef->wrapper->requestStopped(ticket)) {
+            std::vector<float> tail;
+            stretcher->Flush();
+            stretcher->ReadAll(&tail);
+            if (!tail.empty()) emitPcm(tail.data(), static_cast<int32_t>(tail.size()), 1.0f);
+        }
+        if (playback) {
+            if (cancelled) {
+                playback->Clear();
+            } else {
+                playback->MarkEnd();
+            }
+        }
+        // Stopped by the scheduler without a cancel: the deadline passed.
+        const bool expired = !cancelled && instRef->wrapper->requestStopped(ticket);
+        const int64_t queueWaitMs = instRef->wrapper->finishRequest(ticket);
+        instRef->streamTicket.store(0);
+        if ((!success && !cancelled) || expired) {
+            NSString *message = expired ? @"TTS request deadline passed before synthesis completed" : @"TTS streaming generation failed";
+            NSMutableDictionary *errPayload = [NSMutableDictionary dictionaryWithDictionary:@{ @"instanceId": instanceIdCopy, @"message": message }];
             if (requestIdCopy != nil) errPayload[@"requestId"] = requestIdCopy;
             dispatch_async(dispatch_get_main_queue(), ^{
                 if (weakSelf) {
@@ -620,7 +1091,7 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
         }
 
         // Emit final chunk (empty, progress 1, isFinal YES) when not cancelled, matching Android behaviour
-        if (!cancelled) {
+        if (!cancelled && !expired) {
             NSMutableDictionary *finalPayload = [NSMutableDictionary dictionaryWithDictionary:@{
                 @"instanceId": instanceIdCopy,
                 @"samples": @[],
@@ -638,6 +1109,216 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
 
         NSMutableDictionary *endPayload = [NSMutableDictionary dictionaryWithDictionary:@{ @"instanceId": instanceIdCopy, @"cancelled": @(cancelled) }];
         if (requestIdCopy != nil) endPayload[@"requestId"] = requestIdCopy;
+        if (timeToFirstAudioMs >= 0) endPayload[@"timeToFirstAudioMs"] = @(timeToFirstAudioMs);
+        endPayload[@"queueWaitMs"] = @(queueWaitMs);
+        endPayload[@"stats"] = TtsRequestStatsToDict(requestStats);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (weakSelf) {
+                [weakSelf sendEventWithName:@"ttsStreamEnd" body:endPayload];
+            }
+        });
+
+        instRef->streamRunning.store(false);
+        {
+            std::lock_guard<std::mutex> lock(g_tts_mutex);
+            g_tts_stream_cv.notify_all();
+        }
+    });
+
+    resolve(nil);
+}
+
+- (void)startTtsTextStream:(NSString *)instanceId
+                  requestId:(NSString *)requestId
+                    options:(NSDictionary *)options
+                    resolve:(RCTPromiseResolveBlock)resolve
+                     reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId == nil || [instanceId length] == 0 || requestId == nil || [requestId length] == 0) {
+        reject(@"TTS_STREAM_ERROR", @"instanceId and requestId are required", nil);
+        return;
+    }
+    double sid = 0;
+    double speed = 1.0;
+    int32_t firstChunkTargetMs = 0;
+    BOOL playbackRequested = NO;
+    const float tempo = TtsTempoFromOptions(options);
+    if (options != nil) {
+        if (options[@"sid"] != nil) sid = [options[@"sid"] doubleValue];
+        if (options[@"speed"] != nil) speed = [options[@"speed"] doubleValue];
+        if (options[@"firstChunkTargetMs"] != nil) firstChunkTargetMs = [options[@"firstChunkTargetMs"] intValue];
+        if (options[@"playback"] != nil) playbackRequested = [options[@"playback"] boolValue];
+    }
+    std::string instanceIdStr = [instanceId UTF8String];
+    auto session = std::make_shared<TtsTextSessionState>();
+    session->requestId = [requestId UTF8String];
+    std::shared_ptr<TtsInstanceState> instRef;
+    std::shared_ptr<sherpaonnx::TtsPlaybackBuffer> playback;
+    {
+        std::lock_guard<std::mutex> lock(g_tts_mutex);
+        auto it = g_tts_instances.find(instanceIdStr);
+        if (it == g_tts_instances.end() || it->second->wrapper == nullptr || !it->second->wrapper->isInitialized()) {
+            reject(@"TTS_NOT_INITIALIZED", @"TTS not initialized. Call initializeTts() first.", nil);
+            return;
+        }
+        instRef = it->second;
+        if (instRef->streamRunning.load()) {
+            reject(@"TTS_STREAM_ERROR", @"TTS streaming already in progress", nil);
+            return;
+        }
+        instRef->streamCancelled.store(false);
+        instRef->streamRunning.store(true);
+        instRef->textSession = session;
+        instRef->streamTicket.store(SubmitTtsRequest(instRef->wrapper.get(), options));
+        if (playbackRequested) playback = instRef->playback;
+    }
+    const uint64_t ticket = instRef->streamTicket.load();
+
+    int32_t sampleRate = instRef->wrapper->getSampleRate();
+    if (playbackRequested && !playback) {
+        RCTLogWarn(@"TTS text stream: playback requested but the PCM player is not running");
+    } else if (playback && playback->config().sampleRate != sampleRate) {
+        RCTLogWarn(@"TTS text stream: PCM player runs at %d Hz, stream at %d Hz; not playing",
+                   playback->config().sampleRate, sampleRate);
+        playback.reset();
+    }
+    NSString *instanceIdCopy = [instanceId copy];
+    NSString *requestIdCopy = [requestId copy];
+
+    __weak SherpaOnnx *weakSelf = self;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        bool success = true;
+        int64_t firstAudioMs = -1;
+        uint64_t totalSamples = 0;
+        // Times the session from its first segment for the end event; each segment is also recorded
+        // in getStats().
+        sherpaonnx::TtsRequestTimer timer;
+        std::shared_ptr<sherpaonnx::WsolaTimeStretcher> stretcher;
+        if (tempo != 1.0f) stretcher = std::make_shared<sherpaonnx::WsolaTimeStretcher>(sampleRate, tempo);
+        auto emitPcm = [&, weakSelf](const float *samples, int32_t numSamples) {
+            if (firstAudioMs < 0 && numSamples > 0) firstAudioMs = PlaybackNowMs();
+            timer.OnChunk(static_cast<size_t>(numSamples));
+            timer.AddBytesCopied(static_cast<uint64_t>(numSamples) * sizeof(float));
+            totalSamples += static_cast<uint64_t>(numSamples);
+            if (playback) {
+                WritePlayback(*playback, samples, numSamples, [&instRef] { return instRef->streamCancelled.load(); });
+            }
+            NSMutableArray *samplesArray = [NSMutableArray arrayWithCapacity:numSamples];
+            for (int32_t i = 0; i < numSamples; i++) {
+                [samplesArray addObject:@(samples[i])];
+            }
+            NSDictionary *payload = @{
+                @"instanceId": instanceIdCopy,
+                @"requestId": requestIdCopy,
+                @"samples": samplesArray,
+                @"sampleRate": @(sampleRate),
+                @"progress": @0.0f,
+                @"isFinal": @NO
+            };
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if (weakSelf) {
+                    [weakSelf sendEventWithName:@"ttsStreamChunk" body:payload];
+                }
+            });
+        };
+        sherpaonnx::TtsWrapper::TtsStreamCallback onChunk =
+            [&emitPcm, &stretcher, &instRef](const float *samples, int32_t numSamples, float) -> int32_t {
+                if (instRef->streamCancelled.load()) return 0;
+                if (stretcher) {
+                    std::vector<float> out;
+                    stretcher->Push(samples, numSamples);
+                    stretcher->ReadAll(&out);
+                    if (!out.empty()) emitPcm(out.data(), static_cast<int32_t>(out.size()));
+                } else {
+                    emitPcm(samples, numSamples);
+                }
+                return instRef->streamCancelled.load() ? 0 : 1;
+            };
+        bool firstSegment = true;
+        for (;;) {
+            std::string segment;
+            {
+                std::unique_lock<std::mutex> lock(session->mutex);
+                // Wake regularly so a cancel or a deadline passing while no text arrives is noticed.
+                session->cv.wait_for(lock, std::chrono::milliseconds(100), [&] {
+                    return !session->segments.empty() || session->closed || instRef->streamCancelled.load();
+                });
+                if (instRef->streamCancelled.load() || instRef->wrapper->requestStopped(ticket)) break;
+                if (session->segments.empty()) {
+                    if (session->closed) break;
+                    continue;
+                }
+                segment = std::move(session->segments.front());
+                session->segments.pop_front();
+            }
+            // The first segment may still get the leading-clause fast path inside generateStream.
+            const int32_t target = firstSegment ? firstChunkTargetMs : 0;
+            if (firstSegment) timer.OnEngineAcquired();
+            firstSegment = false;
+            if (!instRef->wrapper->generateStream(segment, static_cast<int32_t>(sid), static_cast<float>(speed),
+                                                  onChunk, target, nullptr, ticket, nullptr)) {
+                success = false;
+                break;
+            }
+        }
+
+        bool cancelled = instRef->streamCancelled.load();
+        const bool expired = !cancelled && instRef->wrapper->requestStopped(ticket);
+        if (stretcher && success && !cancelled && !expired) {
+            std::vector<float> tail;
+            stretcher->Flush();
+            stretcher->ReadAll(&tail);
+            if (!tail.empty()) emitPcm(tail.data(), static_cast<int32_t>(tail.size()));
+        }
+        if (playback) {
+            if (cancelled) {
+                playback->Clear();
+            } else {
+                playback->MarkEnd();
+            }
+        }
+        const int64_t queueWaitMs = instRef->wrapper->finishRequest(ticket);
+        int64_t firstTextMs = -1;
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            session->closed = true;
+            firstTextMs = session->firstTextMs;
+        }
+        {
+            std::lock_guard<std::mutex> lock(g_tts_mutex);
+            if (instRef->textSession == session) instRef->textSession.reset();
+        }
+        instRef->streamTicket.store(0);
+        if ((!success && !cancelled) || expired) {
+            NSString *message = expired ? @"TTS request deadline passed before synthesis completed" : @"TTS text stream failed";
+            NSDictionary *errPayload = @{ @"instanceId": instanceIdCopy, @"requestId": requestIdCopy, @"message": message };
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if (weakSelf) {
+                    [weakSelf sendEventWithName:@"ttsStreamError" body:errPayload];
+                }
+            });
+        } else if (!cancelled) {
+            NSDictionary *finalPayload = @{
+                @"instanceId": instanceIdCopy,
+                @"requestId": requestIdCopy,
+                @"samples": @[],
+                @"sampleRate": @(sampleRate),
+                @"progress": @1.0f,
+                @"isFinal": @YES
+            };
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if (weakSelf) {
+                    [weakSelf sendEventWithName:@"ttsStreamChunk" body:finalPayload];
+                }
+            });
+        }
+
+        NSMutableDictionary *endPayload = [NSMutableDictionary dictionaryWithDictionary:@{
+            @"instanceId": instanceIdCopy, @"requestId": requestIdCopy, @"cancelled": @(cancelled) }];
+        // Measured from the first text pushed: how long the listener waits after the LLM starts.
+        if (firstAudioMs >= 0 && firstTextMs >= 0) endPayload[@"timeToFirstAudioMs"] = @(firstAudioMs - firstTextMs);
+        endPayload[@"queueWaitMs"] = @(queueWaitMs);
+        endPayload[@"stats"] = TtsRequestStatsToDict(timer.Finish(totalSamples, sampleRate));
         dispatch_async(dispatch_get_main_queue(), ^{
             if (weakSelf) {
                 [weakSelf sendEventWithName:@"ttsStreamEnd" body:endPayload];
@@ -654,6 +1335,186 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
     resolve(nil);
 }
 
+- (void)pushTtsText:(NSString *)instanceId
+          requestId:(NSString *)requestId
+               text:(NSString *)text
+            resolve:(RCTPromiseResolveBlock)resolve
+             reject:(RCTPromiseRejectBlock)reject
+{
+    std::string fragment = text != nil ? [text UTF8String] : "";
+    UpdateTextSession(instanceId, requestId, [&fragment](TtsTextSessionState &session) {
+        if (session.firstTextMs < 0) session.firstTextMs = PlaybackNowMs();
+        for (auto &segment : session.segmenter.Push(fragment)) session.segments.push_back(std::move(segment));
+    }, resolve, reject);
+}
+
+- (void)flushTtsText:(NSString *)instanceId
+           requestId:(NSString *)requestId
+             resolve:(RCTPromiseResolveBlock)resolve
+              reject:(RCTPromiseRejectBlock)reject
+{
+    UpdateTextSession(instanceId, requestId, [](TtsTextSessionState &session) {
+        for (auto &segment : session.segmenter.Flush()) session.segments.push_back(std::move(segment));
+    }, resolve, reject);
+}
+
+- (void)closeTtsText:(NSString *)instanceId
+           requestId:(NSString *)requestId
+             resolve:(RCTPromiseResolveBlock)resolve
+              reject:(RCTPromiseRejectBlock)reject
+{
+    UpdateTextSession(instanceId, requestId, [](TtsTextSessionState &session) {
+        for (auto &segment : session.segmenter.Flush()) session.segments.push_back(std::move(segment));
+        session.closed = true;
+    }, resolve, reject);
+}
+
+- (void)exportTtsBatch:(NSString *)instanceId
+             requestId:(NSString *)requestId
+                 items:(NSArray *)items
+               options:(NSDictionary *)options
+               resolve:(RCTPromiseResolveBlock)resolve
+                reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId == nil || [instanceId length] == 0) {
+        reject(@"TTS_EXPORT_ERROR", @"instanceId is required", nil);
+        return;
+    }
+    struct ExportItem {
+        std::string text;
+        std::string path;
+        std::string format;
+    };
+    auto jobs = std::make_shared<std::vector<ExportItem>>();
+    jobs->reserve([items count]);
+    for (NSUInteger i = 0; i < [items count]; i++) {
+        NSDictionary *item = [items[i] isKindOfClass:[NSDictionary class]] ? items[i] : nil;
+        NSString *itemText = [item[@"text"] isKindOfClass:[NSString class]] ? item[@"text"] : nil;
+        NSString *itemPath = [item[@"path"] isKindOfClass:[NSString class]] ? item[@"path"] : nil;
+        if (itemText == nil || [itemPath length] == 0) {
+            reject(@"TTS_EXPORT_ERROR", [NSString stringWithFormat:@"items[%lu] needs text and path", (unsigned long)i], nil);
+            return;
+        }
+        NSString *itemFormat = [item[@"format"] isKindOfClass:[NSString class]] ? item[@"format"] : @"";
+        jobs->push_back({[itemText UTF8String], [itemPath UTF8String], [itemFormat UTF8String]});
+    }
+    double sid = 0;
+    double speed = 1.0;
+    int32_t outputSampleRateHz = 0;
+    const float tempo = TtsTempoFromOptions(options);
+    if (options != nil) {
+        if (options[@"sid"] != nil) sid = [options[@"sid"] doubleValue];
+        if (options[@"speed"] != nil) speed = [options[@"speed"] doubleValue];
+        if (options[@"outputSampleRateHz"] != nil) outputSampleRateHz = [options[@"outputSampleRateHz"] intValue];
+    }
+    std::string instanceIdStr = [instanceId UTF8String];
+    std::shared_ptr<TtsInstanceState> instRef;
+    {
+        std::lock_guard<std::mutex> lock(g_tts_mutex);
+        auto it = g_tts_instances.find(instanceIdStr);
+        if (it == g_tts_instances.end() || it->second->wrapper == nullptr || !it->second->wrapper->isInitialized()) {
+            reject(@"TTS_NOT_INITIALIZED", @"TTS not initialized. Call initializeTts() first.", nil);
+            return;
+        }
+        instRef = it->second;
+        if (instRef->streamRunning.load()) {
+            reject(@"TTS_EXPORT_ERROR", @"TTS streaming already in progress", nil);
+            return;
+        }
+        instRef->streamCancelled.store(false);
+        instRef->streamRunning.store(true);
+        instRef->streamTicket.store(SubmitTtsRequest(instRef->wrapper.get(), options));
+    }
+    const uint64_t ticket = instRef->streamTicket.load();
+    NSString *instanceIdCopy = [instanceId copy];
+    NSString *requestIdCopy = [requestId copy] ?: @"";
+
+    __weak SherpaOnnx *weakSelf = self;
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        const int64_t startMs = PlaybackNowMs();
+        // Item N is encoded on the writer's thread while item N + 1 is synthesized here.
+        sherpaonnx::TtsExportWriter writer(MakeTtsExportEncoder(outputSampleRateHz), tempo);
+        NSMutableArray<NSMutableDictionary *> *written = [NSMutableArray arrayWithCapacity:jobs->size()];
+        NSInteger succeeded = 0;
+        auto report = [&](const std::vector<sherpaonnx::TtsExportResult> &results) {
+            for (const auto &r : results) {
+                if (r.error.empty()) succeeded++;
+                NSMutableDictionary *itemDict = TtsExportResultToDict(r);
+                [written addObject:itemDict];
+                NSMutableDictionary *payload = [itemDict mutableCopy];
+                payload[@"instanceId"] = instanceIdCopy;
+                payload[@"requestId"] = requestIdCopy;
+                payload[@"completed"] = @([written count]);
+                payload[@"total"] = @(jobs->size());
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    if (weakSelf) {
+                        [weakSelf sendEventWithName:@"ttsExportProgress" body:payload];
+                    }
+                });
+            }
+        };
+        for (size_t i = 0; i < jobs->size(); i++) {
+            if (instRef->streamCancelled.load() || instRef->wrapper->requestStopped(ticket)) break;
+            const ExportItem &item = (*jobs)[i];
+            sherpaonnx::TtsExportJob job;
+            job.index = i;
+            job.path = item.path;
+            job.format = item.format;
+            @try {
+                auto result = instRef->wrapper->generate(
+                    item.text, static_cast<int32_t>(sid), static_cast<float>(speed), ticket);
+                if (instRef->wrapper->requestStopped(ticket)) break;
+                job.samples = std::move(result.samples);
+                job.sampleRate = result.sampleRate;
+            } @catch (NSException *exception) {
+                sherpaonnx::TtsExportResult failed;
+                failed.index = i;
+                failed.path = item.path;
+                failed.error = std::string("Synthesis failed: ") + [exception.reason UTF8String];
+                report({failed});
+                continue;
+            }
+            if (job.sampleRate <= 0) {
+                // One failed paragraph should not end a long export; it is reported like a write error.
+                sherpaonnx::TtsExportResult failed;
+                failed.index = i;
+                failed.path = item.path;
+                failed.error = "Synthesis failed";
+                report({failed});
+                continue;
+            }
+            if (!writer.Submit(std::move(job))) break;
+            report(writer.TakeCompleted());
+        }
+        const bool cancelled = instRef->streamCancelled.load();
+        if (cancelled) writer.Cancel();
+        report(writer.Finish());
+        const bool expired = !cancelled && instRef->wrapper->requestStopped(ticket);
+        const int64_t queueWaitMs = instRef->wrapper->finishRequest(ticket);
+        instRef->streamTicket.store(0);
+
+        [written sortUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+            return [a[@"index"] compare:b[@"index"]];
+        }];
+        resolve(@{
+            @"items": written,
+            @"succeeded": @(succeeded),
+            @"failed": @((NSInteger)[written count] - succeeded),
+            @"total": @(jobs->size()),
+            @"cancelled": @(cancelled),
+            @"expired": @(expired),
+            @"elapsedMs": @(PlaybackNowMs() - startMs),
+            @"queueWaitMs": @(queueWaitMs),
+        });
+
+        instRef->streamRunning.store(false);
+        {
+            std::lock_guard<std::mutex> lock(g_tts_mutex);
+            g_tts_stream_cv.notify_all();
+        }
+    });
+}
+
 - (void)cancelTtsStream:(NSString *)instanceId
            resolve:(RCTPromiseResolveBlock)resolve
            reject:(RCTPromiseRejectBlock)reject
@@ -667,6 +1528,7 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
     auto it = g_tts_instances.find(instanceIdStr);
     if (it != g_tts_instances.end()) {
         it->second->streamCancelled.store(true);
+        if (it->second->wrapper) it->second->wrapper->cancelRequest(it->second->streamTicket.load());
     }
     resolve(nil);
 }
@@ -700,14 +1562,7 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
                     errorMsg = @"PCM playback supports mono only";
                     goto out_start;
                 }
-                if (inst->player != nil) [inst->player stop];
-                if (inst->engine != nil) {
-                    [inst->engine stop];
-                    [inst->engine reset];
-                }
-                inst->player = nil;
-                inst->engine = nil;
-                inst->format = nil;
+                StopPcmPlayer(inst);
             }
 
             session = [AVAudioSession sharedInstance];
@@ -722,18 +1577,39 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
                     goto out_start;
                 }
                 inst = it->second.get();
+                // Chunks go through a jitter buffer; the render callback pulls device-sized frames
+                // from it and gets silence while it prefills instead of a starved player.
+                sherpaonnx::PlaybackBufferConfig playbackConfig;
+                playbackConfig.sampleRate = static_cast<int32_t>(sampleRate);
+                playbackConfig.frameSamples = static_cast<int32_t>(session.IOBufferDuration * sampleRate);
+                auto playback = std::make_shared<sherpaonnx::TtsPlaybackBuffer>(playbackConfig);
+                auto reader = std::make_shared<sherpaonnx::StretchedFrameReader>(
+                    playbackConfig.sampleRate, playbackConfig.frameSamples);
+                reader->SetTempo(inst->playerTempo);
+                inst->playback = playback;
+                inst->playerReader = reader;
                 inst->engine = [[AVAudioEngine alloc] init];
-                inst->player = [[AVAudioPlayerNode alloc] init];
                 inst->format = [[AVAudioFormat alloc] initStandardFormatWithSampleRate:sampleRate channels:1];
+                inst->sourceNode = [[AVAudioSourceNode alloc] initWithFormat:inst->format
+                    renderBlock:^OSStatus(BOOL *isSilence, const AudioTimeStamp *timestamp,
+                                          AVAudioFrameCount frameCount, AudioBufferList *outputData) {
+                        float *out = static_cast<float *>(outputData->mBuffers[0].mData);
+                        int32_t got = 0;
+                        reader->Fill(out, static_cast<int32_t>(frameCount), [&](float *dst, int32_t count) {
+                            got += playback->Pull(dst, count, PlaybackNowMs());
+                        });
+                        // While stretching, the frame may hold the stretcher's tail even if nothing was pulled.
+                        *isSilence = got == 0 && reader->tempo() == 1.0f;
+                        return noErr;
+                    }];
 
-                [inst->engine attachNode:inst->player];
-                [inst->engine connect:inst->player to:inst->engine.mainMixerNode format:inst->format];
+                [inst->engine attachNode:inst->sourceNode];
+                [inst->engine connect:inst->sourceNode to:inst->engine.mainMixerNode format:inst->format];
 
                 if (![inst->engine startAndReturnError:&startError]) {
                     errorMsg = [NSString stringWithFormat:@"Failed to start audio engine: %@", startError.localizedDescription];
                     goto out_start;
                 }
-                [inst->player play];
             }
         out_start:
             if (errorMsg != nil) {
@@ -762,24 +1638,23 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
         return;
     }
     std::string instanceIdStr = [instanceId UTF8String];
-    std::lock_guard<std::mutex> lock(g_tts_mutex);
-    auto it = g_tts_instances.find(instanceIdStr);
-    if (it == g_tts_instances.end() || it->second->engine == nil || it->second->player == nil || it->second->format == nil) {
-        reject(@"TTS_PCM_ERROR", @"PCM player not initialized", nil);
-        return;
+    std::shared_ptr<sherpaonnx::TtsPlaybackBuffer> playback;
+    {
+        std::lock_guard<std::mutex> lock(g_tts_mutex);
+        auto it = g_tts_instances.find(instanceIdStr);
+        if (it == g_tts_instances.end() || it->second->engine == nil || !it->second->playback) {
+            reject(@"TTS_PCM_ERROR", @"PCM player not initialized", nil);
+            return;
+        }
+        playback = it->second->playback;
     }
-    TtsInstanceState *inst = it->second.get();
     @try {
-        AVAudioFrameCount frameCount = (AVAudioFrameCount)[samples count];
-        AVAudioPCMBuffer *buffer = [[AVAudioPCMBuffer alloc] initWithPCMFormat:inst->format frameCapacity:frameCount];
-        buffer.frameLength = frameCount;
-
-        float *channelData = buffer.floatChannelData[0];
+        std::vector<float> buffer([samples count]);
         for (NSUInteger i = 0; i < [samples count]; i++) {
-            channelData[i] = [samples[i] floatValue];
+            buffer[i] = [samples[i] floatValue];
         }
-
-        [inst->player scheduleBuffer:buffer completionHandler:nil];
+        // Blocks (without g_tts_mutex) only while the jitter buffer is full.
+        WritePlayback(*playback, buffer.data(), static_cast<int32_t>(buffer.size()), [] { return false; });
         resolve(nil);
     } @catch (NSException *exception) {
         NSString *errorMsg = [NSString stringWithFormat:@"Failed to write PCM chunk: %@", exception.reason];
@@ -787,6 +1662,62 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
     }
 }
 
+- (void)getTtsPlaybackStats:(NSString *)instanceId
+                    resolve:(RCTPromiseResolveBlock)resolve
+                     reject:(RCTPromiseRejectBlock)reject
+{
+    std::shared_ptr<sherpaonnx::TtsPlaybackBuffer> playback;
+    if (instanceId != nil) {
+        std::lock_guard<std::mutex> lock(g_tts_mutex);
+        auto it = g_tts_instances.find([instanceId UTF8String]);
+        if (it != g_tts_instances.end()) playback = it->second->playback;
+    }
+    if (!playback) {
+        resolve(nil);
+        return;
+    }
+    const sherpaonnx::PlaybackBufferStats stats = playback->GetStats();
+    const double msPerSample = 1000.0 / playback->config().sampleRate;
+    resolve(@{
+        @"samplesIn": @(stats.samplesIn),
+        @"samplesOut": @(stats.samplesOut),
+        @"framesOut": @(stats.framesOut),
+        @"silentFrames": @(stats.silentFrames),
+        @"underruns": @(stats.underruns),
+        @"overruns": @(stats.overruns),
+        @"bufferedMs": @(stats.fillSamples * msPerSample),
+        @"targetMs": @(stats.targetSamples * msPerSample),
+        @"maxBufferedMs": @(stats.maxFillSamples * msPerSample),
+        @"playing": @(stats.playing),
+        @"frameSamples": @(playback->config().frameSamples),
+    });
+}
+
+- (void)setTtsPcmPlayerTempo:(NSString *)instanceId
+                        tempo:(double)tempo
+                      resolve:(RCTPromiseResolveBlock)resolve
+                       reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId == nil || [instanceId length] == 0) {
+        reject(@"TTS_PCM_ERROR", @"instanceId is required", nil);
+        return;
+    }
+    if (!(tempo > 0.0)) {
+        reject(@"TTS_PCM_ERROR", @"tempo must be > 0", nil);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_tts_mutex);
+    auto it = g_tts_instances.find([instanceId UTF8String]);
+    if (it == g_tts_instances.end()) {
+        reject(@"TTS_PCM_ERROR", @"TTS instance not found", nil);
+        return;
+    }
+    // Applies from the next render callback, also to audio already in the jitter buffer.
+    it->second->playerTempo = static_cast<float>(tempo);
+    if (it->second->playerReader) it->second->playerReader->SetTempo(it->second->playerTempo);
+    resolve(nil);
+}
+
 - (void)stopTtsPcmPlayer:(NSString *)instanceId
             resolve:(RCTPromiseResolveBlock)resolve
             reject:(RCTPromiseRejectBlock)reject
@@ -801,17 +1732,7 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
             std::lock_guard<std::mutex> lock(g_tts_mutex);
             auto it = g_tts_instances.find(instanceIdStr);
             if (it != g_tts_instances.end()) {
-                TtsInstanceState *inst = it->second.get();
-                if (inst->player != nil) {
-                    [inst->player stop];
-                }
-                if (inst->engine != nil) {
-                    [inst->engine stop];
-                    [inst->engine reset];
-                }
-                inst->player = nil;
-                inst->engine = nil;
-                inst->format = nil;
+                StopPcmPlayer(it->second.get());
             }
             resolve(nil);
         } @catch (NSException *exception) {
@@ -859,6 +1780,148 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
     resolve(@(numSpeakers));
 }
 
+- (void)configureTtsAudioCache:(NSString *)instanceId
+                maxMemoryBytes:(double)maxMemoryBytes
+                       diskDir:(NSString *)diskDir
+                  maxDiskBytes:(double)maxDiskBytes
+                       resolve:(RCTPromiseResolveBlock)resolve
+                        reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId == nil || [instanceId length] == 0) {
+        reject(@"TTS_CACHE_ERROR", @"instanceId is required", nil);
+        return;
+    }
+    std::string instanceIdStr = [instanceId UTF8String];
+    std::string diskDirStr = diskDir != nil ? std::string([diskDir UTF8String]) : std::string();
+    std::lock_guard<std::mutex> lock(g_tts_mutex);
+    auto it = g_tts_instances.find(instanceIdStr);
+    if (it == g_tts_instances.end() || it->second->wrapper == nullptr) {
+        reject(@"TTS_CACHE_ERROR", [NSString stringWithFormat:@"TTS instance not found: %@", instanceId], nil);
+        return;
+    }
+    it->second->wrapper->configureAudioCache(
+        maxMemoryBytes > 0 ? static_cast<size_t>(maxMemoryBytes) : 0,
+        diskDirStr,
+        maxDiskBytes > 0 ? static_cast<size_t>(maxDiskBytes) : 0);
+    resolve(nil);
+}
+
+- (void)getTtsAudioCacheStats:(NSString *)instanceId
+                      resolve:(RCTPromiseResolveBlock)resolve
+                       reject:(RCTPromiseRejectBlock)reject
+{
+    sherpaonnx::TtsAudioCache::Stats stats;
+    if (instanceId != nil && [instanceId length] > 0) {
+        std::string instanceIdStr = [instanceId UTF8String];
+        std::lock_guard<std::mutex> lock(g_tts_mutex);
+        auto it = g_tts_instances.find(instanceIdStr);
+        if (it != g_tts_instances.end() && it->second->wrapper != nullptr) {
+            stats = it->second->wrapper->getAudioCacheStats();
+        }
+    }
+    resolve(@{
+        @"memoryHits": @(stats.memoryHits),
+        @"diskHits": @(stats.diskHits),
+        @"misses": @(stats.misses),
+        @"insertions": @(stats.insertions),
+        @"evictions": @(stats.evictions),
+        @"memoryBytes": @(stats.memoryBytes),
+        @"memoryEntries": @(stats.memoryEntries),
+        @"diskBytes": @(stats.diskBytes),
+    });
+}
+
+- (void)getTtsStats:(NSString *)instanceId
+           resolve:(RCTPromiseResolveBlock)resolve
+            reject:(RCTPromiseRejectBlock)reject
+{
+    sherpaonnx::TtsStatsSnapshot stats;
+    if (instanceId != nil && [instanceId length] > 0) {
+        std::string instanceIdStr = [instanceId UTF8String];
+        std::lock_guard<std::mutex> lock(g_tts_mutex);
+        auto it = g_tts_instances.find(instanceIdStr);
+        if (it != g_tts_instances.end() && it->second->wrapper != nullptr) {
+            stats = it->second->wrapper->getStats();
+        }
+    }
+    resolve(@{
+        @"requests": @(stats.requests),
+        @"totalAudioMs": @(stats.totalAudioMs),
+        @"totalSynthesisMs": @(stats.totalSynthesisMs),
+        @"bytesCopied": @(stats.bytesCopied),
+        @"timeToFirstChunkMs": StatsHistogramToDict(stats.timeToFirstChunkMs),
+        @"synthesisMs": StatsHistogramToDict(stats.synthesisMs),
+        @"realTimeFactor": StatsHistogramToDict(stats.realTimeFactor),
+        @"chunkSamples": StatsHistogramToDict(stats.chunkSamples),
+    });
+}
+
+- (void)resetTtsStats:(NSString *)instanceId
+             resolve:(RCTPromiseResolveBlock)resolve
+              reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId != nil && [instanceId length] > 0) {
+        std::string instanceIdStr = [instanceId UTF8String];
+        std::lock_guard<std::mutex> lock(g_tts_mutex);
+        auto it = g_tts_instances.find(instanceIdStr);
+        if (it != g_tts_instances.end() && it->second->wrapper != nullptr) {
+            it->second->wrapper->resetStats();
+        }
+    }
+    resolve(nil);
+}
+
+- (void)clearTtsAudioCache:(NSString *)instanceId
+               includeDisk:(BOOL)includeDisk
+                   resolve:(RCTPromiseResolveBlock)resolve
+                    reject:(RCTPromiseRejectBlock)reject
+{
+    if (instanceId != nil && [instanceId length] > 0) {
+        std::string instanceIdStr = [instanceId UTF8String];
+        std::lock_guard<std::mutex> lock(g_tts_mutex);
+        auto it = g_tts_instances.find(instanceIdStr);
+        if (it != g_tts_instances.end() && it->second->wrapper != nullptr) {
+            it->second->wrapper->clearAudioCache(includeDisk);
+        }
+    }
+    resolve(nil);
+}
+
+- (void)registerTtsPrompt:(NSString *)instanceId
+                  samples:(NSArray<NSNumber *> *)samples
+               sampleRate:(double)sampleRate
+               promptText:(NSString *)promptText
+                  resolve:(RCTPromiseResolveBlock)resolve
+                   reject:(RCTPromiseRejectBlock)reject
+{
+    // The iOS wrapper does not implement reference-audio (voice cloning) generation.
+    reject(@"TTS_PROMPT_ERROR", @"Voice prompts are not supported on iOS", nil);
+}
+
+- (void)unregisterTtsPrompt:(NSString *)instanceId
+                   promptId:(double)promptId
+                    resolve:(RCTPromiseResolveBlock)resolve
+                     reject:(RCTPromiseRejectBlock)reject
+{
+    resolve(@NO);
+}
+
+- (void)calibrateTtsSteps:(NSString *)instanceId
+                  options:(NSDictionary *)options
+                  resolve:(RCTPromiseResolveBlock)resolve
+                   reject:(RCTPromiseRejectBlock)reject
+{
+    // Step planning applies to Zipvoice voice cloning, which the iOS wrapper does not implement.
+    reject(@"TTS_CALIBRATE_ERROR", @"Step calibration is not supported on iOS", nil);
+}
+
+- (void)getTtsStepCalibration:(NSString *)instanceId
+                      resolve:(RCTPromiseResolveBlock)resolve
+                       reject:(RCTPromiseRejectBlock)reject
+{
+    resolve(nil);
+}
+
 - (void)unloadTts:(NSString *)instanceId
      resolve:(RCTPromiseResolveBlock)resolve
      reject:(RCTPromiseRejectBlock)reject
@@ -882,15 +1945,9 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
                     return;
                 }
                 inst = it->second.get();
-                if (inst->player != nil) [inst->player stop];
-                if (inst->engine != nil) {
-                    [inst->engine stop];
-                    [inst->engine reset];
-                }
-                inst->player = nil;
-                inst->engine = nil;
-                inst->format = nil;
+                StopPcmPlayer(inst);
                 inst->streamCancelled.store(true);
+                if (inst->wrapper) inst->wrapper->cancelRequest(inst->streamTicket.load());
             }
             dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
                 {
@@ -909,10 +1966,8 @@ std::vector<std::string> SplitTtsTokens(const std::string &text) {
                     if (!done) {
                         RCTLogWarn(@"TTS unload: stream did not stop within 5s, releasing anyway");
                     }
-                    if (i->wrapper != nullptr) {
-                        i->wrapper->release();
-                        i->wrapper.reset();
-                    }
+                    // A one-shot request still running keeps the wrapper; the last reference releases it.
+                    i->wrapper.reset();
                     i->modelDir = nil;
                     i->modelType = nil;
                     i->provider = nil;
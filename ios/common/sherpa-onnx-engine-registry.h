@@ -0,0 +1,141 @@
+/**
+ * sherpa-onnx-engine-registry.h
+ *
+ * Declares SharedEngineRegistry: process-wide sharing of loaded engines (OfflineTts,
+ * OfflineRecognizer) across instance ids. Wrappers that load the same model with the same
+ * load-affecting config receive the same engine instead of each holding a copy of the weights;
+ * the engine is destroyed when the last holder drops its handle. Header-only; used by the iOS
+ * TTS and STT wrappers.
+ */
+#ifndef SHERPA_ONNX_ENGINE_REGISTRY_H
+#define SHERPA_ONNX_ENGINE_REGISTRY_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "sherpa-onnx-engine-scheduler.h"
+
+namespace sherpaonnx {
+
+template <typename Engine>
+class SharedEngineRegistry {
+ public:
+  /**
+   * A shared engine. Holders take turns through scheduler (priority order, one chunk of work per
+   * slot) and hold mutex for every call into engine: holders may be on different threads.
+   */
+  struct Entry {
+    explicit Entry(Engine e) : engine(std::move(e)) {}
+
+    Engine engine;
+    EngineScheduler scheduler;
+    std::mutex mutex;
+    /**
+     * Process-unique id of the per-holder settings last applied to engine (e.g. recognizer decoding
+     * config); 0 = the settings it was created with. Guarded by mutex.
+     */
+    uint64_t appliedSettings = 0;
+  };
+
+  using Handle = std::shared_ptr<Entry>;
+
+  /** New process-unique id for per-holder settings (see Entry::appliedSettings). */
+  static uint64_t NextSettingsId() {
+    static std::atomic<uint64_t> next{0};
+    return ++next;
+  }
+
+  /** Registry shared by all wrappers of this engine type. */
+  static SharedEngineRegistry& Global() {
+    static SharedEngineRegistry registry;
+    return registry;
+  }
+
+  /**
+   * Return the live engine for key, or create one with create() (returning std::optional<Engine>;
+   * nullopt = failure, nothing is registered). create() runs without the registry lock, so loads
+   * of other keys proceed in parallel; callers racing on the same key wait for the first load and
+   * share its engine (or load again if it failed). reused (optional) tells whether an existing
+   * engine was returned.
+   */
+  template <typename Factory>
+  Handle Acquire(const std::string& key, Factory&& create, bool* reused = nullptr) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      for (;;) {
+        Prune();
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+          if (Handle live = it->second.lock()) {
+            if (reused) *reused = true;
+            return live;
+          }
+        }
+        if (loading_.insert(key).second) break;
+        loaded_.wait(lock, [&] { return loading_.count(key) == 0; });
+      }
+    }
+    if (reused) *reused = false;
+    Handle handle;
+    try {
+      std::optional<Engine> engine = create();
+      if (engine.has_value()) handle = std::make_shared<Entry>(std::move(*engine));
+    } catch (...) {
+      FinishLoad(key, nullptr);
+      throw;
+    }
+    FinishLoad(key, handle);
+    return handle;
+  }
+
+  /** Number of holders of key's engine (0 when none is loaded). */
+  long UseCount(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    return it == entries_.end() ? 0 : it->second.use_count();
+  }
+
+  /** Number of engines currently loaded. */
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t n = 0;
+    for (const auto& kv : entries_) n += kv.second.expired() ? 0 : 1;
+    return n;
+  }
+
+ private:
+  // Publish the result of this caller's load of key (null = failed) and wake callers waiting on it.
+  void FinishLoad(const std::string& key, const Handle& handle) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      loading_.erase(key);
+      if (handle) entries_[key] = handle;
+    }
+    loaded_.notify_all();
+  }
+
+  void Prune() {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      it = it->second.expired() ? entries_.erase(it) : std::next(it);
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::weak_ptr<Entry>> entries_;
+  // Keys being loaded by some caller; loaded_ is notified when one finishes.
+  std::unordered_set<std::string> loading_;
+  std::condition_variable loaded_;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_ENGINE_REGISTRY_H
@@ -0,0 +1,138 @@
+/**
+ * sherpa-onnx-engine-scheduler.h
+ *
+ * Declares EngineScheduler: the request queue in front of one loaded engine (TTS or STT). Requests
+ * are granted the engine by priority, then earliest deadline, then arrival; long requests give it
+ * back between chunks so an interactive request can run in between. Shared by the Android JNI and
+ * the iOS wrappers (mirrored in ios/common).
+ */
+#ifndef SHERPA_ONNX_ENGINE_SCHEDULER_H
+#define SHERPA_ONNX_ENGINE_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace sherpaonnx {
+
+/** Request priorities (higher runs first). Values are shared with the JS options. */
+enum RequestPriority : int32_t {
+  kRequestPriorityBatch = 0,
+  kRequestPriorityNormal = 1,
+  kRequestPriorityInteractive = 2,
+};
+
+/** Parse "interactive" / "normal" / "batch"; anything else is normal. */
+int32_t ParseRequestPriority(const char* name);
+
+class EngineScheduler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Status : int32_t { kOk = 0, kCancelled = 1, kExpired = 2, kUnknown = 3 };
+
+  EngineScheduler() = default;
+  EngineScheduler(const EngineScheduler&) = delete;
+  EngineScheduler& operator=(const EngineScheduler&) = delete;
+
+  /**
+   * Register a request. deadlineMs > 0 is relative to now; a request still waiting at its deadline
+   * fails with kExpired, and ShouldStop() turns true once it passes. Returns the request id (> 0).
+   */
+  uint64_t Submit(int32_t priority, int64_t deadlineMs = 0);
+
+  /**
+   * Block until the request may use the engine (no other holder and it is the best waiting
+   * request). Call Release() after each chunk of work and Acquire() again for the next one.
+   */
+  Status Acquire(uint64_t id);
+
+  /** Give the engine back; the request keeps its place for its next Acquire(). */
+  void Release(uint64_t id);
+
+  /** Release (if held) and forget the request. Returns its total queue wait in ms. */
+  int64_t Finish(uint64_t id);
+
+  /** Mark a request cancelled and wake it if it is waiting. Returns false for an unknown id. */
+  bool Cancel(uint64_t id);
+
+  /** Cancel every registered request (engine unload). */
+  void CancelAll();
+
+  /** True when the request was cancelled or its deadline passed: stop generating. */
+  bool ShouldStop(uint64_t id) const;
+
+  /** True when a waiting request would be granted before this one: yield at the next boundary. */
+  bool ShouldYield(uint64_t id) const;
+
+  /** Priority the request was submitted with (normal for an unknown id). */
+  int32_t PriorityOf(uint64_t id) const;
+
+  /** Time the request has spent waiting for the engine so far, in ms. */
+  int64_t QueueWaitMs(uint64_t id) const;
+
+  /** Requests currently waiting for the engine. */
+  size_t Waiting() const;
+
+ private:
+  struct Request {
+    int32_t priority = kRequestPriorityNormal;
+    Clock::time_point deadline = Clock::time_point::max();
+    bool cancelled = false;
+    bool waiting = false;
+    Clock::duration waited{};
+  };
+
+  // True when a orders before b (both must be registered).
+  static bool Before(uint64_t a, const Request& ra, uint64_t b, const Request& rb);
+  bool IsNextLocked(uint64_t id, const Request& r) const;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::unordered_map<uint64_t, Request> requests_;
+  uint64_t holder_ = 0;
+  uint64_t nextId_ = 0;
+};
+
+/** Submits a request on construction and finishes it on destruction. */
+class ScopedEngineRequest {
+ public:
+  ScopedEngineRequest(EngineScheduler& scheduler, int32_t priority, int64_t deadlineMs = 0)
+      : scheduler_(scheduler), id_(scheduler.Submit(priority, deadlineMs)) {}
+  ~ScopedEngineRequest() { scheduler_.Finish(id_); }
+  ScopedEngineRequest(const ScopedEngineRequest&) = delete;
+  ScopedEngineRequest& operator=(const ScopedEngineRequest&) = delete;
+
+  uint64_t id() const { return id_; }
+
+ private:
+  EngineScheduler& scheduler_;
+  uint64_t id_;
+};
+
+/** Holds the engine for one chunk of work; releases it on destruction. */
+class ScopedEngineSlot {
+ public:
+  ScopedEngineSlot(EngineScheduler& scheduler, uint64_t id)
+      : scheduler_(scheduler), id_(id), status_(scheduler.Acquire(id)) {}
+  ~ScopedEngineSlot() {
+    if (status_ == EngineScheduler::Status::kOk) scheduler_.Release(id_);
+  }
+  ScopedEngineSlot(const ScopedEngineSlot&) = delete;
+  ScopedEngineSlot& operator=(const ScopedEngineSlot&) = delete;
+
+  bool ok() const { return status_ == EngineScheduler::Status::kOk; }
+  EngineScheduler::Status status() const { return status_; }
+
+ private:
+  EngineScheduler& scheduler_;
+  uint64_t id_;
+  EngineScheduler::Status status_;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_ENGINE_SCHEDULER_H
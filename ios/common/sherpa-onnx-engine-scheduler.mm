@@ -0,0 +1,155 @@
+/**
+ * sherpa-onnx-engine-scheduler.mm
+ *
+ * Purpose: Per-engine request scheduling. One holder at a time; among waiting requests the engine
+ * goes to the highest priority, then the earliest deadline, then the oldest request. Waiters sleep
+ * on a condition variable (until their deadline, if any) and are woken on release and cancel.
+ * Mirror of android/src/main/cpp/jni/common/sherpa-onnx-engine-scheduler.cpp; keep in sync.
+ */
+#include "sherpa-onnx-engine-scheduler.h"
+
+#include <cstring>
+
+namespace sherpaonnx {
+
+int32_t ParseRequestPriority(const char* name) {
+  if (name == nullptr) return kRequestPriorityNormal;
+  if (std::strcmp(name, "interactive") == 0) return kRequestPriorityInteractive;
+  if (std::strcmp(name, "batch") == 0) return kRequestPriorityBatch;
+  return kRequestPriorityNormal;
+}
+
+bool EngineScheduler::Before(uint64_t a, const Request& ra, uint64_t b, const Request& rb) {
+  if (ra.priority != rb.priority) return ra.priority > rb.priority;
+  if (ra.deadline != rb.deadline) return ra.deadline < rb.deadline;
+  return a < b;
+}
+
+bool EngineScheduler::IsNextLocked(uint64_t id, const Request& r) const {
+  for (const auto& kv : requests_) {
+    if (kv.first == id || !kv.second.waiting || kv.second.cancelled) continue;
+    if (Before(kv.first, kv.second, id, r)) return false;
+  }
+  return true;
+}
+
+uint64_t EngineScheduler::Submit(int32_t priority, int64_t deadlineMs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint64_t id = ++nextId_;
+  Request& r = requests_[id];
+  r.priority = priority;
+  if (deadlineMs > 0) r.deadline = Clock::now() + std::chrono::milliseconds(deadlineMs);
+  return id;
+}
+
+EngineScheduler::Status EngineScheduler::Acquire(uint64_t id) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto it = requests_.find(id);
+  if (it == requests_.end()) return Status::kUnknown;
+  if (holder_ == id) return Status::kOk;
+
+  const auto start = Clock::now();
+  it->second.waiting = true;
+  Status status = Status::kOk;
+  for (;;) {
+    // Re-find: the map may rehash while unlocked.
+    it = requests_.find(id);
+    if (it == requests_.end()) return Status::kUnknown;
+    Request& r = it->second;
+    if (r.cancelled) {
+      status = Status::kCancelled;
+      break;
+    }
+    if (Clock::now() >= r.deadline) {
+      status = Status::kExpired;
+      break;
+    }
+    if (holder_ == 0 && IsNextLocked(id, r)) {
+      holder_ = id;
+      break;
+    }
+    if (r.deadline == Clock::time_point::max()) {
+      cv_.wait(lock);
+    } else {
+      cv_.wait_until(lock, r.deadline);
+    }
+  }
+  it->second.waiting = false;
+  it->second.waited += Clock::now() - start;
+  // A request that gave up may have been blocking the next one in line.
+  if (status != Status::kOk) cv_.notify_all();
+  return status;
+}
+
+void EngineScheduler::Release(uint64_t id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (holder_ != id) return;
+  holder_ = 0;
+  cv_.notify_all();
+}
+
+int64_t EngineScheduler::Finish(uint64_t id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = requests_.find(id);
+  if (it == requests_.end()) return 0;
+  const int64_t waitedMs = std::chrono::duration_cast<std::chrono::milliseconds>(it->second.waited).count();
+  requests_.erase(it);
+  if (holder_ == id) holder_ = 0;
+  cv_.notify_all();
+  return waitedMs;
+}
+
+bool EngineScheduler::Cancel(uint64_t id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = requests_.find(id);
+  if (it == requests_.end()) return false;
+  it->second.cancelled = true;
+  cv_.notify_all();
+  return true;
+}
+
+void EngineScheduler::CancelAll() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& kv : requests_) kv.second.cancelled = true;
+  cv_.notify_all();
+}
+
+bool EngineScheduler::ShouldStop(uint64_t id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = requests_.find(id);
+  if (it == requests_.end()) return false;
+  return it->second.cancelled || Clock::now() >= it->second.deadline;
+}
+
+bool EngineScheduler::ShouldYield(uint64_t id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = requests_.find(id);
+  if (it == requests_.end()) return false;
+  for (const auto& kv : requests_) {
+    if (kv.first == id || !kv.second.waiting || kv.second.cancelled) continue;
+    if (Before(kv.first, kv.second, id, it->second)) return true;
+  }
+  return false;
+}
+
+int32_t EngineScheduler::PriorityOf(uint64_t id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = requests_.find(id);
+  return it == requests_.end() ? kRequestPriorityNormal : it->second.priority;
+}
+
+int64_t EngineScheduler::QueueWaitMs(uint64_t id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = requests_.find(id);
+  if (it == requests_.end()) return 0;
+  return std::chrono::duration_cast<std::chrono::milliseconds>(it->second.waited).count();
+}
+
+size_t EngineScheduler::Waiting() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t n = 0;
+  for (const auto& kv : requests_) n += kv.second.waiting ? 1 : 0;
+  return n;
+}
+
+}  // namespace sherpaonnx
@@ -9,6 +9,8 @@
 #ifndef SHERPA_ONNX_ONLINE_STT_WRAPPER_H
 #define SHERPA_ONNX_ONLINE_STT_WRAPPER_H
 
+#include "sherpa-onnx-common.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -67,7 +69,8 @@ public:
     void inputFinished(const std::string& streamId);
     void decode(const std::string& streamId);
     bool isReady(const std::string& streamId);
-    OnlineSttStreamResult getResult(const std::string& streamId);
+    /** resultFields: SttResultField mask; only tokens / timestamps apply to streaming results. */
+    OnlineSttStreamResult getResult(const std::string& streamId, uint32_t resultFields = kSttResultAllFields);
     bool isEndpoint(const std::string& streamId);
     void resetStream(const std::string& streamId);
     void releaseStream(const std::string& streamId);
@@ -7,6 +7,7 @@
 
 #include "sherpa-onnx-online-stt-wrapper.h"
 #include "sherpa-onnx-model-detect-helper.h"
+#include "sherpa-onnx-hotwords-compiler.h"
 
 #include "sherpa-onnx/c-api/cxx-api.h"
 
@@ -77,11 +78,22 @@ std::unordered_map<std::string, std::string> scanOnlineModelPaths(const std::str
     return {};
 }
 
+/** Compiled hotwords files live under Library/Caches/sherpaonnx_hotwords (shared with offline STT). */
+std::string HotwordsCacheDir() {
+    @autoreleasepool {
+        NSArray *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
+        NSString *cacheDir = caches.firstObject ?: NSTemporaryDirectory();
+        return [[cacheDir stringByAppendingPathComponent:@"sherpaonnx_hotwords"] UTF8String];
+    }
+}
+
 } // namespace
 
 struct OnlineSttWrapper::Impl {
     std::unique_ptr<sherpa_onnx::cxx::OnlineRecognizer> recognizer;
     std::unordered_map<std::string, sherpa_onnx::cxx::OnlineStream> streams;
+    /** tokens.txt of the loaded model, for compiling per-stream hotwords. */
+    std::string tokensPath;
     bool initialized = false;
 };
 
@@ -145,6 +157,18 @@ OnlineSttInitResult OnlineSttWrapper::initialize(
     config.rule2_min_trailing_silence = rule2MinTrailingSilence > 0 ? rule2MinTrailingSilence : 1.4f;
     config.rule3_min_utterance_length = rule3MinUtteranceLength > 0 ? rule3MinUtteranceLength : 20.f;
     config.hotwords_file = hotwordsFile;
+    if (!hotwordsFile.empty()) {
+        // Compiled (validated, vocabulary-checked, cached) form; the file as given if that fails.
+        HotwordsCompileOptions hotwordsOptions;
+        hotwordsOptions.tokensPath = paths.count("tokens") ? paths["tokens"] : "";
+        hotwordsOptions.cacheDir = HotwordsCacheDir();
+        const HotwordsCompileResult compiled = CompileHotwordsFile(hotwordsFile, hotwordsOptions);
+        if (compiled.ok) {
+            config.hotwords_file = compiled.compiledPath;
+        } else {
+            LOGE("Online hotwords not compiled, using the file as is: %s", compiled.error.c_str());
+        }
+    }
     config.hotwords_score = hotwordsScore;
     config.rule_fsts = ruleFsts;
     config.rule_fars = ruleFars;
@@ -180,6 +204,7 @@ OnlineSttInitResult OnlineSttWrapper::initialize(
     try {
         sherpa_onnx::cxx::OnlineRecognizer rec = sherpa_onnx::cxx::OnlineRecognizer::Create(config);
         pImpl->recognizer = std::make_unique<sherpa_onnx::cxx::OnlineRecognizer>(std::move(rec));
+        pImpl->tokensPath = config.model_config.tokens;
         pImpl->initialized = true;
         result.success = true;
     } catch (const std::exception& e) {
@@ -195,10 +220,22 @@ OnlineSttInitResult OnlineSttWrapper::initialize(
 bool OnlineSttWrapper::createStream(const std::string& streamId, const std::string& hotwords) {
     if (!pImpl->initialized || !pImpl->recognizer) return false;
     if (pImpl->streams.count(streamId)) return false;
+    // Lines the model cannot encode are dropped instead of failing the whole string (cached in memory).
+    std::string streamHotwords = hotwords;
+    if (!hotwords.empty()) {
+        HotwordsCompileOptions hotwordsOptions;
+        hotwordsOptions.tokensPath = pImpl->tokensPath;
+        const HotwordsCompileResult compiled = CompileHotwordsText(hotwords, hotwordsOptions);
+        if (compiled.ok) {
+            streamHotwords = compiled.text;
+        } else {
+            LOGE("Stream hotwords not compiled, using them as is: %s", compiled.error.c_str());
+        }
+    }
     try {
-        sherpa_onnx::cxx::OnlineStream stream = hotwords.empty()
+        sherpa_onnx::cxx::OnlineStream stream = streamHotwords.empty()
             ? pImpl->recognizer->CreateStream()
-            : pImpl->recognizer->CreateStream(hotwords);
+            : pImpl->recognizer->CreateStream(streamHotwords);
         pImpl->streams.emplace(streamId, std::move(stream));
         return true;
     } catch (...) {
@@ -230,14 +267,14 @@ bool OnlineSttWrapper::isReady(const std::string& streamId) {
     return pImpl->recognizer->IsReady(&it->second);
 }
 
-OnlineSttStreamResult OnlineSttWrapper::getResult(const std::string& streamId) {
+OnlineSttStreamResult OnlineSttWrapper::getResult(const std::string& streamId, uint32_t resultFields) {
     OnlineSttStreamResult r;
     auto it = pImpl->streams.find(streamId);
     if (it == pImpl->streams.end() || !pImpl->recognizer) return r;
     sherpa_onnx::cxx::OnlineRecognizerResult res = pImpl->recognizer->GetResult(&it->second);
-    r.text = res.text;
-    r.tokens = res.tokens;
-    r.timestamps = res.timestamps;
+    r.text = std::move(res.text);
+    if (resultFields & kSttResultTokens) r.tokens = std::move(res.tokens);
+    if (resultFields & kSttResultTimestamps) r.timestamps = std::move(res.timestamps);
     return r;
 }
 
@@ -0,0 +1,645 @@
+/**
+ * sherpa-onnx-hotwords-compiler.mm
+ *
+ * Purpose: Validation, vocabulary check, de-duplication and content-keyed caching of hotwords
+ * (hotwordsFile on init / setConfig, per-stream hotwords on createStream).
+ * Mirror of android/src/main/cpp/jni/stt/sherpa-onnx-hotwords-compiler.cpp; keep in sync.
+ */
+#include "sherpa-onnx-hotwords-compiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace sherpaonnx {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kMetaTag = "hwc1";
+constexpr size_t kMaxOovSamples = 5;
+constexpr size_t kMaxCachedTexts = 64;
+/** Compiled files kept in cacheDir; the least recently used beyond this are removed. */
+constexpr size_t kMaxCachedFiles = 32;
+/** Temp files of an interrupted write older than this are removed when pruning. */
+constexpr auto kStaleTempAge = std::chrono::minutes(10);
+/** sentencepiece word-boundary marker (U+2581). */
+constexpr const char* kWordBoundary = "\xe2\x96\x81";
+
+uint64_t Fnv1a(const char* data, size_t n, uint64_t h = 1469598103934665603ULL) {
+  for (size_t i = 0; i < n; ++i) {
+    h ^= static_cast<unsigned char>(data[i]);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+uint64_t Fnv1a(const std::string& s) { return Fnv1a(s.data(), s.size()); }
+
+std::string Hex(uint64_t v) {
+  char buf[17];
+  std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(v));
+  return buf;
+}
+
+bool ReadFile(const std::string& path, std::string* out) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return false;
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  if (in.bad()) return false;
+  *out = ss.str();
+  return true;
+}
+
+bool WriteFileAtomically(const fs::path& path, const std::string& content) {
+  static std::atomic<uint64_t> counter{0};
+  fs::path tmp = path;
+  tmp += ".tmp" + std::to_string(counter.fetch_add(1)) + "-" +
+         std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    out.close();
+    if (!out) {
+      std::error_code ec;
+      fs::remove(tmp, ec);
+      return false;
+    }
+  }
+  std::error_code ec;
+  fs::rename(tmp, path, ec);
+  if (ec) fs::remove(tmp, ec);
+  return !ec;
+}
+
+/** Identity of a file's current version (size + mtime), for memoizing work on its content. */
+bool FileStamp(const std::string& path, std::string* stamp) {
+  std::error_code ec;
+  const auto size = fs::file_size(path, ec);
+  if (ec) return false;
+  const auto mtime = fs::last_write_time(path, ec);
+  if (ec) return false;
+  *stamp = path + "|" + std::to_string(size) + "|" + std::to_string(mtime.time_since_epoch().count());
+  return true;
+}
+
+/** Content hash of tokens.txt / bpe.vocab, memoized per version; 0 for no / unreadable file. */
+uint64_t ModelFileHash(const std::string& path) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, uint64_t> memo;
+  std::string stamp;
+  if (path.empty() || !FileStamp(path, &stamp)) return 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = memo.find(stamp);
+    if (it != memo.end()) return it->second;
+  }
+  std::string content;
+  if (!ReadFile(path, &content)) return 0;
+  const uint64_t h = Fnv1a(content);
+  std::lock_guard<std::mutex> lock(mutex);
+  memo[stamp] = h;
+  return h;
+}
+
+struct Vocabulary {
+  std::unordered_set<std::string> tokens;
+  size_t maxTokenBytes = 0;
+  /** sentencepiece byte pieces (<0x41>) exist, so any text can be encoded. */
+  bool byteFallback = false;
+};
+
+/** Symbols of tokens.txt ("symbol id" per line); the last loaded one is kept in memory. */
+std::shared_ptr<const Vocabulary> LoadVocabulary(const std::string& tokensPath) {
+  static std::mutex mutex;
+  static std::string lastStamp;
+  static std::shared_ptr<const Vocabulary> last;
+  std::string stamp;
+  if (tokensPath.empty() || !FileStamp(tokensPath, &stamp)) return nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (last && lastStamp == stamp) return last;
+  }
+  std::ifstream in(tokensPath, std::ios::binary);
+  if (!in) return nullptr;
+  auto vocab = std::make_shared<Vocabulary>();
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream fields(line);
+    std::string symbol;
+    std::string id;
+    if (!(fields >> symbol >> id)) continue;
+    if (symbol.size() == 6 && symbol.compare(0, 3, "<0x") == 0 && symbol.back() == '>') vocab->byteFallback = true;
+    vocab->maxTokenBytes = std::max(vocab->maxTokenBytes, symbol.size());
+    vocab->tokens.insert(std::move(symbol));
+  }
+  if (vocab->tokens.empty()) return nullptr;
+  std::lock_guard<std::mutex> lock(mutex);
+  lastStamp = stamp;
+  last = vocab;
+  return last;
+}
+
+/** Decode the code point at *i and advance; false on invalid UTF-8. */
+bool NextCodePoint(const std::string& s, size_t* i, uint32_t* cp) {
+  const auto b0 = static_cast<unsigned char>(s[*i]);
+  size_t len = 0;
+  if (b0 < 0x80) {
+    *cp = b0;
+    len = 1;
+  } else if ((b0 & 0xE0) == 0xC0) {
+    *cp = b0 & 0x1F;
+    len = 2;
+  } else if ((b0 & 0xF0) == 0xE0) {
+    *cp = b0 & 0x0F;
+    len = 3;
+  } else if ((b0 & 0xF8) == 0xF0) {
+    *cp = b0 & 0x07;
+    len = 4;
+  } else {
+    return false;
+  }
+  if (*i + len > s.size()) return false;
+  for (size_t k = 1; k < len; ++k) {
+    const auto b = static_cast<unsigned char>(s[*i + k]);
+    if ((b & 0xC0) != 0x80) return false;
+    *cp = (*cp << 6) | (b & 0x3F);
+  }
+  *i += len;
+  return true;
+}
+
+bool IsValidUtf8(const std::string& s) {
+  uint32_t cp = 0;
+  for (size_t i = 0; i < s.size();) {
+    if (!NextCodePoint(s, &i, &cp)) return false;
+  }
+  return true;
+}
+
+/**
+ * Letter test matching the old platform check (Character.isLetter / letterCharacterSet) closely
+ * enough for hotwords: ASCII letters, and non-ASCII code points outside the punctuation, symbol and
+ * emoji blocks.
+ */
+bool IsLetter(uint32_t cp) {
+  if (cp < 0x80) return (cp | 0x20) >= 'a' && (cp | 0x20) <= 'z';
+  if (cp < 0xC0 || cp == 0xD7 || cp == 0xF7) return false;
+  if (cp >= 0x2000 && cp <= 0x2BFF) return false;
+  if (cp >= 0x3000 && cp <= 0x3004) return false;
+  if (cp >= 0x3008 && cp <= 0x3020) return false;
+  if (cp >= 0xFF00 && cp <= 0xFF20) return false;
+  if (cp >= 0x1F000) return false;
+  return true;
+}
+
+bool ContainsLetter(const std::string& s) {
+  uint32_t cp = 0;
+  for (size_t i = 0; i < s.size();) {
+    if (!NextCodePoint(s, &i, &cp)) return false;
+    if (IsLetter(cp)) return true;
+  }
+  return false;
+}
+
+bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r' || c == '\n'; }
+
+std::string Trim(const std::string& s) {
+  size_t start = 0;
+  size_t end = s.size();
+  while (start < end && IsSpace(s[start])) ++start;
+  while (end > start && IsSpace(s[end - 1])) --end;
+  return s.substr(start, end - start);
+}
+
+bool ParseScore(const std::string& s, float* out) {
+  if (s.empty()) return false;
+  char* end = nullptr;
+  const float v = std::strtof(s.c_str(), &end);
+  if (end != s.c_str() + s.size()) return false;
+  *out = v;
+  return true;
+}
+
+/** First 60 code points of a line plus an ellipsis, for error messages. */
+std::string Excerpt(const std::string& line) {
+  size_t i = 0;
+  uint32_t cp = 0;
+  for (int n = 0; n < 60 && i < line.size(); ++n) {
+    if (!NextCodePoint(line, &i, &cp)) break;
+  }
+  return line.substr(0, i) + "\xe2\x80\xa6";
+}
+
+std::vector<std::string> SplitWords(const std::string& phrase) {
+  std::vector<std::string> words;
+  std::istringstream in(phrase);
+  std::string w;
+  while (in >> w) words.push_back(w);
+  return words;
+}
+
+std::string AsciiCase(std::string s, bool upper) {
+  for (char& c : s) {
+    if (upper && c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+    if (!upper && c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+  }
+  return s;
+}
+
+/**
+ * Vocabulary membership is checked leniently (as written, upper- or lower-case) so that a line
+ * sherpa-onnx would accept is never dropped; lines it would still reject just keep being skipped
+ * with its own warning.
+ */
+bool InVocab(const Vocabulary& v, const std::string& piece) {
+  return v.tokens.count(piece) || v.tokens.count(AsciiCase(piece, true)) || v.tokens.count(AsciiCase(piece, false));
+}
+
+/** Can `s` be split into vocabulary pieces at all (any BPE / unigram segmentation)? */
+bool Segmentable(const Vocabulary& v, const std::string& s) {
+  std::vector<char> reach(s.size() + 1, 0);
+  reach[0] = 1;
+  for (size_t i = 0; i < s.size(); ++i) {
+    if (!reach[i]) continue;
+    const size_t maxLen = std::min(v.maxTokenBytes, s.size() - i);
+    for (size_t len = 1; len <= maxLen; ++len) {
+      if (!reach[i + len] && v.tokens.count(s.substr(i, len))) reach[i + len] = 1;
+    }
+  }
+  return reach[s.size()] != 0;
+}
+
+bool BpeWordInVocab(const Vocabulary& v, const std::string& word) {
+  if (v.byteFallback) return true;
+  for (const std::string& w : {word, AsciiCase(word, true), AsciiCase(word, false)}) {
+    if (Segmentable(v, kWordBoundary + w) || Segmentable(v, w)) return true;
+  }
+  return false;
+}
+
+bool IsAsciiAlnum(uint32_t cp) { return cp < 0x80 && (std::isalnum(static_cast<int>(cp)) != 0); }
+
+/**
+ * cjkchar / cjkchar+bpe: sherpa-onnx splits a word into code points, keeping runs of ASCII
+ * letters and digits together; with +bpe the runs that start with a letter are BPE-encoded.
+ */
+bool CharWordInVocab(const Vocabulary& v, const std::string& word, bool bpe) {
+  size_t i = 0;
+  uint32_t cp = 0;
+  while (i < word.size()) {
+    const size_t start = i;
+    if (!NextCodePoint(word, &i, &cp)) return false;
+    if (IsAsciiAlnum(cp)) {
+      while (i < word.size() && IsAsciiAlnum(static_cast<unsigned char>(word[i]))) ++i;
+      const std::string run = word.substr(start, i - start);
+      if (bpe && std::isalpha(static_cast<unsigned char>(run[0])) && BpeWordInVocab(v, run)) continue;
+      if (InVocab(v, run)) continue;
+      bool chars = true;
+      for (char c : run) chars = chars && InVocab(v, std::string(1, c));
+      if (!chars) return false;
+      continue;
+    }
+    if (!InVocab(v, word.substr(start, i - start))) return false;
+  }
+  return true;
+}
+
+struct Entry {
+  std::string phrase;
+  bool hasScore = false;
+  float score = 0.0f;
+};
+
+/** Validator of the former validateHotwordsFile / ValidateHotwordsFile; empty on success. */
+std::string ParseLines(const std::vector<std::string>& lines, std::vector<Entry>* entries) {
+  for (const auto& raw : lines) {
+    const std::string line = Trim(raw);
+    if (line.empty()) continue;
+    Entry e;
+    std::string hotword;
+    const size_t colon = line.rfind(" :");
+    if (colon != std::string::npos) {
+      const std::string afterScore = Trim(line.substr(colon + 2));
+      if (afterScore.empty()) return "Invalid hotword line (missing score after ' :'): " + Excerpt(line);
+      if (!ParseScore(afterScore, &e.score)) {
+        return "Invalid hotword line (score must be a number after ' :'): " + Excerpt(line);
+      }
+      e.hasScore = true;
+      hotword = Trim(line.substr(0, colon));
+    } else {
+      const size_t tab = line.find('\t');
+      float ignored = 0.0f;
+      if (tab != std::string::npos && ParseScore(Trim(line.substr(tab + 1)), &ignored)) {
+        return "This file looks like a sentencepiece .vocab file (token<TAB>score). Use a hotwords file instead: one "
+               "word or phrase per line, optional ' :score' at end.";
+      }
+      hotword = line;
+    }
+    if (hotword.empty()) return "Invalid hotword line (empty hotword): " + Excerpt(line);
+    if (!IsValidUtf8(hotword)) return "Invalid hotword line (invalid UTF-8): " + Excerpt(line);
+    if (!ContainsLetter(hotword)) return "Invalid hotword line (must contain at least one letter): " + Excerpt(line);
+    const std::vector<std::string> words = SplitWords(hotword);
+    for (size_t k = 0; k < words.size(); ++k) e.phrase += (k ? " " : "") + words[k];
+    entries->push_back(std::move(e));
+  }
+  if (entries->empty()) return "Hotwords file has no valid lines (one hotword or phrase per line, UTF-8 text).";
+  return {};
+}
+
+std::string FormatScore(float score) {
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%g", static_cast<double>(score));
+  return buf;
+}
+
+/** Shared part of both entry points: the compiled text with `separator` between entries. */
+HotwordsCompileResult CompileLines(const std::vector<std::string>& lines, const HotwordsCompileOptions& options,
+                                   char separator) {
+  HotwordsCompileResult result;
+  std::vector<Entry> parsed;
+  result.error = ParseLines(lines, &parsed);
+  if (!result.error.empty()) return result;
+
+  const std::string unit = options.modelingUnit.empty() ? "cjkchar" : options.modelingUnit;
+  const bool knownUnit = unit == "cjkchar" || unit == "bpe" || unit == "cjkchar+bpe";
+  const auto vocab = knownUnit ? LoadVocabulary(options.tokensPath) : nullptr;
+  result.vocabChecked = vocab != nullptr;
+
+  std::vector<Entry> kept;
+  std::unordered_map<std::string, size_t> index;
+  for (auto& e : parsed) {
+    auto it = index.find(e.phrase);
+    if (it != index.end()) {
+      Entry& first = kept[it->second];
+      if (e.hasScore && (!first.hasScore || e.score > first.score)) {
+        first.hasScore = true;
+        first.score = e.score;
+      }
+      ++result.duplicates;
+      continue;
+    }
+    if (vocab) {
+      bool ok = true;
+      for (const auto& word : SplitWords(e.phrase)) {
+        ok = unit == "bpe" ? BpeWordInVocab(*vocab, word) : CharWordInVocab(*vocab, word, unit == "cjkchar+bpe");
+        if (!ok) break;
+      }
+      if (!ok) {
+        ++result.oovLines;
+        if (result.oovSamples.size() < kMaxOovSamples) result.oovSamples.push_back(e.phrase);
+        continue;
+      }
+    }
+    index.emplace(e.phrase, kept.size());
+    kept.push_back(std::move(e));
+  }
+  if (kept.empty()) {
+    result.error = "No hotword can be encoded with this model's tokens (e.g. \"" + result.oovSamples.front() +
+                   "\"). Check modelingUnit / bpeVocab and the letter case of the phrases.";
+    return result;
+  }
+  for (size_t k = 0; k < kept.size(); ++k) {
+    if (k) result.text += separator;
+    result.text += kept[k].phrase;
+    if (kept[k].hasScore) result.text += " :" + FormatScore(kept[k].score);
+  }
+  result.entries = static_cast<int32_t>(kept.size());
+  result.ok = true;
+  return result;
+}
+
+std::string SerializeMeta(const HotwordsCompileResult& r) {
+  char buf[96];
+  std::snprintf(buf, sizeof(buf), "%s %d %d %d %d\n", kMetaTag, r.entries, r.duplicates, r.oovLines,
+                r.vocabChecked ? 1 : 0);
+  std::string out = buf;
+  for (const auto& s : r.oovSamples) out += s + "\n";
+  return out;
+}
+
+bool ParseMeta(const std::string& text, HotwordsCompileResult* out) {
+  char tag[16] = {0};
+  int entries = 0;
+  int duplicates = 0;
+  int oov = 0;
+  int checked = 0;
+  if (std::sscanf(text.c_str(), "%15s %d %d %d %d", tag, &entries, &duplicates, &oov, &checked) != 5 ||
+      std::string(tag) != kMetaTag || entries <= 0 || duplicates < 0 || oov < 0) {
+    return false;
+  }
+  out->entries = entries;
+  out->duplicates = duplicates;
+  out->oovLines = oov;
+  out->vocabChecked = checked != 0;
+  std::istringstream in(text);
+  std::string line;
+  std::getline(in, line);
+  while (out->oovSamples.size() < kMaxOovSamples && std::getline(in, line)) {
+    if (!line.empty()) out->oovSamples.push_back(line);
+  }
+  return true;
+}
+
+/**
+ * Compiled files returned by this process. A live recognizer config may still name any of them
+ * as hotwords_file (re-read on every setConfig), so pruning never removes them.
+ */
+struct HandedOutFiles {
+  std::mutex mutex;
+  std::unordered_set<std::string> paths;
+};
+
+HandedOutFiles& HandedOut() {
+  static HandedOutFiles files;
+  return files;
+}
+
+void MarkHandedOut(const fs::path& compiled) {
+  HandedOutFiles& files = HandedOut();
+  std::lock_guard<std::mutex> lock(files.mutex);
+  files.paths.insert(compiled.string());
+}
+
+/** Cached result for a compiled file whose .meta sidecar is present and valid. */
+bool LoadCached(const fs::path& compiled, HotwordsCompileResult* out) {
+  fs::path meta = compiled;
+  meta.replace_extension(".meta");
+  std::string text;
+  std::error_code ec;
+  if (!fs::is_regular_file(compiled, ec) || !ReadFile(meta.string(), &text) || !ParseMeta(text, out)) return false;
+  // Recently used entries survive pruning.
+  fs::last_write_time(meta, fs::file_time_type::clock::now(), ec);
+  MarkHandedOut(compiled);
+  out->compiledPath = compiled.string();
+  out->cached = true;
+  out->ok = true;
+  return true;
+}
+
+/**
+ * Remove the least recently used compiled files beyond kMaxCachedFiles, except those handed out
+ * by this process, and temp files left by a write that never finished.
+ */
+void PruneCache(const fs::path& dir) {
+  std::vector<std::pair<fs::file_time_type, fs::path>> metas;
+  const auto staleBefore = fs::file_time_type::clock::now() - kStaleTempAge;
+  std::error_code ec;
+  for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+    const fs::path& p = it->path();
+    const std::string name = p.filename().string();
+    if (name.compare(0, 3, "hw-") != 0) continue;
+    std::error_code tec;
+    const auto t = fs::last_write_time(p, tec);
+    if (tec) continue;
+    if (name.find(".tmp") != std::string::npos) {
+      if (t < staleBefore) fs::remove(p, tec);
+    } else if (p.extension() == ".meta") {
+      metas.emplace_back(t, p);
+    }
+  }
+  if (metas.size() <= kMaxCachedFiles) return;
+  std::sort(metas.begin(), metas.end());
+  size_t excess = metas.size() - kMaxCachedFiles;
+  HandedOutFiles& files = HandedOut();
+  std::lock_guard<std::mutex> lock(files.mutex);
+  for (size_t k = 0; k < metas.size() && excess > 0; ++k) {
+    fs::path txt = metas[k].second;
+    txt.replace_extension(".txt");
+    if (files.paths.count(txt.string()) != 0) continue;
+    fs::remove(metas[k].second, ec);
+    fs::remove(txt, ec);
+    --excess;
+  }
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t CacheKey(uint64_t contentHash, const HotwordsCompileOptions& options) {
+  const std::string unit = options.modelingUnit.empty() ? "cjkchar" : options.modelingUnit;
+  const std::string key = std::string(kMetaTag) + "|" + Hex(contentHash) + "|" +
+                          Hex(ModelFileHash(options.tokensPath)) + "|" + Hex(ModelFileHash(options.bpeVocabPath)) +
+                          "|" + unit;
+  return Fnv1a(key);
+}
+
+std::vector<std::string> SplitAny(const std::string& s, const char* separators) {
+  std::vector<std::string> parts;
+  size_t start = 0;
+  while (true) {
+    const size_t pos = s.find_first_of(separators, start);
+    parts.push_back(s.substr(start, pos == std::string::npos ? std::string::npos : pos - start));
+    if (pos == std::string::npos) break;
+    start = pos + 1;
+  }
+  return parts;
+}
+
+}  // namespace
+
+HotwordsCompileResult CompileHotwordsFile(const std::string& path, const HotwordsCompileOptions& options) {
+  const auto start = std::chrono::steady_clock::now();
+  HotwordsCompileResult result;
+  std::error_code ec;
+  if (!fs::exists(path, ec)) {
+    result.error = "Hotwords file does not exist: " + path;
+    return result;
+  }
+  if (!fs::is_regular_file(path, ec)) {
+    result.error = "Hotwords path is not a file: " + path;
+    return result;
+  }
+  std::string content;
+  if (!ReadFile(path, &content)) {
+    result.error = "Hotwords file is not readable: " + path;
+    return result;
+  }
+  if (content.find('\0') != std::string::npos) {
+    result.error = "Hotwords file contains null bytes (not a valid text file).";
+    return result;
+  }
+  if (options.cacheDir.empty()) {
+    result.error = "No cache directory for compiled hotwords.";
+    return result;
+  }
+  const fs::path dir(options.cacheDir);
+
+  // setConfig re-applies the compiled file of the current config.
+  const fs::path input(path);
+  if (input.filename().string().compare(0, 3, "hw-") == 0 && input.extension() == ".txt" &&
+      fs::equivalent(input.parent_path(), dir, ec) && LoadCached(input, &result)) {
+    result.compileMs = ElapsedMs(start);
+    return result;
+  }
+
+  const fs::path compiled = dir / ("hw-" + Hex(CacheKey(Fnv1a(content), options)) + ".txt");
+  if (LoadCached(compiled, &result)) {
+    result.compileMs = ElapsedMs(start);
+    return result;
+  }
+  result = CompileLines(SplitAny(content, "\n\r"), options, '\n');
+  if (!result.ok) return result;
+  fs::create_directories(dir, ec);
+  fs::path meta = compiled;
+  meta.replace_extension(".meta");
+  // The .meta sidecar is written last: its presence marks a complete entry.
+  if (!WriteFileAtomically(compiled, result.text + "\n") || !WriteFileAtomically(meta, SerializeMeta(result))) {
+    result.ok = false;
+    result.error = "Failed to write compiled hotwords to " + options.cacheDir;
+    return result;
+  }
+  MarkHandedOut(compiled);
+  PruneCache(dir);
+  result.compiledPath = compiled.string();
+  result.text.clear();
+  result.compileMs = ElapsedMs(start);
+  return result;
+}
+
+HotwordsCompileResult CompileHotwordsText(const std::string& hotwords, const HotwordsCompileOptions& options) {
+  static std::mutex mutex;
+  static std::unordered_map<uint64_t, HotwordsCompileResult> cache;
+  const auto start = std::chrono::steady_clock::now();
+  if (hotwords.find('\0') != std::string::npos) {
+    HotwordsCompileResult result;
+    result.error = "Hotwords contain null bytes (not valid text).";
+    return result;
+  }
+  const uint64_t key = CacheKey(Fnv1a(hotwords), options);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+      HotwordsCompileResult result = it->second;
+      result.cached = true;
+      result.compileMs = ElapsedMs(start);
+      return result;
+    }
+  }
+  HotwordsCompileResult result = CompileLines(SplitAny(hotwords, "/\n\r"), options, '/');
+  result.compileMs = ElapsedMs(start);
+  if (!result.ok) return result;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (cache.size() >= kMaxCachedTexts) cache.clear();
+  cache[key] = result;
+  return result;
+}
+
+}  // namespace sherpaonnx
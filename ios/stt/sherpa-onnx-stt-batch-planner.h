@@ -0,0 +1,49 @@
+/**
+ * sherpa-onnx-stt-batch-planner.h
+ *
+ * Declares the planning half of batched offline transcription (transcribeFiles): estimate each
+ * input's duration without decoding it, then group inputs of similar length so that one
+ * multi-stream decode per group pads little. Used by the STT JNI (Android) and SttWrapper (iOS).
+ */
+#ifndef SHERPA_ONNX_STT_BATCH_PLANNER_H
+#define SHERPA_ONNX_STT_BATCH_PLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sherpaonnx {
+
+struct SttBatchOptions {
+  /** Streams decoded together; 1 = one file at a time (the sequential baseline). */
+  int32_t maxBatchSize = 8;
+  /**
+   * Upper bound on a batch's padded audio (count * longest item), in seconds, which bounds the
+   * feature memory of one decode; <= 0 = no bound. A single longer item still forms its own batch.
+   */
+  double maxPaddedSeconds = 240.0;
+};
+
+/** Batches as indices into the input, longest items first; every index appears exactly once. */
+using SttBatchPlan = std::vector<std::vector<size_t>>;
+
+/**
+ * Group items by length: sort by seconds (descending) and fill each batch while it stays within
+ * maxBatchSize and maxPaddedSeconds. Items with unknown length (< 0) go last, in input order.
+ */
+SttBatchPlan PlanSttBatches(const std::vector<double>& seconds, const SttBatchOptions& options);
+
+/** Audio in the batch plus the silence it is padded with to the longest item, in seconds. */
+double SttBatchPaddedSeconds(const std::vector<double>& seconds, const std::vector<size_t>& batch);
+
+/**
+ * Duration of an audio file from its header only: exact for PCM / float WAV (RIFF "data" chunk
+ * size), otherwise the file size at 128 kbit/s as a rough guess for compressed formats.
+ * Returns -1 when the file cannot be opened (e.g. a content:// URI).
+ */
+double EstimateAudioFileSeconds(const std::string& path);
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_STT_BATCH_PLANNER_H
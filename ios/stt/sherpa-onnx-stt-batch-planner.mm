@@ -0,0 +1,110 @@
+/**
+ * sherpa-onnx-stt-batch-planner.mm
+ *
+ * Purpose: Length-sorted grouping of files for batched offline decoding, and header-only duration
+ * estimates to sort by before any file is read in full.
+ * Mirror of android/src/main/cpp/jni/stt/sherpa-onnx-stt-batch-planner.cpp; keep in sync.
+ */
+#include "sherpa-onnx-stt-batch-planner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace sherpaonnx {
+
+namespace {
+
+uint32_t ReadLe32(const unsigned char* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Compressed formats: 128 kbit/s is typical for speech MP3 / AAC; only the sort order matters.
+constexpr double kCompressedBytesPerSecond = 16000.0;
+
+}  // namespace
+
+SttBatchPlan PlanSttBatches(const std::vector<double>& seconds, const SttBatchOptions& options) {
+  const size_t maxSize = static_cast<size_t>(std::max<int32_t>(1, options.maxBatchSize));
+  std::vector<size_t> order(seconds.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  // Unknown lengths sort after every known one; stable keeps input order among equals.
+  std::stable_sort(order.begin(), order.end(), [&seconds](size_t a, size_t b) {
+    return seconds[a] > seconds[b];
+  });
+
+  SttBatchPlan plan;
+  std::vector<size_t> batch;
+  double longest = 0.0;
+  for (size_t index : order) {
+    const double s = std::max(0.0, seconds[index]);
+    if (!batch.empty()) {
+      // Sorted descending, so the batch's first item stays its longest.
+      const bool full = batch.size() >= maxSize;
+      const bool tooLong = options.maxPaddedSeconds > 0.0 &&
+                           static_cast<double>(batch.size() + 1) * longest > options.maxPaddedSeconds;
+      if (full || tooLong) {
+        plan.push_back(std::move(batch));
+        batch.clear();
+      }
+    }
+    if (batch.empty()) longest = s;
+    batch.push_back(index);
+  }
+  if (!batch.empty()) plan.push_back(std::move(batch));
+  return plan;
+}
+
+double SttBatchPaddedSeconds(const std::vector<double>& seconds, const std::vector<size_t>& batch) {
+  double longest = 0.0;
+  for (size_t index : batch) {
+    if (index < seconds.size()) longest = std::max(longest, seconds[index]);
+  }
+  return longest * static_cast<double>(batch.size());
+}
+
+double EstimateAudioFileSeconds(const std::string& path) {
+  std::FILE* f = std::fopen(path.c_str(), "rb");
+  if (!f) return -1.0;
+  std::fseek(f, 0, SEEK_END);
+  const long fileSize = std::ftell(f);
+  std::fseek(f, 0, SEEK_SET);
+  if (fileSize <= 0) {
+    std::fclose(f);
+    return 0.0;
+  }
+
+  unsigned char riff[12];
+  double result = static_cast<double>(fileSize) / kCompressedBytesPerSecond;
+  if (std::fread(riff, 1, sizeof(riff), f) == sizeof(riff) && std::memcmp(riff, "RIFF", 4) == 0 &&
+      std::memcmp(riff + 8, "WAVE", 4) == 0) {
+    uint32_t byteRate = 0;
+    unsigned char header[8];
+    // Walk the chunks up to "data"; "fmt " carries the byte rate.
+    while (std::fread(header, 1, sizeof(header), f) == sizeof(header)) {
+      const uint32_t size = ReadLe32(header + 4);
+      if (std::memcmp(header, "fmt ", 4) == 0 && size >= 16) {
+        unsigned char fmt[16];
+        if (std::fread(fmt, 1, sizeof(fmt), f) != sizeof(fmt)) break;
+        byteRate = ReadLe32(fmt + 8);
+        if (std::fseek(f, static_cast<long>(size - 16 + (size & 1)), SEEK_CUR) != 0) break;
+      } else if (std::memcmp(header, "data", 4) == 0) {
+        if (byteRate == 0) break;
+        // Streaming writers leave 0 or 0xFFFFFFFF until finalized; use the rest of the file then.
+        const long offset = std::ftell(f);
+        const uint64_t available = fileSize > offset ? static_cast<uint64_t>(fileSize - offset) : 0;
+        const uint64_t dataSize =
+            (size == 0 || size == 0xFFFFFFFFu) ? available : std::min<uint64_t>(size, available);
+        result = static_cast<double>(dataSize) / static_cast<double>(byteRate);
+        break;
+      } else if (std::fseek(f, static_cast<long>(size + (size & 1)), SEEK_CUR) != 0) {
+        break;
+      }
+    }
+  }
+  std::fclose(f);
+  return result;
+}
+
+}  // namespace sherpaonnx
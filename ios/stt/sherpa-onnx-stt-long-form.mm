@@ -0,0 +1,104 @@
+/**
+ * sherpa-onnx-stt-long-form.mm
+ *
+ * Purpose: Decode-range construction from VAD segments and transcript joining for long-form
+ * transcription (transcribeLongFile).
+ * Mirror of android/src/main/cpp/jni/stt/sherpa-onnx-stt-long-form.cpp; keep in sync.
+ */
+#include "sherpa-onnx-stt-long-form.h"
+
+#include <algorithm>
+
+namespace sherpaonnx {
+
+namespace {
+
+bool IsSpace(unsigned char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+// Last (or first) code point of UTF-8 text; 0 if malformed.
+uint32_t CodePointAt(const std::string& s, bool last) {
+  if (s.empty()) return 0;
+  size_t i = last ? s.size() - 1 : 0;
+  if (last) {
+    while (i > 0 && (static_cast<unsigned char>(s[i]) & 0xC0) == 0x80) --i;
+  }
+  const unsigned char lead = static_cast<unsigned char>(s[i]);
+  size_t extra = lead < 0x80 ? 0 : (lead >> 5) == 0x6 ? 1 : (lead >> 4) == 0xE ? 2 : (lead >> 3) == 0x1E ? 3 : 4;
+  if (extra == 4 || i + extra >= s.size()) return 0;
+  uint32_t cp = extra == 0 ? lead : lead & (0x3F >> extra);
+  for (size_t k = 1; k <= extra; ++k) cp = (cp << 6) | (static_cast<unsigned char>(s[i + k]) & 0x3F);
+  return cp;
+}
+
+// Han, kana, CJK punctuation and full-width forms. Hangul is excluded: Korean uses spaces.
+bool IsCjk(uint32_t cp) {
+  return (cp >= 0x2E80 && cp <= 0x9FFF) || (cp >= 0xF900 && cp <= 0xFAFF) || (cp >= 0xFF00 && cp <= 0xFFEF) ||
+         (cp >= 0x20000 && cp <= 0x2FFFF);
+}
+
+}  // namespace
+
+void SpeechRangeBuilder::Emit(const SpeechRange& range, std::vector<SpeechRange>* out) const {
+  const int64_t cap = options_.maxRangeSamples;
+  if (cap <= 0 || range.end - range.start <= cap) {
+    if (range.end > range.start) out->push_back(range);
+    return;
+  }
+  // Split evenly rather than leaving a short tail: n pieces of at most cap each.
+  const int64_t length = range.end - range.start;
+  const int64_t pieces = (length + cap - 1) / cap;
+  for (int64_t k = 0; k < pieces; ++k) {
+    out->push_back({range.start + length * k / pieces, range.start + length * (k + 1) / pieces});
+  }
+}
+
+std::vector<SpeechRange> SpeechRangeBuilder::Push(int64_t start, int64_t length) {
+  std::vector<SpeechRange> ready;
+  if (length <= 0) return ready;
+  SpeechRange padded{std::max<int64_t>(0, start - options_.paddingSamples),
+                     start + length + options_.paddingSamples};
+  if (hasPending_) {
+    const bool overlaps = padded.start <= pending_.end;
+    const bool fits = options_.maxRangeSamples <= 0 ||
+                      std::max(pending_.end, padded.end) - pending_.start <= options_.maxRangeSamples;
+    if (overlaps && fits) {
+      pending_.end = std::max(pending_.end, padded.end);
+      return ready;
+    }
+    Emit(pending_, &ready);
+    // Never hand the same samples to two ranges.
+    padded.start = std::max(padded.start, pending_.end);
+  }
+  pending_ = padded;
+  hasPending_ = true;
+  return ready;
+}
+
+std::vector<SpeechRange> SpeechRangeBuilder::Finish(int64_t totalSamples) {
+  std::vector<SpeechRange> ready;
+  if (hasPending_) {
+    pending_.end = std::min(pending_.end, totalSamples);
+    Emit(pending_, &ready);
+    hasPending_ = false;
+  }
+  return ready;
+}
+
+std::string JoinSegmentTexts(const std::vector<std::string>& texts) {
+  std::string joined;
+  for (const std::string& text : texts) {
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && IsSpace(static_cast<unsigned char>(text[begin]))) ++begin;
+    while (end > begin && IsSpace(static_cast<unsigned char>(text[end - 1]))) --end;
+    if (begin == end) continue;
+    const std::string piece = text.substr(begin, end - begin);
+    if (!joined.empty() && !(IsCjk(CodePointAt(joined, true)) && IsCjk(CodePointAt(piece, false)))) {
+      joined.push_back(' ');
+    }
+    joined += piece;
+  }
+  return joined;
+}
+
+}  // namespace sherpaonnx
@@ -0,0 +1,141 @@
+/**
+ * sherpa-onnx-stt-tuner.h
+ *
+ * Declares the search half of the offline STT auto-tuner (tuneStt): which recognizer
+ * configurations (thread count, execution provider, int8 / fp32 model files) to time on this
+ * device, which measured one wins, the stored form of the winner, and a process memory probe for
+ * the peak cost of each candidate. Loading and decoding stay in the platform code (Kotlin
+ * OfflineRecognizer on Android, SttWrapper on iOS).
+ */
+#ifndef SHERPA_ONNX_STT_TUNER_H
+#define SHERPA_ONNX_STT_TUNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sherpaonnx {
+
+struct SttTuneCandidate {
+  int32_t numThreads = 1;
+  std::string provider = "cpu";
+  /** int8 model files (preferInt8: true) instead of fp32. */
+  bool int8 = false;
+};
+
+struct SttTuneMeasurement {
+  SttTuneCandidate candidate;
+  /** False when the recognizer could not be created or a decode failed (see error). */
+  bool ok = false;
+  std::string error;
+  /** Recognizer (ONNX Runtime session) creation. */
+  double loadMs = 0.0;
+  /** Median of the timed decodes (a warm-up decode runs first and is not counted). */
+  double decodeMs = 0.0;
+  /** Length of the calibration audio. */
+  double audioMs = 0.0;
+  /** decodeMs / audioMs; lower is faster. */
+  double rtf = 0.0;
+  /** Growth of process memory from before creation to the peak during the decodes; 0 = unknown. */
+  int64_t peakMemoryBytes = 0;
+};
+
+struct SttTuneOptions {
+  /** Largest thread count tried (the ladder is 1, 2, 4, ... up to it, plus it). */
+  int32_t maxThreads = 4;
+  /** Providers to try besides "cpu" (which is always tried first). */
+  std::vector<std::string> providers;
+  /** Which model file sets exist; int8 is the baseline when present. */
+  bool hasInt8 = false;
+  bool hasFp32 = true;
+  /** Candidates whose peakMemoryBytes exceeds this are not chosen; <= 0 = no bound. */
+  int64_t maxMemoryBytes = 0;
+  /** Relative RTF gain a candidate needs to count as faster (default 5%). */
+  double tolerance = 0.05;
+};
+
+/** 1, 2, 4, ... below maxThreads, then maxThreads itself (at least { 1 }). */
+std::vector<int32_t> SttTuneThreadLadder(int32_t maxThreads);
+
+/**
+ * Staged search instead of the full product of threads x providers x quantizations, since every
+ * candidate means loading the model: (1) cpu with the baseline quantization over the thread
+ * ladder, stopping once more threads stop helping by `tolerance`; (2) every other provider at the
+ * best thread count; (3) the other quantization with the best provider and thread count so far.
+ * Call Next() for the candidate to measure and Report() its measurement until Next() returns
+ * false. Not thread-safe.
+ */
+class SttAutoTuner {
+ public:
+  explicit SttAutoTuner(const SttTuneOptions& options);
+
+  /** Next configuration to measure; false when the search is done. */
+  bool Next(SttTuneCandidate* candidate);
+
+  /** Result for the candidate returned by the last Next(). */
+  void Report(const SttTuneMeasurement& measurement);
+
+  const std::vector<SttTuneMeasurement>& Measurements() const { return measurements_; }
+
+  /**
+   * Winner: the lowest RTF among working candidates within maxMemoryBytes; candidates within
+   * `tolerance` of it are considered equal and the one with fewer threads, then less memory, wins.
+   * When every working candidate exceeds the memory bound, the one using the least memory. False
+   * when nothing worked.
+   */
+  bool Best(SttTuneMeasurement* best) const;
+
+ private:
+  enum class Stage { kThreads, kProviders, kQuantization, kDone };
+
+  const SttTuneMeasurement* BestSoFar() const;
+
+  SttTuneOptions options_;
+  std::vector<int32_t> ladder_;
+  std::vector<SttTuneMeasurement> measurements_;
+  Stage stage_ = Stage::kThreads;
+  size_t index_ = 0;
+  bool baseInt8_ = false;
+  /** Best ok thread-ladder measurement so far (index into measurements_), or -1. */
+  int64_t bestThreads_ = -1;
+};
+
+/** One-line text form of a winner (candidate, RTF, memory), for storing it across launches. */
+std::string SerializeSttTuneChoice(const SttTuneMeasurement& choice);
+/** Parse a SerializeSttTuneChoice() result; false (out unchanged) if it does not parse. */
+bool ParseSttTuneChoice(const std::string& text, SttTuneMeasurement* out);
+
+/**
+ * Storage key part for a model: directory, model type and the count and total size of its model
+ * files (ListModelFiles), so replacing the files invalidates a stored choice. The platform adds
+ * the device identity.
+ */
+std::string SttTuneModelKey(const std::string& modelDir, const std::string& modelType);
+
+/**
+ * Peak memory of this process while a candidate is loaded and decoded. On Linux / Android the
+ * kernel's resident high-water mark (VmHWM) is reset through /proc/self/clear_refs when allowed,
+ * otherwise VmRSS is sampled; on Apple the physical footprint is sampled. Sample() after the load
+ * and after each decode.
+ */
+class ProcessMemoryProbe {
+ public:
+  /** Record the baseline (and reset the high-water mark where possible). */
+  void Begin();
+  void Sample();
+  /** Peak minus baseline seen since Begin(); 0 when memory could not be read. */
+  int64_t PeakDeltaBytes() const;
+
+  /** Current resident / footprint bytes of the process; 0 when unavailable. */
+  static int64_t CurrentBytes();
+
+ private:
+  int64_t baseline_ = 0;
+  int64_t peak_ = 0;
+  bool highWaterMark_ = false;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_STT_TUNER_H
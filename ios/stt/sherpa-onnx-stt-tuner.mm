@@ -0,0 +1,263 @@
+/**
+ * sherpa-onnx-stt-tuner.mm
+ *
+ * Purpose: Candidate search, winner selection, stored form and memory probe of the offline STT
+ * auto-tuner (tuneStt).
+ * Mirror of android/src/main/cpp/jni/stt/sherpa-onnx-stt-tuner.cpp; keep in sync.
+ */
+#include "sherpa-onnx-stt-tuner.h"
+
+#include "sherpa-onnx-file-prefetch.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+namespace sherpaonnx {
+
+namespace {
+
+constexpr const char* kSerializedTag = "stttune1";
+
+bool WithinMemory(const SttTuneMeasurement& m, int64_t maxMemoryBytes) {
+  return maxMemoryBytes <= 0 || m.peakMemoryBytes <= maxMemoryBytes;
+}
+
+#if defined(__linux__)
+// "VmRSS:    12345 kB" -> bytes; 0 when the field is missing.
+int64_t ReadStatusKb(const char* field) {
+  std::ifstream in("/proc/self/status");
+  std::string line;
+  const size_t n = std::strlen(field);
+  while (std::getline(in, line)) {
+    if (line.compare(0, n, field) == 0 && line.size() > n && line[n] == ':') {
+      long long kb = 0;
+      if (std::sscanf(line.c_str() + n + 1, "%lld", &kb) == 1) return static_cast<int64_t>(kb) * 1024;
+    }
+  }
+  return 0;
+}
+#endif
+
+}  // namespace
+
+std::vector<int32_t> SttTuneThreadLadder(int32_t maxThreads) {
+  maxThreads = std::max<int32_t>(1, maxThreads);
+  std::vector<int32_t> ladder;
+  for (int32_t t = 1; t < maxThreads; t *= 2) ladder.push_back(t);
+  ladder.push_back(maxThreads);
+  return ladder;
+}
+
+SttAutoTuner::SttAutoTuner(const SttTuneOptions& options)
+    : options_(options), ladder_(SttTuneThreadLadder(options.maxThreads)) {
+  if (!options_.hasInt8 && !options_.hasFp32) options_.hasFp32 = true;
+  options_.tolerance = std::max(0.0, options_.tolerance);
+  baseInt8_ = options_.hasInt8;
+  // "cpu" is the thread-ladder stage; keep the other providers once each, in order.
+  std::vector<std::string> providers;
+  for (const auto& p : options_.providers) {
+    if (p.empty() || p == "cpu" || std::find(providers.begin(), providers.end(), p) != providers.end()) continue;
+    providers.push_back(p);
+  }
+  options_.providers = providers;
+}
+
+const SttTuneMeasurement* SttAutoTuner::BestSoFar() const {
+  const SttTuneMeasurement* best = nullptr;
+  for (const auto& m : measurements_) {
+    if (!m.ok || !WithinMemory(m, options_.maxMemoryBytes)) continue;
+    if (!best || m.rtf < best->rtf) best = &m;
+  }
+  return best;
+}
+
+bool SttAutoTuner::Next(SttTuneCandidate* candidate) {
+  while (stage_ != Stage::kDone) {
+    switch (stage_) {
+      case Stage::kThreads:
+        if (index_ < ladder_.size()) {
+          candidate->numThreads = ladder_[index_];
+          candidate->provider = "cpu";
+          candidate->int8 = baseInt8_;
+          return true;
+        }
+        stage_ = Stage::kProviders;
+        index_ = 0;
+        break;
+      case Stage::kProviders:
+        if (index_ < options_.providers.size()) {
+          candidate->numThreads =
+              bestThreads_ >= 0 ? measurements_[static_cast<size_t>(bestThreads_)].candidate.numThreads : 1;
+          candidate->provider = options_.providers[index_];
+          candidate->int8 = baseInt8_;
+          return true;
+        }
+        stage_ = Stage::kQuantization;
+        index_ = 0;
+        break;
+      case Stage::kQuantization:
+        if (index_ == 0 && options_.hasInt8 && options_.hasFp32) {
+          const SttTuneMeasurement* best = BestSoFar();
+          candidate->numThreads = best ? best->candidate.numThreads : 1;
+          candidate->provider = best ? best->candidate.provider : "cpu";
+          candidate->int8 = !baseInt8_;
+          return true;
+        }
+        stage_ = Stage::kDone;
+        break;
+      case Stage::kDone:
+        break;
+    }
+  }
+  return false;
+}
+
+void SttAutoTuner::Report(const SttTuneMeasurement& measurement) {
+  measurements_.push_back(measurement);
+  const int64_t at = static_cast<int64_t>(measurements_.size()) - 1;
+  switch (stage_) {
+    case Stage::kThreads: {
+      ++index_;
+      if (!measurement.ok) break;
+      if (bestThreads_ < 0) {
+        bestThreads_ = at;
+        break;
+      }
+      const double bestRtf = measurements_[static_cast<size_t>(bestThreads_)].rtf;
+      if (measurement.rtf < bestRtf * (1.0 - options_.tolerance)) {
+        bestThreads_ = at;
+      } else {
+        // More threads stopped paying off; the rest of the ladder would only add contention.
+        index_ = ladder_.size();
+      }
+      break;
+    }
+    case Stage::kProviders:
+    case Stage::kQuantization:
+      ++index_;
+      break;
+    case Stage::kDone:
+      break;
+  }
+}
+
+bool SttAutoTuner::Best(SttTuneMeasurement* best) const {
+  const SttTuneMeasurement* fastest = BestSoFar();
+  if (fastest) {
+    const SttTuneMeasurement* pick = fastest;
+    const double limit = fastest->rtf * (1.0 + options_.tolerance);
+    for (const auto& m : measurements_) {
+      if (!m.ok || !WithinMemory(m, options_.maxMemoryBytes) || m.rtf > limit) continue;
+      if (m.candidate.numThreads < pick->candidate.numThreads ||
+          (m.candidate.numThreads == pick->candidate.numThreads && m.peakMemoryBytes < pick->peakMemoryBytes)) {
+        pick = &m;
+      }
+    }
+    *best = *pick;
+    return true;
+  }
+  // Everything that worked was over the memory bound: the smallest footprint is the best fallback.
+  const SttTuneMeasurement* smallest = nullptr;
+  for (const auto& m : measurements_) {
+    if (m.ok && (!smallest || m.peakMemoryBytes < smallest->peakMemoryBytes)) smallest = &m;
+  }
+  if (!smallest) return false;
+  *best = *smallest;
+  return true;
+}
+
+std::string SerializeSttTuneChoice(const SttTuneMeasurement& choice) {
+  const std::string provider = choice.candidate.provider.empty() ? "cpu" : choice.candidate.provider;
+  char buf[192];
+  std::snprintf(buf, sizeof(buf), "%s %d %s %d %.6g %lld", kSerializedTag, choice.candidate.numThreads,
+                provider.c_str(), choice.candidate.int8 ? 1 : 0, choice.rtf,
+                static_cast<long long>(choice.peakMemoryBytes));
+  return buf;
+}
+
+bool ParseSttTuneChoice(const std::string& text, SttTuneMeasurement* out) {
+  char tag[16] = {0};
+  char provider[64] = {0};
+  int threads = 0;
+  int int8 = 0;
+  double rtf = 0.0;
+  long long memory = 0;
+  if (std::sscanf(text.c_str(), "%15s %d %63s %d %lf %lld", tag, &threads, provider, &int8, &rtf, &memory) != 6 ||
+      std::string(tag) != kSerializedTag || threads <= 0 || !(rtf >= 0.0) || memory < 0) {
+    return false;
+  }
+  SttTuneMeasurement m;
+  m.candidate.numThreads = threads;
+  m.candidate.provider = provider;
+  m.candidate.int8 = int8 != 0;
+  m.ok = true;
+  m.rtf = rtf;
+  m.peakMemoryBytes = memory;
+  *out = m;
+  return true;
+}
+
+std::string SttTuneModelKey(const std::string& modelDir, const std::string& modelType) {
+  const std::vector<std::string> files = ListModelFiles(modelDir);
+  uint64_t bytes = 0;
+  for (const auto& f : files) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(f, ec);
+    if (!ec) bytes += static_cast<uint64_t>(size);
+  }
+  std::string dir = modelDir;
+  while (dir.size() > 1 && dir.back() == '/') dir.pop_back();
+  return dir + "|" + (modelType.empty() ? "auto" : modelType) + "|" + std::to_string(files.size()) + "|" +
+         std::to_string(bytes);
+}
+
+int64_t ProcessMemoryProbe::CurrentBytes() {
+#if defined(__linux__)
+  return ReadStatusKb("VmRSS");
+#elif defined(__APPLE__)
+  task_vm_info_data_t info;
+  mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+  if (task_info(mach_task_self(), TASK_VM_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+    return 0;
+  }
+  return static_cast<int64_t>(info.phys_footprint);
+#else
+  return 0;
+#endif
+}
+
+void ProcessMemoryProbe::Begin() {
+  highWaterMark_ = false;
+#if defined(__linux__)
+  // "5" resets VmHWM to the current RSS (Linux 4.0+); SELinux may deny the write.
+  if (FILE* f = std::fopen("/proc/self/clear_refs", "w")) {
+    highWaterMark_ = std::fputs("5", f) >= 0;
+    highWaterMark_ = (std::fclose(f) == 0) && highWaterMark_;
+  }
+#endif
+  baseline_ = CurrentBytes();
+  peak_ = baseline_;
+}
+
+void ProcessMemoryProbe::Sample() {
+  int64_t now = CurrentBytes();
+#if defined(__linux__)
+  if (highWaterMark_) now = std::max(now, ReadStatusKb("VmHWM"));
+#endif
+  peak_ = std::max(peak_, now);
+}
+
+int64_t ProcessMemoryProbe::PeakDeltaBytes() const {
+  if (baseline_ <= 0) return 0;
+  return std::max<int64_t>(0, peak_ - baseline_);
+}
+
+}  // namespace sherpaonnx
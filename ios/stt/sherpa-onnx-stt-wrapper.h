@@ -2,7 +2,12 @@
 #define SHERPA_ONNX_STT_WRAPPER_H
 
 #include "sherpa-onnx-common.h"
+#include "sherpa-onnx-hotwords-compiler.h"
+#include "sherpa-onnx-stt-batch-planner.h"
+#include "sherpa-onnx-stt-long-form.h"
+#include "sherpa-onnx-wav-reader.h"
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -22,10 +27,21 @@ struct SttInitializeResult {
     std::string modelType;
     /** Decoding method actually applied (e.g. "greedy_search", "modified_beam_search"). Set when success is true. */
     std::string decodingMethod;
+    /** Duration of the warm-up decode in milliseconds; -1 when warm-up was not requested. */
+    int64_t warmUpMs = -1;
+    /** Model detection time in milliseconds. */
+    int64_t detectMs = 0;
+    /** Recognizer (ONNX Runtime session) creation time in milliseconds; ~0 when shared. */
+    int64_t createMs = 0;
+    /** True when the recognizer was already loaded by another instance with the same config. */
+    bool sharedEngine = false;
+    /** Compilation of hotwordsFile (entries, dropped lines, cache hit); set when one was given. */
+    std::optional<HotwordsCompileResult> hotwords;
 };
 
 /**
- * Full recognition result (aligned with JS SttRecognitionResult).
+ * Full recognition result (aligned with JS SttRecognitionResult). Fields outside the
+ * resultFields mask (SttResultField) of the call are left empty.
  */
 struct SttRecognitionResult {
     std::string text;
@@ -37,6 +53,64 @@ struct SttRecognitionResult {
     std::vector<float> durations;
 };
 
+/** One file of transcribeFiles: result is valid when error is empty. */
+struct SttBatchItem {
+    size_t index = 0;
+    std::string path;
+    SttRecognitionResult result;
+    std::string error;
+};
+
+/** Totals of one transcribeFiles call. */
+struct SttBatchStats {
+    size_t batches = 0;
+    double audioMs = 0.0;
+    /** Time in decode calls; reads of the next batch overlap it. */
+    double decodeMs = 0.0;
+};
+
+/** Converts a non-WAV input to 16 kHz mono WAV at outputPath; returns "" on success. */
+using SttWavConverter = std::function<std::string(const std::string& inputPath, const std::string& outputPath)>;
+
+/** Options of transcribeLongFile: VAD model and settings, segment shaping and batching. */
+struct SttLongFormOptions {
+    std::string vadModel;
+    /** "silero" or "ten"; empty = "ten" when the model file name contains "ten", else "silero". */
+    std::string vadType;
+    float threshold = 0.5f;
+    float minSilenceDuration = 0.5f;
+    float minSpeechDuration = 0.25f;
+    float maxSegmentSeconds = 20.0f;
+    double paddingMs = 200.0;
+    int32_t maxBatchSize = 8;
+    int32_t vadThreads = 1;
+    /** SttResultField mask of the segment results and of the merged result. */
+    uint32_t resultFields = kSttResultAllFields;
+};
+
+/** One decoded segment of transcribeLongFile (seconds from file start); result is valid when error is empty. */
+struct SttLongFormSegment {
+    size_t index = 0;
+    double start = 0.0;
+    double end = 0.0;
+    SttRecognitionResult result;
+    std::string error;
+    /** Fraction of the file covered once this segment is done. */
+    double progress = 0.0;
+};
+
+/** Merged transcribeLongFile result: timestamps shifted to whole-file time. */
+struct SttLongFormResult {
+    SttRecognitionResult merged;
+    /** Every segment in time order, including failed ones. */
+    std::vector<SttLongFormSegment> segments;
+    size_t failedSegments = 0;
+    double audioMs = 0.0;
+    double speechMs = 0.0;
+    double vadMs = 0.0;
+    double decodeMs = 0.0;
+};
+
 /**
  * Runtime config options for setConfig (only mutable fields).
  */
@@ -106,12 +180,59 @@ public:
         const SttWhisperOptions* whisperOpts = nullptr,
         const SttSenseVoiceOptions* senseVoiceOpts = nullptr,
         const SttCanaryOptions* canaryOpts = nullptr,
-        const SttFunAsrNanoOptions* funasrNanoOpts = nullptr
+        const SttFunAsrNanoOptions* funasrNanoOpts = nullptr,
+        bool warmUp = false
     );
 
-    SttRecognitionResult transcribeFile(const std::string& filePath);
+    /** resultFields (SttResultField mask): only these fields besides text are copied out of the recognizer. */
+    SttRecognitionResult transcribeFile(const std::string& filePath, uint32_t resultFields = kSttResultAllFields);
+
+    SttRecognitionResult transcribeSamples(const std::vector<float>& samples, int32_t sampleRate,
+                                           uint32_t resultFields = kSttResultAllFields);
+
+    /** Same, from a caller-owned span: the samples go straight into the stream, no vector is built. */
+    SttRecognitionResult transcribeSamples(const float* samples, size_t count, int32_t sampleRate,
+                                           uint32_t resultFields = kSttResultAllFields);
+
+    /** 16-bit PCM span, converted to float once (SIMD, Int16ToFloat) right before decoding. */
+    SttRecognitionResult transcribeSamples(const int16_t* samples, size_t count, int32_t sampleRate,
+                                           uint32_t resultFields = kSttResultAllFields);
+
+    /**
+     * Raw PCM bytes (e.g. a decoded base64 chunk from the PCM live stream) in the given encoding;
+     * unaligned data is fine. Converted once, straight into the buffer the stream reads.
+     */
+    SttRecognitionResult transcribePcm(const void* data, size_t bytes, PcmEncoding encoding, int32_t sampleRate,
+                                       uint32_t resultFields = kSttResultAllFields);
+
+    /**
+     * Transcribe many files in length-sorted batches (PlanSttBatches), one multi-stream decode
+     * per batch. The next batch is read (and converted with converter, if set, when not WAV) on
+     * up to ioThreads threads while the current one decodes. onItem is called on the calling
+     * thread for every file as its batch finishes; read or decode failures are reported there.
+     * Item results carry text plus the resultFields of the mask.
+     */
+    SttBatchStats transcribeFiles(
+        const std::vector<std::string>& paths,
+        const SttBatchOptions& options,
+        int32_t ioThreads,
+        const SttWavConverter& converter,
+        const std::function<void(const SttBatchItem&)>& onItem,
+        uint32_t resultFields = kSttResultAllFields
+    );
 
-    SttRecognitionResult transcribeSamples(const std::vector<float>& samples, int32_t sampleRate);
+    /**
+     * Transcribe one long recording: a Silero / TEN VAD scans the (16 kHz WAV, else converted)
+     * file in one-second blocks, speech becomes padded ranges (SpeechRangeBuilder) and every
+     * maxBatchSize ranges are read back and decoded in one multi-stream call on a worker thread
+     * while the scan continues. onSegment is called on the calling thread, in time order.
+     */
+    SttLongFormResult transcribeLongFile(
+        const std::string& path,
+        const SttLongFormOptions& options,
+        const SttWavConverter& converter,
+        const std::function<void(const SttLongFormSegment&)>& onSegment
+    );
 
     void setConfig(const SttRuntimeConfigOptions& options);
 
@@ -7,10 +7,17 @@
 
 #include "sherpa-onnx-stt-wrapper.h"
 #include "sherpa-onnx-model-detect.h"
+#include "sherpa-onnx-engine-registry.h"
+#include "sherpa-onnx-tts-audio-cache.h"
+#include "sherpa-onnx-wav-reader.h"
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
 #include <cstring>
 #include <fstream>
+#include <future>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <cstdint>
@@ -41,77 +48,131 @@ static bool SupportsHotwords(sherpaonnx::SttModelKind kind) {
     return kind == sherpaonnx::SttModelKind::kTransducer || kind == sherpaonnx::SttModelKind::kNemoTransducer;
 }
 
-// Returns error message if hotwords file is invalid, else empty optional.
-static std::optional<std::string> ValidateHotwordsFile(const std::string& filePath) {
-    if (filePath.empty()) return std::nullopt;
-    try {
-        if (!fs::exists(filePath)) return "Hotwords file does not exist: " + filePath;
-        if (!fs::is_regular_file(filePath)) return "Hotwords path is not a file: " + filePath;
-        std::ifstream f(filePath, std::ios::binary);
-        if (!f) return "Hotwords file is not readable: " + filePath;
-        std::string content((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
-        f.close();
-        if (content.find('\0') != std::string::npos) return "Hotwords file contains null bytes (not a valid text file).";
-        NSCharacterSet *letterSet = [NSCharacterSet letterCharacterSet];
-        int validLines = 0;
-        std::istringstream stream(content);
-        std::string line;
-        while (std::getline(stream, line, '\n')) {
-            if (!line.empty() && line.back() == '\r') line.pop_back();
-            size_t start = 0;
-            while (start < line.size() && (line[start] == ' ' || line[start] == '\t')) start++;
-            size_t end = line.size();
-            while (end > start && (line[end - 1] == ' ' || line[end - 1] == '\t')) end--;
-            if (start >= end) continue;
-            line = line.substr(start, end - start);
-            std::string hotwordPart;
-            size_t spaceColon = line.rfind(" :");
-            if (spaceColon != std::string::npos) {
-                std::string scoreStr = line.substr(spaceColon + 2);
-                try {
-                    (void)std::stof(scoreStr);
-                } catch (...) {
-                    return "Invalid hotword line (score must be a number after ' :'): " + line.substr(0, std::min(line.size(), size_t(60))) + "…";
-                }
-                size_t hStart = 0, hEnd = spaceColon;
-                while (hStart < hEnd && (line[hStart] == ' ' || line[hStart] == '\t')) hStart++;
-                while (hEnd > hStart && (line[hEnd - 1] == ' ' || line[hEnd - 1] == '\t')) hEnd--;
-                hotwordPart = line.substr(hStart, hEnd - hStart);
-            } else {
-                size_t tabPos = line.find('\t');
-                if (tabPos != std::string::npos) {
-                    std::string afterTab = line.substr(tabPos + 1);
-                    try {
-                        (void)std::stof(afterTab);
-                        return "This file looks like a sentencepiece .vocab file (token<TAB>score). Use a hotwords file instead: one word or phrase per line, optional ' :score' at end.";
-                    } catch (...) {}
-                }
-                hotwordPart = line;
-            }
-            if (hotwordPart.empty()) return "Invalid hotword line (empty hotword): " + line.substr(0, std::min(line.size(), size_t(60))) + "…";
-            @autoreleasepool {
-                NSString *hotwordNS = [NSString stringWithUTF8String:hotwordPart.c_str()];
-                if (!hotwordNS) return "Invalid hotword line (invalid UTF-8): " + line.substr(0, std::min(line.size(), size_t(60))) + "…";
-                if ([hotwordNS rangeOfCharacterFromSet:letterSet].location == NSNotFound)
-                    return "Invalid hotword line (must contain at least one letter): " + line.substr(0, std::min(line.size(), size_t(60))) + "…";
-            }
-            validLines++;
-        }
-        if (validLines == 0) return "Hotwords file has no valid lines (one hotword or phrase per line, UTF-8 text).";
-        return std::nullopt;
-    } catch (const std::exception& e) {
-        return std::string("Failed to read hotwords file: ") + e.what();
+// Compiled hotwords files (CompileHotwordsFile) live under Library/Caches/sherpaonnx_hotwords.
+static std::string HotwordsCacheDir() {
+    @autoreleasepool {
+        NSArray *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
+        NSString *cacheDir = caches.firstObject ?: NSTemporaryDirectory();
+        return [[cacheDir stringByAppendingPathComponent:@"sherpaonnx_hotwords"] UTF8String];
     }
 }
 
+// Validates hotwordsFile and compiles it against the model tokens (cached by content and tokens).
+static HotwordsCompileResult CompileHotwords(const std::string& filePath, const std::string& tokensPath) {
+    HotwordsCompileOptions options;
+    options.tokensPath = tokensPath;
+    options.cacheDir = HotwordsCacheDir();
+    HotwordsCompileResult compiled = CompileHotwordsFile(filePath, options);
+    if (compiled.ok && compiled.oovLines > 0) {
+        LOGI("Hotwords: dropped %d line(s) not in the model tokens", compiled.oovLines);
+    }
+    return compiled;
+}
+
+// Registry key for a recognizer: every init option plus the model directory contents, so wrappers
+// share a recognizer only when they would have built an identical one.
+static std::string SttEngineKey(
+    const std::string& modelDir,
+    const std::optional<bool>& preferInt8,
+    const std::optional<std::string>& modelType,
+    bool debug,
+    const std::optional<std::string>& hotwordsFile,
+    const std::optional<float>& hotwordsScore,
+    const std::optional<int32_t>& numThreads,
+    const std::optional<std::string>& provider,
+    const std::optional<std::string>& ruleFsts,
+    const std::optional<std::string>& ruleFars,
+    const SttWhisperOptions* whisperOpts,
+    const SttSenseVoiceOptions* senseVoiceOpts,
+    const SttCanaryOptions* canaryOpts,
+    const SttFunAsrNanoOptions* funasrNanoOpts
+) {
+    std::ostringstream k;
+    auto put = [&k](const auto& opt) {
+        if (opt.has_value()) k << '=' << *opt;
+        k << '\x1f';
+    };
+    put(preferInt8); put(modelType); k << debug << '\x1f'; put(hotwordsFile); put(hotwordsScore);
+    put(numThreads); put(provider); put(ruleFsts); put(ruleFars);
+    k << "|w";
+    if (whisperOpts) { put(whisperOpts->language); put(whisperOpts->task); put(whisperOpts->tail_paddings); }
+    k << "|s";
+    if (senseVoiceOpts) { put(senseVoiceOpts->language); put(senseVoiceOpts->use_itn); }
+    k << "|c";
+    if (canaryOpts) { put(canaryOpts->src_lang); put(canaryOpts->tgt_lang); put(canaryOpts->use_pnc); }
+    k << "|f";
+    if (funasrNanoOpts) {
+        put(funasrNanoOpts->system_prompt); put(funasrNanoOpts->user_prompt); put(funasrNanoOpts->max_new_tokens);
+        put(funasrNanoOpts->temperature); put(funasrNanoOpts->top_p); put(funasrNanoOpts->seed);
+        put(funasrNanoOpts->language); put(funasrNanoOpts->itn); put(funasrNanoOpts->hotwords);
+    }
+    return TtsAudioCache::ModelFingerprint(modelDir, k.str()) + "|stt";
+}
+
 // PIMPL pattern implementation
 class SttWrapper::Impl {
 public:
     bool initialized = false;
     std::string modelDir;
     sherpaonnx::SttModelKind currentModelKind = sherpaonnx::SttModelKind::kUnknown;
-    std::optional<sherpa_onnx::cxx::OfflineRecognizer> recognizer;
+    using Registry = SharedEngineRegistry<sherpa_onnx::cxx::OfflineRecognizer>;
+    // Loaded recognizer, shared with every wrapper that loads the same model with the same init
+    // options (see SharedEngineRegistry). Use it only through EngineTurn.
+    Registry::Handle engine;
+    // This wrapper's decoding config and its settings id (0 = unchanged since init).
     std::optional<sherpa_onnx::cxx::OfflineRecognizerConfig> lastConfig;
+    uint64_t configId = 0;
+
+    sherpa_onnx::cxx::OfflineRecognizer& recognizer() { return engine->engine; }
+
+    // One decode's turn on the shared recognizer: queue behind other holders' requests in the
+    // engine's scheduler (FIFO at normal priority), lock it and apply this wrapper's config if
+    // another holder changed it.
+    class EngineTurn {
+    public:
+        explicit EngineTurn(Impl& impl)
+            : request_(impl.engine->scheduler, kRequestPriorityNormal),
+              slot_(impl.engine->scheduler, request_.id()),
+              lock_(impl.engine->mutex) {
+            if (impl.engine->appliedSettings != impl.configId) {
+                impl.recognizer().SetConfig(impl.lastConfig.value());
+                impl.engine->appliedSettings = impl.configId;
+            }
+        }
+
+    private:
+        ScopedEngineRequest request_;
+        ScopedEngineSlot slot_;
+        std::unique_lock<std::mutex> lock_;
+    };
+
+    // Decode a short synthetic clip so ORT allocations, kernel selection and first-touch page
+    // faults on mmapped weights happen now instead of on the first user request. Returns ms, or -1
+    // if the decode failed.
+    int64_t warmUp() {
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            std::vector<float> samples(8000, 0.0f);  // 0.5 s at 16 kHz, low-level noise
+            uint32_t seed = 12345;
+            for (float& s : samples) {
+                seed = seed * 1664525u + 1013904223u;
+                s = (static_cast<float>(seed >> 8) / 16777216.0f - 0.5f) * 1e-3f;
+            }
+            EngineTurn turn(*this);
+            auto stream = recognizer().CreateStream();
+            stream.AcceptWaveform(16000, samples.data(), static_cast<int32_t>(samples.size()));
+            recognizer().Decode(&stream);
+            (void)recognizer().GetResult(&stream);
+        } catch (const std::exception& e) {
+            LOGE("Warm-up decode failed (ignored): %s", e.what());
+            return -1;
+        } catch (...) {
+            LOGE("Warm-up decode failed (ignored)");
+            return -1;
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
 };
 
 SttWrapper::SttWrapper() : pImpl(std::make_unique<Impl>()) {
@@ -138,7 +199,8 @@ SttInitializeResult SttWrapper::initialize(
     const SttWhisperOptions* whisperOpts,
     const SttSenseVoiceOptions* senseVoiceOpts,
     const SttCanaryOptions* canaryOpts,
-    const SttFunAsrNanoOptions* funasrNanoOpts
+    const SttFunAsrNanoOptions* funasrNanoOpts,
+    bool warmUp
 ) {
     SttInitializeResult result;
     result.success = false;
@@ -158,7 +220,10 @@ SttInitializeResult SttWrapper::initialize(
         config.feat_config.sample_rate = 16000;
         config.feat_config.feature_dim = 80;
 
+        const auto detectStart = std::chrono::steady_clock::now();
         auto detect = DetectSttModel(modelDir, preferInt8, modelType, debug);
+        result.detectMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - detectStart).count();
         if (!detect.ok) {
             result.error = detect.error;
             LOGE("%s", result.error.c_str());
@@ -301,10 +366,10 @@ SttInitializeResult SttWrapper::initialize(
                 LOGE("%s", result.error.c_str());
                 return result;
             }
-            auto validateErr = ValidateHotwordsFile(*hotwordsFile);
-            if (validateErr.has_value()) {
+            result.hotwords = CompileHotwords(*hotwordsFile, config.model_config.tokens);
+            if (!result.hotwords->ok) {
                 result.success = false;
-                result.error = "INVALID_HOTWORDS_FILE: " + *validateErr;
+                result.error = "INVALID_HOTWORDS_FILE: " + result.hotwords->error;
                 LOGE("%s", result.error.c_str());
                 return result;
             }
@@ -313,8 +378,8 @@ SttInitializeResult SttWrapper::initialize(
         config.decoding_method = "greedy_search";
         config.model_config.num_threads = numThreads.value_or(1);
         config.model_config.provider = provider.value_or("cpu");
-        if (hotwordsFile.has_value() && !hotwordsFile->empty()) {
-            config.hotwords_file = *hotwordsFile;
+        if (result.hotwords.has_value()) {
+            config.hotwords_file = result.hotwords->compiledPath;
             config.decoding_method = "modified_beam_search";
             config.max_active_paths = std::max(4, config.max_active_paths);
         }
@@ -335,8 +400,23 @@ SttInitializeResult SttWrapper::initialize(
         } else {
             LOGI("Initializing non-Whisper model");
         }
+        bool reused = false;
+        const auto createStart = std::chrono::steady_clock::now();
         try {
-            pImpl->recognizer = sherpa_onnx::cxx::OfflineRecognizer::Create(config);
+            // The compiled file is content-keyed, so an edited hotwords file gets its own recognizer.
+            const std::optional<std::string> hotwordsKey =
+                result.hotwords.has_value() ? std::optional<std::string>(result.hotwords->compiledPath) : hotwordsFile;
+            const std::string engineKey = SttEngineKey(
+                modelDir, preferInt8, modelType, debug, hotwordsKey, hotwordsScore, numThreads, provider,
+                ruleFsts, ruleFars, whisperOpts, senseVoiceOpts, canaryOpts, funasrNanoOpts);
+            pImpl->engine = Impl::Registry::Global().Acquire(
+                engineKey,
+                [&config]() -> std::optional<sherpa_onnx::cxx::OfflineRecognizer> {
+                    auto recognizer = sherpa_onnx::cxx::OfflineRecognizer::Create(config);
+                    if (recognizer.Get() == nullptr) return std::nullopt;
+                    return recognizer;
+                },
+                &reused);
         } catch (const std::exception& e) {
             LOGE("Failed to create recognizer: %s", e.what());
             result.success = false;
@@ -348,8 +428,18 @@ SttInitializeResult SttWrapper::initialize(
             result.error = "INIT_ERROR: Unknown exception during recognizer creation";
             return result;
         }
+        if (!pImpl->engine) {
+            LOGE("Failed to create recognizer");
+            result.error = "INIT_ERROR: Failed to create recognizer";
+            return result;
+        }
+        result.createMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - createStart).count();
+        result.sharedEngine = reused;
+        if (reused) LOGI("Reusing recognizer already loaded by another instance");
 
         pImpl->lastConfig = config;
+        pImpl->configId = 0;
         pImpl->modelDir = modelDir;
         pImpl->currentModelKind = detect.selectedKind;
         pImpl->initialized = true;
@@ -358,6 +448,13 @@ SttInitializeResult SttWrapper::initialize(
         result.detectedModels = detect.detectedModels;
         result.modelType = detect.detectedModels.empty() ? "" : detect.detectedModels[0].type;
         result.decodingMethod = config.decoding_method;
+        // A reused recognizer is already warm.
+        if (warmUp && !reused) {
+            result.warmUpMs = pImpl->warmUp();
+            if (result.warmUpMs >= 0) {
+                LOGI("Warm-up decode took %lld ms", static_cast<long long>(result.warmUpMs));
+            }
+        }
         return result;
     } catch (const std::exception& e) {
         result.error = std::string("Exception during initialization: ") + e.what();
@@ -371,21 +468,34 @@ SttInitializeResult SttWrapper::initialize(
 }
 
 namespace {
-SttRecognitionResult offlineResultToSttResult(const sherpa_onnx::cxx::OfflineRecognizerResult& r) {
+// Moves only the fields in the SttResultField mask out of the recognizer result; text always.
+SttRecognitionResult offlineResultToSttResult(sherpa_onnx::cxx::OfflineRecognizerResult&& r, uint32_t fields) {
     SttRecognitionResult out;
-    out.text = r.text;
-    out.tokens = r.tokens;
-    out.timestamps = r.timestamps;
-    out.lang = r.lang;
-    out.emotion = r.emotion;
-    out.event = r.event;
-    out.durations = r.durations;
+    out.text = std::move(r.text);
+    if (fields & kSttResultTokens) out.tokens = std::move(r.tokens);
+    if (fields & kSttResultTimestamps) out.timestamps = std::move(r.timestamps);
+    if (fields & kSttResultLang) out.lang = std::move(r.lang);
+    if (fields & kSttResultEmotion) out.emotion = std::move(r.emotion);
+    if (fields & kSttResultEvent) out.event = std::move(r.event);
+    if (fields & kSttResultDurations) out.durations = std::move(r.durations);
     return out;
 }
+
+// WAV samples through the memory-mapped WavFileReader (no whole-file byte copy next to the
+// floats); encodings it does not parse fall back to ReadWave.
+sherpa_onnx::cxx::Wave ReadWaveSamples(const std::string& path) {
+    sherpa_onnx::cxx::Wave wave;
+    int32_t sampleRate = 0;
+    if (ReadWavFileMono(path, &wave.samples, &sampleRate, nullptr)) {
+        wave.sample_rate = sampleRate;
+        return wave;
+    }
+    return sherpa_onnx::cxx::ReadWave(path);
+}
 }  // namespace
 
-SttRecognitionResult SttWrapper::transcribeFile(const std::string& filePath) {
-    if (!pImpl->initialized || !pImpl->recognizer.has_value()) {
+SttRecognitionResult SttWrapper::transcribeFile(const std::string& filePath, uint32_t resultFields) {
+    if (!pImpl->initialized || !pImpl->engine) {
         LOGE("Not initialized. Call initialize() first.");
         throw std::runtime_error("STT not initialized. Call initialize() first.");
     }
@@ -402,7 +512,7 @@ SttRecognitionResult SttWrapper::transcribeFile(const std::string& filePath) {
 
     sherpa_onnx::cxx::Wave wave;
     try {
-        wave = sherpa_onnx::cxx::ReadWave(filePath);
+        wave = ReadWaveSamples(filePath);
     } catch (const std::exception& e) {
         LOGE("Transcribe: ReadWave failed: %s", e.what());
         throw;
@@ -417,7 +527,8 @@ SttRecognitionResult SttWrapper::transcribeFile(const std::string& filePath) {
     }
 
     try {
-        auto stream = pImpl->recognizer.value().CreateStream();
+        Impl::EngineTurn turn(*pImpl);
+        auto stream = pImpl->recognizer().CreateStream();
 
         // Ensure safe conversions: AcceptWaveform expects 32-bit ints
         if (wave.samples.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
@@ -436,9 +547,8 @@ SttRecognitionResult SttWrapper::transcribeFile(const std::string& filePath) {
         int32_t n_samples = static_cast<int32_t>(wave.samples.size());
 
         stream.AcceptWaveform(sample_rate, wave.samples.data(), n_samples);
-        pImpl->recognizer.value().Decode(&stream);
-        auto result = pImpl->recognizer.value().GetResult(&stream);
-        return offlineResultToSttResult(result);
+        pImpl->recognizer().Decode(&stream);
+        return offlineResultToSttResult(pImpl->recognizer().GetResult(&stream), resultFields);
     } catch (const std::exception& e) {
         LOGE("Transcribe: recognition failed: %s", e.what());
         throw;
@@ -450,26 +560,46 @@ SttRecognitionResult SttWrapper::transcribeFile(const std::string& filePath) {
     }
 }
 
-SttRecognitionResult SttWrapper::transcribeSamples(const std::vector<float>& samples, int32_t sampleRate) {
-    if (!pImpl->initialized || !pImpl->recognizer.has_value()) {
+SttRecognitionResult SttWrapper::transcribeSamples(const std::vector<float>& samples, int32_t sampleRate,
+                                                   uint32_t resultFields) {
+    return transcribeSamples(samples.data(), samples.size(), sampleRate, resultFields);
+}
+
+SttRecognitionResult SttWrapper::transcribeSamples(const int16_t* samples, size_t count, int32_t sampleRate,
+                                                   uint32_t resultFields) {
+    return transcribePcm(samples, count * sizeof(int16_t), PcmEncoding::kInt16, sampleRate, resultFields);
+}
+
+SttRecognitionResult SttWrapper::transcribePcm(const void* data, size_t bytes, PcmEncoding encoding,
+                                               int32_t sampleRate, uint32_t resultFields) {
+    if (encoding == PcmEncoding::kFloat32 && reinterpret_cast<uintptr_t>(data) % alignof(float) == 0) {
+        return transcribeSamples(static_cast<const float*>(data), bytes / sizeof(float), sampleRate, resultFields);
+    }
+    std::vector<float> samples(bytes / PcmBytesPerSample(encoding));
+    PcmBytesToFloat(data, bytes, encoding, samples.data());
+    return transcribeSamples(samples.data(), samples.size(), sampleRate, resultFields);
+}
+
+SttRecognitionResult SttWrapper::transcribeSamples(const float* samples, size_t count, int32_t sampleRate,
+                                                   uint32_t resultFields) {
+    if (!pImpl->initialized || !pImpl->engine) {
         LOGE("Not initialized. Call initialize() first.");
         throw std::runtime_error("STT not initialized. Call initialize() first.");
     }
-    if (samples.empty()) {
+    if (samples == nullptr || count == 0) {
         SttRecognitionResult empty;
         return empty;
     }
-    if (samples.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
-        LOGE("Samples too large: %zu", samples.size());
+    if (count > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        LOGE("Samples too large: %zu", count);
         throw std::runtime_error("Samples array too large to process");
     }
     try {
-        auto stream = pImpl->recognizer.value().CreateStream();
-        int32_t n = static_cast<int32_t>(samples.size());
-        stream.AcceptWaveform(sampleRate, samples.data(), n);
-        pImpl->recognizer.value().Decode(&stream);
-        auto result = pImpl->recognizer.value().GetResult(&stream);
-        return offlineResultToSttResult(result);
+        Impl::EngineTurn turn(*pImpl);
+        auto stream = pImpl->recognizer().CreateStream();
+        stream.AcceptWaveform(sampleRate, samples, static_cast<int32_t>(count));
+        pImpl->recognizer().Decode(&stream);
+        return offlineResultToSttResult(pImpl->recognizer().GetResult(&stream), resultFields);
     } catch (const std::exception& e) {
         LOGE("TranscribeSamples: recognition failed: %s", e.what());
         throw;
@@ -479,26 +609,370 @@ SttRecognitionResult SttWrapper::transcribeSamples(const std::vector<float>& sam
     }
 }
 
+namespace {
+
+// A transcribeFiles input after reading; error is set when wave is unusable.
+struct SttBatchInput {
+    sherpa_onnx::cxx::Wave wave;
+    std::string error;
+};
+
+bool IsWavFile(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    char header[12];
+    if (!f.read(header, sizeof(header))) return false;
+    return std::memcmp(header, "RIFF", 4) == 0 && std::memcmp(header + 8, "WAVE", 4) == 0;
+}
+
+SttBatchInput LoadBatchInput(const std::string& path, const SttWavConverter& converter) {
+    SttBatchInput input;
+    std::error_code ec;
+    if (!fs::exists(path, ec) || fs::file_size(path, ec) == 0) {
+        input.error = "Audio file does not exist or is empty: " + path;
+        return input;
+    }
+    std::string pathToRead = path;
+    std::string tempPath;
+    if (!IsWavFile(path)) {
+        if (!converter) {
+            input.error = "Not a WAV file: " + path;
+            return input;
+        }
+        static std::atomic<uint64_t> counter{0};
+        tempPath = (fs::temp_directory_path(ec) /
+                    ("stt_batch_" + std::to_string(++counter) + ".wav")).string();
+        const std::string err = converter(path, tempPath);
+        if (!err.empty()) {
+            fs::remove(tempPath, ec);
+            input.error = "Could not convert " + path + " to WAV: " + err;
+            return input;
+        }
+        pathToRead = tempPath;
+    }
+    try {
+        input.wave = ReadWaveSamples(pathToRead);
+    } catch (const std::exception& e) {
+        input.error = e.what();
+    } catch (...) {
+        input.error = "Failed to read audio file: " + path;
+    }
+    if (!tempPath.empty()) fs::remove(tempPath, ec);
+    if (input.error.empty() && (input.wave.samples.empty() || input.wave.sample_rate == 0 ||
+                                input.wave.samples.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))) {
+        input.error = "Audio file is empty or could not be read: " + path;
+    }
+    return input;
+}
+
+}  // namespace
+
+SttBatchStats SttWrapper::transcribeFiles(
+    const std::vector<std::string>& paths,
+    const SttBatchOptions& options,
+    int32_t ioThreads,
+    const SttWavConverter& converter,
+    const std::function<void(const SttBatchItem&)>& onItem,
+    uint32_t resultFields) {
+    if (!pImpl->initialized || !pImpl->engine) {
+        LOGE("Not initialized. Call initialize() first.");
+        throw std::runtime_error("STT not initialized. Call initialize() first.");
+    }
+    std::vector<double> seconds(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) seconds[i] = EstimateAudioFileSeconds(paths[i]);
+    const SttBatchPlan plan = PlanSttBatches(seconds, options);
+    const size_t workers = static_cast<size_t>(std::max<int32_t>(1, ioThreads));
+
+    // Reads one batch on up to `workers` threads; the future is ready when all files are.
+    auto loadBatch = [&](const std::vector<size_t>& batch) {
+        return std::async(std::launch::async, [&paths, &converter, batch, workers]() {
+            std::vector<SttBatchInput> inputs(batch.size());
+            std::vector<std::future<void>> tasks;
+            const size_t n = std::min(workers, batch.size());
+            for (size_t w = 0; w < n; ++w) {
+                tasks.push_back(std::async(std::launch::async, [&, w]() {
+                    for (size_t k = w; k < batch.size(); k += n) {
+                        inputs[k] = LoadBatchInput(paths[batch[k]], converter);
+                    }
+                }));
+            }
+            for (auto& task : tasks) task.get();
+            return inputs;
+        });
+    };
+
+    SttBatchStats stats;
+    stats.batches = plan.size();
+    std::future<std::vector<SttBatchInput>> pending;
+    if (!plan.empty()) pending = loadBatch(plan[0]);
+    for (size_t b = 0; b < plan.size(); ++b) {
+        const std::vector<size_t>& batch = plan[b];
+        std::vector<SttBatchInput> inputs = pending.get();
+        // Read the next batch while this one decodes.
+        if (b + 1 < plan.size()) pending = loadBatch(plan[b + 1]);
+
+        std::vector<SttBatchItem> items(batch.size());
+        std::vector<size_t> ready;
+        for (size_t k = 0; k < batch.size(); ++k) {
+            items[k].index = batch[k];
+            items[k].path = paths[batch[k]];
+            items[k].error = inputs[k].error;
+            if (inputs[k].error.empty()) ready.push_back(k);
+        }
+        if (!ready.empty()) {
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                Impl::EngineTurn turn(*pImpl);
+                std::vector<sherpa_onnx::cxx::OfflineStream> streams;
+                streams.reserve(ready.size());
+                for (size_t k : ready) {
+                    const auto& wave = inputs[k].wave;
+                    streams.push_back(pImpl->recognizer().CreateStream());
+                    streams.back().AcceptWaveform(static_cast<int32_t>(wave.sample_rate), wave.samples.data(),
+                                                  static_cast<int32_t>(wave.samples.size()));
+                }
+                pImpl->recognizer().Decode(streams.data(), static_cast<int32_t>(streams.size()));
+                for (size_t j = 0; j < ready.size(); ++j) {
+                    const auto& wave = inputs[ready[j]].wave;
+                    items[ready[j]].result = offlineResultToSttResult(pImpl->recognizer().GetResult(&streams[j]), resultFields);
+                    stats.audioMs += 1000.0 * static_cast<double>(wave.samples.size()) / wave.sample_rate;
+                }
+            } catch (const std::exception& e) {
+                LOGE("TranscribeFiles: batch %zu failed: %s", b, e.what());
+                for (size_t k : ready) items[k].error = e.what();
+            } catch (...) {
+                LOGE("TranscribeFiles: batch %zu failed (unknown exception)", b);
+                for (size_t k : ready) items[k].error = "Recognition failed.";
+            }
+            stats.decodeMs += std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+        for (const auto& item : items) onItem(item);
+    }
+    return stats;
+}
+
+SttLongFormResult SttWrapper::transcribeLongFile(
+    const std::string& path,
+    const SttLongFormOptions& options,
+    const SttWavConverter& converter,
+    const std::function<void(const SttLongFormSegment&)>& onSegment) {
+    if (!pImpl->initialized || !pImpl->engine) {
+        LOGE("Not initialized. Call initialize() first.");
+        throw std::runtime_error("STT not initialized. Call initialize() first.");
+    }
+    std::error_code ec;
+    if (options.vadModel.empty() || !fs::is_regular_file(options.vadModel, ec)) {
+        throw std::runtime_error("VAD model not found: " + options.vadModel);
+    }
+    if (!fs::is_regular_file(path, ec)) throw std::runtime_error("Audio file does not exist: " + path);
+
+    constexpr int32_t kSampleRate = 16000;
+    // The VAD runs at 16 kHz; anything else (other rates, compressed formats) is converted once.
+    WavFileReader scanReader;
+    std::string pathToRead = path;
+    std::string tempPath;
+    if (!scanReader.Open(path) || scanReader.SampleRate() != kSampleRate) {
+        if (!converter) throw std::runtime_error(scanReader.Error().empty() ? "Not a 16 kHz WAV file: " + path : scanReader.Error());
+        static std::atomic<uint64_t> counter{0};
+        tempPath = (fs::temp_directory_path(ec) / ("stt_long_" + std::to_string(++counter) + ".wav")).string();
+        const std::string err = converter(path, tempPath);
+        if (!err.empty()) {
+            fs::remove(tempPath, ec);
+            throw std::runtime_error("Could not convert " + path + " to WAV: " + err);
+        }
+        pathToRead = tempPath;
+        if (!scanReader.Open(pathToRead)) {
+            fs::remove(tempPath, ec);
+            throw std::runtime_error(scanReader.Error());
+        }
+    }
+    struct TempFile {
+        std::string path;
+        ~TempFile() {
+            std::error_code e;
+            if (!path.empty()) fs::remove(path, e);
+        }
+    } temp{tempPath};
+
+    std::string vadType = options.vadType;
+    if (vadType.empty()) {
+        std::string name = fs::path(options.vadModel).filename().string();
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        vadType = name.find("ten") != std::string::npos ? "ten" : "silero";
+    }
+    sherpa_onnx::cxx::VadModelConfig vadConfig;
+    if (vadType == "ten") {
+        vadConfig.ten_vad.model = options.vadModel;
+        vadConfig.ten_vad.threshold = options.threshold;
+        vadConfig.ten_vad.min_silence_duration = options.minSilenceDuration;
+        vadConfig.ten_vad.min_speech_duration = options.minSpeechDuration;
+        vadConfig.ten_vad.window_size = 256;
+        vadConfig.ten_vad.max_speech_duration = options.maxSegmentSeconds;
+    } else if (vadType == "silero") {
+        vadConfig.silero_vad.model = options.vadModel;
+        vadConfig.silero_vad.threshold = options.threshold;
+        vadConfig.silero_vad.min_silence_duration = options.minSilenceDuration;
+        vadConfig.silero_vad.min_speech_duration = options.minSpeechDuration;
+        vadConfig.silero_vad.window_size = 512;
+        vadConfig.silero_vad.max_speech_duration = options.maxSegmentSeconds;
+    } else {
+        throw std::runtime_error("Unsupported vadType: " + vadType + " (expected \"silero\" or \"ten\")");
+    }
+    vadConfig.sample_rate = kSampleRate;
+    vadConfig.num_threads = std::max<int32_t>(1, options.vadThreads);
+    // The VAD buffers the current segment's audio; leave room for the longest one.
+    auto vad = sherpa_onnx::cxx::VoiceActivityDetector::Create(
+        vadConfig, std::max(60.0f, 2.0f * options.maxSegmentSeconds));
+    if (!vad.Get()) throw std::runtime_error("Failed to create VAD from " + options.vadModel);
+
+    WavFileReader rangeReader;
+    if (!rangeReader.Open(pathToRead)) throw std::runtime_error(rangeReader.Error());
+    const int64_t totalFrames = scanReader.NumFrames();
+    SpeechRangeOptions rangeOptions;
+    rangeOptions.paddingSamples = static_cast<int64_t>(options.paddingMs * kSampleRate / 1000.0);
+    rangeOptions.maxRangeSamples = static_cast<int64_t>(options.maxSegmentSeconds * kSampleRate);
+    SpeechRangeBuilder builder(rangeOptions);
+    const size_t maxBatch = static_cast<size_t>(std::max<int32_t>(1, options.maxBatchSize));
+
+    SttLongFormResult out;
+    std::vector<SpeechRange> window;
+    std::future<std::vector<SttLongFormSegment>> inFlight;
+    double decodeMs = 0.0;
+
+    // Runs on the worker thread; only that thread touches rangeReader and decodeMs.
+    auto decodeBatch = [this, &rangeReader, &decodeMs, totalFrames](std::vector<SpeechRange> ranges) {
+        std::vector<SttLongFormSegment> segments(ranges.size());
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            std::vector<std::vector<float>> audio(ranges.size());
+            for (size_t k = 0; k < ranges.size(); ++k) {
+                audio[k].resize(static_cast<size_t>(ranges[k].end - ranges[k].start));
+                const int64_t got = rangeReader.ReadMono(ranges[k].start, static_cast<int64_t>(audio[k].size()), audio[k].data());
+                if (got < 0) throw std::runtime_error("Failed to read audio samples");
+                audio[k].resize(static_cast<size_t>(got));
+            }
+            Impl::EngineTurn turn(*pImpl);
+            std::vector<sherpa_onnx::cxx::OfflineStream> streams;
+            streams.reserve(ranges.size());
+            for (const auto& samples : audio) {
+                streams.push_back(pImpl->recognizer().CreateStream());
+                streams.back().AcceptWaveform(kSampleRate, samples.data(), static_cast<int32_t>(samples.size()));
+            }
+            pImpl->recognizer().Decode(streams.data(), static_cast<int32_t>(streams.size()));
+            for (size_t k = 0; k < ranges.size(); ++k) {
+                segments[k].result = offlineResultToSttResult(pImpl->recognizer().GetResult(&streams[k]), options.resultFields);
+            }
+        } catch (const std::exception& e) {
+            LOGE("TranscribeLongFile: batch failed: %s", e.what());
+            for (auto& segment : segments) segment.error = e.what();
+        } catch (...) {
+            LOGE("TranscribeLongFile: batch failed (unknown exception)");
+            for (auto& segment : segments) segment.error = "Recognition failed.";
+        }
+        for (size_t k = 0; k < ranges.size(); ++k) {
+            segments[k].start = static_cast<double>(ranges[k].start) / kSampleRate;
+            segments[k].end = static_cast<double>(ranges[k].end) / kSampleRate;
+            segments[k].progress = totalFrames > 0 ? static_cast<double>(ranges[k].end) / totalFrames : 1.0;
+        }
+        decodeMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return segments;
+    };
+    auto collect = [&]() {
+        if (!inFlight.valid()) return;
+        for (auto& segment : inFlight.get()) {
+            segment.index = out.segments.size();
+            onSegment(segment);
+            out.segments.push_back(std::move(segment));
+        }
+    };
+    auto submit = [&](size_t count) {
+        std::vector<SpeechRange> batch(window.begin(), window.begin() + count);
+        window.erase(window.begin(), window.begin() + count);
+        // At most one batch decoding while the next is collected: bounded memory.
+        collect();
+        inFlight = std::async(std::launch::async, decodeBatch, std::move(batch));
+    };
+    auto enqueue = [&](const std::vector<SpeechRange>& ranges) {
+        window.insert(window.end(), ranges.begin(), ranges.end());
+        while (window.size() >= maxBatch) submit(maxBatch);
+    };
+    auto drainVad = [&]() {
+        while (!vad.IsEmpty()) {
+            const sherpa_onnx::cxx::SpeechSegment segment = vad.Front();
+            vad.Pop();
+            enqueue(builder.Push(segment.start, static_cast<int64_t>(segment.samples.size())));
+        }
+    };
+
+    try {
+        std::vector<float> block(kSampleRate);
+        for (int64_t position = 0; position < totalFrames;) {
+            const int64_t got = scanReader.ReadMono(position, kSampleRate, block.data());
+            if (got < 0) throw std::runtime_error("Failed to read audio samples: " + path);
+            if (got == 0) break;
+            const auto vadStart = std::chrono::steady_clock::now();
+            vad.AcceptWaveform(block.data(), static_cast<int32_t>(got));
+            out.vadMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - vadStart).count();
+            position += got;
+            drainVad();
+        }
+        vad.Flush();
+        drainVad();
+        enqueue(builder.Finish(totalFrames));
+        if (!window.empty()) submit(window.size());
+        collect();
+    } catch (...) {
+        // Let a running decode finish before its readers and recognizer turn go away.
+        if (inFlight.valid()) inFlight.wait();
+        throw;
+    }
+
+    std::vector<std::string> texts;
+    texts.reserve(out.segments.size());
+    for (const auto& segment : out.segments) {
+        out.speechMs += 1000.0 * (segment.end - segment.start);
+        if (!segment.error.empty()) {
+            ++out.failedSegments;
+            continue;
+        }
+        const SttRecognitionResult& r = segment.result;
+        const float offset = static_cast<float>(segment.start);
+        texts.push_back(r.text);
+        out.merged.tokens.insert(out.merged.tokens.end(), r.tokens.begin(), r.tokens.end());
+        for (float t : r.timestamps) out.merged.timestamps.push_back(t + offset);
+        out.merged.durations.insert(out.merged.durations.end(), r.durations.begin(), r.durations.end());
+        if (out.merged.lang.empty()) out.merged.lang = r.lang;
+        if (out.merged.emotion.empty()) out.merged.emotion = r.emotion;
+        if (out.merged.event.empty()) out.merged.event = r.event;
+    }
+    out.merged.text = JoinSegmentTexts(texts);
+    out.audioMs = 1000.0 * static_cast<double>(totalFrames) / kSampleRate;
+    out.decodeMs = decodeMs;
+    return out;
+}
+
 void SttWrapper::setConfig(const SttRuntimeConfigOptions& options) {
-    if (!pImpl->initialized || !pImpl->recognizer.has_value() || !pImpl->lastConfig.has_value()) {
+    if (!pImpl->initialized || !pImpl->engine || !pImpl->lastConfig.has_value()) {
         LOGE("Not initialized or no stored config.");
         throw std::runtime_error("STT not initialized. Call initialize() first.");
     }
-    auto& config = pImpl->lastConfig.value();
+    sherpa_onnx::cxx::OfflineRecognizerConfig config = pImpl->lastConfig.value();
     if (options.hotwords_file.has_value() && !options.hotwords_file->empty()) {
         if (!SupportsHotwords(pImpl->currentModelKind)) {
             LOGE("Hotwords are only supported for transducer models.");
             throw std::runtime_error("HOTWORDS_NOT_SUPPORTED: Hotwords are only supported for transducer models (transducer, nemo_transducer). Current model type is not transducer.");
         }
-        auto validateErr = ValidateHotwordsFile(*options.hotwords_file);
-        if (validateErr.has_value()) {
-            LOGE("%s", validateErr->c_str());
-            throw std::runtime_error("INVALID_HOTWORDS_FILE: " + *validateErr);
+        const HotwordsCompileResult compiled = CompileHotwords(*options.hotwords_file, config.model_config.tokens);
+        if (!compiled.ok) {
+            LOGE("%s", compiled.error.c_str());
+            throw std::runtime_error("INVALID_HOTWORDS_FILE: " + compiled.error);
         }
+        config.hotwords_file = compiled.compiledPath;
+    } else if (options.hotwords_file.has_value()) {
+        config.hotwords_file.clear();
     }
     if (options.decoding_method.has_value()) config.decoding_method = *options.decoding_method;
     if (options.max_active_paths.has_value()) config.max_active_paths = *options.max_active_paths;
-    if (options.hotwords_file.has_value()) config.hotwords_file = *options.hotwords_file;
     if (options.hotwords_score.has_value()) config.hotwords_score = *options.hotwords_score;
     if (options.blank_penalty.has_value()) config.blank_penalty = *options.blank_penalty;
     if (options.rule_fsts.has_value()) config.rule_fsts = *options.rule_fsts;
@@ -507,7 +981,11 @@ void SttWrapper::setConfig(const SttRuntimeConfigOptions& options) {
         config.decoding_method = "modified_beam_search";
         config.max_active_paths = std::max(4, config.max_active_paths);
     }
-    pImpl->recognizer.value().SetConfig(config);
+    // Applied now so errors surface here; other holders of the shared recognizer re-apply their own
+    // config before their next decode.
+    pImpl->lastConfig = config;
+    pImpl->configId = Impl::Registry::NextSettingsId();
+    { Impl::EngineTurn turn(*pImpl); }
 }
 
 bool SttWrapper::isInitialized() const {
@@ -516,8 +994,9 @@ bool SttWrapper::isInitialized() const {
 
 void SttWrapper::release() {
     if (pImpl->initialized) {
-        pImpl->recognizer.reset();
+        pImpl->engine.reset();
         pImpl->lastConfig.reset();
+        pImpl->configId = 0;
         pImpl->initialized = false;
         pImpl->modelDir.clear();
         pImpl->currentModelKind = sherpaonnx::SttModelKind::kUnknown;
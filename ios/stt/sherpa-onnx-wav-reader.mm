@@ -0,0 +1,307 @@
+/**
+ * sherpa-onnx-wav-reader.mm
+ *
+ * Purpose: Header parsing and seekable sample reads for WAV files, so long recordings can be
+ * processed a range at a time. The file is mmapped (POSIX) and each read converts one window at a
+ * time straight from the mapping, releasing the window's pages afterwards; elsewhere reads fall
+ * back to stdio blocks.
+ * Mirror of android/src/main/cpp/jni/stt/sherpa-onnx-wav-reader.cpp; keep in sync.
+ */
+#include "sherpa-onnx-wav-reader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define SHERPA_ONNX_WAV_MMAP 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SHERPA_ONNX_WAV_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SHERPA_ONNX_WAV_SSE2 1
+#endif
+
+namespace sherpaonnx {
+
+namespace {
+
+uint16_t ReadLe16(const unsigned char* p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t ReadLe32(const unsigned char* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+bool Seek(std::FILE* f, int64_t offset, int whence) {
+#if defined(_WIN32)
+  return _fseeki64(f, offset, whence) == 0;
+#else
+  return fseeko(f, static_cast<off_t>(offset), whence) == 0;
+#endif
+}
+
+int64_t Tell(std::FILE* f) {
+#if defined(_WIN32)
+  return _ftelli64(f);
+#else
+  return static_cast<int64_t>(ftello(f));
+#endif
+}
+
+// Frames converted per window (256 KiB of mono float output).
+constexpr int64_t kBlockFrames = 64 * 1024;
+
+constexpr float kInt16Scale = 1.0f / 32768.0f;
+
+#if defined(SHERPA_ONNX_WAV_MMAP)
+// Drop the whole pages of [begin, begin + bytes) from this process: the mapping is read-only, so
+// they are simply faulted in again from the page cache if read a second time.
+void ReleasePages(const unsigned char* begin, size_t bytes) {
+  static const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const uintptr_t first = (reinterpret_cast<uintptr_t>(begin) + page - 1) & ~(page - 1);
+  const uintptr_t last = (reinterpret_cast<uintptr_t>(begin) + bytes) & ~(page - 1);
+  if (last > first) madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+}
+#endif
+
+}  // namespace
+
+void Int16ToFloat(const int16_t* in, float* out, size_t n) {
+  size_t i = 0;
+#if defined(SHERPA_ONNX_WAV_NEON)
+  const float32x4_t scale = vdupq_n_f32(kInt16Scale);
+  for (; i + 8 <= n; i += 8) {
+    const int16x8_t v = vld1q_s16(in + i);
+    vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+    vst1q_f32(out + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+  }
+#elif defined(SHERPA_ONNX_WAV_SSE2)
+  const __m128 scale = _mm_set1_ps(kInt16Scale);
+  for (; i + 8 <= n; i += 8) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    // Interleave with itself and shift right arithmetically: sign-extends each int16 to int32.
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+#endif
+  for (; i < n; ++i) out[i] = static_cast<float>(in[i]) * kInt16Scale;
+}
+
+bool ParsePcmEncoding(const std::string& name, PcmEncoding* encoding) {
+  if (name == "int16" || name == "s16le") {
+    *encoding = PcmEncoding::kInt16;
+    return true;
+  }
+  if (name == "float32" || name == "f32le") {
+    *encoding = PcmEncoding::kFloat32;
+    return true;
+  }
+  return false;
+}
+
+size_t PcmBytesPerSample(PcmEncoding encoding) { return encoding == PcmEncoding::kFloat32 ? 4 : 2; }
+
+size_t PcmBytesToFloat(const void* data, size_t bytes, PcmEncoding encoding, float* out) {
+  const size_t n = bytes / PcmBytesPerSample(encoding);
+  if (n == 0) return 0;
+  if (encoding == PcmEncoding::kFloat32) {
+    std::memcpy(out, data, n * sizeof(float));
+    return n;
+  }
+  if (reinterpret_cast<uintptr_t>(data) % alignof(int16_t) == 0) {
+    Int16ToFloat(static_cast<const int16_t*>(data), out, n);
+    return n;
+  }
+  // Unaligned input (e.g. an odd offset into a byte buffer): realign through a small stack window.
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  int16_t window[4096];
+  for (size_t done = 0; done < n;) {
+    const size_t count = std::min(n - done, sizeof(window) / sizeof(window[0]));
+    std::memcpy(window, p + done * 2, count * 2);
+    Int16ToFloat(window, out + done, count);
+    done += count;
+  }
+  return n;
+}
+
+WavFileReader::~WavFileReader() { Close(); }
+
+void WavFileReader::Close() {
+  if (file_) std::fclose(file_);
+  file_ = nullptr;
+#if defined(SHERPA_ONNX_WAV_MMAP)
+  if (mapped_) munmap(mapped_, mappedSize_);
+#endif
+  mapped_ = nullptr;
+  mappedSize_ = 0;
+  sampleRate_ = 0;
+  numChannels_ = 0;
+  bitsPerSample_ = 0;
+  isFloat_ = false;
+  dataOffset_ = 0;
+  numFrames_ = 0;
+}
+
+bool WavFileReader::Open(const std::string& path) {
+  Close();
+  error_.clear();
+  file_ = std::fopen(path.c_str(), "rb");
+  if (!file_) {
+    error_ = "Cannot open " + path;
+    return false;
+  }
+  Seek(file_, 0, SEEK_END);
+  const int64_t fileSize = Tell(file_);
+  Seek(file_, 0, SEEK_SET);
+
+  unsigned char riff[12];
+  if (std::fread(riff, 1, sizeof(riff), file_) != sizeof(riff) || std::memcmp(riff, "RIFF", 4) != 0 ||
+      std::memcmp(riff + 8, "WAVE", 4) != 0) {
+    error_ = "Not a WAV file: " + path;
+    Close();
+    return false;
+  }
+
+  bool haveFormat = false;
+  unsigned char header[8];
+  while (std::fread(header, 1, sizeof(header), file_) == sizeof(header)) {
+    const uint32_t size = ReadLe32(header + 4);
+    if (std::memcmp(header, "fmt ", 4) == 0 && size >= 16) {
+      unsigned char fmt[40] = {0};
+      const size_t toRead = std::min<size_t>(size, sizeof(fmt));
+      if (std::fread(fmt, 1, toRead, file_) != toRead) break;
+      uint16_t formatTag = ReadLe16(fmt);
+      numChannels_ = ReadLe16(fmt + 2);
+      sampleRate_ = static_cast<int32_t>(ReadLe32(fmt + 4));
+      bitsPerSample_ = ReadLe16(fmt + 14);
+      // WAVE_FORMAT_EXTENSIBLE: the real format is the first two bytes of the sub-format GUID.
+      if (formatTag == 0xFFFE && toRead >= 26) formatTag = ReadLe16(fmt + 24);
+      isFloat_ = formatTag == 3;
+      haveFormat = (formatTag == 1 && (bitsPerSample_ == 8 || bitsPerSample_ == 16 || bitsPerSample_ == 24 ||
+                                       bitsPerSample_ == 32)) ||
+                   (isFloat_ && bitsPerSample_ == 32);
+      if (!Seek(file_, static_cast<int64_t>(size - toRead + (size & 1)), SEEK_CUR)) break;
+    } else if (std::memcmp(header, "data", 4) == 0) {
+      if (!haveFormat || numChannels_ <= 0 || sampleRate_ <= 0) break;
+      dataOffset_ = Tell(file_);
+      const int64_t available = std::max<int64_t>(0, fileSize - dataOffset_);
+      // Streaming writers leave 0 or 0xFFFFFFFF until finalized; use the rest of the file then.
+      const int64_t dataSize =
+          (size == 0 || size == 0xFFFFFFFFu) ? available : std::min<int64_t>(size, available);
+      numFrames_ = dataSize / (static_cast<int64_t>(numChannels_) * (bitsPerSample_ / 8));
+#if defined(SHERPA_ONNX_WAV_MMAP)
+      if (fileSize > 0 && static_cast<uint64_t>(fileSize) <= SIZE_MAX) {
+        void* map = mmap(nullptr, static_cast<size_t>(fileSize), PROT_READ, MAP_PRIVATE, fileno(file_), 0);
+        if (map != MAP_FAILED) {
+          mapped_ = static_cast<unsigned char*>(map);
+          mappedSize_ = static_cast<size_t>(fileSize);
+          madvise(mapped_, mappedSize_, MADV_SEQUENTIAL);
+          // The mapping keeps the file alive; stdio is only the fallback.
+          std::fclose(file_);
+          file_ = nullptr;
+        }
+      }
+#endif
+      return true;
+    } else if (!Seek(file_, static_cast<int64_t>(size) + (size & 1), SEEK_CUR)) {
+      break;
+    }
+  }
+  error_ = haveFormat ? "WAV file has no data chunk: " + path : "Unsupported WAV encoding: " + path;
+  Close();
+  return false;
+}
+
+void WavFileReader::ConvertFrames(const unsigned char* p, int64_t frames, float* out) const {
+  const int64_t bytesPerSample = bitsPerSample_ / 8;
+  if (bytesPerSample == 2 && numChannels_ == 1 && !isFloat_) {
+    // The common case (16 kHz mono recordings). All supported ABIs are little-endian, and RIFF
+    // pads chunks to even sizes, so the samples are 2-byte aligned in the mapping.
+    Int16ToFloat(reinterpret_cast<const int16_t*>(p), out, static_cast<size_t>(frames));
+    return;
+  }
+  const float channelScale = 1.0f / static_cast<float>(numChannels_);
+  for (int64_t i = 0; i < frames; ++i) {
+    float sum = 0.0f;
+    for (int32_t c = 0; c < numChannels_; ++c, p += bytesPerSample) {
+      float v;
+      if (isFloat_) {
+        std::memcpy(&v, p, sizeof(v));
+      } else if (bytesPerSample == 2) {
+        v = static_cast<float>(static_cast<int16_t>(ReadLe16(p))) * kInt16Scale;
+      } else if (bytesPerSample == 1) {
+        v = (static_cast<float>(p[0]) - 128.0f) / 128.0f;
+      } else if (bytesPerSample == 3) {
+        const int32_t s = static_cast<int32_t>(static_cast<uint32_t>(p[0]) << 8 | static_cast<uint32_t>(p[1]) << 16 |
+                                               static_cast<uint32_t>(p[2]) << 24) >> 8;
+        v = static_cast<float>(s) / 8388608.0f;
+      } else {
+        v = static_cast<float>(static_cast<int32_t>(ReadLe32(p))) / 2147483648.0f;
+      }
+      sum += v;
+    }
+    out[i] = numChannels_ == 1 ? sum : sum * channelScale;
+  }
+}
+
+int64_t WavFileReader::ReadMono(int64_t start, int64_t n, float* out) {
+  if (!IsOpen() || start < 0 || n <= 0 || start >= numFrames_) return 0;
+  n = std::min(n, numFrames_ - start);
+  const int64_t frameBytes = static_cast<int64_t>(bitsPerSample_ / 8) * numChannels_;
+
+#if defined(SHERPA_ONNX_WAV_MMAP)
+  if (mapped_) {
+    const unsigned char* src = mapped_ + dataOffset_ + start * frameBytes;
+    for (int64_t done = 0; done < n; done += kBlockFrames) {
+      const int64_t frames = std::min(kBlockFrames, n - done);
+      const unsigned char* window = src + done * frameBytes;
+      ConvertFrames(window, frames, out + done);
+      ReleasePages(window, static_cast<size_t>(frames * frameBytes));
+    }
+    return n;
+  }
+#endif
+
+  if (!Seek(file_, dataOffset_ + start * frameBytes, SEEK_SET)) return -1;
+  int64_t done = 0;
+  while (done < n) {
+    const int64_t frames = std::min(kBlockFrames, n - done);
+    buffer_.resize(static_cast<size_t>(frames * frameBytes));
+    const size_t got = std::fread(buffer_.data(), 1, buffer_.size(), file_);
+    const int64_t gotFrames = static_cast<int64_t>(got) / frameBytes;
+    ConvertFrames(buffer_.data(), gotFrames, out + done);
+    done += gotFrames;
+    if (gotFrames < frames) return std::ferror(file_) ? -1 : done;
+  }
+  return done;
+}
+
+bool ReadWavFileMono(const std::string& path, std::vector<float>* samples, int32_t* sampleRate,
+                     std::string* error) {
+  WavFileReader reader;
+  if (!reader.Open(path)) {
+    if (error) *error = reader.Error();
+    return false;
+  }
+  samples->assign(static_cast<size_t>(reader.NumFrames()), 0.0f);
+  const int64_t got = reader.ReadMono(0, reader.NumFrames(), samples->data());
+  if (got < 0) {
+    if (error) *error = "Failed to read audio samples: " + path;
+    samples->clear();
+    return false;
+  }
+  samples->resize(static_cast<size_t>(got));
+  if (sampleRate) *sampleRate = reader.SampleRate();
+  return true;
+}
+
+}  // namespace sherpaonnx
@@ -0,0 +1,100 @@
+/**
+ * sherpa-onnx-tts-audio-cache.h
+ *
+ * Declares TtsAudioCache: a cache of synthesized TTS audio keyed by (model fingerprint, text, sid,
+ * speed, generation params). In-memory LRU bounded in bytes, with an optional on-disk tier that
+ * stores 16-bit PCM in a small self-describing file per entry. Thread-safe. Shared by the Android
+ * TTS helper (via JNI) and the iOS TtsWrapper (mirrored in ios/tts).
+ */
+#ifndef SHERPA_ONNX_TTS_AUDIO_CACHE_H
+#define SHERPA_ONNX_TTS_AUDIO_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sherpaonnx {
+
+class TtsAudioCache {
+ public:
+  struct Options {
+    /** Memory budget for cached samples (float32). 0 disables the memory tier. */
+    size_t maxMemoryBytes = 16u << 20;
+    /** Directory for the disk tier; empty disables it. Created if missing. */
+    std::string diskDir;
+    /** Disk budget; oldest files are removed when exceeded. */
+    size_t maxDiskBytes = 64u << 20;
+  };
+
+  struct Stats {
+    uint64_t memoryHits = 0;
+    uint64_t diskHits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;
+    size_t memoryBytes = 0;
+    size_t memoryEntries = 0;
+    size_t diskBytes = 0;
+  };
+
+  using Samples = std::shared_ptr<const std::vector<float>>;
+
+  TtsAudioCache();
+  explicit TtsAudioCache(const Options& options);
+
+  /** Apply new budgets / disk directory; evicts immediately if over budget. */
+  void Configure(const Options& options);
+  Options GetOptions() const;
+
+  /** Build a cache key. params carries any other generation options that affect the audio. */
+  static std::string MakeKey(const std::string& modelFingerprint, const std::string& text,
+                             int32_t sid, float speed, const std::string& params = "");
+
+  /**
+   * Fingerprint of a loaded model: model directory, the files in it (name, size, mtime) and a
+   * serialized init config (model type, scales, threads...). Changes whenever any of them change.
+   */
+  static std::string ModelFingerprint(const std::string& modelDir, const std::string& config);
+
+  /** Look up key in memory, then on disk (promoting disk hits to memory). */
+  bool Get(const std::string& key, Samples* samples, int32_t* sampleRate);
+
+  /** Insert audio for key (memory and, if enabled, disk). Empty audio is not cached. */
+  void Put(const std::string& key, std::vector<float> samples, int32_t sampleRate);
+
+  /** Drop all memory entries and optionally the disk tier. Stats counters are kept. */
+  void Clear(bool includeDisk);
+
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    Samples samples;
+    int32_t sampleRate = 0;
+    size_t bytes = 0;
+  };
+
+  void InsertMemoryLocked(const std::string& key, Samples samples, int32_t sampleRate);
+  void EvictMemoryLocked(size_t budget);
+  bool ReadDisk(const std::string& key, std::vector<float>* samples, int32_t* sampleRate);
+  void WriteDisk(const std::string& key, const std::vector<float>& samples, int32_t sampleRate);
+  void EnforceDiskBudget(const std::string& dir, size_t budget);
+  std::string DiskPath(const std::string& dir, const std::string& key) const;
+
+  mutable std::mutex mutex_;
+  Options options_;
+  std::list<Entry> lru_;  // front = most recently used
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  Stats stats_;
+  std::mutex diskMutex_;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_TTS_AUDIO_CACHE_H
@@ -0,0 +1,343 @@
+/**
+ * sherpa-onnx-tts-audio-cache.mm
+ *
+ * Purpose: In-memory LRU + on-disk cache of synthesized TTS audio. Disk entries are one file per
+ * key (name = 64-bit hash of the key) holding a small header, the full key (verified on read, so
+ * hash collisions are misses) and 16-bit PCM samples.
+ * Mirror of android/src/main/cpp/jni/tts/sherpa-onnx-tts-audio-cache.cpp; keep in sync.
+ */
+#include "sherpa-onnx-tts-audio-cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace sherpaonnx {
+
+namespace {
+
+constexpr char kDiskMagic[4] = {'S', 'T', 'A', 'C'};
+constexpr uint32_t kDiskVersion = 1;
+constexpr const char* kDiskSuffix = ".stac";
+
+struct DiskHeader {
+  char magic[4];
+  uint32_t version;
+  int32_t sampleRate;
+  uint32_t keyLength;
+  uint64_t numSamples;
+};
+
+uint64_t Fnv1a64(const void* data, size_t n, uint64_t h = 1469598103934665603ULL) {
+  const auto* p = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < n; ++i) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+std::string Hex64(uint64_t v) {
+  char buf[17];
+  std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(v));
+  return buf;
+}
+
+size_t EntryBytes(const std::string& key, const std::vector<float>& samples) {
+  return samples.size() * sizeof(float) + key.size();
+}
+
+}  // namespace
+
+TtsAudioCache::TtsAudioCache() = default;
+
+TtsAudioCache::TtsAudioCache(const Options& options) {
+  Configure(options);
+}
+
+void TtsAudioCache::Configure(const Options& options) {
+  std::string diskDir;
+  size_t maxDiskBytes = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    options_ = options;
+    EvictMemoryLocked(options_.maxMemoryBytes);
+    diskDir = options_.diskDir;
+    maxDiskBytes = options_.maxDiskBytes;
+  }
+  if (!diskDir.empty()) {
+    std::error_code ec;
+    fs::create_directories(diskDir, ec);
+    EnforceDiskBudget(diskDir, maxDiskBytes);
+  }
+}
+
+TtsAudioCache::Options TtsAudioCache::GetOptions() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return options_;
+}
+
+std::string TtsAudioCache::MakeKey(const std::string& modelFingerprint, const std::string& text,
+                                   int32_t sid, float speed, const std::string& params) {
+  char numbers[64];
+  std::snprintf(numbers, sizeof(numbers), "%d\x1f%.4f", sid, static_cast<double>(speed));
+  std::string key;
+  key.reserve(modelFingerprint.size() + text.size() + params.size() + 32);
+  key.append(modelFingerprint).append(1, '\x1f');
+  key.append(numbers).append(1, '\x1f');
+  key.append(params).append(1, '\x1f');
+  key.append(text);
+  return key;
+}
+
+std::string TtsAudioCache::ModelFingerprint(const std::string& modelDir, const std::string& config) {
+  uint64_t h = Fnv1a64(modelDir.data(), modelDir.size());
+  h = Fnv1a64("\x1f", 1, h);
+  h = Fnv1a64(config.data(), config.size(), h);
+
+  std::vector<std::string> files;
+  std::error_code ec;
+  for (fs::directory_iterator it(modelDir, ec), end; !ec && it != end; it.increment(ec)) {
+    std::error_code fec;
+    if (!it->is_regular_file(fec)) continue;
+    const auto size = it->file_size(fec);
+    const auto mtime = it->last_write_time(fec).time_since_epoch().count();
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "\x1f%llu\x1f%lld", static_cast<unsigned long long>(size),
+                  static_cast<long long>(mtime));
+    files.push_back(it->path().filename().string() + buf);
+  }
+  std::sort(files.begin(), files.end());
+  for (const auto& f : files) h = Fnv1a64(f.data(), f.size(), h);
+  return Hex64(h);
+}
+
+bool TtsAudioCache::Get(const std::string& key, Samples* samples, int32_t* sampleRate) {
+  std::string diskDir;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      if (samples) *samples = it->second->samples;
+      if (sampleRate) *sampleRate = it->second->sampleRate;
+      ++stats_.memoryHits;
+      return true;
+    }
+    diskDir = options_.diskDir;
+  }
+
+  std::vector<float> loaded;
+  int32_t loadedRate = 0;
+  if (!diskDir.empty() && ReadDisk(key, &loaded, &loadedRate)) {
+    auto shared = std::make_shared<const std::vector<float>>(std::move(loaded));
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.diskHits;
+    InsertMemoryLocked(key, shared, loadedRate);
+    if (samples) *samples = shared;
+    if (sampleRate) *sampleRate = loadedRate;
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.misses;
+  return false;
+}
+
+void TtsAudioCache::Put(const std::string& key, std::vector<float> samples, int32_t sampleRate) {
+  if (samples.empty() || sampleRate <= 0) return;
+  auto shared = std::make_shared<const std::vector<float>>(std::move(samples));
+  bool toDisk = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.insertions;
+    InsertMemoryLocked(key, shared, sampleRate);
+    toDisk = !options_.diskDir.empty();
+  }
+  if (toDisk) WriteDisk(key, *shared, sampleRate);
+}
+
+void TtsAudioCache::Clear(bool includeDisk) {
+  std::string diskDir;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    stats_.memoryBytes = 0;
+    stats_.memoryEntries = 0;
+    diskDir = options_.diskDir;
+  }
+  if (includeDisk && !diskDir.empty()) EnforceDiskBudget(diskDir, 0);
+}
+
+TtsAudioCache::Stats TtsAudioCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void TtsAudioCache::InsertMemoryLocked(const std::string& key, Samples samples, int32_t sampleRate) {
+  const size_t bytes = EntryBytes(key, *samples);
+  if (bytes > options_.maxMemoryBytes) return;  // too large (or memory tier disabled)
+
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    stats_.memoryBytes -= it->second->bytes;
+    --stats_.memoryEntries;
+    lru_.erase(it->second);
+    index_.erase(it);
+  }
+  EvictMemoryLocked(options_.maxMemoryBytes - bytes);
+  lru_.push_front(Entry{key, std::move(samples), sampleRate, bytes});
+  index_[key] = lru_.begin();
+  stats_.memoryBytes += bytes;
+  ++stats_.memoryEntries;
+}
+
+void TtsAudioCache::EvictMemoryLocked(size_t budget) {
+  while (!lru_.empty() && stats_.memoryBytes > budget) {
+    const Entry& victim = lru_.back();
+    stats_.memoryBytes -= victim.bytes;
+    --stats_.memoryEntries;
+    ++stats_.evictions;
+    index_.erase(victim.key);
+    lru_.pop_back();
+  }
+}
+
+std::string TtsAudioCache::DiskPath(const std::string& dir, const std::string& key) const {
+  return (fs::path(dir) / (Hex64(Fnv1a64(key.data(), key.size())) + kDiskSuffix)).string();
+}
+
+bool TtsAudioCache::ReadDisk(const std::string& key, std::vector<float>* samples, int32_t* sampleRate) {
+  std::string dir = GetOptions().diskDir;
+  std::lock_guard<std::mutex> diskLock(diskMutex_);
+  const std::string path = DiskPath(dir, key);
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return false;
+  std::error_code ec;
+  const uint64_t fileSize = fs::file_size(path, ec);
+  if (ec) return false;
+
+  // A truncated, corrupt or foreign file is dropped: its header must describe exactly this file
+  // before numSamples is trusted to size a buffer.
+  auto discard = [&]() {
+    in.close();
+    fs::remove(path, ec);
+    return false;
+  };
+  DiskHeader header{};
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return discard();
+  if (std::memcmp(header.magic, kDiskMagic, 4) != 0 || header.version != kDiskVersion) return discard();
+  if (header.sampleRate <= 0 || header.numSamples > fileSize / sizeof(int16_t) ||
+      sizeof(header) + header.keyLength + header.numSamples * sizeof(int16_t) != fileSize) {
+    return discard();
+  }
+  if (header.keyLength != key.size()) return false;
+
+  std::string storedKey(header.keyLength, '\0');
+  if (!in.read(&storedKey[0], header.keyLength) || storedKey != key) return false;
+
+  std::vector<int16_t> pcm(static_cast<size_t>(header.numSamples));
+  if (!in.read(reinterpret_cast<char*>(pcm.data()),
+               static_cast<std::streamsize>(pcm.size() * sizeof(int16_t)))) {
+    return false;
+  }
+  samples->resize(pcm.size());
+  for (size_t i = 0; i < pcm.size(); ++i) (*samples)[i] = static_cast<float>(pcm[i]) / 32767.0f;
+  *sampleRate = header.sampleRate;
+
+  // Refresh mtime so the disk tier evicts least recently used files first.
+  fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+  return true;
+}
+
+void TtsAudioCache::WriteDisk(const std::string& key, const std::vector<float>& samples, int32_t sampleRate) {
+  Options opts = GetOptions();
+  if (opts.diskDir.empty()) return;
+  size_t written = 0;
+  {
+    std::lock_guard<std::mutex> diskLock(diskMutex_);
+    const std::string path = DiskPath(opts.diskDir, key);
+    const std::string tmp = path + ".tmp";
+    {
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      if (!out) return;
+      DiskHeader header{};
+      std::memcpy(header.magic, kDiskMagic, 4);
+      header.version = kDiskVersion;
+      header.sampleRate = sampleRate;
+      header.keyLength = static_cast<uint32_t>(key.size());
+      header.numSamples = samples.size();
+      out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      out.write(key.data(), static_cast<std::streamsize>(key.size()));
+      std::vector<int16_t> pcm(samples.size());
+      for (size_t i = 0; i < samples.size(); ++i) {
+        const float clamped = std::max(-1.0f, std::min(1.0f, samples[i]));
+        pcm[i] = static_cast<int16_t>(std::lround(clamped * 32767.0f));
+      }
+      out.write(reinterpret_cast<const char*>(pcm.data()),
+                static_cast<std::streamsize>(pcm.size() * sizeof(int16_t)));
+      if (!out) {
+        out.close();
+        std::remove(tmp.c_str());
+        return;
+      }
+      written = sizeof(header) + key.size() + pcm.size() * sizeof(int16_t);
+    }
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    if (ec) {
+      fs::remove(tmp, ec);
+      return;
+    }
+  }
+
+  bool overBudget = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.diskBytes += written;
+    overBudget = stats_.diskBytes > opts.maxDiskBytes;
+  }
+  if (overBudget) EnforceDiskBudget(opts.diskDir, opts.maxDiskBytes);
+}
+
+void TtsAudioCache::EnforceDiskBudget(const std::string& dir, size_t budget) {
+  struct FileInfo {
+    fs::path path;
+    uintmax_t size;
+    fs::file_time_type mtime;
+  };
+  std::vector<FileInfo> files;
+  size_t total = 0;
+  {
+    std::lock_guard<std::mutex> diskLock(diskMutex_);
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+      if (it->path().extension() != kDiskSuffix) continue;
+      std::error_code fec;
+      FileInfo info{it->path(), it->file_size(fec), it->last_write_time(fec)};
+      if (fec) continue;
+      total += static_cast<size_t>(info.size);
+      files.push_back(std::move(info));
+    }
+    if (total > budget) {
+      std::sort(files.begin(), files.end(),
+                [](const FileInfo& a, const FileInfo& b) { return a.mtime < b.mtime; });
+      for (const auto& f : files) {
+        if (total <= budget) break;
+        std::error_code rec;
+        if (fs::remove(f.path, rec)) total -= static_cast<size_t>(f.size);
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.diskBytes = total;
+}
+
+}  // namespace sherpaonnx
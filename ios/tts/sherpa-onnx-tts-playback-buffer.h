@@ -0,0 +1,116 @@
+/**
+ * sherpa-onnx-tts-playback-buffer.h
+ *
+ * Declares TtsPlaybackBuffer: the jitter buffer between TTS generation and the platform audio
+ * sink (AudioTrack / AVAudioEngine). Chunks of any size go in; the sink pulls fixed device-sized
+ * frames. Shared by the Android JNI and the iOS bridge (mirrored in ios/tts).
+ */
+#ifndef SHERPA_ONNX_TTS_PLAYBACK_BUFFER_H
+#define SHERPA_ONNX_TTS_PLAYBACK_BUFFER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace sherpaonnx {
+
+struct PlaybackBufferConfig {
+  int32_t sampleRate = 24000;
+  /** Samples the sink pulls at a time (device buffer size). */
+  int32_t frameSamples = 480;
+  /** Fill level to reach before (re)starting playback; adapted between min and max. */
+  int32_t initialTargetMs = 100;
+  int32_t minTargetMs = 40;
+  int32_t maxTargetMs = 600;
+  /** Target change per underrun (up) or per relaxAfterMs of clean playback (down). */
+  int32_t adaptStepMs = 40;
+  int32_t relaxAfterMs = 3000;
+  /**
+   * A buffer that ran dry counts as an underrun only if audio resumes within this long; otherwise
+   * the utterance simply ended (writers that cannot call MarkEnd()).
+   */
+  int32_t endGapMs = 1000;
+  int32_t capacityMs = 10000;
+};
+
+struct PlaybackBufferStats {
+  uint64_t samplesIn = 0;
+  uint64_t samplesOut = 0;
+  uint64_t framesOut = 0;
+  /** Frames pulled while prefilling or dry (all silence). */
+  uint64_t silentFrames = 0;
+  /** Playback ran dry mid-utterance. */
+  uint64_t underruns = 0;
+  /** A Push() did not fit and the producer had to wait. */
+  uint64_t overruns = 0;
+  int32_t fillSamples = 0;
+  int32_t targetSamples = 0;
+  int32_t maxFillSamples = 0;
+  bool playing = false;
+};
+
+/**
+ * Thread-safe jitter buffer with an adaptive prefill target. Playback starts once the fill level
+ * reaches the target, after MarkEnd(), or when nothing arrived for the target's duration (so a
+ * short tail still plays). Running dry mid-utterance raises the target by one step; a long run
+ * without underruns lowers it again. Times are caller-supplied milliseconds on any monotonic clock.
+ */
+class TtsPlaybackBuffer {
+ public:
+  explicit TtsPlaybackBuffer(const PlaybackBufferConfig& config);
+
+  /** Append up to n samples; returns how many fit (less than n counts an overrun). */
+  int32_t Push(const float* samples, int32_t n, int64_t nowMs);
+
+  /**
+   * Block until at least min(n, capacity) samples fit, Close() is called, or timeoutMs passes.
+   * Returns false if closed.
+   */
+  bool WaitWritable(int32_t n, int32_t timeoutMs);
+
+  /**
+   * Fill out[0, n) for the sink: buffered audio, zero-padded when prefilling, dry or drained.
+   * Returns the number of audio (non-padding) samples. Never blocks on the producer.
+   */
+  int32_t Pull(float* out, int32_t n, int64_t nowMs);
+
+  /** End of the current utterance: play what is left without waiting for the target. */
+  void MarkEnd();
+  /** Drop buffered audio and return to prefilling (stop / cancel). */
+  void Clear();
+  /** Wake and refuse blocked writers (the sink is shutting down). */
+  void Close();
+
+  bool Drained() const;
+  PlaybackBufferStats GetStats() const;
+  const PlaybackBufferConfig& config() const { return config_; }
+
+ private:
+  int32_t MsToSamples(int32_t ms) const;
+  int32_t Free() const { return static_cast<int32_t>(ring_.size()) - fill_; }
+
+  PlaybackBufferConfig config_;
+  mutable std::mutex mutex_;
+  std::condition_variable writable_;
+  std::vector<float> ring_;
+  int32_t head_ = 0;
+  int32_t fill_ = 0;
+  int32_t target_ = 0;
+  int32_t minTarget_ = 0;
+  int32_t maxTarget_ = 0;
+  int32_t step_ = 0;
+  int64_t relaxSamples_ = 0;
+  int64_t cleanSamples_ = 0;
+  int64_t lastPushMs_ = 0;
+  int64_t dryAtMs_ = 0;
+  bool playing_ = false;
+  bool dry_ = false;
+  bool ended_ = false;
+  bool closed_ = false;
+  PlaybackBufferStats stats_;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_TTS_PLAYBACK_BUFFER_H
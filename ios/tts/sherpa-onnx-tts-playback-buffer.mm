@@ -0,0 +1,155 @@
+/**
+ * sherpa-onnx-tts-playback-buffer.mm
+ *
+ * Purpose: Jitter buffer and fixed-frame rechunker between TTS generation and the audio sink.
+ * Generation pushes irregular chunks; the sink's playback thread / render callback pulls frames.
+ * Mirror of android/src/main/cpp/jni/tts/sherpa-onnx-tts-playback-buffer.cpp; keep in sync.
+ */
+#include "sherpa-onnx-tts-playback-buffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace sherpaonnx {
+
+TtsPlaybackBuffer::TtsPlaybackBuffer(const PlaybackBufferConfig& config) : config_(config) {
+  if (config_.sampleRate <= 0) config_.sampleRate = 24000;
+  if (config_.frameSamples <= 0) config_.frameSamples = config_.sampleRate / 50;
+  config_.minTargetMs = std::max(config_.minTargetMs, 0);
+  config_.maxTargetMs = std::max(config_.maxTargetMs, config_.minTargetMs);
+  minTarget_ = MsToSamples(config_.minTargetMs);
+  maxTarget_ = MsToSamples(config_.maxTargetMs);
+  target_ = std::min(std::max(MsToSamples(config_.initialTargetMs), minTarget_), maxTarget_);
+  step_ = std::max(MsToSamples(config_.adaptStepMs), 1);
+  relaxSamples_ = std::max(MsToSamples(config_.relaxAfterMs), 1);
+  const int32_t capacity =
+      std::max(MsToSamples(config_.capacityMs), maxTarget_ + 2 * config_.frameSamples);
+  ring_.assign(static_cast<size_t>(capacity), 0.0f);
+  stats_.targetSamples = target_;
+}
+
+int32_t TtsPlaybackBuffer::MsToSamples(int32_t ms) const {
+  return static_cast<int32_t>(static_cast<int64_t>(ms) * config_.sampleRate / 1000);
+}
+
+int32_t TtsPlaybackBuffer::Push(const float* samples, int32_t n, int64_t nowMs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (dry_) {
+    // Audio resumed shortly after running dry: the sink starved mid-utterance.
+    if (nowMs - dryAtMs_ < config_.endGapMs) {
+      ++stats_.underruns;
+      target_ = std::min(target_ + step_, maxTarget_);
+    }
+    dry_ = false;
+  }
+  ended_ = false;
+  lastPushMs_ = nowMs;
+  if (n <= 0 || samples == nullptr) return 0;
+
+  const int32_t accepted = std::min(n, Free());
+  if (accepted < n) ++stats_.overruns;
+  const int32_t capacity = static_cast<int32_t>(ring_.size());
+  const int32_t tail = (head_ + fill_) % capacity;
+  const int32_t first = std::min(accepted, capacity - tail);
+  std::memcpy(ring_.data() + tail, samples, sizeof(float) * static_cast<size_t>(first));
+  std::memcpy(ring_.data(), samples + first, sizeof(float) * static_cast<size_t>(accepted - first));
+  fill_ += accepted;
+  stats_.samplesIn += static_cast<uint64_t>(accepted);
+  stats_.maxFillSamples = std::max(stats_.maxFillSamples, fill_);
+  return accepted;
+}
+
+bool TtsPlaybackBuffer::WaitWritable(int32_t n, int32_t timeoutMs) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const int32_t needed = std::min(n, static_cast<int32_t>(ring_.size()));
+  writable_.wait_for(lock, std::chrono::milliseconds(std::max(timeoutMs, 0)),
+                     [&] { return closed_ || Free() >= needed; });
+  return !closed_;
+}
+
+int32_t TtsPlaybackBuffer::Pull(float* out, int32_t n, int64_t nowMs) {
+  if (n <= 0 || out == nullptr) return 0;
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++stats_.framesOut;
+  if (!playing_) {
+    const int64_t targetMs = static_cast<int64_t>(target_) * 1000 / config_.sampleRate;
+    const bool ready =
+        fill_ > 0 && (fill_ >= target_ || ended_ || nowMs - lastPushMs_ >= targetMs);
+    if (!ready) {
+      std::fill(out, out + n, 0.0f);
+      ++stats_.silentFrames;
+      return 0;
+    }
+    playing_ = true;
+  }
+
+  const int32_t capacity = static_cast<int32_t>(ring_.size());
+  const int32_t taken = std::min(n, fill_);
+  const int32_t first = std::min(taken, capacity - head_);
+  std::memcpy(out, ring_.data() + head_, sizeof(float) * static_cast<size_t>(first));
+  std::memcpy(out + first, ring_.data(), sizeof(float) * static_cast<size_t>(taken - first));
+  std::fill(out + taken, out + n, 0.0f);
+  head_ = (head_ + taken) % capacity;
+  fill_ -= taken;
+  stats_.samplesOut += static_cast<uint64_t>(taken);
+
+  if (taken < n) {
+    // Ran dry: prefill again. Whether this was an underrun is decided by the next Push().
+    playing_ = false;
+    cleanSamples_ = 0;
+    if (taken == 0) ++stats_.silentFrames;
+    if (!ended_) {
+      dry_ = true;
+      dryAtMs_ = nowMs;
+    }
+  } else {
+    cleanSamples_ += taken;
+    if (cleanSamples_ >= relaxSamples_) {
+      target_ = std::max(target_ - step_, minTarget_);
+      cleanSamples_ = 0;
+    }
+  }
+  if (taken > 0) writable_.notify_all();
+  return taken;
+}
+
+void TtsPlaybackBuffer::MarkEnd() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ended_ = true;
+  dry_ = false;
+}
+
+void TtsPlaybackBuffer::Clear() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    head_ = fill_ = 0;
+    playing_ = dry_ = ended_ = false;
+    cleanSamples_ = 0;
+  }
+  writable_.notify_all();
+}
+
+void TtsPlaybackBuffer::Close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+  }
+  writable_.notify_all();
+}
+
+bool TtsPlaybackBuffer::Drained() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return ended_ && fill_ == 0;
+}
+
+PlaybackBufferStats TtsPlaybackBuffer::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  PlaybackBufferStats out = stats_;
+  out.fillSamples = fill_;
+  out.targetSamples = target_;
+  out.playing = playing_;
+  return out;
+}
+
+}  // namespace sherpaonnx
@@ -0,0 +1,190 @@
+/**
+ * sherpa-onnx-tts-time-stretch.mm
+ *
+ * Purpose: WSOLA time-scale modification for TTS output. A tempo change costs one windowed
+ * overlap-add and a short similarity search per 15 ms of output instead of a new synthesis.
+ * Mirror of android/src/main/cpp/jni/tts/sherpa-onnx-tts-time-stretch.cpp; keep in sync.
+ */
+#include "sherpa-onnx-tts-time-stretch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace sherpaonnx {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+}  // namespace
+
+WsolaTimeStretcher::WsolaTimeStretcher(int32_t sampleRate, float tempo) {
+  if (sampleRate <= 0) sampleRate = 16000;
+  frame_ = std::max(64, (sampleRate * 30 / 1000) & ~1);
+  hop_ = frame_ / 2;
+  tolerance_ = frame_ / 4;
+  // Periodic Hann: copies spaced hop_ = frame_ / 2 apart sum to exactly 1.
+  window_.resize(static_cast<size_t>(frame_));
+  for (int32_t i = 0; i < frame_; ++i) {
+    window_[static_cast<size_t>(i)] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * i / frame_));
+  }
+  SetTempo(tempo);
+  Reset();
+}
+
+void WsolaTimeStretcher::SetTempo(float tempo) {
+  if (!(tempo > 0.0f)) tempo = 1.0f;
+  tempo_.store(std::min(std::max(tempo, kMinTempo), kMaxTempo), std::memory_order_relaxed);
+}
+
+void WsolaTimeStretcher::Reset() {
+  // hop_ zeros in front so the first real sample is covered by two frames (window sum 1);
+  // the matching hop_ of output is skipped.
+  in_.assign(static_cast<size_t>(hop_), 0.0f);
+  inStart_ = 0;
+  anaPos_ = 0.0;
+  template_.assign(static_cast<size_t>(hop_), 0.0f);
+  haveTemplate_ = false;
+  ola_.assign(static_cast<size_t>(frame_), 0.0f);
+  out_.clear();
+  outRead_ = 0;
+  skip_ = hop_;
+  expectedOut_ = 0.0;
+  produced_ = 0;
+  flushed_ = false;
+}
+
+void WsolaTimeStretcher::Push(const float* samples, int32_t n) {
+  if (samples == nullptr || n <= 0) return;
+  if (flushed_) Reset();
+  in_.insert(in_.end(), samples, samples + n);
+  expectedOut_ += static_cast<double>(n) / tempo();
+  Process(false);
+}
+
+void WsolaTimeStretcher::Flush() {
+  Process(true);
+  flushed_ = true;
+  const int64_t expected = std::llround(expectedOut_);
+  if (produced_ > expected) {
+    const size_t excess = static_cast<size_t>(
+        std::min<int64_t>(produced_ - expected, static_cast<int64_t>(out_.size() - outRead_)));
+    out_.resize(out_.size() - excess);
+    produced_ -= static_cast<int64_t>(excess);
+  }
+}
+
+int32_t WsolaTimeStretcher::BestOffset(int64_t nominal) const {
+  const int64_t lo = std::max<int64_t>(-tolerance_, inStart_ - nominal);
+  const int64_t hi = tolerance_;
+  const float* t = template_.data();
+  auto score = [&](int64_t delta, int32_t stride) {
+    const float* x = in_.data() + (nominal + delta - inStart_);
+    double corr = 0.0;
+    double energy = 1e-9;
+    for (int32_t i = 0; i < hop_; i += stride) {
+      corr += static_cast<double>(x[i]) * t[i];
+      energy += static_cast<double>(x[i]) * x[i];
+    }
+    return corr / std::sqrt(energy);
+  };
+  // Coarse search on every other offset and sample, then refine around the winner.
+  int64_t best = lo;
+  double bestScore = -1e300;
+  for (int64_t delta = lo; delta <= hi; delta += 2) {
+    const double s = score(delta, 2);
+    if (s > bestScore) {
+      bestScore = s;
+      best = delta;
+    }
+  }
+  const int64_t coarse = best;
+  bestScore = -1e300;
+  for (int64_t delta = std::max(lo, coarse - 1); delta <= std::min(hi, coarse + 1); ++delta) {
+    const double s = score(delta, 1);
+    if (s > bestScore) {
+      bestScore = s;
+      best = delta;
+    }
+  }
+  return static_cast<int32_t>(best);
+}
+
+void WsolaTimeStretcher::Process(bool flushing) {
+  const int64_t expected = std::llround(expectedOut_);
+  while (true) {
+    if (flushing && produced_ >= expected) break;
+    const int64_t nominal = std::llround(anaPos_);
+    const int64_t needed = nominal + tolerance_ + frame_;
+    const int64_t have = inStart_ + static_cast<int64_t>(in_.size());
+    if (needed > have) {
+      if (!flushing) break;
+      in_.resize(static_cast<size_t>(needed - inStart_), 0.0f);
+    }
+
+    const int64_t start = haveTemplate_ ? nominal + BestOffset(nominal) : nominal;
+    const float* seg = in_.data() + (start - inStart_);
+    for (int32_t i = 0; i < frame_; ++i) ola_[static_cast<size_t>(i)] += window_[static_cast<size_t>(i)] * seg[i];
+
+    // The first hop_ of the accumulator is complete: no later frame reaches back that far.
+    for (int32_t i = 0; i < hop_; ++i) {
+      if (skip_ > 0) {
+        --skip_;
+        continue;
+      }
+      out_.push_back(ola_[static_cast<size_t>(i)]);
+      ++produced_;
+    }
+    std::memmove(ola_.data(), ola_.data() + hop_, sizeof(float) * static_cast<size_t>(frame_ - hop_));
+    std::fill(ola_.begin() + (frame_ - hop_), ola_.end(), 0.0f);
+
+    // What naturally follows this frame; the next frame start is chosen to resemble it.
+    std::memcpy(template_.data(), seg + hop_, sizeof(float) * static_cast<size_t>(hop_));
+    haveTemplate_ = true;
+    anaPos_ += hop_ * static_cast<double>(tempo());
+    CompactInput();
+  }
+}
+
+void WsolaTimeStretcher::CompactInput() {
+  const int64_t keepFrom = std::max<int64_t>(inStart_, std::llround(anaPos_) - tolerance_);
+  const int64_t drop = std::min<int64_t>(keepFrom - inStart_, static_cast<int64_t>(in_.size()));
+  // Erase in large steps only: a whole clip pushed at once must not be shifted every frame.
+  if (drop < 4 * frame_ || drop < static_cast<int64_t>(in_.size()) / 2) return;
+  in_.erase(in_.begin(), in_.begin() + drop);
+  inStart_ += drop;
+}
+
+int32_t WsolaTimeStretcher::Read(float* out, int32_t n) {
+  const int32_t count = std::min(n, Available());
+  if (count <= 0) return 0;
+  std::memcpy(out, out_.data() + outRead_, sizeof(float) * static_cast<size_t>(count));
+  outRead_ += static_cast<size_t>(count);
+  if (outRead_ == out_.size()) {
+    out_.clear();
+    outRead_ = 0;
+  }
+  return count;
+}
+
+void WsolaTimeStretcher::ReadAll(std::vector<float>* out) {
+  out->insert(out->end(), out_.begin() + static_cast<std::ptrdiff_t>(outRead_), out_.end());
+  out_.clear();
+  outRead_ = 0;
+}
+
+std::vector<float> WsolaTimeStretcher::Stretch(const float* samples, size_t n, int32_t sampleRate,
+                                               float tempo) {
+  if (samples == nullptr || n == 0) return {};
+  if (std::fabs(tempo - 1.0f) < 1e-4f) return std::vector<float>(samples, samples + n);
+  WsolaTimeStretcher stretcher(sampleRate, tempo);
+  std::vector<float> out;
+  out.reserve(static_cast<size_t>(static_cast<double>(n) / stretcher.tempo()) + 1);
+  stretcher.Push(samples, static_cast<int32_t>(n));
+  stretcher.Flush();
+  stretcher.ReadAll(&out);
+  return out;
+}
+
+}  // namespace sherpaonnx
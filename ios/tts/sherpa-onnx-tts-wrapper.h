@@ -2,6 +2,10 @@
 #define SHERPA_ONNX_TTS_WRAPPER_H
 
 #include "sherpa-onnx-common.h"
+#include "sherpa-onnx-engine-scheduler.h"
+#include "sherpa-onnx-tts-audio-cache.h"
+#include "sherpa-onnx-tts-stats.h"
+#include "sherpa-onnx-wav-writer.h"
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -17,6 +21,7 @@ namespace sherpaonnx {
 struct TtsInitializeResult {
     bool success;
     std::vector<DetectedModel> detectedModels;  // List of detected models with type and path
+    int64_t warmUpMs = -1;                       // Warm-up synthesis time; -1 if not requested
 };
 
 /**
@@ -39,12 +44,14 @@ public:
         const std::optional<std::string>& ruleFars = std::nullopt,
         const std::optional<int32_t>& maxNumSentences = std::nullopt,
         const std::optional<float>& silenceScale = std::nullopt,
-        const std::optional<std::string>& provider = std::nullopt
+        const std::optional<std::string>& provider = std::nullopt,
+        bool warmUp = false
     );
 
     struct AudioResult {
         std::vector<float> samples;  // Audio samples in range [-1.0, 1.0]
         int32_t sampleRate;          // Sample rate in Hz
+        TtsRequestStats stats;       // Timing of this request (also recorded in getStats())
     };
 
     using TtsStreamCallback = std::function<int32_t(
@@ -53,19 +60,118 @@ public:
         float progress
     )>;
 
+    /**
+     * Register a request with the engine's scheduler (the engine may be shared with other
+     * instances): priority is a RequestPriority, deadlineMs > 0 a deadline relative to now. Pass the
+     * ticket to generate* and call finishRequest() afterwards. Returns 0 when not initialized.
+     * The generate* methods take ticket 0 to run as an internal normal-priority request.
+     */
+    uint64_t submitRequest(int32_t priority, int64_t deadlineMs = 0);
+
+    /** Stop a submitted request, queued or running (at its next chunk). */
+    void cancelRequest(uint64_t ticket);
+
+    /** True when the request was cancelled or its deadline passed. */
+    bool requestStopped(uint64_t ticket) const;
+
+    /** Forget a request; returns the total time it waited for the engine, in ms. */
+    int64_t finishRequest(uint64_t ticket);
+
     AudioResult generate(
         const std::string& text,
         int32_t sid = 0,
-        float speed = 1.0f
+        float speed = 1.0f,
+        uint64_t ticket = 0
     );
 
+    /**
+     * Stream audio through callback (return 0 to cancel). firstChunkTargetMs > 0 enables the
+     * first-chunk fast path: a short leading clause, sized to meet that time-to-first-audio, is
+     * synthesized before the rest. timeToFirstAudioMs (optional) receives the measured time from
+     * the call to the first audio, or -1 if none was produced. The engine is held one piece at a
+     * time; batch-priority tickets are split into sentences so interactive requests can run between
+     * them. stats (optional) receives the request's measurements, which are also recorded in
+     * getStats().
+     */
     bool generateStream(
         const std::string& text,
         int32_t sid,
         float speed,
-        const TtsStreamCallback& callback
+        const TtsStreamCallback& callback,
+        int32_t firstChunkTargetMs = 0,
+        int64_t* timeToFirstAudioMs = nullptr,
+        uint64_t ticket = 0,
+        TtsRequestStats* stats = nullptr
     );
 
+    /**
+     * Stream audio straight into an open WavWriter on the generating thread (no intermediate
+     * buffer of the whole utterance). callback, if set, still sees every chunk and may cancel.
+     * The writer is not finalized; returns false if generation or a write fails.
+     */
+    bool generateStream(
+        const std::string& text,
+        int32_t sid,
+        float speed,
+        WavWriter* writer,
+        const TtsStreamCallback& callback = nullptr,
+        uint64_t ticket = 0,
+        TtsRequestStats* stats = nullptr
+    );
+
+    /**
+     * Long-text mode: split text into sentences and synthesize them on up to numEngines engine
+     * instances in parallel (extra engines are created on first use and kept until release()).
+     * Audio is reassembled in sentence order with silenceMs of silence between sentences.
+     */
+    AudioResult generateParallel(
+        const std::string& text,
+        int32_t sid,
+        float speed,
+        int32_t numEngines,
+        int32_t silenceMs = 0,
+        uint64_t ticket = 0
+    );
+
+    /**
+     * Streaming variant of generateParallel: callback receives audio in order as soon as each
+     * prefix of sentences is complete (progress = finished sentences / total). Return 0 to cancel.
+     * firstChunkTargetMs, timeToFirstAudioMs and stats as for generateStream; the leading clause
+     * runs on the first engine while the others start on the rest of the text.
+     */
+    bool generateParallelStream(
+        const std::string& text,
+        int32_t sid,
+        float speed,
+        int32_t numEngines,
+        int32_t silenceMs,
+        const TtsStreamCallback& callback,
+        int32_t firstChunkTargetMs = 0,
+        int64_t* timeToFirstAudioMs = nullptr,
+        uint64_t ticket = 0,
+        TtsRequestStats* stats = nullptr
+    );
+
+    /**
+     * Aggregate measurements (time to first chunk, synthesis time, RTF, chunk sizes, bytes handed
+     * out) over every generate* call on this wrapper since initialization or resetStats().
+     */
+    TtsStatsSnapshot getStats() const;
+
+    void resetStats();
+
+    /**
+     * Enable or reconfigure the synthesized-audio cache used by generate / generateStream /
+     * generateParallel*. maxMemoryBytes == 0 and an empty diskDir disable it. The cache survives
+     * re-initialization; entries are keyed by a fingerprint of the model files and init options.
+     */
+    void configureAudioCache(size_t maxMemoryBytes, const std::string& diskDir, size_t maxDiskBytes);
+
+    /** Cache counters and sizes (all zero when the cache is disabled). */
+    TtsAudioCache::Stats getAudioCacheStats() const;
+
+    void clearAudioCache(bool includeDisk);
+
     static bool saveToWavFile(
         const std::vector<float>& samples,
         int32_t sampleRate,
@@ -6,11 +6,16 @@
  */
 
 #include "sherpa-onnx-tts-wrapper.h"
+#include "sherpa-onnx-engine-registry.h"
 #include "sherpa-onnx-model-detect.h"
+#include "sherpa-onnx-tts-sentence-pipeline.h"
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <mutex>
 #include <optional>
 #include <sstream>
 
@@ -38,7 +43,112 @@ class TtsWrapper::Impl {
 public:
     bool initialized = false;
     std::string modelDir;
-    std::optional<sherpa_onnx::cxx::OfflineTts> tts;
+    // Loaded engine, shared with every wrapper that loads the same model with the same load config
+    // (see SharedEngineRegistry). Hold engine->mutex while generating with it.
+    SharedEngineRegistry<sherpa_onnx::cxx::OfflineTts>::Handle engine;
+    // Config used for the engine; extra engines for generateParallel are created from it on demand.
+    std::optional<sherpa_onnx::cxx::OfflineTtsConfig> config;
+    // A deque so growing the pool never moves engines already handed out by acquireEngines.
+    std::deque<sherpa_onnx::cxx::OfflineTts> enginePool;
+    std::mutex enginePoolMutex;
+    // Synthesized-audio cache (null = disabled) and the fingerprint of the loaded model for its keys.
+    std::shared_ptr<TtsAudioCache> audioCache;
+    std::string modelFingerprint;
+    mutable std::mutex audioCacheMutex;
+    // Sizes the leading clause of the streaming first-chunk fast path from measured TTFA.
+    FirstChunkPlanner firstChunkPlanner;
+    // Per-request measurements of every generate* call on this wrapper.
+    TtsStatsRecorder requestStats;
+
+    sherpa_onnx::cxx::OfflineTts& tts() { return engine->engine; }
+    EngineScheduler& scheduler() { return engine->scheduler; }
+
+    // Turns a caller's ticket (0 = none) into a request id, submitting a normal-priority request
+    // for the duration of the call when there is none.
+    class Request {
+    public:
+        Request(EngineScheduler& scheduler, uint64_t ticket) {
+            if (ticket == 0) owned_.emplace(scheduler, kRequestPriorityNormal);
+            id_ = ticket != 0 ? ticket : owned_->id();
+        }
+        uint64_t id() const { return id_; }
+
+    private:
+        std::optional<ScopedEngineRequest> owned_;
+        uint64_t id_ = 0;
+    };
+
+    static void logNotRun(EngineScheduler::Status status) {
+        LOGE("TTS: Request %s before it could run",
+             status == EngineScheduler::Status::kExpired ? "passed its deadline" : "was cancelled");
+    }
+
+    // Count a chunk handed to the caller (which copies it across the bridge).
+    static void handOut(TtsRequestTimer& timer, size_t numSamples) {
+        timer.OnChunk(numSamples);
+        timer.AddBytesCopied(numSamples * sizeof(float));
+    }
+
+    // Finish a request's measurements and add them to this wrapper's aggregate.
+    TtsRequestStats recordStats(TtsRequestTimer& timer, uint64_t totalSamples, int32_t sampleRate) {
+        TtsRequestStats stats = timer.Finish(totalSamples, sampleRate);
+        requestStats.Record(stats);
+        return stats;
+    }
+
+    static int64_t elapsedMs(std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - since).count();
+    }
+
+    std::shared_ptr<TtsAudioCache> cache() const {
+        std::lock_guard<std::mutex> lock(audioCacheMutex);
+        return audioCache;
+    }
+
+    // Cache key for a request, or empty when caching is disabled.
+    std::string cacheKey(const std::string& text, int32_t sid, float speed, const std::string& params = "") const {
+        std::lock_guard<std::mutex> lock(audioCacheMutex);
+        if (!audioCache || modelFingerprint.empty()) return std::string();
+        return TtsAudioCache::MakeKey(modelFingerprint, text, sid, speed, params);
+    }
+
+    // Synthesize a short phrase so ORT allocations, kernel selection and first-touch page faults
+    // on mmapped weights happen at init instead of on the first user request. Returns ms.
+    int64_t warmUp() {
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            std::lock_guard<std::mutex> lock(engine->mutex);
+            (void)tts().Generate("Hello.", 0, 1.0f);
+        } catch (const std::exception& e) {
+            LOGE("TTS: Warm-up synthesis failed (ignored): %s", e.what());
+        } catch (...) {
+            LOGE("TTS: Warm-up synthesis failed (ignored)");
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Ensure up to count extra engines exist. Returns the engines to use (the shared engine first;
+    // the caller holds its mutex). Extra engines are private to this wrapper.
+    std::vector<sherpa_onnx::cxx::OfflineTts*> acquireEngines(int32_t count) {
+        std::vector<sherpa_onnx::cxx::OfflineTts*> engines;
+        if (!engine) return engines;
+        engines.push_back(&tts());
+        std::lock_guard<std::mutex> lock(enginePoolMutex);
+        while (config.has_value() && static_cast<int32_t>(enginePool.size()) + 1 < count) {
+            auto extra = sherpa_onnx::cxx::OfflineTts::Create(config.value());
+            if (extra.Get() == nullptr) {
+                LOGE("TTS: Failed to create extra engine %zu for parallel generation", enginePool.size() + 1);
+                break;
+            }
+            enginePool.push_back(std::move(extra));
+        }
+        for (size_t i = 0; i < enginePool.size() && static_cast<int32_t>(engines.size()) < count; ++i) {
+            engines.push_back(&enginePool[i]);
+        }
+        return engines;
+    }
 };
 
 TtsWrapper::TtsWrapper() : pImpl(std::make_unique<Impl>()) {
@@ -62,7 +172,8 @@ TtsInitializeResult TtsWrapper::initialize(
     const std::optional<std::string>& ruleFars,
     const std::optional<int32_t>& maxNumSentences,
     const std::optional<float>& silenceScale,
-    const std::optional<std::string>& provider
+    const std::optional<std::string>& provider,
+    bool warmUp
 ) {
     TtsInitializeResult result;
     result.success = false;
@@ -167,20 +278,53 @@ TtsInitializeResult TtsWrapper::initialize(
             config.silence_scale = *silenceScale;
         }
 
-        LOGI("TTS: Creating OfflineTts instance...");
-        pImpl->tts = sherpa_onnx::cxx::OfflineTts::Create(config);
-
-        if (!pImpl->tts.has_value()) {
+        // Everything from init that changes the synthesized audio.
+        std::ostringstream fp;
+        fp << static_cast<int>(detect.selectedKind)
+           << '|' << noiseScale.value_or(-1.0f) << '|' << noiseScaleW.value_or(-1.0f)
+           << '|' << lengthScale.value_or(-1.0f) << '|' << ruleFsts.value_or("")
+           << '|' << ruleFars.value_or("") << '|' << maxNumSentences.value_or(0)
+           << '|' << silenceScale.value_or(-1.0f);
+        std::string fingerprint = TtsAudioCache::ModelFingerprint(modelDir, fp.str());
+
+        // Engine key adds the settings that only affect how the model is loaded.
+        const std::string engineKey = fingerprint + "|tts|" + std::to_string(config.model.num_threads) +
+            '|' + (debug ? "1" : "0") + '|' + config.model.provider;
+        bool reused = false;
+        pImpl->engine = SharedEngineRegistry<sherpa_onnx::cxx::OfflineTts>::Global().Acquire(
+            engineKey,
+            [&config]() -> std::optional<sherpa_onnx::cxx::OfflineTts> {
+                LOGI("TTS: Creating OfflineTts instance...");
+                auto tts = sherpa_onnx::cxx::OfflineTts::Create(config);
+                if (tts.Get() == nullptr) return std::nullopt;
+                return tts;
+            },
+            &reused);
+
+        if (!pImpl->engine) {
             LOGE("TTS: Failed to create OfflineTts instance");
             return result;
         }
+        if (reused) LOGI("TTS: Reusing OfflineTts already loaded by another instance");
 
         pImpl->initialized = true;
         pImpl->modelDir = modelDir;
+        pImpl->config = config;
+        {
+            std::lock_guard<std::mutex> lock(pImpl->audioCacheMutex);
+            pImpl->modelFingerprint = std::move(fingerprint);
+        }
 
         LOGI("TTS: Initialization successful");
-        LOGI("TTS: Sample rate: %d Hz", pImpl->tts.value().SampleRate());
-        LOGI("TTS: Number of speakers: %d", pImpl->tts.value().NumSpeakers());
+        LOGI("TTS: Sample rate: %d Hz", pImpl->tts().SampleRate());
+        LOGI("TTS: Number of speakers: %d", pImpl->tts().NumSpeakers());
+
+        // Pocket needs reference audio to synthesize anything, so it cannot be warmed up this way.
+        // A reused engine is already warm.
+        if (warmUp && !reused && detect.selectedKind != TtsModelKind::kPocket) {
+            result.warmUpMs = pImpl->warmUp();
+            LOGI("TTS: Warm-up synthesis took %lld ms", static_cast<long long>(result.warmUpMs));
+        }
 
         result.success = true;
         result.detectedModels = detect.detectedModels;
@@ -194,15 +338,34 @@ TtsInitializeResult TtsWrapper::initialize(
     }
 }
 
+uint64_t TtsWrapper::submitRequest(int32_t priority, int64_t deadlineMs) {
+    if (!pImpl->initialized || !pImpl->engine) return 0;
+    return pImpl->scheduler().Submit(priority, deadlineMs);
+}
+
+void TtsWrapper::cancelRequest(uint64_t ticket) {
+    if (pImpl->engine && ticket != 0) pImpl->scheduler().Cancel(ticket);
+}
+
+bool TtsWrapper::requestStopped(uint64_t ticket) const {
+    return pImpl->engine && ticket != 0 && pImpl->engine->scheduler.ShouldStop(ticket);
+}
+
+int64_t TtsWrapper::finishRequest(uint64_t ticket) {
+    if (!pImpl->engine || ticket == 0) return 0;
+    return pImpl->scheduler().Finish(ticket);
+}
+
 TtsWrapper::AudioResult TtsWrapper::generate(
     const std::string& text,
     int32_t sid,
-    float speed
+    float speed,
+    uint64_t ticket
 ) {
     AudioResult result;
     result.sampleRate = 0;
 
-    if (!pImpl->initialized || !pImpl->tts.has_value()) {
+    if (!pImpl->initialized || !pImpl->engine) {
         LOGE("TTS: Not initialized. Call initialize() first.");
         return result;
     }
@@ -213,16 +376,53 @@ TtsWrapper::AudioResult TtsWrapper::generate(
     }
 
     try {
+        TtsRequestTimer timer;
+        const std::string key = pImpl->cacheKey(text, sid, speed);
+        auto cache = pImpl->cache();
+        TtsAudioCache::Samples cached;
+        if (!key.empty() && cache && cache->Get(key, &cached, &result.sampleRate)) {
+            result.samples = *cached;
+            LOGI("TTS: Audio cache hit (%zu samples)", result.samples.size());
+            Impl::handOut(timer, result.samples.size());
+            result.stats = pImpl->recordStats(timer, result.samples.size(), result.sampleRate);
+            return result;
+        }
+
         LOGI("TTS: Generating speech for text: %s (sid=%d, speed=%.2f)",
              text.c_str(), sid, speed);
 
-        auto audio = pImpl->tts.value().Generate(text, sid, speed);
-
-        result.samples = std::move(audio.samples);
-        result.sampleRate = audio.sample_rate;
+        Impl::Request request(pImpl->scheduler(), ticket);
+        EngineScheduler& scheduler = pImpl->scheduler();
+        // Batch work gives the engine back after every sentence so interactive requests get in.
+        std::vector<std::string> pieces{text};
+        if (scheduler.PriorityOf(request.id()) == kRequestPriorityBatch) {
+            std::vector<std::string> sentences = SplitSentences(text);
+            if (sentences.size() > 1) pieces = std::move(sentences);
+        }
+        for (const std::string& piece : pieces) {
+            ScopedEngineSlot slot(scheduler, request.id());
+            if (!slot.ok()) {
+                Impl::logNotRun(slot.status());
+                result.samples.clear();
+                result.sampleRate = 0;
+                return result;
+            }
+            timer.OnEngineAcquired();
+            auto audio = [&] {
+                std::lock_guard<std::mutex> lock(pImpl->engine->mutex);
+                return pImpl->tts().Generate(piece, sid, speed);
+            }();
+            result.samples.insert(result.samples.end(), audio.samples.begin(), audio.samples.end());
+            result.sampleRate = audio.sample_rate;
+        }
 
         LOGI("TTS: Generated %zu samples at %d Hz",
              result.samples.size(), result.sampleRate);
+        Impl::handOut(timer, result.samples.size());
+        result.stats = pImpl->recordStats(timer, result.samples.size(), result.sampleRate);
+
+        // Audio generated by sentence pauses differently from the one-shot result the key stands for.
+        if (!key.empty() && cache && pieces.size() == 1) cache->Put(key, result.samples, result.sampleRate);
 
         return result;
     } catch (const std::exception& e) {
@@ -238,9 +438,16 @@ bool TtsWrapper::generateStream(
     const std::string& text,
     int32_t sid,
     float speed,
-    const TtsStreamCallback& callback
+    const TtsStreamCallback& callback,
+    int32_t firstChunkTargetMs,
+    int64_t* timeToFirstAudioMs,
+    uint64_t ticket,
+    TtsRequestStats* stats
 ) {
-    if (!pImpl->initialized || !pImpl->tts.has_value()) {
+    const auto start = std::chrono::steady_clock::now();
+    TtsRequestTimer timer;
+    if (timeToFirstAudioMs) *timeToFirstAudioMs = -1;
+    if (!pImpl->initialized || !pImpl->engine) {
         LOGE("TTS: Not initialized. Call initialize() first.");
         return false;
     }
@@ -251,24 +458,111 @@ bool TtsWrapper::generateStream(
     }
 
     try {
+        Impl::Request request(pImpl->scheduler(), ticket);
+        EngineScheduler& scheduler = pImpl->scheduler();
+        const std::string key = pImpl->cacheKey(text, sid, speed);
+        auto cache = pImpl->cache();
+        TtsAudioCache::Samples cached;
+        int32_t cachedRate = 0;
+        if (!key.empty() && cache && cache->Get(key, &cached, &cachedRate)) {
+            LOGI("TTS: Audio cache hit (%zu samples), emitting as one chunk", cached->size());
+            Impl::handOut(timer, cached->size());
+            if (callback) callback(cached->data(), static_cast<int32_t>(cached->size()), 1.0f);
+            if (timeToFirstAudioMs) *timeToFirstAudioMs = Impl::elapsedMs(start);
+            TtsRequestStats measured = pImpl->recordStats(timer, cached->size(), cachedRate);
+            if (stats) *stats = measured;
+            return true;
+        }
+
         LOGI("TTS: Streaming generation for text: %s (sid=%d, speed=%.2f)",
              text.c_str(), sid, speed);
 
-        auto callbackCopy = callback;
+        // First-chunk fast path: synthesize a short leading clause, then the rest.
+        auto leading = SplitLeadingClause(text, pImpl->firstChunkPlanner.Budget(firstChunkTargetMs));
+        std::vector<std::string> pieces;
+        if (!leading.first.empty()) {
+            LOGI("TTS: Leading clause of %zu bytes for first-chunk target %d ms", leading.first.size(), firstChunkTargetMs);
+            pieces = {leading.first, leading.second};
+        } else {
+            pieces = {text};
+        }
+        // Batch work gives the engine back after every sentence so interactive requests get in.
+        if (scheduler.PriorityOf(request.id()) == kRequestPriorityBatch) {
+            std::vector<std::string> sentences = SplitSentences(pieces.back());
+            if (sentences.size() > 1) {
+                pieces.pop_back();
+                pieces.insert(pieces.end(), sentences.begin(), sentences.end());
+            }
+        }
+        size_t piecesBytes = 0;
+        for (const std::string& piece : pieces) piecesBytes += piece.size();
+
+        // On a cache miss, collect the emitted chunks; cache only if the stream was not cancelled.
+        // Split text is not cached: its pauses and prosody differ from a one-shot generate().
+        std::vector<float> collected;
+        bool cancelled = false;
+        const bool collect = !key.empty() && cache && pieces.size() == 1;
+        TtsStreamCallback callbackCopy = callback;
+        if (collect) {
+            callbackCopy = [&callback, &collected, &cancelled](const float *samples, int32_t numSamples, float progress) -> int32_t {
+                collected.insert(collected.end(), samples, samples + numSamples);
+                int32_t ret = callback ? callback(samples, numSamples, progress) : 1;
+                if (ret == 0) cancelled = true;
+                return ret;
+            };
+        }
+        // Records time-to-first-audio and maps per-piece progress onto the whole text (by bytes).
+        int64_t firstAudioMs = -1;
+        uint64_t totalSamples = 0;
+        bool stopped = false;
+        size_t doneBytes = 0;
+        size_t pieceBytes = 0;
+        const float totalBytes = static_cast<float>(piecesBytes);
+        TtsStreamCallback timed = [&](const float *samples, int32_t numSamples, float progress) -> int32_t {
+            if (scheduler.ShouldStop(request.id())) {
+                stopped = true;
+                cancelled = true;
+                return 0;
+            }
+            if (firstAudioMs < 0 && numSamples > 0) firstAudioMs = Impl::elapsedMs(start);
+            Impl::handOut(timer, static_cast<size_t>(numSamples));
+            totalSamples += static_cast<uint64_t>(numSamples);
+            if (pieces.size() > 1) {
+                progress = (static_cast<float>(doneBytes) + progress * static_cast<float>(pieceBytes)) / totalBytes;
+            }
+            int32_t ret = callbackCopy ? callbackCopy(samples, numSamples, progress) : 1;
+            if (ret == 0) stopped = true;
+            return ret;
+        };
         auto shim = [](const float *samples, int32_t numSamples, float progress, void *arg) -> int32_t {
             auto *cb = reinterpret_cast<TtsStreamCallback*>(arg);
             if (!cb || !(*cb)) return 0;
             return (*cb)(samples, numSamples, progress);
         };
 
-        pImpl->tts.value().Generate(
-            text,
-            sid,
-            speed,
-            callbackCopy ? shim : nullptr,
-            callbackCopy ? &callbackCopy : nullptr
-        );
+        for (const std::string& piece : pieces) {
+            ScopedEngineSlot slot(scheduler, request.id());
+            if (!slot.ok()) {
+                Impl::logNotRun(slot.status());
+                return false;
+            }
+            timer.OnEngineAcquired();
+            std::lock_guard<std::mutex> lock(pImpl->engine->mutex);
+            pieceBytes = piece.size();
+            pImpl->tts().Generate(piece, sid, speed, shim, &timed);
+            doneBytes += pieceBytes;
+            if (stopped) break;
+        }
 
+        if (timeToFirstAudioMs) *timeToFirstAudioMs = firstAudioMs;
+        if (!leading.first.empty() && firstAudioMs >= 0) {
+            pImpl->firstChunkPlanner.Observe(leading.first.size(), firstAudioMs);
+        }
+        TtsRequestStats measured = pImpl->recordStats(timer, totalSamples, pImpl->tts().SampleRate());
+        if (stats) *stats = measured;
+        if (collect && !cancelled) {
+            cache->Put(key, std::move(collected), pImpl->tts().SampleRate());
+        }
         return true;
     } catch (const std::exception& e) {
         LOGE("TTS: Exception during streaming generation: %s", e.what());
@@ -279,20 +573,223 @@ bool TtsWrapper::generateStream(
     }
 }
 
+bool TtsWrapper::generateStream(
+    const std::string& text,
+    int32_t sid,
+    float speed,
+    WavWriter* writer,
+    const TtsStreamCallback& callback,
+    uint64_t ticket,
+    TtsRequestStats* stats
+) {
+    if (!writer || !writer->IsOpen()) {
+        LOGE("TTS: WAV writer is not open");
+        return false;
+    }
+    bool writeFailed = false;
+    bool ok = generateStream(text, sid, speed,
+        [writer, &callback, &writeFailed](const float *samples, int32_t numSamples, float progress) -> int32_t {
+            if (!writer->Append(samples, static_cast<size_t>(numSamples))) {
+                writeFailed = true;
+                return 0;
+            }
+            return callback ? callback(samples, numSamples, progress) : 1;
+        },
+        0, nullptr, ticket, stats);
+    if (writeFailed) LOGE("TTS: Failed to write audio to %s", writer->Path().c_str());
+    return ok && !writeFailed;
+}
+
+TtsWrapper::AudioResult TtsWrapper::generateParallel(
+    const std::string& text,
+    int32_t sid,
+    float speed,
+    int32_t numEngines,
+    int32_t silenceMs,
+    uint64_t ticket
+) {
+    AudioResult result;
+    result.sampleRate = 0;
+    bool ok = generateParallelStream(
+        text, sid, speed, numEngines, silenceMs,
+        [&result](const float *samples, int32_t numSamples, float /* progress */) -> int32_t {
+            result.samples.insert(result.samples.end(), samples, samples + numSamples);
+            return 1;
+        },
+        0, nullptr, ticket, &result.stats);
+    if (!ok) {
+        result.samples.clear();
+        return result;
+    }
+    result.sampleRate = getSampleRate();
+    return result;
+}
+
+bool TtsWrapper::generateParallelStream(
+    const std::string& text,
+    int32_t sid,
+    float speed,
+    int32_t numEngines,
+    int32_t silenceMs,
+    const TtsStreamCallback& callback,
+    int32_t firstChunkTargetMs,
+    int64_t* timeToFirstAudioMs,
+    uint64_t ticket,
+    TtsRequestStats* stats
+) {
+    const auto start = std::chrono::steady_clock::now();
+    TtsRequestTimer timer;
+    if (timeToFirstAudioMs) *timeToFirstAudioMs = -1;
+    if (!pImpl->initialized || !pImpl->engine) {
+        LOGE("TTS: Not initialized. Call initialize() first.");
+        return false;
+    }
+
+    if (text.empty()) {
+        LOGE("TTS: Input text is empty");
+        return false;
+    }
+
+    try {
+        const std::string key = pImpl->cacheKey(text, sid, speed, "silenceMs=" + std::to_string(silenceMs));
+        auto cache = pImpl->cache();
+        TtsAudioCache::Samples cached;
+        int32_t cachedRate = 0;
+        if (!key.empty() && cache && cache->Get(key, &cached, &cachedRate)) {
+            LOGI("TTS: Audio cache hit (%zu samples), emitting as one chunk", cached->size());
+            Impl::handOut(timer, cached->size());
+            if (callback) callback(cached->data(), static_cast<int32_t>(cached->size()), 1.0f);
+            if (timeToFirstAudioMs) *timeToFirstAudioMs = Impl::elapsedMs(start);
+            TtsRequestStats measured = pImpl->recordStats(timer, cached->size(), cachedRate);
+            if (stats) *stats = measured;
+            return true;
+        }
+
+        auto leading = SplitLeadingClause(text, pImpl->firstChunkPlanner.Budget(firstChunkTargetMs));
+        std::vector<std::string> sentences = SplitSentences(leading.first.empty() ? text : leading.second);
+        if (!leading.first.empty()) sentences.insert(sentences.begin(), leading.first);
+        auto engines = pImpl->acquireEngines(std::max<int32_t>(1, numEngines));
+        if (engines.empty()) return false;
+        // The pipeline keeps the shared engine busy until it finishes, so it takes a single slot and
+        // is not preempted, whatever the request's priority.
+        Impl::Request request(pImpl->scheduler(), ticket);
+        ScopedEngineSlot slot(pImpl->scheduler(), request.id());
+        if (!slot.ok()) {
+            Impl::logNotRun(slot.status());
+            return false;
+        }
+        timer.OnEngineAcquired();
+        std::lock_guard<std::mutex> engineLock(pImpl->engine->mutex);
+
+        const int32_t sampleRate = pImpl->tts().SampleRate();
+        std::vector<float> collected;
+        const bool collect = !key.empty() && cache && leading.first.empty();
+        SentencePipelineOptions options;
+        options.numWorkers = static_cast<int32_t>(engines.size());
+        options.silenceSamples = static_cast<int32_t>(
+            static_cast<int64_t>(sampleRate) * std::max<int32_t>(0, silenceMs) / 1000);
+        options.firstIsClause = !leading.first.empty();
+        int64_t firstAudioMs = -1;
+        uint64_t totalSamples = 0;
+
+        LOGI("TTS: Parallel generation: %zu sentences on %zu engines (sid=%d, speed=%.2f, silenceMs=%d)",
+             sentences.size(), engines.size(), sid, speed, silenceMs);
+
+        auto status = RunSentencePipeline(
+            sentences,
+            options,
+            [&engines, sid, speed](int32_t worker, const std::string& sentence, std::vector<float>* out) {
+                auto audio = engines[static_cast<size_t>(worker)]->Generate(sentence, sid, speed);
+                *out = std::move(audio.samples);
+                return true;
+            },
+            [&](const float *samples, int32_t n, int32_t index, int32_t total) {
+                if (pImpl->scheduler().ShouldStop(request.id())) return false;
+                if (firstAudioMs < 0 && n > 0) firstAudioMs = Impl::elapsedMs(start);
+                Impl::handOut(timer, static_cast<size_t>(n));
+                totalSamples += static_cast<uint64_t>(n);
+                if (collect) collected.insert(collected.end(), samples, samples + n);
+                if (!callback) return true;
+                float progress = static_cast<float>(index + 1) / static_cast<float>(total);
+                return callback(samples, n, progress) != 0;
+            });
+
+        if (timeToFirstAudioMs) *timeToFirstAudioMs = firstAudioMs;
+        if (!leading.first.empty() && firstAudioMs >= 0) {
+            pImpl->firstChunkPlanner.Observe(leading.first.size(), firstAudioMs);
+        }
+        if (status == SentencePipelineStatus::kFailed) {
+            LOGE("TTS: Parallel generation failed");
+            return false;
+        }
+        TtsRequestStats measured = pImpl->recordStats(timer, totalSamples, sampleRate);
+        if (stats) *stats = measured;
+        if (collect && status == SentencePipelineStatus::kOk) {
+            cache->Put(key, std::move(collected), sampleRate);
+        }
+        return true;
+    } catch (const std::exception& e) {
+        LOGE("TTS: Exception during parallel generation: %s", e.what());
+        return false;
+    } catch (...) {
+        LOGE("TTS: Unknown exception during parallel generation");
+        return false;
+    }
+}
+
+TtsStatsSnapshot TtsWrapper::getStats() const {
+    return pImpl->requestStats.Snapshot();
+}
+
+void TtsWrapper::resetStats() {
+    pImpl->requestStats.Reset();
+}
+
 int32_t TtsWrapper::getSampleRate() const {
-    if (!pImpl->initialized || !pImpl->tts.has_value()) {
+    if (!pImpl->initialized || !pImpl->engine) {
         LOGE("TTS: Not initialized. Call initialize() first.");
         return 0;
     }
-    return pImpl->tts.value().SampleRate();
+    return pImpl->tts().SampleRate();
 }
 
 int32_t TtsWrapper::getNumSpeakers() const {
-    if (!pImpl->initialized || !pImpl->tts.has_value()) {
+    if (!pImpl->initialized || !pImpl->engine) {
         LOGE("TTS: Not initialized. Call initialize() first.");
         return 0;
     }
-    return pImpl->tts.value().NumSpeakers();
+    return pImpl->tts().NumSpeakers();
+}
+
+void TtsWrapper::configureAudioCache(size_t maxMemoryBytes, const std::string& diskDir, size_t maxDiskBytes) {
+    std::shared_ptr<TtsAudioCache> cache;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->audioCacheMutex);
+        if (maxMemoryBytes == 0 && diskDir.empty()) {
+            pImpl->audioCache.reset();
+            LOGI("TTS: Audio cache disabled");
+            return;
+        }
+        if (!pImpl->audioCache) pImpl->audioCache = std::make_shared<TtsAudioCache>();
+        cache = pImpl->audioCache;
+    }
+    TtsAudioCache::Options options;
+    options.maxMemoryBytes = maxMemoryBytes;
+    options.diskDir = diskDir;
+    options.maxDiskBytes = maxDiskBytes;
+    cache->Configure(options);
+    LOGI("TTS: Audio cache configured (memory=%zu bytes, disk=%s, maxDisk=%zu bytes)",
+         maxMemoryBytes, diskDir.empty() ? "off" : diskDir.c_str(), maxDiskBytes);
+}
+
+TtsAudioCache::Stats TtsWrapper::getAudioCacheStats() const {
+    auto cache = pImpl->cache();
+    return cache ? cache->GetStats() : TtsAudioCache::Stats();
+}
+
+void TtsWrapper::clearAudioCache(bool includeDisk) {
+    auto cache = pImpl->cache();
+    if (cache) cache->Clear(includeDisk);
 }
 
 bool TtsWrapper::isInitialized() const {
@@ -301,9 +798,19 @@ bool TtsWrapper::isInitialized() const {
 
 void TtsWrapper::release() {
     if (pImpl->initialized) {
-        pImpl->tts.reset();
+        {
+            std::lock_guard<std::mutex> lock(pImpl->enginePoolMutex);
+            pImpl->enginePool.clear();
+        }
+        pImpl->config.reset();
+        pImpl->engine.reset();
+        pImpl->firstChunkPlanner.Reset();
         pImpl->initialized = false;
         pImpl->modelDir.clear();
+        {
+            std::lock_guard<std::mutex> lock(pImpl->audioCacheMutex);
+            pImpl->modelFingerprint.clear();
+        }
         LOGI("TTS: Resources released");
     }
 }
@@ -323,54 +830,17 @@ bool TtsWrapper::saveToWavFile(
         return false;
     }
 
-    try {
-        std::ofstream outfile(filePath, std::ios::binary);
-        if (!outfile) {
-            LOGE("TTS: Failed to open output file: %s", filePath.c_str());
-            return false;
-        }
-
-        const int32_t numChannels = 1;
-        const int32_t bitsPerSample = 16;
-        const int32_t byteRate = sampleRate * numChannels * bitsPerSample / 8;
-        const int32_t blockAlign = numChannels * bitsPerSample / 8;
-        const int32_t dataSize = static_cast<int32_t>(samples.size()) * bitsPerSample / 8;
-        const int32_t chunkSize = 36 + dataSize;
-
-        outfile.write("RIFF", 4);
-        outfile.write(reinterpret_cast<const char*>(&chunkSize), 4);
-        outfile.write("WAVE", 4);
-
-        outfile.write("fmt ", 4);
-        const int32_t subchunk1Size = 16;
-        outfile.write(reinterpret_cast<const char*>(&subchunk1Size), 4);
-        const int16_t audioFormat = 1;
-        outfile.write(reinterpret_cast<const char*>(&audioFormat), 2);
-        const int16_t numChannelsInt16 = static_cast<int16_t>(numChannels);
-        outfile.write(reinterpret_cast<const char*>(&numChannelsInt16), 2);
-        outfile.write(reinterpret_cast<const char*>(&sampleRate), 4);
-        outfile.write(reinterpret_cast<const char*>(&byteRate), 4);
-        const int16_t blockAlignInt16 = static_cast<int16_t>(blockAlign);
-        outfile.write(reinterpret_cast<const char*>(&blockAlignInt16), 2);
-        const int16_t bitsPerSampleInt16 = static_cast<int16_t>(bitsPerSample);
-        outfile.write(reinterpret_cast<const char*>(&bitsPerSampleInt16), 2);
-
-        outfile.write("data", 4);
-        outfile.write(reinterpret_cast<const char*>(&dataSize), 4);
-
-        for (float sample : samples) {
-            float clamped = std::max(-1.0f, std::min(1.0f, sample));
-            int16_t intSample = static_cast<int16_t>(clamped * 32767.0f);
-            outfile.write(reinterpret_cast<const char*>(&intSample), sizeof(int16_t));
-        }
-
-        outfile.close();
-        LOGI("TTS: Successfully saved %zu samples to %s", samples.size(), filePath.c_str());
-        return true;
-    } catch (const std::exception& e) {
-        LOGE("TTS: Exception while saving WAV file: %s", e.what());
+    WavWriter writer;
+    if (!writer.Open(filePath, sampleRate)) {
+        LOGE("TTS: Failed to open output file: %s", filePath.c_str());
+        return false;
+    }
+    if (!writer.Append(samples.data(), samples.size()) || !writer.Finalize()) {
+        LOGE("TTS: Failed to write WAV file: %s", filePath.c_str());
         return false;
     }
+    LOGI("TTS: Successfully saved %zu samples to %s", samples.size(), filePath.c_str());
+    return true;
 }
 
 } // namespace sherpaonnx
@@ -0,0 +1,74 @@
+/**
+ * sherpa-onnx-wav-writer.h
+ *
+ * Declares WavWriter: incremental 16-bit PCM WAV output for TTS (open, append float chunks,
+ * finalize), and the vectorized float -> int16 conversion it uses. Shared by the Android JNI and the
+ * iOS TtsWrapper (mirrored in ios/tts).
+ */
+#ifndef SHERPA_ONNX_WAV_WRITER_H
+#define SHERPA_ONNX_WAV_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace sherpaonnx {
+
+/**
+ * Convert float samples in [-1, 1] to int16 (clamp, scale by 32767, truncate toward zero).
+ * Uses NEON on ARM and SSE2 on x86, with a scalar tail; results are identical on every path for
+ * non-NaN input.
+ */
+void FloatToInt16(const float* in, int16_t* out, size_t n);
+
+/**
+ * Streams mono or interleaved multi-channel float audio into a 16-bit PCM WAV file.
+ *
+ * Open() writes a header with zero sizes; Append() converts into an internal buffer and writes it
+ * in large blocks; Finalize() flushes and patches the RIFF and data sizes. The destructor
+ * finalizes an open file. Not thread-safe: use from one thread at a time.
+ */
+class WavWriter {
+ public:
+  /** Samples converted per block write (128 KiB of int16). */
+  static constexpr size_t kBufferSamples = 64 * 1024;
+
+  WavWriter() = default;
+  ~WavWriter();
+
+  WavWriter(const WavWriter&) = delete;
+  WavWriter& operator=(const WavWriter&) = delete;
+
+  /** Create or truncate path and write the header. Returns false (and stays closed) on failure. */
+  bool Open(const std::string& path, int32_t sampleRate, int32_t numChannels = 1);
+
+  /** Append n samples (interleaved when numChannels > 1). Returns false on a write error. */
+  bool Append(const float* samples, size_t n);
+
+  /** Flush, patch the header sizes and close. Safe to call more than once. */
+  bool Finalize();
+
+  bool IsOpen() const { return file_ != nullptr; }
+  /** Samples appended since Open (all channels). */
+  uint64_t NumSamples() const { return numSamples_; }
+  int32_t SampleRate() const { return sampleRate_; }
+  const std::string& Path() const { return path_; }
+
+ private:
+  bool FlushBuffer();
+
+  std::FILE* file_ = nullptr;
+  std::string path_;
+  int32_t sampleRate_ = 0;
+  int32_t numChannels_ = 1;
+  uint64_t numSamples_ = 0;
+  bool failed_ = false;
+  std::vector<int16_t> buffer_;
+  size_t buffered_ = 0;
+};
+
+}  // namespace sherpaonnx
+
+#endif  // SHERPA_ONNX_WAV_WRITER_H
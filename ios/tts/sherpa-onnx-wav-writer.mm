@@ -0,0 +1,158 @@
+/**
+ * sherpa-onnx-wav-writer.mm
+ *
+ * Purpose: Incremental 16-bit PCM WAV writer. Samples are converted with SIMD clamp + truncating
+ * convert + saturating narrow into a 128 KiB buffer and written in blocks, so saving long audio
+ * is bound by memory bandwidth rather than per-sample stream calls. Sizes are patched on Finalize.
+ * Mirror of android/src/main/cpp/jni/tts/sherpa-onnx-wav-writer.cpp; keep in sync.
+ */
+#include "sherpa-onnx-wav-writer.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SHERPA_ONNX_WAV_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SHERPA_ONNX_WAV_SSE2 1
+#endif
+
+namespace sherpaonnx {
+
+namespace {
+
+constexpr uint32_t kHeaderBytes = 44;
+
+void PutLE16(uint8_t* p, uint16_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+void PutLE32(uint8_t* p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+  p[2] = static_cast<uint8_t>(v >> 16);
+  p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+}  // namespace
+
+void FloatToInt16(const float* in, int16_t* out, size_t n) {
+  size_t i = 0;
+#if defined(SHERPA_ONNX_WAV_NEON)
+  const float32x4_t lo = vdupq_n_f32(-1.0f);
+  const float32x4_t hi = vdupq_n_f32(1.0f);
+  const float32x4_t scale = vdupq_n_f32(32767.0f);
+  for (; i + 8 <= n; i += 8) {
+    float32x4_t a = vld1q_f32(in + i);
+    float32x4_t b = vld1q_f32(in + i + 4);
+    a = vmulq_f32(vminq_f32(vmaxq_f32(a, lo), hi), scale);
+    b = vmulq_f32(vminq_f32(vmaxq_f32(b, lo), hi), scale);
+    // vcvtq truncates toward zero like the scalar cast; vqmovn narrows with saturation.
+    const int16x4_t ra = vqmovn_s32(vcvtq_s32_f32(a));
+    const int16x4_t rb = vqmovn_s32(vcvtq_s32_f32(b));
+    vst1q_s16(out + i, vcombine_s16(ra, rb));
+  }
+#elif defined(SHERPA_ONNX_WAV_SSE2)
+  const __m128 lo = _mm_set1_ps(-1.0f);
+  const __m128 hi = _mm_set1_ps(1.0f);
+  const __m128 scale = _mm_set1_ps(32767.0f);
+  for (; i + 8 <= n; i += 8) {
+    __m128 a = _mm_loadu_ps(in + i);
+    __m128 b = _mm_loadu_ps(in + i + 4);
+    a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(a, lo), hi), scale);
+    b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(b, lo), hi), scale);
+    // cvtt truncates toward zero like the scalar cast; packs narrows with saturation.
+    const __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+  }
+#endif
+  for (; i < n; ++i) {
+    const float clamped = std::max(-1.0f, std::min(1.0f, in[i]));
+    out[i] = static_cast<int16_t>(clamped * 32767.0f);
+  }
+}
+
+WavWriter::~WavWriter() { Finalize(); }
+
+bool WavWriter::Open(const std::string& path, int32_t sampleRate, int32_t numChannels) {
+  if (file_) Finalize();
+  if (sampleRate <= 0 || numChannels <= 0) return false;
+
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) return false;
+  // Blocks are already large; bypass stdio buffering so they go straight to write().
+  std::setvbuf(file_, nullptr, _IONBF, 0);
+
+  path_ = path;
+  sampleRate_ = sampleRate;
+  numChannels_ = numChannels;
+  numSamples_ = 0;
+  failed_ = false;
+  buffered_ = 0;
+  if (buffer_.size() != kBufferSamples) buffer_.assign(kBufferSamples, 0);
+
+  // Sizes are zero until Finalize patches them.
+  uint8_t header[kHeaderBytes] = {};
+  const auto channels = static_cast<uint16_t>(numChannels);
+  std::copy_n("RIFF", 4, header);
+  std::copy_n("WAVE", 4, header + 8);
+  std::copy_n("fmt ", 4, header + 12);
+  PutLE32(header + 16, 16);
+  PutLE16(header + 20, 1);  // PCM
+  PutLE16(header + 22, channels);
+  PutLE32(header + 24, static_cast<uint32_t>(sampleRate));
+  PutLE32(header + 28, static_cast<uint32_t>(sampleRate) * channels * 2);
+  PutLE16(header + 32, static_cast<uint16_t>(channels * 2));
+  PutLE16(header + 34, 16);
+  std::copy_n("data", 4, header + 36);
+  if (std::fwrite(header, 1, kHeaderBytes, file_) != kHeaderBytes) {
+    std::fclose(file_);
+    file_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool WavWriter::Append(const float* samples, size_t n) {
+  if (!file_ || failed_) return false;
+  while (n > 0) {
+    const size_t take = std::min(n, kBufferSamples - buffered_);
+    FloatToInt16(samples, buffer_.data() + buffered_, take);
+    buffered_ += take;
+    numSamples_ += take;
+    samples += take;
+    n -= take;
+    if (buffered_ == kBufferSamples && !FlushBuffer()) return false;
+  }
+  return true;
+}
+
+bool WavWriter::FlushBuffer() {
+  if (buffered_ == 0) return true;
+  if (std::fwrite(buffer_.data(), sizeof(int16_t), buffered_, file_) != buffered_) failed_ = true;
+  buffered_ = 0;
+  return !failed_;
+}
+
+bool WavWriter::Finalize() {
+  if (!file_) return !failed_;
+  bool ok = FlushBuffer();
+
+  // RIFF sizes are 32-bit; clamp rather than wrap for (unrealistically) huge outputs.
+  const uint64_t maxData = std::numeric_limits<uint32_t>::max() - (kHeaderBytes - 8);
+  const auto dataBytes = static_cast<uint32_t>(std::min<uint64_t>(numSamples_ * 2, maxData));
+  uint8_t size[4];
+  PutLE32(size, dataBytes + (kHeaderBytes - 8));
+  ok = ok && std::fseek(file_, 4, SEEK_SET) == 0 && std::fwrite(size, 1, 4, file_) == 4;
+  PutLE32(size, dataBytes);
+  ok = ok && std::fseek(file_, 40, SEEK_SET) == 0 && std::fwrite(size, 1, 4, file_) == 4;
+  ok = (std::fclose(file_) == 0) && ok;
+  file_ = nullptr;
+  if (!ok) failed_ = true;
+  return ok;
+}
+
+}  // namespace sherpaonnx
@@ -33,6 +33,7 @@ export interface Spec extends TurboModule {
    * @param modelOptions - Optional: model-specific options (whisper, senseVoice, canary, funasrNano). Only the block for the loaded model type is applied.
    * @param modelingUnit - Optional: 'cjkchar' | 'bpe' | 'cjkchar+bpe' for hotwords tokenization (OfflineModelConfig.modelingUnit)
    * @param bpeVocab - Optional: path to BPE vocab file (OfflineModelConfig.bpeVocab), used when modelingUnit is bpe or cjkchar+bpe
+   * @param warmUp - Optional: run one short synthetic decode before resolving so the first real request is not slowed by lazy init (default: false)
    * @returns Object with success boolean and array of detected models (each with type and modelDir)
    */
   initializeStt(
@@ -50,14 +51,61 @@ export interface Spec extends TurboModule {
     dither?: number,
     modelOptions?: Object,
     modelingUnit?: string,
-    bpeVocab?: string
+    bpeVocab?: string,
+    warmUp?: boolean,
+    /**
+     * { background?: boolean, prefetch?: boolean, useTuning?: boolean }. background: resolve after
+     * detection with loading: true. useTuning (default true): fill unset numThreads / provider /
+     * preferInt8 from a stored tuneStt winner.
+     */
+    loadOptions?: Object
   ): Promise<{
     success: boolean;
     detectedModels: Array<{ type: string; modelDir: string }>;
     modelType?: string;
     decodingMethod?: string;
+    /** Warm-up decode time in ms (only when warmUp was requested). */
+    warmUpMs?: number;
+    /** True when the recognizer is still being created in the background (see waitForSttReady). */
+    loading?: boolean;
+    /** Load-phase timings: prefetchMs, prefetchedFiles, prefetchedBytes, detectMs, createMs, warmUpMs, totalMs, shared. */
+    loadTimings?: Object;
+    /** { numThreads, provider, preferInt8 } actually used when a stored tuneStt winner was applied. */
+    autoTuned?: Object;
+    /** { entries, duplicates, droppedLines, vocabChecked, cached, compileMs } when hotwordsFile was compiled. */
+    hotwords?: Object;
   }>;
 
+  /**
+   * Time recognizer configurations (thread count, provider, int8 / fp32 files) for an STT model on
+   * this device and store the fastest for later initializeStt calls. Loads the model once per
+   * candidate, so it can take tens of seconds.
+   * @param modelDir - Model directory (same as for initializeStt)
+   * @param options - { modelType?, maxThreads?, providers?, runs?, audioFile?, maxMemoryMB?, tolerance?, persist?, modelOptions? }
+   * @returns SttTuningResult: the winner { numThreads, provider, preferInt8, rtf, peakMemoryBytes } plus audioMs, stored, measurements
+   */
+  tuneStt(modelDir: string, options: Object): Promise<Object>;
+
+  /**
+   * Stored tuneStt winner for a model on this device, or null.
+   * @param modelDir - Model directory
+   * @param modelType - Optional: the modelType passed to tuneStt / initializeStt (default 'auto')
+   */
+  getSttTuning(modelDir: string, modelType?: string): Promise<Object | null>;
+
+  /**
+   * Forget the stored tuneStt winner for a model. Resolves true if one was stored.
+   * @param modelDir - Model directory
+   * @param modelType - Optional: the modelType passed to tuneStt / initializeStt (default 'auto')
+   */
+  clearSttTuning(modelDir: string, modelType?: string): Promise<boolean>;
+
+  /**
+   * Wait for the recognizer of a background initializeStt (loadOptions.background). Resolves with the
+   * full init result including loadTimings, or rejects with the load error. Settles at once when done.
+   */
+  waitForSttReady(instanceId: string): Promise<Object>;
+
   /**
    * Detect STT model type and structure without initializing the recognizer.
    * Uses the same native file-based detection as initializeStt. Useful to show model-specific
@@ -80,19 +128,22 @@ export interface Spec extends TurboModule {
   }>;
 
   /**
-   * Transcribe an audio file. Returns full recognition result (text, tokens, timestamps, lang, emotion, event, durations).
+   * Transcribe an audio file. Returns text plus the recognition result fields selected by
+   * resultFields (tokens, timestamps, lang, emotion, event, durations).
+   * @param resultFields - Bit mask: tokens=1, timestamps=2, durations=4, lang=8, emotion=16, event=32; omit or -1 for all. Unrequested fields are not copied or marshalled.
    */
   transcribeFile(
     instanceId: string,
-    filePath: string
+    filePath: string,
+    resultFields?: number
   ): Promise<{
     text: string;
-    tokens: string[];
-    timestamps: number[];
-    lang: string;
-    emotion: string;
-    event: string;
-    durations: number[];
+    tokens?: string[];
+    timestamps?: number[];
+    lang?: string;
+    emotion?: string;
+    event?: string;
+    durations?: number[];
   }>;
 
   /**
@@ -101,17 +152,68 @@ export interface Spec extends TurboModule {
   transcribeSamples(
     instanceId: string,
     samples: number[],
-    sampleRate: number
+    sampleRate: number,
+    resultFields?: number
   ): Promise<{
     text: string;
-    tokens: string[];
-    timestamps: number[];
-    lang: string;
-    emotion: string;
-    event: string;
-    durations: number[];
+    tokens?: string[];
+    timestamps?: number[];
+    lang?: string;
+    emotion?: string;
+    event?: string;
+    durations?: number[];
   }>;
 
+  /**
+   * Transcribe raw mono PCM passed as base64 bytes (little-endian). Avoids boxing every sample into
+   * a JS number array; pcmLiveStreamData chunks can be passed through as they arrive.
+   * @param encoding - 'int16' (default) or 'float32'
+   */
+  transcribePcm(
+    instanceId: string,
+    base64Pcm: string,
+    sampleRate: number,
+    encoding?: string,
+    resultFields?: number
+  ): Promise<{
+    text: string;
+    tokens?: string[];
+    timestamps?: number[];
+    lang?: string;
+    emotion?: string;
+    event?: string;
+    durations?: number[];
+  }>;
+
+  /**
+   * Transcribe many files in length-sorted batches. Inputs are read (non-WAV: converted) on I/O
+   * threads while the previous batch decodes; each file's result is emitted as an sttBatchResult
+   * event ({ instanceId, requestId, index, path, success, error?, completed, total, ...result }).
+   * @param options - { maxBatchSize?, maxPaddedSeconds?, ioThreads?, resultFields? }
+   * @returns { results, succeeded, failed, total, batches, audioMs, decodeMs, elapsedMs, realTimeFactor }
+   */
+  transcribeFiles(
+    instanceId: string,
+    requestId: string,
+    paths: string[],
+    options: Object
+  ): Promise<Object>;
+
+  /**
+   * Transcribe one long recording: a Silero / TEN VAD cuts speech into padded segments that are
+   * decoded in batches while the scan continues, then merged with segment-offset timestamps. Each
+   * segment is emitted as an sttLongFormSegment event
+   * ({ instanceId, requestId, index, start, end, text, success, error?, progress }).
+   * @param options - { vadModel, vadType?, threshold?, minSilenceDuration?, minSpeechDuration?, maxSegmentSeconds?, paddingMs?, maxBatchSize?, vadThreads?, resultFields? }
+   * @returns { text, tokens, timestamps, lang, emotion, event, durations, segments, failedSegments, audioMs, speechMs, vadMs, decodeMs, elapsedMs, realTimeFactor }
+   */
+  transcribeLongFile(
+    instanceId: string,
+    requestId: string,
+    filePath: string,
+    options: Object
+  ): Promise<Object>;
+
   /**
    * Update recognizer config at runtime (decodingMethod, maxActivePaths, hotwordsFile, hotwordsScore, blankPenalty, ruleFsts, ruleFars).
    */
@@ -180,11 +282,17 @@ export interface Spec extends TurboModule {
   /** True if the stream has enough audio to decode. */
   isSttStreamReady(streamId: string): Promise<boolean>;
 
-  /** Get current partial or final result (call after decodeSttStream). */
-  getSttStreamResult(streamId: string): Promise<{
+  /**
+   * Get current partial or final result (call after decodeSttStream).
+   * @param resultFields - Same mask as transcribeFile; only tokens (1) and timestamps (2) apply. Omit for all.
+   */
+  getSttStreamResult(
+    streamId: string,
+    resultFields?: number
+  ): Promise<{
     text: string;
-    tokens: string[];
-    timestamps: number[];
+    tokens?: string[];
+    timestamps?: number[];
   }>;
 
   /** True if endpoint (end of utterance) was detected. */
@@ -205,11 +313,12 @@ export interface Spec extends TurboModule {
   processSttAudioChunk(
     streamId: string,
     samples: number[],
-    sampleRate: number
+    sampleRate: number,
+    resultFields?: number
   ): Promise<{
     text: string;
-    tokens: string[];
-    timestamps: number[];
+    tokens?: string[];
+    timestamps?: number[];
     isEndpoint: boolean;
   }>;
 
@@ -244,6 +353,7 @@ export interface Spec extends TurboModule {
    * @param maxNumSentences - Optional max sentences per callback (default: 1)
    * @param silenceScale - Optional silence scale on config (default: 0.2)
    * @param provider - Optional execution provider (e.g. 'cpu', 'coreml', 'xnnpack'; default: 'cpu')
+   * @param warmUp - Optional: synthesize one short phrase before resolving (skipped for pocket, which needs reference audio; default: false)
    * @returns Object with success boolean and array of detected models (each with type and modelDir)
    */
   initializeTts(
@@ -259,12 +369,15 @@ export interface Spec extends TurboModule {
     ruleFars?: string,
     maxNumSentences?: number,
     silenceScale?: number,
-    provider?: string
+    provider?: string,
+    warmUp?: boolean
   ): Promise<{
     success: boolean;
     detectedModels: Array<{ type: string; modelDir: string }>;
     sampleRate: number;
     numSpeakers: number;
+    /** Warm-up synthesis time in ms (only when warmUp was requested and supported by the model). */
+    warmUpMs?: number;
   }>;
 
   /**
@@ -320,6 +433,18 @@ export interface Spec extends TurboModule {
   ): Promise<{
     samples: number[];
     sampleRate: number;
+    queueWaitMs?: number;
+    stats?: {
+      timeToFirstChunkMs: number;
+      synthesisMs: number;
+      audioMs: number;
+      realTimeFactor: number;
+      chunkCount: number;
+      minChunkSamples: number;
+      meanChunkSamples: number;
+      maxChunkSamples: number;
+      bytesCopied: number;
+    };
   }>;
 
   /**
@@ -338,10 +463,40 @@ export interface Spec extends TurboModule {
     sampleRate: number;
     subtitles: Array<{ text: string; start: number; end: number }>;
     estimated: boolean;
+    queueWaitMs?: number;
+    stats?: {
+      timeToFirstChunkMs: number;
+      synthesisMs: number;
+      audioMs: number;
+      realTimeFactor: number;
+      chunkCount: number;
+      minChunkSamples: number;
+      meanChunkSamples: number;
+      maxChunkSamples: number;
+      bytesCopied: number;
+    };
   }>;
 
   // ==================== Online (streaming) TTS Methods ====================
 
+  /**
+   * Generate speech straight into a file without returning samples: chunks are written natively
+   * as they are synthesized (WAV; MP3/FLAC/... are encoded from it with the FFmpeg converter).
+   * @param instanceId - Unique ID for this engine instance
+   * @param text - Text to convert to speech
+   * @param options - Generation options as for generateTts, plus outputSampleRateHz for MP3
+   * @param path - Absolute output path
+   * @param format - 'wav', 'mp3', 'flac', ...; '' = the path's extension
+   * @returns { path, format, sampleRate, numSamples, durationMs, queueWaitMs, stats }
+   */
+  generateTtsToFile(
+    instanceId: string,
+    text: string,
+    options: Object,
+    path: string,
+    format: string
+  ): Promise<Object>;
+
   /**
    * Generate speech in streaming mode (emits chunk events).
    * @param instanceId - Unique ID for this engine instance
@@ -356,6 +511,59 @@ export interface Spec extends TurboModule {
     options: Object
   ): Promise<void>;
 
+  /**
+   * Open a text session: a stream whose text arrives in fragments via pushTtsText. Segments are
+   * synthesized as soon as a sentence or clause is complete; chunk/end/error events carry requestId.
+   * Stop it with cancelTtsStream.
+   * @param instanceId - Unique ID for this engine instance
+   * @param requestId - Unique ID for this session (included in chunk/end/error events for routing)
+   * @param options - Generation options as for generateTtsStream
+   */
+  startTtsTextStream(
+    instanceId: string,
+    requestId: string,
+    options: Object
+  ): Promise<void>;
+
+  /**
+   * Append a text fragment to an open text session.
+   * @param instanceId - Unique ID for this engine instance
+   * @param requestId - Session id from startTtsTextStream
+   * @param text - Fragment, e.g. an LLM token (whitespace is kept)
+   */
+  pushTtsText(instanceId: string, requestId: string, text: string): Promise<void>;
+
+  /**
+   * Synthesize the pending text of a session now, without waiting for a sentence end.
+   * @param instanceId - Unique ID for this engine instance
+   * @param requestId - Session id from startTtsTextStream
+   */
+  flushTtsText(instanceId: string, requestId: string): Promise<void>;
+
+  /**
+   * End a text session: the pending text is synthesized, then the final chunk and end are emitted.
+   * @param instanceId - Unique ID for this engine instance
+   * @param requestId - Session id from startTtsTextStream
+   */
+  closeTtsText(instanceId: string, requestId: string): Promise<void>;
+
+  /**
+   * Synthesize items to files without returning samples: item N is encoded and written (WAV, or
+   * MP3/FLAC/... via the FFmpeg encoders) while item N + 1 is synthesized. Emits ttsExportProgress
+   * per written item. Occupies the instance's stream; cancelTtsStream stops it.
+   * @param instanceId - Unique ID for this engine instance
+   * @param requestId - Unique ID for this export (included in progress events)
+   * @param items - Array of { text, path, format? }; format defaults to the path's extension
+   * @param options - Generation options as for generateTts, plus outputSampleRateHz for MP3
+   * @returns { items, succeeded, failed, total, cancelled, expired, elapsedMs, queueWaitMs, stats }
+   */
+  exportTtsBatch(
+    instanceId: string,
+    requestId: string,
+    items: Object[],
+    options: Object
+  ): Promise<Object>;
+
   /**
    * Cancel an ongoing streaming TTS generation.
    * @param instanceId - Unique ID for this engine instance
@@ -381,12 +589,28 @@ export interface Spec extends TurboModule {
    */
   writeTtsPcmChunk(instanceId: string, samples: number[]): Promise<void>;
 
+  /**
+   * Set the PCM player's speed (1 = as generated). Applies within a frame, also to audio already
+   * buffered, by pitch-preserving time-stretching; kept across player restarts.
+   * @param instanceId - Unique ID for this engine instance
+   * @param tempo - Speed factor (> 0, clamped to 0.25..4)
+   */
+  setTtsPcmPlayerTempo(instanceId: string, tempo: number): Promise<void>;
+
   /**
    * Stop PCM playback for streaming TTS.
    * @param instanceId - Unique ID for this engine instance
    */
   stopTtsPcmPlayer(instanceId: string): Promise<void>;
 
+  /**
+   * Jitter buffer counters of the PCM player: { samplesIn, samplesOut, framesOut, silentFrames,
+   * underruns, overruns, bufferedMs, targetMs, maxBufferedMs, playing, frameSamples }; null when
+   * the player is not running.
+   * @param instanceId - Unique ID for this engine instance
+   */
+  getTtsPlaybackStats(instanceId: string): Promise<Object | null>;
+
   /**
    * Get the sample rate of the initialized TTS model.
    * @param instanceId - Unique ID for this engine instance
@@ -401,6 +625,97 @@ export interface Spec extends TurboModule {
    */
   getTtsNumSpeakers(instanceId: string): Promise<number>;
 
+  /**
+   * Enable or reconfigure the synthesized-audio cache of a TTS instance.
+   * Passing maxMemoryBytes <= 0 and an empty diskDir disables the cache.
+   * @param instanceId - Unique ID for this engine instance
+   * @param maxMemoryBytes - In-memory LRU budget in bytes
+   * @param diskDir - Directory for the on-disk tier (empty = memory only)
+   * @param maxDiskBytes - On-disk budget in bytes
+   */
+  configureTtsAudioCache(
+    instanceId: string,
+    maxMemoryBytes: number,
+    diskDir: string,
+    maxDiskBytes: number
+  ): Promise<void>;
+
+  /**
+   * Hit/miss counters and sizes of the instance's audio cache (all zero when disabled).
+   * @param instanceId - Unique ID for this engine instance
+   */
+  getTtsAudioCacheStats(instanceId: string): Promise<{
+    memoryHits: number;
+    diskHits: number;
+    misses: number;
+    insertions: number;
+    evictions: number;
+    memoryBytes: number;
+    memoryEntries: number;
+    diskBytes: number;
+  }>;
+
+  /**
+   * Drop cached audio of a TTS instance.
+   * @param instanceId - Unique ID for this engine instance
+   * @param includeDisk - Also delete the on-disk tier
+   */
+  clearTtsAudioCache(instanceId: string, includeDisk: boolean): Promise<void>;
+
+  /**
+   * Aggregate latency stats of a TTS instance: { requests, totalAudioMs, totalSynthesisMs,
+   * bytesCopied } plus histograms timeToFirstChunkMs, synthesisMs, realTimeFactor and chunkSamples,
+   * each { count, mean, min, max, p50, p90, p99, upperBounds, counts } (see TtsStats).
+   * @param instanceId - Unique ID for this engine instance
+   */
+  getTtsStats(instanceId: string): Promise<Object>;
+
+  /**
+   * Reset the aggregate stats of a TTS instance.
+   * @param instanceId - Unique ID for this engine instance
+   */
+  resetTtsStats(instanceId: string): Promise<void>;
+
+  /**
+   * Register a reference prompt for repeated voice cloning (Zipvoice, Android). The prompt is
+   * copied and resampled natively once; pass the resolved id as `promptId` in generation options.
+   * @param instanceId - Unique ID for this engine instance
+   * @param samples - Reference audio (mono, [-1, 1])
+   * @param sampleRate - Sample rate of samples in Hz
+   * @param promptText - Transcript of the reference audio
+   * @returns Prompt id (> 0)
+   */
+  registerTtsPrompt(
+    instanceId: string,
+    samples: number[],
+    sampleRate: number,
+    promptText: string
+  ): Promise<number>;
+
+  /**
+   * Forget a registered prompt.
+   * @param instanceId - Unique ID for this engine instance
+   * @param promptId - Id from registerTtsPrompt
+   * @returns false if the id was not registered
+   */
+  unregisterTtsPrompt(instanceId: string, promptId: number): Promise<boolean>;
+
+  /**
+   * Time Zipvoice voice cloning at two flow-step counts on this device and store the fit, so
+   * `latencyBudgetMs` can pick num_steps (Android). Blocks the engine for a few generations.
+   * @param instanceId - Unique ID for this engine instance
+   * @param options - { text?, speed?, promptId? | referenceAudio + referenceSampleRate + referenceText }
+   * @returns TtsStepCalibration plus { flowSeconds, stepsLo, msLo, stepsHi, msHi }
+   */
+  calibrateTtsSteps(instanceId: string, options: Object): Promise<Object>;
+
+  /**
+   * Current step-time model of a Zipvoice instance (TtsStepCalibration), or null for other models
+   * and on iOS.
+   * @param instanceId - Unique ID for this engine instance
+   */
+  getTtsStepCalibration(instanceId: string): Promise<Object | null>;
+
   /**
    * Release TTS resources.
    * @param instanceId - Unique ID for this engine instance
@@ -29,6 +29,13 @@ export type PcmLiveStreamHandle = {
   onData: (
     callback: (samples: Float32Array, sampleRate: number) => void
   ) => () => void;
+  /**
+   * Chunks as delivered by native capture: base64 Int16 PCM, not decoded in JS. Pass them to
+   * `stt.transcribePcm()` (or buffer them) to skip the per-sample float conversion.
+   */
+  onRawData: (
+    callback: (base64Pcm: string, sampleRate: number) => void
+  ) => () => void;
   onError: (callback: (message: string) => void) => () => void;
 };
 
@@ -69,6 +76,17 @@ export function createPcmLiveStream(
       return () => sub.remove();
     },
 
+    onRawData: (callback: (base64Pcm: string, sampleRate: number) => void) => {
+      const sub = DeviceEventEmitter.addListener(
+        'pcmLiveStreamData',
+        (event: { base64Pcm?: string; sampleRate?: number }) => {
+          const base64 = event?.base64Pcm ?? '';
+          if (base64) callback(base64, event?.sampleRate ?? sampleRate);
+        }
+      );
+      return () => sub.remove();
+    },
+
     onError: (callback: (message: string) => void) => {
       const sub = DeviceEventEmitter.addListener(
         'pcmLiveStreamError',
@@ -1,16 +1,31 @@
+import { Buffer } from 'buffer';
+import { DeviceEventEmitter } from 'react-native';
 import SherpaOnnx from '../NativeSherpaOnnx';
 import type {
   STTInitializeOptions,
   STTModelType,
   SttEngine,
+  SttInitResult,
   SttModelOptions,
   SttRecognitionResult,
   SttRuntimeConfig,
+  SttBatchOptions,
+  SttBatchItemResult,
+  SttBatchResult,
+  SttLongFormOptions,
+  SttLongFormSegment,
+  SttLongFormResult,
+  SttTuneOptions,
+  SttTuning,
+  SttTuningResult,
 } from './types';
+import { sttResultFieldMask } from './types';
 import type { ModelPathConfig } from '../types';
 import { resolveModelPath } from '../utils';
 
 let sttInstanceCounter = 0;
+let sttBatchCounter = 0;
+let sttLongFormCounter = 0;
 
 function normalizeSttResult(raw: {
   text?: string;
@@ -34,6 +49,41 @@ function normalizeSttResult(raw: {
   };
 }
 
+type RawBatchItem = Parameters<typeof normalizeSttResult>[0] & {
+  index: number;
+  path: string;
+  success: boolean;
+  error?: string;
+  completed?: number;
+  total?: number;
+};
+
+function normalizeBatchItem(raw: RawBatchItem): SttBatchItemResult {
+  const item: SttBatchItemResult = {
+    index: raw.index,
+    path: raw.path,
+    success: raw.success,
+  };
+  if (raw.success) item.result = normalizeSttResult(raw);
+  if (raw.error !== undefined) item.error = raw.error;
+  if (raw.completed !== undefined) item.completed = raw.completed;
+  if (raw.total !== undefined) item.total = raw.total;
+  return item;
+}
+
+function normalizeLongFormSegment(raw: SttLongFormSegment): SttLongFormSegment {
+  const segment: SttLongFormSegment = {
+    index: raw.index,
+    start: raw.start,
+    end: raw.end,
+    text: typeof raw.text === 'string' ? raw.text : '',
+    success: raw.success,
+  };
+  if (raw.error !== undefined) segment.error = raw.error;
+  if (raw.progress !== undefined) segment.progress = raw.progress;
+  return segment;
+}
+
 /**
  * Detect STT model type and structure without initializing the recognizer.
  * Uses the same native file-based detection as createSTT. Stateless; no instance required.
@@ -66,6 +116,66 @@ export async function detectSttModel(
   );
 }
 
+/**
+ * Benchmark recognizer configurations for a model on this device — thread counts, execution
+ * providers and int8 vs fp32 model files — and store the fastest that fits `maxMemoryMB`. Later
+ * createSTT() calls for the same model use it for options they leave unset (see `useTuning`).
+ * Each candidate loads the model once, so this can take tens of seconds; run it once, e.g. after a
+ * model download. The stored choice is dropped when the model files or the OS build change.
+ *
+ * @param modelPath - Model path configuration (as for createSTT)
+ * @param options - Candidates, calibration audio and memory bound
+ * @returns The winner and every measurement
+ * @example
+ * ```typescript
+ * const tuning = await tuneStt({ type: 'asset', path: 'models/whisper-tiny' });
+ * console.log(tuning.provider, tuning.numThreads, tuning.preferInt8, tuning.rtf);
+ * const stt = await createSTT({ modelPath: { type: 'asset', path: 'models/whisper-tiny' } });
+ * ```
+ */
+export async function tuneStt(
+  modelPath: ModelPathConfig,
+  options?: SttTuneOptions
+): Promise<SttTuningResult> {
+  const resolvedPath = await resolveModelPath(modelPath);
+  return (await SherpaOnnx.tuneStt(
+    resolvedPath,
+    options ?? {}
+  )) as SttTuningResult;
+}
+
+/**
+ * The configuration stored by tuneStt() for a model on this device, or null.
+ *
+ * @param modelPath - Model path configuration
+ * @param modelType - The modelType passed to tuneStt() (default 'auto')
+ */
+export async function getSttTuning(
+  modelPath: ModelPathConfig,
+  modelType?: STTModelType
+): Promise<SttTuning | null> {
+  const resolvedPath = await resolveModelPath(modelPath);
+  return (await SherpaOnnx.getSttTuning(
+    resolvedPath,
+    modelType
+  )) as SttTuning | null;
+}
+
+/**
+ * Forget the configuration stored by tuneStt(); createSTT() then uses its defaults again.
+ * Resolves true if one was stored.
+ *
+ * @param modelPath - Model path configuration
+ * @param modelType - The modelType passed to tuneStt() (default 'auto')
+ */
+export async function clearSttTuning(
+  modelPath: ModelPathConfig,
+  modelType?: STTModelType
+): Promise<boolean> {
+  const resolvedPath = await resolveModelPath(modelPath);
+  return SherpaOnnx.clearSttTuning(resolvedPath, modelType);
+}
+
 /**
  * Create an STT engine instance. Call destroy() on the returned engine when done to free native resources.
  *
@@ -99,6 +209,12 @@ export async function createSTT(
   let modelOptions: SttModelOptions | undefined;
   let modelingUnit: string | undefined;
   let bpeVocab: string | undefined;
+  let warmUp: boolean | undefined;
+  let loadInBackground: boolean | undefined;
+  let whileLoading: STTInitializeOptions['whileLoading'];
+  let prefetch: boolean | undefined;
+  let resultFields: STTInitializeOptions['resultFields'];
+  let useTuning: boolean | undefined;
 
   if ('modelPath' in options) {
     modelPath = options.modelPath;
@@ -114,6 +230,12 @@ export async function createSTT(
     modelOptions = options.modelOptions;
     modelingUnit = options.modelingUnit;
     bpeVocab = options.bpeVocab;
+    warmUp = options.warmUp;
+    loadInBackground = options.loadInBackground;
+    whileLoading = options.whileLoading;
+    prefetch = options.prefetch;
+    resultFields = options.resultFields;
+    useTuning = options.useTuning;
   } else {
     modelPath = options;
     preferInt8 = undefined;
@@ -128,6 +250,12 @@ export async function createSTT(
     modelOptions = undefined;
     modelingUnit = undefined;
     bpeVocab = undefined;
+    warmUp = undefined;
+    loadInBackground = undefined;
+    whileLoading = undefined;
+    prefetch = undefined;
+    resultFields = undefined;
+    useTuning = undefined;
   }
 
   const debug = 'modelPath' in options ? options.debug : undefined;
@@ -148,7 +276,13 @@ export async function createSTT(
     dither,
     modelOptions,
     modelingUnit,
-    bpeVocab
+    bpeVocab,
+    warmUp,
+    {
+      background: loadInBackground === true,
+      prefetch: prefetch !== false,
+      useTuning: useTuning !== false,
+    }
   );
 
   if (!result.success) {
@@ -169,32 +303,184 @@ export async function createSTT(
     }
   };
 
+  // Background load: resolved by waitForSttReady once the recognizer exists.
+  let ready = result.loading !== true;
+  const readyPromise: Promise<SttInitResult> = ready
+    ? Promise.resolve(result as SttInitResult)
+    : SherpaOnnx.waitForSttReady(instanceId).then((loaded) => {
+        ready = true;
+        return loaded as SttInitResult;
+      });
+  // Observed through whenReady() or the next request; do not report it as unhandled.
+  readyPromise.catch(() => {});
+
+  /** guard(), then wait for a background load unless whileLoading is 'reject' (native fails fast with STT_NOT_READY). */
+  const ensureReady = async () => {
+    guard();
+    if (!ready && whileLoading !== 'reject') await readyPromise;
+  };
+
+  // Computed once: every transcribe* call sends it so unrequested fields stay native.
+  const fieldMask = sttResultFieldMask(resultFields);
+
   const engine: SttEngine = {
     get instanceId() {
       return instanceId;
     },
 
-    async transcribeFile(filePath: string): Promise<SttRecognitionResult> {
+    isReady(): boolean {
+      return ready;
+    },
+
+    whenReady(): Promise<SttInitResult> {
       guard();
-      const raw = await SherpaOnnx.transcribeFile(instanceId, filePath);
+      return readyPromise;
+    },
+
+    async transcribeFile(filePath: string): Promise<SttRecognitionResult> {
+      await ensureReady();
+      const raw = await SherpaOnnx.transcribeFile(
+        instanceId,
+        filePath,
+        fieldMask
+      );
       return normalizeSttResult(raw);
     },
 
     async transcribeSamples(
-      samples: number[],
+      samples: number[] | Float32Array | Int16Array,
       sampleRate: number
     ): Promise<SttRecognitionResult> {
-      guard();
-      const raw = await SherpaOnnx.transcribeSamples(
+      await ensureReady();
+      if (Array.isArray(samples)) {
+        const raw = await SherpaOnnx.transcribeSamples(
+          instanceId,
+          samples,
+          sampleRate,
+          fieldMask
+        );
+        return normalizeSttResult(raw);
+      }
+      // Typed arrays cross the bridge as their bytes; native converts them in one pass.
+      const bytes = Buffer.from(
+        samples.buffer,
+        samples.byteOffset,
+        samples.byteLength
+      );
+      const raw = await SherpaOnnx.transcribePcm(
         instanceId,
-        samples,
-        sampleRate
+        bytes.toString('base64'),
+        sampleRate,
+        samples instanceof Int16Array ? 'int16' : 'float32',
+        fieldMask
       );
       return normalizeSttResult(raw);
     },
 
+    async transcribePcm(
+      base64Pcm: string,
+      sampleRate: number,
+      encoding?: 'int16' | 'float32'
+    ): Promise<SttRecognitionResult> {
+      await ensureReady();
+      const raw = await SherpaOnnx.transcribePcm(
+        instanceId,
+        base64Pcm,
+        sampleRate,
+        encoding ?? 'int16',
+        fieldMask
+      );
+      return normalizeSttResult(raw);
+    },
+
+    async transcribeFiles(
+      filePaths: string[],
+      opts?: SttBatchOptions
+    ): Promise<SttBatchResult> {
+      await ensureReady();
+      const requestId = `stt_batch_${++sttBatchCounter}`;
+      const native: Record<string, number> = {};
+      if (opts?.maxBatchSize != null) native.maxBatchSize = opts.maxBatchSize;
+      if (opts?.maxPaddedSeconds != null)
+        native.maxPaddedSeconds = opts.maxPaddedSeconds;
+      if (opts?.ioThreads != null) native.ioThreads = opts.ioThreads;
+      const batchMask = sttResultFieldMask(opts?.resultFields) ?? fieldMask;
+      if (batchMask != null) native.resultFields = batchMask;
+      const onResult = opts?.onResult;
+      const subscription = onResult
+        ? DeviceEventEmitter.addListener('sttBatchResult', (event: unknown) => {
+            const e = event as RawBatchItem & {
+              instanceId?: string;
+              requestId?: string;
+            };
+            if (e.instanceId === instanceId && e.requestId === requestId) {
+              onResult(normalizeBatchItem(e));
+            }
+          })
+        : null;
+      try {
+        const raw = (await SherpaOnnx.transcribeFiles(
+          instanceId,
+          requestId,
+          filePaths,
+          native
+        )) as Omit<SttBatchResult, 'results'> & { results: RawBatchItem[] };
+        return { ...raw, results: raw.results.map(normalizeBatchItem) };
+      } finally {
+        subscription?.remove();
+      }
+    },
+
+    async transcribeLongFile(
+      filePath: string,
+      opts: SttLongFormOptions
+    ): Promise<SttLongFormResult> {
+      await ensureReady();
+      const requestId = `stt_long_${++sttLongFormCounter}`;
+      const { onSegment, resultFields: segmentFields, ...rest } = opts;
+      const longMask = sttResultFieldMask(segmentFields) ?? fieldMask;
+      const native =
+        longMask != null ? { ...rest, resultFields: longMask } : rest;
+      const subscription = onSegment
+        ? DeviceEventEmitter.addListener(
+            'sttLongFormSegment',
+            (event: unknown) => {
+              const e = event as SttLongFormSegment & {
+                instanceId?: string;
+                requestId?: string;
+              };
+              if (e.instanceId === instanceId && e.requestId === requestId) {
+                onSegment(normalizeLongFormSegment(e));
+              }
+            }
+          )
+        : null;
+      try {
+        const raw = (await SherpaOnnx.transcribeLongFile(
+          instanceId,
+          requestId,
+          filePath,
+          native
+        )) as Omit<SttLongFormResult, keyof SttRecognitionResult> &
+          Parameters<typeof normalizeSttResult>[0];
+        return {
+          ...normalizeSttResult(raw),
+          segments: Array.isArray(raw.segments) ? raw.segments : [],
+          failedSegments: raw.failedSegments ?? 0,
+          audioMs: raw.audioMs,
+          speechMs: raw.speechMs,
+          vadMs: raw.vadMs,
+          decodeMs: raw.decodeMs,
+          elapsedMs: raw.elapsedMs,
+          realTimeFactor: raw.realTimeFactor,
+        };
+      } finally {
+        subscription?.remove();
+      }
+    },
+
     async setConfig(config: SttRuntimeConfig): Promise<void> {
-      guard();
+      await ensureReady();
       const map: Record<string, string | number> = {};
       if (config.decodingMethod != null)
         map.decodingMethod = config.decodingMethod;
@@ -245,11 +531,26 @@ export type {
   SttRuntimeConfig,
   SttEngine,
   SttInitResult,
+  SttLoadTimings,
+  SttHotwordsInfo,
+  SttBatchOptions,
+  SttBatchItemResult,
+  SttBatchResult,
+  SttLongFormOptions,
+  SttLongFormSegment,
+  SttLongFormResult,
+  SttResultField,
+  SttTuneOptions,
+  SttTuning,
+  SttTuneMeasurement,
+  SttTuningResult,
 } from './types';
 export {
   STT_MODEL_TYPES,
   STT_HOTWORDS_MODEL_TYPES,
   sttSupportsHotwords,
+  STT_RESULT_FIELDS,
+  sttResultFieldMask,
 } from './types';
 export {
   getWhisperLanguages,
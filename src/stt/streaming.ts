@@ -7,6 +7,7 @@ import type {
   StreamingSttResult,
   SttStream,
 } from './streamingTypes';
+import { sttResultFieldMask } from './types';
 
 let streamingSttInstanceCounter = 0;
 
@@ -232,6 +233,7 @@ export async function createStreamingSTT(
   }
 
   const enableInputNormalization = options.enableInputNormalization !== false;
+  const fieldMask = sttResultFieldMask(options.resultFields);
   let destroyed = false;
 
   const guard = () => {
@@ -296,7 +298,7 @@ export async function createStreamingSTT(
 
         async getResult(): Promise<StreamingSttResult> {
           streamGuard();
-          const raw = await SherpaOnnx.getSttStreamResult(streamId);
+          const raw = await SherpaOnnx.getSttStreamResult(streamId, fieldMask);
           return normalizeStreamingResult(raw);
         },
 
@@ -343,7 +345,8 @@ export async function createStreamingSTT(
           const raw = await SherpaOnnx.processSttAudioChunk(
             streamId,
             samplesArray,
-            sampleRate
+            sampleRate,
+            fieldMask
           );
           return {
             result: normalizeStreamingResult(raw),
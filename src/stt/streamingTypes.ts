@@ -1,4 +1,5 @@
 import type { ModelPathConfig } from '../types';
+import type { SttResultField } from './types';
 
 /**
  * Online (streaming) STT model types.
@@ -85,6 +86,12 @@ export interface StreamingSttInitOptions {
    * Set to false if your audio is already in the expected range [-1, 1] and you want to pass it through unchanged.
    */
   enableInputNormalization?: boolean;
+  /**
+   * Result fields besides `text` returned by getResult() and processAudioChunk(): `[]` for text
+   * only (typical for live partials), `['tokens']`, `['timestamps']`, or both. Fields not listed
+   * are not marshalled over the bridge and come back empty. Default: both.
+   */
+  resultFields?: Array<Extract<SttResultField, 'tokens' | 'timestamps'>>;
 }
 
 /**
@@ -38,6 +38,41 @@ export function sttSupportsHotwords(modelType: STTModelType | string): boolean {
   return modelType === 'transducer' || modelType === 'nemo_transducer';
 }
 
+/** Optional fields of a recognition result; `text` is always returned. */
+export type SttResultField =
+  | 'tokens'
+  | 'timestamps'
+  | 'durations'
+  | 'lang'
+  | 'emotion'
+  | 'event';
+
+/** Result fields in native bit order (must match SttResultField in sherpa-onnx-common.h). */
+export const STT_RESULT_FIELDS: readonly SttResultField[] = [
+  'tokens',
+  'timestamps',
+  'durations',
+  'lang',
+  'emotion',
+  'event',
+] as const;
+
+/**
+ * Native result-field mask for a field list; undefined (every field) when no list is given.
+ * An empty list returns text only.
+ */
+export function sttResultFieldMask(
+  fields?: readonly SttResultField[]
+): number | undefined {
+  if (fields == null) return undefined;
+  let mask = 0;
+  for (const field of fields) {
+    const bit = STT_RESULT_FIELDS.indexOf(field);
+    if (bit >= 0) mask |= 1 << bit;
+  }
+  return mask;
+}
+
 /** Runtime list of supported STT model types (must match ParseSttModelType in native). */
 export const STT_MODEL_TYPES: readonly STTModelType[] = [
   'transducer',
@@ -66,6 +101,14 @@ export interface SttInitResult {
   detectedModels: Array<{ type: string; modelDir: string }>;
   modelType?: string;
   decodingMethod?: string;
+  /** Warm-up decode time in ms (only when warmUp was requested). */
+  warmUpMs?: number;
+  /** Load-phase timings; set once the recognizer is loaded. */
+  loadTimings?: SttLoadTimings;
+  /** Set when a stored tuneStt() winner filled in numThreads / provider / preferInt8: the values used. */
+  autoTuned?: Pick<SttTuning, 'numThreads' | 'provider' | 'preferInt8'>;
+  /** Set when hotwordsFile was given: what compiling it against the model tokens kept and dropped. */
+  hotwords?: SttHotwordsInfo;
 }
 
 // ========== Model-specific options (only applied when that model type is loaded) ==========
@@ -237,6 +280,142 @@ export interface STTInitializeOptions {
    * E.g. when modelType is 'whisper', only modelOptions.whisper is used.
    */
   modelOptions?: SttModelOptions;
+
+  /**
+   * Decode a short synthetic clip during initialization so the first real
+   * transcription does not pay for lazy ONNX Runtime setup. Initialization
+   * takes correspondingly longer. Default false.
+   */
+  warmUp?: boolean;
+
+  /**
+   * Result fields besides `text` that transcribe* return, e.g. `[]` for text only or
+   * `['tokens', 'timestamps']`. Fields not listed are never copied out of the recognizer or sent
+   * over the bridge and come back empty. Default: all fields.
+   */
+  resultFields?: SttResultField[];
+
+  /**
+   * Return the engine as soon as the model is detected and create the ONNX Runtime sessions on
+   * a background thread. Use `engine.whenReady()` to wait for the load (and its timings). Default false.
+   */
+  loadInBackground?: boolean;
+
+  /**
+   * What transcribe* and setConfig do while a background load is still running: 'wait' until the
+   * model is loaded (default) or 'reject' with an STT_NOT_READY error.
+   */
+  whileLoading?: 'wait' | 'reject';
+
+  /**
+   * Ask the OS to read the model files into the page cache while detection runs, so session
+   * creation does not fault them in page by page. Hints only. Default true.
+   */
+  prefetch?: boolean;
+
+  /**
+   * Use the configuration stored by tuneStt() for this model on this device for whichever of
+   * numThreads, provider and preferInt8 are not set here. Pass the same modelType as to tuneStt().
+   * Default true; has no effect until tuneStt() has run.
+   */
+  useTuning?: boolean;
+}
+
+/** Options for tuneStt(). */
+export interface SttTuneOptions {
+  /** Same as for createSTT(); part of the stored key. Default 'auto'. */
+  modelType?: STTModelType;
+  /** Largest thread count tried (1, 2, 4, ... up to it). Default: CPU cores, at most 8. */
+  maxThreads?: number;
+  /**
+   * Providers to try besides 'cpu'. Default: those usable on the device ('xnnpack' when compiled
+   * in and 'nnapi' when an accelerator is present on Android; 'coreml' when available on iOS).
+   */
+  providers?: string[];
+  /** Timed decodes per candidate after one warm-up decode; the median counts. Default 2. */
+  runs?: number;
+  /** 16 kHz-ish WAV to decode; representative speech gives the most realistic RTF. Default: a built-in 4 s synthetic clip. */
+  audioFile?: string;
+  /** Candidates whose peak memory growth exceeds this are not chosen. Default: no bound. */
+  maxMemoryMB?: number;
+  /** Relative RTF gain that counts as faster; ties go to fewer threads. Default 0.05. */
+  tolerance?: number;
+  /** Store the winner for later createSTT() calls. Default true. */
+  persist?: boolean;
+  /** Model-specific options used for the calibration decodes (see STTInitializeOptions.modelOptions). */
+  modelOptions?: SttModelOptions;
+}
+
+/** A recognizer configuration chosen by tuneStt(). */
+export interface SttTuning {
+  numThreads: number;
+  provider: string;
+  preferInt8: boolean;
+  /** Decode time / audio duration measured for it (lower is faster). */
+  rtf: number;
+  /** Peak process memory growth while it was loaded and decoding; 0 when unknown. */
+  peakMemoryBytes: number;
+}
+
+/** One configuration timed by tuneStt(). */
+export interface SttTuneMeasurement {
+  numThreads: number;
+  provider: string;
+  preferInt8: boolean;
+  /** False when the recognizer could not be created or decode failed (see error). */
+  ok: boolean;
+  error?: string;
+  /** Recognizer (ONNX Runtime session) creation. */
+  loadMs: number;
+  /** Median timed decode. */
+  decodeMs: number;
+  rtf: number;
+  peakMemoryBytes: number;
+}
+
+/** Result of tuneStt(): the winner plus every measurement, in the order they ran. */
+export interface SttTuningResult extends SttTuning {
+  /** Length of the calibration audio. */
+  audioMs: number;
+  /** Whether the winner was stored (options.persist). */
+  stored: boolean;
+  measurements: SttTuneMeasurement[];
+}
+
+/** Time spent in each phase of loading an offline STT model (ms unless noted). */
+export interface SttLoadTimings {
+  /** Issuing read-ahead hints for the model files (the reads continue in the background). */
+  prefetchMs: number;
+  prefetchedFiles: number;
+  prefetchedBytes: number;
+  detectMs: number;
+  /** Recognizer (ONNX Runtime session) creation; about 0 when `shared`. */
+  createMs: number;
+  /** Only when warmUp ran. */
+  warmUpMs?: number;
+  /** From the initializeStt call until the recognizer was ready. */
+  totalMs: number;
+  /** The recognizer was already loaded by another instance with the same model and config. */
+  shared: boolean;
+}
+
+/**
+ * Outcome of compiling a hotwords file: lines are validated, checked against the model's
+ * tokens.txt and de-duplicated once, and the compact result is cached by file content and model
+ * vocabulary, so later inits with the same file skip the work.
+ */
+export interface SttHotwordsInfo {
+  /** Phrases passed to the recognizer. */
+  entries: number;
+  /** Repeated phrases merged into one (the higher explicit score is kept). */
+  duplicates: number;
+  /** Lines dropped because the model's tokens cannot spell them (see the native log for examples). */
+  droppedLines: number;
+  /** False when tokens.txt could not be read, so only the format was checked. */
+  vocabChecked: boolean;
+  /** The compiled file was reused from an earlier init. */
+  cached: boolean;
+  compileMs: number;
 }
 
 /**
@@ -259,17 +438,161 @@ export interface SttRecognitionResult {
   durations: number[];
 }
 
+/** Options for `transcribeFiles()`. */
+export interface SttBatchOptions {
+  /**
+   * Files decoded per batch (default 8). Files are grouped by length, so a batch pads little;
+   * 1 decodes one file at a time, the baseline to compare throughput against.
+   */
+  maxBatchSize?: number;
+  /** Upper bound on a batch's padded audio (files * longest), in seconds (default 240). */
+  maxPaddedSeconds?: number;
+  /** Threads reading and converting the next batch while one decodes (default 2, max 8). */
+  ioThreads?: number;
+  /** Overrides the engine's `resultFields` for this call. */
+  resultFields?: SttResultField[];
+  /** Called as each file's batch finishes, in batch order (longest files first). */
+  onResult?: (item: SttBatchItemResult) => void;
+}
+
+/** One file of a `transcribeFiles()` call; `result` is set when `success` is true. */
+export interface SttBatchItemResult {
+  /** Position in the input paths. */
+  index: number;
+  path: string;
+  success: boolean;
+  error?: string;
+  result?: SttRecognitionResult;
+  /** Files finished so far (in progress callbacks). */
+  completed?: number;
+  total?: number;
+}
+
+export interface SttBatchResult {
+  /** One entry per input path, in input order. */
+  results: SttBatchItemResult[];
+  succeeded: number;
+  failed: number;
+  total: number;
+  batches: number;
+  /** Audio transcribed, in ms. */
+  audioMs: number;
+  /** Time spent decoding (excluding reads that overlapped it). */
+  decodeMs: number;
+  elapsedMs: number;
+  /** decodeMs / audioMs; compare against `maxBatchSize: 1` to measure the batching gain. */
+  realTimeFactor: number;
+}
+
+/** Options for `transcribeLongFile()`. */
+export interface SttLongFormOptions {
+  /** Path to a VAD model: silero_vad.onnx or ten-vad.onnx (required). */
+  vadModel: string;
+  /** VAD family; default: 'ten' when the file name contains "ten", else 'silero'. */
+  vadType?: 'silero' | 'ten';
+  /** Speech probability threshold (default 0.5). */
+  threshold?: number;
+  /** Silence in seconds that ends a segment (default 0.5). */
+  minSilenceDuration?: number;
+  /** Shorter speech in seconds is dropped (default 0.25). */
+  minSpeechDuration?: number;
+  /**
+   * Longest segment handed to the recognizer, in seconds (default 20; keep it under 30 for
+   * Whisper). Short neighbouring segments are merged up to this, longer speech is split.
+   */
+  maxSegmentSeconds?: number;
+  /** Context kept before and after each speech segment, in ms (default 200). */
+  paddingMs?: number;
+  /** Segments decoded per recognizer turn (default 8). */
+  maxBatchSize?: number;
+  /** Threads for the VAD model (default 1). */
+  vadThreads?: number;
+  /** Overrides the engine's `resultFields` for the merged result. */
+  resultFields?: SttResultField[];
+  /** Called as each segment is decoded, in time order. */
+  onSegment?: (segment: SttLongFormSegment) => void;
+}
+
+/** One decoded speech segment of a long recording; times are seconds from the file start. */
+export interface SttLongFormSegment {
+  /** Position in time order. */
+  index: number;
+  start: number;
+  end: number;
+  text: string;
+  success: boolean;
+  error?: string;
+  /** Fraction of the file covered so far, 0..1 (in progress callbacks). */
+  progress?: number;
+}
+
+/**
+ * Merged transcript of a long recording. `timestamps` are shifted by each segment's offset, so
+ * they refer to the whole file.
+ */
+export interface SttLongFormResult extends SttRecognitionResult {
+  /** Successfully decoded segments, in time order. */
+  segments: Array<{ start: number; end: number; text: string }>;
+  failedSegments: number;
+  /** Length of the recording, in ms. */
+  audioMs: number;
+  /** Audio inside speech segments (including padding), in ms. */
+  speechMs: number;
+  vadMs: number;
+  decodeMs: number;
+  elapsedMs: number;
+  /** decodeMs / audioMs. */
+  realTimeFactor: number;
+}
+
 /**
  * Instance-based STT engine returned by createSTT().
  * Call destroy() when done to free native resources.
  */
 export interface SttEngine {
   readonly instanceId: string;
+  /** False while a `loadInBackground` load is still creating the recognizer. */
+  isReady(): boolean;
+  /**
+   * Resolves with the init result and load timings once the recognizer is loaded (immediately
+   * for a regular init); rejects if the background load failed.
+   */
+  whenReady(): Promise<SttInitResult>;
   transcribeFile(filePath: string): Promise<SttRecognitionResult>;
+  /**
+   * Float samples in [-1, 1]. Typed arrays (Float32Array, or Int16Array PCM) are sent to native
+   * as raw bytes instead of one boxed number per sample, which is much cheaper for long buffers.
+   */
   transcribeSamples(
-    samples: number[],
+    samples: number[] | Float32Array | Int16Array,
     sampleRate: number
   ): Promise<SttRecognitionResult>;
+  /**
+   * Raw mono little-endian PCM as base64, e.g. `base64Pcm` of a PCM live stream chunk
+   * (`createPcmLiveStream().onRawData`), decoded natively without a JS round trip per sample.
+   * Default encoding 'int16'.
+   */
+  transcribePcm(
+    base64Pcm: string,
+    sampleRate: number,
+    encoding?: 'int16' | 'float32'
+  ): Promise<SttRecognitionResult>;
+  /**
+   * Transcribe many files (e.g. a folder of recordings) in length-sorted batches. Files that fail
+   * to read or decode are reported per item without stopping the rest.
+   */
+  transcribeFiles(
+    filePaths: string[],
+    options?: SttBatchOptions
+  ): Promise<SttBatchResult>;
+  /**
+   * Transcribe one long recording (e.g. an hour-long meeting) with models that cannot take it in
+   * one piece: VAD-segmented, decoded in batches, merged with whole-file timestamps.
+   */
+  transcribeLongFile(
+    filePath: string,
+    options: SttLongFormOptions
+  ): Promise<SttLongFormResult>;
   setConfig(options: SttRuntimeConfig): Promise<void>;
   destroy(): Promise<void>;
 }
@@ -1,3 +1,4 @@
+import { DeviceEventEmitter } from 'react-native';
 import SherpaOnnx from '../NativeSherpaOnnx';
 import type {
   TTSInitializeOptions,
@@ -7,13 +8,25 @@ import type {
   TtsGenerationOptions,
   GeneratedAudio,
   GeneratedAudioWithTimestamps,
+  GeneratedAudioFile,
+  TtsFileOptions,
   TTSModelInfo,
   TtsEngine,
+  TtsAudioCacheOptions,
+  TtsAudioCacheStats,
+  TtsStats,
+  TtsStepCalibration,
+  TtsStepCalibrationOptions,
+  TtsExportItem,
+  TtsExportOptions,
+  TtsExportProgress,
+  TtsExportResult,
 } from './types';
 import type { ModelPathConfig } from '../types';
 import { resolveModelPath } from '../utils';
 
 let ttsInstanceCounter = 0;
+let ttsExportCounter = 0;
 
 /**
  * Flatten model-specific options for the given model type to native init/update params.
@@ -129,9 +142,19 @@ function toNativeTtsOptions(
   }
   if (options.referenceText !== undefined)
     out.referenceText = options.referenceText;
+  if (options.promptId !== undefined) out.promptId = options.promptId;
   if (options.numSteps !== undefined) out.numSteps = options.numSteps;
+  if (options.latencyBudgetMs !== undefined)
+    out.latencyBudgetMs = options.latencyBudgetMs;
   if (options.extra != null && Object.keys(options.extra).length > 0)
     out.extra = options.extra;
+  if (options.parallelSentences !== undefined)
+    out.parallelSentences = options.parallelSentences;
+  if (options.sentenceSilenceMs !== undefined)
+    out.sentenceSilenceMs = options.sentenceSilenceMs;
+  if (options.priority !== undefined) out.priority = options.priority;
+  if (options.deadlineMs !== undefined) out.deadlineMs = options.deadlineMs;
+  if (options.tempo !== undefined) out.tempo = options.tempo;
   return out;
 }
 
@@ -168,6 +191,8 @@ export async function createTTS(
   let ruleFars: string | undefined;
   let maxNumSentences: number | undefined;
   let silenceScale: number | undefined;
+  let audioCache: TtsAudioCacheOptions | undefined;
+  let warmUp: boolean | undefined;
 
   if ('modelPath' in options) {
     modelPath = options.modelPath;
@@ -180,6 +205,8 @@ export async function createTTS(
     ruleFars = options.ruleFars;
     maxNumSentences = options.maxNumSentences;
     silenceScale = options.silenceScale;
+    audioCache = options.audioCache;
+    warmUp = options.warmUp;
   } else {
     modelPath = options;
     modelType = undefined;
@@ -191,6 +218,7 @@ export async function createTTS(
     ruleFars = undefined;
     maxNumSentences = undefined;
     silenceScale = undefined;
+    warmUp = undefined;
   }
 
   const flat = flattenTtsModelOptionsForNative(modelType, modelOptions);
@@ -209,7 +237,8 @@ export async function createTTS(
     ruleFars,
     maxNumSentences,
     silenceScale,
-    provider
+    provider,
+    warmUp
   );
 
   if (!result.success) {
@@ -261,6 +290,24 @@ export async function createTTS(
       );
     },
 
+    async generateSpeechToFile(
+      text: string,
+      path: string,
+      opts?: TtsFileOptions
+    ): Promise<GeneratedAudioFile> {
+      guard();
+      const native = toNativeTtsOptions(opts);
+      if (opts?.outputSampleRateHz !== undefined)
+        native.outputSampleRateHz = opts.outputSampleRateHz;
+      return (await SherpaOnnx.generateTtsToFile(
+        instanceId,
+        text,
+        native,
+        path,
+        opts?.format ?? ''
+      )) as GeneratedAudioFile;
+    },
+
     async updateParams(opts: TtsUpdateOptions): Promise<{
       success: boolean;
       detectedModels: Array<{ type: string; modelDir: string }>;
@@ -307,6 +354,114 @@ export async function createTTS(
       return SherpaOnnx.getTtsNumSpeakers(instanceId);
     },
 
+    async configureAudioCache(cacheOpts: TtsAudioCacheOptions): Promise<void> {
+      guard();
+      return SherpaOnnx.configureTtsAudioCache(
+        instanceId,
+        cacheOpts.maxMemoryBytes ?? 16 * 1024 * 1024,
+        cacheOpts.diskDir ?? '',
+        cacheOpts.maxDiskBytes ?? 64 * 1024 * 1024
+      );
+    },
+
+    async getAudioCacheStats(): Promise<TtsAudioCacheStats> {
+      guard();
+      return SherpaOnnx.getTtsAudioCacheStats(instanceId);
+    },
+
+    async clearAudioCache(includeDisk?: boolean): Promise<void> {
+      guard();
+      return SherpaOnnx.clearTtsAudioCache(instanceId, includeDisk ?? false);
+    },
+
+    async getStats(): Promise<TtsStats> {
+      guard();
+      return SherpaOnnx.getTtsStats(instanceId) as Promise<TtsStats>;
+    },
+
+    async resetStats(): Promise<void> {
+      guard();
+      return SherpaOnnx.resetTtsStats(instanceId);
+    },
+
+    async registerVoicePrompt(
+      referenceAudio: { samples: number[]; sampleRate: number },
+      referenceText: string
+    ): Promise<number> {
+      guard();
+      return SherpaOnnx.registerTtsPrompt(
+        instanceId,
+        referenceAudio.samples,
+        referenceAudio.sampleRate,
+        referenceText
+      );
+    },
+
+    async unregisterVoicePrompt(promptId: number): Promise<boolean> {
+      guard();
+      return SherpaOnnx.unregisterTtsPrompt(instanceId, promptId);
+    },
+
+    async calibrateSteps(
+      options: TtsStepCalibrationOptions
+    ): Promise<TtsStepCalibration> {
+      guard();
+      const native = toNativeTtsOptions(options);
+      if (options.text !== undefined) native.text = options.text;
+      return SherpaOnnx.calibrateTtsSteps(
+        instanceId,
+        native
+      ) as Promise<TtsStepCalibration>;
+    },
+
+    async getStepCalibration(): Promise<TtsStepCalibration | null> {
+      guard();
+      return SherpaOnnx.getTtsStepCalibration(
+        instanceId
+      ) as Promise<TtsStepCalibration | null>;
+    },
+
+    async exportToFiles(
+      items: TtsExportItem[],
+      opts?: TtsExportOptions
+    ): Promise<TtsExportResult> {
+      guard();
+      const requestId = `tts_export_${++ttsExportCounter}`;
+      const native = toNativeTtsOptions(opts);
+      if (opts?.outputSampleRateHz !== undefined)
+        native.outputSampleRateHz = opts.outputSampleRateHz;
+      const onProgress = opts?.onProgress;
+      const subscription = onProgress
+        ? DeviceEventEmitter.addListener(
+            'ttsExportProgress',
+            (event: unknown) => {
+              const e = event as TtsExportProgress & {
+                instanceId?: string;
+                requestId?: string;
+              };
+              if (e.instanceId === instanceId && e.requestId === requestId) {
+                onProgress(e);
+              }
+            }
+          )
+        : null;
+      try {
+        return (await SherpaOnnx.exportTtsBatch(
+          instanceId,
+          requestId,
+          items.map((item) => ({ ...item })),
+          native
+        )) as TtsExportResult;
+      } finally {
+        subscription?.remove();
+      }
+    },
+
+    async cancelExport(): Promise<void> {
+      guard();
+      return SherpaOnnx.cancelTtsStream(instanceId);
+    },
+
     async destroy(): Promise<void> {
       if (destroyed) return;
       destroyed = true;
@@ -314,6 +469,10 @@ export async function createTTS(
     },
   };
 
+  if (audioCache) {
+    await engine.configureAudioCache(audioCache);
+  }
+
   return engine;
 }
 
@@ -420,12 +579,29 @@ export type {
   TtsPocketModelOptions,
   TtsUpdateOptions,
   TtsGenerationOptions,
+  TtsRequestPriority,
   GeneratedAudio,
   GeneratedAudioWithTimestamps,
+  GeneratedAudioFile,
+  TtsFileOptions,
   TtsSubtitleItem,
   TTSModelInfo,
   TtsEngine,
+  TtsAudioCacheOptions,
+  TtsAudioCacheStats,
+  TtsRequestStats,
+  TtsStats,
+  TtsStatsHistogram,
+  TtsStepCalibration,
+  TtsStepCalibrationOptions,
+  TtsExportItem,
+  TtsExportOptions,
+  TtsExportItemResult,
+  TtsExportProgress,
+  TtsExportResult,
+  TtsPlaybackStats,
   TtsStreamController,
+  TtsTextSession,
   TtsStreamHandlers,
   TtsStreamChunk,
   TtsStreamEnd,
@@ -10,7 +10,12 @@ import type {
   TtsStreamError,
   TtsStreamHandlers,
   TtsStreamController,
+  TtsTextSession,
   TTSModelInfo,
+  TtsAudioCacheOptions,
+  TtsAudioCacheStats,
+  TtsStats,
+  TtsPlaybackStats,
 } from './types';
 import type { StreamingTtsEngine } from './streamingTypes';
 import type { ModelPathConfig } from '../types';
@@ -95,12 +100,88 @@ function toNativeTtsOptions(
   }
   if (options.referenceText !== undefined)
     out.referenceText = options.referenceText;
+  if (options.promptId !== undefined) out.promptId = options.promptId;
   if (options.numSteps !== undefined) out.numSteps = options.numSteps;
   if (options.extra != null && Object.keys(options.extra).length > 0)
     out.extra = options.extra;
+  if (options.parallelSentences !== undefined)
+    out.parallelSentences = options.parallelSentences;
+  if (options.sentenceSilenceMs !== undefined)
+    out.sentenceSilenceMs = options.sentenceSilenceMs;
+  if (options.priority !== undefined) out.priority = options.priority;
+  if (options.deadlineMs !== undefined) out.deadlineMs = options.deadlineMs;
+  if (options.firstChunkTargetMs !== undefined)
+    out.firstChunkTargetMs = options.firstChunkTargetMs;
+  if (options.tempo !== undefined) out.tempo = options.tempo;
+  if (options.playback !== undefined) out.playback = options.playback;
   return out;
 }
 
+/**
+ * Route chunk/end/error events of one request to its handlers; listeners are removed on end or
+ * error. Resolves with the unsubscribe function once the listeners are registered.
+ */
+async function subscribeToRequest(
+  instanceId: string,
+  requestId: string,
+  handlers: TtsStreamHandlers
+): Promise<() => void> {
+  const subscriptions: Array<{ remove: () => void }> = [];
+  let unsubscribed = false;
+
+  const unsubscribe = () => {
+    if (unsubscribed) return;
+    unsubscribed = true;
+    subscriptions.forEach((sub) => sub.remove());
+  };
+
+  const matchesRequest = (e: { instanceId?: string; requestId?: string }) =>
+    (e.instanceId == null || e.instanceId === instanceId) &&
+    (e.requestId == null || e.requestId === requestId);
+
+  subscriptions.push(
+    DeviceEventEmitter.addListener('ttsStreamChunk', (event: unknown) => {
+      const e = event as TtsStreamChunk;
+      if (!matchesRequest(e)) {
+        return;
+      }
+      handlers.onChunk?.(e);
+    }),
+    DeviceEventEmitter.addListener('ttsStreamEnd', (event: unknown) => {
+      const e = event as TtsStreamEnd;
+      if (!matchesRequest(e)) {
+        return;
+      }
+      try {
+        handlers.onEnd?.(e);
+      } finally {
+        unsubscribe();
+      }
+    }),
+    DeviceEventEmitter.addListener('ttsStreamError', (event: unknown) => {
+      const e = event as TtsStreamError;
+      if (!matchesRequest(e)) {
+        return;
+      }
+      try {
+        handlers.onError?.(e);
+      } finally {
+        unsubscribe();
+      }
+    })
+  );
+
+  // Yield so the bridge can register listeners before native emits (avoids "no listeners" / "already in progress")
+  await new Promise<void>((resolve) => {
+    if (typeof setImmediate === 'function') {
+      setImmediate(resolve);
+    } else {
+      setTimeout(resolve, 0);
+    }
+  });
+  return unsubscribe;
+}
+
 /**
  * Create a streaming TTS engine instance. Use for incremental generation with
  * chunk callbacks and PCM playback. Call destroy() when done.
@@ -135,6 +216,8 @@ export async function createStreamingTTS(
   let ruleFars: string | undefined;
   let maxNumSentences: number | undefined;
   let silenceScale: number | undefined;
+  let audioCache: TtsAudioCacheOptions | undefined;
+  let warmUp: boolean | undefined;
 
   if ('modelPath' in options) {
     modelPath = options.modelPath;
@@ -147,6 +230,8 @@ export async function createStreamingTTS(
     ruleFars = options.ruleFars;
     maxNumSentences = options.maxNumSentences;
     silenceScale = options.silenceScale;
+    audioCache = options.audioCache;
+    warmUp = options.warmUp;
   } else {
     modelPath = options;
     modelType = undefined;
@@ -158,6 +243,7 @@ export async function createStreamingTTS(
     ruleFars = undefined;
     maxNumSentences = undefined;
     silenceScale = undefined;
+    warmUp = undefined;
   }
 
   const flat = flattenTtsModelOptionsForNative(modelType, modelOptions);
@@ -176,7 +262,8 @@ export async function createStreamingTTS(
     ruleFars,
     maxNumSentences,
     silenceScale,
-    provider
+    provider,
+    warmUp
   );
 
   if (!result.success) {
@@ -209,60 +296,12 @@ export async function createStreamingTTS(
     ): Promise<TtsStreamController> {
       guard();
       const requestId = `tts_req_${++ttsRequestIdCounter}`;
-      const subscriptions: Array<{ remove: () => void }> = [];
-      let unsubscribed = false;
-
-      const unsubscribe = () => {
-        if (unsubscribed) return;
-        unsubscribed = true;
-        subscriptions.forEach((sub) => sub.remove());
-      };
-
-      const matchesRequest = (e: { instanceId?: string; requestId?: string }) =>
-        (e.instanceId == null || e.instanceId === instanceId) &&
-        (e.requestId == null || e.requestId === requestId);
-
-      subscriptions.push(
-        DeviceEventEmitter.addListener('ttsStreamChunk', (event: unknown) => {
-          const e = event as TtsStreamChunk;
-          if (!matchesRequest(e)) {
-            return;
-          }
-          handlers.onChunk?.(e);
-        }),
-        DeviceEventEmitter.addListener('ttsStreamEnd', (event: unknown) => {
-          const e = event as TtsStreamEnd;
-          if (!matchesRequest(e)) {
-            return;
-          }
-          try {
-            handlers.onEnd?.(e);
-          } finally {
-            unsubscribe();
-          }
-        }),
-        DeviceEventEmitter.addListener('ttsStreamError', (event: unknown) => {
-          const e = event as TtsStreamError;
-          if (!matchesRequest(e)) {
-            return;
-          }
-          try {
-            handlers.onError?.(e);
-          } finally {
-            unsubscribe();
-          }
-        })
+      const unsubscribe = await subscribeToRequest(
+        instanceId,
+        requestId,
+        handlers
       );
 
-      // Yield so the bridge can register listeners before native emits (avoids "no listeners" / "already in progress")
-      await new Promise<void>((resolve) => {
-        if (typeof setImmediate === 'function') {
-          setImmediate(resolve);
-        } else {
-          setTimeout(resolve, 0);
-        }
-      });
-
       try {
         await SherpaOnnx.generateTtsStream(
           instanceId,
@@ -286,6 +325,53 @@ export async function createStreamingTTS(
       return controller;
     },
 
+    async startSpeechSession(
+      opts: TtsGenerationOptions | undefined,
+      handlers: TtsStreamHandlers
+    ): Promise<TtsTextSession> {
+      guard();
+      const requestId = `tts_req_${++ttsRequestIdCounter}`;
+      const unsubscribe = await subscribeToRequest(
+        instanceId,
+        requestId,
+        handlers
+      );
+
+      try {
+        await SherpaOnnx.startTtsTextStream(
+          instanceId,
+          requestId,
+          toNativeTtsOptions(opts)
+        );
+      } catch (error) {
+        unsubscribe();
+        throw error;
+      }
+
+      const session: TtsTextSession = {
+        async pushText(fragment: string): Promise<void> {
+          guard();
+          if (fragment.length === 0) return;
+          return SherpaOnnx.pushTtsText(instanceId, requestId, fragment);
+        },
+        async flush(): Promise<void> {
+          guard();
+          return SherpaOnnx.flushTtsText(instanceId, requestId);
+        },
+        async close(): Promise<void> {
+          guard();
+          return SherpaOnnx.closeTtsText(instanceId, requestId);
+        },
+        async cancel(): Promise<void> {
+          guard();
+          await SherpaOnnx.cancelTtsStream(instanceId);
+          unsubscribe();
+        },
+        unsubscribe,
+      };
+      return session;
+    },
+
     async cancelSpeechStream(): Promise<void> {
       guard();
       return SherpaOnnx.cancelTtsStream(instanceId);
@@ -306,6 +392,18 @@ export async function createStreamingTTS(
       return SherpaOnnx.stopTtsPcmPlayer(instanceId);
     },
 
+    async setPcmPlayerTempo(tempo: number): Promise<void> {
+      guard();
+      return SherpaOnnx.setTtsPcmPlayerTempo(instanceId, tempo);
+    },
+
+    async getPcmPlayerStats(): Promise<TtsPlaybackStats | null> {
+      guard();
+      return SherpaOnnx.getTtsPlaybackStats(
+        instanceId
+      ) as Promise<TtsPlaybackStats | null>;
+    },
+
     async getModelInfo(): Promise<TTSModelInfo> {
       guard();
       const [sampleRate, numSpeakers] = await Promise.all([
@@ -325,6 +423,36 @@ export async function createStreamingTTS(
       return SherpaOnnx.getTtsNumSpeakers(instanceId);
     },
 
+    async configureAudioCache(cacheOpts: TtsAudioCacheOptions): Promise<void> {
+      guard();
+      return SherpaOnnx.configureTtsAudioCache(
+        instanceId,
+        cacheOpts.maxMemoryBytes ?? 16 * 1024 * 1024,
+        cacheOpts.diskDir ?? '',
+        cacheOpts.maxDiskBytes ?? 64 * 1024 * 1024
+      );
+    },
+
+    async getAudioCacheStats(): Promise<TtsAudioCacheStats> {
+      guard();
+      return SherpaOnnx.getTtsAudioCacheStats(instanceId);
+    },
+
+    async clearAudioCache(includeDisk?: boolean): Promise<void> {
+      guard();
+      return SherpaOnnx.clearTtsAudioCache(instanceId, includeDisk ?? false);
+    },
+
+    async getStats(): Promise<TtsStats> {
+      guard();
+      return SherpaOnnx.getTtsStats(instanceId) as Promise<TtsStats>;
+    },
+
+    async resetStats(): Promise<void> {
+      guard();
+      return SherpaOnnx.resetTtsStats(instanceId);
+    },
+
     async destroy(): Promise<void> {
       if (destroyed) return;
       destroyed = true;
@@ -332,5 +460,9 @@ export async function createStreamingTTS(
     },
   };
 
+  if (audioCache) {
+    await engine.configureAudioCache(audioCache);
+  }
+
   return engine;
 }
@@ -1,8 +1,13 @@
 import type {
   TtsStreamHandlers,
   TtsStreamController,
+  TtsTextSession,
   TtsGenerationOptions,
   TTSModelInfo,
+  TtsAudioCacheOptions,
+  TtsAudioCacheStats,
+  TtsStats,
+  TtsPlaybackStats,
 } from './types';
 
 // Re-export streaming event types for consumers who import from streamingTypes
@@ -12,6 +17,7 @@ export type {
   TtsStreamError,
   TtsStreamHandlers,
   TtsStreamController,
+  TtsTextSession,
   TtsGenerationOptions,
   TTSModelInfo,
 } from './types';
@@ -31,6 +37,15 @@ export interface StreamingTtsEngine {
     handlers: TtsStreamHandlers
   ): Promise<TtsStreamController>;
 
+  /**
+   * Open a session whose text arrives in fragments (e.g. from a streaming LLM) so audio starts
+   * before the full text is known. Uses the engine's stream: only one stream or session at a time.
+   */
+  startSpeechSession(
+    options: TtsGenerationOptions | undefined,
+    handlers: TtsStreamHandlers
+  ): Promise<TtsTextSession>;
+
   /** Cancel the current streaming generation. */
   cancelSpeechStream(): Promise<void>;
 
@@ -40,15 +55,33 @@ export interface StreamingTtsEngine {
   /** Write float PCM samples to the player. Use from onChunk. */
   writePcmChunk(samples: number[]): Promise<void>;
 
-  /** Stop and release the PCM player. */
+  /** Stop and release the PCM player; audio still buffered is dropped. */
   stopPcmPlayer(): Promise<void>;
 
+  /**
+   * Change the player's speed (1 = as generated) without re-synthesis; applies immediately, also
+   * to audio already buffered. Pitch is preserved.
+   */
+  setPcmPlayerTempo(tempo: number): Promise<void>;
+
+  /** Jitter buffer counters of the PCM player (underruns, overruns, fill); null when stopped. */
+  getPcmPlayerStats(): Promise<TtsPlaybackStats | null>;
+
   /** Model sample rate and number of speakers. */
   getModelInfo(): Promise<TTSModelInfo>;
 
   getSampleRate(): Promise<number>;
   getNumSpeakers(): Promise<number>;
 
+  /** Enable or reconfigure the audio cache; a cache hit is delivered as a single chunk. */
+  configureAudioCache(options: TtsAudioCacheOptions): Promise<void>;
+  getAudioCacheStats(): Promise<TtsAudioCacheStats>;
+  clearAudioCache(includeDisk?: boolean): Promise<void>;
+
+  /** Latency / real-time-factor histograms over this engine's requests. */
+  getStats(): Promise<TtsStats>;
+  resetStats(): Promise<void>;
+
   /** Release native TTS resources. Do not use the engine after this. */
   destroy(): Promise<void>;
 }
@@ -151,6 +151,244 @@ export interface TTSInitializeOptions {
    * Default: 0.2.
    */
   silenceScale?: number;
+
+  /**
+   * Enable the synthesized-audio cache right after initialization.
+   * Equivalent to calling `configureAudioCache()` on the returned engine.
+   */
+  audioCache?: TtsAudioCacheOptions;
+
+  /**
+   * Synthesize a short phrase during initialization so the first real request
+   * does not pay for lazy ONNX Runtime setup. Initialization takes
+   * correspondingly longer. Ignored for pocket (needs reference audio).
+   * Default false.
+   */
+  warmUp?: boolean;
+}
+
+/**
+ * Cache of synthesized audio, keyed by model (files + init options), text, sid, speed and
+ * long-text options. Repeated prompts are returned without running the model. Requests with
+ * reference audio (voice cloning) are never cached.
+ */
+export interface TtsAudioCacheOptions {
+  /**
+   * In-memory LRU budget in bytes (float32 samples). 0 disables the memory tier.
+   *
+   * @default 16777216 (16 MB)
+   */
+  maxMemoryBytes?: number;
+
+  /**
+   * Directory for the on-disk tier (16-bit PCM, survives restarts), e.g. a folder under the app
+   * cache directory. Omit for memory only.
+   */
+  diskDir?: string;
+
+  /**
+   * On-disk budget in bytes; least recently used files are removed when exceeded.
+   *
+   * @default 67108864 (64 MB)
+   */
+  maxDiskBytes?: number;
+}
+
+/** Counters and sizes of a TTS instance's audio cache (all zero when disabled). */
+export interface TtsAudioCacheStats {
+  memoryHits: number;
+  diskHits: number;
+  misses: number;
+  insertions: number;
+  evictions: number;
+  memoryBytes: number;
+  memoryEntries: number;
+  diskBytes: number;
+}
+
+/**
+ * Latency and throughput of one TTS request, measured natively. A non-streaming request counts
+ * as a single chunk; a cache hit is measured like any other request.
+ */
+export interface TtsRequestStats {
+  /**
+   * From the moment the request got the engine to the first audio chunk; -1 if no audio was
+   * produced. Time spent queued behind other requests is in queueWaitMs, not here.
+   */
+  timeToFirstChunkMs: number;
+  /** From the moment the request got the engine until all audio was produced. */
+  synthesisMs: number;
+  /** Duration of the produced audio. */
+  audioMs: number;
+  /** synthesisMs / audioMs (below 1 is faster than real time); 0 when no audio was produced. */
+  realTimeFactor: number;
+  chunkCount: number;
+  minChunkSamples: number;
+  meanChunkSamples: number;
+  maxChunkSamples: number;
+  /** PCM bytes copied out of native code on the way to JS (JNI arrays, bridge arrays). */
+  bytesCopied: number;
+}
+
+/**
+ * Fixed-bucket histogram: `counts[i]` counts values up to `upperBounds[i]`; the last entry of
+ * `counts` counts values above every bound. Percentiles are estimated from the buckets.
+ */
+export interface TtsStatsHistogram {
+  count: number;
+  mean: number;
+  min: number;
+  max: number;
+  p50: number;
+  p90: number;
+  p99: number;
+  upperBounds: number[];
+  counts: number[];
+}
+
+/**
+ * Counters of the PCM player's jitter buffer. The player pulls fixed device-sized frames; the
+ * buffer prefills to `targetMs` before playing, raises the target after an underrun and lowers it
+ * again after a few seconds without one.
+ */
+export interface TtsPlaybackStats {
+  samplesIn: number;
+  samplesOut: number;
+  framesOut: number;
+  /** Frames played as silence while prefilling or waiting for audio. */
+  silentFrames: number;
+  /** Times playback ran dry in the middle of an utterance. */
+  underruns: number;
+  /** Times a write found the buffer full and had to wait. */
+  overruns: number;
+  bufferedMs: number;
+  targetMs: number;
+  maxBufferedMs: number;
+  playing: boolean;
+  /** Samples per frame pulled by the audio sink. */
+  frameSamples: number;
+}
+
+/**
+ * Aggregate stats over every request of an engine since it was created or last reset.
+ */
+export interface TtsStats {
+  requests: number;
+  totalAudioMs: number;
+  totalSynthesisMs: number;
+  bytesCopied: number;
+  /** Requests that produced audio only. */
+  timeToFirstChunkMs: TtsStatsHistogram;
+  synthesisMs: TtsStatsHistogram;
+  /** Requests that produced audio only. */
+  realTimeFactor: TtsStatsHistogram;
+  /** Samples per emitted chunk, over all requests. */
+  chunkSamples: TtsStatsHistogram;
+}
+
+/**
+ * Per-device model of Zipvoice synthesis time, from `calibrateSteps()` and later planned requests:
+ * ms = scale * flowSeconds * (overheadMsPerSecond + numSteps * stepMsPerSecond), where flowSeconds
+ * is the prompt plus the estimated generated duration.
+ */
+export interface TtsStepCalibration {
+  /** False until a calibration or a first planned request has been measured. */
+  calibrated: boolean;
+  overheadMsPerSecond: number;
+  stepMsPerSecond: number;
+  /** Running correction from observed requests (1 right after calibrating). */
+  scale: number;
+  observations: number;
+  /** calibrateSteps() only: the measured runs. */
+  flowSeconds?: number;
+  stepsLo?: number;
+  msLo?: number;
+  stepsHi?: number;
+  msHi?: number;
+}
+
+/** Voice and text to time in `calibrateSteps()`; the voice is required. */
+export interface TtsStepCalibrationOptions {
+  /** Sentence to synthesize; a built-in sentence of typical length by default. */
+  text?: string;
+  speed?: number;
+  promptId?: number;
+  referenceAudio?: { samples: number[]; sampleRate: number };
+  referenceText?: string;
+}
+
+/** One paragraph of a batch export (`exportToFiles()`). */
+export interface TtsExportItem {
+  text: string;
+  /** Absolute output path; parent directories must exist. */
+  path: string;
+  /**
+   * 'wav' (written at the model's sample rate), or any format `convertAudioToFormat()` encodes
+   * ('mp3', 'flac', ...; needs the FFmpeg prebuilts). Defaults to the path's extension.
+   */
+  format?: string;
+}
+
+export interface TtsExportOptions extends TtsGenerationOptions {
+  /** MP3 output rate (32000 / 44100 / 48000; default 44100), as in `convertAudioToFormat()`. */
+  outputSampleRateHz?: number;
+  /** Called from the progress event as each item is written (or fails). */
+  onProgress?: (progress: TtsExportProgress) => void;
+}
+
+/** Outcome of one exported item. */
+export interface TtsExportItemResult {
+  index: number;
+  path: string;
+  success: boolean;
+  error?: string;
+  sampleRate?: number;
+  /** Audio written, after tempo. */
+  durationMs?: number;
+  /** Time spent encoding and writing this item (off the synthesis thread). */
+  encodeMs: number;
+}
+
+export interface TtsExportProgress extends TtsExportItemResult {
+  /** Items finished so far, including failures. */
+  completed: number;
+  total: number;
+}
+
+export interface TtsExportResult {
+  /** Finished items by index; items skipped after a cancel or deadline are absent. */
+  items: TtsExportItemResult[];
+  succeeded: number;
+  failed: number;
+  total: number;
+  cancelled: boolean;
+  /** The request's deadlineMs passed before every item was synthesized. */
+  expired: boolean;
+  elapsedMs: number;
+  queueWaitMs: number;
+  stats?: TtsRequestStats;
+}
+
+/** Options for `generateSpeechToFile()`. */
+export interface TtsFileOptions extends TtsGenerationOptions {
+  /** 'wav' or any format `convertAudioToFormat()` encodes; defaults to the path's extension. */
+  format?: string;
+  /** MP3 output rate (32000 / 44100 / 48000; default 44100), as in `convertAudioToFormat()`. */
+  outputSampleRateHz?: number;
+}
+
+/** Metadata of a file written by `generateSpeechToFile()`; the samples stay native. */
+export interface GeneratedAudioFile {
+  path: string;
+  /** Resolved output format ('wav', 'mp3', ...). */
+  format: string;
+  /** Rate of the synthesized audio (the WAV rate; MP3 may be resampled to outputSampleRateHz). */
+  sampleRate: number;
+  /** Samples written, after tempo. */
+  numSamples: number;
+  durationMs: number;
+  queueWaitMs?: number;
+  stats?: TtsRequestStats;
 }
 
 /**
@@ -214,19 +452,107 @@ export interface TtsGenerationOptions {
    */
   referenceText?: string;
 
+  /**
+   * Id of a reference prompt registered with `registerVoicePrompt()` (Zipvoice, Android). Used
+   * instead of `referenceAudio` / `referenceText`; the prompt is not sent again. Not supported in
+   * streaming.
+   */
+  promptId?: number;
+
   /**
    * Number of steps, e.g. flow-matching steps (Kotlin GenerationConfig.numSteps).
    * Used by models such as Pocket.
    */
   numSteps?: number;
 
+  /**
+   * Zipvoice voice cloning (Android): target synthesis time in ms. The largest flow-step count
+   * predicted to finish within it is used (`numSteps`, if set, is the upper bound; at least 4).
+   * Predictions come from `calibrateSteps()`, refined by every planned request; without a
+   * calibration the first request runs at `numSteps` and seeds the model. The chosen count is
+   * reported as `numSteps` in the result.
+   */
+  latencyBudgetMs?: number;
+
   /**
    * Extra options as key-value pairs (Kotlin GenerationConfig.extra).
    * Model-specific (e.g. temperature, chunk_size for Pocket).
    */
   extra?: Record<string, string>;
+
+  /**
+   * Long-text mode: split the text into sentences and synthesize them on this many engine
+   * instances in parallel, reassembling audio in order. In streaming, chunks are emitted as soon
+   * as each prefix of sentences is complete. Each extra engine loads another copy of the model.
+   * Supported on iOS and for Zipvoice on Android; ignored with reference audio. The pipeline holds
+   * a shared engine until the whole text is done: it does not yield between sentences, whatever
+   * its `priority`.
+   *
+   * @default 1 (regular generation)
+   */
+  parallelSentences?: number;
+
+  /**
+   * Silence in milliseconds inserted between sentences in long-text mode (`parallelSentences` > 1).
+   *
+   * @default 0
+   */
+  sentenceSilenceMs?: number;
+
+  /**
+   * Streaming only: time-to-first-audio target in milliseconds. When set, a short leading clause
+   * (split at punctuation or a word boundary) is synthesized first and the rest right after it,
+   * so the first chunk arrives sooner. The clause length adapts to measured synthesis speed to
+   * meet the target. Ignored with reference audio. `onEnd` reports the result as
+   * `timeToFirstAudioMs`.
+   *
+   * @default undefined (disabled)
+   */
+  firstChunkTargetMs?: number;
+
+  /**
+   * Playback speed applied after synthesis by pitch-preserving time-stretching (WSOLA): 2 is twice
+   * as fast, 0.5 half as fast (clamped to 0.25..4). Unlike `speed`, the model runs at its normal
+   * rate, so a tempo change never re-synthesizes and cached audio is reused at any tempo.
+   * Timestamps follow the stretched audio.
+   *
+   * @default 1
+   */
+  tempo?: number;
+
+  /**
+   * Streaming only: also feed every chunk natively into this engine's PCM player
+   * (`startPcmPlayer()`), so playback does not wait for a JS round trip per chunk. Chunks are
+   * still delivered to `onChunk`; do not also write them with `writePcmChunk()`. Ignored (with a
+   * warning) when the player is not running or runs at a different sample rate.
+   *
+   * @default false
+   */
+  playback?: boolean;
+
+  /**
+   * Scheduling priority when several instances share one engine (see `createTTS()`). Waiting
+   * requests run highest priority first, then earliest deadline, then in arrival order. A `batch`
+   * request (generate, stream or file output) gives the engine back after every sentence, so an
+   * `interactive` request waits at most one sentence (not in parallel mode, see `parallelSentences`).
+   *
+   * @default 'normal'
+   */
+  priority?: TtsRequestPriority;
+
+  /**
+   * Deadline in milliseconds from the call. A request still queued at its deadline, or still
+   * generating, is stopped and rejected with `TTS_DEADLINE_EXCEEDED` (streaming: `onError`, then
+   * `onEnd`).
+   *
+   * @default undefined (none)
+   */
+  deadlineMs?: number;
 }
 
+/** Priority of a TTS request on a shared engine. */
+export type TtsRequestPriority = 'interactive' | 'normal' | 'batch';
+
 /**
  * Generated audio data from TTS synthesis.
  *
@@ -246,6 +572,18 @@ export interface GeneratedAudio {
    * Common values: 16000, 22050, 44100, 48000
    */
   sampleRate: number;
+
+  /** Native time the request waited for a shared engine before synthesis, in ms. */
+  queueWaitMs?: number;
+
+  /** Latency / real-time-factor measurements of this request. */
+  stats?: TtsRequestStats;
+
+  /** Flow steps used when `latencyBudgetMs` planned them (Zipvoice, Android). */
+  numSteps?: number;
+
+  /** Predicted synthesis time of the planned steps in ms, for comparison with `stats`. */
+  predictedMs?: number;
 }
 
 /**
@@ -306,6 +644,12 @@ export interface TtsStreamEnd {
   /** Request ID for this generation. */
   requestId?: string;
   cancelled: boolean;
+  /** Native time from the start of generation to the first audio chunk; absent if none was produced. */
+  timeToFirstAudioMs?: number;
+  /** Native time the stream waited for a shared engine, in ms. */
+  queueWaitMs?: number;
+  /** Latency / real-time-factor measurements of this stream (absent if it failed to start). */
+  stats?: TtsRequestStats;
 }
 
 /**
@@ -330,6 +674,20 @@ export interface TtsStreamController {
   unsubscribe(): void;
 }
 
+/**
+ * Incremental text input for streaming TTS, from `startSpeechSession()`. Push text as it arrives
+ * (e.g. LLM tokens); each sentence, or a clause of a long one, is synthesized as soon as it is
+ * complete and audio arrives through the session's handlers in order. `cancel()` stops it.
+ */
+export interface TtsTextSession extends TtsStreamController {
+  /** Append a fragment; whitespace is kept, so pass tokens as they come. */
+  pushText(fragment: string): Promise<void>;
+  /** Synthesize the text pushed so far without waiting for a sentence end (e.g. the LLM paused). */
+  flush(): Promise<void>;
+  /** No more text: the rest is synthesized, then `onEnd` fires. */
+  close(): Promise<void>;
+}
+
 /**
  * Handlers for TTS streaming generation (chunk, end, error).
  */
@@ -355,6 +713,15 @@ export interface TtsEngine {
     text: string,
     options?: TtsGenerationOptions
   ): Promise<GeneratedAudioWithTimestamps>;
+  /**
+   * Synthesize straight into a file: chunks are written natively as they are generated, so memory
+   * stays flat for long texts and only metadata crosses the bridge.
+   */
+  generateSpeechToFile(
+    text: string,
+    path: string,
+    options?: TtsFileOptions
+  ): Promise<GeneratedAudioFile>;
   updateParams(options: TtsUpdateOptions): Promise<{
     success: boolean;
     detectedModels: Array<{ type: string; modelDir: string }>;
@@ -362,6 +729,45 @@ export interface TtsEngine {
   getModelInfo(): Promise<TTSModelInfo>;
   getSampleRate(): Promise<number>;
   getNumSpeakers(): Promise<number>;
+  /** Enable or reconfigure the audio cache; pass `{ maxMemoryBytes: 0 }` to disable it. */
+  configureAudioCache(options: TtsAudioCacheOptions): Promise<void>;
+  getAudioCacheStats(): Promise<TtsAudioCacheStats>;
+  /** Drop cached audio (memory; also disk when includeDisk is true). */
+  clearAudioCache(includeDisk?: boolean): Promise<void>;
+  /** Latency / real-time-factor histograms over this engine's requests. */
+  getStats(): Promise<TtsStats>;
+  resetStats(): Promise<void>;
+  /**
+   * Register a reference voice once for repeated cloning (Zipvoice, Android) and return its id,
+   * to be passed as `promptId` in generation options. Prompts are dropped on `updateParams()`
+   * and `destroy()`.
+   */
+  registerVoicePrompt(
+    referenceAudio: { samples: number[]; sampleRate: number },
+    referenceText: string
+  ): Promise<number>;
+  /** Forget a registered prompt; resolves false if the id is unknown. */
+  unregisterVoicePrompt(promptId: number): Promise<boolean>;
+  /**
+   * Time voice cloning at two step counts on this device so `latencyBudgetMs` can choose
+   * num_steps (Zipvoice, Android). Stored per model and init options, and restored on load.
+   */
+  calibrateSteps(
+    options: TtsStepCalibrationOptions
+  ): Promise<TtsStepCalibration>;
+  /** Current step-time model, or null when not Zipvoice. */
+  getStepCalibration(): Promise<TtsStepCalibration | null>;
+  /**
+   * Synthesize many texts straight to files (e.g. audiobook paragraphs). Samples never cross the
+   * bridge, and each item is encoded on a native writer thread while the next is synthesized.
+   * Uses the engine's stream slot: one export (or stream) at a time per engine.
+   */
+  exportToFiles(
+    items: TtsExportItem[],
+    options?: TtsExportOptions
+  ): Promise<TtsExportResult>;
+  /** Stop a running `exportToFiles()` after the item in progress; it resolves with `cancelled`. */
+  cancelExport(): Promise<void>;
   destroy(): Promise<void>;
 }
 
@@ -0,0 +1,185 @@
+/**
+ * engine_registry_test.cpp
+ *
+ * Host-side GTest suite for the shared engine registry (ios/common/sherpa-onnx-engine-registry.h):
+ * reuse per key, destruction with the last holder, failed loads, racing acquires, and loads of
+ * different keys running in parallel.
+ */
+
+#include "sherpa-onnx-engine-registry.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace sherpaonnx;
+
+namespace {
+
+std::atomic<int> g_live{0};
+
+// Move-only stand-in for OfflineTts / OfflineRecognizer that counts live instances.
+struct FakeEngine {
+  explicit FakeEngine(int v) : value(v) { ++g_live; }
+  FakeEngine(FakeEngine&& o) noexcept : value(o.value), owned(o.owned) { o.owned = false; }
+  FakeEngine(const FakeEngine&) = delete;
+  ~FakeEngine() {
+    if (owned) --g_live;
+  }
+  int value;
+  bool owned = true;
+};
+
+using Registry = SharedEngineRegistry<FakeEngine>;
+
+}  // namespace
+
+TEST(EngineRegistry, SameKeyReturnsSameEngine) {
+  Registry reg;
+  int creates = 0;
+  auto make = [&]() -> std::optional<FakeEngine> { ++creates; return FakeEngine(7); };
+  bool reused = true;
+  Registry::Handle a = reg.Acquire("k", make, &reused);
+  EXPECT_FALSE(reused);
+  Registry::Handle b = reg.Acquire("k", make, &reused);
+  EXPECT_TRUE(reused);
+  ASSERT_TRUE(a && b);
+  EXPECT_EQ(a.get(), b.get());
+  EXPECT_EQ(creates, 1);
+  EXPECT_EQ(reg.UseCount("k"), 2);
+  EXPECT_EQ(reg.Size(), 1u);
+}
+
+TEST(EngineRegistry, DistinctKeysLoadSeparately) {
+  Registry reg;
+  Registry::Handle a = reg.Acquire("a", [] { return std::optional<FakeEngine>(FakeEngine(1)); });
+  Registry::Handle b = reg.Acquire("b", [] { return std::optional<FakeEngine>(FakeEngine(2)); });
+  ASSERT_TRUE(a && b);
+  EXPECT_NE(a.get(), b.get());
+  EXPECT_EQ(a->engine.value, 1);
+  EXPECT_EQ(b->engine.value, 2);
+  EXPECT_EQ(reg.Size(), 2u);
+}
+
+TEST(EngineRegistry, EngineDestroyedWithLastHolder) {
+  const int before = g_live.load();
+  Registry reg;
+  auto make = [] { return std::optional<FakeEngine>(FakeEngine(3)); };
+  Registry::Handle a = reg.Acquire("k", make);
+  Registry::Handle b = reg.Acquire("k", make);
+  EXPECT_EQ(g_live.load(), before + 1);
+  a.reset();
+  EXPECT_EQ(g_live.load(), before + 1);
+  b.reset();
+  EXPECT_EQ(g_live.load(), before);
+  EXPECT_EQ(reg.UseCount("k"), 0);
+  EXPECT_EQ(reg.Size(), 0u);
+
+  // A new acquire after release loads a fresh engine.
+  bool reused = true;
+  Registry::Handle c = reg.Acquire("k", make, &reused);
+  EXPECT_FALSE(reused);
+  EXPECT_EQ(g_live.load(), before + 1);
+}
+
+TEST(EngineRegistry, FailedLoadIsNotCached) {
+  Registry reg;
+  Registry::Handle h = reg.Acquire("k", [] { return std::optional<FakeEngine>(); });
+  EXPECT_EQ(h, nullptr);
+  EXPECT_EQ(reg.Size(), 0u);
+  h = reg.Acquire("k", [] { return std::optional<FakeEngine>(FakeEngine(4)); });
+  ASSERT_TRUE(h);
+  EXPECT_EQ(h->engine.value, 4);
+}
+
+TEST(EngineRegistry, ConcurrentAcquireLoadsOnce) {
+  Registry reg;
+  std::atomic<int> creates{0};
+  std::vector<Registry::Handle> handles(8);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < handles.size(); ++t) {
+    threads.emplace_back([&, t] {
+      handles[t] = reg.Acquire("k", [&] {
+        ++creates;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return std::optional<FakeEngine>(FakeEngine(5));
+      });
+    });
+  }
+  for (auto& th : threads) th.join();
+  EXPECT_EQ(creates.load(), 1);
+  for (const auto& h : handles) EXPECT_EQ(h.get(), handles[0].get());
+  EXPECT_EQ(reg.UseCount("k"), static_cast<long>(handles.size()));
+}
+
+TEST(EngineRegistry, SlowLoadDoesNotBlockOtherKeys) {
+  Registry reg;
+  std::atomic<bool> slowStarted{false};
+  std::atomic<bool> releaseSlow{false};
+  std::thread slow([&] {
+    reg.Acquire("slow", [&] {
+      slowStarted = true;
+      while (!releaseSlow) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return std::optional<FakeEngine>(FakeEngine(7));
+    });
+  });
+  while (!slowStarted) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  // Another key loads (and an existing one is looked up) while "slow" is still loading.
+  bool reused = true;
+  Registry::Handle fast =
+      reg.Acquire("fast", [] { return std::optional<FakeEngine>(FakeEngine(8)); }, &reused);
+  ASSERT_TRUE(fast);
+  EXPECT_FALSE(reused);
+  EXPECT_EQ(reg.UseCount("slow"), 0);
+
+  releaseSlow = true;
+  slow.join();
+  EXPECT_EQ(reg.Size(), 1u);  // the slow thread dropped its handle
+}
+
+TEST(EngineRegistry, WaiterLoadsAgainAfterFailedLoad) {
+  Registry reg;
+  std::atomic<bool> firstStarted{false};
+  std::atomic<bool> failFirst{false};
+  std::atomic<int> creates{0};
+  Registry::Handle first;
+  std::thread loader([&] {
+    first = reg.Acquire("k", [&] {
+      ++creates;
+      firstStarted = true;
+      while (!failFirst) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return std::optional<FakeEngine>();
+    });
+  });
+  while (!firstStarted) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  std::thread waiter([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    failFirst = true;
+  });
+  bool reused = true;
+  Registry::Handle second = reg.Acquire("k", [&] {
+    ++creates;
+    return std::optional<FakeEngine>(FakeEngine(9));
+  }, &reused);
+  loader.join();
+  waiter.join();
+  EXPECT_FALSE(first);
+  ASSERT_TRUE(second);
+  EXPECT_FALSE(reused);
+  EXPECT_EQ(creates.load(), 2);
+}
+
+TEST(EngineRegistry, SettingsIdsAreUniqueAndNonZero) {
+  const uint64_t a = Registry::NextSettingsId();
+  const uint64_t b = Registry::NextSettingsId();
+  EXPECT_NE(a, 0u);
+  EXPECT_GT(b, a);
+  Registry reg;
+  Registry::Handle h = reg.Acquire("k", [] { return std::optional<FakeEngine>(FakeEngine(6)); });
+  ASSERT_TRUE(h);
+  EXPECT_EQ(h->appliedSettings, 0u);
+}
@@ -0,0 +1,191 @@
+/**
+ * engine_scheduler_test.cpp
+ *
+ * Host-side GTest suite for the per-engine request scheduler (sherpa-onnx-engine-scheduler.*):
+ * priority and deadline ordering, yielding between chunks, cancellation and deadline expiry while
+ * queued, and queue-wait accounting.
+ */
+
+#include "sherpa-onnx-engine-scheduler.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace sherpaonnx;
+using Status = EngineScheduler::Status;
+
+namespace {
+
+// Wait until n requests are queued behind the current holder.
+void WaitForWaiting(const EngineScheduler& s, size_t n) {
+  for (int i = 0; i < 2000 && s.Waiting() < n; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(s.Waiting(), n);
+}
+
+}  // namespace
+
+TEST(EngineScheduler, ParsePriority) {
+  EXPECT_EQ(ParseRequestPriority("interactive"), kRequestPriorityInteractive);
+  EXPECT_EQ(ParseRequestPriority("batch"), kRequestPriorityBatch);
+  EXPECT_EQ(ParseRequestPriority("normal"), kRequestPriorityNormal);
+  EXPECT_EQ(ParseRequestPriority("bogus"), kRequestPriorityNormal);
+  EXPECT_EQ(ParseRequestPriority(nullptr), kRequestPriorityNormal);
+}
+
+TEST(EngineScheduler, UncontendedAcquireIsImmediate) {
+  EngineScheduler s;
+  const uint64_t id = s.Submit(kRequestPriorityNormal);
+  EXPECT_EQ(s.Acquire(id), Status::kOk);
+  EXPECT_FALSE(s.ShouldYield(id));
+  EXPECT_FALSE(s.ShouldStop(id));
+  s.Release(id);
+  EXPECT_LT(s.Finish(id), 50);
+  EXPECT_EQ(s.Acquire(id), Status::kUnknown);
+}
+
+TEST(EngineScheduler, ScopedRequestFinishesOnExit) {
+  EngineScheduler s;
+  uint64_t id = 0;
+  {
+    ScopedEngineRequest request(s, kRequestPriorityBatch);
+    id = request.id();
+    EXPECT_EQ(s.PriorityOf(id), kRequestPriorityBatch);
+    ScopedEngineSlot slot(s, id);
+    EXPECT_TRUE(slot.ok());
+  }
+  EXPECT_EQ(s.Acquire(id), Status::kUnknown);
+  // The engine is free again for the next request.
+  ScopedEngineRequest next(s, kRequestPriorityNormal);
+  ScopedEngineSlot slot(s, next.id());
+  EXPECT_TRUE(slot.ok());
+}
+
+TEST(EngineScheduler, GrantsByPriorityThenDeadlineThenArrival) {
+  EngineScheduler s;
+  const uint64_t holder = s.Submit(kRequestPriorityNormal);
+  ASSERT_EQ(s.Acquire(holder), Status::kOk);
+
+  const uint64_t batch = s.Submit(kRequestPriorityBatch);
+  const uint64_t normalLate = s.Submit(kRequestPriorityNormal);
+  const uint64_t normalEarly = s.Submit(kRequestPriorityNormal, 60000);
+  const uint64_t interactive = s.Submit(kRequestPriorityInteractive);
+
+  std::mutex orderMutex;
+  std::vector<uint64_t> order;
+  std::vector<std::thread> threads;
+  for (uint64_t id : {batch, normalLate, normalEarly, interactive}) {
+    threads.emplace_back([&, id] {
+      ASSERT_EQ(s.Acquire(id), Status::kOk);
+      {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back(id);
+      }
+      s.Finish(id);
+    });
+  }
+  WaitForWaiting(s, 4);
+  EXPECT_TRUE(s.ShouldYield(holder));
+  s.Finish(holder);
+  for (auto& t : threads) t.join();
+
+  EXPECT_EQ(order, (std::vector<uint64_t>{interactive, normalEarly, normalLate, batch}));
+}
+
+TEST(EngineScheduler, InteractivePreemptsBatchBetweenChunks) {
+  EngineScheduler s;
+  const uint64_t batch = s.Submit(kRequestPriorityBatch);
+  std::atomic<int> batchChunks{0};
+  std::atomic<int> chunksBeforeInteractive{-1};
+
+  const uint64_t interactive = s.Submit(kRequestPriorityInteractive);
+  std::thread batchThread([&] {
+    for (int chunk = 0; chunk < 20; ++chunk) {
+      ScopedEngineSlot slot(s, batch);
+      ASSERT_TRUE(slot.ok());
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      ++batchChunks;
+    }
+    s.Finish(batch);
+  });
+  // Let the batch request get going, then queue the interactive one.
+  while (batchChunks.load() < 2) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  ASSERT_EQ(s.Acquire(interactive), Status::kOk);
+  chunksBeforeInteractive = batchChunks.load();
+  s.Finish(interactive);
+  batchThread.join();
+
+  EXPECT_EQ(batchChunks.load(), 20);
+  // Granted at the next chunk boundary, not after the whole batch request.
+  EXPECT_LT(chunksBeforeInteractive.load(), 20);
+}
+
+TEST(EngineScheduler, CancelWakesQueuedRequest) {
+  EngineScheduler s;
+  const uint64_t holder = s.Submit(kRequestPriorityNormal);
+  ASSERT_EQ(s.Acquire(holder), Status::kOk);
+  const uint64_t queued = s.Submit(kRequestPriorityNormal);
+  Status result = Status::kOk;
+  std::thread t([&] { result = s.Acquire(queued); });
+  WaitForWaiting(s, 1);
+  EXPECT_TRUE(s.Cancel(queued));
+  t.join();
+  EXPECT_EQ(result, Status::kCancelled);
+  EXPECT_TRUE(s.ShouldStop(queued));
+  EXPECT_FALSE(s.Cancel(12345));
+  s.Finish(queued);
+  s.Finish(holder);
+}
+
+TEST(EngineScheduler, DeadlineExpiresWhileQueued) {
+  EngineScheduler s;
+  const uint64_t holder = s.Submit(kRequestPriorityNormal);
+  ASSERT_EQ(s.Acquire(holder), Status::kOk);
+  const uint64_t queued = s.Submit(kRequestPriorityInteractive, 30);
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(s.Acquire(queued), Status::kExpired);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_GE(elapsed, std::chrono::milliseconds(25));
+  EXPECT_TRUE(s.ShouldStop(queued));
+  EXPECT_GE(s.QueueWaitMs(queued), 25);
+  s.Finish(queued);
+  s.Finish(holder);
+}
+
+TEST(EngineScheduler, ReportsQueueWait) {
+  EngineScheduler s;
+  const uint64_t holder = s.Submit(kRequestPriorityNormal);
+  ASSERT_EQ(s.Acquire(holder), Status::kOk);
+  const uint64_t queued = s.Submit(kRequestPriorityNormal);
+  std::thread t([&] { EXPECT_EQ(s.Acquire(queued), Status::kOk); });
+  WaitForWaiting(s, 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  s.Finish(holder);
+  t.join();
+  EXPECT_GE(s.Finish(queued), 25);
+}
+
+TEST(EngineScheduler, CancelAllFailsEveryWaiter) {
+  EngineScheduler s;
+  const uint64_t holder = s.Submit(kRequestPriorityNormal);
+  ASSERT_EQ(s.Acquire(holder), Status::kOk);
+  std::vector<uint64_t> ids;
+  for (int i = 0; i < 4; ++i) ids.push_back(s.Submit(kRequestPriorityBatch));
+  std::atomic<int> cancelled{0};
+  std::vector<std::thread> threads;
+  for (uint64_t id : ids) {
+    threads.emplace_back([&, id] {
+      if (s.Acquire(id) == Status::kCancelled) ++cancelled;
+    });
+  }
+  WaitForWaiting(s, ids.size());
+  s.CancelAll();
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(cancelled.load(), 4);
+  EXPECT_TRUE(s.ShouldStop(holder));
+}
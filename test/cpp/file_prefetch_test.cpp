@@ -0,0 +1,70 @@
+/**
+ * file_prefetch_test.cpp
+ *
+ * Host-side GTest suite for model-file prefetching (sherpa-onnx-file-prefetch.*): which files of a
+ * model directory are listed and in what order, and the stats reported for read-ahead hints.
+ */
+
+#include "sherpa-onnx-file-prefetch.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace sherpaonnx;
+namespace fs = std::filesystem;
+
+namespace {
+
+void WriteBytes(const fs::path& path, size_t n) {
+  std::ofstream out(path, std::ios::binary);
+  out << std::string(n, 'x');
+}
+
+class FilePrefetchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    dir_ = fs::temp_directory_path() / ("file_prefetch_" + std::to_string(stamp));
+    fs::create_directories(dir_ / "sub" / "deeper");
+  }
+  void TearDown() override { fs::remove_all(dir_); }
+
+  fs::path dir_;
+};
+
+}  // namespace
+
+TEST_F(FilePrefetchTest, ListsModelFilesLargestFirst) {
+  WriteBytes(dir_ / "tokens.txt", 10);
+  WriteBytes(dir_ / "encoder.int8.onnx", 3000);
+  WriteBytes(dir_ / "README.md", 5000);
+  WriteBytes(dir_ / "sub" / "decoder.ONNX", 2000);
+  WriteBytes(dir_ / "sub" / "deeper" / "ignored.onnx", 9000);
+
+  const auto files = ListModelFiles(dir_.string());
+  ASSERT_EQ(files.size(), 3u);
+  EXPECT_EQ(fs::path(files[0]).filename(), "encoder.int8.onnx");
+  EXPECT_EQ(fs::path(files[1]).filename(), "decoder.ONNX");
+  EXPECT_EQ(fs::path(files[2]).filename(), "tokens.txt");
+}
+
+TEST_F(FilePrefetchTest, ReportsPrefetchedFilesAndSkipsMissing) {
+  WriteBytes(dir_ / "model.onnx", 4096);
+  WriteBytes(dir_ / "tokens.txt", 100);
+  auto files = ListModelFiles(dir_.string());
+  files.push_back((dir_ / "missing.onnx").string());
+
+  const PrefetchStats stats = PrefetchFiles(files);
+  EXPECT_EQ(stats.files, 2);
+  EXPECT_EQ(stats.bytes, 4196);
+  EXPECT_GE(stats.elapsedMs, 0);
+}
+
+TEST(FilePrefetch, MissingDirectoryIsEmpty) {
+  EXPECT_TRUE(ListModelFiles("/definitely/not/a/model/dir").empty());
+  EXPECT_TRUE(ListModelFiles("").empty());
+  EXPECT_EQ(PrefetchFiles({}).files, 0);
+}
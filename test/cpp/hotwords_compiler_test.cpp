@@ -0,0 +1,196 @@
+/**
+ * hotwords_compiler_test.cpp
+ *
+ * Host-side GTest suite for the hotwords compiler (sherpa-onnx-hotwords-compiler.*): format
+ * validation, the vocabulary check per modeling unit, de-duplication, the content-keyed file cache
+ * and the per-stream string form.
+ */
+
+#include "sherpa-onnx-hotwords-compiler.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace sherpaonnx;
+namespace fs = std::filesystem;
+
+namespace {
+
+class HotwordsCompilerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    dir_ = fs::temp_directory_path() / ("hotwords_compiler_" + std::to_string(stamp));
+    fs::create_directories(dir_);
+    options_.tokensPath = Write("tokens.txt",
+                                "<blk> 0\n"
+                                "\xe2\x96\x81SHER 1\nPA 2\n\xe2\x96\x81ONNX 3\n\xe2\x96\x81REACT 4\n"
+                                "\xe2\x96\x81NATIVE 5\n\xe4\xbd\xa0 6\n\xe5\xa5\xbd 7\n");
+    options_.modelingUnit = "bpe";
+    options_.cacheDir = (dir_ / "cache").string();
+  }
+
+  void TearDown() override { fs::remove_all(dir_); }
+
+  std::string Write(const std::string& name, const std::string& content) {
+    const fs::path p = dir_ / name;
+    std::ofstream(p, std::ios::binary) << content;
+    return p.string();
+  }
+
+  static std::string ReadAll(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  fs::path dir_;
+  HotwordsCompileOptions options_;
+};
+
+}  // namespace
+
+TEST_F(HotwordsCompilerTest, RejectsMalformedFiles) {
+  EXPECT_NE(CompileHotwordsFile((dir_ / "missing.txt").string(), options_).error.find("does not exist"),
+            std::string::npos);
+  EXPECT_NE(CompileHotwordsFile(Write("nul.txt", std::string("a\0b", 3)), options_).error.find("null bytes"),
+            std::string::npos);
+  EXPECT_NE(CompileHotwordsFile(Write("score.txt", "sherpa :high\n"), options_).error.find("score must be a number"),
+            std::string::npos);
+  EXPECT_NE(CompileHotwordsFile(Write("vocab.txt", "\xe2\x96\x81the\t-3.2\n"), options_).error.find(".vocab"),
+            std::string::npos);
+  EXPECT_NE(CompileHotwordsFile(Write("digits.txt", "1234\n"), options_).error.find("at least one letter"),
+            std::string::npos);
+  EXPECT_NE(CompileHotwordsFile(Write("empty.txt", "\n  \n"), options_).error.find("no valid lines"),
+            std::string::npos);
+}
+
+TEST_F(HotwordsCompilerTest, DropsOutOfVocabularyLinesAndMergesDuplicates) {
+  const std::string path = Write("hotwords.txt",
+                                 "sherpa onnx :3\n"
+                                 "react   native\n"
+                                 "SHERPA ONNX :4.5\n"
+                                 "zipformer :2\n");
+  const HotwordsCompileResult r = CompileHotwordsFile(path, options_);
+  ASSERT_TRUE(r.ok) << r.error;
+  EXPECT_TRUE(r.vocabChecked);
+  EXPECT_FALSE(r.cached);
+  EXPECT_EQ(r.entries, 3);
+  EXPECT_EQ(r.duplicates, 0);
+  EXPECT_EQ(r.oovLines, 1);
+  ASSERT_EQ(r.oovSamples.size(), 1u);
+  EXPECT_EQ(r.oovSamples[0], "zipformer");
+  EXPECT_EQ(ReadAll(r.compiledPath), "sherpa onnx :3\nreact native\nSHERPA ONNX :4.5\n");
+
+  const HotwordsCompileResult dup = CompileHotwordsFile(Write("dup.txt", "react native\nreact native :2\n"), options_);
+  ASSERT_TRUE(dup.ok) << dup.error;
+  EXPECT_EQ(dup.duplicates, 1);
+  EXPECT_EQ(ReadAll(dup.compiledPath), "react native :2\n");
+
+  EXPECT_FALSE(CompileHotwordsFile(Write("oov.txt", "zipformer\n"), options_).ok);
+}
+
+TEST_F(HotwordsCompilerTest, CharacterUnitsCheckEachCharacter) {
+  options_.modelingUnit = "cjkchar";
+  const HotwordsCompileResult r =
+      CompileHotwordsFile(Write("cjk.txt", "\xe4\xbd\xa0\xe5\xa5\xbd\n\xe4\xbd\xa0\xe4\xbb\xac\n"), options_);
+  ASSERT_TRUE(r.ok) << r.error;
+  EXPECT_EQ(r.entries, 1);
+  EXPECT_EQ(r.oovLines, 1);
+
+  options_.modelingUnit = "cjkchar+bpe";
+  const HotwordsCompileResult mixed = CompileHotwordsFile(Write("mixed.txt", "\xe4\xbd\xa0\xe5\xa5\xbd onnx\n"), options_);
+  ASSERT_TRUE(mixed.ok) << mixed.error;
+  EXPECT_EQ(mixed.oovLines, 0);
+}
+
+TEST_F(HotwordsCompilerTest, ReusesCompiledFileForSameContentAndVocabulary) {
+  const std::string first = Write("a.txt", "sherpa onnx :3\n");
+  const HotwordsCompileResult r1 = CompileHotwordsFile(first, options_);
+  ASSERT_TRUE(r1.ok) << r1.error;
+
+  // Same content under another name: cache hit with the same counts.
+  const HotwordsCompileResult r2 = CompileHotwordsFile(Write("b.txt", "sherpa onnx :3\n"), options_);
+  ASSERT_TRUE(r2.ok);
+  EXPECT_TRUE(r2.cached);
+  EXPECT_EQ(r2.compiledPath, r1.compiledPath);
+  EXPECT_EQ(r2.entries, 1);
+
+  // The compiled file itself (setConfig re-applying the current config) is used as is.
+  const HotwordsCompileResult again = CompileHotwordsFile(r1.compiledPath, options_);
+  EXPECT_TRUE(again.cached);
+  EXPECT_EQ(again.compiledPath, r1.compiledPath);
+
+  // Another modeling unit or changed tokens give another entry.
+  options_.modelingUnit = "cjkchar+bpe";
+  EXPECT_NE(CompileHotwordsFile(first, options_).compiledPath, r1.compiledPath);
+  options_.modelingUnit = "bpe";
+  Write("tokens.txt", "\xe2\x96\x81SHER 1\nPA 2\n\xe2\x96\x81ONNX 3\n\xe2\x96\x81ZIP 4\n");
+  const HotwordsCompileResult r3 = CompileHotwordsFile(first, options_);
+  ASSERT_TRUE(r3.ok);
+  EXPECT_FALSE(r3.cached);
+  EXPECT_NE(r3.compiledPath, r1.compiledPath);
+}
+
+TEST_F(HotwordsCompilerTest, PruningKeepsFilesHandedOutAndDropsStaleTemps) {
+  const fs::path cache(options_.cacheDir);
+  const HotwordsCompileResult kept = CompileHotwordsFile(Write("kept.txt", "sherpa onnx\n"), options_);
+  ASSERT_TRUE(kept.ok) << kept.error;
+  fs::path keptMeta(kept.compiledPath);
+  keptMeta.replace_extension(".meta");
+
+  // Entries left by an earlier run, all newer than the one handed out above.
+  const auto old = fs::file_time_type::clock::now() - std::chrono::hours(1);
+  fs::last_write_time(keptMeta, old - std::chrono::hours(1));
+  for (int i = 0; i < 40; ++i) {
+    const std::string base = "hw-" + std::to_string(1000 + i);
+    std::ofstream(cache / (base + ".txt")) << "react native\n";
+    std::ofstream(cache / (base + ".meta")) << "x\n";
+    fs::last_write_time(cache / (base + ".meta"), old + std::chrono::seconds(i));
+  }
+  const fs::path staleTemp = cache / "hw-1.txt.tmp0-1";
+  const fs::path freshTemp = cache / "hw-2.txt.tmp1-2";
+  std::ofstream(staleTemp) << "partial";
+  std::ofstream(freshTemp) << "partial";
+  fs::last_write_time(staleTemp, old);
+
+  const HotwordsCompileResult fresh = CompileHotwordsFile(Write("fresh.txt", "react native\n"), options_);
+  ASSERT_TRUE(fresh.ok) << fresh.error;
+  EXPECT_TRUE(fs::exists(kept.compiledPath));
+  EXPECT_TRUE(fs::exists(keptMeta));
+  EXPECT_TRUE(fs::exists(fresh.compiledPath));
+  EXPECT_FALSE(fs::exists(cache / "hw-1000.meta"));
+  EXPECT_TRUE(fs::exists(cache / "hw-1039.meta"));
+  EXPECT_FALSE(fs::exists(staleTemp));
+  EXPECT_TRUE(fs::exists(freshTemp));
+
+  size_t metas = 0;
+  for (const auto& entry : fs::directory_iterator(cache)) {
+    if (entry.path().extension() == ".meta") ++metas;
+  }
+  EXPECT_EQ(metas, 32u);
+}
+
+TEST_F(HotwordsCompilerTest, WithoutTokensOnlyValidatesAndDeduplicates) {
+  options_.tokensPath.clear();
+  const HotwordsCompileResult r = CompileHotwordsFile(Write("h.txt", "zipformer\nzipformer\n"), options_);
+  ASSERT_TRUE(r.ok) << r.error;
+  EXPECT_FALSE(r.vocabChecked);
+  EXPECT_EQ(r.entries, 1);
+  EXPECT_EQ(r.duplicates, 1);
+}
+
+TEST_F(HotwordsCompilerTest, CompilesPerStreamStrings) {
+  const HotwordsCompileResult r = CompileHotwordsText("sherpa onnx :2/zipformer/react native", options_);
+  ASSERT_TRUE(r.ok) << r.error;
+  EXPECT_EQ(r.text, "sherpa onnx :2/react native");
+  EXPECT_EQ(r.oovLines, 1);
+  EXPECT_FALSE(r.cached);
+  EXPECT_TRUE(CompileHotwordsText("sherpa onnx :2/zipformer/react native", options_).cached);
+  EXPECT_FALSE(CompileHotwordsText("zipformer", options_).ok);
+}
@@ -17,6 +17,7 @@
  */
 
 #include "model_detect_test_utils.h"
+#include "sherpa-onnx-common.h"
 #include "sherpa-onnx-model-detect.h"
 #include "sherpa-onnx-validate-stt.h"
 #include "sherpa-onnx-validate-tts.h"
@@ -440,4 +441,15 @@ TEST(ModelDetectValidation, ValidateSttPathsUnknownKindPassesThrough) {
     EXPECT_TRUE(v.ok) << "Unknown kind should not fail validation";
 }
 
+TEST(SttResultFields, BridgeArgumentToMask) {
+    using namespace sherpaonnx;
+    EXPECT_EQ(SttResultFieldsFromArg(0, false), kSttResultAllFields) << "absent = every field";
+    EXPECT_EQ(SttResultFieldsFromArg(-1, true), kSttResultAllFields);
+    EXPECT_EQ(SttResultFieldsFromArg(0, true), 0u) << "text only";
+    EXPECT_EQ(SttResultFieldsFromArg(kSttResultTokens | kSttResultLang, true),
+              static_cast<uint32_t>(kSttResultTokens | kSttResultLang));
+    EXPECT_EQ(SttResultFieldsFromArg(1024 + kSttResultEvent, true), static_cast<uint32_t>(kSttResultEvent))
+        << "unknown bits are dropped";
+}
+
 }  // namespace
@@ -0,0 +1,134 @@
+/**
+ * pcm_ring_test.cpp
+ *
+ * Host-side GTest suite for PcmRing (android/src/main/cpp/jni/tts/sherpa-onnx-pcm-ring.*): the SPSC
+ * float ring shared between the Zipvoice JNI producer and the Kotlin consumer via a direct ByteBuffer.
+ */
+
+#include "sherpa-onnx-pcm-ring.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using sherpaonnx::PcmRing;
+
+namespace {
+
+// 8-byte aligned backing store, like a direct ByteBuffer.
+std::vector<int64_t> MakeStorage(int32_t capacitySamples) {
+  return std::vector<int64_t>((PcmRing::RequiredBytes(capacitySamples) + 7) / 8);
+}
+
+}  // namespace
+
+TEST(PcmRing, InitAndAttachShareState) {
+  auto storage = MakeStorage(16);
+  const size_t bytes = PcmRing::RequiredBytes(16);
+  PcmRing writer = PcmRing::Init(storage.data(), bytes);
+  ASSERT_TRUE(writer.valid());
+  EXPECT_EQ(writer.capacity(), 16);
+
+  const float in[5] = {1, 2, 3, 4, 5};
+  EXPECT_EQ(writer.Write(in, 5), 5);
+
+  PcmRing reader = PcmRing::Attach(storage.data(), bytes);
+  ASSERT_TRUE(reader.valid());
+  EXPECT_EQ(reader.Readable(), 5);
+  float out[5] = {};
+  EXPECT_EQ(reader.Read(out, 5), 5);
+  for (int i = 0; i < 5; ++i) EXPECT_EQ(out[i], in[i]);
+  EXPECT_EQ(writer.Writable(), 16);
+}
+
+TEST(PcmRing, RejectsTooSmallOrUnaligned) {
+  auto storage = MakeStorage(4);
+  EXPECT_FALSE(PcmRing::Init(storage.data(), PcmRing::kHeaderBytes).valid());
+  EXPECT_FALSE(PcmRing::Init(reinterpret_cast<char*>(storage.data()) + 1, PcmRing::RequiredBytes(2)).valid());
+  EXPECT_FALSE(PcmRing::Attach(nullptr, 1024).valid());
+}
+
+TEST(PcmRing, WrapsAroundAndReportsFull) {
+  auto storage = MakeStorage(8);
+  PcmRing ring = PcmRing::Init(storage.data(), PcmRing::RequiredBytes(8));
+  const float a[6] = {0, 1, 2, 3, 4, 5};
+  EXPECT_EQ(ring.Write(a, 6), 6);
+  float out[8] = {};
+  EXPECT_EQ(ring.Read(out, 4), 4);
+
+  // Write 6 more: 2 at the tail, 4 wrapped to the head; then the ring is full.
+  const float b[7] = {6, 7, 8, 9, 10, 11, 12};
+  EXPECT_EQ(ring.Write(b, 7), 6);
+  EXPECT_EQ(ring.Writable(), 0);
+  EXPECT_EQ(ring.Readable(), 8);
+
+  EXPECT_EQ(ring.Read(out, 8), 8);
+  for (int i = 0; i < 8; ++i) EXPECT_EQ(out[i], static_cast<float>(i + 4));
+}
+
+TEST(PcmRing, InPlaceReadUsesOffsetAndCommit) {
+  auto storage = MakeStorage(4);
+  PcmRing ring = PcmRing::Init(storage.data(), PcmRing::RequiredBytes(4));
+  const float a[3] = {1, 2, 3};
+  ring.Write(a, 3);
+  ring.CommitRead(2);
+  EXPECT_EQ(ring.ReadOffset(), 2);
+  EXPECT_EQ(ring.Readable(), 1);
+  ring.CommitRead(10);  // clamped to readable
+  EXPECT_EQ(ring.Readable(), 0);
+}
+
+TEST(PcmRing, FlagsAndReset) {
+  auto storage = MakeStorage(4);
+  PcmRing ring = PcmRing::Init(storage.data(), PcmRing::RequiredBytes(4));
+  EXPECT_FALSE(ring.HasFlag(PcmRing::kWriterDone));
+  ring.SetFlag(PcmRing::kWriterDone);
+  ring.SetFlag(PcmRing::kReaderClosed);
+  EXPECT_TRUE(ring.HasFlag(PcmRing::kWriterDone));
+  EXPECT_TRUE(ring.HasFlag(PcmRing::kReaderClosed));
+  const float a[2] = {1, 2};
+  ring.Write(a, 2);
+  ring.Reset();
+  EXPECT_FALSE(ring.HasFlag(PcmRing::kWriterDone));
+  EXPECT_EQ(ring.Readable(), 0);
+}
+
+TEST(PcmRing, ProducerConsumerThreadsPreserveOrder) {
+  constexpr int32_t kTotal = 200000;
+  auto storage = MakeStorage(257);
+  const size_t bytes = PcmRing::RequiredBytes(257);
+  PcmRing producer = PcmRing::Init(storage.data(), bytes);
+  PcmRing consumer = PcmRing::Attach(storage.data(), bytes);
+
+  std::thread writer([&] {
+    std::vector<float> chunk(97);
+    int32_t next = 0;
+    while (next < kTotal) {
+      const int32_t n = std::min<int32_t>(static_cast<int32_t>(chunk.size()), kTotal - next);
+      for (int32_t i = 0; i < n; ++i) chunk[i] = static_cast<float>(next + i);
+      int32_t off = 0;
+      while (off < n) {
+        off += producer.Write(chunk.data() + off, n - off);
+        if (off < n) std::this_thread::yield();
+      }
+      next += n;
+    }
+    producer.SetFlag(PcmRing::kWriterDone);
+  });
+
+  std::vector<float> buf(64);
+  int32_t expected = 0;
+  bool ordered = true;
+  while (!(consumer.HasFlag(PcmRing::kWriterDone) && consumer.Readable() == 0)) {
+    const int32_t n = consumer.Read(buf.data(), static_cast<int32_t>(buf.size()));
+    for (int32_t i = 0; i < n; ++i) {
+      if (buf[i] != static_cast<float>(expected++)) ordered = false;
+    }
+    if (n == 0) std::this_thread::yield();
+  }
+  writer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(expected, kTotal);
+}
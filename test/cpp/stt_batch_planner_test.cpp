@@ -0,0 +1,146 @@
+/**
+ * stt_batch_planner_test.cpp
+ *
+ * Host-side GTest suite for batched transcription planning (sherpa-onnx-stt-batch-planner.*):
+ * length-sorted grouping under size and padded-length limits, unknown lengths, and header-only
+ * duration estimates for WAV (including an unfinalized header) and other files.
+ */
+
+#include "sherpa-onnx-stt-batch-planner.h"
+#include "sherpa-onnx-wav-writer.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace sherpaonnx;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string TempPath(const std::string& name) {
+  const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+  return (fs::temp_directory_path() / ("stt_batch_" + std::to_string(stamp) + "_" + name)).string();
+}
+
+std::vector<size_t> Flatten(const SttBatchPlan& plan) {
+  std::vector<size_t> all;
+  for (const auto& batch : plan) all.insert(all.end(), batch.begin(), batch.end());
+  return all;
+}
+
+}  // namespace
+
+TEST(SttBatchPlanner, GroupsBySimilarLengthLongestFirst) {
+  const std::vector<double> seconds = {2.0, 30.0, 3.0, 29.0, 1.0, 31.0};
+  SttBatchOptions options;
+  options.maxBatchSize = 3;
+  options.maxPaddedSeconds = 0.0;
+  const SttBatchPlan plan = PlanSttBatches(seconds, options);
+  ASSERT_EQ(plan.size(), 2u);
+  EXPECT_EQ(plan[0], (std::vector<size_t>{5, 1, 3}));
+  EXPECT_EQ(plan[1], (std::vector<size_t>{2, 0, 4}));
+  // Sorted grouping pads far less than input order would (30 s + 3 s items together).
+  double padded = 0.0;
+  for (const auto& batch : plan) padded += SttBatchPaddedSeconds(seconds, batch);
+  EXPECT_DOUBLE_EQ(padded, 31.0 * 3 + 3.0 * 3);
+}
+
+TEST(SttBatchPlanner, EveryIndexExactlyOnce) {
+  std::vector<double> seconds;
+  for (int i = 0; i < 37; ++i) seconds.push_back(static_cast<double>((i * 7) % 11));
+  SttBatchOptions options;
+  options.maxBatchSize = 4;
+  std::vector<size_t> all = Flatten(PlanSttBatches(seconds, options));
+  std::sort(all.begin(), all.end());
+  ASSERT_EQ(all.size(), seconds.size());
+  for (size_t i = 0; i < all.size(); ++i) EXPECT_EQ(all[i], i);
+}
+
+TEST(SttBatchPlanner, PaddedLimitSplitsLongItems) {
+  const std::vector<double> seconds = {100.0, 90.0, 80.0, 10.0, 10.0};
+  SttBatchOptions options;
+  options.maxBatchSize = 8;
+  options.maxPaddedSeconds = 200.0;
+  const SttBatchPlan plan = PlanSttBatches(seconds, options);
+  for (const auto& batch : plan) {
+    // A batch over the limit may only be a single item that is too long on its own.
+    if (batch.size() > 1) {
+      EXPECT_LE(SttBatchPaddedSeconds(seconds, batch), 200.0);
+    }
+  }
+  ASSERT_EQ(plan.size(), 3u);
+  EXPECT_EQ(plan[0], (std::vector<size_t>{0, 1}));
+  EXPECT_EQ(plan[1], (std::vector<size_t>{2, 3}));
+  EXPECT_EQ(plan[2], (std::vector<size_t>{4}));
+
+  options.maxPaddedSeconds = 50.0;
+  const SttBatchPlan single = PlanSttBatches({120.0}, options);
+  ASSERT_EQ(single.size(), 1u);
+  EXPECT_EQ(single[0], (std::vector<size_t>{0}));
+}
+
+TEST(SttBatchPlanner, BatchSizeOneIsSequential) {
+  SttBatchOptions options;
+  options.maxBatchSize = 1;
+  const SttBatchPlan plan = PlanSttBatches({1.0, 2.0, 3.0}, options);
+  ASSERT_EQ(plan.size(), 3u);
+  for (const auto& batch : plan) EXPECT_EQ(batch.size(), 1u);
+  EXPECT_TRUE(PlanSttBatches({}, options).empty());
+}
+
+TEST(SttBatchPlanner, UnknownLengthsGoLastInInputOrder) {
+  SttBatchOptions options;
+  options.maxBatchSize = 2;
+  const SttBatchPlan plan = PlanSttBatches({-1.0, 5.0, -1.0, 6.0}, options);
+  EXPECT_EQ(Flatten(plan), (std::vector<size_t>{3, 1, 0, 2}));
+}
+
+TEST(SttBatchPlanner, EstimatesWavFromHeader) {
+  const std::string path = TempPath("a.wav");
+  {
+    WavWriter writer;
+    ASSERT_TRUE(writer.Open(path, 16000));
+    std::vector<float> samples(24000, 0.25f);
+    ASSERT_TRUE(writer.Append(samples.data(), samples.size()));
+    ASSERT_TRUE(writer.Finalize());
+  }
+  EXPECT_NEAR(EstimateAudioFileSeconds(path), 1.5, 1e-9);
+  fs::remove(path);
+}
+
+TEST(SttBatchPlanner, EstimatesUnfinalizedWavFromFileSize) {
+  const std::string path = TempPath("b.wav");
+  {
+    WavWriter writer;
+    ASSERT_TRUE(writer.Open(path, 8000));
+    std::vector<float> samples(8000, 0.1f);
+    ASSERT_TRUE(writer.Append(samples.data(), samples.size()));
+    ASSERT_TRUE(writer.Finalize());
+  }
+  // Zero the data size as a recorder would before finalizing.
+  {
+    std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(40);
+    const char zero[4] = {0, 0, 0, 0};
+    f.write(zero, 4);
+  }
+  EXPECT_NEAR(EstimateAudioFileSeconds(path), 1.0, 1e-9);
+  fs::remove(path);
+}
+
+TEST(SttBatchPlanner, EstimatesOtherFilesFromSize) {
+  const std::string path = TempPath("c.mp3");
+  {
+    std::ofstream out(path, std::ios::binary);
+    std::string bytes(32000, 'x');
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+  EXPECT_NEAR(EstimateAudioFileSeconds(path), 2.0, 1e-9);
+  fs::remove(path);
+  EXPECT_LT(EstimateAudioFileSeconds(TempPath("missing.wav")), 0.0);
+}
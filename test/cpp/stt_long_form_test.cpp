@@ -0,0 +1,258 @@
+/**
+ * stt_long_form_test.cpp
+ *
+ * Host-side GTest suite for long-form transcription helpers: seekable, memory-mapped WAV range
+ * reads and SIMD int16 / raw PCM conversion (sherpa-onnx-wav-reader.*), VAD segment padding /
+ * merging / capping and transcript joining (sherpa-onnx-stt-long-form.*).
+ */
+
+#include "sherpa-onnx-stt-long-form.h"
+#include "sherpa-onnx-wav-reader.h"
+#include "sherpa-onnx-wav-writer.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace sherpaonnx;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string TempPath(const std::string& name) {
+  const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+  return (fs::temp_directory_path() / ("stt_long_form_" + std::to_string(stamp) + "_" + name)).string();
+}
+
+void WriteLe(std::ofstream& out, uint32_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+// Stereo 16-bit PCM with a LIST chunk before "data", as many recorders write.
+void WriteStereoWav(const std::string& path, const std::vector<int16_t>& interleaved) {
+  std::ofstream out(path, std::ios::binary);
+  const uint32_t dataBytes = static_cast<uint32_t>(interleaved.size() * 2);
+  out.write("RIFF", 4);
+  WriteLe(out, 4 + 24 + 12 + 8 + dataBytes, 4);
+  out.write("WAVE", 4);
+  out.write("fmt ", 4);
+  WriteLe(out, 16, 4);
+  WriteLe(out, 1, 2);
+  WriteLe(out, 2, 2);
+  WriteLe(out, 8000, 4);
+  WriteLe(out, 8000 * 4, 4);
+  WriteLe(out, 4, 2);
+  WriteLe(out, 16, 2);
+  out.write("LIST", 4);
+  WriteLe(out, 4, 4);
+  out.write("INFO", 4);
+  out.write("data", 4);
+  WriteLe(out, dataBytes, 4);
+  for (int16_t s : interleaved) WriteLe(out, static_cast<uint16_t>(s), 2);
+}
+
+}  // namespace
+
+TEST(WavFileReader, ReadsRangesOfMonoFile) {
+  const std::string path = TempPath("mono.wav");
+  std::vector<float> samples(40000);
+  for (size_t i = 0; i < samples.size(); ++i) samples[i] = static_cast<float>(i % 100) / 200.0f;
+  {
+    WavWriter writer;
+    ASSERT_TRUE(writer.Open(path, 16000));
+    ASSERT_TRUE(writer.Append(samples.data(), samples.size()));
+    ASSERT_TRUE(writer.Finalize());
+  }
+  WavFileReader reader;
+  ASSERT_TRUE(reader.Open(path)) << reader.Error();
+  EXPECT_EQ(reader.SampleRate(), 16000);
+  EXPECT_EQ(reader.NumChannels(), 1);
+  EXPECT_EQ(reader.NumFrames(), 40000);
+
+  // Spans more than one internal block and is read out of order.
+  std::vector<float> out(20000);
+  ASSERT_EQ(reader.ReadMono(17000, 20000, out.data()), 20000);
+  for (size_t i = 0; i < out.size(); ++i) EXPECT_NEAR(out[i], samples[17000 + i], 1.0f / 16384) << i;
+  ASSERT_EQ(reader.ReadMono(5, 10, out.data()), 10);
+  EXPECT_NEAR(out[0], samples[5], 1.0f / 16384);
+
+  // Clamped at the end, empty past it.
+  EXPECT_EQ(reader.ReadMono(39990, 100, out.data()), 10);
+  EXPECT_EQ(reader.ReadMono(40000, 100, out.data()), 0);
+  fs::remove(path);
+}
+
+TEST(WavFileReader, DownmixesStereoAndSkipsExtraChunks) {
+  const std::string path = TempPath("stereo.wav");
+  WriteStereoWav(path, {16384, 0, -16384, -16384, 8192, 24576});
+  WavFileReader reader;
+  ASSERT_TRUE(reader.Open(path)) << reader.Error();
+  EXPECT_EQ(reader.SampleRate(), 8000);
+  EXPECT_EQ(reader.NumChannels(), 2);
+  ASSERT_EQ(reader.NumFrames(), 3);
+  float out[3];
+  ASSERT_EQ(reader.ReadMono(0, 3, out), 3);
+  EXPECT_FLOAT_EQ(out[0], 0.25f);
+  EXPECT_FLOAT_EQ(out[1], -0.5f);
+  EXPECT_FLOAT_EQ(out[2], 0.5f);
+  fs::remove(path);
+}
+
+TEST(WavFileReader, RejectsNonWav) {
+  const std::string path = TempPath("x.mp3");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "ID3 not a wav file at all";
+  }
+  WavFileReader reader;
+  EXPECT_FALSE(reader.Open(path));
+  EXPECT_FALSE(reader.Error().empty());
+  EXPECT_FALSE(reader.IsOpen());
+  EXPECT_FALSE(reader.Open(TempPath("missing.wav")));
+  fs::remove(path);
+}
+
+TEST(WavFileReader, Int16ToFloatMatchesScalar) {
+  std::vector<int16_t> in;
+  for (int v = -32768; v <= 32767; v += 97) in.push_back(static_cast<int16_t>(v));
+  in.push_back(32767);
+  in.push_back(-32768);
+  std::vector<float> out(in.size());
+  // Odd count exercises the scalar tail after the 8-wide SIMD loop.
+  Int16ToFloat(in.data(), out.data(), in.size());
+  for (size_t i = 0; i < in.size(); ++i) EXPECT_EQ(out[i], static_cast<float>(in[i]) / 32768.0f) << i;
+}
+
+TEST(WavFileReader, PcmBytesToFloatHandlesEncodingsAndAlignment) {
+  std::vector<int16_t> pcm;
+  for (int v = -32768; v <= 32767; v += 331) pcm.push_back(static_cast<int16_t>(v));
+  // Copy to an odd offset so the int16 input is misaligned.
+  std::vector<unsigned char> bytes(pcm.size() * 2 + 2);
+  std::memcpy(bytes.data() + 1, pcm.data(), pcm.size() * 2);
+  std::vector<float> out(pcm.size());
+  ASSERT_EQ(PcmBytesToFloat(bytes.data() + 1, pcm.size() * 2 + 1, PcmEncoding::kInt16, out.data()), pcm.size());
+  for (size_t i = 0; i < pcm.size(); ++i) EXPECT_EQ(out[i], static_cast<float>(pcm[i]) / 32768.0f) << i;
+  ASSERT_EQ(PcmBytesToFloat(pcm.data(), pcm.size() * 2, PcmEncoding::kInt16, out.data()), pcm.size());
+  EXPECT_EQ(out.back(), static_cast<float>(pcm.back()) / 32768.0f);
+
+  const float floats[3] = {0.25f, -1.0f, 0.5f};
+  float back[3] = {};
+  ASSERT_EQ(PcmBytesToFloat(floats, sizeof(floats), PcmEncoding::kFloat32, back), 3u);
+  EXPECT_EQ(back[1], -1.0f);
+  EXPECT_EQ(PcmBytesToFloat(floats, 3, PcmEncoding::kFloat32, back), 0u);
+
+  PcmEncoding encoding = PcmEncoding::kInt16;
+  EXPECT_TRUE(ParsePcmEncoding("float32", &encoding));
+  EXPECT_EQ(encoding, PcmEncoding::kFloat32);
+  EXPECT_TRUE(ParsePcmEncoding("s16le", &encoding));
+  EXPECT_EQ(encoding, PcmEncoding::kInt16);
+  EXPECT_FALSE(ParsePcmEncoding("mulaw", &encoding));
+}
+
+TEST(WavFileReader, ReadsWholeFileThroughMapping) {
+  const std::string path = TempPath("whole.wav");
+  // Longer than one conversion window, so pages are released between windows.
+  std::vector<float> samples(200000);
+  for (size_t i = 0; i < samples.size(); ++i) samples[i] = static_cast<float>((i * 37) % 2000) / 2000.0f - 0.5f;
+  {
+    WavWriter writer;
+    ASSERT_TRUE(writer.Open(path, 16000));
+    ASSERT_TRUE(writer.Append(samples.data(), samples.size()));
+    ASSERT_TRUE(writer.Finalize());
+  }
+  WavFileReader reader;
+  ASSERT_TRUE(reader.Open(path));
+#if defined(__unix__) || defined(__APPLE__)
+  EXPECT_TRUE(reader.IsMapped());
+#endif
+  reader.Close();
+
+  std::vector<float> out;
+  int32_t sampleRate = 0;
+  std::string error;
+  ASSERT_TRUE(ReadWavFileMono(path, &out, &sampleRate, &error)) << error;
+  EXPECT_EQ(sampleRate, 16000);
+  ASSERT_EQ(out.size(), samples.size());
+  for (size_t i = 0; i < out.size(); i += 101) EXPECT_NEAR(out[i], samples[i], 1.0f / 16384) << i;
+  // A second pass over released pages reads the same data.
+  std::vector<float> again;
+  ASSERT_TRUE(ReadWavFileMono(path, &again, nullptr, nullptr));
+  EXPECT_EQ(again, out);
+  fs::remove(path);
+
+  EXPECT_FALSE(ReadWavFileMono(TempPath("missing.wav"), &out, &sampleRate, &error));
+  EXPECT_FALSE(error.empty());
+}
+
+TEST(SpeechRangeBuilder, PadsAndMergesOverlappingSegments) {
+  SpeechRangeOptions options;
+  options.paddingSamples = 100;
+  options.maxRangeSamples = 10000;
+  SpeechRangeBuilder builder(options);
+  EXPECT_TRUE(builder.Push(50, 1000).empty());
+  // Padded [1050, ...) touches the previous padded end 1150: merged.
+  EXPECT_TRUE(builder.Push(1150, 500).empty());
+  // Far away: the first range is final now.
+  const auto first = builder.Push(5000, 400);
+  ASSERT_EQ(first.size(), 1u);
+  EXPECT_EQ(first[0].start, 0);
+  EXPECT_EQ(first[0].end, 1750);
+  const auto rest = builder.Finish(5450);
+  ASSERT_EQ(rest.size(), 1u);
+  EXPECT_EQ(rest[0].start, 4900);
+  EXPECT_EQ(rest[0].end, 5450);
+  EXPECT_TRUE(builder.Finish(5450).empty());
+}
+
+TEST(SpeechRangeBuilder, CapStopsMergingAndRangesNeverOverlap) {
+  SpeechRangeOptions options;
+  options.paddingSamples = 200;
+  options.maxRangeSamples = 3000;
+  SpeechRangeBuilder builder(options);
+  EXPECT_TRUE(builder.Push(1000, 2000).empty());
+  // Merging would give [800, 4700) > cap, so the ranges stay separate and do not share samples.
+  const auto first = builder.Push(3300, 1200);
+  ASSERT_EQ(first.size(), 1u);
+  EXPECT_EQ(first[0].start, 800);
+  EXPECT_EQ(first[0].end, 3200);
+  const auto second = builder.Finish(100000);
+  ASSERT_EQ(second.size(), 1u);
+  EXPECT_EQ(second[0].start, 3200);
+  EXPECT_EQ(second[0].end, 4700);
+}
+
+TEST(SpeechRangeBuilder, SplitsOverlongSpeechEvenly) {
+  SpeechRangeOptions options;
+  options.maxRangeSamples = 1000;
+  SpeechRangeBuilder builder(options);
+  EXPECT_TRUE(builder.Push(0, 2500).empty());
+  const auto ranges = builder.Finish(2500);
+  ASSERT_EQ(ranges.size(), 3u);
+  int64_t expectedStart = 0;
+  for (const auto& r : ranges) {
+    EXPECT_EQ(r.start, expectedStart);
+    EXPECT_LE(r.end - r.start, 1000);
+    EXPECT_GE(r.end - r.start, 833);
+    expectedStart = r.end;
+  }
+  EXPECT_EQ(expectedStart, 2500);
+}
+
+TEST(SpeechRangeBuilder, IgnoresEmptySegments) {
+  SpeechRangeBuilder builder(SpeechRangeOptions{});
+  EXPECT_TRUE(builder.Push(10, 0).empty());
+  EXPECT_TRUE(builder.Finish(100).empty());
+}
+
+TEST(JoinSegmentTexts, SpacesLatinButNotCjk) {
+  EXPECT_EQ(JoinSegmentTexts({" Hello there.", "", "  How are you? "}), "Hello there. How are you?");
+  EXPECT_EQ(JoinSegmentTexts({"你好。", "今天天气很好"}), "你好。今天天气很好");
+  EXPECT_EQ(JoinSegmentTexts({"안녕하세요", "반갑습니다"}), "안녕하세요 반갑습니다");
+  EXPECT_EQ(JoinSegmentTexts({"OK", "好的"}), "OK 好的");
+  EXPECT_EQ(JoinSegmentTexts({}), "");
+}
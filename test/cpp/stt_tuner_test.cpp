@@ -0,0 +1,172 @@
+/**
+ * stt_tuner_test.cpp
+ *
+ * Host-side GTest suite for the offline STT auto-tuner (sherpa-onnx-stt-tuner.*): the thread
+ * ladder, the staged candidate search, winner selection under a memory bound, the stored form of a
+ * winner and the per-model key.
+ */
+
+#include "sherpa-onnx-stt-tuner.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace sherpaonnx;
+namespace fs = std::filesystem;
+
+namespace {
+
+using RtfFn = std::function<double(const SttTuneCandidate&)>;
+
+// Drive the search to the end with a synthetic cost model; returns the candidates in order.
+std::vector<SttTuneCandidate> RunSearch(SttAutoTuner& tuner, const RtfFn& rtf, int64_t memory = 0) {
+  std::vector<SttTuneCandidate> seen;
+  SttTuneCandidate c;
+  while (tuner.Next(&c)) {
+    seen.push_back(c);
+    SttTuneMeasurement m;
+    m.candidate = c;
+    m.rtf = rtf(c);
+    m.ok = m.rtf >= 0.0;
+    m.peakMemoryBytes = memory > 0 ? memory * c.numThreads : 0;
+    tuner.Report(m);
+  }
+  return seen;
+}
+
+}  // namespace
+
+TEST(SttTuneThreadLadder, PowersOfTwoThenMax) {
+  EXPECT_EQ(SttTuneThreadLadder(0), (std::vector<int32_t>{1}));
+  EXPECT_EQ(SttTuneThreadLadder(1), (std::vector<int32_t>{1}));
+  EXPECT_EQ(SttTuneThreadLadder(4), (std::vector<int32_t>{1, 2, 4}));
+  EXPECT_EQ(SttTuneThreadLadder(6), (std::vector<int32_t>{1, 2, 4, 6}));
+}
+
+TEST(SttAutoTuner, StopsThreadLadderWhenMoreThreadsStopHelping) {
+  SttTuneOptions options;
+  options.maxThreads = 8;
+  SttAutoTuner tuner(options);
+  // 1 -> 2 threads halves the RTF, 4 threads gains nothing: 8 is never tried.
+  const auto seen = RunSearch(tuner, [](const SttTuneCandidate& c) { return c.numThreads == 1 ? 0.4 : 0.2; });
+  ASSERT_EQ(seen.size(), 3u);
+  EXPECT_EQ(seen[2].numThreads, 4);
+
+  SttTuneMeasurement best;
+  ASSERT_TRUE(tuner.Best(&best));
+  EXPECT_EQ(best.candidate.numThreads, 2);
+  EXPECT_EQ(best.candidate.provider, "cpu");
+}
+
+TEST(SttAutoTuner, TriesProvidersAtBestThreadsThenOtherQuantization) {
+  SttTuneOptions options;
+  options.maxThreads = 2;
+  options.providers = {"cpu", "xnnpack", "nnapi", "xnnpack"};
+  options.hasInt8 = true;
+  options.hasFp32 = true;
+  SttAutoTuner tuner(options);
+  const auto seen = RunSearch(tuner, [](const SttTuneCandidate& c) {
+    if (c.provider == "nnapi") return -1.0;  // fails to load
+    double rtf = c.numThreads == 2 ? 0.3 : 0.5;
+    if (c.provider == "xnnpack") rtf *= 0.5;
+    if (!c.int8) rtf *= 1.5;
+    return rtf;
+  });
+  ASSERT_EQ(seen.size(), 5u);
+  EXPECT_TRUE(seen[0].int8);
+  EXPECT_EQ(seen[2].provider, "xnnpack");
+  EXPECT_EQ(seen[2].numThreads, 2);
+  EXPECT_EQ(seen[3].provider, "nnapi");
+  EXPECT_EQ(seen[4].provider, "xnnpack");
+  EXPECT_FALSE(seen[4].int8);
+
+  SttTuneMeasurement best;
+  ASSERT_TRUE(tuner.Best(&best));
+  EXPECT_EQ(best.candidate.provider, "xnnpack");
+  EXPECT_TRUE(best.candidate.int8);
+  EXPECT_EQ(tuner.Measurements().size(), 5u);
+}
+
+TEST(SttAutoTuner, TiesGoToFewerThreadsAndMemoryBoundIsRespected) {
+  SttTuneOptions options;
+  options.maxThreads = 4;
+  options.tolerance = 0.1;
+  SttAutoTuner tied(options);
+  RunSearch(tied, [](const SttTuneCandidate& c) { return c.numThreads == 1 ? 0.5 : (c.numThreads == 2 ? 0.2 : 0.19); });
+  SttTuneMeasurement best;
+  ASSERT_TRUE(tied.Best(&best));
+  EXPECT_EQ(best.candidate.numThreads, 2);
+
+  options.maxMemoryBytes = 150;
+  SttAutoTuner bounded(options);
+  RunSearch(bounded, [](const SttTuneCandidate& c) { return 1.0 / c.numThreads; }, 100);
+  ASSERT_TRUE(bounded.Best(&best));
+  EXPECT_EQ(best.candidate.numThreads, 1);
+
+  options.maxMemoryBytes = 50;
+  SttAutoTuner over(options);
+  RunSearch(over, [](const SttTuneCandidate& c) { return 1.0 / c.numThreads; }, 100);
+  ASSERT_TRUE(over.Best(&best));
+  EXPECT_EQ(best.peakMemoryBytes, 100);
+}
+
+TEST(SttAutoTuner, NoWinnerWhenEverythingFails) {
+  SttTuneOptions options;
+  options.maxThreads = 2;
+  SttAutoTuner tuner(options);
+  const auto seen = RunSearch(tuner, [](const SttTuneCandidate&) { return -1.0; });
+  EXPECT_EQ(seen.size(), 2u);
+  SttTuneMeasurement best;
+  EXPECT_FALSE(tuner.Best(&best));
+}
+
+TEST(SttTuneChoice, SerializeRoundTripAndRejectsGarbage) {
+  SttTuneMeasurement m;
+  m.candidate.numThreads = 3;
+  m.candidate.provider = "nnapi";
+  m.candidate.int8 = true;
+  m.ok = true;
+  m.rtf = 0.125;
+  m.peakMemoryBytes = 123456789;
+  SttTuneMeasurement back;
+  ASSERT_TRUE(ParseSttTuneChoice(SerializeSttTuneChoice(m), &back));
+  EXPECT_EQ(back.candidate.numThreads, 3);
+  EXPECT_EQ(back.candidate.provider, "nnapi");
+  EXPECT_TRUE(back.candidate.int8);
+  EXPECT_DOUBLE_EQ(back.rtf, 0.125);
+  EXPECT_EQ(back.peakMemoryBytes, 123456789);
+
+  SttTuneMeasurement untouched;
+  untouched.candidate.numThreads = 7;
+  EXPECT_FALSE(ParseSttTuneChoice("", &untouched));
+  EXPECT_FALSE(ParseSttTuneChoice("zvsteps1 3 cpu 1 0.1 0", &untouched));
+  EXPECT_FALSE(ParseSttTuneChoice("stttune1 0 cpu 1 0.1 0", &untouched));
+  EXPECT_EQ(untouched.candidate.numThreads, 7);
+}
+
+TEST(SttTuneModelKey, ChangesWhenModelFilesChange) {
+  const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+  const fs::path dir = fs::temp_directory_path() / ("stt_tuner_" + std::to_string(stamp));
+  fs::create_directories(dir);
+  { std::ofstream(dir / "model.onnx", std::ios::binary) << std::string(100, 'x'); }
+  const std::string key = SttTuneModelKey(dir.string(), "whisper");
+  EXPECT_EQ(key, SttTuneModelKey(dir.string() + "/", "whisper"));
+  EXPECT_NE(key, SttTuneModelKey(dir.string(), "transducer"));
+  { std::ofstream(dir / "model.onnx", std::ios::binary) << std::string(200, 'x'); }
+  EXPECT_NE(key, SttTuneModelKey(dir.string(), "whisper"));
+  fs::remove_all(dir);
+}
+
+TEST(ProcessMemoryProbe, PeakIsNeverNegative) {
+  ProcessMemoryProbe probe;
+  probe.Begin();
+  std::vector<char> block(8 << 20, 1);
+  probe.Sample();
+  EXPECT_GE(probe.PeakDeltaBytes(), 0);
+  EXPECT_GT(block[block.size() - 1], 0);
+}
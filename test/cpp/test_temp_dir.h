@@ -0,0 +1,39 @@
+/**
+ * test_temp_dir.h
+ *
+ * Test-only RAII temporary directory shared by the host suites that write files: created under
+ * the system temp directory as <prefix><timestamp> and removed with its contents on destruction.
+ */
+
+#ifndef TEST_TEMP_DIR_H
+#define TEST_TEMP_DIR_H
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+class TempDir {
+ public:
+  explicit TempDir(const std::string& prefix) {
+    path_ = std::filesystem::temp_directory_path() /
+            (prefix + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(path_);
+  }
+  ~TempDir() {
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+  }
+  TempDir(const TempDir&) = delete;
+  TempDir& operator=(const TempDir&) = delete;
+
+  const std::filesystem::path& path() const { return path_; }
+  std::string str() const { return path_.string(); }
+  /** Path of [name] inside the directory. */
+  std::string file(const std::string& name) const { return (path_ / name).string(); }
+
+ private:
+  std::filesystem::path path_;
+};
+
+#endif  // TEST_TEMP_DIR_H
@@ -0,0 +1,189 @@
+/**
+ * tts_audio_cache_test.cpp
+ *
+ * Host-side GTest suite for the synthesized-audio cache (sherpa-onnx-tts-audio-cache.*): key
+ * construction, memory LRU eviction by byte budget, disk spill / reload across instances,
+ * collision-safe disk reads, rejection of corrupt files and disk budget enforcement.
+ */
+
+#include "sherpa-onnx-tts-audio-cache.h"
+#include "test_temp_dir.h"
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace sherpaonnx;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::vector<float> Ramp(size_t n) {
+  std::vector<float> v(n);
+  for (size_t i = 0; i < n; ++i) v[i] = static_cast<float>(i % 100) / 100.0f - 0.5f;
+  return v;
+}
+
+}  // namespace
+
+TEST(TtsAudioCache, KeyDependsOnEveryInput) {
+  const auto base = TtsAudioCache::MakeKey("fp", "hello", 0, 1.0f);
+  EXPECT_EQ(base, TtsAudioCache::MakeKey("fp", "hello", 0, 1.0f));
+  EXPECT_NE(base, TtsAudioCache::MakeKey("fp2", "hello", 0, 1.0f));
+  EXPECT_NE(base, TtsAudioCache::MakeKey("fp", "hello!", 0, 1.0f));
+  EXPECT_NE(base, TtsAudioCache::MakeKey("fp", "hello", 1, 1.0f));
+  EXPECT_NE(base, TtsAudioCache::MakeKey("fp", "hello", 0, 1.1f));
+  EXPECT_NE(base, TtsAudioCache::MakeKey("fp", "hello", 0, 1.0f, "silence=0.3"));
+}
+
+TEST(TtsAudioCache, ModelFingerprintTracksFiles) {
+  TempDir dir("tts_audio_cache_test_");
+  const auto empty = TtsAudioCache::ModelFingerprint(dir.str(), "vits");
+  EXPECT_EQ(empty, TtsAudioCache::ModelFingerprint(dir.str(), "vits"));
+  EXPECT_NE(empty, TtsAudioCache::ModelFingerprint(dir.str(), "kokoro"));
+  std::ofstream(fs::path(dir.str()) / "model.onnx") << "weights";
+  EXPECT_NE(empty, TtsAudioCache::ModelFingerprint(dir.str(), "vits"));
+}
+
+TEST(TtsAudioCache, MemoryHitReturnsSharedSamples) {
+  TtsAudioCache cache;
+  const auto key = TtsAudioCache::MakeKey("fp", "a", 0, 1.0f);
+  TtsAudioCache::Samples samples;
+  int32_t rate = 0;
+  EXPECT_FALSE(cache.Get(key, &samples, &rate));
+  cache.Put(key, Ramp(1000), 22050);
+  ASSERT_TRUE(cache.Get(key, &samples, &rate));
+  EXPECT_EQ(rate, 22050);
+  EXPECT_EQ(*samples, Ramp(1000));
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.memoryHits, 1u);
+  EXPECT_EQ(stats.insertions, 1u);
+  EXPECT_EQ(stats.memoryEntries, 1u);
+}
+
+TEST(TtsAudioCache, EvictsLeastRecentlyUsedWithinByteBudget) {
+  TtsAudioCache::Options opts;
+  opts.maxMemoryBytes = 3 * 1000 * sizeof(float) + 100;  // room for three entries
+  TtsAudioCache cache(opts);
+  for (int i = 0; i < 3; ++i) {
+    cache.Put(TtsAudioCache::MakeKey("fp", std::to_string(i), 0, 1.0f), Ramp(1000), 16000);
+  }
+  // Touch "0" so "1" becomes the LRU victim.
+  ASSERT_TRUE(cache.Get(TtsAudioCache::MakeKey("fp", "0", 0, 1.0f), nullptr, nullptr));
+  cache.Put(TtsAudioCache::MakeKey("fp", "3", 0, 1.0f), Ramp(1000), 16000);
+
+  EXPECT_TRUE(cache.Get(TtsAudioCache::MakeKey("fp", "0", 0, 1.0f), nullptr, nullptr));
+  EXPECT_FALSE(cache.Get(TtsAudioCache::MakeKey("fp", "1", 0, 1.0f), nullptr, nullptr));
+  EXPECT_TRUE(cache.Get(TtsAudioCache::MakeKey("fp", "2", 0, 1.0f), nullptr, nullptr));
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.memoryEntries, 3u);
+  EXPECT_LE(stats.memoryBytes, opts.maxMemoryBytes);
+}
+
+TEST(TtsAudioCache, OversizedEntrySkipsMemoryTier) {
+  TtsAudioCache::Options opts;
+  opts.maxMemoryBytes = 1024;
+  TtsAudioCache cache(opts);
+  cache.Put("big", Ramp(10000), 16000);
+  EXPECT_FALSE(cache.Get("big", nullptr, nullptr));
+  EXPECT_EQ(cache.GetStats().memoryBytes, 0u);
+}
+
+TEST(TtsAudioCache, DiskTierSurvivesNewInstance) {
+  TempDir dir("tts_audio_cache_test_");
+  TtsAudioCache::Options opts;
+  opts.diskDir = dir.str();
+  const auto key = TtsAudioCache::MakeKey("fp", "persist me", 2, 0.9f);
+  {
+    TtsAudioCache cache(opts);
+    cache.Put(key, Ramp(4000), 24000);
+    EXPECT_GT(cache.GetStats().diskBytes, 0u);
+  }
+  TtsAudioCache cache(opts);
+  EXPECT_GT(cache.GetStats().diskBytes, 0u);
+  TtsAudioCache::Samples samples;
+  int32_t rate = 0;
+  ASSERT_TRUE(cache.Get(key, &samples, &rate));
+  EXPECT_EQ(rate, 24000);
+  ASSERT_EQ(samples->size(), 4000u);
+  const auto expected = Ramp(4000);
+  for (size_t i = 0; i < expected.size(); ++i) EXPECT_NEAR((*samples)[i], expected[i], 1e-4f);
+  EXPECT_EQ(cache.GetStats().diskHits, 1u);
+
+  // Promoted to memory: second lookup is a memory hit.
+  ASSERT_TRUE(cache.Get(key, &samples, &rate));
+  EXPECT_EQ(cache.GetStats().memoryHits, 1u);
+}
+
+TEST(TtsAudioCache, DiskReadRejectsDifferentKey) {
+  TempDir dir("tts_audio_cache_test_");
+  TtsAudioCache::Options opts;
+  opts.diskDir = dir.str();
+  TtsAudioCache cache(opts);
+  cache.Put("k1", Ramp(100), 16000);
+  cache.Clear(false);
+  EXPECT_TRUE(cache.Get("k1", nullptr, nullptr));
+  cache.Clear(false);
+
+  // Overwrite the k1 file with an entry for another key (simulated hash collision).
+  std::vector<fs::path> files;
+  for (const auto& e : fs::directory_iterator(dir.str())) files.push_back(e.path());
+  ASSERT_EQ(files.size(), 1u);
+  {
+    TempDir other("tts_audio_cache_test_");
+    TtsAudioCache::Options otherOpts;
+    otherOpts.diskDir = other.str();
+    TtsAudioCache otherCache(otherOpts);
+    otherCache.Put("k2", Ramp(100), 16000);
+    for (const auto& e : fs::directory_iterator(other.str())) {
+      fs::copy_file(e.path(), files[0], fs::copy_options::overwrite_existing);
+    }
+  }
+  EXPECT_FALSE(cache.Get("k1", nullptr, nullptr));
+}
+
+TEST(TtsAudioCache, DiskReadDropsFileWithBadSampleCount) {
+  TempDir dir("tts_audio_cache_test_");
+  TtsAudioCache::Options opts;
+  opts.diskDir = dir.str();
+  TtsAudioCache cache(opts);
+  cache.Put("k1", Ramp(100), 16000);
+  cache.Clear(false);
+
+  std::vector<fs::path> files;
+  for (const auto& e : fs::directory_iterator(dir.str())) files.push_back(e.path());
+  ASSERT_EQ(files.size(), 1u);
+  {
+    // numSamples follows magic, version, sampleRate and keyLength in the header.
+    std::fstream f(files[0], std::ios::in | std::ios::out | std::ios::binary);
+    const uint64_t huge = uint64_t{1} << 60;
+    f.seekp(16);
+    f.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+  }
+  EXPECT_FALSE(cache.Get("k1", nullptr, nullptr));
+  EXPECT_FALSE(fs::exists(files[0]));
+}
+
+TEST(TtsAudioCache, DiskBudgetRemovesOldestFiles) {
+  TempDir dir("tts_audio_cache_test_");
+  TtsAudioCache::Options opts;
+  opts.maxMemoryBytes = 0;
+  opts.diskDir = dir.str();
+  opts.maxDiskBytes = 3 * (2000 * sizeof(int16_t) + 64);
+  TtsAudioCache cache(opts);
+  for (int i = 0; i < 6; ++i) {
+    cache.Put("key" + std::to_string(i), Ramp(2000), 16000);
+  }
+  auto stats = cache.GetStats();
+  EXPECT_LE(stats.diskBytes, opts.maxDiskBytes);
+  EXPECT_TRUE(cache.Get("key5", nullptr, nullptr));
+
+  cache.Clear(true);
+  EXPECT_EQ(cache.GetStats().diskBytes, 0u);
+  EXPECT_FALSE(cache.Get("key5", nullptr, nullptr));
+}
@@ -0,0 +1,159 @@
+/**
+ * tts_export_writer_test.cpp
+ *
+ * Host-side GTest suite for the batch export writer (sherpa-onnx-tts-export-writer.*): WAV output
+ * at the job's rate, the temporary WAV handed to the encoder, error results, tempo, and that
+ * Submit() returns while the previous item is still being encoded.
+ */
+
+#include "sherpa-onnx-tts-export-writer.h"
+#include "test_temp_dir.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sherpaonnx;
+namespace fs = std::filesystem;
+
+namespace {
+
+TtsExportJob Job(size_t index, const std::string& path, size_t n, int32_t sampleRate = 24000,
+                 const std::string& format = "") {
+  TtsExportJob job;
+  job.index = index;
+  job.samples.assign(n, 0.25f);
+  job.sampleRate = sampleRate;
+  job.path = path;
+  job.format = format;
+  return job;
+}
+
+}  // namespace
+
+TEST(TtsExportWriter, ResolvesFormatFromPathOrHint) {
+  EXPECT_EQ(TtsExportWriter::ResolveFormat("/a/b/c.MP3", ""), "mp3");
+  EXPECT_EQ(TtsExportWriter::ResolveFormat("/a/b/c.wav", "FLAC"), "flac");
+  EXPECT_EQ(TtsExportWriter::ResolveFormat("/a/b.dir/c", ""), "wav");
+  EXPECT_EQ(TtsExportWriter::ResolveFormat("", ""), "wav");
+}
+
+TEST(TtsExportWriter, WritesWavAtJobRateInSubmitOrder) {
+  TempDir dir("tts_export_writer_test_");
+  TtsExportWriter writer(nullptr);
+  for (size_t i = 0; i < 5; ++i) {
+    ASSERT_TRUE(writer.Submit(Job(i, dir.file("p" + std::to_string(i) + ".wav"), 1000 + i, 22050)));
+  }
+  const auto results = writer.Finish();
+  ASSERT_EQ(results.size(), 5u);
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i].index, i);
+    EXPECT_TRUE(results[i].error.empty()) << results[i].error;
+    EXPECT_EQ(results[i].numSamples, 1000 + i);
+    EXPECT_EQ(results[i].sampleRate, 22050);
+    EXPECT_EQ(fs::file_size(results[i].path), 44 + (1000 + i) * 2);
+  }
+  EXPECT_FALSE(writer.Submit(Job(5, dir.file("late.wav"), 10)));
+}
+
+TEST(TtsExportWriter, HandsTemporaryWavToEncoderAndRemovesIt) {
+  TempDir dir("tts_export_writer_test_");
+  std::vector<std::string> calls;
+  bool wavExisted = false;
+  TtsExportWriter writer([&](const std::string& wavPath, const std::string& outputPath, const std::string& format) {
+    wavExisted = fs::exists(wavPath);
+    calls.push_back(format + ":" + outputPath);
+    return std::string();
+  });
+  const std::string out = dir.file("chapter.mp3");
+  ASSERT_TRUE(writer.Submit(Job(0, out, 480)));
+  const auto results = writer.Finish();
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_TRUE(results[0].error.empty());
+  ASSERT_EQ(calls.size(), 1u);
+  EXPECT_EQ(calls[0], "mp3:" + out);
+  EXPECT_TRUE(wavExisted);
+  EXPECT_FALSE(fs::exists(out + ".part.wav"));
+}
+
+TEST(TtsExportWriter, ReportsErrorsPerItem) {
+  TempDir dir("tts_export_writer_test_");
+  TtsExportWriter writer(nullptr);
+  ASSERT_TRUE(writer.Submit(Job(0, dir.file("a.flac"), 100)));
+  ASSERT_TRUE(writer.Submit(Job(1, dir.file("missing/b.wav"), 100)));
+  ASSERT_TRUE(writer.Submit(Job(2, dir.file("c.wav"), 100)));
+  const auto results = writer.Finish();
+  ASSERT_EQ(results.size(), 3u);
+  EXPECT_FALSE(results[0].error.empty());
+  EXPECT_FALSE(results[1].error.empty());
+  EXPECT_TRUE(results[2].error.empty());
+}
+
+TEST(TtsExportWriter, AppliesTempoOnTheEncoderThread) {
+  TempDir dir("tts_export_writer_test_");
+  TtsExportWriter writer(nullptr, 2.0f);
+  ASSERT_TRUE(writer.Submit(Job(0, dir.file("fast.wav"), 24000)));
+  const auto results = writer.Finish();
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_EQ(results[0].numSamples, 12000u);
+}
+
+TEST(TtsExportWriter, SubmitOverlapsEncodingOfThePreviousItem) {
+  TempDir dir("tts_export_writer_test_");
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool release = false;
+  std::atomic<int> encoding{0};
+  TtsExportWriter writer([&](const std::string&, const std::string&, const std::string&) {
+    encoding.fetch_add(1);
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return release; });
+    return std::string();
+  });
+  ASSERT_TRUE(writer.Submit(Job(0, dir.file("0.mp3"), 100)));
+  // Item 0 is blocked in the encoder; item 1 still fits in the slot.
+  ASSERT_TRUE(writer.Submit(Job(1, dir.file("1.mp3"), 100)));
+  while (encoding.load() == 0) std::this_thread::yield();
+  EXPECT_TRUE(writer.TakeCompleted().empty());
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  cv.notify_all();
+  const auto results = writer.Finish();
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0].index, 0u);
+  EXPECT_EQ(results[1].index, 1u);
+}
+
+TEST(TtsExportWriter, CancelDropsTheQueuedItem) {
+  TempDir dir("tts_export_writer_test_");
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool release = false;
+  std::atomic<int> encoding{0};
+  TtsExportWriter writer([&](const std::string&, const std::string&, const std::string&) {
+    encoding.fetch_add(1);
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return release; });
+    return std::string();
+  });
+  ASSERT_TRUE(writer.Submit(Job(0, dir.file("0.mp3"), 100)));
+  while (encoding.load() == 0) std::this_thread::yield();
+  ASSERT_TRUE(writer.Submit(Job(1, dir.file("1.mp3"), 100)));
+  writer.Cancel();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  cv.notify_all();
+  const auto results = writer.Finish();
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_EQ(results[0].index, 0u);
+  EXPECT_EQ(encoding.load(), 1);
+}
@@ -0,0 +1,206 @@
+/**
+ * tts_playback_buffer_test.cpp
+ *
+ * Host-side GTest suite for the TTS jitter buffer (sherpa-onnx-tts-playback-buffer.*): fixed-frame
+ * rechunking, prefill / tail handling, underrun and overrun accounting, and target adaptation,
+ * driven by a simulated clock.
+ */
+
+#include "sherpa-onnx-tts-playback-buffer.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace sherpaonnx;
+
+namespace {
+
+PlaybackBufferConfig Config16k() {
+  PlaybackBufferConfig c;
+  c.sampleRate = 16000;
+  c.frameSamples = 320;  // 20 ms
+  c.initialTargetMs = 100;
+  c.minTargetMs = 40;
+  c.maxTargetMs = 600;
+  c.adaptStepMs = 40;
+  c.relaxAfterMs = 3000;
+  c.endGapMs = 1000;
+  c.capacityMs = 2000;
+  return c;
+}
+
+/** Ramp 0, 1, 2, ... starting at first, so reordering or loss is detectable. */
+std::vector<float> Ramp(int32_t first, int32_t n) {
+  std::vector<float> v(static_cast<size_t>(n));
+  for (int32_t i = 0; i < n; ++i) v[static_cast<size_t>(i)] = static_cast<float>(first + i);
+  return v;
+}
+
+}  // namespace
+
+TEST(TtsPlaybackBuffer, RechunksIrregularInputIntoFixedFrames) {
+  TtsPlaybackBuffer buf(Config16k());
+  int32_t pushed = 0;
+  for (int32_t n : {100, 1000, 37, 2000, 1}) {
+    auto chunk = Ramp(pushed, n);
+    ASSERT_EQ(buf.Push(chunk.data(), n, 0), n);
+    pushed += n;
+  }
+  buf.MarkEnd();
+
+  std::vector<float> out;
+  std::vector<float> frame(320);
+  int64_t now = 0;
+  while (!buf.Drained()) {
+    const int32_t got = buf.Pull(frame.data(), 320, now += 20);
+    out.insert(out.end(), frame.begin(), frame.begin() + got);
+    for (int32_t i = got; i < 320; ++i) EXPECT_EQ(frame[static_cast<size_t>(i)], 0.0f);
+  }
+  ASSERT_EQ(static_cast<int32_t>(out.size()), pushed);
+  for (int32_t i = 0; i < pushed; ++i) ASSERT_EQ(out[static_cast<size_t>(i)], static_cast<float>(i));
+  EXPECT_EQ(buf.GetStats().underruns, 0u);
+}
+
+TEST(TtsPlaybackBuffer, PrefillsToTargetBeforePlaying) {
+  TtsPlaybackBuffer buf(Config16k());  // target 100 ms = 1600 samples
+  std::vector<float> frame(320);
+  auto chunk = Ramp(1, 800);
+  buf.Push(chunk.data(), 800, 0);
+  EXPECT_EQ(buf.Pull(frame.data(), 320, 20), 0);  // still prefilling
+  buf.Push(chunk.data(), 800, 40);
+  EXPECT_EQ(buf.Pull(frame.data(), 320, 60), 320);
+
+  PlaybackBufferStats s = buf.GetStats();
+  EXPECT_TRUE(s.playing);
+  EXPECT_EQ(s.silentFrames, 1u);
+  EXPECT_EQ(s.fillSamples, 1280);
+  EXPECT_EQ(s.underruns, 0u);
+}
+
+TEST(TtsPlaybackBuffer, ShortTailPlaysAfterIdleOrMarkEnd) {
+  std::vector<float> frame(320);
+  auto chunk = Ramp(1, 480);  // 30 ms, below the 100 ms target
+
+  TtsPlaybackBuffer idle(Config16k());
+  idle.Push(chunk.data(), 480, 0);
+  EXPECT_EQ(idle.Pull(frame.data(), 320, 50), 0);
+  EXPECT_EQ(idle.Pull(frame.data(), 320, 100), 320);  // nothing new for the target's duration
+  EXPECT_EQ(idle.Pull(frame.data(), 320, 120), 160);
+
+  TtsPlaybackBuffer ended(Config16k());
+  ended.Push(chunk.data(), 480, 0);
+  ended.MarkEnd();
+  EXPECT_EQ(ended.Pull(frame.data(), 320, 1), 320);
+  EXPECT_EQ(ended.Pull(frame.data(), 320, 2), 160);
+  EXPECT_TRUE(ended.Drained());
+  EXPECT_EQ(ended.GetStats().underruns, 0u);
+}
+
+TEST(TtsPlaybackBuffer, RunningDryMidUtteranceRaisesTarget) {
+  TtsPlaybackBuffer buf(Config16k());
+  std::vector<float> frame(320);
+  auto chunk = Ramp(1, 1600);
+  buf.Push(chunk.data(), 1600, 0);
+  int64_t now = 0;
+  for (int i = 0; i < 5; ++i) EXPECT_EQ(buf.Pull(frame.data(), 320, now += 20), 320);
+  EXPECT_EQ(buf.Pull(frame.data(), 320, now += 20), 0);  // dry
+
+  buf.Push(chunk.data(), 1600, now + 50);  // the generator was just late
+  PlaybackBufferStats s = buf.GetStats();
+  EXPECT_EQ(s.underruns, 1u);
+  EXPECT_EQ(s.targetSamples, 1600 + 640);
+  EXPECT_FALSE(s.playing);
+}
+
+TEST(TtsPlaybackBuffer, AudioAfterLongGapIsANewUtteranceNotAnUnderrun) {
+  TtsPlaybackBuffer buf(Config16k());
+  std::vector<float> frame(320);
+  auto chunk = Ramp(1, 1600);
+  buf.Push(chunk.data(), 1600, 0);
+  int64_t now = 0;
+  for (int i = 0; i < 6; ++i) buf.Pull(frame.data(), 320, now += 20);
+
+  buf.Push(chunk.data(), 1600, now + 5000);
+  PlaybackBufferStats s = buf.GetStats();
+  EXPECT_EQ(s.underruns, 0u);
+  EXPECT_EQ(s.targetSamples, 1600);
+}
+
+TEST(TtsPlaybackBuffer, CleanPlaybackLowersTarget) {
+  PlaybackBufferConfig c = Config16k();
+  c.relaxAfterMs = 200;
+  TtsPlaybackBuffer buf(c);
+  std::vector<float> frame(320);
+  auto chunk = Ramp(1, 16000);
+  buf.Push(chunk.data(), 16000, 0);
+  int64_t now = 0;
+  for (int i = 0; i < 10; ++i) buf.Pull(frame.data(), 320, now += 20);  // 200 ms played
+  EXPECT_EQ(buf.GetStats().targetSamples, 1600 - 640);
+  for (int i = 0; i < 40; ++i) buf.Pull(frame.data(), 320, now += 20);
+  EXPECT_EQ(buf.GetStats().targetSamples, 640);  // clamped at minTargetMs
+}
+
+TEST(TtsPlaybackBuffer, OverrunAcceptsWhatFitsAndWriterWaits) {
+  PlaybackBufferConfig c = Config16k();
+  c.capacityMs = 0;  // smallest ring: maxTarget + two frames
+  TtsPlaybackBuffer buf(c);
+  const int32_t capacity = 9600 + 640;
+  auto big = Ramp(0, capacity + 1000);
+  EXPECT_EQ(buf.Push(big.data(), capacity + 1000, 0), capacity);
+  EXPECT_EQ(buf.GetStats().overruns, 1u);
+  EXPECT_EQ(buf.GetStats().maxFillSamples, capacity);
+
+  std::atomic<bool> writable{false};
+  std::thread writer([&] { writable = buf.WaitWritable(1000, 2000); });
+  std::vector<float> frame(1000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  buf.Pull(frame.data(), 1000, 1);
+  writer.join();
+  EXPECT_TRUE(writable.load());
+
+  std::thread closed([&] { writable = buf.WaitWritable(capacity, 2000); });
+  buf.Close();
+  closed.join();
+  EXPECT_FALSE(writable.load());
+}
+
+TEST(TtsPlaybackBuffer, AdaptsToBurstyGeneratorOnSimulatedClock) {
+  // The generator keeps up on average (100 ms of audio per 100 ms) but is bursty: four chunks
+  // 50 ms apart, then a stall of 360 ms or 240 ms, alternating. The sink pulls a 20 ms frame
+  // every 20 ms, so the initial 100 ms target cannot absorb the longer stall.
+  PlaybackBufferConfig c = Config16k();
+  c.relaxAfterMs = 60000;
+  TtsPlaybackBuffer buf(c);
+  const int32_t chunkSamples = 1600;
+  std::vector<float> frame(320);
+  std::vector<float> out;
+  int32_t produced = 0;
+  int64_t nextChunkMs = 0;
+  int chunkIndex = 0;
+  uint64_t underrunsFirstHalf = 0;
+  const int64_t endMs = 60000;
+  for (int64_t now = 0; now <= endMs; ++now) {
+    if (now == nextChunkMs) {
+      auto chunk = Ramp(produced, chunkSamples);
+      ASSERT_EQ(buf.Push(chunk.data(), chunkSamples, now), chunkSamples);
+      produced += chunkSamples;
+      ++chunkIndex;
+      nextChunkMs += chunkIndex % 5 != 0 ? 50 : (chunkIndex % 10 == 5 ? 360 : 240);
+    }
+    if (now % 20 == 0) {
+      const int32_t got = buf.Pull(frame.data(), 320, now);
+      out.insert(out.end(), frame.begin(), frame.begin() + got);
+    }
+    if (now == endMs / 2) underrunsFirstHalf = buf.GetStats().underruns;
+  }
+
+  PlaybackBufferStats s = buf.GetStats();
+  EXPECT_GT(underrunsFirstHalf, 0u);
+  EXPECT_EQ(s.underruns, underrunsFirstHalf);  // settled: no underruns in the second half
+  EXPECT_GT(s.targetSamples, 1600);
+  EXPECT_LE(s.targetSamples, 9600);
+  for (size_t i = 0; i < out.size(); ++i) ASSERT_EQ(out[i], static_cast<float>(i));
+}
@@ -0,0 +1,147 @@
+/**
+ * tts_prompt_registry_test.cpp
+ *
+ * Host-side GTest suite for the voice-cloning prompt registry (sherpa-onnx-tts-prompt-registry.*):
+ * id allocation, one-time resampling to the engine rate, removal while a prompt is in use, owner
+ * scoping and concurrent registration.
+ */
+
+#include "sherpa-onnx-tts-prompt-registry.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace sherpaonnx;
+
+namespace {
+
+// Stand-in resampler: nearest-neighbour, counting calls.
+TtsPromptRegistry::Resampler CountingResampler(std::atomic<int>* calls) {
+  return [calls](const float* samples, size_t n, int32_t inRate, int32_t outRate) {
+    ++*calls;
+    const size_t outN = n * static_cast<size_t>(outRate) / static_cast<size_t>(inRate);
+    std::vector<float> out(outN);
+    for (size_t i = 0; i < outN; ++i) out[i] = samples[i * static_cast<size_t>(inRate) / outRate];
+    return out;
+  };
+}
+
+}  // namespace
+
+TEST(TtsPromptRegistry, RegisterGetRemove) {
+  TtsPromptRegistry registry;
+  const std::vector<float> audio = {0.1f, 0.2f, 0.3f};
+  const int64_t a = registry.Register("tts-1", "hello", audio.data(), audio.size(), 16000);
+  const int64_t b = registry.Register("tts-1", "world", audio.data(), 2, 16000);
+  ASSERT_GT(a, 0);
+  ASSERT_GT(b, 0);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(registry.Size(), 2u);
+  EXPECT_EQ(registry.Bytes(), 5 * sizeof(float));
+
+  auto p = registry.Get("tts-1", a);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(p->text, "hello");
+  EXPECT_EQ(p->samples, audio);
+  EXPECT_EQ(p->sampleRate, 16000);
+
+  EXPECT_TRUE(registry.Remove("tts-1", a));
+  EXPECT_FALSE(registry.Remove("tts-1", a));
+  EXPECT_EQ(registry.Get("tts-1", a), nullptr);
+  // A prompt fetched before removal stays usable.
+  EXPECT_EQ(p->samples.size(), 3u);
+  EXPECT_EQ(registry.Bytes(), 2 * sizeof(float));
+
+  registry.Clear();
+  EXPECT_EQ(registry.Size(), 0u);
+  EXPECT_EQ(registry.Bytes(), 0u);
+  EXPECT_EQ(registry.Get("tts-1", b), nullptr);
+}
+
+TEST(TtsPromptRegistry, PromptsAreScopedToTheirOwner) {
+  TtsPromptRegistry registry;
+  const std::vector<float> audio = {0.1f, 0.2f};
+  const int64_t mine = registry.Register("tts-1", "mine", audio.data(), audio.size(), 16000);
+  const int64_t theirs = registry.Register("tts-2", "theirs", audio.data(), audio.size(), 16000);
+  registry.Register("tts-2", "theirs too", audio.data(), audio.size(), 16000);
+
+  // Ids are unique across owners but only resolve for the owner that registered them.
+  EXPECT_NE(mine, theirs);
+  EXPECT_EQ(registry.Get("tts-2", mine), nullptr);
+  EXPECT_EQ(registry.Get("tts-1", theirs), nullptr);
+  EXPECT_FALSE(registry.Remove("tts-2", mine));
+  ASSERT_NE(registry.Get("tts-1", mine), nullptr);
+
+  EXPECT_EQ(registry.RemoveOwner("tts-2"), 2u);
+  EXPECT_EQ(registry.Get("tts-2", theirs), nullptr);
+  EXPECT_EQ(registry.Size(), 1u);
+  EXPECT_EQ(registry.Bytes(), 2 * sizeof(float));
+  EXPECT_EQ(registry.RemoveOwner("tts-2"), 0u);
+}
+
+TEST(TtsPromptRegistry, RejectsEmptyOrInvalidAudio) {
+  TtsPromptRegistry registry;
+  const float s = 0.5f;
+  EXPECT_EQ(registry.Register("tts-1", "x", nullptr, 0, 16000), 0);
+  EXPECT_EQ(registry.Register("tts-1", "x", &s, 0, 16000), 0);
+  EXPECT_EQ(registry.Register("tts-1", "x", &s, 1, 0), 0);
+  EXPECT_EQ(registry.Size(), 0u);
+}
+
+TEST(TtsPromptRegistry, ResamplesOnceToTargetRate) {
+  std::atomic<int> calls{0};
+  TtsPromptRegistry registry(24000, CountingResampler(&calls));
+  std::vector<float> audio(16000);
+  for (size_t i = 0; i < audio.size(); ++i) audio[i] = static_cast<float>(i) / 16000.0f;
+
+  const int64_t id = registry.Register("tts-1", "ref", audio.data(), audio.size(), 16000);
+  EXPECT_EQ(calls.load(), 1);
+  for (int i = 0; i < 10; ++i) {
+    auto p = registry.Get("tts-1", id);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(p->sampleRate, 24000);
+    EXPECT_EQ(p->samples.size(), 24000u);
+  }
+  EXPECT_EQ(calls.load(), 1);
+
+  // Already at the target rate: stored as-is without resampling.
+  const int64_t same = registry.Register("tts-1", "ref", audio.data(), audio.size(), 24000);
+  EXPECT_EQ(calls.load(), 1);
+  EXPECT_EQ(registry.Get("tts-1", same)->samples, audio);
+}
+
+TEST(TtsPromptRegistry, FallsBackToOriginalWhenResamplerFails) {
+  TtsPromptRegistry registry(24000, [](const float*, size_t, int32_t, int32_t) {
+    return std::vector<float>();
+  });
+  const std::vector<float> audio = {0.1f, 0.2f};
+  auto p = registry.Get("tts-1", registry.Register("tts-1", "ref", audio.data(), audio.size(), 16000));
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(p->sampleRate, 16000);
+  EXPECT_EQ(p->samples, audio);
+}
+
+TEST(TtsPromptRegistry, ConcurrentRegistrationYieldsUniqueIds) {
+  TtsPromptRegistry registry;
+  const std::vector<float> audio(64, 0.25f);
+  constexpr int kThreads = 8;
+  constexpr int kPerThread = 100;
+  std::vector<std::vector<int64_t>> ids(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kPerThread; ++i) {
+        ids[t].push_back(registry.Register("tts-1", "p", audio.data(), audio.size(), 16000));
+      }
+    });
+  }
+  for (auto& th : threads) th.join();
+  std::set<int64_t> unique;
+  for (const auto& v : ids) unique.insert(v.begin(), v.end());
+  EXPECT_EQ(unique.size(), static_cast<size_t>(kThreads * kPerThread));
+  EXPECT_EQ(unique.count(0), 0u);
+  EXPECT_EQ(registry.Size(), static_cast<size_t>(kThreads * kPerThread));
+}
@@ -0,0 +1,323 @@
+/**
+ * tts_sentence_pipeline_test.cpp
+ *
+ * Host-side GTest suite for the long-text TTS pipeline (sherpa-onnx-tts-sentence-pipeline.*):
+ * sentence splitting, the leading-clause split and budget planner of the first-chunk fast path, the
+ * incremental segmenter for fragmented input, and ordered reassembly of sentences synthesized in parallel. Synthesis is
+ * simulated with callbacks that sleep for varying times so completion order differs from text order.
+ */
+
+#include "sherpa-onnx-tts-sentence-pipeline.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sherpaonnx;
+
+TEST(SplitSentences, SplitsOnTerminatorsAndNewlines) {
+  auto s = SplitSentences("Hello world. How are you?  Fine!\nNext line; done");
+  ASSERT_EQ(s.size(), 5u);
+  EXPECT_EQ(s[0], "Hello world.");
+  EXPECT_EQ(s[1], "How are you?");
+  EXPECT_EQ(s[2], "Fine!");
+  EXPECT_EQ(s[3], "Next line;");
+  EXPECT_EQ(s[4], "done");
+}
+
+TEST(SplitSentences, KeepsDecimalsAndEllipsisTogether) {
+  auto s = SplitSentences("Pi is 3.14... roughly. Ok");
+  ASSERT_EQ(s.size(), 3u);
+  EXPECT_EQ(s[0], "Pi is 3.14...");
+  EXPECT_EQ(s[1], "roughly.");
+  EXPECT_EQ(s[2], "Ok");
+}
+
+TEST(SplitSentences, SplitsCjkPunctuation) {
+  auto s = SplitSentences("你好。今天怎么样？很好！");
+  ASSERT_EQ(s.size(), 3u);
+  EXPECT_EQ(s[0], "你好。");
+  EXPECT_EQ(s[1], "今天怎么样？");
+  EXPECT_EQ(s[2], "很好！");
+}
+
+TEST(SplitSentences, BreaksOverlongSentencesAtCommaOrSpace) {
+  auto s = SplitSentences("one two three, four five six seven", 15);
+  for (const auto& piece : s) EXPECT_LE(piece.size(), 15u);
+  std::string joined;
+  for (const auto& piece : s) joined += (joined.empty() ? "" : " ") + piece;
+  EXPECT_EQ(joined, "one two three, four five six seven");
+}
+
+TEST(SplitSentences, DropsEmptyPieces) {
+  EXPECT_TRUE(SplitSentences("  \n\n  ").empty());
+  EXPECT_TRUE(SplitSentences("").empty());
+}
+
+TEST(SplitLeadingClause, BreaksAtLastClausePunctuationInBudget) {
+  auto parts = SplitLeadingClause("Well, as I was saying, the meeting is moved to Friday afternoon.", 30);
+  EXPECT_EQ(parts.first, "Well, as I was saying,");
+  EXPECT_EQ(parts.second, "the meeting is moved to Friday afternoon.");
+}
+
+TEST(SplitLeadingClause, FallsBackToSpaceAndHonorsMinimum) {
+  auto parts = SplitLeadingClause("Hi, the quick brown fox jumps over the lazy dog", 20, 8);
+  // "Hi," is shorter than minChars, so the last space within the budget is used instead.
+  EXPECT_EQ(parts.first, "Hi, the quick brown");
+  EXPECT_EQ(parts.second, "fox jumps over the lazy dog");
+}
+
+TEST(SplitLeadingClause, DoesNotSplitShortTextOrDecimals) {
+  auto shortText = SplitLeadingClause("  Short text.  ", 40);
+  EXPECT_TRUE(shortText.first.empty());
+  EXPECT_EQ(shortText.second, "Short text.");
+  auto decimals = SplitLeadingClause("Pi is about 3.14159 and e is about 2.71828 today", 20, 4);
+  EXPECT_EQ(decimals.first, "Pi is about 3.14159");
+  auto longWord = SplitLeadingClause("Supercalifragilisticexpialidocious rest", 10);
+  EXPECT_TRUE(longWord.first.empty());
+}
+
+TEST(SplitLeadingClause, HandlesCjk) {
+  // "你好，" is 9 bytes; the budget of 12 bytes ends inside the next clause.
+  auto parts = SplitLeadingClause("你好，今天天气很好。", 12, 3);
+  EXPECT_EQ(parts.first, "你好，");
+  EXPECT_EQ(parts.second, "今天天气很好。");
+  // No punctuation in range: cut at a character boundary, never inside a code point.
+  auto cut = SplitLeadingClause("今天天气很好我们去公园吧", 10, 3);
+  EXPECT_EQ(cut.first, "今天天");
+  EXPECT_EQ(cut.first + cut.second, "今天天气很好我们去公园吧");
+}
+
+TEST(SplitLeadingClause, RestSplitsIntoSentencesAfterHead) {
+  auto parts = SplitLeadingClause("A rather long opening sentence, with a clause. Second one.", 35);
+  EXPECT_EQ(parts.first, "A rather long opening sentence,");
+  auto rest = SplitSentences(parts.second);
+  ASSERT_EQ(rest.size(), 2u);
+  EXPECT_EQ(rest[0], "with a clause.");
+  EXPECT_EQ(rest[1], "Second one.");
+}
+
+TEST(FirstChunkPlanner, DisabledWithoutTargetAndInitialBudgetBeforeObservations) {
+  FirstChunkPlanner planner;
+  EXPECT_EQ(planner.Budget(0), 0u);
+  EXPECT_EQ(planner.Budget(300), 48u);
+  EXPECT_EQ(planner.MsPerChar(), 0.0);
+}
+
+TEST(FirstChunkPlanner, ConvergesOnBudgetThatMeetsTarget) {
+  // Simulated engine: 100 ms fixed overhead + 2 ms per byte; 300 ms target -> 100 bytes.
+  FirstChunkPlanner planner;
+  size_t budget = planner.Budget(300);
+  for (int i = 0; i < 30; ++i) {
+    planner.Observe(budget, 100 + 2 * static_cast<int64_t>(budget));
+    budget = planner.Budget(300);
+  }
+  EXPECT_NEAR(static_cast<double>(budget), 100.0, 3.0);
+  planner.Reset();
+  EXPECT_EQ(planner.Budget(300), 48u);
+}
+
+TEST(FirstChunkPlanner, ClampsToLimits) {
+  FirstChunkPlanner::Options opts;
+  opts.minChars = 10;
+  opts.maxChars = 50;
+  FirstChunkPlanner planner(opts);
+  planner.Observe(10, 1000);  // very slow engine
+  EXPECT_EQ(planner.Budget(200), 10u);
+  FirstChunkPlanner fast(opts);
+  fast.Observe(100, 1);  // very fast engine
+  EXPECT_EQ(fast.Budget(200), 50u);
+}
+
+namespace {
+
+/** Push text through the segmenter in fragments of `step` bytes, then flush. */
+std::vector<std::string> SegmentInFragments(IncrementalTextSegmenter& segmenter, const std::string& text,
+                                            size_t step) {
+  std::vector<std::string> all;
+  for (size_t i = 0; i < text.size(); i += step) {
+    for (auto& s : segmenter.Push(text.substr(i, step))) all.push_back(std::move(s));
+  }
+  for (auto& s : segmenter.Flush()) all.push_back(std::move(s));
+  return all;
+}
+
+}  // namespace
+
+TEST(IncrementalTextSegmenter, EmitsSentencesAsSoonAsTheirEndIsKnown) {
+  IncrementalTextSegmenter segmenter;
+  EXPECT_TRUE(segmenter.Push("The value is 3.").empty());  // could still be 3.14
+  EXPECT_TRUE(segmenter.Push("14 today").empty());
+  auto ready = segmenter.Push(". Next");
+  ASSERT_EQ(ready.size(), 1u);
+  EXPECT_EQ(ready[0], "The value is 3.14 today.");
+  EXPECT_TRUE(segmenter.Push(" one").empty());
+  EXPECT_EQ(segmenter.PendingBytes(), 8u);  // "Next one"
+  ready = segmenter.Flush();
+  ASSERT_EQ(ready.size(), 1u);
+  EXPECT_EQ(ready[0], "Next one");
+  EXPECT_TRUE(segmenter.Flush().empty());
+}
+
+TEST(IncrementalTextSegmenter, SameSegmentsForAnyFragmentation) {
+  const std::string text =
+      "Hi. Dr. Smith will see you now! Please bring your card, your forms and a pen; "
+      "then wait for me.\n你好。今天天气很好，我们去公园吧！";
+  IncrementalTextSegmenter whole;
+  const auto expected = SegmentInFragments(whole, text, text.size());
+  ASSERT_EQ(expected.size(), 4u);
+  EXPECT_EQ(expected[0], "Hi. Dr. Smith will see you now!");  // short pieces are merged
+  EXPECT_EQ(expected[1], "Please bring your card, your forms and a pen;");
+  EXPECT_EQ(expected[2], "then wait for me.");
+  EXPECT_EQ(expected[3], "你好。今天天气很好，我们去公园吧！");
+  for (size_t step : {1u, 2u, 3u, 5u, 7u}) {
+    IncrementalTextSegmenter segmenter;
+    EXPECT_EQ(SegmentInFragments(segmenter, text, step), expected) << "step " << step;
+  }
+}
+
+TEST(IncrementalTextSegmenter, CutsLongSentencesAtClausesEarlierForTheFirstSegment) {
+  IncrementalTextSegmenter::Options opts;
+  opts.firstClauseChars = 30;
+  opts.clauseChars = 60;
+  IncrementalTextSegmenter segmenter(opts);
+  const std::string text =
+      "Well, here is a fairly long opening clause, followed by more words, and then a second "
+      "clause that keeps going, until it finally ends.";
+  const auto segments = SegmentInFragments(segmenter, text, 4);
+  ASSERT_EQ(segments.size(), 4u);
+  EXPECT_EQ(segments[0], "Well, here is a fairly long opening clause,");
+  // Later segments cut at the last clause before clauseChars.
+  EXPECT_EQ(segments[1], "followed by more words,");
+  EXPECT_EQ(segments[2], "and then a second clause that keeps going,");
+  EXPECT_EQ(segments[3], "until it finally ends.");
+}
+
+TEST(IncrementalTextSegmenter, HardCutsUnpunctuatedText) {
+  IncrementalTextSegmenter::Options opts;
+  opts.maxChars = 20;
+  IncrementalTextSegmenter segmenter(opts);
+  const auto segments = SegmentInFragments(segmenter, "one two three four five six seven eight", 3);
+  ASSERT_GE(segments.size(), 2u);
+  std::string joined;
+  for (const auto& s : segments) {
+    EXPECT_LE(s.size(), 20u);
+    joined += (joined.empty() ? "" : " ") + s;
+  }
+  EXPECT_EQ(joined, "one two three four five six seven eight");
+}
+
+namespace {
+
+// Each sentence "N" synthesizes to N+1 samples of value N; later sentences finish first.
+bool FakeSynth(int32_t, const std::string& sentence, std::vector<float>* out) {
+  const int n = std::stoi(sentence);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5 * (8 - n % 8)));
+  out->assign(static_cast<size_t>(n + 1), static_cast<float>(n));
+  return true;
+}
+
+std::vector<std::string> NumberedSentences(int count) {
+  std::vector<std::string> v;
+  for (int i = 0; i < count; ++i) v.push_back(std::to_string(i));
+  return v;
+}
+
+}  // namespace
+
+TEST(SentencePipeline, EmitsInOrderWithSilence) {
+  SentencePipelineOptions opts;
+  opts.numWorkers = 4;
+  opts.silenceSamples = 2;
+  std::vector<float> audio;
+  std::vector<int32_t> indices;
+  const std::thread::id caller = std::this_thread::get_id();
+  bool onCallerThread = true;
+
+  auto status = RunSentencePipeline(NumberedSentences(10), opts, FakeSynth,
+      [&](const float* s, int32_t n, int32_t idx, int32_t total) {
+        EXPECT_EQ(total, 10);
+        if (std::this_thread::get_id() != caller) onCallerThread = false;
+        audio.insert(audio.end(), s, s + n);
+        indices.push_back(idx);
+        return true;
+      });
+
+  EXPECT_EQ(status, SentencePipelineStatus::kOk);
+  EXPECT_TRUE(onCallerThread);
+  std::vector<float> expected;
+  for (int i = 0; i < 10; ++i) {
+    if (i > 0) expected.insert(expected.end(), 2, 0.0f);
+    expected.insert(expected.end(), static_cast<size_t>(i + 1), static_cast<float>(i));
+  }
+  EXPECT_EQ(audio, expected);
+  for (size_t k = 1; k < indices.size(); ++k) EXPECT_LE(indices[k - 1], indices[k]);
+}
+
+TEST(SentencePipeline, NoSilenceAfterLeadingClause) {
+  SentencePipelineOptions opts;
+  opts.numWorkers = 2;
+  opts.silenceSamples = 2;
+  opts.firstIsClause = true;
+  std::vector<float> audio;
+  auto status = RunSentencePipeline(NumberedSentences(3), opts, FakeSynth,
+      [&](const float* s, int32_t n, int32_t, int32_t) {
+        audio.insert(audio.end(), s, s + n);
+        return true;
+      });
+  EXPECT_EQ(status, SentencePipelineStatus::kOk);
+  EXPECT_EQ(audio, (std::vector<float>{0, 1, 1, 0, 0, 2, 2, 2}));
+}
+
+TEST(SentencePipeline, UsesEachWorkerFromOneThreadAtATime) {
+  SentencePipelineOptions opts;
+  opts.numWorkers = 3;
+  std::atomic<int> busy[3] = {{0}, {0}, {0}};
+  std::atomic<bool> overlap{false};
+  auto status = RunSentencePipeline(NumberedSentences(12), opts,
+      [&](int32_t w, const std::string& s, std::vector<float>* out) {
+        if (busy[w].fetch_add(1) != 0) overlap = true;
+        bool ok = FakeSynth(w, s, out);
+        busy[w].fetch_sub(1);
+        return ok;
+      },
+      [](const float*, int32_t, int32_t, int32_t) { return true; });
+  EXPECT_EQ(status, SentencePipelineStatus::kOk);
+  EXPECT_FALSE(overlap.load());
+}
+
+TEST(SentencePipeline, CancelStopsRemainingWork) {
+  SentencePipelineOptions opts;
+  opts.numWorkers = 2;
+  std::atomic<int> synthesized{0};
+  int emitted = 0;
+  auto status = RunSentencePipeline(NumberedSentences(50), opts,
+      [&](int32_t w, const std::string& s, std::vector<float>* out) {
+        ++synthesized;
+        return FakeSynth(w, s, out);
+      },
+      [&](const float*, int32_t, int32_t, int32_t) { return ++emitted < 2; });
+  EXPECT_EQ(status, SentencePipelineStatus::kCancelled);
+  EXPECT_EQ(emitted, 2);
+  EXPECT_LT(synthesized.load(), 50);
+}
+
+TEST(SentencePipeline, FailureIsReportedAfterPrecedingSentences) {
+  SentencePipelineOptions opts;
+  opts.numWorkers = 2;
+  std::vector<int32_t> indices;
+  auto status = RunSentencePipeline(NumberedSentences(6), opts,
+      [](int32_t w, const std::string& s, std::vector<float>* out) {
+        if (s == "3") return false;
+        return FakeSynth(w, s, out);
+      },
+      [&](const float*, int32_t, int32_t idx, int32_t) {
+        indices.push_back(idx);
+        return true;
+      });
+  EXPECT_EQ(status, SentencePipelineStatus::kFailed);
+  EXPECT_EQ(indices, (std::vector<int32_t>{0, 1, 2}));
+}
@@ -0,0 +1,172 @@
+/**
+ * tts_stats_test.cpp
+ *
+ * Host-side GTest suite for TTS request instrumentation (sherpa-onnx-tts-stats.*): histogram
+ * bucketing, merging and percentile estimates, per-request timing and RTF, and aggregation.
+ */
+
+#include "sherpa-onnx-tts-stats.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace sherpaonnx;
+
+TEST(StatsHistogram, BucketsByUpperBoundWithOverflow) {
+  StatsHistogram h({10.0, 20.0, 40.0});
+  for (double v : {1.0, 10.0, 10.5, 20.0, 39.0, 41.0, 1000.0}) h.Record(v);
+
+  ASSERT_EQ(h.Counts().size(), 4u);
+  EXPECT_EQ(h.Counts()[0], 2u);  // 1, 10
+  EXPECT_EQ(h.Counts()[1], 2u);  // 10.5, 20
+  EXPECT_EQ(h.Counts()[2], 1u);  // 39
+  EXPECT_EQ(h.Counts()[3], 2u);  // 41, 1000
+  EXPECT_EQ(h.Count(), 7u);
+  EXPECT_DOUBLE_EQ(h.Min(), 1.0);
+  EXPECT_DOUBLE_EQ(h.Max(), 1000.0);
+  EXPECT_DOUBLE_EQ(h.Sum(), 1121.5);
+}
+
+TEST(StatsHistogram, PercentilesStayWithinObservedRange) {
+  StatsHistogram h(LatencyBucketsMs());
+  EXPECT_EQ(h.Percentile(0.5), 0.0);
+
+  for (int i = 1; i <= 100; ++i) h.Record(static_cast<double>(i));
+  const double p50 = h.Percentile(0.5);
+  const double p90 = h.Percentile(0.9);
+  EXPECT_GE(p50, 40.0);
+  EXPECT_LE(p50, 80.0);
+  EXPECT_GE(p90, p50);
+  EXPECT_LE(p90, 100.0);
+  EXPECT_DOUBLE_EQ(h.Percentile(1.0), 100.0);
+  EXPECT_GE(h.Percentile(0.0), 1.0);
+
+  StatsHistogram single(LatencyBucketsMs());
+  single.Record(123.0);
+  EXPECT_DOUBLE_EQ(single.Percentile(0.5), 123.0);
+  EXPECT_DOUBLE_EQ(single.Percentile(0.99), 123.0);
+}
+
+TEST(StatsHistogram, MergeRequiresSameBounds) {
+  StatsHistogram a({1.0, 2.0});
+  StatsHistogram b({1.0, 2.0});
+  StatsHistogram other({5.0});
+  a.Record(0.5);
+  b.Record(1.5);
+  b.Record(3.0);
+  other.Record(4.0);
+
+  a.Merge(b);
+  a.Merge(other);
+  EXPECT_EQ(a.Count(), 3u);
+  EXPECT_EQ(a.Counts()[0], 1u);
+  EXPECT_EQ(a.Counts()[1], 1u);
+  EXPECT_EQ(a.Counts()[2], 1u);
+  EXPECT_DOUBLE_EQ(a.Min(), 0.5);
+  EXPECT_DOUBLE_EQ(a.Max(), 3.0);
+
+  a.Clear();
+  EXPECT_EQ(a.Count(), 0u);
+  EXPECT_EQ(a.Counts()[2], 0u);
+}
+
+TEST(TtsRequestTimer, MeasuresFirstChunkAudioAndRtf) {
+  TtsRequestTimer timer;
+  timer.OnChunk(0);  // empty chunks do not count
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  timer.OnChunk(1600);
+  timer.OnChunk(800);
+  timer.AddBytesCopied(2400 * sizeof(float));
+
+  TtsRequestStats s = timer.Finish(2400, 16000);
+  EXPECT_GE(s.timeToFirstChunkMs, 15);
+  EXPECT_GE(s.synthesisMs, s.timeToFirstChunkMs);
+  EXPECT_EQ(s.audioMs, 150);
+  EXPECT_EQ(s.chunkCount, 2);
+  EXPECT_EQ(s.chunkSamples.Count(), 2u);
+  EXPECT_DOUBLE_EQ(s.chunkSamples.Min(), 800.0);
+  EXPECT_DOUBLE_EQ(s.chunkSamples.Max(), 1600.0);
+  EXPECT_EQ(s.bytesCopied, 2400 * sizeof(float));
+  EXPECT_NEAR(s.realTimeFactor, static_cast<double>(s.synthesisMs) / 150.0, 1e-9);
+}
+
+TEST(TtsRequestTimer, NoAudioLeavesFirstChunkAndRtfUnset) {
+  TtsRequestTimer timer;
+  TtsRequestStats s = timer.Finish(0, 22050);
+  EXPECT_EQ(s.timeToFirstChunkMs, -1);
+  EXPECT_EQ(s.audioMs, 0);
+  EXPECT_EQ(s.realTimeFactor, 0.0);
+  EXPECT_EQ(s.chunkCount, 0);
+}
+
+TEST(TtsRequestTimer, QueueWaitBeforeEngineIsNotSynthesis) {
+  TtsRequestTimer timer;
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));  // waiting for the engine
+  timer.OnEngineAcquired();
+  timer.OnChunk(1600);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  timer.OnEngineAcquired();  // next piece of a stream: keeps the first start
+  TtsRequestStats s = timer.Finish(1600, 16000);
+  EXPECT_LT(s.timeToFirstChunkMs, 50);
+  EXPECT_GE(s.synthesisMs, 15);
+  EXPECT_LT(s.synthesisMs, 50);
+}
+
+TEST(TtsRequestTimer, AudioDurationCountsAllChannels) {
+  TtsRequestTimer timer;
+  EXPECT_EQ(timer.Finish(48000, 24000, 2).audioMs, 1000);
+}
+
+TEST(TtsStatsRecorder, AggregatesAndResets) {
+  TtsStatsRecorder recorder;
+  TtsRequestStats a;
+  a.timeToFirstChunkMs = 120;
+  a.synthesisMs = 400;
+  a.audioMs = 2000;
+  a.realTimeFactor = 0.2;
+  a.chunkCount = 2;
+  a.chunkSamples.Record(1024);
+  a.chunkSamples.Record(2048);
+  a.bytesCopied = 100;
+  TtsRequestStats b;  // produced no audio
+  b.synthesisMs = 50;
+
+  recorder.Record(a);
+  recorder.Record(b);
+  TtsStatsSnapshot s = recorder.Snapshot();
+  EXPECT_EQ(s.requests, 2u);
+  EXPECT_EQ(s.totalAudioMs, 2000u);
+  EXPECT_EQ(s.totalSynthesisMs, 450u);
+  EXPECT_EQ(s.bytesCopied, 100u);
+  EXPECT_EQ(s.timeToFirstChunkMs.Count(), 1u);
+  EXPECT_EQ(s.synthesisMs.Count(), 2u);
+  EXPECT_EQ(s.realTimeFactor.Count(), 1u);
+  EXPECT_EQ(s.chunkSamples.Count(), 2u);
+
+  recorder.Reset();
+  s = recorder.Snapshot();
+  EXPECT_EQ(s.requests, 0u);
+  EXPECT_EQ(s.chunkSamples.Count(), 0u);
+  EXPECT_EQ(s.chunkSamples.Counts().size(), ChunkSizeBuckets().size() + 1);
+}
+
+TEST(TtsStatsRecorder, ConcurrentRecording) {
+  TtsStatsRecorder recorder;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&recorder] {
+      for (int i = 0; i < 250; ++i) {
+        TtsRequestStats s;
+        s.synthesisMs = i;
+        s.chunkSamples.Record(512);
+        recorder.Record(s);
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  TtsStatsSnapshot s = recorder.Snapshot();
+  EXPECT_EQ(s.requests, 1000u);
+  EXPECT_EQ(s.chunkSamples.Count(), 1000u);
+}
@@ -0,0 +1,95 @@
+/**
+ * tts_step_planner_test.cpp
+ *
+ * Host-side GTest suite for the Zipvoice step planner (sherpa-onnx-tts-step-planner.*): flow length
+ * estimate, two-point calibration, budget-driven step choice, bootstrap from a single observation,
+ * drift tracking, and the stored text form.
+ */
+
+#include "sherpa-onnx-tts-step-planner.h"
+
+#include <gtest/gtest.h>
+
+using namespace sherpaonnx;
+
+namespace {
+
+/** A device where each step costs 30 ms per flow second and vocoder/front end 80 ms. */
+double DeviceMs(double flowSeconds, int32_t steps, double slowdown = 1.0) {
+  return slowdown * flowSeconds * (80.0 + 30.0 * steps);
+}
+
+}  // namespace
+
+TEST(ZipvoiceStepPlanner, FlowSecondsScalesWithTextAndSpeed) {
+  // 3 s prompt for 30 bytes: 60 bytes of text is ~6 s of audio, 3 s at double speed.
+  EXPECT_DOUBLE_EQ(ZipvoiceStepPlanner::FlowSeconds(60, 30, 3.0, 1.0f), 9.0);
+  EXPECT_DOUBLE_EQ(ZipvoiceStepPlanner::FlowSeconds(60, 30, 3.0, 2.0f), 6.0);
+  EXPECT_DOUBLE_EQ(ZipvoiceStepPlanner::FlowSeconds(60, 30, 0.0, 1.0f), 0.0);
+}
+
+TEST(ZipvoiceStepPlanner, CalibrationRecoversCostsAndPicksLargestFittingSteps) {
+  ZipvoiceStepPlanner planner;
+  const double flow = 4.0;
+  ASSERT_TRUE(planner.Calibrate(flow, 4, DeviceMs(flow, 4), 16, DeviceMs(flow, 16)));
+  ZipvoiceStepPlanner::Model m = planner.GetModel();
+  EXPECT_TRUE(m.calibrated);
+  EXPECT_NEAR(m.stepMsPerSec, 30.0, 1e-9);
+  EXPECT_NEAR(m.overheadMsPerSec, 80.0, 1e-9);
+
+  // 6 s of flow: 480 ms overhead + 180 ms per step; 2500 ms fits 11 steps (2460 ms), not 12.
+  ZipvoiceStepPlanner::Choice c = planner.Choose(2500, 6.0, 32);
+  EXPECT_EQ(c.numSteps, 11);
+  EXPECT_NEAR(c.predictedMs, DeviceMs(6.0, 11), 1e-6);
+  EXPECT_TRUE(c.fits);
+
+  // Generous budget: capped by maxSteps. Hopeless budget: minSteps, reported as not fitting.
+  EXPECT_EQ(planner.Choose(1e6, 6.0, 20).numSteps, 20);
+  ZipvoiceStepPlanner::Choice tight = planner.Choose(100, 6.0, 32);
+  EXPECT_EQ(tight.numSteps, 4);
+  EXPECT_FALSE(tight.fits);
+}
+
+TEST(ZipvoiceStepPlanner, RejectsUnusableCalibration) {
+  ZipvoiceStepPlanner planner;
+  EXPECT_FALSE(planner.Calibrate(4.0, 4, 500, 16, 400));
+  EXPECT_FALSE(planner.Calibrate(0.0, 4, 500, 16, 900));
+  EXPECT_FALSE(planner.GetModel().calibrated);
+  ZipvoiceStepPlanner::Choice c = planner.Choose(1000, 4.0, 20);
+  EXPECT_EQ(c.numSteps, 20);  // no model: the caller's step count
+  EXPECT_LT(c.predictedMs, 0.0);
+}
+
+TEST(ZipvoiceStepPlanner, FirstObservationBootstrapsAndDriftIsTracked) {
+  ZipvoiceStepPlanner planner;
+  planner.Observe(5.0, 20, DeviceMs(5.0, 20));
+  // Prior split (overhead = 2 steps) is off, but the prediction at the observed point is exact.
+  EXPECT_NEAR(planner.PredictMs(5.0, 20), DeviceMs(5.0, 20), 1e-6);
+  EXPECT_FALSE(planner.GetModel().calibrated);
+
+  ZipvoiceStepPlanner calibrated;
+  calibrated.Calibrate(4.0, 4, DeviceMs(4.0, 4), 16, DeviceMs(4.0, 16));
+  const int32_t before = calibrated.Choose(3000, 6.0).numSteps;
+  // The device becomes 1.5x slower (throttling): the scale converges and fewer steps are chosen.
+  for (int i = 0; i < 30; ++i) calibrated.Observe(6.0, before, DeviceMs(6.0, before, 1.5));
+  EXPECT_NEAR(calibrated.GetModel().scale, 1.5, 0.01);
+  const ZipvoiceStepPlanner::Choice after = calibrated.Choose(3000, 6.0);
+  EXPECT_LT(after.numSteps, before);
+  EXPECT_LE(DeviceMs(6.0, after.numSteps, 1.5), 3000.0);
+}
+
+TEST(ZipvoiceStepPlanner, SerializeRoundTrip) {
+  ZipvoiceStepPlanner planner;
+  planner.Calibrate(4.0, 4, DeviceMs(4.0, 4), 16, DeviceMs(4.0, 16));
+  planner.Observe(6.0, 10, DeviceMs(6.0, 10, 1.2));
+
+  ZipvoiceStepPlanner restored;
+  ASSERT_TRUE(restored.Restore(planner.Serialize()));
+  EXPECT_NEAR(restored.PredictMs(6.0, 12), planner.PredictMs(6.0, 12), 1e-3);
+  EXPECT_TRUE(restored.GetModel().calibrated);
+  EXPECT_EQ(restored.GetModel().observations, 1);
+
+  EXPECT_FALSE(restored.Restore("garbage"));
+  EXPECT_FALSE(restored.Restore("zvsteps1 1 -2 1 1 0"));
+  EXPECT_TRUE(restored.GetModel().calibrated);  // unchanged by failed restores
+}
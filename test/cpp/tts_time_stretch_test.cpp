@@ -0,0 +1,168 @@
+/**
+ * tts_time_stretch_test.cpp
+ *
+ * Host-side GTest suite for WSOLA time stretching (sherpa-onnx-tts-time-stretch.*): output length,
+ * pitch preservation, identity at tempo 1, streaming vs one-shot equivalence and tempo changes
+ * mid-stream.
+ */
+
+#include "sherpa-onnx-tts-time-stretch.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace sherpaonnx;
+
+namespace {
+
+constexpr int32_t kRate = 16000;
+
+std::vector<float> Sine(double hz, int32_t n, float amplitude = 0.5f) {
+  std::vector<float> v(static_cast<size_t>(n));
+  for (int32_t i = 0; i < n; ++i) {
+    v[static_cast<size_t>(i)] = amplitude * static_cast<float>(std::sin(2.0 * M_PI * hz * i / kRate));
+  }
+  return v;
+}
+
+/** Frequency from rising zero crossings over [from, to). */
+double EstimateHz(const std::vector<float>& v, size_t from, size_t to) {
+  size_t first = 0;
+  size_t last = 0;
+  int crossings = 0;
+  for (size_t i = from + 1; i < to; ++i) {
+    if (v[i - 1] < 0.0f && v[i] >= 0.0f) {
+      if (crossings == 0) first = i;
+      last = i;
+      ++crossings;
+    }
+  }
+  if (crossings < 2) return 0.0;
+  return static_cast<double>(crossings - 1) * kRate / static_cast<double>(last - first);
+}
+
+}  // namespace
+
+TEST(WsolaTimeStretcher, OutputLengthFollowsTempo) {
+  const auto in = Sine(220.0, kRate);
+  for (float tempo : {0.5f, 0.75f, 1.25f, 1.5f, 2.0f, 3.0f}) {
+    const auto out = WsolaTimeStretcher::Stretch(in.data(), in.size(), kRate, tempo);
+    EXPECT_EQ(out.size(), static_cast<size_t>(std::llround(kRate / static_cast<double>(tempo))))
+        << "tempo " << tempo;
+  }
+  EXPECT_TRUE(WsolaTimeStretcher::Stretch(nullptr, 0, kRate, 2.0f).empty());
+}
+
+TEST(WsolaTimeStretcher, PreservesPitchAndLevel) {
+  const auto in = Sine(200.0, 2 * kRate);
+  for (float tempo : {0.6f, 1.5f, 2.5f}) {
+    const auto out = WsolaTimeStretcher::Stretch(in.data(), in.size(), kRate, tempo);
+    const size_t from = out.size() / 4;
+    const size_t to = out.size() * 3 / 4;
+    EXPECT_NEAR(EstimateHz(out, from, to), 200.0, 4.0) << "tempo " << tempo;
+    float peak = 0.0f;
+    float minPeak = 1.0f;
+    // Per-period peaks stay near the input amplitude (no overlap-add dips or doubling).
+    for (size_t p = from; p + 80 <= to; p += 80) {
+      float local = 0.0f;
+      for (size_t i = p; i < p + 80; ++i) local = std::max(local, std::fabs(out[i]));
+      peak = std::max(peak, local);
+      minPeak = std::min(minPeak, local);
+    }
+    EXPECT_LT(peak, 0.55f) << "tempo " << tempo;
+    EXPECT_GT(minPeak, 0.4f) << "tempo " << tempo;
+  }
+}
+
+TEST(WsolaTimeStretcher, TempoOneStreamReproducesInput) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+  std::vector<float> in(kRate);
+  for (auto& s : in) s = dist(rng);
+
+  WsolaTimeStretcher stretcher(kRate, 1.0f);
+  std::vector<float> out;
+  for (size_t pos = 0; pos < in.size(); pos += 500) {
+    stretcher.Push(in.data() + pos, static_cast<int32_t>(std::min<size_t>(500, in.size() - pos)));
+    stretcher.ReadAll(&out);
+  }
+  stretcher.Flush();
+  stretcher.ReadAll(&out);
+  ASSERT_EQ(out.size(), in.size());
+  for (size_t i = 0; i < in.size(); ++i) ASSERT_NEAR(out[i], in[i], 1e-5f) << i;
+}
+
+TEST(WsolaTimeStretcher, StreamingMatchesOneShot) {
+  const auto in = Sine(180.0, kRate);
+  const auto expected = WsolaTimeStretcher::Stretch(in.data(), in.size(), kRate, 1.4f);
+
+  WsolaTimeStretcher stretcher(kRate, 1.4f);
+  std::vector<float> out;
+  std::vector<float> piece(300);
+  size_t pos = 0;
+  for (int32_t n : {1, 17, 333, 4096, 5000}) {
+    stretcher.Push(in.data() + pos, n);
+    pos += static_cast<size_t>(n);
+    // Read in small pieces too.
+    int32_t got;
+    while ((got = stretcher.Read(piece.data(), 300)) > 0) out.insert(out.end(), piece.begin(), piece.begin() + got);
+  }
+  stretcher.Push(in.data() + pos, static_cast<int32_t>(in.size() - pos));
+  stretcher.Flush();
+  stretcher.ReadAll(&out);
+  ASSERT_EQ(out.size(), expected.size());
+  for (size_t i = 0; i < out.size(); ++i) ASSERT_FLOAT_EQ(out[i], expected[i]) << i;
+}
+
+TEST(WsolaTimeStretcher, TempoChangeMidStreamAndRestart) {
+  const auto in = Sine(200.0, kRate);
+  WsolaTimeStretcher stretcher(kRate, 1.0f);
+  stretcher.Push(in.data(), kRate);
+  stretcher.SetTempo(2.0f);
+  stretcher.Push(in.data(), kRate);
+  stretcher.Flush();
+  // The first second was already pushed at tempo 1; the second at tempo 2.
+  EXPECT_NEAR(static_cast<double>(stretcher.Available()), kRate * 1.5, kRate * 0.02);
+
+  std::vector<float> drained;
+  stretcher.ReadAll(&drained);
+  stretcher.Push(in.data(), kRate);  // a Push after Flush starts a new stream
+  stretcher.Flush();
+  EXPECT_EQ(stretcher.Available(), kRate / 2);
+
+  stretcher.SetTempo(100.0f);
+  EXPECT_FLOAT_EQ(stretcher.tempo(), WsolaTimeStretcher::kMaxTempo);
+  stretcher.SetTempo(-1.0f);
+  EXPECT_FLOAT_EQ(stretcher.tempo(), 1.0f);
+}
+
+TEST(StretchedFrameReader, PassesThroughAtUnityAndStretchesOtherwise) {
+  int64_t next = 0;
+  int64_t pulled = 0;
+  auto ramp = [&](float* dst, int32_t count) {
+    for (int32_t i = 0; i < count; ++i) dst[i] = static_cast<float>(next++);
+    pulled += count;
+  };
+  StretchedFrameReader reader(kRate, 320);
+  std::vector<float> frame(256);
+
+  reader.Fill(frame.data(), 256, ramp);
+  EXPECT_EQ(pulled, 256);
+  EXPECT_EQ(frame[255], 255.0f);
+
+  // At tempo 2, each output frame consumes about two frames of input.
+  reader.SetTempo(2.0f);
+  pulled = 0;
+  for (int i = 0; i < 100; ++i) reader.Fill(frame.data(), 256, ramp);
+  EXPECT_NEAR(static_cast<double>(pulled), 2.0 * 256 * 100, 2.0 * 800);
+
+  // Back at tempo 1 the stretcher drains, then input passes through sample for sample again.
+  reader.SetTempo(1.0f);
+  for (int i = 0; i < 10; ++i) reader.Fill(frame.data(), 256, ramp);
+  pulled = 0;
+  reader.Fill(frame.data(), 256, ramp);
+  EXPECT_EQ(pulled, 256);
+  EXPECT_EQ(frame[1] - frame[0], 1.0f);
+}
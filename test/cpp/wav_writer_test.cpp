@@ -0,0 +1,184 @@
+/**
+ * wav_writer_test.cpp
+ *
+ * Host-side GTest suite for the streaming WAV writer (sherpa-onnx-wav-writer.*): SIMD float ->
+ * int16 conversion against a scalar reference, header and data layout across block flushes,
+ * idempotent finalize and open failures.
+ */
+
+#include "sherpa-onnx-wav-writer.h"
+#include "test_temp_dir.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace sherpaonnx;
+namespace fs = std::filesystem;
+
+namespace {
+
+int16_t ScalarReference(float x) {
+  const float clamped = std::max(-1.0f, std::min(1.0f, x));
+  return static_cast<int16_t>(clamped * 32767.0f);
+}
+
+std::vector<float> Signal(size_t n) {
+  std::vector<float> v(n);
+  uint32_t state = 12345;
+  for (size_t i = 0; i < n; ++i) {
+    state = state * 1664525u + 1013904223u;
+    // Spread over [-1.5, 1.5] so clamping is exercised on both sides.
+    v[i] = (static_cast<float>(state >> 8) / static_cast<float>(1u << 24)) * 3.0f - 1.5f;
+  }
+  return v;
+}
+
+std::vector<uint8_t> ReadAll(const fs::path& p) {
+  std::ifstream in(p, std::ios::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), {});
+}
+
+uint32_t LE32(const std::vector<uint8_t>& b, size_t off) {
+  return static_cast<uint32_t>(b[off]) | (static_cast<uint32_t>(b[off + 1]) << 8) |
+         (static_cast<uint32_t>(b[off + 2]) << 16) | (static_cast<uint32_t>(b[off + 3]) << 24);
+}
+
+uint16_t LE16(const std::vector<uint8_t>& b, size_t off) {
+  return static_cast<uint16_t>(b[off] | (b[off + 1] << 8));
+}
+
+}  // namespace
+
+TEST(FloatToInt16, MatchesScalarReferenceForOddLengths) {
+  for (size_t n : {0u, 1u, 7u, 8u, 9u, 31u, 1000u}) {
+    const auto in = Signal(n);
+    std::vector<int16_t> out(n);
+    FloatToInt16(in.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i) ASSERT_EQ(out[i], ScalarReference(in[i])) << "n=" << n << " i=" << i;
+  }
+}
+
+TEST(FloatToInt16, ClampsAndTruncates) {
+  const std::vector<float> in = {-2.0f, -1.0f, -0.5f, -0.00001f, 0.0f, 0.00001f,
+                                 0.5f,  1.0f,  2.0f,  1e9f,      -1e9f, 0.99999f};
+  std::vector<int16_t> out(in.size());
+  FloatToInt16(in.data(), out.data(), in.size());
+  const std::vector<int16_t> expected = {-32767, -32767, -16383, 0,     0,      0,
+                                         16383,  32767,  32767,  32767, -32767, 32766};
+  EXPECT_EQ(out, expected);
+}
+
+TEST(WavWriter, WritesHeaderAndDataAcrossBlockFlushes) {
+  TempDir dir("wav_writer_test_");
+  const fs::path file = dir.path() / "out.wav";
+  // More than one buffer's worth, appended in uneven chunks.
+  const size_t total = WavWriter::kBufferSamples * 2 + 12345;
+  const auto signal = Signal(total);
+
+  WavWriter writer;
+  ASSERT_TRUE(writer.Open(file.string(), 22050));
+  size_t pos = 0;
+  size_t chunk = 1;
+  while (pos < total) {
+    const size_t n = std::min(chunk, total - pos);
+    ASSERT_TRUE(writer.Append(signal.data() + pos, n));
+    pos += n;
+    chunk = chunk * 3 + 17;
+  }
+  EXPECT_EQ(writer.NumSamples(), total);
+  ASSERT_TRUE(writer.Finalize());
+  EXPECT_FALSE(writer.IsOpen());
+
+  const auto bytes = ReadAll(file);
+  ASSERT_EQ(bytes.size(), 44 + total * 2);
+  EXPECT_EQ(std::memcmp(bytes.data(), "RIFF", 4), 0);
+  EXPECT_EQ(LE32(bytes, 4), 36 + total * 2);
+  EXPECT_EQ(std::memcmp(bytes.data() + 8, "WAVEfmt ", 8), 0);
+  EXPECT_EQ(LE32(bytes, 16), 16u);
+  EXPECT_EQ(LE16(bytes, 20), 1u);
+  EXPECT_EQ(LE16(bytes, 22), 1u);
+  EXPECT_EQ(LE32(bytes, 24), 22050u);
+  EXPECT_EQ(LE32(bytes, 28), 22050u * 2);
+  EXPECT_EQ(LE16(bytes, 32), 2u);
+  EXPECT_EQ(LE16(bytes, 34), 16u);
+  EXPECT_EQ(std::memcmp(bytes.data() + 36, "data", 4), 0);
+  EXPECT_EQ(LE32(bytes, 40), total * 2);
+  for (size_t i = 0; i < total; ++i) {
+    const auto s = static_cast<int16_t>(LE16(bytes, 44 + i * 2));
+    ASSERT_EQ(s, ScalarReference(signal[i])) << "i=" << i;
+  }
+}
+
+TEST(WavWriter, FinalizeIsIdempotentAndDestructorFinalizes) {
+  TempDir dir("wav_writer_test_");
+  const fs::path a = dir.path() / "a.wav";
+  const auto signal = Signal(100);
+  {
+    WavWriter writer;
+    ASSERT_TRUE(writer.Open(a.string(), 16000));
+    ASSERT_TRUE(writer.Append(signal.data(), signal.size()));
+    EXPECT_TRUE(writer.Finalize());
+    EXPECT_TRUE(writer.Finalize());
+    EXPECT_FALSE(writer.Append(signal.data(), signal.size()));
+  }
+  EXPECT_EQ(fs::file_size(a), 44u + 200u);
+
+  const fs::path b = dir.path() / "b.wav";
+  {
+    WavWriter writer;
+    ASSERT_TRUE(writer.Open(b.string(), 16000));
+    ASSERT_TRUE(writer.Append(signal.data(), 10));
+  }
+  const auto bytes = ReadAll(b);
+  ASSERT_EQ(bytes.size(), 44u + 20u);
+  EXPECT_EQ(LE32(bytes, 40), 20u);
+}
+
+TEST(WavWriter, EmptyFileHasValidHeader) {
+  TempDir dir("wav_writer_test_");
+  const fs::path file = dir.path() / "empty.wav";
+  WavWriter writer;
+  ASSERT_TRUE(writer.Open(file.string(), 24000));
+  ASSERT_TRUE(writer.Finalize());
+  const auto bytes = ReadAll(file);
+  ASSERT_EQ(bytes.size(), 44u);
+  EXPECT_EQ(LE32(bytes, 4), 36u);
+  EXPECT_EQ(LE32(bytes, 40), 0u);
+}
+
+TEST(WavWriter, OpenFailsForBadPathOrFormat) {
+  TempDir dir("wav_writer_test_");
+  WavWriter writer;
+  EXPECT_FALSE(writer.Open((dir.path() / "missing" / "x.wav").string(), 16000));
+  EXPECT_FALSE(writer.IsOpen());
+  EXPECT_FALSE(writer.Open((dir.path() / "x.wav").string(), 0));
+  float s = 0.0f;
+  EXPECT_FALSE(writer.Append(&s, 1));
+}
+
+TEST(WavWriter, ReopenFinalizesPreviousFile) {
+  TempDir dir("wav_writer_test_");
+  const auto signal = Signal(50);
+  WavWriter writer;
+  ASSERT_TRUE(writer.Open((dir.path() / "first.wav").string(), 16000));
+  ASSERT_TRUE(writer.Append(signal.data(), signal.size()));
+  ASSERT_TRUE(writer.Open((dir.path() / "second.wav").string(), 16000, 2));
+  EXPECT_EQ(writer.NumSamples(), 0u);
+  ASSERT_TRUE(writer.Append(signal.data(), 20));
+  ASSERT_TRUE(writer.Finalize());
+
+  const auto first = ReadAll(dir.path() / "first.wav");
+  ASSERT_EQ(first.size(), 44u + 100u);
+  EXPECT_EQ(LE32(first, 40), 100u);
+  const auto second = ReadAll(dir.path() / "second.wav");
+  EXPECT_EQ(LE16(second, 22), 2u);
+  EXPECT_EQ(LE32(second, 28), 16000u * 4);
+  EXPECT_EQ(LE16(second, 32), 4u);
+  EXPECT_EQ(LE32(second, 40), 40u);
+}